@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+//! @file   inline_function.h
+//! @brief  インラインストレージ付き型消去関数オブジェクト
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "common/stl/stl_common.h"
+#include "common/stl/stl_metaprogramming.h"
+#include <new>
+
+template<typename Signature, size_t InlineSize = 64>
+class InlineFunction;
+
+//============================================================================
+//! @brief インラインストレージ付き型消去関数オブジェクト
+//!
+//! std::functionと同様に任意の呼び出し可能オブジェクトを保持するが、
+//! InlineSizeバイト以下のファンクタはオブジェクト内に直接格納し、
+//! ヒープ確保を行わない。超過した場合のみヒープにフォールバックする。
+//!
+//! @tparam R       戻り値型
+//! @tparam Args    引数型
+//! @tparam InlineSize インライン格納できる最大サイズ（バイト）
+//!
+//! @note std::functionと同様、格納するファンクタはコピー構築可能であること
+//============================================================================
+template<typename R, typename... Args, size_t InlineSize>
+class InlineFunction<R(Args...), InlineSize>
+{
+public:
+    //! インラインストレージのサイズ
+    static constexpr size_t kInlineSize = InlineSize;
+
+    //! インライン格納可能か（サイズ・アラインメント・例外なしムーブ）
+    template<typename F>
+    static constexpr bool kFitsInline =
+        sizeof(F) <= InlineSize &&
+        alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    template<typename F,
+             typename Fn = std::decay_t<F>,
+             std::enable_if_t<!std::is_same_v<Fn, InlineFunction> &&
+                              std::is_invocable_r_v<R, Fn&, Args...>, int> = 0>
+    InlineFunction(F&& func)
+    {
+        static_assert(std::is_copy_constructible_v<Fn>, "InlineFunction requires a copy constructible callable");
+        if constexpr (kFitsInline<Fn>) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(func));
+        } else {
+            // インラインに収まらない場合のみヒープ確保
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(func));
+        }
+        ops_ = &kOps<Fn>;
+    }
+
+    InlineFunction(const InlineFunction& other)
+    {
+        if (other.ops_) {
+            other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept
+    {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    InlineFunction& operator=(const InlineFunction& other)
+    {
+        if (this != &other) {
+            InlineFunction copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    ~InlineFunction() { Reset(); }
+
+    //! @brief 呼び出し
+    R operator()(Args... args) const
+    {
+        assert(ops_ && "InlineFunction is empty");
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    //! @brief 関数を保持しているか
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    //! @brief ヒープを使わずに格納されているか（空の場合もtrue）
+    [[nodiscard]] bool IsInline() const noexcept { return !ops_ || ops_->isInline; }
+
+    //! @brief 保持している関数を破棄
+    void Reset() noexcept
+    {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    //! @brief 型ごとの操作テーブル
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+        bool isInline;
+    };
+
+    template<typename Fn>
+    static Fn& Get(void* storage) noexcept
+    {
+        if constexpr (kFitsInline<Fn>) {
+            return *std::launder(reinterpret_cast<Fn*>(storage));
+        } else {
+            return **reinterpret_cast<Fn**>(storage);
+        }
+    }
+
+    template<typename Fn>
+    static R Invoke(void* storage, Args&&... args)
+    {
+        return std::invoke(Get<Fn>(storage), std::forward<Args>(args)...);
+    }
+
+    template<typename Fn>
+    static void Copy(void* dst, const void* src)
+    {
+        const Fn& source = Get<Fn>(const_cast<void*>(src));
+        if constexpr (kFitsInline<Fn>) {
+            ::new (dst) Fn(source);
+        } else {
+            *reinterpret_cast<Fn**>(dst) = new Fn(source);
+        }
+    }
+
+    template<typename Fn>
+    static void Move(void* dst, void* src) noexcept
+    {
+        if constexpr (kFitsInline<Fn>) {
+            Fn& source = Get<Fn>(src);
+            ::new (dst) Fn(std::move(source));
+            source.~Fn();
+        } else {
+            // ヒープ格納はポインタの付け替えのみ
+            *reinterpret_cast<Fn**>(dst) = *reinterpret_cast<Fn**>(src);
+        }
+    }
+
+    template<typename Fn>
+    static void Destroy(void* storage) noexcept
+    {
+        if constexpr (kFitsInline<Fn>) {
+            Get<Fn>(storage).~Fn();
+        } else {
+            delete *reinterpret_cast<Fn**>(storage);
+        }
+    }
+
+    template<typename Fn>
+    static constexpr Ops kOps = {
+        &Invoke<Fn>, &Copy<Fn>, &Move<Fn>, &Destroy<Fn>, kFitsInline<Fn>
+    };
+
+    static_assert(InlineSize >= sizeof(void*), "InlineSize must hold at least a pointer");
+
+    alignas(std::max_align_t) mutable std::byte storage_[InlineSize];
+    const Ops* ops_ = nullptr;
+};
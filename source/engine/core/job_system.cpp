@@ -8,6 +8,7 @@
 #include "common/stl/stl_containers.h"
 #include "common/stl/stl_threading.h"
 #include "job_system.h"
+#include "work_stealing_deque.h"
 #include "singleton_registry.h"
 #include "common/logging/logging.h"
 #include <chrono>
@@ -17,99 +18,284 @@
 #undef min
 
 //----------------------------------------------------------------------------
-// JobCounter::Impl 実装
+// ジョブ用ブロックプール
 //----------------------------------------------------------------------------
 
-class JobCounter::Impl
+namespace {
+
+//! @brief ジョブ投入経路でヒープ確保が発生した回数（JobSystem::GetHeapAllocationCount）
+std::atomic<uint64_t> g_heapAllocations{0};
+
+//============================================================================
+//! @brief 固定サイズブロックプール（内部ジョブ・カウンター用）
+//!
+//! スレッドローカルキャッシュから確保/返却し、溢れた分や不足分のみ
+//! 共有リストとまとめてやり取りする（ロックはkBatchSize回に1回程度）。
+//! メインスレッドで確保しワーカーで返却する偏りもキャッシュ間で移動して吸収する。
+//!
+//! @tparam BlockSize  ブロックサイズ（バイト）
+//! @tparam BlockAlign ブロックのアラインメント
+//============================================================================
+template<size_t BlockSize, size_t BlockAlign>
+class JobBlockPool
 {
 public:
-    Impl() = default;
-    explicit Impl(uint32_t initialCount) : count_(initialCount) {}
-
-    void Increment() noexcept
+    [[nodiscard]] static void* Allocate()
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        ++count_;
+        LocalCache& cache = GetLocalCache();
+        if (cache.blocks.empty()) {
+            Refill(cache);
+            if (cache.blocks.empty()) {
+                g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(BlockSize, std::align_val_t{BlockAlign});
+            }
+        }
+        void* block = cache.blocks.back();
+        cache.blocks.pop_back();
+        return block;
     }
 
-    void Decrement() noexcept
+    static void Deallocate(void* block) noexcept
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        if (count_ > 0) {
-            --count_;
-            if (count_ == 0) {
-                cv_.notify_all();
-            }
+        LocalCache& cache = GetLocalCache();
+        cache.blocks.push_back(block);
+        if (cache.blocks.size() > kLocalCapacity) {
+            Flush(cache, kBatchSize);
         }
     }
 
-    void Wait() const noexcept
+private:
+    static constexpr size_t kLocalCapacity = 256;  //!< スレッドローカルに保持する最大数
+    static constexpr size_t kBatchSize = 64;       //!< 共有リストとの一括移動数
+
+    struct SharedList {
+        std::mutex mutex;
+        std::vector<void*> blocks;
+
+        ~SharedList()
+        {
+            for (void* block : blocks) {
+                ::operator delete(block, std::align_val_t{BlockAlign});
+            }
+        }
+    };
+
+    struct LocalCache {
+        std::vector<void*> blocks;
+
+        LocalCache() { blocks.reserve(kLocalCapacity + 1); }
+        ~LocalCache() { Flush(*this, blocks.size()); }
+    };
+
+    static SharedList& GetShared()
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        cv_.wait(lock, [this] { return count_ == 0; });
+        static SharedList shared;
+        return shared;
     }
 
-    [[nodiscard]] bool IsComplete() const noexcept
+    static LocalCache& GetLocalCache()
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        return count_ == 0;
+        static thread_local LocalCache cache;
+        return cache;
     }
 
-    [[nodiscard]] uint32_t GetCount() const noexcept
+    static void Refill(LocalCache& cache)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        return count_;
+        SharedList& shared = GetShared();
+        std::unique_lock<std::mutex> lock(shared.mutex);
+        const size_t count = std::min(kBatchSize, shared.blocks.size());
+        cache.blocks.insert(cache.blocks.end(), shared.blocks.end() - count, shared.blocks.end());
+        shared.blocks.resize(shared.blocks.size() - count);
     }
 
-    void Reset(uint32_t count) noexcept
+    static void Flush(LocalCache& cache, size_t count)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        count_ = count;
-        result_ = JobResult::Pending;
+        SharedList& shared = GetShared();
+        std::unique_lock<std::mutex> lock(shared.mutex);
+        shared.blocks.insert(shared.blocks.end(), cache.blocks.end() - count, cache.blocks.end());
+        cache.blocks.resize(cache.blocks.size() - count);
     }
+};
 
-    void SetResult(JobResult result) noexcept
+//! @brief JobBlockPoolを使うSTLアロケータ（std::allocate_shared用）
+template<typename T>
+struct JobPoolAllocator
+{
+    using value_type = T;
+
+    JobPoolAllocator() noexcept = default;
+    template<typename U>
+    JobPoolAllocator(const JobPoolAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n)
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        // エラー状態（Exception/Cancelled）は上書きしない
-        // Pending → Success/Exception/Cancelled は許可
-        // Success → Exception/Cancelled は許可（エラーへの遷移）
-        // Exception/Cancelled → 他への遷移は不許可
-        if (result_ == JobResult::Exception || result_ == JobResult::Cancelled) {
-            return;  // エラー状態を保持
+        if (n != 1) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
         }
-        result_ = result;
+        return static_cast<T*>(JobBlockPool<sizeof(T), alignof(T)>::Allocate());
     }
 
-    [[nodiscard]] JobResult GetResult() const noexcept
+    void deallocate(T* ptr, size_t n) noexcept
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        return result_;
+        if (n != 1) {
+            ::operator delete(ptr, std::align_val_t{alignof(T)});
+            return;
+        }
+        JobBlockPool<sizeof(T), alignof(T)>::Deallocate(ptr);
     }
 
-private:
-    mutable std::mutex mutex_;
-    mutable std::condition_variable cv_;
-    uint32_t count_ = 0;
-    JobResult result_ = JobResult::Pending;
+    template<typename U>
+    bool operator==(const JobPoolAllocator<U>&) const noexcept { return true; }
 };
 
+//! @brief プールからカウンターを確保（制御ブロックと一体で再利用される）
+[[nodiscard]] JobCounterPtr MakePooledCounter(uint32_t initialCount)
+{
+    return std::allocate_shared<JobCounter>(JobPoolAllocator<JobCounter>{}, initialCount);
+}
+
+//! @brief 並列ループ本体用ブロックのサイズ（これを超える本体はヒープから確保）
+constexpr size_t kRangeBodyBlockSize = 256;
+
+using RangeBodyPool = JobBlockPool<kRangeBodyBlockSize, alignof(std::max_align_t)>;
+
+} // namespace
+
+void detail::NoteJobHeapAllocation() noexcept
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+// ParallelRangeBody 確保
+//----------------------------------------------------------------------------
+
+void* ParallelRangeBody::operator new(size_t size)
+{
+    if (size <= kRangeBodyBlockSize) {
+        return RangeBodyPool::Allocate();
+    }
+    detail::NoteJobHeapAllocation();
+    return ::operator new(size);
+}
+
+void* ParallelRangeBody::operator new(size_t size, std::align_val_t align)
+{
+    // 過剰アラインメントの本体はプールを使わない
+    detail::NoteJobHeapAllocation();
+    return ::operator new(size, align);
+}
+
+void ParallelRangeBody::operator delete(void* ptr, size_t size) noexcept
+{
+    if (size <= kRangeBodyBlockSize) {
+        RangeBodyPool::Deallocate(ptr);
+        return;
+    }
+    ::operator delete(ptr, size);
+}
+
+void ParallelRangeBody::operator delete(void* ptr, size_t size, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, size, align);
+}
+
 //----------------------------------------------------------------------------
 // JobCounter 実装
 //----------------------------------------------------------------------------
 
-JobCounter::JobCounter() : impl_(std::make_unique<Impl>()) {}
-JobCounter::JobCounter(uint32_t initialCount) : impl_(std::make_unique<Impl>(initialCount)) {}
-JobCounter::~JobCounter() = default;
+void JobCounter::Increment() noexcept
+{
+    count_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void JobCounter::Decrement() noexcept
+{
+    uint32_t current = count_.load(std::memory_order_relaxed);
+    while (current > 0) {
+        if (count_.compare_exchange_weak(current, current - 1,
+                                         std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            if (current == 1) {
+                NotifyWaiters();
+            }
+            return;
+        }
+    }
+}
+
+//! @brief ジョブを実行せずにブロッキング待機（アトミック待機 = futex/WaitOnAddress）
+void JobCounter::WaitBlocking() const noexcept
+{
+    if (IsComplete()) return;
+
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    uint32_t current = count_.load(std::memory_order_seq_cst);
+    while (current != 0) {
+        count_.wait(current, std::memory_order_seq_cst);
+        current = count_.load(std::memory_order_seq_cst);
+    }
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool JobCounter::IsComplete() const noexcept
+{
+    return count_.load(std::memory_order_acquire) == 0;
+}
+
+uint32_t JobCounter::GetCount() const noexcept
+{
+    return count_.load(std::memory_order_acquire);
+}
 
-void JobCounter::Increment() noexcept { impl_->Increment(); }
-void JobCounter::Decrement() noexcept { impl_->Decrement(); }
-void JobCounter::Wait() const noexcept { impl_->Wait(); }
-bool JobCounter::IsComplete() const noexcept { return impl_->IsComplete(); }
-uint32_t JobCounter::GetCount() const noexcept { return impl_->GetCount(); }
-void JobCounter::Reset(uint32_t count) noexcept { impl_->Reset(count); }
-void JobCounter::SetResult(JobResult result) noexcept { impl_->SetResult(result); }
-JobResult JobCounter::GetResult() const noexcept { return impl_->GetResult(); }
+void JobCounter::Reset(uint32_t count) noexcept
+{
+    result_.store(JobResult::Pending, std::memory_order_relaxed);
+    count_.store(count, std::memory_order_seq_cst);
+    if (count == 0) {
+        NotifyWaiters();
+    }
+}
+
+void JobCounter::SetResult(JobResult result) noexcept
+{
+    // エラー状態（Exception/Cancelled）は上書きしない
+    // Pending → Success/Exception/Cancelled は許可
+    // Success → Exception/Cancelled は許可（エラーへの遷移）
+    // Exception/Cancelled → 他への遷移は不許可
+    JobResult current = result_.load(std::memory_order_relaxed);
+    while (current != JobResult::Exception && current != JobResult::Cancelled) {
+        if (result_.compare_exchange_weak(current, result,
+                                          std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+JobResult JobCounter::GetResult() const noexcept
+{
+    return result_.load(std::memory_order_acquire);
+}
+
+void JobCounter::Wait() const noexcept
+{
+    if (IsComplete()) return;
+
+    // JobSystemがあれば待機中に他のジョブを実行する（ワーカーの遊休・デッドロック防止）
+    if (JobSystem::IsCreated()) {
+        JobSystem::GetConcrete().WaitForCounter(*this);
+    } else {
+        WaitBlocking();
+    }
+}
+
+void JobCounter::NotifyWaiters() noexcept
+{
+    // WaitBlocking()のwaiters_加算→count_確認と対になるフェンス
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0) {
+        count_.notify_all();
+    }
+}
 
 //----------------------------------------------------------------------------
 // JobSystem::Impl
@@ -132,26 +318,46 @@ public:
 #endif
     };
 
+    //! @brief スレッドごとのキュー群（優先度別Chase-Levデック）
+    //! @note 所有スレッドのみPush/Pop、他スレッドはStealのみ
+    struct alignas(64) LocalQueues {
+        WorkStealingDeque<InternalJob*> deques[static_cast<int>(JobPriority::Count)];
+    };
+
+    //! @brief 待機に入る前のスピン回数（短いバースト間でスリープしないため）
+    static constexpr uint32_t kIdleSpinCount = 64;
+
+    //! @brief Dynamic分割時のワーカーあたりの目標スライス数
+    static constexpr uint32_t kDynamicSlicesPerWorker = 8;
+
     //! @brief 現在のスレッドのワーカーID（-1 = 非ワーカー）
     static inline thread_local int32_t currentWorkerId_ = -1;
 
+    //! @brief 現在のスレッドで実行中のジョブのネスト数（待機中のヘルプ実行を含む）
+    static inline thread_local uint32_t executingDepth_ = 0;
+
+    //! @brief スティール対象選択用の乱数状態（xorshift32）
+    static inline thread_local uint32_t stealRandomState_ = 0;
+
     Impl() : mainThreadId_(std::this_thread::get_id()) {}
     ~Impl() { Shutdown(); }
 
     void Initialize(uint32_t numWorkers)
     {
-        if (running_) return;
+        if (running_.load(std::memory_order_acquire)) return;
 
         // ワーカー数を決定（0なら論理コア数-1、最低1）
         if (numWorkers == 0) {
             numWorkers = std::max(1u, std::thread::hardware_concurrency() - 1);
         }
 
-        running_ = true;
+        running_.store(true, std::memory_order_release);
 
-        // Work-Stealing用のローカルキューを各ワーカーに割り当て
-        localQueues_.resize(numWorkers);
-        localQueueMutexes_ = std::make_unique<std::mutex[]>(numWorkers);
+        // ワーカー分 + メインスレッド分のローカルキューを確保
+        // メインスレッドからの投入も自分のデックに積み、ワーカーがStealする
+        localQueueCount_ = numWorkers + 1;
+        mainQueueIndex_ = static_cast<int32_t>(numWorkers);
+        localQueues_ = std::make_unique<LocalQueues[]>(localQueueCount_);
         workers_.reserve(numWorkers);
 
         for (uint32_t i = 0; i < numWorkers; ++i) {
@@ -163,13 +369,11 @@ public:
 
     void Shutdown()
     {
-        if (!running_) return;
+        if (!running_.load(std::memory_order_acquire)) return;
 
-        {
-            std::unique_lock<std::mutex> lock(globalMutex_);
-            running_ = false;
-        }
-        globalCondition_.notify_all();
+        running_.store(false, std::memory_order_seq_cst);
+        wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        wakeEpoch_.notify_all();
 
         for (auto& worker : workers_) {
             if (worker.joinable()) {
@@ -177,14 +381,32 @@ public:
             }
         }
         workers_.clear();
-        localQueues_.clear();
-        localQueueMutexes_.reset();
 
-        // 残っているジョブをクリア
-        for (int i = 0; i < static_cast<int>(JobPriority::Count); ++i) {
-            globalQueues_[i].clear();
+        // 残っているジョブをクリア（全ワーカー停止後なのでStealで取り出す）
+        for (uint32_t q = 0; q < localQueueCount_; ++q) {
+            for (auto& deque : localQueues_[q].deques) {
+                InternalJob* job = nullptr;
+                while (deque.Steal(job)) {
+                    DeleteJob(job);
+                }
+            }
+        }
+        localQueues_.reset();
+        localQueueCount_ = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(externalMutex_);
+            for (auto& queue : externalQueues_) {
+                for (InternalJob* job : queue) {
+                    DeleteJob(job);
+                }
+                queue.clear();
+            }
+            externalJobCount_.store(0, std::memory_order_relaxed);
         }
         mainThreadQueue_.clear();
+        pendingJobs_.store(0, std::memory_order_relaxed);
+        outstandingJobs_.store(0, std::memory_order_relaxed);
 
         LOG_INFO("[JobSystem] シャットダウン完了");
     }
@@ -208,7 +430,7 @@ public:
 
     JobCounterPtr SubmitAndGetCounter(JobFunction job, JobPriority priority)
     {
-        auto counter = std::make_shared<JobCounter>(1);
+        auto counter = MakePooledCounter(1);
         Submit(std::move(job), counter, priority);
         return counter;
     }
@@ -219,7 +441,7 @@ public:
 
     JobHandle SubmitJob(JobDesc desc)
     {
-        auto counter = std::make_shared<JobCounter>(1);
+        auto counter = MakePooledCounter(1);
 
         InternalJob job;
         job.function = std::move(desc.function_);
@@ -299,7 +521,7 @@ public:
     void BeginFrame()
     {
         std::unique_lock<std::mutex> lock(frameMutex_);
-        frameCounter_ = std::make_shared<JobCounter>(0);
+        frameCounter_ = MakePooledCounter(0);
     }
 
     void EndFrame()
@@ -320,19 +542,63 @@ public:
 
     void WaitAll()
     {
-        // 全キューが空になるまで待機
+        // 呼び出し元スレッドで実行中のジョブ自身は完了を待てないので除外する
+        const uint32_t selfJobs = executingDepth_;
+
+        // 投入済みジョブが全て完了するまで、ジョブを実行しながら待機
+        uint32_t idleSpins = 0;
         while (true) {
             ProcessMainThreadJobs(0);
 
-            std::unique_lock<std::mutex> lock(globalMutex_);
-            // ロック保持中なのでHasPendingJobsLocked()を直接使用（デッドロック回避）
-            if (!HasPendingJobsLocked() && !HasLocalJobs() && mainThreadQueue_.empty()) {
+            const uint32_t outstanding = outstandingJobs_.load(std::memory_order_acquire);
+            if (outstanding <= selfJobs && GetMainThreadJobCount() == 0) {
                 break;
             }
-            // 少し待ってから再チェック
-            lock.unlock();
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            if (TryExecuteOneJob(JobPriority::Low)) {
+                idleSpins = 0;
+                continue;
+            }
+            if (++idleSpins < kIdleSpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+            idleSpins = 0;
+
+            // 実行できるジョブがない: 非ワーカーは完了通知までブロック（スリープポーリングしない）
+            if (!IsWorkerThread() && selfJobs == 0) {
+                WaitForOutstandingChange(outstanding);
+            }
+        }
+    }
+
+    //! @brief カウンター完了まで他のジョブを実行しながら待機
+    //!
+    //! Normal以上のジョブを優先し、なくなればLowも実行する（待機対象がLowでも進むように）。
+    //! 依存関係はExecuteJob内で待つので、投入済みのジョブは必ずいずれかのキューにある。
+    //! 実行できるジョブが見つからなければ残りは他スレッドで実行中なので、
+    //! ワーカーも含めてアトミック待機に切り替えてコアを空ける。
+    //!
+    //! @return 完了していればtrue、呼び出し元がブロッキング待機すべきならfalse
+    bool HelpUntilComplete(const JobCounter& counter)
+    {
+        uint32_t idleSpins = 0;
+        while (!counter.IsComplete()) {
+            if (TryExecuteOneJob(JobPriority::Normal) || TryExecuteOneJob(JobPriority::Low)) {
+                idleSpins = 0;
+                continue;
+            }
+            if (IsMainThread() && ProcessMainThreadJobs(1) > 0) {
+                idleSpins = 0;
+                continue;
+            }
+            if (++idleSpins < kIdleSpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+            return counter.IsComplete();
         }
+        return true;
     }
 
     //------------------------------------------------------------------------
@@ -345,29 +611,10 @@ public:
     {
         if (begin >= end) return JobHandle();
 
-        uint32_t count = end - begin;
-
-        if (granularity == 0) {
-            uint32_t numJobs = std::max(1u, static_cast<uint32_t>(workers_.size()) * 2);
-            granularity = std::max(1u, count / numJobs);
-        }
-
-        uint32_t numJobs = (count + granularity - 1) / granularity;
-        auto counter = std::make_shared<JobCounter>(numJobs);
-
-        for (uint32_t i = 0; i < numJobs; ++i) {
-            uint32_t jobBegin = begin + i * granularity;
-            uint32_t jobEnd = std::min(jobBegin + granularity, end);
-
-            Submit([func, jobBegin, jobEnd] {
-                for (uint32_t j = jobBegin; j < jobEnd; ++j) {
-                    func(j);
-                }
-                // 結果はExecuteJobInternalで設定される
-            }, counter, JobPriority::Normal);
-        }
-
-        return JobHandle(counter);
+        // 関数のコピーは呼び出しごとに1回（スライスごとにはコピーしない）
+        return SubmitParallelRange(begin, end,
+            std::make_unique<detail::ParallelForBodyImpl<std::function<void(uint32_t)>>>(func),
+            ParallelForDesc().SetGranularity(granularity));
     }
 
     [[nodiscard]] JobHandle ParallelForRange(uint32_t begin, uint32_t end,
@@ -376,27 +623,76 @@ public:
     {
         if (begin >= end) return JobHandle();
 
-        uint32_t count = end - begin;
+        return SubmitParallelRange(begin, end,
+            std::make_unique<detail::ParallelRangeBodyImpl<std::function<void(uint32_t, uint32_t)>>>(func),
+            ParallelForDesc().SetGranularity(granularity));
+    }
+
+    [[nodiscard]] JobHandle SubmitParallelRange(uint32_t begin, uint32_t end,
+                                                 std::unique_ptr<ParallelRangeBody> body,
+                                                 const ParallelForDesc& desc)
+    {
+        if (begin >= end || !body) return JobHandle();
+
+        const uint32_t count = end - begin;
+        const uint32_t workerCount = std::max(1u, static_cast<uint32_t>(workers_.size()));
+        const bool dynamic = desc.GetPartition() == ParallelForPartition::Dynamic;
+
+        // 目標スライス数: Staticは従来通りワーカー数×2、
+        // Dynamicは取り合いで負荷を均すため細かめに切る
+        const uint32_t targetSlices = workerCount * (dynamic ? kDynamicSlicesPerWorker : 2);
+
+        ParallelRangeBody* sharedBody = body.release();
+        sharedBody->begin_ = begin;
+        sharedBody->end_ = end;
 
-        if (granularity == 0) {
-            uint32_t numJobs = std::max(1u, static_cast<uint32_t>(workers_.size()) * 2);
-            granularity = std::max(1u, count / numJobs);
+        const auto itemCosts = desc.GetItemCosts();
+        if (!itemCosts.empty()) {
+            assert(itemCosts.size() == count && "Item cost count must match the iteration count");
+            BuildCostBalancedSlices(*sharedBody, itemCosts, targetSlices, desc.GetGranularity());
+        } else {
+            uint32_t granularity = desc.GetGranularity();
+            if (granularity == 0) {
+                granularity = std::max(1u, count / targetSlices);
+            }
+            sharedBody->grain_ = granularity;
+            sharedBody->sliceCount_ = (count + granularity - 1) / granularity;
         }
 
-        uint32_t numJobs = (count + granularity - 1) / granularity;
-        auto counter = std::make_shared<JobCounter>(numJobs);
+        const uint32_t sliceCount = sharedBody->sliceCount_;
+
+        // Dynamic: ワーカー数+1（待機スレッドのヘルプ分）のランナーがスライスを取り合う
+        const uint32_t numJobs = dynamic ? std::min(sliceCount, workerCount + 1) : sliceCount;
+        auto counter = MakePooledCounter(numJobs);
+        sharedBody->remainingJobs_.store(numJobs, std::memory_order_relaxed);
+        sharedBody->cursor_.store(0, std::memory_order_relaxed);
 
         for (uint32_t i = 0; i < numJobs; ++i) {
-            uint32_t jobBegin = begin + i * granularity;
-            uint32_t jobEnd = std::min(jobBegin + granularity, end);
+            // キャプチャはポインタ+インデックスのみなのでJobFunctionのインラインストレージに収まる
+            Submit([sharedBody, i, dynamic] {
+                struct ReleaseGuard {
+                    ParallelRangeBody* body;
+                    ~ReleaseGuard() {
+                        if (body->remainingJobs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                            delete body;
+                        }
+                    }
+                } guard{sharedBody};
 
-            Submit([func, jobBegin, jobEnd] {
-                func(jobBegin, jobEnd);
+                if (dynamic) {
+                    const uint32_t slices = sharedBody->sliceCount_;
+                    uint32_t slice;
+                    while ((slice = sharedBody->cursor_.fetch_add(1, std::memory_order_relaxed)) < slices) {
+                        ExecuteSlice(*sharedBody, slice);
+                    }
+                } else {
+                    ExecuteSlice(*sharedBody, i);
+                }
                 // 結果はExecuteJobInternalで設定される
             }, counter, JobPriority::Normal);
         }
 
-        return JobHandle(counter);
+        return JobHandle(std::move(counter));
     }
 
     //------------------------------------------------------------------------
@@ -436,86 +732,254 @@ public:
 #endif
 
 private:
+    //! @brief 現在のスレッドが所有するローカルキューのインデックス（-1 = なし）
+    [[nodiscard]] int32_t GetLocalQueueIndex() const noexcept
+    {
+        if (currentWorkerId_ >= 0) {
+            return currentWorkerId_;
+        }
+        if (localQueues_ && std::this_thread::get_id() == mainThreadId_) {
+            return mainQueueIndex_;
+        }
+        return -1;
+    }
+
     void EnqueueJob(InternalJob job, JobPriority priority, bool mainThread)
     {
+        // インラインに収まらなかったジョブ関数は構築時にヒープ確保している
+        if (!job.function.IsInline() || !job.cancellableFunction.IsInline()) {
+            detail::NoteJobHeapAllocation();
+        }
+
         if (mainThread) {
             std::unique_lock<std::mutex> lock(mainThreadMutex_);
             mainThreadQueue_.push_back(std::move(job));
+            return;
+        }
+
+        const int p = static_cast<int>(priority);
+        InternalJob* newJob = NewJob(std::move(job));
+
+        // 取り出し側のデクリメントより先にカウントする
+        outstandingJobs_.fetch_add(1, std::memory_order_relaxed);
+        pendingJobs_.fetch_add(1, std::memory_order_seq_cst);
+
+        const int32_t queueIndex = GetLocalQueueIndex();
+        if (queueIndex >= 0) {
+            // ワーカー/メインスレッドからの投入は自分のデックへ（ロックなし）
+            if (localQueues_[queueIndex].deques[p].Push(newJob)) {
+                detail::NoteJobHeapAllocation();
+            }
         } else {
-            // ワーカースレッドからの投入はローカルキューへ（Work-Stealing用）
-            int32_t workerId = currentWorkerId_;
-            if (workerId >= 0 && workerId < static_cast<int32_t>(localQueues_.size())) {
-                std::unique_lock<std::mutex> lock(localQueueMutexes_[workerId]);
-                localQueues_[workerId].push_back(std::move(job));
-                ++pendingJobs_;
-            } else {
-                // 非ワーカースレッドからはグローバルキューへ
-                std::unique_lock<std::mutex> lock(globalMutex_);
-                globalQueues_[static_cast<int>(priority)].push_back(std::move(job));
-                ++pendingJobs_;
+            // その他のスレッドからは外部キューへ（低頻度パス）
+            std::unique_lock<std::mutex> lock(externalMutex_);
+            externalQueues_[p].push_back(newJob);
+            externalJobCount_.fetch_add(1, std::memory_order_release);
+        }
+
+        WakeWorker();
+    }
+
+    //! @brief スリープ中のワーカーを1つ起こす（スリープ中がいなければ何もしない）
+    void WakeWorker() noexcept
+    {
+        // WaitForWork()のsleepingWorkers_加算→pendingJobs_確認と対になるフェンス
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepingWorkers_.load(std::memory_order_seq_cst) > 0) {
+            wakeEpoch_.fetch_add(1, std::memory_order_seq_cst);
+            wakeEpoch_.notify_one();
+        }
+    }
+
+    //! @brief 未完了ジョブ数が変化するまでブロック（WaitAll用）
+    void WaitForOutstandingChange(uint32_t observed) noexcept
+    {
+        allJobsWaiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (outstandingJobs_.load(std::memory_order_seq_cst) == observed) {
+            outstandingJobs_.wait(observed, std::memory_order_seq_cst);
+        }
+        allJobsWaiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //! @brief スライス番号の範囲を実行
+    static void ExecuteSlice(ParallelRangeBody& body, uint32_t slice)
+    {
+        uint32_t sliceBegin;
+        uint32_t sliceEnd;
+        if (!body.sliceBounds_.empty()) {
+            sliceBegin = body.sliceBounds_[slice];
+            sliceEnd = body.sliceBounds_[slice + 1];
+        } else {
+            sliceBegin = body.begin_ + slice * body.grain_;
+            sliceEnd = std::min(sliceBegin + body.grain_, body.end_);
+        }
+        body.Execute(sliceBegin, sliceEnd);
+    }
+
+    //! @brief コストヒントから各スライスの総コストが均等になる境界を作る
+    //! @param targetCost 1スライスの目標コスト（0 = 総コスト / targetSlices）
+    static void BuildCostBalancedSlices(ParallelRangeBody& body, std::span<const uint32_t> itemCosts,
+                                        uint32_t targetSlices, uint32_t targetCost)
+    {
+        if (targetCost == 0) {
+            uint64_t totalCost = 0;
+            for (uint32_t cost : itemCosts) {
+                totalCost += cost;
+            }
+            targetCost = static_cast<uint32_t>(std::max<uint64_t>(1, (totalCost + targetSlices - 1) / targetSlices));
+        }
+
+        auto& bounds = body.sliceBounds_;
+        auto pushBound = [&bounds](uint32_t bound) {
+            if (bounds.size() == bounds.capacity()) {
+                detail::NoteJobHeapAllocation();
+            }
+            bounds.push_back(bound);
+        };
+        bounds.clear();
+        pushBound(body.begin_);
+
+        uint64_t accumulated = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(itemCosts.size()); ++i) {
+            accumulated += itemCosts[i];
+            if (accumulated >= targetCost) {
+                pushBound(body.begin_ + i + 1);
+                accumulated = 0;
             }
         }
-        globalCondition_.notify_one();
+        if (bounds.back() != body.end_) {
+            pushBound(body.end_);
+        }
+        body.sliceCount_ = static_cast<uint32_t>(bounds.size() - 1);
     }
 
-    //! @brief 1つのジョブを取得して実行（待機中のヘルプ用）
-    bool TryExecuteOneJob()
+    //! @brief 内部ジョブをプールから確保
+    [[nodiscard]] static InternalJob* NewJob(InternalJob&& job)
     {
-        InternalJob job;
-        int32_t workerId = currentWorkerId_;
+        void* memory = JobBlockPool<sizeof(InternalJob), alignof(InternalJob)>::Allocate();
+        return ::new (memory) InternalJob(std::move(job));
+    }
+
+    //! @brief 内部ジョブをプールへ返却
+    static void DeleteJob(InternalJob* job) noexcept
+    {
+        job->~InternalJob();
+        JobBlockPool<sizeof(InternalJob), alignof(InternalJob)>::Deallocate(job);
+    }
 
-        // 1. ローカルキューから取得
-        if (workerId >= 0 && workerId < static_cast<int32_t>(localQueues_.size())) {
-            std::unique_lock<std::mutex> lock(localQueueMutexes_[workerId], std::try_to_lock);
-            if (lock.owns_lock() && !localQueues_[workerId].empty()) {
-                job = std::move(localQueues_[workerId].front());
-                localQueues_[workerId].pop_front();
-                --pendingJobs_;
-                ExecuteJobInternal(job);
-                return true;
+    //! @brief ジョブを実行して破棄し、未完了ジョブ数を減らす
+    void RunJob(InternalJob* job)
+    {
+        ++executingDepth_;
+        ExecuteJob(*job);
+        DeleteJob(job);
+        --executingDepth_;
+
+        if (outstandingJobs_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (allJobsWaiters_.load(std::memory_order_seq_cst) > 0) {
+                outstandingJobs_.notify_all();
             }
         }
+    }
 
-        // 2. グローバルキューから取得
-        {
-            std::unique_lock<std::mutex> lock(globalMutex_, std::try_to_lock);
-            if (lock.owns_lock()) {
-                for (int i = 0; i < static_cast<int>(JobPriority::Count); ++i) {
-                    if (!globalQueues_[i].empty()) {
-                        job = std::move(globalQueues_[i].front());
-                        globalQueues_[i].pop_front();
-                        --pendingJobs_;
-                        lock.unlock();
-                        ExecuteJobInternal(job);
-                        return true;
-                    }
+    //! @brief ジョブが投入されるまでスリープ
+    void WaitForWork() noexcept
+    {
+        const uint32_t epoch = wakeEpoch_.load(std::memory_order_seq_cst);
+        sleepingWorkers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (running_.load(std::memory_order_acquire) &&
+            pendingJobs_.load(std::memory_order_seq_cst) == 0) {
+            wakeEpoch_.wait(epoch, std::memory_order_seq_cst);
+        }
+
+        sleepingWorkers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    //! @brief 次のスティール対象の開始位置を選ぶ
+    [[nodiscard]] uint32_t NextStealStart() noexcept
+    {
+        uint32_t x = stealRandomState_;
+        if (x == 0) {
+            x = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        }
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        stealRandomState_ = x;
+        return x % localQueueCount_;
+    }
+
+    //! @brief 実行可能なジョブを1つ取得
+    //!
+    //! 1. 自分のデック（High→Low、LIFOでキャッシュ局所性を優先）
+    //! 2. 外部キュー（High→Low）
+    //! 3. ランダムに選んだ他スレッドのデックから盗む（High→Low、FIFO）
+    //!
+    //! @param selfIndex 自分のローカルキュー（-1 = なし）
+    //! @param lowestPriority 取得対象とする最も低い優先度
+    //! @return 取得したジョブ（なければnullptr）
+    InternalJob* FindJob(int32_t selfIndex, JobPriority lowestPriority = JobPriority::Low)
+    {
+        InternalJob* job = nullptr;
+        const int priorityCount = static_cast<int>(lowestPriority) + 1;
+
+        if (selfIndex >= 0) {
+            for (int p = 0; p < priorityCount; ++p) {
+                if (localQueues_[selfIndex].deques[p].Pop(job)) {
+                    pendingJobs_.fetch_sub(1, std::memory_order_acq_rel);
+                    return job;
                 }
             }
         }
 
-        // 3. 他のワーカーから盗む
-        if (workerId >= 0) {
-            for (size_t i = 0; i < localQueues_.size(); ++i) {
-                if (static_cast<int32_t>(i) == workerId) continue;
+        if (externalJobCount_.load(std::memory_order_acquire) > 0) {
+            std::unique_lock<std::mutex> lock(externalMutex_);
+            for (int p = 0; p < priorityCount; ++p) {
+                if (!externalQueues_[p].empty()) {
+                    job = externalQueues_[p].front();
+                    externalQueues_[p].pop_front();
+                    externalJobCount_.fetch_sub(1, std::memory_order_relaxed);
+                    pendingJobs_.fetch_sub(1, std::memory_order_acq_rel);
+                    return job;
+                }
+            }
+        }
 
-                std::unique_lock<std::mutex> lock(localQueueMutexes_[i], std::try_to_lock);
-                if (!lock.owns_lock()) continue;
+        const uint32_t start = NextStealStart();
+        for (int p = 0; p < priorityCount; ++p) {
+            for (uint32_t i = 0; i < localQueueCount_; ++i) {
+                const uint32_t victim = (start + i) % localQueueCount_;
+                if (static_cast<int32_t>(victim) == selfIndex) continue;
 
-                if (!localQueues_[i].empty()) {
-                    job = std::move(localQueues_[i].back());  // 後ろから盗む
-                    localQueues_[i].pop_back();
-                    --pendingJobs_;
+                auto& deque = localQueues_[victim].deques[p];
+                if (deque.IsEmptyApprox()) continue;
+
+                if (deque.Steal(job)) {
+                    pendingJobs_.fetch_sub(1, std::memory_order_acq_rel);
 #ifdef _DEBUG
                     ++stats_.totalJobsStolen;
 #endif
-                    lock.unlock();
-                    ExecuteJobInternal(job);
-                    return true;
+                    return job;
                 }
             }
         }
 
-        return false;
+        return nullptr;
+    }
+
+    //! @brief 1つのジョブを取得して実行（待機中のヘルプ用）
+    bool TryExecuteOneJob(JobPriority lowestPriority)
+    {
+        InternalJob* job = FindJob(GetLocalQueueIndex(), lowestPriority);
+        if (!job) {
+            return false;
+        }
+        RunJob(job);
+        return true;
     }
 
     //! @brief ジョブの実際の実行（依存関係チェック後）
@@ -589,13 +1053,8 @@ private:
     {
         // 依存関係をチェック（待機中は他のジョブを実行してデッドロック回避）
         for (const auto& dep : job.dependencies) {
-            if (dep) {
-                while (!dep->IsComplete()) {
-                    if (!TryExecuteOneJob()) {
-                        // 実行できるジョブがなければ少し待つ
-                        std::this_thread::yield();
-                    }
-                }
+            if (dep && !dep->IsComplete()) {
+                dep->Wait();
             }
         }
 
@@ -606,137 +1065,49 @@ private:
     {
         // このスレッドのワーカーIDを設定
         currentWorkerId_ = static_cast<int32_t>(workerId);
+        stealRandomState_ = (workerId + 1) * 2654435761u;
 
 #if defined(_WIN32) && defined(_DEBUG)
         std::wstring name = L"JobWorker_" + std::to_wstring(workerId);
         SetThreadDescription(GetCurrentThread(), name.c_str());
 #endif
 
+        uint32_t idleSpins = 0;
         while (true) {
-            InternalJob job;
-            bool gotJob = false;
-
-            // 1. 自分のローカルキューをチェック
-            {
-                std::unique_lock<std::mutex> lock(localQueueMutexes_[workerId]);
-                if (!localQueues_[workerId].empty()) {
-                    job = std::move(localQueues_[workerId].front());
-                    localQueues_[workerId].pop_front();
-                    --pendingJobs_;
-                    gotJob = true;
-                }
-            }
-
-            // 2. グローバルキューをチェック
-            if (!gotJob) {
-                std::unique_lock<std::mutex> lock(globalMutex_);
-
-                // ジョブがなければ待機
-                if (!HasPendingJobsLocked() && !HasLocalJobs()) {
-                    globalCondition_.wait(lock, [this] {
-                        return !running_ || HasPendingJobsLocked() || HasLocalJobs();
-                    });
-                }
-
-                if (!running_ && !HasPendingJobsLocked() && !HasLocalJobs()) {
-                    return;
-                }
-
-                gotJob = TryPopJob(job);
-                if (gotJob) {
-                    --pendingJobs_;
-                }
-            }
-
-            // 3. Work-Stealing: 他のワーカーから盗む
-            if (!gotJob) {
-                gotJob = TryStealJob(job, workerId);
-                if (gotJob) {
-                    --pendingJobs_;
-                }
+            InternalJob* job = FindJob(static_cast<int32_t>(workerId));
+            if (job) {
+                RunJob(job);
+                idleSpins = 0;
+                continue;
             }
 
-            if (gotJob) {
-                ExecuteJob(job);
+            if (!running_.load(std::memory_order_acquire)) {
+                return;
             }
-        }
-    }
 
-    //! @brief グローバルキューにジョブがあるか（ロック保持前提）
-    [[nodiscard]] bool HasPendingJobsLocked() const noexcept
-    {
-        for (int i = 0; i < static_cast<int>(JobPriority::Count); ++i) {
-            if (!globalQueues_[i].empty()) {
-                return true;
+            // しばらくスピンしてから待機（ParallelFor間の短い空きでスリープしない）
+            if (++idleSpins < kIdleSpinCount) {
+                std::this_thread::yield();
+                continue;
             }
+            idleSpins = 0;
+            WaitForWork();
         }
-        return false;
-    }
-
-    //! @brief いずれかのローカルキューにジョブがあるか
-    [[nodiscard]] bool HasLocalJobs() const noexcept
-    {
-        for (size_t i = 0; i < localQueues_.size(); ++i) {
-            // ロックなしでチェック（厳密ではないがウェイクアップ判定用）
-            if (!localQueues_[i].empty()) {
-                return true;
-            }
-        }
-        return false;
-    }
-
-    //! @brief グローバルまたはローカルにジョブがあるか（スレッドセーフ）
-    [[nodiscard]] bool HasPendingJobs() const noexcept
-    {
-        std::unique_lock<std::mutex> lock(globalMutex_);
-        return HasPendingJobsLocked() || HasLocalJobs();
-    }
-
-    bool TryPopJob(InternalJob& outJob)
-    {
-        for (int i = 0; i < static_cast<int>(JobPriority::Count); ++i) {
-            if (!globalQueues_[i].empty()) {
-                outJob = std::move(globalQueues_[i].front());
-                globalQueues_[i].pop_front();
-                return true;
-            }
-        }
-        return false;
-    }
-
-    bool TryStealJob(InternalJob& outJob, uint32_t thiefId)
-    {
-        // 他のワーカーのローカルキューから盗む
-        for (size_t i = 0; i < localQueues_.size(); ++i) {
-            if (i == thiefId) continue;
-
-            std::unique_lock<std::mutex> lock(localQueueMutexes_[i], std::try_to_lock);
-            if (!lock.owns_lock()) continue;
-
-            if (!localQueues_[i].empty()) {
-                outJob = std::move(localQueues_[i].back());
-                localQueues_[i].pop_back();
-#ifdef _DEBUG
-                ++stats_.totalJobsStolen;
-#endif
-                return true;
-            }
-        }
-        return false;
     }
 
     // スレッド管理
     std::vector<std::thread> workers_;
     std::thread::id mainThreadId_;
 
-    // グローバルキュー（優先度別）
-    std::deque<InternalJob> globalQueues_[static_cast<int>(JobPriority::Count)];
-    mutable std::mutex globalMutex_;
-    std::condition_variable globalCondition_;
+    // ローカルキュー（ワーカー + メインスレッド、優先度別ワークスティーリングデック）
+    std::unique_ptr<LocalQueues[]> localQueues_;
+    uint32_t localQueueCount_ = 0;
+    int32_t mainQueueIndex_ = -1;
 
-    // ローカルキュー（Work-Stealing用）
-    std::vector<std::deque<InternalJob>> localQueues_;
-    std::unique_ptr<std::mutex[]> localQueueMutexes_;
+    // 外部キュー（ワーカー/メインスレッド以外からの投入、優先度別）
+    std::deque<InternalJob*> externalQueues_[static_cast<int>(JobPriority::Count)];
+    std::mutex externalMutex_;
+    std::atomic<uint32_t> externalJobCount_{0};
 
     // メインスレッドキュー
     std::deque<InternalJob> mainThreadQueue_;
@@ -747,8 +1118,12 @@ private:
     std::mutex frameMutex_;
 
     // 状態
-    std::atomic<uint32_t> pendingJobs_{0};
-    bool running_ = false;
+    alignas(64) std::atomic<uint32_t> pendingJobs_{0};      //!< キュー内のジョブ数
+    alignas(64) std::atomic<uint32_t> outstandingJobs_{0};  //!< 投入済みで未完了のジョブ数
+    std::atomic<uint32_t> allJobsWaiters_{0};
+    alignas(64) std::atomic<uint32_t> wakeEpoch_{0};
+    std::atomic<uint32_t> sleepingWorkers_{0};
+    std::atomic<bool> running_{false};
 
 #ifdef _DEBUG
     // プロファイリング
@@ -853,6 +1228,14 @@ void JobSystem::WaitAll()
     impl_->WaitAll();
 }
 
+void JobSystem::WaitForCounter(const JobCounter& counter)
+{
+    if (impl_ && impl_->HelpUntilComplete(counter)) {
+        return;
+    }
+    counter.WaitBlocking();
+}
+
 //----------------------------------------------------------------------------
 // 並列ループ
 //----------------------------------------------------------------------------
@@ -871,6 +1254,13 @@ JobHandle JobSystem::ParallelForRange(uint32_t begin, uint32_t end,
     return impl_->ParallelForRange(begin, end, func, granularity);
 }
 
+JobHandle JobSystem::SubmitParallelRange(uint32_t begin, uint32_t end,
+                                         std::unique_ptr<ParallelRangeBody> body,
+                                         const ParallelForDesc& desc)
+{
+    return impl_->SubmitParallelRange(begin, end, std::move(body), desc);
+}
+
 //----------------------------------------------------------------------------
 // 状態取得
 //----------------------------------------------------------------------------
@@ -890,6 +1280,11 @@ uint32_t JobSystem::GetPendingJobCount() const noexcept
     return impl_ ? impl_->GetPendingJobCount() : 0;
 }
 
+uint64_t JobSystem::GetHeapAllocationCount() noexcept
+{
+    return g_heapAllocations.load(std::memory_order_relaxed);
+}
+
 //----------------------------------------------------------------------------
 // プロファイリング
 //----------------------------------------------------------------------------
@@ -7,8 +7,10 @@
 
 #include "common/stl/stl_common.h"
 #include "common/stl/stl_threading.h"
+#include <span>
 #include "common/stl/stl_metaprogramming.h"
 #include "common/utility/non_copyable.h"
+#include "inline_function.h"
 
 //! @brief ジョブ優先度
 enum class JobPriority : uint8_t {
@@ -56,13 +58,21 @@ using CancelTokenPtr = std::shared_ptr<CancelToken>;
 
 //============================================================================
 //! @brief ジョブカウンター（依存関係管理用）
+//!
+//! カウントはアトミック変数のみで管理する（mutex/condvarなし）。
+//! Wait()はJobSystemが存在すれば待機中に他のジョブを実行し、
+//! 実行できるジョブがなくなったらアトミック待機でブロックする（ワーカーも同様）。
+//!
+//! @note Wait()中に任意のジョブが実行されうるため、
+//!       ジョブと共有するロックを保持したまま呼び出さないこと
+//! @note JobSystem内部で生成するカウンターはプールから確保・再利用される
 //============================================================================
 class JobCounter
 {
 public:
-    JobCounter();
-    explicit JobCounter(uint32_t initialCount);
-    ~JobCounter();
+    JobCounter() = default;
+    explicit JobCounter(uint32_t initialCount) : count_(initialCount) {}
+    ~JobCounter() = default;
 
     JobCounter(const JobCounter&) = delete;
     JobCounter& operator=(const JobCounter&) = delete;
@@ -81,17 +91,160 @@ public:
     [[nodiscard]] JobResult GetResult() const noexcept;
 
 private:
-    class Impl;
-    std::unique_ptr<Impl> impl_;
+    friend class JobSystem;
+
+    //! @brief ジョブを実行せずにブロッキング待機
+    void WaitBlocking() const noexcept;
+
+    //! @brief 待機中のスレッドがいれば起こす
+    void NotifyWaiters() noexcept;
+
+    std::atomic<uint32_t> count_{0};
+    std::atomic<JobResult> result_{JobResult::Pending};
+    mutable std::atomic<uint32_t> waiters_{0};
 };
 
 using JobCounterPtr = std::shared_ptr<JobCounter>;
 
-//! @brief ジョブ関数型
-using JobFunction = std::function<void()>;
+//! @brief ジョブ関数型（64バイト以下のキャプチャはヒープ確保なし）
+using JobFunction = InlineFunction<void(), 64>;
+
+//! @brief キャンセル対応ジョブ関数型（64バイト以下のキャプチャはヒープ確保なし）
+using CancellableJobFunction = InlineFunction<void(const CancelToken&), 64>;
+
+namespace detail {
+
+//! @brief ジョブ投入経路でのヒープ確保を記録（JobSystem::GetHeapAllocationCount()で参照）
+void NoteJobHeapAllocation() noexcept;
 
-//! @brief キャンセル対応ジョブ関数型
-using CancellableJobFunction = std::function<void(const CancelToken&)>;
+} // namespace detail
+
+//! @brief 並列ループの分割方式
+enum class ParallelForPartition : uint8_t {
+    Static = 0,   //!< 投入時に固定粒度で分割し、1スライス1ジョブ（従来動作）
+    Dynamic = 1   //!< ワーカー数分のジョブがアトミックカーソルで「次のスライス」を取り合う
+};
+
+//============================================================================
+//! @brief 並列ループ記述子
+//!
+//! ParallelFor/ParallelForRangeの分割方法を呼び出しごとに指定する。
+//!
+//! @code
+//!   // 要素ごとのコスト（例: Chunk内のエンティティ数）で均等化し、動的に取り合う
+//!   auto handle = JobSystem::Get().ParallelForRange(0, chunkCount, body,
+//!       ParallelForDesc().SetPartition(ParallelForPartition::Dynamic).SetItemCosts(entityCounts));
+//! @endcode
+//============================================================================
+class ParallelForDesc
+{
+public:
+    ParallelForDesc() = default;
+
+    //! @brief 分割方式を設定
+    ParallelForDesc& SetPartition(ParallelForPartition partition) {
+        partition_ = partition;
+        return *this;
+    }
+
+    //! @brief 粒度を設定（0 = 自動）
+    //! @note コストヒント指定時は1スライスあたりの目標コストとして扱う
+    ParallelForDesc& SetGranularity(uint32_t granularity) {
+        granularity_ = granularity;
+        return *this;
+    }
+
+    //! @brief 要素ごとのコストヒントを設定（要素数と同じ長さ）
+    //! @note 投入時にスライス境界の計算にのみ使用する（ジョブ実行中は参照しない）
+    ParallelForDesc& SetItemCosts(std::span<const uint32_t> itemCosts) {
+        itemCosts_ = itemCosts;
+        return *this;
+    }
+
+    [[nodiscard]] ParallelForPartition GetPartition() const noexcept { return partition_; }
+    [[nodiscard]] uint32_t GetGranularity() const noexcept { return granularity_; }
+    [[nodiscard]] std::span<const uint32_t> GetItemCosts() const noexcept { return itemCosts_; }
+
+private:
+    ParallelForPartition partition_ = ParallelForPartition::Static;
+    uint32_t granularity_ = 0;
+    std::span<const uint32_t> itemCosts_;
+};
+
+//============================================================================
+//! @brief 並列ループ本体（ParallelFor/ParallelForRangeのテンプレート版で使用）
+//!
+//! ループ関数を呼び出し1回につき1度だけ保持し、全スライスで共有する。
+//! スライスごとの関数コピーや型消去ラッパーの生成は行わない。
+//! 本体はJobSystemのブロックプールから確保し、収まらない場合のみヒープを使う。
+//============================================================================
+class ParallelRangeBody
+{
+public:
+    virtual ~ParallelRangeBody() = default;
+
+    //! @name 確保（派生型のサイズがプールのブロックに収まればプールから確保）
+    //!@{
+    [[nodiscard]] static void* operator new(size_t size);
+    [[nodiscard]] static void* operator new(size_t size, std::align_val_t align);
+    static void operator delete(void* ptr, size_t size) noexcept;
+    static void operator delete(void* ptr, size_t size, std::align_val_t align) noexcept;
+    //!@}
+
+    //! @brief [begin, end) を処理
+    virtual void Execute(uint32_t begin, uint32_t end) = 0;
+
+private:
+    friend class JobSystem;
+
+    //! @name スライス情報（JobSystem内部使用）
+    //!@{
+    std::atomic<uint32_t> remainingJobs_{0};  //!< 未完了ジョブ数（最後のジョブが本体を破棄する）
+    std::atomic<uint32_t> cursor_{0};         //!< Dynamic: 次に処理するスライス
+    uint32_t begin_ = 0;
+    uint32_t end_ = 0;
+    uint32_t grain_ = 1;                      //!< 均等分割時のスライス幅
+    uint32_t sliceCount_ = 0;
+    std::vector<uint32_t> sliceBounds_;       //!< コスト分割時のスライス境界（sliceCount_ + 1個）
+    //!@}
+};
+
+namespace detail {
+
+//! @brief 範囲関数 void(uint32_t begin, uint32_t end) を保持する本体
+template<typename Func>
+class ParallelRangeBodyImpl final : public ParallelRangeBody
+{
+public:
+    template<typename F>
+    explicit ParallelRangeBodyImpl(F&& func) : func_(std::forward<F>(func)) {}
+
+    void Execute(uint32_t begin, uint32_t end) override { func_(begin, end); }
+
+private:
+    Func func_;
+};
+
+//! @brief 要素関数 void(uint32_t index) を保持する本体
+template<typename Func>
+class ParallelForBodyImpl final : public ParallelRangeBody
+{
+public:
+    template<typename F>
+    explicit ParallelForBodyImpl(F&& func) : func_(std::forward<F>(func)) {}
+
+    void Execute(uint32_t begin, uint32_t end) override
+    {
+        for (uint32_t i = begin; i < end; ++i) {
+            func_(i);
+        }
+    }
+
+private:
+    Func func_;
+};
+
+} // namespace detail
 
 //============================================================================
 //! @brief ジョブハンドル
@@ -111,7 +264,7 @@ public:
         return counter_ && counter_->IsComplete();
     }
 
-    //! @brief ジョブの完了を待機
+    //! @brief ジョブの完了を待機（待機中は他のジョブを実行する）
     void Wait() const noexcept {
         if (counter_) counter_->Wait();
     }
@@ -242,6 +395,9 @@ public:
     //! @brief 依存ジョブを追加（このジョブより先に完了する必要がある）
     JobDesc& AddDependency(const JobHandle& dependency) {
         if (dependency.IsValid()) {
+            if (dependencies_.size() == dependencies_.capacity()) {
+                detail::NoteJobHeapAllocation();
+            }
             dependencies_.push_back(dependency.GetCounter());
         }
         return *this;
@@ -352,6 +508,56 @@ public:
     [[nodiscard]] virtual JobHandle ParallelForRange(uint32_t begin, uint32_t end,
                                                      const std::function<void(uint32_t, uint32_t)>& func,
                                                      uint32_t granularity = 0) = 0;
+
+    //! @brief 並列ループ本体を分割して投入（テンプレート版ParallelFor/ParallelForRangeの実体）
+    //! @param body ループ本体（全スライス完了後にJobSystemが破棄する）
+    //! @param desc 分割方式・粒度・コストヒント
+    [[nodiscard]] virtual JobHandle SubmitParallelRange(uint32_t begin, uint32_t end,
+                                                        std::unique_ptr<ParallelRangeBody> body,
+                                                        const ParallelForDesc& desc) = 0;
+
+    //! @brief 任意のファンクタで並列ループ（スライスごとの型消去・コピーなし）
+    //! @code
+    //!   auto handle = JobSystem::Get().ParallelFor(0, count, [&](uint32_t i) { Process(i); });
+    //! @endcode
+    template<typename Func,
+             std::enable_if_t<std::is_invocable_v<std::decay_t<Func>&, uint32_t> &&
+                              !std::is_same_v<std::decay_t<Func>, std::function<void(uint32_t)>>, int> = 0>
+    [[nodiscard]] JobHandle ParallelFor(uint32_t begin, uint32_t end, Func&& func, uint32_t granularity = 0)
+    {
+        return ParallelFor(begin, end, std::forward<Func>(func), ParallelForDesc().SetGranularity(granularity));
+    }
+
+    //! @brief 分割方式を指定して並列ループ
+    template<typename Func,
+             std::enable_if_t<std::is_invocable_v<std::decay_t<Func>&, uint32_t>, int> = 0>
+    [[nodiscard]] JobHandle ParallelFor(uint32_t begin, uint32_t end, Func&& func, const ParallelForDesc& desc)
+    {
+        if (begin >= end) return JobHandle();
+        return SubmitParallelRange(begin, end,
+            std::make_unique<detail::ParallelForBodyImpl<std::decay_t<Func>>>(std::forward<Func>(func)),
+            desc);
+    }
+
+    //! @brief 任意のファンクタで範囲並列ループ（スライスごとの型消去・コピーなし）
+    template<typename Func,
+             std::enable_if_t<std::is_invocable_v<std::decay_t<Func>&, uint32_t, uint32_t> &&
+                              !std::is_same_v<std::decay_t<Func>, std::function<void(uint32_t, uint32_t)>>, int> = 0>
+    [[nodiscard]] JobHandle ParallelForRange(uint32_t begin, uint32_t end, Func&& func, uint32_t granularity = 0)
+    {
+        return ParallelForRange(begin, end, std::forward<Func>(func), ParallelForDesc().SetGranularity(granularity));
+    }
+
+    //! @brief 分割方式を指定して範囲並列ループ
+    template<typename Func,
+             std::enable_if_t<std::is_invocable_v<std::decay_t<Func>&, uint32_t, uint32_t>, int> = 0>
+    [[nodiscard]] JobHandle ParallelForRange(uint32_t begin, uint32_t end, Func&& func, const ParallelForDesc& desc)
+    {
+        if (begin >= end) return JobHandle();
+        return SubmitParallelRange(begin, end,
+            std::make_unique<detail::ParallelRangeBodyImpl<std::decay_t<Func>>>(std::forward<Func>(func)),
+            desc);
+    }
     //!@}
 
     //------------------------------------------------------------------------
@@ -431,6 +637,9 @@ public:
     static void Destroy();
     [[nodiscard]] static bool IsCreated() noexcept { return instance_ != nullptr; }
 
+    //! @brief 作成済みでワーカーを持つか（ジョブを投入して並列実行できるか）
+    [[nodiscard]] static bool HasWorkers() noexcept { return instance_ && instance_->GetWorkerCount() > 0; }
+
     //------------------------------------------------------------------------
     // IJobSystem 実装
     //------------------------------------------------------------------------
@@ -452,12 +661,26 @@ public:
     [[nodiscard]] JobHandle ParallelForRange(uint32_t begin, uint32_t end,
                                              const std::function<void(uint32_t, uint32_t)>& func,
                                              uint32_t granularity = 0) override;
+    [[nodiscard]] JobHandle SubmitParallelRange(uint32_t begin, uint32_t end,
+                                                std::unique_ptr<ParallelRangeBody> body,
+                                                const ParallelForDesc& desc) override;
+    using IJobSystem::ParallelFor;
+    using IJobSystem::ParallelForRange;
 
     [[nodiscard]] uint32_t GetWorkerCount() const noexcept override;
     [[nodiscard]] bool IsWorkerThread() const noexcept override;
     [[nodiscard]] uint32_t GetPendingJobCount() const noexcept override;
     [[nodiscard]] uint32_t GetMainThreadJobCount() const noexcept override;
 
+    //! @brief ジョブ投入経路でヒープ確保が発生した回数（全インスタンス累計、全ビルド構成で有効）
+    //!
+    //! ジョブ・カウンター用プールの不足、JobFunctionのインライン格納超過、
+    //! 依存リストの拡張、並列ループ本体のプール外確保、コスト分割境界の拡張、
+    //! ワーカーデックの拡張をそれぞれ1回として数える。
+    //! メインスレッド専用ジョブとワーカー外スレッドからの投入が使うキュー、
+    //! std::function版ParallelForの関数コピー、CancelTokenの生成は対象外。
+    [[nodiscard]] static uint64_t GetHeapAllocationCount() noexcept;
+
     //------------------------------------------------------------------------
     //! @name プロファイリング（デバッグビルドのみ、具象クラス専用）
     //------------------------------------------------------------------------
@@ -484,8 +707,13 @@ public:
     ~JobSystem() override;
 
 private:
+    friend class JobCounter;
+
     JobSystem() = default;
 
+    //! @brief カウンター完了まで他のジョブを実行しながら待機（JobCounter::Wait()から呼ばれる）
+    void WaitForCounter(const JobCounter& counter);
+
     void Initialize(uint32_t numWorkers);
     void Shutdown();
 
@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------
+//! @file   work_stealing_deque.h
+//! @brief  Chase-Lev ワークスティーリングデック（ロックフリー）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "common/stl/stl_common.h"
+#include "common/stl/stl_threading.h"
+#include <cassert>
+
+//============================================================================
+//! @brief Chase-Lev ワークスティーリングデック
+//!
+//! 所有スレッドは底（bottom）側でPush/Popを行い（LIFO）、
+//! 他スレッドは頂（top）側からStealする（FIFO）。
+//! 所有スレッドのPush/Popはアトミック操作のみで完結し、
+//! 競合が発生するのは最後の1要素を取り合う場合のみ。
+//!
+//! @tparam T 要素型（ポインタ等のトリビアルコピー可能な型）
+//!
+//! @note Push/Popは所有スレッドのみ、Stealは任意スレッドから呼び出し可能
+//! @note 拡張時の旧バッファは破棄まで保持する（Steal中の読み取り保護）
+//! @see  Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013)
+//============================================================================
+template<typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires trivially copyable elements");
+
+public:
+    //! @brief デフォルト初期容量
+    static constexpr int64_t kDefaultCapacity = 1024;
+
+    explicit WorkStealingDeque(int64_t capacity = kDefaultCapacity)
+    {
+        assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "Capacity must be a power of two");
+        garbage_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(garbage_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    //------------------------------------------------------------------------
+    //! @brief 底に要素を追加（所有スレッドのみ）
+    //! @return バッファを拡張した（ヒープ確保した）場合true
+    //------------------------------------------------------------------------
+    bool Push(T item)
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        const bool grown = b - t > buffer->capacity - 1;
+        if (grown) {
+            buffer = Grow(buffer, b, t);
+        }
+
+        buffer->Put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return grown;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 底から要素を取り出す（所有スレッドのみ）
+    //! @return 取り出せたらtrue
+    //------------------------------------------------------------------------
+    bool Pop(T& outItem)
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // 空
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        outItem = buffer->Get(b);
+        if (t == b) {
+            // 最後の1要素: Stealと競合するのでCASで確定
+            const bool won = top_.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 頂から要素を盗む（任意スレッド）
+    //! @return 盗めたらtrue（空または他スレッドとの競合に負けた場合false）
+    //------------------------------------------------------------------------
+    bool Steal(T& outItem)
+    {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T item = buffer->Get(t);
+        if (!top_.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        outItem = item;
+        return true;
+    }
+
+    //! @brief 概算要素数（他スレッドからの参照は目安）
+    [[nodiscard]] int64_t SizeApprox() const noexcept
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    //! @brief 空か（概算）
+    [[nodiscard]] bool IsEmptyApprox() const noexcept { return SizeApprox() == 0; }
+
+private:
+    //! @brief 循環バッファ
+    struct Buffer {
+        explicit Buffer(int64_t cap)
+            : capacity(cap), mask(cap - 1), slots(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(cap))) {}
+
+        void Put(int64_t index, T item) noexcept {
+            slots[static_cast<size_t>(index & mask)].store(item, std::memory_order_relaxed);
+        }
+        [[nodiscard]] T Get(int64_t index) const noexcept {
+            return slots[static_cast<size_t>(index & mask)].load(std::memory_order_relaxed);
+        }
+
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    //! @brief バッファを2倍に拡張（所有スレッドのみ）
+    Buffer* Grow(Buffer* old, int64_t bottom, int64_t top)
+    {
+        auto grown = std::make_unique<Buffer>(old->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            grown->Put(i, old->Get(i));
+        }
+        Buffer* raw = grown.get();
+        garbage_.push_back(std::move(grown));
+        buffer_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    // 所有スレッド（Push/Pop）と盗むスレッド（Steal）で別キャッシュラインに配置
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> garbage_;  //!< 全バッファ（旧バッファ含む）
+};
@@ -52,12 +52,48 @@ struct InOut {
     static constexpr bool IsWriteOnly = false;
 };
 
+//============================================================================
+//! @brief 変更フィルタ付きアクセス
+//!
+//! 前回のSystem実行以降に書き込まれたChunkのみを処理する。
+//! アクセスモードを包んで指定し、ラムダには包んだアクセスモードと同じ型で渡される。
+//! 複数指定した場合は、いずれかが変更されたChunkを処理する。
+//!
+//! 基準となるバージョンは実行中SystemのSystemState::lastRunVersion
+//! （System外から呼んだ場合は0 = 全Chunkを処理）。
+//! 変更判定はChunk単位・フレーム単位のため、変更されたChunkは
+//! 変更フレームと次のフレームの2回処理される。
+//!
+//! @tparam T アクセスモード（In<U>/InOut<U>）。CachedQueryではコンポーネント型
+//!
+//! @code
+//! world.ForEach<Changed<In<LocalToWorld>>, InOut<WorldRenderBoundsData>>(
+//!     [](Actor e, const LocalToWorld& ltw, WorldRenderBoundsData& bounds) {
+//!         // LocalToWorldが変更されたChunkのみ
+//!     });
+//! @endcode
+//!
+//! @note Changed<InOut<T>>は自身の書き込みで毎回変更扱いになる。
+//!       通常は読み取り側（Changed<In<T>>）に指定する
+//============================================================================
+template<typename T>
+struct Changed {
+    using Type = T;
+};
+
 //============================================================================
 // 型特性（Type Traits）
 //============================================================================
 
 namespace detail {
 
+// Changed<T> 判定
+template<typename T>
+struct is_changed : std::false_type {};
+
+template<typename T>
+struct is_changed<Changed<T>> : std::true_type {};
+
 // In<T> 判定
 template<typename T>
 struct is_in : std::false_type {};
@@ -65,6 +101,9 @@ struct is_in : std::false_type {};
 template<typename T>
 struct is_in<In<T>> : std::true_type {};
 
+template<typename T>
+struct is_in<Changed<T>> : is_in<T> {};
+
 // InOut<T> 判定
 template<typename T>
 struct is_inout : std::false_type {};
@@ -72,6 +111,9 @@ struct is_inout : std::false_type {};
 template<typename T>
 struct is_inout<InOut<T>> : std::true_type {};
 
+template<typename T>
+struct is_inout<Changed<T>> : is_inout<T> {};
+
 // アクセスモード判定（In/InOutのいずれか）
 template<typename T>
 struct is_access_mode : std::bool_constant<
@@ -94,6 +136,11 @@ struct unwrap_access<InOut<T>> {
     using type = T;
 };
 
+template<typename T>
+struct unwrap_access<Changed<T>> {
+    using type = typename unwrap_access<T>::type;
+};
+
 } // namespace detail
 
 //============================================================================
@@ -109,6 +156,13 @@ inline constexpr bool is_inout_v = detail::is_inout<T>::value;
 template<typename T>
 inline constexpr bool is_access_mode_v = detail::is_access_mode<T>::value;
 
+template<typename T>
+inline constexpr bool is_changed_v = detail::is_changed<T>::value;
+
+//! @brief Changed<T>を1つ以上含むか
+template<typename... Ts>
+inline constexpr bool has_changed_filter_v = (is_changed_v<Ts> || ...);
+
 //! @brief 全ての型がアクセスモード（In/InOut）かどうか
 template<typename... Ts>
 inline constexpr bool all_are_access_modes_v = (is_access_mode_v<Ts> && ...);
@@ -132,6 +186,9 @@ struct arg_type<In<T>> {
     using type = const T&;  // In<T>はconst T&
 };
 
+template<typename T>
+struct arg_type<Changed<T>> : arg_type<T> {};
+
 } // namespace detail
 
 template<typename AccessMode>
@@ -153,6 +210,9 @@ struct is_read_access<In<T>> : std::true_type {};
 template<typename T>
 struct is_read_access<InOut<T>> : std::true_type {};
 
+template<typename T>
+struct is_read_access<Changed<T>> : is_read_access<T> {};
+
 //! 書き込みアクセスかどうか（InOut<T>）
 template<typename T>
 struct is_write_access : std::false_type {};
@@ -160,6 +220,9 @@ struct is_write_access : std::false_type {};
 template<typename T>
 struct is_write_access<InOut<T>> : std::true_type {};
 
+template<typename T>
+struct is_write_access<Changed<T>> : is_write_access<T> {};
+
 //============================================================================
 // 型リストフィルタリング（Read/Write抽出）
 //============================================================================
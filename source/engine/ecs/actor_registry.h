@@ -222,6 +222,8 @@ public:
     //! @tparam T コンポーネントの型
     //! @param actor 対象のアクター
     //! @return コンポーネントへのポインタ（存在しない場合はnullptr）
+    //!
+    //! @note 非const版は書き込みとみなし、所属Chunkのバージョンを更新する
     //------------------------------------------------------------------------
     template<typename T>
     [[nodiscard]] T* Get(Actor actor) {
@@ -234,7 +236,11 @@ public:
             return nullptr;
         }
 
-        return rec.archetype->GetComponent<T>(rec.chunkIndex, rec.indexInChunk);
+        T* comp = rec.archetype->GetComponent<T>(rec.chunkIndex, rec.indexInChunk);
+        if (comp) {
+            rec.archetype->MarkComponentWritten<T>(rec.chunkIndex, archetypes_.GetWriteVersion());
+        }
+        return comp;
     }
 
     template<typename T>
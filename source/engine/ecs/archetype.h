@@ -9,9 +9,11 @@
 #include "common/stl/stl_containers.h"
 #include "common/stl/stl_metaprogramming.h"
 #include "common/utility/non_copyable.h"
+#include <atomic>
 #include "actor.h"
 #include "chunk.h"
 #include "component_data.h"
+#include "component_type_id.h"
 #include "buffer/buffer_element.h"
 #include "buffer/buffer_header.h"
 #include "buffer/internal_buffer_capacity.h"
@@ -30,6 +32,7 @@ static constexpr ArchetypeId kInvalidArchetypeId = 0;
 //============================================================================
 struct ComponentInfo {
     std::type_index type;
+    ComponentTypeId typeId; //!< 連番の型ID（列インデックス表・シグネチャ用）
     size_t size;
     size_t alignment;
     size_t offset;          //!< コンポーネントデータ内のオフセット
@@ -38,13 +41,15 @@ struct ComponentInfo {
     int32_t inlineCapacity; //!< インライン容量（isBuffer時のみ有効）
 
     ComponentInfo(std::type_index t, size_t s, size_t a, size_t o = 0)
-        : type(t), size(s), alignment(a), offset(o)
+        : type(t), typeId(ComponentTypeRegistry::GetOrRegister(t))
+        , size(s), alignment(a), offset(o)
         , isBuffer(false), elementSize(0), inlineCapacity(0) {}
 
     //! @brief バッファコンポーネント用コンストラクタ
     ComponentInfo(std::type_index t, size_t s, size_t a,
                   size_t elemSize, int32_t inlineCap)
-        : type(t), size(s), alignment(a), offset(0)
+        : type(t), typeId(ComponentTypeRegistry::GetOrRegister(t))
+        , size(s), alignment(a), offset(0)
         , isBuffer(true), elementSize(elemSize), inlineCapacity(inlineCap) {}
 
     bool operator<(const ComponentInfo& other) const {
@@ -65,6 +70,9 @@ struct ComponentInfo {
 //! 各コンポーネント型が連続配置されることで、ForEach時のキャッシュ効率が向上。
 //============================================================================
 class Archetype : private NonCopyable {
+    //! 型ID→列インデックス表の「列なし」
+    static constexpr uint16_t kNoColumn = UINT16_MAX;
+
 public:
     //------------------------------------------------------------------------
     //! @brief Chunk毎のメタデータ
@@ -88,6 +96,18 @@ public:
             componentVersions.resize(componentCount, 0);
         }
 
+        //! @brief バージョンを読み取る
+        //! @note 並列System間で同じChunkのバージョンを読み書きするためアトミックに扱う
+        [[nodiscard]] uint32_t LoadVersion(size_t compIndex) const noexcept {
+            return std::atomic_ref<uint32_t>(const_cast<uint32_t&>(componentVersions[compIndex]))
+                .load(std::memory_order_relaxed);
+        }
+
+        //! @brief バージョンを書き込む
+        void StoreVersion(size_t compIndex, uint32_t version) noexcept {
+            std::atomic_ref<uint32_t>(componentVersions[compIndex]).store(version, std::memory_order_relaxed);
+        }
+
         //! @brief 有効ビット配列を初期化（デフォルト全有効）
         void InitEnabledBits(size_t componentCount, uint16_t capacity) {
             size_t wordsPerComp = (capacity + 63) / 64;
@@ -153,15 +173,30 @@ public:
         : components_(std::move(components))
     {
         CalculateLayout();
+        BuildTypeTable();
         id_ = CalculateId();
     }
 
+    //! @brief デストラクタ（残っているActorのバッファ外部ストレージを解放）
+    ~Archetype() {
+        const bool hasBuffers = std::any_of(components_.begin(), components_.end(),
+            [](const ComponentInfo& info) { return info.isBuffer; });
+        if (!hasBuffers) return;
+
+        for (size_t ci = 0; ci < chunkMetas_.size(); ++ci) {
+            for (uint16_t i = 0; i < chunkMetas_[ci].count; ++i) {
+                CleanupBuffers(static_cast<uint32_t>(ci), i);
+            }
+        }
+    }
+
     //------------------------------------------------------------------------
     // アクセサ
     //------------------------------------------------------------------------
 
     [[nodiscard]] ArchetypeId GetId() const noexcept { return id_; }
     [[nodiscard]] const std::vector<ComponentInfo>& GetComponents() const noexcept { return components_; }
+    [[nodiscard]] const ComponentSignature& GetSignature() const noexcept { return signature_; }
     [[nodiscard]] uint16_t GetChunkCapacity() const noexcept { return chunkCapacity_; }
 
     [[nodiscard]] size_t GetActorCount() const noexcept {
@@ -199,35 +234,28 @@ public:
     //------------------------------------------------------------------------
     template<typename T>
     [[nodiscard]] const ComponentInfo* GetComponentInfo() const noexcept {
-        std::type_index typeIdx = std::type_index(typeid(T));
-        for (const auto& info : components_) {
-            if (info.type == typeIdx) return &info;
-        }
-        return nullptr;
+        return GetComponentInfoById(ComponentTypeRegistry::Get<T>());
     }
 
     [[nodiscard]] const ComponentInfo* GetComponentInfo(std::type_index typeIdx) const noexcept {
-        for (const auto& info : components_) {
-            if (info.type == typeIdx) return &info;
-        }
-        return nullptr;
+        return GetComponentInfoById(ComponentTypeRegistry::Find(typeIdx));
+    }
+
+    [[nodiscard]] const ComponentInfo* GetComponentInfoById(ComponentTypeId typeId) const noexcept {
+        const size_t index = GetComponentIndexById(typeId);
+        return index != SIZE_MAX ? &components_[index] : nullptr;
     }
 
     template<typename T>
     [[nodiscard]] bool HasComponent() const noexcept {
-        return GetComponentInfo<T>() != nullptr;
+        return signature_.Test(ComponentTypeRegistry::Get<T>());
     }
 
     //! @brief 型インデックスでコンポーネントを所持しているか確認
     //! @param typeIdx コンポーネントの型インデックス
     //! @return 所持している場合はtrue
     [[nodiscard]] bool HasComponentByTypeIndex(std::type_index typeIdx) const noexcept {
-        for (const auto& info : components_) {
-            if (info.type == typeIdx) {
-                return true;
-            }
-        }
-        return false;
+        return GetComponentInfo(typeIdx) != nullptr;
     }
 
     template<typename T>
@@ -272,18 +300,18 @@ public:
     //------------------------------------------------------------------------
     template<typename T>
     [[nodiscard]] size_t GetComponentIndex() const noexcept {
-        std::type_index typeIdx = std::type_index(typeid(T));
-        for (size_t i = 0; i < components_.size(); ++i) {
-            if (components_[i].type == typeIdx) return i;
-        }
-        return SIZE_MAX;
+        return GetComponentIndexById(ComponentTypeRegistry::Get<T>());
     }
 
     [[nodiscard]] size_t GetComponentIndex(std::type_index typeIdx) const noexcept {
-        for (size_t i = 0; i < components_.size(); ++i) {
-            if (components_[i].type == typeIdx) return i;
-        }
-        return SIZE_MAX;
+        return GetComponentIndexById(ComponentTypeRegistry::Find(typeIdx));
+    }
+
+    //! @brief 型IDからコンポーネントのインデックスを取得（配列参照のみ）
+    [[nodiscard]] size_t GetComponentIndexById(ComponentTypeId typeId) const noexcept {
+        if (typeId >= columnIndices_.size()) return SIZE_MAX;
+        const uint16_t index = columnIndices_[typeId];
+        return index != kNoColumn ? index : SIZE_MAX;
     }
 
     //------------------------------------------------------------------------
@@ -326,14 +354,14 @@ public:
         if (compIdx != SIZE_MAX && chunkIndex < chunkMetas_.size()) {
             ChunkMeta& meta = chunkMetas_[chunkIndex];
             if (compIdx < meta.componentVersions.size()) {
-                meta.componentVersions[compIdx] = version;
+                meta.StoreVersion(compIdx, version);
             }
         }
     }
 
     void MarkComponentWritten(size_t chunkIndex, size_t compIdx, uint32_t version) {
         if (chunkIndex < chunkMetas_.size() && compIdx < chunkMetas_[chunkIndex].componentVersions.size()) {
-            chunkMetas_[chunkIndex].componentVersions[compIdx] = version;
+            chunkMetas_[chunkIndex].StoreVersion(compIdx, version);
         }
     }
 
@@ -349,7 +377,7 @@ public:
         if (compIdx != SIZE_MAX && chunkIndex < chunkMetas_.size()) {
             const ChunkMeta& meta = chunkMetas_[chunkIndex];
             if (compIdx < meta.componentVersions.size()) {
-                return meta.componentVersions[compIdx];
+                return meta.LoadVersion(compIdx);
             }
         }
         return 0;
@@ -357,11 +385,34 @@ public:
 
     [[nodiscard]] uint32_t GetComponentVersion(size_t chunkIndex, size_t compIdx) const noexcept {
         if (chunkIndex < chunkMetas_.size() && compIdx < chunkMetas_[chunkIndex].componentVersions.size()) {
-            return chunkMetas_[chunkIndex].componentVersions[compIdx];
+            return chunkMetas_[chunkIndex].LoadVersion(compIdx);
         }
         return 0;
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 指定バージョン以降（同じバージョンを含む）に書き込まれたか
+    //! @param chunkIndex Chunkインデックス
+    //! @param compIdx コンポーネントインデックス（SIZE_MAXは常にfalse）
+    //! @param sinceVersion 基準バージョン（前回のSystem実行時のバージョン）
+    //!
+    //! 同じフレーム内で後から書き込まれた変更を取りこぼさないよう、
+    //! 基準と同じバージョンも変更ありとみなす。
+    //------------------------------------------------------------------------
+    [[nodiscard]] bool DidChange(size_t chunkIndex, size_t compIdx, uint32_t sinceVersion) const noexcept {
+        return compIdx != SIZE_MAX && GetComponentVersion(chunkIndex, compIdx) >= sinceVersion;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Actor配置時に参照する書き込みバージョンを設定
+    //! @param source ArchetypeStorageの現在の書き込みバージョン
+    //!
+    //! Actorが配置されたChunkは全コンポーネントを書き込み済みとして扱う。
+    //------------------------------------------------------------------------
+    void SetWriteVersionSource(const std::atomic<uint32_t>* source) noexcept {
+        writeVersionSource_ = source;
+    }
+
     //------------------------------------------------------------------------
     //! @brief Chunk内のActor配列へのポインタを取得
     //------------------------------------------------------------------------
@@ -480,13 +531,8 @@ public:
     [[nodiscard]] bool HasBuffer() const noexcept {
         static_assert(is_buffer_element_v<T>,
             "T must inherit from IBufferElement and be trivially_copyable");
-        std::type_index typeIdx = std::type_index(typeid(T));
-        for (const auto& info : components_) {
-            if (info.type == typeIdx && info.isBuffer) {
-                return true;
-            }
-        }
-        return false;
+        const ComponentInfo* info = GetComponentInfo<T>();
+        return info && info->isBuffer;
     }
 
     //------------------------------------------------------------------------
@@ -501,19 +547,17 @@ public:
         static_assert(is_buffer_element_v<T>,
             "T must inherit from IBufferElement and be trivially_copyable");
 
-        std::type_index typeIdx = std::type_index(typeid(T));
-        for (size_t compIdx = 0; compIdx < components_.size(); ++compIdx) {
-            const auto& info = components_[compIdx];
-            if (info.type == typeIdx && info.isBuffer) {
-                // SoA: GetComponentAtにコンポーネントインデックスを渡す
-                std::byte* base = static_cast<std::byte*>(
-                    GetComponentAt(chunkIndex, indexInChunk, compIdx));
-                BufferHeader* header = reinterpret_cast<BufferHeader*>(base);
-                std::byte* inlineData = base + sizeof(BufferHeader);
-                return DynamicBuffer<T>(header, inlineData);
-            }
+        const size_t compIdx = GetComponentIndex<T>();
+        if (compIdx == SIZE_MAX || !components_[compIdx].isBuffer) {
+            return DynamicBuffer<T>();
         }
-        return DynamicBuffer<T>();
+
+        // SoA: GetComponentAtにコンポーネントインデックスを渡す
+        std::byte* base = static_cast<std::byte*>(
+            GetComponentAt(chunkIndex, indexInChunk, compIdx));
+        BufferHeader* header = reinterpret_cast<BufferHeader*>(base);
+        std::byte* inlineData = base + sizeof(BufferHeader);
+        return DynamicBuffer<T>(header, inlineData);
     }
 
     //------------------------------------------------------------------------
@@ -528,19 +572,17 @@ public:
         static_assert(is_buffer_element_v<T>,
             "T must inherit from IBufferElement and be trivially_copyable");
 
-        std::type_index typeIdx = std::type_index(typeid(T));
-        for (size_t compIdx = 0; compIdx < components_.size(); ++compIdx) {
-            const auto& info = components_[compIdx];
-            if (info.type == typeIdx && info.isBuffer) {
-                // SoA: GetComponentAtにコンポーネントインデックスを渡す
-                const std::byte* base = static_cast<const std::byte*>(
-                    GetComponentAt(chunkIndex, indexInChunk, compIdx));
-                const BufferHeader* header = reinterpret_cast<const BufferHeader*>(base);
-                const std::byte* inlineData = base + sizeof(BufferHeader);
-                return ConstDynamicBuffer<T>(header, inlineData);
-            }
+        const size_t compIdx = GetComponentIndex<T>();
+        if (compIdx == SIZE_MAX || !components_[compIdx].isBuffer) {
+            return ConstDynamicBuffer<T>();
         }
-        return ConstDynamicBuffer<T>();
+
+        // SoA: GetComponentAtにコンポーネントインデックスを渡す
+        const std::byte* base = static_cast<const std::byte*>(
+            GetComponentAt(chunkIndex, indexInChunk, compIdx));
+        const BufferHeader* header = reinterpret_cast<const BufferHeader*>(base);
+        const std::byte* inlineData = base + sizeof(BufferHeader);
+        return ConstDynamicBuffer<T>(header, inlineData);
     }
 
     //------------------------------------------------------------------------
@@ -554,6 +596,7 @@ public:
                 outIndexInChunk = chunkMetas_[i].count++;
                 Actor* actors = GetActorArray(i);
                 actors[outIndexInChunk] = actor;
+                MarkChunkWritten(i);
                 return true;
             }
         }
@@ -567,6 +610,7 @@ public:
         outIndexInChunk = chunkMetas_[outChunkIndex].count++;
         Actor* actors = GetActorArray(outChunkIndex);
         actors[outIndexInChunk] = actor;
+        MarkChunkWritten(outChunkIndex);
         return true;
     }
 
@@ -590,6 +634,9 @@ public:
             ChunkMeta& meta = chunkMetas_[ci];
             Actor* actorArray = GetActorArray(ci);
 
+            if (meta.count < chunkCapacity_) {
+                MarkChunkWritten(ci);
+            }
             while (meta.count < chunkCapacity_ && actorIdx < totalActors) {
                 uint16_t indexInChunk = meta.count++;
                 actorArray[indexInChunk] = actors[actorIdx];
@@ -607,6 +654,7 @@ public:
             uint32_t chunkIndex = static_cast<uint32_t>(chunks_.size() - 1);
             ChunkMeta& meta = chunkMetas_[chunkIndex];
             Actor* actorArray = GetActorArray(chunkIndex);
+            MarkChunkWritten(chunkIndex);
 
             while (meta.count < chunkCapacity_ && actorIdx < totalActors) {
                 uint16_t indexInChunk = meta.count++;
@@ -620,6 +668,9 @@ public:
     //------------------------------------------------------------------------
     //! @brief Actorを解放（swap-and-pop、SoA対応）
     //! @return 移動が発生した場合、移動元のインデックス。移動なしなら UINT16_MAX
+    //!
+    //! 確保時と同様にChunkの全コンポーネントを書き込み扱いにする
+    //! （Chunkの構成変化を変更検出から判定できるようにするため）
     //------------------------------------------------------------------------
     uint16_t DeallocateActor(uint32_t chunkIndex, uint16_t indexInChunk) {
         assert(chunkIndex < chunks_.size());
@@ -629,6 +680,7 @@ public:
 
         // 削除対象のバッファをクリーンアップ
         CleanupBuffers(chunkIndex, indexInChunk);
+        MarkChunkWritten(chunkIndex);
 
         uint16_t lastIndex = meta.count - 1;
         --meta.count;
@@ -682,6 +734,7 @@ public:
     //! @brief Actorを解放（バッファクリーンアップなし、SoA対応）
     //!
     //! MoveActorFromで外部ストレージを移譲済みの場合に使用。
+    //! DeallocateActorと同様にChunkの全コンポーネントを書き込み扱いにする。
     //! @return 移動が発生した場合、移動元のインデックス。移動なしなら UINT16_MAX
     //------------------------------------------------------------------------
     uint16_t DeallocateActorWithoutBufferCleanup(uint32_t chunkIndex, uint16_t indexInChunk) {
@@ -690,6 +743,8 @@ public:
         assert(indexInChunk < meta.count);
         assert(meta.count > 0);
 
+        MarkChunkWritten(chunkIndex);
+
         uint16_t lastIndex = meta.count - 1;
         --meta.count;
 
@@ -780,7 +835,7 @@ public:
             // 共通コンポーネントを探してコピー
             for (size_t dstCompIdx = 0; dstCompIdx < components_.size(); ++dstCompIdx) {
                 const auto& dstInfo = components_[dstCompIdx];
-                size_t srcCompIdx = source->GetComponentIndex(dstInfo.type);
+                size_t srcCompIdx = source->GetComponentIndexById(dstInfo.typeId);
                 if (srcCompIdx != SIZE_MAX) {
                     const auto& srcInfo = source->components_[srcCompIdx];
 
@@ -825,16 +880,20 @@ public:
         return hash;
     }
 
+    //! @note 型リストごとに初回のみ計算してキャッシュする
     template<typename... Ts>
     static ArchetypeId CalculateId() {
-        std::vector<std::type_index> types = { std::type_index(typeid(Ts))... };
-        std::sort(types.begin(), types.end());
-        size_t hash = 14695981039346656037ull;
-        for (const auto& type : types) {
-            hash ^= type.hash_code();
-            hash *= 1099511628211ull;
-        }
-        return hash;
+        static const ArchetypeId id = [] {
+            std::vector<std::type_index> types = { std::type_index(typeid(Ts))... };
+            std::sort(types.begin(), types.end());
+            size_t hash = 14695981039346656037ull;
+            for (const auto& type : types) {
+                hash ^= type.hash_code();
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }();
+        return id;
     }
 
 private:
@@ -845,6 +904,8 @@ private:
     //! [Actor0, Actor1, ...] | [Comp0_0, Comp0_1, ...] | [Comp1_0, Comp1_1, ...] | ...
     //!
     //! 各コンポーネント型が連続配置されるため、ForEach時のキャッシュ効率が向上。
+    //! 容量は1Actorあたりのサイズから求め、配列間のアラインメント詰め物で
+    //! Chunkを超える場合は最後の配列がkSize以内に収まるまで減らす。
     //------------------------------------------------------------------------
     void CalculateLayout() {
         if (components_.empty()) {
@@ -873,17 +934,25 @@ private:
         }
 
         // 3. SoAレイアウト: 各コンポーネント配列のオフセットを計算
-        // Actor配列の直後から開始
-        size_t actorArraySize = static_cast<size_t>(chunkCapacity_) * sizeof(Actor);
-        size_t currentOffset = (actorArraySize + maxAlign - 1) & ~(maxAlign - 1);
-        componentDataOffset_ = currentOffset;
+        // Actor配列の直後から開始。配列間のアラインメント詰め物で
+        // Chunkをはみ出す場合は容量を減らして収まるまで再計算する
+        for (;;) {
+            size_t actorArraySize = static_cast<size_t>(chunkCapacity_) * sizeof(Actor);
+            size_t currentOffset = (actorArraySize + maxAlign - 1) & ~(maxAlign - 1);
+            componentDataOffset_ = currentOffset;
+
+            for (auto& info : components_) {
+                // アラインメント調整
+                currentOffset = (currentOffset + info.alignment - 1) & ~(info.alignment - 1);
+                info.offset = currentOffset;  // この配列の開始オフセット
+                // 配列全体のサイズを加算
+                currentOffset += info.size * static_cast<size_t>(chunkCapacity_);
+            }
 
-        for (auto& info : components_) {
-            // アラインメント調整
-            currentOffset = (currentOffset + info.alignment - 1) & ~(info.alignment - 1);
-            info.offset = currentOffset;  // この配列の開始オフセット
-            // 配列全体のサイズを加算
-            currentOffset += info.size * static_cast<size_t>(chunkCapacity_);
+            if (currentOffset <= Chunk::kSize || chunkCapacity_ == 1) {
+                break;
+            }
+            --chunkCapacity_;
         }
 
         // componentDataSize_は互換性のため保持（1エンティティあたり）
@@ -894,11 +963,42 @@ private:
         return CalculateId(components_);
     }
 
+    //------------------------------------------------------------------------
+    //! @brief シグネチャと型ID→列インデックス表を構築
+    //!
+    //! 表の長さは所持する最大の型ID+1。型IDは連番のため、
+    //! 少数のArchetypeで多くの型を使う構成でも表は小さく収まる。
+    //------------------------------------------------------------------------
+    void BuildTypeTable() {
+        ComponentTypeId maxId = 0;
+        for (const auto& info : components_) {
+            maxId = (std::max)(maxId, info.typeId);
+        }
+        columnIndices_.assign(components_.empty() ? 0 : static_cast<size_t>(maxId) + 1, kNoColumn);
+        for (size_t i = 0; i < components_.size(); ++i) {
+            columnIndices_[components_[i].typeId] = static_cast<uint16_t>(i);
+            signature_.Set(components_[i].typeId);
+        }
+    }
+
+    //! @brief Chunkの全コンポーネントを現在の書き込みバージョンで更新
+    void MarkChunkWritten(size_t chunkIndex) noexcept {
+        if (!writeVersionSource_) return;
+        const uint32_t version = writeVersionSource_->load(std::memory_order_relaxed);
+        ChunkMeta& meta = chunkMetas_[chunkIndex];
+        for (size_t i = 0; i < meta.componentVersions.size(); ++i) {
+            meta.StoreVersion(i, version);
+        }
+    }
+
 private:
     ArchetypeId id_ = kInvalidArchetypeId;
     std::vector<ComponentInfo> components_;
+    ComponentSignature signature_;           //!< 所持コンポーネントの型IDビット集合
+    std::vector<uint16_t> columnIndices_;    //!< 型ID → components_のインデックス（なければkNoColumn）
     std::vector<std::unique_ptr<Chunk>> chunks_;
     std::vector<ChunkMeta> chunkMetas_;      //!< Chunk毎のメタデータ
+    const std::atomic<uint32_t>* writeVersionSource_ = nullptr;  //!< Actor配置時の書き込みバージョン
 
     size_t componentDataSize_ = 0;           //!< 1Actorのコンポーネントデータサイズ
     size_t componentDataOffset_ = 0;         //!< Chunk内コンポーネントデータ開始位置
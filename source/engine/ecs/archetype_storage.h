@@ -21,37 +21,15 @@ namespace detail {
 // Archetype マッチングヘルパー
 //============================================================================
 
-//! タプル内の全ての型をArchetypeが持っているか確認
+//! タプル内の型群のシグネチャ（型リストごとに1回だけ構築）
 template<typename Tuple>
-struct HasAllInTuple;
+struct TupleSignature;
 
-template<>
-struct HasAllInTuple<std::tuple<>> {
-    static bool Check(const Archetype&) { return true; }
-};
-
-template<typename T, typename... Rest>
-struct HasAllInTuple<std::tuple<T, Rest...>> {
-    static bool Check(const Archetype& arch) {
-        if (!arch.HasComponent<T>()) return false;
-        return HasAllInTuple<std::tuple<Rest...>>::Check(arch);
-    }
-};
-
-//! タプル内のいずれかの型をArchetypeが持っているか確認
-template<typename Tuple>
-struct HasAnyInTuple;
-
-template<>
-struct HasAnyInTuple<std::tuple<>> {
-    static bool Check(const Archetype&) { return false; }
-};
-
-template<typename T, typename... Rest>
-struct HasAnyInTuple<std::tuple<T, Rest...>> {
-    static bool Check(const Archetype& arch) {
-        if (arch.HasComponent<T>()) return true;
-        return HasAnyInTuple<std::tuple<Rest...>>::Check(arch);
+template<typename... Ts>
+struct TupleSignature<std::tuple<Ts...>> {
+    static const ComponentSignature& Get() {
+        static const ComponentSignature signature = ComponentSignature::Of<Ts...>();
+        return signature;
     }
 };
 
@@ -61,17 +39,11 @@ bool ArchetypeMatches(const Archetype& arch) {
     using PureRequired = filter_pure_required_t<Ts...>;
     using Excludes = filter_excludes_t<Ts...>;
 
-    // 純粋なRequired型を全て持つ
-    if (!HasAllInTuple<PureRequired>::Check(arch)) {
-        return false;
-    }
+    const ComponentSignature& signature = arch.GetSignature();
 
-    // Exclude型を1つも持たない
-    if (HasAnyInTuple<Excludes>::Check(arch)) {
-        return false;
-    }
-
-    return true;
+    // 純粋なRequired型を全て持ち、Exclude型を1つも持たない
+    return signature.ContainsAll(TupleSignature<PureRequired>::Get()) &&
+           !signature.Intersects(TupleSignature<Excludes>::Get());
 }
 
 } // namespace detail
@@ -109,12 +81,7 @@ public:
         }
 
         // 新規作成
-        auto archetype = BuildArchetype<Ts...>();
-        Archetype* ptr = archetype.get();
-        archetypes_[id] = std::move(archetype);
-        queryCache_.Invalidate();  // キャッシュ無効化
-
-        return ptr;
+        return Register(id, BuildArchetype<Ts...>());
     }
 
     //------------------------------------------------------------------------
@@ -142,12 +109,7 @@ public:
             return it->second.get();
         }
 
-        auto archetype = std::make_unique<Archetype>(std::move(components));
-        Archetype* ptr = archetype.get();
-        archetypes_[id] = std::move(archetype);
-        queryCache_.Invalidate();  // キャッシュ無効化
-
-        return ptr;
+        return Register(id, std::make_unique<Archetype>(std::move(components)));
     }
 
     //------------------------------------------------------------------------
@@ -161,12 +123,7 @@ public:
         }
 
         // 空のArchetypeを作成（コンポーネントなし）
-        auto archetype = std::make_unique<Archetype>();
-        Archetype* ptr = archetype.get();
-        archetypes_[kEmptyArchetypeId] = std::move(archetype);
-        queryCache_.Invalidate();  // キャッシュ無効化
-
-        return ptr;
+        return Register(kEmptyArchetypeId, std::make_unique<Archetype>());
     }
 
     //------------------------------------------------------------------------
@@ -177,25 +134,21 @@ public:
     //------------------------------------------------------------------------
     template<typename T>
     Archetype* GetOrCreateWith(Archetype* base) {
+        // 既に持っている場合は同じArchetypeを返す
+        if (base && base->HasComponent<T>()) {
+            return base;
+        }
+
         // baseのコンポーネント + T
         std::vector<ComponentInfo> newComponents;
         if (base) {
             newComponents = base->GetComponents();
         }
 
-        // Tが既に存在するか確認
-        std::type_index newType(typeid(T));
-        for (const auto& info : newComponents) {
-            if (info.type == newType) {
-                // 既に持っている場合は同じArchetypeを返す
-                return base;
-            }
-        }
-
         // Tを追加（Tagコンポーネントはサイズ0として扱う）
         constexpr size_t size = is_tag_component_v<T> ? 0 : sizeof(T);
         constexpr size_t align = is_tag_component_v<T> ? 1 : alignof(T);
-        newComponents.emplace_back(newType, size, align);
+        newComponents.emplace_back(std::type_index(typeid(T)), size, align);
 
         return GetOrCreate(std::move(newComponents));
     }
@@ -214,10 +167,10 @@ public:
 
         // baseのコンポーネント - T
         std::vector<ComponentInfo> newComponents;
-        std::type_index removeType(typeid(T));
+        const ComponentTypeId removeId = ComponentTypeRegistry::Get<T>();
 
         for (const auto& info : base->GetComponents()) {
-            if (info.type != removeType) {
+            if (info.typeId != removeId) {
                 newComponents.push_back(info);
             }
         }
@@ -241,28 +194,24 @@ public:
         static_assert(is_buffer_element_v<T>,
             "T must inherit from IBufferElement and be trivially_copyable");
 
+        // 既に持っている場合は同じArchetypeを返す
+        if (base && base->HasBuffer<T>()) {
+            return base;
+        }
+
         // baseのコンポーネント + Buffer<T>
         std::vector<ComponentInfo> newComponents;
         if (base) {
             newComponents = base->GetComponents();
         }
 
-        // バッファが既に存在するか確認
-        std::type_index newType(typeid(T));
-        for (const auto& info : newComponents) {
-            if (info.type == newType && info.isBuffer) {
-                // 既に持っている場合は同じArchetypeを返す
-                return base;
-            }
-        }
-
         // バッファを追加
         constexpr int32_t inlineCap = InternalBufferCapacity<T>::Value;
         constexpr size_t totalSize = sizeof(BufferHeader) +
                                      static_cast<size_t>(inlineCap) * sizeof(T);
 
         newComponents.emplace_back(
-            newType,
+            std::type_index(typeid(T)),
             totalSize,
             alignof(BufferHeader),
             sizeof(T),   // elementSize
@@ -289,11 +238,11 @@ public:
 
         // baseのコンポーネント - Buffer<T>
         std::vector<ComponentInfo> newComponents;
-        std::type_index removeType(typeid(T));
+        const ComponentTypeId removeId = ComponentTypeRegistry::Get<T>();
 
         for (const auto& info : base->GetComponents()) {
             // バッファコンポーネントで型が一致するものを除外
-            if (!(info.type == removeType && info.isBuffer)) {
+            if (!(info.typeId == removeId && info.isBuffer)) {
                 newComponents.push_back(info);
             }
         }
@@ -345,14 +294,17 @@ public:
 
     //------------------------------------------------------------------------
     //! @brief 指定コンポーネントを持つ全Archetypeをイテレーション
+    //!
+    //! 判定はArchetypeのシグネチャとのビット集合の包含（ワード単位のAND）。
     //! @tparam Ts 必須コンポーネント型群
     //! @tparam Func 処理関数の型 void(Archetype&)
     //! @param func 各Archetypeに対して呼び出す関数
     //------------------------------------------------------------------------
     template<typename... Ts, typename Func>
     void ForEachMatching(Func&& func) {
+        const ComponentSignature& required = detail::TupleSignature<std::tuple<Ts...>>::Get();
         for (auto& [id, archetype] : archetypes_) {
-            if ((archetype->HasComponent<Ts>() && ...)) {
+            if (archetype->GetSignature().ContainsAll(required)) {
                 func(*archetype);
             }
         }
@@ -360,8 +312,9 @@ public:
 
     template<typename... Ts, typename Func>
     void ForEachMatching(Func&& func) const {
+        const ComponentSignature& required = detail::TupleSignature<std::tuple<Ts...>>::Get();
         for (const auto& [id, archetype] : archetypes_) {
-            if ((archetype->HasComponent<Ts>() && ...)) {
+            if (archetype->GetSignature().ContainsAll(required)) {
                 func(*archetype);
             }
         }
@@ -398,6 +351,28 @@ public:
         }
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 指定コンポーネントを持つArchetype配列をキャッシュから取得
+    //!
+    //! @tparam Ts コンポーネント型群（T, Optional<T>, Exclude<T> の組み合わせ）
+    //! @return マッチするArchetypeの配列
+    //!
+    //! @note 初回のみO(全Archetype数)で構築。以降に作成されたArchetypeは
+    //!       作成時に照合されて配列へ追加される。参照はQueryCacheの
+    //!       バージョンが変わる（Clear/Invalidate）まで有効
+    //------------------------------------------------------------------------
+    template<typename... Ts>
+    const std::vector<Archetype*>& GetMatchingArchetypes() {
+        return queryCache_.GetOrBuild(
+            QueryCache::CalculateKey<Ts...>(),
+            &detail::ArchetypeMatches<Ts...>,
+            [this](auto&& visit) {
+                for (auto& [id, archetype] : archetypes_) {
+                    visit(*archetype);
+                }
+            });
+    }
+
     //------------------------------------------------------------------------
     //! @brief 指定コンポーネントを持つ全Archetypeをキャッシュ経由でイテレーション
     //!
@@ -406,36 +381,16 @@ public:
     //! @param func 各Archetypeに対して呼び出す関数
     //!
     //! @note キャッシュにヒットした場合O(マッチArchetype数)、
-    //!       ミスした場合O(全Archetype数)で再構築
+    //!       初回のみO(全Archetype数)で構築
     //------------------------------------------------------------------------
     template<typename... Ts, typename Func>
     void ForEachMatchingCached(Func&& func) {
-        constexpr size_t key = QueryCache::CalculateKey<Ts...>();
-
-        // キャッシュを確認
-        QueryCache::CacheEntry* entry = queryCache_.GetEntry(key);
-        if (entry) {
-            // キャッシュヒット
-            for (Archetype* arch : entry->archetypes) {
-                func(*arch);
-            }
-            return;
-        }
+        const std::vector<Archetype*>& matching = GetMatchingArchetypes<Ts...>();
 
-        // キャッシュミス: 再構築（Optional/Exclude対応）
-        std::vector<Archetype*> matching;
-        for (auto& [id, archetype] : archetypes_) {
-            if (detail::ArchetypeMatches<Ts...>(*archetype)) {
-                matching.push_back(archetype.get());
-            }
-        }
-
-        // キャッシュに保存
-        queryCache_.SetEntry(key, matching);
-
-        // 処理実行
-        for (Archetype* arch : matching) {
-            func(*arch);
+        // funcがArchetypeを作成して配列が伸びても、呼び出し時点の分だけ処理する
+        const size_t count = matching.size();
+        for (size_t i = 0; i < count; ++i) {
+            func(*matching[i]);
         }
     }
 
@@ -463,7 +418,7 @@ public:
     //! @param version フレームカウンターなどの値
     //------------------------------------------------------------------------
     void SetWriteVersion(uint32_t version) noexcept {
-        currentWriteVersion_ = version;
+        currentWriteVersion_.store(version, std::memory_order_relaxed);
     }
 
     //------------------------------------------------------------------------
@@ -471,10 +426,22 @@ public:
     //! @return 現在の書き込みバージョン
     //------------------------------------------------------------------------
     [[nodiscard]] uint32_t GetWriteVersion() const noexcept {
-        return currentWriteVersion_;
+        return currentWriteVersion_.load(std::memory_order_relaxed);
     }
 
 private:
+    //------------------------------------------------------------------------
+    //! @brief 新規Archetypeを登録
+    //------------------------------------------------------------------------
+    Archetype* Register(ArchetypeId id, std::unique_ptr<Archetype> archetype) {
+        Archetype* ptr = archetype.get();
+        ptr->SetWriteVersionSource(&currentWriteVersion_);
+        archetypes_[id] = std::move(archetype);
+        queryCache_.OnArchetypeAdded(*ptr);  // 登録済みQueryへ追加
+
+        return ptr;
+    }
+
     //------------------------------------------------------------------------
     //! @brief 型リストからArchetypeを構築
     //------------------------------------------------------------------------
@@ -488,7 +455,7 @@ private:
 private:
     std::unordered_map<ArchetypeId, std::unique_ptr<Archetype>> archetypes_;
     mutable QueryCache queryCache_;  //!< Queryマッチング結果キャッシュ
-    uint32_t currentWriteVersion_ = 0;  //!< ForEach内での書き込みバージョン
+    std::atomic<uint32_t> currentWriteVersion_{0};  //!< 書き込みバージョン（並列Systemから参照される）
 };
 
 } // namespace ECS
@@ -0,0 +1,246 @@
+//----------------------------------------------------------------------------
+//! @file   broad_phase_3d.h
+//! @brief  3D永続Broad-phase（動的AABBツリー + ペアキャッシュ）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/actor.h"
+#include "engine/ecs/collision/dynamic_aabb_tree_3d.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace Collision {
+
+//============================================================================
+//! @brief 3D永続Broad-phase
+//!
+//! Actorごとのプロキシを動的AABBツリーに保持し、フレーム間で再利用する。
+//! 太いAABBが重なるペアをキャッシュし、今回作成・移動・破棄された
+//! プロキシに関わるペアだけを作り直す。
+//!
+//! ペアの重複除去にハッシュセットは使わない:
+//! - 変化のないプロキシ同士のペアは太いAABBが変わらないためそのまま残す
+//! - 変化したプロキシpはツリーを検索し、相手qが変化していないか q < p の場合のみ採用
+//!   （両方変化したペアは小さいID側の検索でのみ採用される）
+//!
+//! 使い方（毎フレーム）:
+//! @code
+//! broadPhase.BeginUpdate();
+//! for (each enabled collider) broadPhase.UpdateProxy(actor, bounds);
+//! broadPhase.EndUpdate();   // UpdateProxyされなかったプロキシは破棄
+//! broadPhase.QueryAllPairs([](Actor a, Actor b) { ... });
+//! @endcode
+//============================================================================
+class BroadPhase3D {
+public:
+    //------------------------------------------------------------------------
+    //! @brief コンストラクタ
+    //! @param margin 太いAABBの拡張量（大きいほど再挿入が減り、偽ペアが増える）
+    //------------------------------------------------------------------------
+    explicit BroadPhase3D(float margin = 0.1f) noexcept
+        : tree_(margin) {}
+
+    //------------------------------------------------------------------------
+    //! @brief 更新開始
+    //------------------------------------------------------------------------
+    void BeginUpdate() noexcept {
+        ++stamp_;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Actorのプロキシを登録または更新
+    //! @param actor エンティティ
+    //! @param bounds 実AABB
+    //! @param userIndex 呼び出し側の任意インデックス（毎フレーム更新される。QueryAllIndexPairsで返す）
+    //!
+    //! 実AABBが太いAABBに収まっていればツリーもペアも触らない。
+    //------------------------------------------------------------------------
+    void UpdateProxy(ECS::Actor actor, const Bounds3D& bounds, uint32_t userIndex = 0) {
+        const uint32_t index = actor.Index();
+        if (index >= proxyByActor_.size()) {
+            proxyByActor_.resize(index + 1, DynamicAabbTree3D::kNullNode);
+        }
+
+        int32_t proxyId = proxyByActor_[index];
+        if (proxyId != DynamicAabbTree3D::kNullNode && proxyActor_[proxyId] != actor) {
+            // 同じインデックスの旧世代Actorのプロキシが残っている
+            DestroyProxyInternal(proxyId);
+            proxyId = DynamicAabbTree3D::kNullNode;
+        }
+
+        if (proxyId == DynamicAabbTree3D::kNullNode) {
+            proxyId = tree_.CreateProxy(bounds, actor.id);
+            proxyByActor_[index] = proxyId;
+            EnsureProxySlot(proxyId);
+            proxyActor_[proxyId] = actor;
+            MarkMoved(proxyId);
+        } else if (tree_.MoveProxy(proxyId, bounds)) {
+            MarkMoved(proxyId);
+        }
+        proxyStamp_[proxyId] = stamp_;
+        proxyUserIndex_[proxyId] = userIndex;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Actorのプロキシを破棄
+    //------------------------------------------------------------------------
+    void RemoveProxy(ECS::Actor actor) {
+        const uint32_t index = actor.Index();
+        if (index >= proxyByActor_.size()) return;
+        const int32_t proxyId = proxyByActor_[index];
+        if (proxyId != DynamicAabbTree3D::kNullNode && proxyActor_[proxyId] == actor) {
+            DestroyProxyInternal(proxyId);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 更新終了（未更新プロキシの破棄とペアの更新）
+    //------------------------------------------------------------------------
+    void EndUpdate() {
+        // 今回UpdateProxyされなかったプロキシ（破棄・無効化されたActor）を破棄
+        for (size_t i = 0; i < proxyActor_.size(); ++i) {
+            const int32_t proxyId = static_cast<int32_t>(i);
+            if (proxyActor_[i].IsValid() && proxyStamp_[i] != stamp_) {
+                DestroyProxyInternal(proxyId);
+            }
+        }
+        UpdatePairs();
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 太いAABBが重なる全ペアを列挙（重複なし）
+    //! @param callback void(Actor a, Actor b)
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void QueryAllPairs(Func&& callback) const {
+        for (const Pair& pair : pairs_) {
+            callback(proxyActor_[pair.proxyA], proxyActor_[pair.proxyB]);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 太いAABBが重なる全ペアをUpdateProxyのuserIndexで列挙（重複なし）
+    //! @param callback void(uint32_t indexA, uint32_t indexB)
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void QueryAllIndexPairs(Func&& callback) const {
+        for (const Pair& pair : pairs_) {
+            callback(proxyUserIndex_[pair.proxyA], proxyUserIndex_[pair.proxyB]);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 指定範囲と太いAABBが重なるActorを列挙
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void QueryRange(const Bounds3D& bounds, Func&& callback) const {
+        tree_.Query(bounds, [this, &callback](int32_t proxyId) {
+            callback(proxyActor_[proxyId]);
+        });
+    }
+
+    //! @brief 全プロキシとペアを破棄
+    void Clear() noexcept {
+        tree_.Clear();
+        proxyByActor_.clear();
+        proxyActor_.clear();
+        proxyStamp_.clear();
+        proxyUserIndex_.clear();
+        proxyMoved_.clear();
+        moveBuffer_.clear();
+        pairs_.clear();
+    }
+
+    //! @brief 太いAABBの拡張量を設定
+    void SetMargin(float margin) noexcept { tree_.SetMargin(margin); }
+    [[nodiscard]] float GetMargin() const noexcept { return tree_.GetMargin(); }
+
+    //! @brief プロキシ数
+    [[nodiscard]] size_t GetProxyCount() const noexcept { return tree_.GetProxyCount(); }
+
+    //! @brief キャッシュ中のペア数
+    [[nodiscard]] size_t GetPairCount() const noexcept { return pairs_.size(); }
+
+    //! @brief 直前のEndUpdateで作り直したプロキシ数
+    [[nodiscard]] size_t GetLastMovedCount() const noexcept { return lastMovedCount_; }
+
+    //! @brief 内部ツリー（統計・デバッグ用）
+    [[nodiscard]] const DynamicAabbTree3D& GetTree() const noexcept { return tree_; }
+
+private:
+    //! @brief プロキシIDのペア（proxyA < proxyB）
+    struct Pair {
+        int32_t proxyA;
+        int32_t proxyB;
+    };
+
+    void EnsureProxySlot(int32_t proxyId) {
+        const size_t required = static_cast<size_t>(proxyId) + 1;
+        if (proxyActor_.size() < required) {
+            proxyActor_.resize(required);
+            proxyStamp_.resize(required, 0);
+            proxyUserIndex_.resize(required, 0);
+            proxyMoved_.resize(required, 0);
+        }
+    }
+
+    void MarkMoved(int32_t proxyId) {
+        if (!proxyMoved_[proxyId]) {
+            proxyMoved_[proxyId] = 1;
+            moveBuffer_.push_back(proxyId);
+        }
+    }
+
+    void DestroyProxyInternal(int32_t proxyId) {
+        proxyByActor_[proxyActor_[proxyId].Index()] = DynamicAabbTree3D::kNullNode;
+        proxyActor_[proxyId] = ECS::Actor{};
+        tree_.DestroyProxy(proxyId);
+        // 破棄されたIDを含むペアを除去するため変化扱いにする（IDは再利用され得る）
+        MarkMoved(proxyId);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 変化したプロキシに関わるペアを作り直す
+    //------------------------------------------------------------------------
+    void UpdatePairs() {
+        lastMovedCount_ = moveBuffer_.size();
+        if (moveBuffer_.empty()) return;
+
+        // 変化したプロキシを含むペアを除去（変化のないペアは重なりが変わらない）
+        pairs_.erase(std::remove_if(pairs_.begin(), pairs_.end(), [this](const Pair& pair) {
+            return proxyMoved_[pair.proxyA] || proxyMoved_[pair.proxyB];
+        }), pairs_.end());
+
+        // 変化したプロキシから新しいペアを検索
+        for (const int32_t proxyId : moveBuffer_) {
+            if (!proxyActor_[proxyId].IsValid()) continue;  // 破棄済み
+
+            tree_.Query(tree_.GetFatBounds(proxyId), [this, proxyId](int32_t other) {
+                if (other == proxyId) return;
+                // 両方変化した場合は小さいID側の検索でのみ採用
+                if (proxyMoved_[other] && other < proxyId) return;
+                pairs_.push_back(Pair{(std::min)(proxyId, other), (std::max)(proxyId, other)});
+            });
+        }
+
+        for (const int32_t proxyId : moveBuffer_) {
+            proxyMoved_[proxyId] = 0;
+        }
+        moveBuffer_.clear();
+    }
+
+    DynamicAabbTree3D tree_;
+    std::vector<int32_t> proxyByActor_;     //!< Actorインデックス → プロキシID
+    std::vector<ECS::Actor> proxyActor_;    //!< プロキシID → Actor（空きは無効Actor）
+    std::vector<uint32_t> proxyStamp_;      //!< プロキシID → 最後にUpdateProxyされた更新番号
+    std::vector<uint32_t> proxyUserIndex_;  //!< プロキシID → UpdateProxyで渡されたインデックス
+    std::vector<uint8_t> proxyMoved_;       //!< プロキシID → 今回作成・移動・破棄されたか
+    std::vector<int32_t> moveBuffer_;       //!< 今回変化したプロキシID
+    std::vector<Pair> pairs_;               //!< 太いAABBが重なるペア
+    size_t lastMovedCount_ = 0;
+    uint32_t stamp_ = 0;
+};
+
+} // namespace Collision
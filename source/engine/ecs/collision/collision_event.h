@@ -56,7 +56,7 @@ struct alignas(16) Event3D {
     float contactX = 0.0f;           //!< 接触点X (4 bytes)
     float contactY = 0.0f;           //!< 接触点Y (4 bytes)
     float contactZ = 0.0f;           //!< 接触点Z (4 bytes)
-    float _pad0 = 0.0f;              //!< アライメント (4 bytes)
+    float toi = 1.0f;                //!< 衝突時刻（0..1、ステップ内の割合。離散判定は1）(4 bytes)
     float normalX = 0.0f;            //!< 接触法線X (4 bytes)
     float normalY = 0.0f;            //!< 接触法線Y (4 bytes)
     float normalZ = 0.0f;            //!< 接触法線Z (4 bytes)
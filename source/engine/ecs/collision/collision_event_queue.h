@@ -21,7 +21,7 @@ struct PairKey {
 
     PairKey(ECS::Actor a, ECS::Actor b) noexcept {
         // 順序を正規化してユニークキーを生成
-        uint32_t idA = a.GetId(), idB = b.GetId();
+        uint32_t idA = a.id, idB = b.id;
         if (idA > idB) std::swap(idA, idB);
         key = (static_cast<uint64_t>(idA) << 32) | idB;
     }
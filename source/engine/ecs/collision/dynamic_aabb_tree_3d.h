@@ -0,0 +1,415 @@
+//----------------------------------------------------------------------------
+//! @file   dynamic_aabb_tree_3d.h
+//! @brief  3D動的AABBツリー（Broad-phase）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+namespace Collision {
+
+//============================================================================
+//! @brief 3D AABB（Broad-phase用）
+//============================================================================
+struct Bounds3D {
+    float minX = 0.0f, minY = 0.0f, minZ = 0.0f;
+    float maxX = 0.0f, maxY = 0.0f, maxZ = 0.0f;
+
+    //! @brief 他のAABBと重なるか（境界を含む）
+    [[nodiscard]] bool Overlaps(const Bounds3D& other) const noexcept {
+        return minX <= other.maxX && maxX >= other.minX &&
+               minY <= other.maxY && maxY >= other.minY &&
+               minZ <= other.maxZ && maxZ >= other.minZ;
+    }
+
+    //! @brief 他のAABBを完全に含むか
+    [[nodiscard]] bool Contains(const Bounds3D& other) const noexcept {
+        return minX <= other.minX && minY <= other.minY && minZ <= other.minZ &&
+               maxX >= other.maxX && maxY >= other.maxY && maxZ >= other.maxZ;
+    }
+
+    //! @brief 表面積の1/2（挿入コストの比較用）
+    [[nodiscard]] float HalfSurfaceArea() const noexcept {
+        const float dx = maxX - minX;
+        const float dy = maxY - minY;
+        const float dz = maxZ - minZ;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    //! @brief 全方向にmarginだけ広げたAABB
+    [[nodiscard]] Bounds3D Fattened(float margin) const noexcept {
+        return Bounds3D{minX - margin, minY - margin, minZ - margin,
+                        maxX + margin, maxY + margin, maxZ + margin};
+    }
+
+    //! @brief 2つのAABBを包含するAABB
+    [[nodiscard]] static Bounds3D Union(const Bounds3D& a, const Bounds3D& b) noexcept {
+        return Bounds3D{(std::min)(a.minX, b.minX), (std::min)(a.minY, b.minY), (std::min)(a.minZ, b.minZ),
+                        (std::max)(a.maxX, b.maxX), (std::max)(a.maxY, b.maxY), (std::max)(a.maxZ, b.maxZ)};
+    }
+};
+
+//============================================================================
+//! @brief 3D動的AABBツリー
+//!
+//! 葉にプロキシ（コライダー）を持つ2分木。フレームを跨いで保持し、
+//! 移動したプロキシだけを抜き差しする。
+//!
+//! - 葉のAABBはmarginだけ広げた「太いAABB」で、実AABBがその中に収まる間は
+//!   ツリーを更新しない（静止・微小移動のコライダーはコスト0）
+//! - 挿入位置は表面積の増分が最小になる兄弟を選ぶ
+//! - 挿入・削除後に高さ差2以上のノードを回転させ、高さをO(log n)に保つ
+//!
+//! @note スレッドセーフではない。Queryは更新中でなければ並列に呼べる。
+//============================================================================
+class DynamicAabbTree3D {
+public:
+    static constexpr int32_t kNullNode = -1;
+
+    //------------------------------------------------------------------------
+    //! @brief コンストラクタ
+    //! @param margin 太いAABBの拡張量
+    //------------------------------------------------------------------------
+    explicit DynamicAabbTree3D(float margin = 0.1f) noexcept
+        : margin_(margin) {}
+
+    //------------------------------------------------------------------------
+    //! @brief プロキシを作成
+    //! @param bounds 実AABB
+    //! @param userData 任意の値（Actor ID等）
+    //! @return プロキシID（破棄後は再利用される）
+    //------------------------------------------------------------------------
+    int32_t CreateProxy(const Bounds3D& bounds, uint32_t userData) {
+        const int32_t proxyId = AllocateNode();
+        Node& node = nodes_[proxyId];
+        node.bounds = bounds.Fattened(margin_);
+        node.userData = userData;
+        node.height = 0;
+        InsertLeaf(proxyId);
+        ++proxyCount_;
+        return proxyId;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief プロキシを破棄
+    //------------------------------------------------------------------------
+    void DestroyProxy(int32_t proxyId) {
+        assert(IsProxy(proxyId));
+        RemoveLeaf(proxyId);
+        FreeNode(proxyId);
+        --proxyCount_;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief プロキシの実AABBを更新
+    //! @return 太いAABBからはみ出してツリーを更新した場合true
+    //------------------------------------------------------------------------
+    bool MoveProxy(int32_t proxyId, const Bounds3D& bounds) {
+        assert(IsProxy(proxyId));
+        if (nodes_[proxyId].bounds.Contains(bounds)) {
+            return false;
+        }
+        RemoveLeaf(proxyId);
+        nodes_[proxyId].bounds = bounds.Fattened(margin_);
+        InsertLeaf(proxyId);
+        return true;
+    }
+
+    //! @brief プロキシの太いAABB
+    [[nodiscard]] const Bounds3D& GetFatBounds(int32_t proxyId) const noexcept {
+        return nodes_[proxyId].bounds;
+    }
+
+    //! @brief プロキシのユーザーデータ
+    [[nodiscard]] uint32_t GetUserData(int32_t proxyId) const noexcept {
+        return nodes_[proxyId].userData;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief AABBと太いAABBが重なるプロキシを列挙
+    //! @param bounds 検索範囲
+    //! @param callback void(int32_t proxyId)
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void Query(const Bounds3D& bounds, Func&& callback) const {
+        if (root_ == kNullNode) return;
+
+        // 回転で高さを保っているため固定長スタックで足りる
+        int32_t stack[kMaxStackDepth];
+        int32_t top = 0;
+        stack[top++] = root_;
+
+        while (top > 0) {
+            const int32_t id = stack[--top];
+            const Node& node = nodes_[id];
+            if (!node.bounds.Overlaps(bounds)) continue;
+
+            if (node.IsLeaf()) {
+                callback(id);
+            } else {
+                assert(top + 2 <= kMaxStackDepth);
+                stack[top++] = node.child1;
+                stack[top++] = node.child2;
+            }
+        }
+    }
+
+    //! @brief 全プロキシを破棄
+    void Clear() noexcept {
+        nodes_.clear();
+        root_ = kNullNode;
+        freeList_ = kNullNode;
+        proxyCount_ = 0;
+    }
+
+    //! @brief 太いAABBの拡張量を設定（既存のプロキシは次の再挿入時に反映）
+    void SetMargin(float margin) noexcept { margin_ = margin; }
+    [[nodiscard]] float GetMargin() const noexcept { return margin_; }
+
+    //! @brief プロキシ数
+    [[nodiscard]] size_t GetProxyCount() const noexcept { return proxyCount_; }
+
+    //! @brief ツリーの高さ（葉のみなら0、空なら-1）
+    [[nodiscard]] int32_t GetHeight() const noexcept {
+        return root_ == kNullNode ? -1 : nodes_[root_].height;
+    }
+
+    //! @brief ノード配列の大きさ（プロキシIDの上限）
+    [[nodiscard]] size_t GetNodeCapacity() const noexcept { return nodes_.size(); }
+
+    //! @brief 有効なプロキシIDか
+    [[nodiscard]] bool IsProxy(int32_t proxyId) const noexcept {
+        return proxyId >= 0 && static_cast<size_t>(proxyId) < nodes_.size() &&
+               nodes_[proxyId].height == 0;
+    }
+
+private:
+    static constexpr int32_t kMaxStackDepth = 256;
+
+    //------------------------------------------------------------------------
+    //! @brief ツリーノード
+    //!
+    //! height: 葉=0、内部ノード=子の高さ+1、空きノード=-1
+    //! parent: 空きノードでは空きリストの次要素
+    //------------------------------------------------------------------------
+    struct Node {
+        Bounds3D bounds;
+        uint32_t userData = 0;
+        int32_t parent = kNullNode;
+        int32_t child1 = kNullNode;
+        int32_t child2 = kNullNode;
+        int32_t height = -1;
+
+        [[nodiscard]] bool IsLeaf() const noexcept { return child1 == kNullNode; }
+    };
+
+    int32_t AllocateNode() {
+        if (freeList_ == kNullNode) {
+            nodes_.emplace_back();
+            return static_cast<int32_t>(nodes_.size() - 1);
+        }
+        const int32_t id = freeList_;
+        freeList_ = nodes_[id].parent;
+        nodes_[id] = Node{};
+        return id;
+    }
+
+    void FreeNode(int32_t id) noexcept {
+        nodes_[id].parent = freeList_;
+        nodes_[id].child1 = kNullNode;
+        nodes_[id].child2 = kNullNode;
+        nodes_[id].height = -1;
+        freeList_ = id;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 葉を挿入（表面積の増分が最小になる兄弟を探す）
+    //------------------------------------------------------------------------
+    void InsertLeaf(int32_t leaf) {
+        if (root_ == kNullNode) {
+            root_ = leaf;
+            nodes_[leaf].parent = kNullNode;
+            return;
+        }
+
+        const Bounds3D leafBounds = nodes_[leaf].bounds;
+        int32_t index = root_;
+        while (!nodes_[index].IsLeaf()) {
+            const Node& node = nodes_[index];
+            const float area = node.bounds.HalfSurfaceArea();
+            const float combinedArea = Bounds3D::Union(node.bounds, leafBounds).HalfSurfaceArea();
+
+            // このノードと兄弟にする場合のコスト
+            const float cost = 2.0f * combinedArea;
+            // 下位へ降りる場合に祖先が負担する増分
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            const float cost1 = DescendCost(node.child1, leafBounds) + inheritanceCost;
+            const float cost2 = DescendCost(node.child2, leafBounds) + inheritanceCost;
+
+            if (cost < cost1 && cost < cost2) break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        // 兄弟と新しい親で置き換える
+        const int32_t sibling = index;
+        const int32_t oldParent = nodes_[sibling].parent;
+        const int32_t newParent = AllocateNode();
+        {
+            Node& parent = nodes_[newParent];
+            parent.parent = oldParent;
+            parent.bounds = Bounds3D::Union(leafBounds, nodes_[sibling].bounds);
+            parent.height = nodes_[sibling].height + 1;
+            parent.child1 = sibling;
+            parent.child2 = leaf;
+        }
+
+        if (oldParent != kNullNode) {
+            if (nodes_[oldParent].child1 == sibling) {
+                nodes_[oldParent].child1 = newParent;
+            } else {
+                nodes_[oldParent].child2 = newParent;
+            }
+        } else {
+            root_ = newParent;
+        }
+        nodes_[sibling].parent = newParent;
+        nodes_[leaf].parent = newParent;
+
+        RefitAncestors(nodes_[leaf].parent);
+    }
+
+    //! @brief childの下に挿入する場合のコスト
+    [[nodiscard]] float DescendCost(int32_t child, const Bounds3D& leafBounds) const noexcept {
+        const Bounds3D& bounds = nodes_[child].bounds;
+        const float newArea = Bounds3D::Union(leafBounds, bounds).HalfSurfaceArea();
+        return nodes_[child].IsLeaf() ? newArea : newArea - bounds.HalfSurfaceArea();
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 葉を取り除く（親ノードは兄弟で置き換えて解放）
+    //------------------------------------------------------------------------
+    void RemoveLeaf(int32_t leaf) {
+        if (leaf == root_) {
+            root_ = kNullNode;
+            return;
+        }
+
+        const int32_t parent = nodes_[leaf].parent;
+        const int32_t grandParent = nodes_[parent].parent;
+        const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+        if (grandParent != kNullNode) {
+            if (nodes_[grandParent].child1 == parent) {
+                nodes_[grandParent].child1 = sibling;
+            } else {
+                nodes_[grandParent].child2 = sibling;
+            }
+            nodes_[sibling].parent = grandParent;
+            FreeNode(parent);
+            RefitAncestors(grandParent);
+        } else {
+            root_ = sibling;
+            nodes_[sibling].parent = kNullNode;
+            FreeNode(parent);
+        }
+    }
+
+    //! @brief indexから根までバランス調整しつつAABBと高さを更新
+    void RefitAncestors(int32_t index) {
+        while (index != kNullNode) {
+            index = Balance(index);
+
+            Node& node = nodes_[index];
+            const Node& child1 = nodes_[node.child1];
+            const Node& child2 = nodes_[node.child2];
+            node.height = 1 + (std::max)(child1.height, child2.height);
+            node.bounds = Bounds3D::Union(child1.bounds, child2.bounds);
+
+            index = node.parent;
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 子の高さ差が2以上なら回転する
+    //! @return 回転後にiAの位置に来たノード
+    //------------------------------------------------------------------------
+    int32_t Balance(int32_t iA) {
+        Node& A = nodes_[iA];
+        if (A.IsLeaf() || A.height < 2) {
+            return iA;
+        }
+
+        const int32_t iB = A.child1;
+        const int32_t iC = A.child2;
+        const int32_t balance = nodes_[iC].height - nodes_[iB].height;
+
+        if (balance > 1) {
+            return Rotate(iA, iC, iB);
+        }
+        if (balance < -1) {
+            return Rotate(iA, iB, iC);
+        }
+        return iA;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 高い方の子iUpをiAの位置へ引き上げる
+    //! @param iA 回転の中心
+    //! @param iUp 引き上げる子（高い方）
+    //! @param iOther iAに残る子
+    //------------------------------------------------------------------------
+    int32_t Rotate(int32_t iA, int32_t iUp, int32_t iOther) {
+        Node& A = nodes_[iA];
+        Node& U = nodes_[iUp];
+        const int32_t iF = U.child1;
+        const int32_t iG = U.child2;
+
+        // UとAを入れ替える
+        U.child1 = iA;
+        U.parent = A.parent;
+        A.parent = iUp;
+
+        if (U.parent != kNullNode) {
+            if (nodes_[U.parent].child1 == iA) {
+                nodes_[U.parent].child1 = iUp;
+            } else {
+                nodes_[U.parent].child2 = iUp;
+            }
+        } else {
+            root_ = iUp;
+        }
+
+        // Uの子のうち高い方をUに残し、低い方をAへ移す
+        const bool keepF = nodes_[iF].height > nodes_[iG].height;
+        const int32_t iKeep = keepF ? iF : iG;
+        const int32_t iMove = keepF ? iG : iF;
+
+        U.child2 = iKeep;
+        if (A.child1 == iUp) {
+            A.child1 = iMove;
+        } else {
+            A.child2 = iMove;
+        }
+        nodes_[iMove].parent = iA;
+
+        A.bounds = Bounds3D::Union(nodes_[iOther].bounds, nodes_[iMove].bounds);
+        A.height = 1 + (std::max)(nodes_[iOther].height, nodes_[iMove].height);
+        U.bounds = Bounds3D::Union(A.bounds, nodes_[iKeep].bounds);
+        U.height = 1 + (std::max)(A.height, nodes_[iKeep].height);
+
+        return iUp;
+    }
+
+    std::vector<Node> nodes_;
+    int32_t root_ = kNullNode;
+    int32_t freeList_ = kNullNode;
+    size_t proxyCount_ = 0;
+    float margin_;
+};
+
+} // namespace Collision
@@ -0,0 +1,653 @@
+//----------------------------------------------------------------------------
+//! @file   narrow_phase_3d.h
+//! @brief  3D Narrow-phase（SoAスナップショット + 形状ペア別バッチ判定）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/actor.h"
+#include "engine/ecs/collision/collision_event.h"
+#include "engine/ecs/collision/collision_event_queue.h"
+#include "engine/core/job_system.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Collision {
+
+//============================================================================
+//! @brief Narrow-phaseでの形状分類
+//============================================================================
+enum class NarrowShape3D : uint8_t {
+    Sphere,     //!< 球
+    Box,        //!< AABB
+    Approx      //!< AABBで近似する形状（カプセル等）
+};
+
+//============================================================================
+//! @brief コライダーのSoAスナップショット（フレームごとに1回作成）
+//!
+//! Broad-phaseのペアはこの配列のインデックスで表す。
+//! Narrow-phaseはコンポーネントを参照せず、この配列だけを読む。
+//! 境界はステップ終端の位置。CCD対象はmoveX/Y/Zにこのステップの移動量を持つ
+//! （開始位置 = 境界 - 移動量）。
+//============================================================================
+struct ColliderSnapshot3D {
+    std::vector<ECS::Actor> actors;
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    std::vector<float> radius;              //!< 球の半径（球以外は0）
+    std::vector<uint32_t> layer;
+    std::vector<uint32_t> mask;
+    std::vector<NarrowShape3D> shape;
+    std::vector<float> moveX, moveY, moveZ; //!< このステップの移動量（CCD対象以外は0）
+
+    void Clear() noexcept {
+        actors.clear();
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+        radius.clear();
+        layer.clear();
+        mask.clear();
+        shape.clear();
+        moveX.clear(); moveY.clear(); moveZ.clear();
+    }
+
+    //! @brief コライダーを追加
+    //! @return スナップショット内のインデックス
+    uint32_t Add(ECS::Actor actor,
+                 float x0, float y0, float z0, float x1, float y1, float z1,
+                 float sphereRadius, NarrowShape3D shapeClass,
+                 uint32_t layerBits, uint32_t maskBits) {
+        const uint32_t index = static_cast<uint32_t>(actors.size());
+        actors.push_back(actor);
+        minX.push_back(x0); minY.push_back(y0); minZ.push_back(z0);
+        maxX.push_back(x1); maxY.push_back(y1); maxZ.push_back(z1);
+        radius.push_back(sphereRadius);
+        layer.push_back(layerBits);
+        mask.push_back(maskBits);
+        shape.push_back(shapeClass);
+        moveX.push_back(0.0f); moveY.push_back(0.0f); moveZ.push_back(0.0f);
+        return index;
+    }
+
+    //! @brief CCD対象としてこのステップの移動量を設定
+    void SetMotion(uint32_t index, float dx, float dy, float dz) noexcept {
+        moveX[index] = dx;
+        moveY[index] = dy;
+        moveZ[index] = dz;
+    }
+
+    //! @brief 掃引判定の対象か（移動量を持つか）
+    [[nodiscard]] bool HasMotion(uint32_t index) const noexcept {
+        return moveX[index] != 0.0f || moveY[index] != 0.0f || moveZ[index] != 0.0f;
+    }
+
+    [[nodiscard]] uint32_t Size() const noexcept { return static_cast<uint32_t>(actors.size()); }
+};
+
+//============================================================================
+//! @brief 3D Narrow-phase
+//!
+//! Broad-phaseのペアを形状の組み合わせ（球-球、AABB-AABB、球-AABB）ごとに
+//! 分けて溜め、SSEで4ペアずつ棄却判定した後、衝突したペアだけ接触情報を計算する。
+//! ペア列は固定長ブロックに分割してJobSystemで並列処理し、
+//! ブロックごとのイベントバッファをブロック順に結合する（結果は実行順に依存しない）。
+//!
+//! どちらかが移動量を持つペア（CCD）は掃引バッチへ分け、終端で重なっていれば
+//! 通常の接触を、重なっていなければ相対移動で衝突時刻（TOI）を求めて
+//! 衝突時点の接触点・法線（penetration = 0、toi < 1）を返す。
+//! 衝突時刻イベントは通知のみで、物体の位置は補正しない（Collision3DSystem参照）。
+//!
+//! @code
+//! narrowPhase.BeginPairs();
+//! broadPhase.QueryAllIndexPairs([&](uint32_t a, uint32_t b) { narrowPhase.AddPair(snapshot, a, b); });
+//! narrowPhase.Execute(snapshot);
+//! narrowPhase.Flush(eventQueue);
+//! @endcode
+//============================================================================
+class NarrowPhase3D {
+public:
+    //! @brief 1ブロックのペア数（ブロック単位でJobSystemへ分配する）
+    static constexpr uint32_t kBlockSize = 256;
+
+    //! @brief 並列化するブロック数の下限
+    static constexpr uint32_t kMinParallelBlocks = 4;
+
+    //------------------------------------------------------------------------
+    //! @brief ペアの蓄積を開始
+    //------------------------------------------------------------------------
+    void BeginPairs() noexcept {
+        sphereSphere_.clear();
+        boxBox_.clear();
+        sphereBox_.clear();
+        swept_.clear();
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief ペアを形状別に振り分け（レイヤーマスクで除外）
+    //------------------------------------------------------------------------
+    void AddPair(const ColliderSnapshot3D& s, uint32_t a, uint32_t b) {
+        if ((s.layer[a] & s.mask[b]) == 0 || (s.layer[b] & s.mask[a]) == 0) return;
+
+        if (s.HasMotion(a) || s.HasMotion(b)) {
+            swept_.push_back(Pair{a, b});
+            return;
+        }
+
+        const NarrowShape3D shapeA = s.shape[a];
+        const NarrowShape3D shapeB = s.shape[b];
+        if (shapeA == NarrowShape3D::Sphere && shapeB == NarrowShape3D::Sphere) {
+            sphereSphere_.push_back(Pair{a, b});
+        } else if (shapeA == NarrowShape3D::Sphere && shapeB == NarrowShape3D::Box) {
+            sphereBox_.push_back(Pair{a, b});
+        } else if (shapeA == NarrowShape3D::Box && shapeB == NarrowShape3D::Sphere) {
+            sphereBox_.push_back(Pair{a, b});
+        } else {
+            // カプセル等はAABBで近似
+            boxBox_.push_back(Pair{a, b});
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 蓄積したペアを判定
+    //------------------------------------------------------------------------
+    void Execute(const ColliderSnapshot3D& s) {
+        BuildBlocks();
+        const uint32_t blockCount = static_cast<uint32_t>(blocks_.size());
+        if (blockEvents_.size() < blockCount) {
+            blockEvents_.resize(blockCount);
+        }
+
+        const bool parallel = blockCount >= kMinParallelBlocks &&
+            JobSystem::HasWorkers();
+        if (parallel) {
+            JobSystem::Get().ParallelForRange(0, blockCount,
+                [this, &s](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i) {
+                        RunBlock(s, i);
+                    }
+                }, 1).Wait();
+        } else {
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                RunBlock(s, i);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief ブロックごとのイベントをキューへ結合
+    //------------------------------------------------------------------------
+    void Flush(EventQueue3D& queue) const {
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+            for (const Event3D& event : blockEvents_[i]) {
+                queue.Push(event);
+            }
+        }
+    }
+
+    //! @brief ブロックごとのイベントを列挙（Flushを使わない場合）
+    template<typename Func>
+    void ForEachEvent(Func&& func) const {
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+            for (const Event3D& event : blockEvents_[i]) {
+                func(event);
+            }
+        }
+    }
+
+    //! @brief 直前に判定したペア数
+    [[nodiscard]] size_t GetPairCount() const noexcept {
+        return sphereSphere_.size() + boxBox_.size() + sphereBox_.size() + swept_.size();
+    }
+
+private:
+    struct Pair {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    enum class BatchType : uint8_t { SphereSphere, BoxBox, SphereBox, Swept };
+
+    struct Block {
+        BatchType type;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    void BuildBlocks() {
+        blocks_.clear();
+        AppendBlocks(BatchType::SphereSphere, static_cast<uint32_t>(sphereSphere_.size()));
+        AppendBlocks(BatchType::BoxBox, static_cast<uint32_t>(boxBox_.size()));
+        AppendBlocks(BatchType::SphereBox, static_cast<uint32_t>(sphereBox_.size()));
+        AppendBlocks(BatchType::Swept, static_cast<uint32_t>(swept_.size()));
+    }
+
+    void AppendBlocks(BatchType type, uint32_t count) {
+        for (uint32_t begin = 0; begin < count; begin += kBlockSize) {
+            blocks_.push_back(Block{type, begin, (std::min)(begin + kBlockSize, count)});
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1ブロックを判定（4ペアずつ棄却判定し、衝突したペアのみ接触計算）
+    //------------------------------------------------------------------------
+    void RunBlock(const ColliderSnapshot3D& s, uint32_t blockIndex) const {
+        const Block& block = blocks_[blockIndex];
+        std::vector<Event3D>& out = blockEvents_[blockIndex];
+        out.clear();
+
+        const std::vector<Pair>& pairs =
+            block.type == BatchType::SphereSphere ? sphereSphere_ :
+            block.type == BatchType::BoxBox ? boxBox_ :
+            block.type == BatchType::SphereBox ? sphereBox_ : swept_;
+
+        for (uint32_t i = block.begin; i < block.end; i += 4) {
+            const uint32_t lanes = (std::min)(4u, block.end - i);
+            uint32_t a[4], b[4];
+            for (uint32_t l = 0; l < 4; ++l) {
+                // 端数レーンは先頭ペアで埋め、結果はマスクで捨てる
+                const Pair& pair = pairs[i + (l < lanes ? l : 0)];
+                a[l] = pair.a;
+                b[l] = pair.b;
+            }
+
+            uint32_t hits;
+            switch (block.type) {
+            case BatchType::SphereSphere: hits = OverlapSphereSphere4(s, a, b); break;
+            case BatchType::BoxBox:       hits = OverlapBoxBox4(s, a, b); break;
+            case BatchType::SphereBox:    hits = OverlapSphereBox4(s, a, b); break;
+            default:                      hits = 0xF; break;   // 掃引ペアは少数なので全て接触計算へ
+            }
+            hits &= (1u << lanes) - 1;
+
+            while (hits != 0) {
+                const uint32_t l = static_cast<uint32_t>(std::countr_zero(hits));
+                hits &= hits - 1;
+
+                Event3D event;
+                bool hit;
+                switch (block.type) {
+                case BatchType::SphereSphere: hit = SphereSphere(s, a[l], b[l], event); break;
+                case BatchType::BoxBox:       hit = BoxBox(s, a[l], b[l], event); break;
+                case BatchType::SphereBox:    hit = SphereBoxOrdered(s, a[l], b[l], event); break;
+                default:                      hit = Swept(s, a[l], b[l], event); break;
+                }
+                if (hit) {
+                    event.actorA = s.actors[a[l]];
+                    event.actorB = s.actors[b[l]];
+                    event.layerA = s.layer[a[l]];
+                    event.layerB = s.layer[b[l]];
+                    out.push_back(event);
+                }
+            }
+        }
+    }
+
+    //========================================================================
+    // SIMD棄却判定（4ペア）
+    //========================================================================
+
+    //! @brief 4要素をインデックスで集める
+    [[nodiscard]] static __m128 Gather(const std::vector<float>& v, const uint32_t* idx) noexcept {
+        return _mm_setr_ps(v[idx[0]], v[idx[1]], v[idx[2]], v[idx[3]]);
+    }
+
+    [[nodiscard]] static __m128 Abs(__m128 v) noexcept {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+    }
+
+    //! @brief 中心と半サイズを集める
+    static void GatherCenterHalf(const ColliderSnapshot3D& s, const uint32_t* idx,
+                                 __m128 center[3], __m128 half[3]) noexcept {
+        const __m128 k05 = _mm_set1_ps(0.5f);
+        const __m128 x0 = Gather(s.minX, idx), x1 = Gather(s.maxX, idx);
+        const __m128 y0 = Gather(s.minY, idx), y1 = Gather(s.maxY, idx);
+        const __m128 z0 = Gather(s.minZ, idx), z1 = Gather(s.maxZ, idx);
+        center[0] = _mm_mul_ps(_mm_add_ps(x0, x1), k05);
+        center[1] = _mm_mul_ps(_mm_add_ps(y0, y1), k05);
+        center[2] = _mm_mul_ps(_mm_add_ps(z0, z1), k05);
+        half[0] = _mm_mul_ps(_mm_sub_ps(x1, x0), k05);
+        half[1] = _mm_mul_ps(_mm_sub_ps(y1, y0), k05);
+        half[2] = _mm_mul_ps(_mm_sub_ps(z1, z0), k05);
+    }
+
+    [[nodiscard]] static uint32_t OverlapSphereSphere4(const ColliderSnapshot3D& s,
+                                                       const uint32_t* a, const uint32_t* b) noexcept {
+        __m128 ca[3], ha[3], cb[3], hb[3];
+        GatherCenterHalf(s, a, ca, ha);
+        GatherCenterHalf(s, b, cb, hb);
+        const __m128 dx = _mm_sub_ps(cb[0], ca[0]);
+        const __m128 dy = _mm_sub_ps(cb[1], ca[1]);
+        const __m128 dz = _mm_sub_ps(cb[2], ca[2]);
+        const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        const __m128 sum = _mm_add_ps(Gather(s.radius, a), Gather(s.radius, b));
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(sum, sum))));
+    }
+
+    [[nodiscard]] static uint32_t OverlapBoxBox4(const ColliderSnapshot3D& s,
+                                                 const uint32_t* a, const uint32_t* b) noexcept {
+        __m128 ca[3], ha[3], cb[3], hb[3];
+        GatherCenterHalf(s, a, ca, ha);
+        GatherCenterHalf(s, b, cb, hb);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 hit = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int axis = 0; axis < 3; ++axis) {
+            const __m128 overlap = _mm_sub_ps(_mm_add_ps(ha[axis], hb[axis]), Abs(_mm_sub_ps(ca[axis], cb[axis])));
+            hit = _mm_and_ps(hit, _mm_cmpgt_ps(overlap, zero));
+        }
+        return static_cast<uint32_t>(_mm_movemask_ps(hit));
+    }
+
+    [[nodiscard]] static uint32_t OverlapSphereBox4(const ColliderSnapshot3D& s,
+                                                    const uint32_t* a, const uint32_t* b) noexcept {
+        // レーンごとに球側・AABB側を揃える
+        uint32_t sphere[4], box[4];
+        for (int l = 0; l < 4; ++l) {
+            const bool sphereIsA = s.shape[a[l]] == NarrowShape3D::Sphere;
+            sphere[l] = sphereIsA ? a[l] : b[l];
+            box[l] = sphereIsA ? b[l] : a[l];
+        }
+
+        __m128 sc[3], sh[3];
+        GatherCenterHalf(s, sphere, sc, sh);
+        const __m128 closestX = _mm_min_ps(_mm_max_ps(sc[0], Gather(s.minX, box)), Gather(s.maxX, box));
+        const __m128 closestY = _mm_min_ps(_mm_max_ps(sc[1], Gather(s.minY, box)), Gather(s.maxY, box));
+        const __m128 closestZ = _mm_min_ps(_mm_max_ps(sc[2], Gather(s.minZ, box)), Gather(s.maxZ, box));
+        const __m128 dx = _mm_sub_ps(sc[0], closestX);
+        const __m128 dy = _mm_sub_ps(sc[1], closestY);
+        const __m128 dz = _mm_sub_ps(sc[2], closestZ);
+        const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        const __m128 r = Gather(s.radius, sphere);
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distSq, _mm_mul_ps(r, r))));
+    }
+
+    //========================================================================
+    // 接触情報（衝突したペアのみ）
+    //========================================================================
+
+    [[nodiscard]] static float CenterX(const ColliderSnapshot3D& s, uint32_t i) noexcept { return (s.minX[i] + s.maxX[i]) * 0.5f; }
+    [[nodiscard]] static float CenterY(const ColliderSnapshot3D& s, uint32_t i) noexcept { return (s.minY[i] + s.maxY[i]) * 0.5f; }
+    [[nodiscard]] static float CenterZ(const ColliderSnapshot3D& s, uint32_t i) noexcept { return (s.minZ[i] + s.maxZ[i]) * 0.5f; }
+
+    //------------------------------------------------------------------------
+    //! @brief AABB vs AABB（最小分離軸、法線はBからA向き）
+    //------------------------------------------------------------------------
+    [[nodiscard]] static bool BoxBox(const ColliderSnapshot3D& s, uint32_t a, uint32_t b,
+                                     Event3D& event) noexcept {
+        const float cax = CenterX(s, a), cay = CenterY(s, a), caz = CenterZ(s, a);
+        const float cbx = CenterX(s, b), cby = CenterY(s, b), cbz = CenterZ(s, b);
+        event.contactX = (cax + cbx) * 0.5f;
+        event.contactY = (cay + cby) * 0.5f;
+        event.contactZ = (caz + cbz) * 0.5f;
+
+        const float overlapX = ((s.maxX[a] - s.minX[a]) * 0.5f + (s.maxX[b] - s.minX[b]) * 0.5f) - std::abs(cax - cbx);
+        const float overlapY = ((s.maxY[a] - s.minY[a]) * 0.5f + (s.maxY[b] - s.minY[b]) * 0.5f) - std::abs(cay - cby);
+        const float overlapZ = ((s.maxZ[a] - s.minZ[a]) * 0.5f + (s.maxZ[b] - s.minZ[b]) * 0.5f) - std::abs(caz - cbz);
+        if (overlapX <= 0 || overlapY <= 0 || overlapZ <= 0) return false;
+
+        if (overlapX < overlapY && overlapX < overlapZ) {
+            event.normalX = (cax < cbx) ? -1.0f : 1.0f;
+            event.normalY = 0.0f;
+            event.normalZ = 0.0f;
+            event.penetration = overlapX;
+        } else if (overlapY < overlapZ) {
+            event.normalX = 0.0f;
+            event.normalY = (cay < cby) ? -1.0f : 1.0f;
+            event.normalZ = 0.0f;
+            event.penetration = overlapY;
+        } else {
+            event.normalX = 0.0f;
+            event.normalY = 0.0f;
+            event.normalZ = (caz < cbz) ? -1.0f : 1.0f;
+            event.penetration = overlapZ;
+        }
+        return true;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Sphere vs Sphere（法線はAからB向き）
+    //------------------------------------------------------------------------
+    [[nodiscard]] static bool SphereSphere(const ColliderSnapshot3D& s, uint32_t a, uint32_t b,
+                                           Event3D& event) noexcept {
+        const float cax = CenterX(s, a), cay = CenterY(s, a), caz = CenterZ(s, a);
+        const float radiusA = s.radius[a];
+        const float radiusB = s.radius[b];
+
+        const float dx = CenterX(s, b) - cax;
+        const float dy = CenterY(s, b) - cay;
+        const float dz = CenterZ(s, b) - caz;
+        const float distSq = dx * dx + dy * dy + dz * dz;
+        const float radiusSum = radiusA + radiusB;
+        if (distSq > radiusSum * radiusSum) return false;
+
+        const float dist = std::sqrt(distSq);
+        if (dist < 0.0001f) {
+            // 中心が同じ位置の場合
+            event.normalX = 0.0f;
+            event.normalY = 1.0f;
+            event.normalZ = 0.0f;
+            event.penetration = radiusSum;
+        } else {
+            const float invDist = 1.0f / dist;
+            event.normalX = dx * invDist;
+            event.normalY = dy * invDist;
+            event.normalZ = dz * invDist;
+            event.penetration = radiusSum - dist;
+        }
+
+        // 接触点（2つの球の表面間の中点）
+        const float contactDist = radiusA - event.penetration * 0.5f;
+        event.contactX = cax + event.normalX * contactDist;
+        event.contactY = cay + event.normalY * contactDist;
+        event.contactZ = caz + event.normalZ * contactDist;
+        return true;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Sphere vs AABB（ペアの順序どおりの法線を返す）
+    //!
+    //! Aが球なら法線はAABBから球向き、AがAABBなら反転する。
+    //------------------------------------------------------------------------
+    [[nodiscard]] static bool SphereBoxOrdered(const ColliderSnapshot3D& s, uint32_t a, uint32_t b,
+                                               Event3D& event) noexcept {
+        if (s.shape[a] == NarrowShape3D::Sphere) {
+            return SphereBox(s, a, b, event);
+        }
+        if (!SphereBox(s, b, a, event)) return false;
+        event.normalX = -event.normalX;
+        event.normalY = -event.normalY;
+        event.normalZ = -event.normalZ;
+        return true;
+    }
+
+    [[nodiscard]] static bool SphereBox(const ColliderSnapshot3D& s, uint32_t sphere, uint32_t box,
+                                        Event3D& event) noexcept {
+        const float scx = CenterX(s, sphere), scy = CenterY(s, sphere), scz = CenterZ(s, sphere);
+        const float radius = s.radius[sphere];
+
+        // AABBへの最近接点を計算
+        const float closestX = std::clamp(scx, s.minX[box], s.maxX[box]);
+        const float closestY = std::clamp(scy, s.minY[box], s.maxY[box]);
+        const float closestZ = std::clamp(scz, s.minZ[box], s.maxZ[box]);
+
+        float dx = scx - closestX;
+        float dy = scy - closestY;
+        float dz = scz - closestZ;
+        const float distSq = dx * dx + dy * dy + dz * dz;
+        if (distSq > radius * radius) return false;
+
+        const float dist = std::sqrt(distSq);
+        if (dist < 0.0001f) {
+            // 球の中心がAABB内部にある
+            dx = scx - CenterX(s, box);
+            dy = scy - CenterY(s, box);
+            dz = scz - CenterZ(s, box);
+
+            const float overlapX = (s.maxX[box] - s.minX[box]) * 0.5f - std::abs(dx);
+            const float overlapY = (s.maxY[box] - s.minY[box]) * 0.5f - std::abs(dy);
+            const float overlapZ = (s.maxZ[box] - s.minZ[box]) * 0.5f - std::abs(dz);
+
+            if (overlapX < overlapY && overlapX < overlapZ) {
+                event.normalX = (dx > 0) ? 1.0f : -1.0f;
+                event.normalY = 0.0f;
+                event.normalZ = 0.0f;
+                event.penetration = overlapX + radius;
+            } else if (overlapY < overlapZ) {
+                event.normalX = 0.0f;
+                event.normalY = (dy > 0) ? 1.0f : -1.0f;
+                event.normalZ = 0.0f;
+                event.penetration = overlapY + radius;
+            } else {
+                event.normalX = 0.0f;
+                event.normalY = 0.0f;
+                event.normalZ = (dz > 0) ? 1.0f : -1.0f;
+                event.penetration = overlapZ + radius;
+            }
+        } else {
+            const float invDist = 1.0f / dist;
+            event.normalX = dx * invDist;
+            event.normalY = dy * invDist;
+            event.normalZ = dz * invDist;
+            event.penetration = radius - dist;
+        }
+
+        event.contactX = closestX;
+        event.contactY = closestY;
+        event.contactZ = closestZ;
+        return true;
+    }
+
+    //========================================================================
+    // 連続衝突判定（掃引ペア）
+    //========================================================================
+
+    //------------------------------------------------------------------------
+    //! @brief 掃引ペアの判定
+    //!
+    //! 終端で重なっていれば形状別の通常判定と同じ結果（toi = 1）。
+    //! 重なっていなければ開始位置から相対移動で最初に触れる時刻を求める。
+    //! 法線の向きは通常判定と同じ規則（球同士はAからB、AABBを含むとBからA）。
+    //------------------------------------------------------------------------
+    [[nodiscard]] static bool Swept(const ColliderSnapshot3D& s, uint32_t a, uint32_t b,
+                                    Event3D& event) noexcept {
+        const NarrowShape3D shapeA = s.shape[a];
+        const NarrowShape3D shapeB = s.shape[b];
+        const bool sphereSphere = shapeA == NarrowShape3D::Sphere && shapeB == NarrowShape3D::Sphere;
+        const bool sphereBox = (shapeA == NarrowShape3D::Sphere && shapeB == NarrowShape3D::Box) ||
+                               (shapeA == NarrowShape3D::Box && shapeB == NarrowShape3D::Sphere);
+
+        const bool overlapping = sphereSphere ? SphereSphere(s, a, b, event) :
+                                 sphereBox ? SphereBoxOrdered(s, a, b, event) : BoxBox(s, a, b, event);
+        if (overlapping) {
+            event.toi = 1.0f;
+            return true;
+        }
+
+        // Bから見たAの相対移動。開始位置はそれぞれ終端 - 移動量
+        const float dx = s.moveX[a] - s.moveX[b];
+        const float dy = s.moveY[a] - s.moveY[b];
+        const float dz = s.moveZ[a] - s.moveZ[b];
+        const float startAX = CenterX(s, a) - s.moveX[a];
+        const float startAY = CenterY(s, a) - s.moveY[a];
+        const float startAZ = CenterZ(s, a) - s.moveZ[a];
+        const float startBX = CenterX(s, b) - s.moveX[b];
+        const float startBY = CenterY(s, b) - s.moveY[b];
+        const float startBZ = CenterZ(s, b) - s.moveZ[b];
+
+        float toi;
+        if (sphereSphere) {
+            // 半径の和の球に対するレイ判定
+            const float radiusSum = s.radius[a] + s.radius[b];
+            const float px = startAX - startBX, py = startAY - startBY, pz = startAZ - startBZ;
+            const float dd = dx * dx + dy * dy + dz * dz;
+            const float pd = px * dx + py * dy + pz * dz;
+            const float c = px * px + py * py + pz * pz - radiusSum * radiusSum;
+            const float disc = pd * pd - dd * c;
+            if (dd <= 0.0f || pd >= 0.0f || disc < 0.0f) return false;
+            toi = (-pd - std::sqrt(disc)) / dd;
+            if (toi < 0.0f || toi > 1.0f) return false;
+
+            const float nx = (startBX + s.moveX[b] * toi) - (startAX + s.moveX[a] * toi);
+            const float ny = (startBY + s.moveY[b] * toi) - (startAY + s.moveY[a] * toi);
+            const float nz = (startBZ + s.moveZ[b] * toi) - (startAZ + s.moveZ[a] * toi);
+            const float invLength = 1.0f / radiusSum;
+            event.normalX = nx * invLength;
+            event.normalY = ny * invLength;
+            event.normalZ = nz * invLength;
+            event.contactX = startAX + s.moveX[a] * toi + event.normalX * s.radius[a];
+            event.contactY = startAY + s.moveY[a] * toi + event.normalY * s.radius[a];
+            event.contactZ = startAZ + s.moveZ[a] * toi + event.normalZ * s.radius[a];
+        } else {
+            // 半サイズの和だけ広げたBに対するスラブ判定（球はAABBで近似）
+            const float start[3] = { startAX - startBX, startAY - startBY, startAZ - startBZ };
+            const float delta[3] = { dx, dy, dz };
+            const float extent[3] = {
+                (s.maxX[a] - s.minX[a] + s.maxX[b] - s.minX[b]) * 0.5f,
+                (s.maxY[a] - s.minY[a] + s.maxY[b] - s.minY[b]) * 0.5f,
+                (s.maxZ[a] - s.minZ[a] + s.maxZ[b] - s.minZ[b]) * 0.5f };
+            float enter = 0.0f;
+            float exit = 1.0f;
+            int enterAxis = -1;
+            for (int axis = 0; axis < 3; ++axis) {
+                if (delta[axis] == 0.0f) {
+                    if (std::abs(start[axis]) >= extent[axis]) return false;
+                    continue;
+                }
+                const float inv = 1.0f / delta[axis];
+                float t0 = (-extent[axis] - start[axis]) * inv;
+                float t1 = (extent[axis] - start[axis]) * inv;
+                if (t0 > t1) std::swap(t0, t1);
+                if (t0 > enter) {
+                    enter = t0;
+                    enterAxis = axis;
+                }
+                exit = (std::min)(exit, t1);
+                if (enter >= exit) return false;
+            }
+            // 開始時点で重なっている（終端では離れている）ペアは接触なし
+            if (enterAxis < 0) return false;
+            toi = enter;
+
+            // 法線はBの入射面からA向き
+            const float sign = delta[enterAxis] > 0.0f ? -1.0f : 1.0f;
+            event.normalX = enterAxis == 0 ? sign : 0.0f;
+            event.normalY = enterAxis == 1 ? sign : 0.0f;
+            event.normalZ = enterAxis == 2 ? sign : 0.0f;
+
+            // 接触点: 入射軸はBの面、他の軸は衝突時のAの中心をBの範囲へ寄せる
+            const float centerA[3] = {
+                startAX + s.moveX[a] * toi, startAY + s.moveY[a] * toi, startAZ + s.moveZ[a] * toi };
+            const float centerB[3] = {
+                startBX + s.moveX[b] * toi, startBY + s.moveY[b] * toi, startBZ + s.moveZ[b] * toi };
+            const float halfB[3] = {
+                (s.maxX[b] - s.minX[b]) * 0.5f, (s.maxY[b] - s.minY[b]) * 0.5f, (s.maxZ[b] - s.minZ[b]) * 0.5f };
+            float contact[3];
+            for (int axis = 0; axis < 3; ++axis) {
+                contact[axis] = axis == enterAxis
+                    ? centerB[axis] + sign * halfB[axis]
+                    : std::clamp(centerA[axis], centerB[axis] - halfB[axis], centerB[axis] + halfB[axis]);
+            }
+            event.contactX = contact[0];
+            event.contactY = contact[1];
+            event.contactZ = contact[2];
+        }
+
+        event.penetration = 0.0f;
+        event.toi = toi;
+        return true;
+    }
+
+    std::vector<Pair> sphereSphere_;                    //!< 球-球ペア
+    std::vector<Pair> boxBox_;                          //!< AABB-AABBペア（近似形状を含む）
+    std::vector<Pair> sphereBox_;                       //!< 球-AABBペア（順序は元のまま）
+    std::vector<Pair> swept_;                           //!< どちらかが移動量を持つペア（CCD）
+    std::vector<Block> blocks_;                         //!< 今回の判定ブロック
+    mutable std::vector<std::vector<Event3D>> blockEvents_;  //!< ブロックごとのイベント
+};
+
+} // namespace Collision
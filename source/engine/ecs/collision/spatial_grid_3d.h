@@ -120,7 +120,7 @@ public:
                     auto it = cells_.find(key);
                     if (it != cells_.end()) {
                         for (const auto& actor : it->second) {
-                            if (visitedActors.insert(actor.GetId()).second) {
+                            if (visitedActors.insert(actor.id).second) {
                                 callback(actor);
                             }
                         }
@@ -162,7 +162,7 @@ private:
     //! @brief ペアキーを生成（順序正規化）
     //------------------------------------------------------------------------
     [[nodiscard]] static uint64_t MakePairKey(ECS::Actor a, ECS::Actor b) noexcept {
-        uint32_t idA = a.GetId(), idB = b.GetId();
+        uint32_t idA = a.id, idB = b.id;
         if (idA > idB) std::swap(idA, idB);
         return (static_cast<uint64_t>(idA) << 32) | idB;
     }
@@ -6,9 +6,11 @@
 
 
 #include "engine/ecs/actor.h"
+#include "engine/ecs/world.h"
+#include "engine/core/job_system.h"
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cmath>
 #include <algorithm>
@@ -18,11 +20,37 @@ namespace Collision {
 //============================================================================
 //! @brief 2D空間ハッシュグリッド
 //!
-//! 各セルにActorリストを保持。
-//! 大きいオブジェクトは複数セルに登録される。
+//! セル座標をハッシュしたフラットなバケット配列に、カウンティングソートで
+//! (セル, コライダー) のエントリを詰める。大きいオブジェクトは複数セルに登録される。
+//!
+//! 構築（Build）:
+//! 1. コライダーごとのセル範囲とエントリ数を計算し、プレフィックス和でエントリ位置を決定
+//! 2. エントリごとにバケットを計算してバケット内の数を数える
+//! 3. バケットのプレフィックス和 → エントリを散布
+//! 4. バケット内を (セル, コライダー) 順に並べる（散布順に依存しない結果にする）
+//! 各段階は要素数が多い場合JobSystemで並列実行する。
+//!
+//! ペアの重複除去にハッシュセットは使わない（所有セル規則）:
+//! - 2つのコライダーのセル範囲の共通部分のうち、最小セル（両者の最小セル座標の最大値）を所有セルとする
+//! - ペアは所有セルでのみ出力される
+//!
+//! 使い方（毎フレーム）:
+//! @code
+//! grid.Clear();
+//! for (each collider) grid.Insert(actor, posX, posY, halfW, halfH);
+//! grid.Build();
+//! grid.FindPairs([](uint32_t a, uint32_t b) { return true; });  // 並列、フィルタは読み取りのみ
+//! grid.QueryAllPairs([](Actor a, Actor b) { ... });
+//! @endcode
 //============================================================================
 class SpatialHash2D {
 public:
+    //! @brief 並列化するコライダー数（エントリ数）の下限
+    static constexpr uint32_t kMinParallelCount = 2048;
+
+    //! @brief ペア生成で1ブロックが担当するバケット数
+    static constexpr uint32_t kBucketsPerBlock = 1024;
+
     //------------------------------------------------------------------------
     //! @brief コンストラクタ
     //! @param cellSize セルサイズ（ピクセル）
@@ -31,10 +59,16 @@ public:
         : cellSize_(cellSize), invCellSize_(1.0f / cellSize) {}
 
     //------------------------------------------------------------------------
-    //! @brief 全セルをクリア
+    //! @brief 全コライダーとペアをクリア
     //------------------------------------------------------------------------
     void Clear() noexcept {
-        cells_.clear();
+        actors_.clear();
+        bounds_.clear();
+        cellRanges_.clear();
+        pairBlocks_.clear();
+        entryCount_ = 0;
+        cellCount_ = 0;
+        built_ = false;
     }
 
     //------------------------------------------------------------------------
@@ -58,39 +92,191 @@ public:
     //! @param posY Y座標
     //! @param halfW 半幅
     //! @param halfH 半高
+    //! @return 登録インデックス（QueryAllIndexPairs/FindPairsで使う）
+    //------------------------------------------------------------------------
+    uint32_t Insert(ECS::Actor actor, float posX, float posY, float halfW, float halfH) {
+        const uint32_t index = static_cast<uint32_t>(actors_.size());
+        actors_.push_back(actor);
+        bounds_.push_back(Bounds{posX - halfW, posY - halfH, posX + halfW, posY + halfH});
+        built_ = false;
+        return index;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 登録済みコライダーからグリッドを構築
     //------------------------------------------------------------------------
-    void Insert(ECS::Actor actor, float posX, float posY, float halfW, float halfH) {
-        int minCellX = static_cast<int>(std::floor((posX - halfW) * invCellSize_));
-        int maxCellX = static_cast<int>(std::floor((posX + halfW) * invCellSize_));
-        int minCellY = static_cast<int>(std::floor((posY - halfH) * invCellSize_));
-        int maxCellY = static_cast<int>(std::floor((posY + halfH) * invCellSize_));
+    void Build() {
+        const uint32_t proxyCount = static_cast<uint32_t>(actors_.size());
+        cellRanges_.resize(proxyCount);
+        entryBegin_.resize(static_cast<size_t>(proxyCount) + 1);
+        pairBlocks_.clear();
+
+        // 1. セル範囲とエントリ数
+        ECS::RunParallelRange(proxyCount, kMinParallelCount, ParallelForDesc(), [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                const Bounds& b = bounds_[i];
+                CellRange& r = cellRanges_[i];
+                r.minX = ToCell(b.minX);
+                r.minY = ToCell(b.minY);
+                r.maxX = ToCell(b.maxX);
+                r.maxY = ToCell(b.maxY);
+                entryBegin_[i] = static_cast<uint32_t>((r.maxX - r.minX + 1) * (r.maxY - r.minY + 1));
+            }
+        });
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < proxyCount; ++i) {
+            const uint32_t span = entryBegin_[i];
+            entryBegin_[i] = total;
+            total += span;
+        }
+        entryBegin_[proxyCount] = total;
+        entryCount_ = total;
+
+        // 2. エントリのバケットを計算して数える
+        const uint32_t bucketCount = (std::bit_ceil)((std::max)(total, 64u));
+        bucketMask_ = bucketCount - 1;
+        bucketStart_.assign(static_cast<size_t>(bucketCount) + 1, 0);
+        entryKey_.resize(total);
+        entryBucket_.resize(total);
+        // 逐次実行時はアトミック操作を避ける
+        const bool parallel = proxyCount >= kMinParallelCount && JobSystem::HasWorkers();
+        ECS::RunParallelRange(proxyCount, kMinParallelCount, ParallelForDesc(), [this, parallel](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                const CellRange& r = cellRanges_[i];
+                uint32_t e = entryBegin_[i];
+                for (int32_t cy = r.minY; cy <= r.maxY; ++cy) {
+                    for (int32_t cx = r.minX; cx <= r.maxX; ++cx, ++e) {
+                        const uint32_t bucket = HashCell(cx, cy) & bucketMask_;
+                        entryKey_[e] = MakeKey(cx, cy);
+                        entryBucket_[e] = bucket;
+                        if (parallel) {
+                            std::atomic_ref<uint32_t>(bucketStart_[bucket]).fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            ++bucketStart_[bucket];
+                        }
+                    }
+                }
+            }
+        });
 
-        for (int cy = minCellY; cy <= maxCellY; ++cy) {
-            for (int cx = minCellX; cx <= maxCellX; ++cx) {
-                uint64_t key = MakeKey(cx, cy);
-                cells_[key].push_back(actor);
+        // 3. プレフィックス和 → 散布
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < bucketCount; ++bucket) {
+            const uint32_t count = bucketStart_[bucket];
+            bucketStart_[bucket] = offset;
+            offset += count;
+        }
+        bucketStart_[bucketCount] = offset;
+        bucketCursor_.assign(bucketStart_.begin(), bucketStart_.end() - 1);
+        entries_.resize(total);
+        ECS::RunParallelRange(proxyCount, kMinParallelCount, ParallelForDesc(), [this, parallel](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                for (uint32_t e = entryBegin_[i]; e < entryBegin_[i + 1]; ++e) {
+                    uint32_t& cursor = bucketCursor_[entryBucket_[e]];
+                    const uint32_t slot = parallel
+                        ? std::atomic_ref<uint32_t>(cursor).fetch_add(1, std::memory_order_relaxed)
+                        : cursor++;
+                    entries_[slot] = Entry{entryKey_[e], i};
+                }
             }
+        });
+
+        // 4. バケット内を (セル, コライダー) 順に整列し、セル数を数える
+        const uint32_t blockCount = (bucketCount + kBucketsPerBlock - 1) / kBucketsPerBlock;
+        blockCellCount_.assign(blockCount, 0);
+        RunBlocks(blockCount, total, [this](uint32_t block) {
+            uint32_t cells = 0;
+            const uint32_t first = block * kBucketsPerBlock;
+            const uint32_t last = (std::min)(first + kBucketsPerBlock, bucketMask_ + 1);
+            for (uint32_t bucket = first; bucket < last; ++bucket) {
+                Entry* begin = entries_.data() + bucketStart_[bucket];
+                Entry* end = entries_.data() + bucketStart_[bucket + 1];
+                // バケットは小さいので挿入ソート
+                for (Entry* it = begin + (begin != end); it < end; ++it) {
+                    const Entry value = *it;
+                    Entry* j = it;
+                    for (; j > begin && value < *(j - 1); --j) {
+                        *j = *(j - 1);
+                    }
+                    *j = value;
+                }
+                for (Entry* it = begin; it < end; ++it) {
+                    if (it == begin || it->key != (it - 1)->key) ++cells;
+                }
+            }
+            blockCellCount_[block] = cells;
+        });
+        cellCount_ = 0;
+        for (const uint32_t cells : blockCellCount_) {
+            cellCount_ += cells;
         }
+        built_ = true;
     }
 
     //------------------------------------------------------------------------
-    //! @brief 全ペアをコールバックで列挙（重複なし）
-    //! @param callback コールバック関数 void(Actor a, Actor b)
+    //! @brief 同じセルを共有するペアを生成（重複なし、並列）
+    //! @param filter bool(uint32_t indexA, uint32_t indexB)。trueのペアのみ保持する。
+    //!        ワーカースレッドから呼ばれるため読み取り専用の処理にすること。
+    //!
+    //! 結果はバケット順・セル内の登録順で決まり、実行スレッド数に依存しない。
     //------------------------------------------------------------------------
     template<typename Func>
-    void QueryAllPairs(Func&& callback) const {
-        std::unordered_set<uint64_t> testedPairs;
-
-        for (const auto& [cellKey, actors] : cells_) {
-            size_t count = actors.size();
-            for (size_t i = 0; i < count; ++i) {
-                for (size_t j = i + 1; j < count; ++j) {
-                    uint64_t pairKey = MakePairKey(actors[i], actors[j]);
-                    if (testedPairs.insert(pairKey).second) {
-                        callback(actors[i], actors[j]);
+    void FindPairs(Func&& filter) {
+        if (!built_) Build();
+
+        const uint32_t blockCount = (bucketMask_ + 1 + kBucketsPerBlock - 1) / kBucketsPerBlock;
+        pairBlocks_.resize(blockCount);
+        RunBlocks(blockCount, entryCount_, [this, &filter](uint32_t block) {
+            std::vector<IndexPair>& out = pairBlocks_[block];
+            out.clear();
+            const uint32_t first = block * kBucketsPerBlock;
+            const uint32_t last = (std::min)(first + kBucketsPerBlock, bucketMask_ + 1);
+            for (uint32_t bucket = first; bucket < last; ++bucket) {
+                const uint32_t end = bucketStart_[bucket + 1];
+                for (uint32_t i = bucketStart_[bucket]; i < end; ++i) {
+                    const Entry& ei = entries_[i];
+                    const CellRange& ri = cellRanges_[ei.proxy];
+                    // 同じバケットの別セル（ハッシュ衝突）はキーで区別される
+                    for (uint32_t j = i + 1; j < end && entries_[j].key == ei.key; ++j) {
+                        const uint32_t other = entries_[j].proxy;
+                        const CellRange& rj = cellRanges_[other];
+                        // 所有セルでのみ出力
+                        if (MakeKey((std::max)(ri.minX, rj.minX), (std::max)(ri.minY, rj.minY)) != ei.key) continue;
+                        if (filter(ei.proxy, other)) {
+                            out.push_back(IndexPair{ei.proxy, other});
+                        }
                     }
                 }
             }
+        });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 全ペアをコールバックで列挙（重複なし）
+    //! @param callback コールバック関数 void(Actor a, Actor b)
+    //!
+    //! 直前のFindPairsの結果を列挙する。FindPairs未実行なら全ペアを生成する。
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void QueryAllPairs(Func&& callback) {
+        QueryAllIndexPairs([this, &callback](uint32_t a, uint32_t b) {
+            callback(actors_[a], actors_[b]);
+        });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 全ペアを登録インデックスで列挙（重複なし）
+    //! @param callback コールバック関数 void(uint32_t indexA, uint32_t indexB)
+    //------------------------------------------------------------------------
+    template<typename Func>
+    void QueryAllIndexPairs(Func&& callback) {
+        if (!built_ || pairBlocks_.empty()) {
+            FindPairs([](uint32_t, uint32_t) { return true; });
+        }
+        for (const auto& block : pairBlocks_) {
+            for (const IndexPair& pair : block) {
+                callback(pair.a, pair.b);
+            }
         }
     }
 
@@ -101,57 +287,132 @@ public:
     //! @param halfW 半幅
     //! @param halfH 半高
     //! @param callback コールバック関数 void(Actor actor)
+    //!
+    //! Build後に使用する。同じコライダーは1回だけ列挙される（所有セル規則）。
     //------------------------------------------------------------------------
     template<typename Func>
     void QueryRange(float posX, float posY, float halfW, float halfH, Func&& callback) const {
-        int minCellX = static_cast<int>(std::floor((posX - halfW) * invCellSize_));
-        int maxCellX = static_cast<int>(std::floor((posX + halfW) * invCellSize_));
-        int minCellY = static_cast<int>(std::floor((posY - halfH) * invCellSize_));
-        int maxCellY = static_cast<int>(std::floor((posY + halfH) * invCellSize_));
-
-        std::unordered_set<uint32_t> visitedActors;
-
-        for (int cy = minCellY; cy <= maxCellY; ++cy) {
-            for (int cx = minCellX; cx <= maxCellX; ++cx) {
-                uint64_t key = MakeKey(cx, cy);
-                auto it = cells_.find(key);
-                if (it != cells_.end()) {
-                    for (const auto& actor : it->second) {
-                        if (visitedActors.insert(actor.GetId()).second) {
-                            callback(actor);
-                        }
-                    }
+        if (!built_) return;
+
+        const int32_t minCellX = ToCell(posX - halfW);
+        const int32_t maxCellX = ToCell(posX + halfW);
+        const int32_t minCellY = ToCell(posY - halfH);
+        const int32_t maxCellY = ToCell(posY + halfH);
+
+        for (int32_t cy = minCellY; cy <= maxCellY; ++cy) {
+            for (int32_t cx = minCellX; cx <= maxCellX; ++cx) {
+                const uint64_t key = MakeKey(cx, cy);
+                const uint32_t bucket = HashCell(cx, cy) & bucketMask_;
+                const uint32_t end = bucketStart_[bucket + 1];
+                for (uint32_t i = bucketStart_[bucket]; i < end; ++i) {
+                    const Entry& entry = entries_[i];
+                    if (entry.key != key) continue;
+                    const CellRange& r = cellRanges_[entry.proxy];
+                    if (MakeKey((std::max)(minCellX, r.minX), (std::max)(minCellY, r.minY)) != key) continue;
+                    callback(actors_[entry.proxy]);
                 }
             }
         }
     }
 
     //------------------------------------------------------------------------
-    //! @brief 登録されているセル数を取得
+    //! @brief 登録されているセル数を取得（Build後）
     //------------------------------------------------------------------------
-    [[nodiscard]] size_t GetCellCount() const noexcept { return cells_.size(); }
+    [[nodiscard]] size_t GetCellCount() const noexcept { return cellCount_; }
+
+    //! @brief 登録されているコライダー数
+    [[nodiscard]] size_t GetProxyCount() const noexcept { return actors_.size(); }
+
+    //! @brief (セル, コライダー) のエントリ数（Build後）
+    [[nodiscard]] size_t GetEntryCount() const noexcept { return entryCount_; }
+
+    //! @brief 登録インデックスのActor
+    [[nodiscard]] ECS::Actor GetActor(uint32_t index) const noexcept { return actors_[index]; }
 
 private:
+    struct Bounds {
+        float minX, minY, maxX, maxY;
+    };
+
+    struct CellRange {
+        int32_t minX, minY, maxX, maxY;
+    };
+
+    //! @brief バケット内のエントリ（キー→登録順で整列）
+    struct Entry {
+        uint64_t key;
+        uint32_t proxy;
+
+        [[nodiscard]] bool operator<(const Entry& other) const noexcept {
+            return key != other.key ? key < other.key : proxy < other.proxy;
+        }
+    };
+
+    struct IndexPair {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    [[nodiscard]] int32_t ToCell(float v) const noexcept {
+        return static_cast<int32_t>(std::floor(v * invCellSize_));
+    }
+
     //------------------------------------------------------------------------
     //! @brief セルキーを生成
     //------------------------------------------------------------------------
-    [[nodiscard]] static uint64_t MakeKey(int cx, int cy) noexcept {
+    [[nodiscard]] static uint64_t MakeKey(int32_t cx, int32_t cy) noexcept {
         return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
                static_cast<uint64_t>(static_cast<uint32_t>(cy));
     }
 
     //------------------------------------------------------------------------
-    //! @brief ペアキーを生成（順序正規化）
+    //! @brief セル座標のハッシュ
+    //------------------------------------------------------------------------
+    [[nodiscard]] static uint32_t HashCell(int32_t cx, int32_t cy) noexcept {
+        return (static_cast<uint32_t>(cx) * 73856093u) ^ (static_cast<uint32_t>(cy) * 19349663u);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief ブロック単位の処理を並列実行
+    //! @param work 全体の仕事量（並列化の判断に使う）
     //------------------------------------------------------------------------
-    [[nodiscard]] static uint64_t MakePairKey(ECS::Actor a, ECS::Actor b) noexcept {
-        uint32_t idA = a.GetId(), idB = b.GetId();
-        if (idA > idB) std::swap(idA, idB);
-        return (static_cast<uint64_t>(idA) << 32) | idB;
+    template<typename Func>
+    static void RunBlocks(uint32_t blockCount, uint32_t work, Func&& func) {
+        auto blocks = [&func](uint32_t begin, uint32_t end) {
+            for (uint32_t block = begin; block < end; ++block) {
+                func(block);
+            }
+        };
+        if (work >= kMinParallelCount) {
+            ECS::RunParallelRange(blockCount, 2, ParallelForDesc().SetGranularity(1), blocks);
+        } else {
+            blocks(0u, blockCount);
+        }
     }
 
     float cellSize_;
     float invCellSize_;
-    std::unordered_map<uint64_t, std::vector<ECS::Actor>> cells_;
+
+    // 登録データ（登録インデックス順）
+    std::vector<ECS::Actor> actors_;
+    std::vector<Bounds> bounds_;
+    std::vector<CellRange> cellRanges_;
+    std::vector<uint32_t> entryBegin_;          //!< 登録インデックス → 最初のエントリ位置
+
+    // カウンティングソート
+    std::vector<uint64_t> entryKey_;            //!< エントリ → セルキー
+    std::vector<uint32_t> entryBucket_;         //!< エントリ → バケット
+    std::vector<uint32_t> bucketStart_;         //!< バケット → entries_の開始位置（末尾に番兵）
+    std::vector<uint32_t> bucketCursor_;        //!< 散布用カーソル
+    std::vector<Entry> entries_;                //!< バケット順に並んだエントリ
+    std::vector<uint32_t> blockCellCount_;
+    uint32_t bucketMask_ = 0;
+    uint32_t entryCount_ = 0;
+    size_t cellCount_ = 0;
+    bool built_ = false;
+
+    // ペア（ブロックごと、ブロック順に列挙）
+    std::vector<std::vector<IndexPair>> pairBlocks_;
 };
 
 } // namespace Collision
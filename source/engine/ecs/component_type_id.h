@@ -0,0 +1,174 @@
+//----------------------------------------------------------------------------
+//! @file   component_type_id.h
+//! @brief  ECS ComponentTypeId - コンポーネント型の連番IDとシグネチャ
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ECS {
+
+//============================================================================
+//! @brief ComponentTypeId
+//!
+//! コンポーネント型ごとに初回参照時に割り当てられる0始まりの連番。
+//! Archetypeの型→列インデックス表やシグネチャのビット位置として使う。
+//!
+//! @note 値はプロセス内でのみ有効（実行ごとに変わり得るため保存しないこと）
+//============================================================================
+using ComponentTypeId = uint32_t;
+static constexpr ComponentTypeId kInvalidComponentTypeId = UINT32_MAX;
+
+//============================================================================
+//! @brief ComponentTypeRegistry
+//!
+//! type_index → ComponentTypeId の対応を一元管理する。
+//! テンプレート版Get<T>()は型ごとの静的変数にIDを保持するため、
+//! 2回目以降は登録表を引かずに済む。
+//!
+//! 対応表は登録のたびに複製して差し替える不変テーブルで、検索はアトミックに
+//! 公開中のテーブルを読むだけ（ロックなし）。ロックは新しい型の登録時のみ取る。
+//! 型の数は高々数百のため、複製と旧テーブルの保持のコストは無視できる。
+//============================================================================
+class ComponentTypeRegistry {
+public:
+    //------------------------------------------------------------------------
+    //! @brief 型TのIDを取得（未登録なら登録）
+    //------------------------------------------------------------------------
+    template<typename T>
+    [[nodiscard]] static ComponentTypeId Get() {
+        static const ComponentTypeId id = GetOrRegister(std::type_index(typeid(T)));
+        return id;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief type_indexのIDを取得（未登録なら登録）
+    //------------------------------------------------------------------------
+    [[nodiscard]] static ComponentTypeId GetOrRegister(std::type_index type) {
+        const ComponentTypeId found = Find(type);
+        if (found != kInvalidComponentTypeId) return found;
+
+        Registry& registry = Instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const IdTable* current = registry.table.load(std::memory_order_relaxed);
+        if (current) {
+            auto it = current->find(type);
+            if (it != current->end()) return it->second;
+        }
+
+        // 複製に追加して公開（読み取り中の旧テーブルは破棄しない）
+        auto next = current ? std::make_unique<IdTable>(*current) : std::make_unique<IdTable>();
+        const auto id = static_cast<ComponentTypeId>(next->size());
+        next->emplace(type, id);
+        registry.table.store(next.get(), std::memory_order_release);
+        registry.count.store(static_cast<uint32_t>(next->size()), std::memory_order_release);
+        registry.tables.push_back(std::move(next));
+        return id;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief type_indexのIDを検索（未登録ならkInvalidComponentTypeId）
+    //!
+    //! 未登録の型はどのArchetypeにも含まれないため、検索側では登録しない。
+    //! 公開中のテーブルを読むだけでロックは取らない。
+    //------------------------------------------------------------------------
+    [[nodiscard]] static ComponentTypeId Find(std::type_index type) {
+        const IdTable* table = Instance().table.load(std::memory_order_acquire);
+        if (!table) return kInvalidComponentTypeId;
+        auto it = table->find(type);
+        return it != table->end() ? it->second : kInvalidComponentTypeId;
+    }
+
+    //! @brief 登録済みの型数
+    [[nodiscard]] static uint32_t GetCount() noexcept {
+        return Instance().count.load(std::memory_order_acquire);
+    }
+
+private:
+    using IdTable = std::unordered_map<std::type_index, ComponentTypeId>;
+
+    struct Registry {
+        std::mutex mutex;                                   //!< 登録同士の排他（検索では取らない）
+        std::atomic<const IdTable*> table{nullptr};         //!< 公開中の対応表（不変）
+        std::vector<std::unique_ptr<IdTable>> tables;       //!< 公開した全テーブル（検索中の参照を保つため保持）
+        std::atomic<uint32_t> count{0};
+    };
+
+    static Registry& Instance() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+//============================================================================
+//! @brief ComponentSignature
+//!
+//! ComponentTypeIdをビット位置とするコンポーネント構成のビット集合。
+//! Archetypeのマッチングを型ごとの検索ではなくワード単位のANDで行う。
+//============================================================================
+class ComponentSignature {
+public:
+    ComponentSignature() = default;
+
+    //! @brief 型群からシグネチャを構築
+    template<typename... Ts>
+    [[nodiscard]] static ComponentSignature Of() {
+        ComponentSignature signature;
+        (signature.Set(ComponentTypeRegistry::Get<Ts>()), ...);
+        return signature;
+    }
+
+    //! @brief IDのビットを立てる
+    void Set(ComponentTypeId id) {
+        const size_t word = id / 64;
+        if (word >= words_.size()) {
+            words_.resize(word + 1, 0);
+        }
+        words_[word] |= uint64_t{1} << (id % 64);
+    }
+
+    //! @brief IDのビットが立っているか
+    [[nodiscard]] bool Test(ComponentTypeId id) const noexcept {
+        const size_t word = id / 64;
+        return word < words_.size() && (words_[word] & (uint64_t{1} << (id % 64))) != 0;
+    }
+
+    //! @brief otherの全ビットを含むか
+    [[nodiscard]] bool ContainsAll(const ComponentSignature& other) const noexcept {
+        for (size_t i = 0; i < other.words_.size(); ++i) {
+            const uint64_t mine = i < words_.size() ? words_[i] : 0;
+            if ((other.words_[i] & ~mine) != 0) return false;
+        }
+        return true;
+    }
+
+    //! @brief otherと共通のビットを持つか
+    [[nodiscard]] bool Intersects(const ComponentSignature& other) const noexcept {
+        const size_t count = (std::min)(words_.size(), other.words_.size());
+        for (size_t i = 0; i < count; ++i) {
+            if ((words_[i] & other.words_[i]) != 0) return true;
+        }
+        return false;
+    }
+
+    //! @brief ビットが1つも立っていないか
+    [[nodiscard]] bool Empty() const noexcept {
+        for (uint64_t word : words_) {
+            if (word != 0) return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+} // namespace ECS
@@ -5,3 +5,8 @@
 #pragma once
 
 #include "animator_data.h"
+#include "skeletal_animation_data.h"
+#include "skeleton_ref_data.h"
+#include "animation_cursor_key.h"
+#include "animation_lod_data.h"
+#include "skinning_matrix.h"
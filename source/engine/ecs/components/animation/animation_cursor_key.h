@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------
+//! @file   animation_cursor_key.h
+//! @brief  ECS AnimationCursorKey - 圧縮クリップの再生カーソル（DynamicBuffer）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/buffer/buffer_element.h"
+#include "engine/ecs/buffer/internal_buffer_capacity.h"
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 圧縮クリップの再生カーソル（バッファ要素）
+//!
+//! 2バイト。CompressedAnimationClipのアニメーショントラックごとの区間先頭キー。
+//! フレーム間で保持することで、サンプリングは前回の区間から前後に歩くだけになる。
+//! AnimationSystemが管理するので、利用側はバッファを追加するだけでよい
+//! （なければ毎フレーム先頭から探す）。
+//============================================================================
+struct AnimationCursorKey : public IBufferElement {
+    uint16_t value = 0;     //!< 区間先頭キー (2 bytes)
+};
+
+ECS_BUFFER_ELEMENT(AnimationCursorKey);
+static_assert(sizeof(AnimationCursorKey) == 2, "AnimationCursorKey must be 2 bytes");
+
+} // namespace ECS
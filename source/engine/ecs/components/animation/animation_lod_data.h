@@ -0,0 +1,55 @@
+//----------------------------------------------------------------------------
+//! @file   animation_lod_data.h
+//! @brief  ECS AnimationLODData - スケルタルアニメーションのLOD
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/component_data.h"
+#include "engine/game_object/components/animation/animation_lod.h"
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief スケルタルアニメーションのLOD（POD構造体）
+//!
+//! SkeletalAnimationDataと一緒に持たせると、AnimationSystemが
+//! アクティブカメラからの距離（LODSystemと同じくLocalToWorldの位置）で
+//! ポーズの評価を間引く。再生時間は毎フレーム進む。
+//!
+//! - 距離に応じて 1/2/4 フレームに1回評価（phaseでインスタンスごとにずらす）
+//! - 最遠レベルではAnimationSystem::SetLODBoneMask()のボーンだけ評価
+//! - 視錐台の外、またはLODRangeDataの範囲外では評価を止め、
+//!   復帰時は停止していたポーズから補間する
+//!
+//! @note メモリレイアウト: 24 bytes
+//!
+//! @code
+//! world.AddComponent<AnimationLODData>(character);
+//! world.AddComponent<LODRangeData>(character, LODRangeData::Near());  // 50mより遠いと停止
+//! @endcode
+//============================================================================
+struct AnimationLODData : public IComponentData {
+    static constexpr uint8_t kAutoPhase = 0xFF;  //!< ActorのIndexから位相を決める
+
+    AnimationLODSettings settings;      //!< 距離しきい値・復帰補間時間
+    AnimationLODState state;            //!< 現在のレベル・停止状態（システムが管理）
+    uint8_t phase = kAutoPhase;         //!< 評価フレームの位相
+    uint8_t _pad0[3] = {};
+
+    AnimationLODData() = default;
+    explicit AnimationLODData(const AnimationLODSettings& lodSettings)
+        : settings(lodSettings) {}
+
+    //! @brief 現在のLODレベル
+    [[nodiscard]] AnimationLODLevel GetLevel() const noexcept { return state.level; }
+
+    //! @brief 画面外で停止中か
+    [[nodiscard]] bool IsFrozen() const noexcept { return state.frozen; }
+};
+
+ECS_COMPONENT(AnimationLODData);
+static_assert(sizeof(AnimationLODData) == 24, "AnimationLODData must be 24 bytes");
+
+} // namespace ECS
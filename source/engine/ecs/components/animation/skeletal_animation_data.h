@@ -0,0 +1,78 @@
+//----------------------------------------------------------------------------
+//! @file   skeletal_animation_data.h
+//! @brief  ECS SkeletalAnimationData - スケルタルアニメーション再生状態
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/component_data.h"
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief スケルタルアニメーションの再生状態（POD構造体）
+//!
+//! 再生するクリップはAnimationSystemに登録したクリップIDで参照する。
+//! クリップ本体（AnimationClip / CompressedAnimationClip）は全インスタンスで
+//! 共有する不変データで、インスタンスごとに持つのはこの再生状態だけ。
+//!
+//! AnimationSystemが時間を進め、SkinningMatrixバッファへポーズを書き出す。
+//!
+//! @note メモリレイアウト: 20 bytes
+//============================================================================
+struct SkeletalAnimationData : public IComponentData {
+    static constexpr uint32_t kInvalidId = UINT32_MAX;  //!< クリップなし
+
+    uint32_t clip = kInvalidId;         //!< 再生中のクリップID
+    uint32_t boundClip = kInvalidId;    //!< カーソルがバインドされているクリップID（システムが管理）
+    float time = 0.0f;                  //!< 再生時間（秒）
+    float speed = 1.0f;                 //!< 再生速度
+    uint8_t flags = kFlagPlaying;       //!< Playing(0x01)
+    uint8_t _pad0[3] = {};
+
+    //------------------------------------------------------------------------
+    // フラグ定数
+    //------------------------------------------------------------------------
+    static constexpr uint8_t kFlagPlaying = 0x01;
+
+    //------------------------------------------------------------------------
+    // ヘルパー関数
+    //------------------------------------------------------------------------
+
+    //! @brief 再生中かどうか
+    [[nodiscard]] bool IsPlaying() const noexcept {
+        return (flags & kFlagPlaying) != 0;
+    }
+
+    //! @brief 再生状態を設定
+    void SetPlaying(bool playing) noexcept {
+        flags = playing ? (flags | kFlagPlaying) : (flags & ~kFlagPlaying);
+    }
+
+    //! @brief クリップを先頭から再生
+    //! @param clipId AnimationSystemに登録したクリップID
+    void Play(uint32_t clipId) noexcept {
+        clip = clipId;
+        time = 0.0f;
+        SetPlaying(true);
+    }
+
+    //! @brief 停止（現在のポーズを維持）
+    void Stop() noexcept {
+        SetPlaying(false);
+    }
+
+    //------------------------------------------------------------------------
+    // コンストラクタ
+    //------------------------------------------------------------------------
+    SkeletalAnimationData() = default;
+
+    explicit SkeletalAnimationData(uint32_t clipId, float playbackSpeed = 1.0f)
+        : clip(clipId)
+        , speed(playbackSpeed) {}
+};
+
+ECS_COMPONENT(SkeletalAnimationData);
+
+} // namespace ECS
@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------
+//! @file   skeleton_ref_data.h
+//! @brief  ECS SkeletonRefData - 共有スケルトンへの参照
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/component_data.h"
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 共有スケルトンへの参照（POD構造体）
+//!
+//! AnimationSystemに登録したスケルトンIDを持つ。
+//! 同じ骨格のキャラクターは1つのSkeletonを共有する。
+//!
+//! @note メモリレイアウト: 4 bytes
+//============================================================================
+struct SkeletonRefData : public IComponentData {
+    static constexpr uint32_t kInvalidId = UINT32_MAX;  //!< スケルトンなし
+
+    uint32_t skeleton = kInvalidId;     //!< スケルトンID
+
+    SkeletonRefData() = default;
+    explicit SkeletonRefData(uint32_t skeletonId) : skeleton(skeletonId) {}
+
+    //! @brief 有効な参照か
+    [[nodiscard]] bool IsValid() const noexcept { return skeleton != kInvalidId; }
+};
+
+ECS_COMPONENT(SkeletonRefData);
+
+} // namespace ECS
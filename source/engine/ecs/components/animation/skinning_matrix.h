@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------
+//! @file   skinning_matrix.h
+//! @brief  ECS SkinningMatrix - スキニング行列（DynamicBuffer）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/buffer/buffer_element.h"
+#include "engine/ecs/buffer/internal_buffer_capacity.h"
+#include "engine/math/math_types.h"
+
+namespace ECS {
+
+//============================================================================
+//! @brief スキニング行列（バッファ要素）
+//!
+//! 64バイト。ボーンごとの 逆バインド行列 × グローバル変換行列。
+//! AnimationSystemがボーン数に合わせて伸縮し、毎フレーム書き込む。
+//! DynamicBuffer<SkinningMatrix>として使用する。
+//!
+//! @code
+//! auto matrices = world.GetBuffer<SkinningMatrix>(character);
+//! // matrices.Data() をそのまま定数バッファへコピーできる
+//! @endcode
+//============================================================================
+struct SkinningMatrix : public IBufferElement {
+    Matrix value;   //!< スキニング行列 (64 bytes)
+};
+
+// コンパイル時検証
+ECS_BUFFER_ELEMENT(SkinningMatrix);
+static_assert(sizeof(SkinningMatrix) == sizeof(Matrix), "SkinningMatrix must be a bare Matrix");
+
+} // namespace ECS
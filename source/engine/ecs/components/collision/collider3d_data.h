@@ -67,7 +67,7 @@ struct alignas(16) Collider3DData : public IComponentData {
     // 状態（8 bytes）
     //------------------------------------------------------------------------
     Collider3DShape shapeType = Collider3DShape::AABB;  //!< 形状タイプ
-    uint8_t flags = 0x01;              //!< enabled(bit0), trigger(bit1), static(bit2)
+    uint8_t flags = 0x01;              //!< enabled(bit0), trigger(bit1), static(bit2), continuous(bit3)
     uint16_t _pad3 = 0;
     uint32_t _pad4 = 0;
 
@@ -77,11 +77,19 @@ struct alignas(16) Collider3DData : public IComponentData {
     [[nodiscard]] bool IsEnabled() const noexcept { return (flags & 0x01) != 0; }
     [[nodiscard]] bool IsTrigger() const noexcept { return (flags & 0x02) != 0; }
     [[nodiscard]] bool IsStatic() const noexcept  { return (flags & 0x04) != 0; }
+    [[nodiscard]] bool IsContinuous() const noexcept { return (flags & 0x08) != 0; }
 
     void SetEnabled(bool v) noexcept { flags = v ? (flags | 0x01) : (flags & ~0x01); }
     void SetTrigger(bool v) noexcept { flags = v ? (flags | 0x02) : (flags & ~0x02); }
     void SetStatic(bool v) noexcept  { flags = v ? (flags | 0x04) : (flags & ~0x04); }
 
+    //! @brief 連続衝突判定（CCD）を有効化
+    //! @note VelocityDataを持つ高速な物体（弾丸など）に使う。
+    //!       1ステップの移動量で掃引したAABBをBroad-phaseへ入れ、
+    //!       薄いコライダーのすり抜けを衝突時刻付きのイベントとして検出する。
+    //! @note 検出のみで、すり抜け自体は止めない（RigidBodySystemも応答しない）。
+    void SetContinuous(bool v) noexcept { flags = v ? (flags | 0x08) : (flags & ~0x08); }
+
     //! @brief AABBとして初期化
     void SetAsAABB(float hx, float hy, float hz) noexcept {
         shapeType = Collider3DShape::AABB;
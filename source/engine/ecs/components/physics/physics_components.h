@@ -10,6 +10,7 @@
 #include "physics_damping_data.h"
 #include "physics_gravity_factor_data.h"
 #include "physics_mass_override_data.h"
+#include "rigid_body_data.h"
 
 namespace ECS {
 
@@ -24,6 +25,7 @@ namespace ECS {
 //! | PhysicsDampingData        | 8B     | 減衰（空気抵抗）            |
 //! | PhysicsGravityFactorData  | 4B     | 個別重力スケール            |
 //! | PhysicsMassOverrideData   | 4B     | キネマティック設定          |
+//! | RigidBodyData             | 16B    | 接触応答・スリープ          |
 //!
 //! 典型的な構成例:
 //!
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------
+//! @file   rigid_body_data.h
+//! @brief  ECS RigidBodyData - 接触応答・スリープ状態
+//! @ref    Unity DOTS PhysicsBody
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/component_data.h"
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 剛体データ（POD構造体）
+//!
+//! RigidBodySystemで接触応答を受けるActorに付ける。
+//! VelocityData + PhysicsMassData + LocalTransform + Collider3DData と組み合わせる。
+//! AngularVelocityDataも持つ場合は接触で回転する（持たなければ回転しない）。
+//!
+//! 付けていないCollider3DDataは静的（無限質量）な相手として扱われる。
+//!
+//! @note メモリレイアウト: 16 bytes
+//!
+//! @code
+//! world.AddComponent<RigidBodyData>(crate, RigidBodyData(0.6f, 0.1f));
+//!
+//! // 外から速度を与えた場合は起こす
+//! world.GetComponent<RigidBodyData>(crate)->WakeUp();
+//! @endcode
+//============================================================================
+struct RigidBodyData : public IComponentData {
+    float friction = 0.5f;          //!< 摩擦係数
+    float restitution = 0.0f;       //!< 反発係数（0 = 跳ねない）
+    float sleepTimer = 0.0f;        //!< 静止が続いている時間（秒）
+    uint16_t contactCount = 0;      //!< 直前のステップでの接触数
+    uint8_t sleeping = 0;           //!< スリープ中フラグ
+    uint8_t _pad = 0;               //!< パディング
+
+    //------------------------------------------------------------------------
+    // コンストラクタ
+    //------------------------------------------------------------------------
+    RigidBodyData() = default;
+
+    RigidBodyData(float frictionCoefficient, float restitutionCoefficient) noexcept
+        : friction(frictionCoefficient), restitution(restitutionCoefficient) {}
+
+    //------------------------------------------------------------------------
+    // ヘルパー関数
+    //------------------------------------------------------------------------
+
+    //! @brief スリープ中か
+    [[nodiscard]] bool IsSleeping() const noexcept {
+        return sleeping != 0;
+    }
+
+    //! @brief 起こす（同じアイランドの剛体も次のステップで起きる）
+    void WakeUp() noexcept {
+        sleeping = 0;
+        sleepTimer = 0.0f;
+    }
+};
+
+// コンパイル時検証
+ECS_COMPONENT(RigidBodyData);
+static_assert(sizeof(RigidBodyData) == 16, "RigidBodyData must be 16 bytes");
+
+} // namespace ECS
@@ -15,19 +15,17 @@ namespace ECS {
 
 template<typename... Ts>
 bool CachedQuery<Ts...>::IsCacheValid() const noexcept {
-    return cacheVersion_ == world_->GetArchetypeStorage().GetQueryCache().GetVersion();
+    return cachedArchetypes_ &&
+           cacheVersion_ == world_->GetArchetypeStorage().GetQueryCache().GetVersion();
 }
 
 template<typename... Ts>
 void CachedQuery<Ts...>::RebuildCache() {
-    cachedArchetypes_.clear();
-
     ArchetypeStorage& storage = world_->GetArchetypeStorage();
 
-    // マッチするArchetypeを収集
-    storage.ForEachMatchingFiltered<Ts...>([this](Archetype& arch) {
-        cachedArchetypes_.push_back(&arch);
-    });
+    // マッチするArchetypeの配列を取得（Changed<T>はTの所持で判定）
+    // 以降に作成されたArchetypeはQueryCache側で追加される
+    cachedArchetypes_ = &storage.GetMatchingArchetypes<unwrap_access_t<Ts>...>();
 
     // 現在のバージョンを記録
     cacheVersion_ = storage.GetQueryCache().GetVersion();
@@ -40,21 +38,34 @@ size_t CachedQuery<Ts...>::Count() {
     }
 
     size_t count = 0;
-    for (Archetype* arch : cachedArchetypes_) {
+    for (Archetype* arch : *cachedArchetypes_) {
         count += arch->GetActorCount();
     }
     return count;
 }
 
 //----------------------------------------------------------------------------
-// ヘルパー: オフセット取得とコンポーネント参照取得
+// ヘルパー: SoA配列からのコンポーネント参照取得
 //----------------------------------------------------------------------------
 namespace detail {
 
+//! T -> T&（書き込みとみなす）、Changed<T> -> const T&（変更判定の入力）
 template<typename T>
-T& GetComponentRef(Archetype& arch, std::byte* compBase, uint16_t index, size_t compDataSize) {
-    size_t offset = arch.GetComponentOffset<T>();
-    return *reinterpret_cast<T*>(compBase + index * compDataSize + offset);
+decltype(auto) GetCachedQueryArg(std::byte* arrayBase, uint16_t index) noexcept {
+    using Component = unwrap_access_t<T>;
+    Component* array = reinterpret_cast<Component*>(arrayBase);
+    if constexpr (is_changed_v<T>) {
+        return static_cast<const Component&>(array[index]);
+    } else {
+        return (array[index]);
+    }
+}
+
+template<typename... Ts, typename Func, size_t... Is>
+void InvokeCachedQuery(Func& func, Actor actor, uint16_t index,
+                       const std::array<std::byte*, sizeof...(Ts)>& arrayBases,
+                       std::index_sequence<Is...>) {
+    func(actor, GetCachedQueryArg<Ts>(arrayBases[Is], index)...);
 }
 
 } // namespace detail
@@ -67,19 +78,46 @@ void CachedQuery<Ts...>::ForEach(Func&& func) {
         RebuildCache();
     }
 
+    ArchetypeStorage& storage = world_->GetArchetypeStorage();
+    const uint32_t writeVersion = storage.GetWriteVersion();
+    const uint32_t sinceVersion = SystemAPI::LastRunVersion();
+
     // キャッシュされたArchetypeをイテレーション
-    for (Archetype* arch : cachedArchetypes_) {
+    // （funcがArchetypeを作成して配列が伸びても、開始時点の分だけ処理する）
+    const std::vector<Archetype*>& archetypes = *cachedArchetypes_;
+    const size_t archetypeCount = archetypes.size();
+    for (size_t ai = 0; ai < archetypeCount; ++ai) {
+        Archetype* arch = archetypes[ai];
         const auto& metas = arch->GetChunkMetas();
-        size_t compDataSize = arch->GetComponentDataSize();
+
+        // Changed<T>以外は非const参照を渡すため書き込みとみなす
+        const std::array<size_t, sizeof...(Ts)> compIndices = {
+            arch->GetComponentIndex<unwrap_access_t<Ts>>()...
+        };
+        constexpr std::array<bool, sizeof...(Ts)> isChanged = { is_changed_v<Ts>... };
 
         for (size_t ci = 0; ci < metas.size(); ++ci) {
-            const Actor* actors = arch->GetActorArray(ci);
-            std::byte* compBase = arch->GetComponentDataBase(ci);
+            const uint16_t count = metas[ci].count;
+            if (count == 0) continue;
+
+            // 変更フィルタ: Changed<T>がいずれも未変更のChunkはスキップ
+            if (!detail::PassesChangedFilter<Ts...>(*arch, ci, sinceVersion)) continue;
+
+            for (size_t k = 0; k < sizeof...(Ts); ++k) {
+                if (!isChanged[k]) {
+                    arch->MarkComponentWritten(ci, compIndices[k], writeVersion);
+                }
+            }
+
+            // SoA: 各コンポーネント配列の先頭を取得
+            const std::array<std::byte*, sizeof...(Ts)> arrayBases = {
+                reinterpret_cast<std::byte*>(arch->GetComponentArray<unwrap_access_t<Ts>>(ci))...
+            };
 
-            for (uint16_t i = 0; i < metas[ci].count; ++i) {
-                // fold expressionで各コンポーネント参照を取得して呼び出し
-                func(actors[i],
-                     detail::GetComponentRef<Ts>(*arch, compBase, i, compDataSize)...);
+            const Actor* actors = arch->GetActorArray(ci);
+            for (uint16_t i = 0; i < count; ++i) {
+                detail::InvokeCachedQuery<Ts...>(func, actors[i], i, arrayBases,
+                                                 std::index_sequence_for<Ts...>{});
             }
         }
     }
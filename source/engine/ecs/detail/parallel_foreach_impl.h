@@ -22,6 +22,48 @@ struct ParallelChunkInfo {
     size_t chunkIndex;
 };
 
+//----------------------------------------------------------------------------
+//! @brief Chunk並列処理の分割設定
+//!
+//! 各Archetypeの末尾Chunkは満杯ではないため、Chunk数で均等分割すると
+//! 負荷が偏る。Chunk内Actor数をコストヒントとして渡し、動的分割で取り合う。
+//!
+//! @param chunkCosts Chunkごとのコスト（投入時のみ参照）
+//----------------------------------------------------------------------------
+[[nodiscard]] inline ParallelForDesc MakeChunkParallelForDesc(const std::vector<uint32_t>& chunkCosts) {
+    return ParallelForDesc()
+        .SetPartition(ParallelForPartition::Dynamic)
+        .SetItemCosts(chunkCosts);
+}
+
+//----------------------------------------------------------------------------
+//! @brief 範囲処理をJobSystemで並列実行し完了を待つ（小規模・JobSystemなしの場合は逐次）
+//!
+//! @param count 範囲の要素数
+//! @param minParallelCount これ未満の要素数は呼び出しスレッドで逐次実行
+//! @param desc 分割設定
+//! @param func 処理関数 void(uint32_t begin, uint32_t end)
+//!
+//! @note 並列実行時の各スライスは並列コンテキスト内で呼ばれる（構造変更はアサート）
+//----------------------------------------------------------------------------
+template<typename Func>
+void RunParallelRange(uint32_t count, uint32_t minParallelCount, const ParallelForDesc& desc, Func&& func) {
+    if (count == 0) return;
+
+    if (count < minParallelCount || !JobSystem::HasWorkers()) {
+        func(0u, count);
+        return;
+    }
+
+    JobSystem::Get().ParallelForRange(0, count,
+        [&func](uint32_t begin, uint32_t end) {
+#ifdef _DEBUG
+            ParallelContextGuard guard;
+#endif
+            func(begin, end);
+        }, desc).Wait();
+}
+
 //----------------------------------------------------------------------------
 //! @brief 任意数のコンポーネントに対して並列イテレーション（SoA対応レガシー版）
 //!
@@ -38,11 +80,13 @@ template<typename... Ts, typename Func,
 JobHandle World::ParallelForEach(Func&& func) {
     static_assert(sizeof...(Ts) >= 1, "ParallelForEach requires at least one component type");
 
-    // マッチするArchetypeのChunkを収集
+    // マッチするArchetypeのChunkを収集（コストヒントとしてChunk内Actor数も記録）
     std::vector<ParallelChunkInfo> chunks;
-    container_.ECS().GetArchetypeStorage().ForEachMatching<Ts...>([&chunks](Archetype& arch) {
+    std::vector<uint32_t> chunkCosts;
+    container_.ECS().GetArchetypeStorage().ForEachMatching<Ts...>([&chunks, &chunkCosts](Archetype& arch) {
         for (size_t ci = 0; ci < arch.GetChunkCount(); ++ci) {
             chunks.push_back({&arch, ci});
+            chunkCosts.push_back(arch.GetChunkActorCount(ci));
         }
     });
 
@@ -50,9 +94,10 @@ JobHandle World::ParallelForEach(Func&& func) {
         return JobHandle{};
     }
 
-    // Chunk単位で並列実行
+    // Chunk単位で並列実行（Chunk数ではなくActor数で均等化し、動的に取り合う）
     // 注意: 引数の評価順序は未規定なので、size()をmove前に取得
     const uint32_t chunkCount = static_cast<uint32_t>(chunks.size());
+    const ParallelForDesc desc = MakeChunkParallelForDesc(chunkCosts);
     return JobSystem::Get().ParallelForRange(
         0, chunkCount,
         [chunks = std::move(chunks), func = std::forward<Func>(func)]
@@ -80,7 +125,7 @@ JobHandle World::ParallelForEach(Func&& func) {
                     );
                 }
             }
-        });
+        }, desc);
 }
 
 //----------------------------------------------------------------------------
@@ -96,7 +141,8 @@ JobHandle World::ParallelForEach(Func&& func) {
 //! - ラムダ引数とアクセスモードの整合性を検証
 //!
 //! In<T>: const T& で渡される（読み取り専用）
-//! Out<T>/InOut<T>: T& で渡される（書き込み可能）
+//! Out<T>/InOut<T>: T& で渡される（書き込み可能、処理Chunkのバージョンを更新）
+//! Changed<M>: 前回のSystem実行以降に変更されたChunkのみ処理
 //----------------------------------------------------------------------------
 template<typename... AccessModes, typename Func,
          std::enable_if_t<detail::all_are_access_modes_v<AccessModes...>, int>>
@@ -119,20 +165,37 @@ JobHandle World::ParallelForEach(Func&& func) {
         "Lambda argument types must match access modes: "
         "In<T> requires const T&, Out<T>/InOut<T> requires T&");
 
-    // マッチするArchetypeのChunkを収集
+    // マッチするArchetypeのChunkを収集（コストヒントとしてChunk内Actor数も記録）
+    // Changed<M>の判定と書き込みマークは投入前にこのスレッドで行う
+    constexpr bool hasWrite = detail::has_any_write_v<AccessModes...>;
+    ArchetypeStorage& storage = container_.ECS().GetArchetypeStorage();
+    const uint32_t writeVersion = storage.GetWriteVersion();
+    const uint32_t sinceVersion = SystemAPI::LastRunVersion();
+
     std::vector<ParallelChunkInfo> chunks;
-    container_.ECS().GetArchetypeStorage().ForEachMatching<unwrap_access_t<AccessModes>...>([&chunks](Archetype& arch) {
-        for (size_t ci = 0; ci < arch.GetChunkCount(); ++ci) {
-            chunks.push_back({&arch, ci});
-        }
-    });
+    std::vector<uint32_t> chunkCosts;
+    storage.ForEachMatching<unwrap_access_t<AccessModes>...>(
+        [&chunks, &chunkCosts, writeVersion, sinceVersion](Archetype& arch) {
+            for (size_t ci = 0; ci < arch.GetChunkCount(); ++ci) {
+                if (!detail::PassesChangedFilter<AccessModes...>(arch, ci, sinceVersion)) continue;
+                if constexpr (hasWrite) {
+                    detail::MarkWrittenComponents<AccessModes...>(
+                        arch, ci, writeVersion, {},
+                        std::index_sequence_for<AccessModes...>{}
+                    );
+                }
+                chunks.push_back({&arch, ci});
+                chunkCosts.push_back(arch.GetChunkActorCount(ci));
+            }
+        });
 
     if (chunks.empty()) {
         return JobHandle{};
     }
 
-    // Chunk単位で並列実行
+    // Chunk単位で並列実行（Chunk数ではなくActor数で均等化し、動的に取り合う）
     const uint32_t chunkCount = static_cast<uint32_t>(chunks.size());
+    const ParallelForDesc desc = MakeChunkParallelForDesc(chunkCosts);
     return JobSystem::Get().ParallelForRange(
         0, chunkCount,
         [chunks = std::move(chunks), func = std::forward<Func>(func)]
@@ -163,7 +226,7 @@ JobHandle World::ParallelForEach(Func&& func) {
                     );
                 }
             }
-        });
+        }, desc);
 }
 
 } // namespace ECS
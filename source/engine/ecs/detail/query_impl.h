@@ -35,10 +35,10 @@ void SetTuplePointersSoA(
 inline bool PassesChangeFiltersImpl(
     const Archetype& arch,
     size_t chunkIndex,
-    const std::vector<std::pair<std::type_index, uint32_t>>& changeFilters)
+    const std::vector<std::pair<ComponentTypeId, uint32_t>>& changeFilters)
 {
-    for (const auto& [typeIdx, sinceVersion] : changeFilters) {
-        size_t compIdx = arch.GetComponentIndex(typeIdx);
+    for (const auto& [typeId, sinceVersion] : changeFilters) {
+        size_t compIdx = arch.GetComponentIndexById(typeId);
         if (compIdx == SIZE_MAX) continue;  // コンポーネントがない場合はスキップ
 
         uint32_t chunkVersion = arch.GetComponentVersion(chunkIndex, compIdx);
@@ -57,7 +57,7 @@ void ForEachPureRequired(
     Archetype& arch,
     Func&& func,
     const std::vector<std::function<bool(Actor)>>& predicates,
-    const std::vector<std::pair<std::type_index, uint32_t>>& changeFilters = {})
+    const std::vector<std::pair<ComponentTypeId, uint32_t>>& changeFilters = {})
 {
     const auto& metas = arch.GetChunkMetas();
 
@@ -106,7 +106,7 @@ struct ForEachDispatcher<std::tuple<PureTs...>, Func> {
         Archetype& arch,
         Func&& func,
         const std::vector<std::function<bool(Actor)>>& predicates,
-        const std::vector<std::pair<std::type_index, uint32_t>>& changeFilters = {})
+        const std::vector<std::pair<ComponentTypeId, uint32_t>>& changeFilters = {})
     {
         ForEachPureRequired<PureTs...>(arch, std::forward<Func>(func), predicates, changeFilters);
     }
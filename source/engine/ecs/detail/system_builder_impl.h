@@ -29,6 +29,7 @@ void SystemBuilder<T>::Commit() {
     entry.runAfter = std::move(runAfter_);
     entry.runBefore = std::move(runBefore_);
     entry.name = name_;
+    entry.access = std::move(access_);
 
     // Worldに登録
     world_->CommitSystem(std::move(entry));
@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------
+//! @file   system_executor_impl.h
+//! @brief  SystemExecutor::RunSystem() 実装
+//!
+//! world.h と system_executor.h の循環依存を解決するための実装ファイル。
+//! world.h の末尾でインクルードすること。
+//----------------------------------------------------------------------------
+#pragma once
+
+#include "engine/ecs/system_executor.h"
+#include "engine/ecs/system_api.h"
+#include "engine/ecs/world.h"
+
+namespace ECS {
+
+//----------------------------------------------------------------------------
+// SystemExecutor::RunSystem()
+//----------------------------------------------------------------------------
+inline void SystemExecutor::RunSystem(ISystem& system, SystemState& state, World& world, float dt) {
+    // 実行開始時のバージョンを次回の基準にする
+    // （実行中に書き込んだChunkは次回も変更ありとして扱われる）
+    const uint32_t runVersion = world.GetArchetypeStorage().GetWriteVersion();
+
+    state.world = &world;
+    state.deltaTime = dt;
+    state.time += dt;
+    state.frameCount = world.GetFrameCounter();
+
+    // 例外時も呼び出し元の状態に戻す（入れ子の直接実行に対応）
+    struct CurrentStateScope {
+        SystemState* previous;
+        explicit CurrentStateScope(SystemState* current) : previous(SystemAPI::GetCurrentState()) {
+            SystemAPI::SetCurrentState(current);
+        }
+        ~CurrentStateScope() { SystemAPI::SetCurrentState(previous); }
+    } scope(&state);
+
+    system.OnUpdate(world, dt);
+    state.lastRunVersion = runVersion;
+}
+
+} // namespace ECS
@@ -23,37 +23,53 @@ TypedQuery<AccessModes...> ActorRegistry::Query() {
 template<typename... AccessModes>
 template<typename Func>
 void TypedQuery<AccessModes...>::ForEach(Func&& func) {
-    // コンポーネント型を抽出
-    using ComponentTypes = std::tuple<unwrap_access_t<AccessModes>...>;
+    constexpr bool hasWrite = detail::has_any_write_v<AccessModes...>;
+
+    ArchetypeStorage& storage = registry_->GetArchetypeStorage();
+    const uint32_t writeVersion = storage.GetWriteVersion();
+    const uint32_t sinceVersion = sinceVersion_;
 
     // フィルター条件を取得
-    const auto& withTypes = this->GetWithTypes();
-    const auto& withoutTypes = this->GetWithoutTypes();
+    const ComponentSignature& withSignature = this->GetWithSignature();
+    const ComponentSignature& withoutSignature = this->GetWithoutSignature();
 
     // マッチするArchetypeをイテレーション
-    registry_->GetArchetypeStorage().ForEachMatching<unwrap_access_t<AccessModes>...>(
-        [&func, &withTypes, &withoutTypes](Archetype& arch) {
-            // With フィルター: 必須コンポーネントをすべて持っているか確認
-            for (const auto& typeIdx : withTypes) {
-                if (!arch.HasComponentByTypeIndex(typeIdx)) {
-                    return;  // このArchetypeをスキップ
-                }
-            }
-
-            // Without フィルター: 除外コンポーネントを持っていないか確認
-            for (const auto& typeIdx : withoutTypes) {
-                if (arch.HasComponentByTypeIndex(typeIdx)) {
-                    return;  // このArchetypeをスキップ
-                }
+    storage.ForEachMatching<unwrap_access_t<AccessModes>...>(
+        [&func, &withSignature, &withoutSignature, writeVersion, sinceVersion](Archetype& arch) {
+            // With/Without フィルター: 必須を全て持ち、除外を1つも持たないか
+            const ComponentSignature& signature = arch.GetSignature();
+            if (!signature.ContainsAll(withSignature) || signature.Intersects(withoutSignature)) {
+                return;  // このArchetypeをスキップ
             }
 
-            // オフセット配列を取得
-            auto offsets = detail::GetOffsets<AccessModes...>(arch);
-
             // 各Chunkを処理
             const auto& metas = arch.GetChunkMetas();
             for (size_t ci = 0; ci < metas.size(); ++ci) {
-                detail::ProcessChunk<AccessModes...>(arch, ci, offsets, func);
+                const uint16_t count = metas[ci].count;
+                if (count == 0) continue;
+
+                // 変更フィルタ: 入力が変更されていないChunkはスキップ
+                if (!detail::PassesChangedFilter<AccessModes...>(arch, ci, sinceVersion)) continue;
+
+                if constexpr (hasWrite) {
+                    detail::MarkWrittenComponents<AccessModes...>(
+                        arch, ci, writeVersion, {},
+                        std::index_sequence_for<AccessModes...>{}
+                    );
+                }
+
+                // SoA: 各コンポーネント配列の先頭を取得
+                std::array<std::byte*, sizeof...(AccessModes)> arrayBases = {
+                    reinterpret_cast<std::byte*>(arch.GetComponentArray<unwrap_access_t<AccessModes>>(ci))...
+                };
+
+                const Actor* actors = arch.GetActorArray(ci);
+                for (uint16_t i = 0; i < count; ++i) {
+                    detail::InvokeWithComponentsSoA<AccessModes...>(
+                        func, actors[i], i, arrayBases,
+                        std::index_sequence_for<AccessModes...>{}
+                    );
+                }
             }
         }
     );
@@ -94,11 +94,14 @@ void LogComponentAssertFailure(
 inline thread_local bool g_inParallelEcsContext = false;
 
 //! ParallelForEach実行中にフラグを立てるRAIIガード
+//! 入れ子（並列System内のRunParallelRange等）でも外側の状態を復元する
 struct ParallelContextGuard {
-    ParallelContextGuard() noexcept { g_inParallelEcsContext = true; }
-    ~ParallelContextGuard() noexcept { g_inParallelEcsContext = false; }
+    ParallelContextGuard() noexcept : previous_(g_inParallelEcsContext) { g_inParallelEcsContext = true; }
+    ~ParallelContextGuard() noexcept { g_inParallelEcsContext = previous_; }
     ParallelContextGuard(const ParallelContextGuard&) = delete;
     ParallelContextGuard& operator=(const ParallelContextGuard&) = delete;
+private:
+    bool previous_;
 };
 #endif
 
@@ -0,0 +1,296 @@
+//----------------------------------------------------------------------------
+//! @file   contact_solver.h
+//! @brief  接触マニフォールドと逐次インパルス法ソルバー
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/collision/dynamic_aabb_tree_3d.h"
+#include "engine/math/math_types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace Physics {
+
+//============================================================================
+//! @brief 対称3x3行列（ワールド空間の逆慣性テンソル）
+//============================================================================
+struct InverseInertia {
+    float xx = 0.0f, yy = 0.0f, zz = 0.0f;
+    float xy = 0.0f, xz = 0.0f, yz = 0.0f;
+
+    //! @brief 主軸の逆慣性と回転から作成（R * diag * R^T）
+    [[nodiscard]] static InverseInertia FromPrincipal(const Vector3& diagonal, const Quaternion& rotation) noexcept {
+        const Matrix r = Matrix::CreateFromQuaternion(rotation);
+        // 行ベクトル規約: 行iがローカル軸iのワールド方向
+        const Vector3 ax(r._11, r._12, r._13);
+        const Vector3 ay(r._21, r._22, r._23);
+        const Vector3 az(r._31, r._32, r._33);
+        InverseInertia out;
+        out.xx = diagonal.x * ax.x * ax.x + diagonal.y * ay.x * ay.x + diagonal.z * az.x * az.x;
+        out.yy = diagonal.x * ax.y * ax.y + diagonal.y * ay.y * ay.y + diagonal.z * az.y * az.y;
+        out.zz = diagonal.x * ax.z * ax.z + diagonal.y * ay.z * ay.z + diagonal.z * az.z * az.z;
+        out.xy = diagonal.x * ax.x * ax.y + diagonal.y * ay.x * ay.y + diagonal.z * az.x * az.y;
+        out.xz = diagonal.x * ax.x * ax.z + diagonal.y * ay.x * ay.z + diagonal.z * az.x * az.z;
+        out.yz = diagonal.x * ax.y * ax.z + diagonal.y * ay.y * ay.z + diagonal.z * az.y * az.z;
+        return out;
+    }
+
+    [[nodiscard]] Vector3 Transform(const Vector3& v) const noexcept {
+        return Vector3(xx * v.x + xy * v.y + xz * v.z,
+                       xy * v.x + yy * v.y + yz * v.z,
+                       xz * v.x + yz * v.y + zz * v.z);
+    }
+};
+
+//============================================================================
+//! @brief ソルバー内の剛体状態
+//!
+//! 静的・キネマティックな相手は dynamic = false（質量・慣性は0、速度は読み取りのみ）。
+//============================================================================
+struct SolverBody {
+    Vector3 linearVelocity = Vector3::Zero;
+    Vector3 angularVelocity = Vector3::Zero;
+    Vector3 position = Vector3::Zero;           //!< 回転中心（ワールド）
+    InverseInertia inverseInertia;              //!< ワールド空間の逆慣性（回転しない剛体は0）
+    float inverseMass = 0.0f;
+    bool dynamic = false;
+};
+
+//============================================================================
+//! @brief 接触点
+//============================================================================
+struct ContactPoint {
+    //! @brief 拘束方向の並び（angularA/B, responseA/B の添字）
+    enum Row : uint32_t { kNormal = 0, kTangent0 = 1, kTangent1 = 2, kRowCount = 3 };
+
+    Vector3 rA;                                 //!< 剛体Aの中心から接触点
+    Vector3 rB;                                 //!< 剛体Bの中心から接触点
+    float penetration = 0.0f;                   //!< 侵入深度
+    float normalMass = 0.0f;                    //!< 法線方向の有効質量
+    float tangentMass[2] = {0.0f, 0.0f};        //!< 接線方向の有効質量
+    float velocityBias = 0.0f;                  //!< 目標分離速度（位置補正・反発）
+    float normalImpulse = 0.0f;                 //!< 累積法線インパルス
+    float tangentImpulse[2] = {0.0f, 0.0f};     //!< 累積接線インパルス
+    Vector3 angularA[kRowCount];                //!< rA × d（Prepareで計算）
+    Vector3 angularB[kRowCount];                //!< rB × d
+    Vector3 responseA[kRowCount];               //!< IA⁻¹(rA × d)：単位インパルスによるAの角速度変化
+    Vector3 responseB[kRowCount];               //!< IB⁻¹(rB × d)
+    uint8_t id = 0;                             //!< 特徴ID（ウォームスタートの対応付け）
+};
+
+//============================================================================
+//! @brief 接触マニフォールド（1ペア分、最大4点）
+//============================================================================
+struct ContactManifold {
+    static constexpr uint32_t kMaxPoints = 4;
+
+    uint32_t bodyA = 0;                         //!< ソルバー剛体インデックス
+    uint32_t bodyB = 0;
+    Vector3 normal;                             //!< 接触法線（AからB向き）
+    Vector3 tangent[2];                         //!< 摩擦方向
+    float friction = 0.5f;
+    float restitution = 0.0f;
+    uint32_t pointCount = 0;
+    ContactPoint points[kMaxPoints];
+};
+
+//============================================================================
+//! @brief ソルバー設定
+//============================================================================
+struct ContactSolverSettings {
+    uint32_t velocityIterations = 8;            //!< 速度反復回数
+    float baumgarte = 0.2f;                     //!< 侵入補正の割合（1ステップあたり）
+    float linearSlop = 0.01f;                   //!< 補正しない侵入量
+    float maxCorrectionVelocity = 4.0f;         //!< 侵入補正速度の上限
+    float restitutionThreshold = 1.0f;          //!< 反発を適用する接近速度の下限
+};
+
+//----------------------------------------------------------------------------
+//! @brief 接触点を生成
+//!
+//! AABB同士は法線軸に垂直な重なり矩形の4隅を接触点にする（積み重ねが安定する）。
+//! 球を含むペアはNarrow-phaseの接触点1点を使う。
+//!
+//! @param normal 接触法線（AからB向き）
+//! @param contact Narrow-phaseの接触点
+//! @param boundsA 剛体AのAABB
+//! @param boundsB 剛体BのAABB
+//! @param boxBox AABB同士か（法線は軸平行であること）
+//! @param out 接触点（rA/rBは呼び出し側で設定する）
+//! @return 接触点数
+//----------------------------------------------------------------------------
+[[nodiscard]] inline uint32_t BuildContactPoints(const Vector3& normal, const Vector3& contact,
+                                                 const Collision::Bounds3D& boundsA, const Collision::Bounds3D& boundsB,
+                                                 bool boxBox, Vector3 out[ContactManifold::kMaxPoints]) noexcept {
+    if (!boxBox) {
+        out[0] = contact;
+        return 1;
+    }
+
+    const float minA[3] = { boundsA.minX, boundsA.minY, boundsA.minZ };
+    const float maxA[3] = { boundsA.maxX, boundsA.maxY, boundsA.maxZ };
+    const float minB[3] = { boundsB.minX, boundsB.minY, boundsB.minZ };
+    const float maxB[3] = { boundsB.maxX, boundsB.maxY, boundsB.maxZ };
+    const float n[3] = { normal.x, normal.y, normal.z };
+    int axis = 0;
+    if (std::abs(n[1]) > std::abs(n[axis])) axis = 1;
+    if (std::abs(n[2]) > std::abs(n[axis])) axis = 2;
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+
+    // 法線軸は重なり区間の中央、他の2軸は重なり矩形の4隅
+    const float lo[3] = { (std::max)(minA[0], minB[0]), (std::max)(minA[1], minB[1]), (std::max)(minA[2], minB[2]) };
+    const float hi[3] = { (std::min)(maxA[0], maxB[0]), (std::min)(maxA[1], maxB[1]), (std::min)(maxA[2], maxB[2]) };
+    for (uint32_t i = 0; i < 4; ++i) {
+        float p[3];
+        p[axis] = (lo[axis] + hi[axis]) * 0.5f;
+        p[u] = (i & 1) ? hi[u] : lo[u];
+        p[v] = (i & 2) ? hi[v] : lo[v];
+        out[i] = Vector3(p[0], p[1], p[2]);
+    }
+    return 4;
+}
+
+//============================================================================
+//! @brief 逐次インパルス法（Sequential Impulse）の接触ソルバー
+//!
+//! 1アイランド分のマニフォールドを解く。アイランド間で剛体を共有しないため、
+//! 異なるアイランドは別スレッドから同時に解いてよい（静的な相手は読み取りのみ）。
+//!
+//! @code
+//! for (auto& m : manifolds) solver.Prepare(m, bodies, dt);
+//! for (auto& m : manifolds) solver.WarmStart(m, bodies);
+//! for (uint32_t it = 0; it < settings.velocityIterations; ++it)
+//!     for (auto& m : manifolds) solver.Solve(m, bodies);
+//! @endcode
+//============================================================================
+class ContactSolver {
+public:
+    explicit ContactSolver(const ContactSolverSettings& settings = ContactSolverSettings()) noexcept
+        : settings_(settings) {}
+
+    [[nodiscard]] const ContactSolverSettings& GetSettings() const noexcept { return settings_; }
+
+    //------------------------------------------------------------------------
+    //! @brief ヤコビアン・有効質量・摩擦方向・目標分離速度を計算
+    //!
+    //! 反復中に外積と慣性テンソルの変換をしないよう、拘束方向ごとの
+    //! r × d と I⁻¹(r × d) をここで求めておく。
+    //------------------------------------------------------------------------
+    void Prepare(ContactManifold& m, const SolverBody* bodies, float dt) const noexcept {
+        const SolverBody& a = bodies[m.bodyA];
+        const SolverBody& b = bodies[m.bodyB];
+        BuildTangents(m.normal, m.tangent[0], m.tangent[1]);
+        const Vector3 directions[ContactPoint::kRowCount] = { m.normal, m.tangent[0], m.tangent[1] };
+
+        const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+        for (uint32_t i = 0; i < m.pointCount; ++i) {
+            ContactPoint& p = m.points[i];
+            float inverseMass[ContactPoint::kRowCount];
+            for (uint32_t row = 0; row < ContactPoint::kRowCount; ++row) {
+                p.angularA[row] = p.rA.Cross(directions[row]);
+                p.angularB[row] = p.rB.Cross(directions[row]);
+                p.responseA[row] = a.inverseInertia.Transform(p.angularA[row]);
+                p.responseB[row] = b.inverseInertia.Transform(p.angularB[row]);
+                inverseMass[row] = a.inverseMass + b.inverseMass +
+                    p.angularA[row].Dot(p.responseA[row]) + p.angularB[row].Dot(p.responseB[row]);
+            }
+            p.normalMass = inverseMass[ContactPoint::kNormal] > 0.0f ? 1.0f / inverseMass[ContactPoint::kNormal] : 0.0f;
+            for (int t = 0; t < 2; ++t) {
+                const float k = inverseMass[ContactPoint::kTangent0 + t];
+                p.tangentMass[t] = k > 0.0f ? 1.0f / k : 0.0f;
+            }
+
+            // 侵入補正（Baumgarte）と反発のうち大きい方を目標分離速度にする
+            const float correction = settings_.baumgarte * invDt * (std::max)(0.0f, p.penetration - settings_.linearSlop);
+            p.velocityBias = (std::min)(correction, settings_.maxCorrectionVelocity);
+            const float vn = RowVelocity(a, b, p, m.normal, ContactPoint::kNormal);
+            if (vn < -settings_.restitutionThreshold) {
+                p.velocityBias = (std::max)(p.velocityBias, -m.restitution * vn);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 前ステップの累積インパルスを適用
+    //------------------------------------------------------------------------
+    void WarmStart(const ContactManifold& m, SolverBody* bodies) const noexcept {
+        SolverBody& a = bodies[m.bodyA];
+        SolverBody& b = bodies[m.bodyB];
+        for (uint32_t i = 0; i < m.pointCount; ++i) {
+            const ContactPoint& p = m.points[i];
+            ApplyImpulse(a, b, p, m.normal, ContactPoint::kNormal, p.normalImpulse);
+            ApplyImpulse(a, b, p, m.tangent[0], ContactPoint::kTangent0, p.tangentImpulse[0]);
+            ApplyImpulse(a, b, p, m.tangent[1], ContactPoint::kTangent1, p.tangentImpulse[1]);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1反復分を解く（摩擦 → 法線の順）
+    //------------------------------------------------------------------------
+    void Solve(ContactManifold& m, SolverBody* bodies) const noexcept {
+        SolverBody& a = bodies[m.bodyA];
+        SolverBody& b = bodies[m.bodyB];
+
+        for (uint32_t i = 0; i < m.pointCount; ++i) {
+            ContactPoint& p = m.points[i];
+            const float maxFriction = m.friction * p.normalImpulse;
+            for (uint32_t t = 0; t < 2; ++t) {
+                const uint32_t row = ContactPoint::kTangent0 + t;
+                const float vt = RowVelocity(a, b, p, m.tangent[t], row);
+                const float old = p.tangentImpulse[t];
+                p.tangentImpulse[t] = std::clamp(old - p.tangentMass[t] * vt, -maxFriction, maxFriction);
+                ApplyImpulse(a, b, p, m.tangent[t], row, p.tangentImpulse[t] - old);
+            }
+        }
+
+        for (uint32_t i = 0; i < m.pointCount; ++i) {
+            ContactPoint& p = m.points[i];
+            const float vn = RowVelocity(a, b, p, m.normal, ContactPoint::kNormal);
+            const float old = p.normalImpulse;
+            p.normalImpulse = (std::max)(0.0f, old - p.normalMass * (vn - p.velocityBias));
+            ApplyImpulse(a, b, p, m.normal, ContactPoint::kNormal, p.normalImpulse - old);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 法線に直交する2方向
+    //------------------------------------------------------------------------
+    static void BuildTangents(const Vector3& n, Vector3& t0, Vector3& t1) noexcept {
+        // 0.57735 = 1/sqrt(3)。最大成分を含む組で作ると退化しない
+        if (std::abs(n.x) >= 0.57735f) {
+            t0 = Vector3(n.y, -n.x, 0.0f);
+        } else {
+            t0 = Vector3(0.0f, n.z, -n.y);
+        }
+        t0.Normalize();
+        t1 = n.Cross(t0);
+    }
+
+private:
+    //! @brief 接触点での方向dの相対速度（B - A）
+    [[nodiscard]] static float RowVelocity(const SolverBody& a, const SolverBody& b, const ContactPoint& p,
+                                           const Vector3& d, uint32_t row) noexcept {
+        return d.Dot(b.linearVelocity - a.linearVelocity) +
+               p.angularB[row].Dot(b.angularVelocity) - p.angularA[row].Dot(a.angularVelocity);
+    }
+
+    //! @brief 方向dのインパルスを適用（AにはBへの反作用として逆向き）。静的な相手には書き込まない
+    static void ApplyImpulse(SolverBody& a, SolverBody& b, const ContactPoint& p,
+                             const Vector3& d, uint32_t row, float impulse) noexcept {
+        if (a.dynamic) {
+            a.linearVelocity -= d * (impulse * a.inverseMass);
+            a.angularVelocity -= p.responseA[row] * impulse;
+        }
+        if (b.dynamic) {
+            b.linearVelocity += d * (impulse * b.inverseMass);
+            b.angularVelocity += p.responseB[row] * impulse;
+        }
+    }
+
+    ContactSolverSettings settings_;
+};
+
+} // namespace Physics
@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------------
+//! @file   island_builder.h
+//! @brief  接触グラフのアイランド分割（Union-Find）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Physics {
+
+//============================================================================
+//! @brief 接触でつながった動的剛体の集合（アイランド）を求める
+//!
+//! 動的剛体同士の接触で Union-Find を結合し、アイランドごとに
+//! 剛体と接触を連続した範囲へ並べ替える（計数ソート）。
+//! 静的・キネマティックな相手との接触はアイランドをつながない
+//! （地面を介して全体が1つのアイランドになるのを避けるため）。
+//!
+//! アイランド同士は剛体を共有しないため、独立に並列で解ける。
+//! 並び順は最小の剛体インデックス順で、実行ごとに変わらない。
+//!
+//! @code
+//! islands.Reset(bodyCount);
+//! islands.AddContact(a, b);     // 接触ごと（静的な相手はkNoBody、追加順が接触インデックス）
+//! islands.Build();
+//! for (uint32_t i = 0; i < islands.GetIslandCount(); ++i) {
+//!     const auto& island = islands.GetIsland(i);
+//!     // island.bodyBegin..bodyEnd → GetBodies()、contactBegin..contactEnd → GetContacts()
+//! }
+//! @endcode
+//============================================================================
+class IslandBuilder {
+public:
+    //! @brief 静的な相手を表す剛体インデックス
+    static constexpr uint32_t kNoBody = UINT32_MAX;
+
+    //! @brief 1アイランドの範囲
+    struct Island {
+        uint32_t bodyBegin;         //!< GetBodies()内の開始位置
+        uint32_t bodyEnd;           //!< GetBodies()内の終了位置
+        uint32_t contactBegin;      //!< GetContacts()内の開始位置
+        uint32_t contactEnd;        //!< GetContacts()内の終了位置
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief 動的剛体数を指定して初期化
+    //------------------------------------------------------------------------
+    void Reset(uint32_t bodyCount) {
+        parent_.resize(bodyCount);
+        size_.assign(bodyCount, 1);
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            parent_[i] = i;
+        }
+        contactOwner_.clear();
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 接触を追加（どちらかは動的剛体であること）
+    //! @param a 剛体Aのインデックス（静的ならkNoBody）
+    //! @param b 剛体Bのインデックス（静的ならkNoBody）
+    //------------------------------------------------------------------------
+    void AddContact(uint32_t a, uint32_t b) {
+        if (a != kNoBody && b != kNoBody) {
+            Union(a, b);
+        }
+        contactOwner_.push_back(a != kNoBody ? a : b);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief アイランドを確定
+    //------------------------------------------------------------------------
+    void Build() {
+        const uint32_t bodyCount = static_cast<uint32_t>(parent_.size());
+        islands_.clear();
+
+        // 根ごとにアイランド番号を振る（最小の剛体インデックス順）
+        islandOfRoot_.assign(bodyCount, kNoBody);
+        bodyIsland_.resize(bodyCount);
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            const uint32_t root = Find(i);
+            if (islandOfRoot_[root] == kNoBody) {
+                islandOfRoot_[root] = static_cast<uint32_t>(islands_.size());
+                islands_.push_back(Island{0, 0, 0, 0});
+            }
+            const uint32_t island = islandOfRoot_[root];
+            bodyIsland_[i] = island;
+            ++islands_[island].bodyEnd;
+        }
+        for (uint32_t owner : contactOwner_) {
+            ++islands_[bodyIsland_[owner]].contactEnd;
+        }
+
+        // 件数を範囲へ変換
+        uint32_t bodyOffset = 0;
+        uint32_t contactOffset = 0;
+        for (Island& island : islands_) {
+            island.bodyBegin = bodyOffset;
+            bodyOffset += island.bodyEnd;
+            island.bodyEnd = island.bodyBegin;
+            island.contactBegin = contactOffset;
+            contactOffset += island.contactEnd;
+            island.contactEnd = island.contactBegin;
+        }
+
+        // 入力順を保って詰める
+        bodies_.resize(bodyCount);
+        for (uint32_t i = 0; i < bodyCount; ++i) {
+            bodies_[islands_[bodyIsland_[i]].bodyEnd++] = i;
+        }
+        contacts_.resize(contactOwner_.size());
+        for (uint32_t c = 0; c < static_cast<uint32_t>(contactOwner_.size()); ++c) {
+            contacts_[islands_[bodyIsland_[contactOwner_[c]]].contactEnd++] = c;
+        }
+    }
+
+    [[nodiscard]] uint32_t GetIslandCount() const noexcept { return static_cast<uint32_t>(islands_.size()); }
+    [[nodiscard]] const Island& GetIsland(uint32_t index) const noexcept { return islands_[index]; }
+
+    //! @brief アイランド順に並べた剛体インデックス
+    [[nodiscard]] const std::vector<uint32_t>& GetBodies() const noexcept { return bodies_; }
+
+    //! @brief アイランド順に並べた接触インデックス（AddContactの呼び出し順）
+    [[nodiscard]] const std::vector<uint32_t>& GetContacts() const noexcept { return contacts_; }
+
+    //! @brief 剛体が属するアイランド
+    [[nodiscard]] uint32_t GetBodyIsland(uint32_t body) const noexcept { return bodyIsland_[body]; }
+
+private:
+    //! @brief 根を探す（経路半分化）
+    uint32_t Find(uint32_t i) noexcept {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    //! @brief 2つの集合を結合（サイズの大きい方へ）
+    void Union(uint32_t a, uint32_t b) noexcept {
+        a = Find(a);
+        b = Find(b);
+        if (a == b) return;
+        if (size_[a] < size_[b]) {
+            std::swap(a, b);
+        }
+        parent_[b] = a;
+        size_[a] += size_[b];
+    }
+
+    std::vector<uint32_t> parent_;          //!< Union-Findの親
+    std::vector<uint32_t> size_;            //!< 集合のサイズ（根のみ有効）
+    std::vector<uint32_t> contactOwner_;    //!< 接触ごとの代表剛体
+    std::vector<uint32_t> islandOfRoot_;    //!< 根 → アイランド番号
+    std::vector<uint32_t> bodyIsland_;      //!< 剛体 → アイランド番号
+    std::vector<uint32_t> bodies_;          //!< アイランド順の剛体
+    std::vector<uint32_t> contacts_;        //!< アイランド順の接触
+    std::vector<Island> islands_;           //!< アイランドの範囲
+};
+
+} // namespace Physics
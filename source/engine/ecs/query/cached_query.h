@@ -6,6 +6,7 @@
 
 
 #include "../actor.h"
+#include "../access_mode.h"
 #include "../archetype.h"
 #include "query_cache.h"
 #include <vector>
@@ -33,11 +34,23 @@ class ArchetypeStorage;
 //! });
 //! @endcode
 //!
-//! キャッシュ無効化:
-//! - 新しいArchetypeが作成された時（自動検知）
-//! - `Invalidate()` が呼ばれた時
+//! キャッシュ:
+//! - マッチ結果はArchetypeStorageのQueryCacheに登録され、同じ型構成の
+//!   CachedQuery間で共有される
+//! - 新しいArchetypeは作成時に照合されて追加される（再構築なし）
+//! - `Invalidate()` で参照を破棄し、次回QueryCacheから取得し直す
 //!
-//! @tparam Ts コンポーネント型群
+//! 変更追跡:
+//! - Tは T& で渡され、処理したChunkは書き込み済みとしてバージョンが更新される
+//! - Changed<T>は const T& で渡され、実行中Systemの前回実行以降に
+//!   変更されたChunkのみを処理する（複数指定時はいずれかが変更されたChunk）
+//!
+//! @code
+//! auto query = world.CreateCachedQuery<Changed<LocalToWorld>, WorldRenderBoundsData>();
+//! query.ForEach([](Actor e, const LocalToWorld& ltw, WorldRenderBoundsData& b) { ... });
+//! @endcode
+//!
+//! @tparam Ts コンポーネント型群（T または Changed<T>）
 //============================================================================
 template<typename... Ts>
 class CachedQuery {
@@ -57,7 +70,7 @@ public:
 
     //------------------------------------------------------------------------
     //! @brief マッチするActorに対してイテレーション
-    //! @tparam Func 処理関数の型 void(Actor, Ts&...)
+    //! @tparam Func 処理関数の型 void(Actor, Ts&...)（Changed<T>は const T&）
     //! @param func 各Actorに対して呼び出す関数
     //!
     //! @code
@@ -90,10 +103,10 @@ public:
     //------------------------------------------------------------------------
     //! @brief キャッシュを強制無効化
     //!
-    //! 次回のForEach/Count呼び出しでキャッシュが再構築される。
+    //! 次回のForEach/Count呼び出しでQueryCacheから取得し直す。
     //------------------------------------------------------------------------
     void Invalidate() noexcept {
-        cacheVersion_ = 0;
+        cachedArchetypes_ = nullptr;
     }
 
     //------------------------------------------------------------------------
@@ -107,16 +120,16 @@ public:
     //! @return キャッシュ内のArchetype数
     //------------------------------------------------------------------------
     [[nodiscard]] size_t CachedArchetypeCount() const noexcept {
-        return cachedArchetypes_.size();
+        return cachedArchetypes_ ? cachedArchetypes_->size() : 0;
     }
 
 private:
-    //! @brief キャッシュを再構築
+    //! @brief QueryCacheからマッチ結果を取得し直す
     void RebuildCache();
 
     World* world_;
-    std::vector<Archetype*> cachedArchetypes_;  //!< マッチするArchetypeのキャッシュ
-    uint32_t cacheVersion_;                      //!< 構築時のバージョン
+    const std::vector<Archetype*>* cachedArchetypes_ = nullptr;  //!< QueryCache内のマッチ結果
+    uint32_t cacheVersion_;                                      //!< 取得時のQueryCacheバージョン
 };
 
 } // namespace ECS
@@ -152,7 +152,7 @@ public:
     template<typename FilterT>
     Query& WithChangeFilter(uint32_t sinceVersion) {
         changeFilters_.emplace_back(
-            std::type_index(typeid(FilterT)),
+            ComponentTypeRegistry::Get<FilterT>(),
             sinceVersion
         );
         return *this;
@@ -188,9 +188,9 @@ public:
 
     //------------------------------------------------------------------------
     //! @brief 変更フィルター取得（内部用）
-    //! @return (type_index, sinceVersion)のペア配列
+    //! @return (ComponentTypeId, sinceVersion)のペア配列
     //------------------------------------------------------------------------
-    [[nodiscard]] const std::vector<std::pair<std::type_index, uint32_t>>& GetChangeFilters() const noexcept {
+    [[nodiscard]] const std::vector<std::pair<ComponentTypeId, uint32_t>>& GetChangeFilters() const noexcept {
         return changeFilters_;
     }
 
@@ -215,8 +215,8 @@ protected:
     //! @param chunkIndex Chunkインデックス
     //! @return 全ての変更フィルターを通過したらtrue
     [[nodiscard]] bool PassesChangeFilters(const Archetype& arch, size_t chunkIndex) const {
-        for (const auto& [typeIdx, sinceVersion] : changeFilters_) {
-            size_t compIdx = arch.GetComponentIndex(typeIdx);
+        for (const auto& [typeId, sinceVersion] : changeFilters_) {
+            size_t compIdx = arch.GetComponentIndexById(typeId);
             if (compIdx == SIZE_MAX) continue;  // コンポーネントがない場合はスキップ
 
             uint32_t chunkVersion = arch.GetComponentVersion(chunkIndex, compIdx);
@@ -229,7 +229,7 @@ protected:
 
     World* world_;
     std::vector<std::function<bool(Actor)>> predicates_;
-    std::vector<std::pair<std::type_index, uint32_t>> changeFilters_;  //!< 変更フィルター
+    std::vector<std::pair<ComponentTypeId, uint32_t>> changeFilters_;  //!< 変更フィルター
 };
 
 //============================================================================
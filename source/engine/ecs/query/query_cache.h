@@ -6,33 +6,55 @@
 
 
 #include "../archetype.h"
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
 
 namespace ECS {
 
-// 前方宣言
-class ArchetypeStorage;
+//============================================================================
+//! @brief QueryCache統計情報
+//============================================================================
+struct QueryCacheStats {
+    uint64_t hitCount = 0;              //!< キャッシュヒット回数
+    uint64_t missCount = 0;             //!< キャッシュミス（全Archetype走査による構築）回数
+    uint64_t archetypeTestCount = 0;    //!< 新規Archetypeと登録済みQueryの照合回数
+    uint64_t appendCount = 0;           //!< 照合によりQueryへ追加されたArchetype数
+    uint64_t rebuildTimeNs = 0;         //!< 構築に要した累計時間（ナノ秒）
+    size_t entryCount = 0;              //!< 登録済みQuery数
+
+    [[nodiscard]] double HitRate() const noexcept {
+        uint64_t total = hitCount + missCount;
+        return total > 0 ? static_cast<double>(hitCount) / total : 0.0;
+    }
+};
 
 //============================================================================
 //! @brief QueryCache
 //!
 //! Query<Ts...>のマッチング結果をキャッシュする。
-//! Archetype追加時にキャッシュを無効化し、次回Queryで再構築。
+//! 初回のみ全Archetypeを走査してエントリを構築し、以降に作成された
+//! Archetypeは作成時に登録済みの各Queryと1回だけ照合して追加する。
+//! Archetype追加によるキャッシュ全体の再構築は発生しない。
 //!
 //! 性能向上:
 //! - ForEachMatching: O(Archetype数) → O(マッチArchetype数)
-//! - 10万Entity + 100 Archetype規模で効果的
+//! - Archetype追加: O(全Query × 全Archetype) の再走査 → O(登録Query数) の照合
 //!
-//! @note メインスレッドからのみ使用すること
+//! @note エントリの構築はQuery実行中のSystemから並行に行われ得るため排他する。
+//!       OnArchetypeAdded()はArchetype作成時（構造変更、メインスレッド）にのみ呼ばれる
 //============================================================================
 class QueryCache {
 public:
+    //! Archetypeがクエリにマッチするかの判定関数
+    using MatchFunc = bool(*)(const Archetype&);
+
     //! キャッシュエントリ
     struct CacheEntry {
         std::vector<Archetype*> archetypes;
-        uint32_t version = 0;  //!< 構築時のバージョン
+        MatchFunc match = nullptr;      //!< 新規Archetypeの照合に使う判定関数
     };
 
     QueryCache() = default;
@@ -45,15 +67,20 @@ public:
     //------------------------------------------------------------------------
     //! @brief キャッシュを無効化
     //!
-    //! Archetype追加/削除時に呼び出す。
-    //! 次回のGetOrBuild呼び出しでキャッシュが再構築される。
+    //! 全エントリを破棄し、次回の参照で再構築させる。
+    //! Archetype追加時は呼び出す必要はない（OnArchetypeAdded()で追従する）。
     //------------------------------------------------------------------------
-    void Invalidate() noexcept {
+    void Invalidate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
         ++version_;
     }
 
     //------------------------------------------------------------------------
     //! @brief 現在のバージョンを取得
+    //!
+    //! エントリが破棄されるたびに増加する。GetOrBuild()が返した配列への
+    //! 参照は、バージョンが変わるまで有効。
     //------------------------------------------------------------------------
     [[nodiscard]] uint32_t GetVersion() const noexcept {
         return version_;
@@ -63,59 +90,110 @@ public:
     //! @brief キャッシュキーを計算
     //! @tparam Ts コンポーネント型群
     //! @return ハッシュ値（キャッシュキー）
+    //!
+    //! @note 型リストごとに初回のみ計算し、以降は静的変数の値を返す
     //------------------------------------------------------------------------
     template<typename... Ts>
     [[nodiscard]] static size_t CalculateKey() {
-        // 型のtype_indexを使ってFNV-1aハッシュを計算
-        size_t hash = 14695981039346656037ull;
-        ((hash ^= std::type_index(typeid(Ts)).hash_code(),
-          hash *= 1099511628211ull), ...);
-        return hash;
+        static const size_t key = [] {
+            // 型のtype_indexを使ってFNV-1aハッシュを計算
+            size_t hash = 14695981039346656037ull;
+            ((hash ^= std::type_index(typeid(Ts)).hash_code(),
+              hash *= 1099511628211ull), ...);
+            return hash;
+        }();
+        return key;
     }
 
     //------------------------------------------------------------------------
-    //! @brief キャッシュエントリを取得（なければnullptr）
+    //! @brief マッチするArchetype配列を取得（なければ構築して登録）
     //! @param key キャッシュキー
-    //! @return キャッシュエントリへのポインタ（存在しない場合はnullptr）
+    //! @param match Archetypeの判定関数
+    //! @param forEachArchetype 全Archetypeを列挙する関数 void(Func&&)（構築時のみ使用）
+    //! @return マッチするArchetypeの配列（以降のArchetype追加にも追従する）
     //------------------------------------------------------------------------
-    [[nodiscard]] CacheEntry* GetEntry(size_t key) noexcept {
+    template<typename ForEachArchetype>
+    const std::vector<Archetype*>& GetOrBuild(size_t key, MatchFunc match,
+                                              ForEachArchetype&& forEachArchetype) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
         auto it = cache_.find(key);
-        if (it != cache_.end() && it->second.version == version_) {
-            return &it->second;
+        if (it != cache_.end()) {
+            ++stats_.hitCount;
+            return it->second.archetypes;
         }
-        return nullptr;
+
+        // キャッシュミス: 全Archetypeを走査して構築
+        const auto start = std::chrono::steady_clock::now();
+
+        CacheEntry& entry = cache_[key];
+        entry.match = match;
+        forEachArchetype([&entry](Archetype& arch) {
+            if (entry.match(arch)) {
+                entry.archetypes.push_back(&arch);
+            }
+        });
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        ++stats_.missCount;
+        stats_.rebuildTimeNs += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return entry.archetypes;
     }
 
     //------------------------------------------------------------------------
-    //! @brief キャッシュエントリを設定
-    //! @param key キャッシュキー
-    //! @param archetypes マッチするArchetypeのリスト
+    //! @brief 新規Archetypeを登録済みの全Queryと照合し、マッチすれば追加
+    //! @param archetype 作成されたArchetype
     //------------------------------------------------------------------------
-    void SetEntry(size_t key, std::vector<Archetype*> archetypes) {
-        CacheEntry entry;
-        entry.archetypes = std::move(archetypes);
-        entry.version = version_;
-        cache_[key] = std::move(entry);
+    void OnArchetypeAdded(Archetype& archetype) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [key, entry] : cache_) {
+            ++stats_.archetypeTestCount;
+            if (entry.match(archetype)) {
+                entry.archetypes.push_back(&archetype);
+                ++stats_.appendCount;
+            }
+        }
     }
 
     //------------------------------------------------------------------------
     //! @brief キャッシュをクリア
     //------------------------------------------------------------------------
     void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
         cache_.clear();
-        version_ = 0;
+        ++version_;
     }
 
     //------------------------------------------------------------------------
     //! @brief キャッシュエントリ数を取得
     //------------------------------------------------------------------------
-    [[nodiscard]] size_t GetEntryCount() const noexcept {
+    [[nodiscard]] size_t GetEntryCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
         return cache_.size();
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 統計情報を取得
+    //------------------------------------------------------------------------
+    [[nodiscard]] QueryCacheStats GetStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        QueryCacheStats stats = stats_;
+        stats.entryCount = cache_.size();
+        return stats;
+    }
+
+    //! @brief 統計情報をリセット
+    void ResetStats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = QueryCacheStats{};
+    }
+
 private:
     std::unordered_map<size_t, CacheEntry> cache_;
-    uint32_t version_ = 0;  //!< キャッシュバージョン（無効化でインクリメント）
+    QueryCacheStats stats_;
+    mutable std::mutex mutex_;
+    uint32_t version_ = 0;  //!< エントリ破棄でインクリメント（参照の有効性判定用）
 };
 
 } // namespace ECS
@@ -9,6 +9,8 @@
 #include "../actor.h"
 #include "../archetype.h"
 #include "../archetype_storage.h"
+#include "../system_api.h"
+#include "../typed_foreach.h"
 #include <type_traits>
 #include <tuple>
 #include <vector>
@@ -19,77 +21,24 @@ namespace ECS {
 // 前方宣言
 class ActorRegistry;
 
-namespace detail {
-
-//============================================================================
-// ForEach実装ヘルパー
-//============================================================================
-
-// インデックスシーケンスを使ってコンポーネントを展開
-template<typename... AccessModes, typename Func, size_t... Is>
-void InvokeWithComponents(
-    Actor actor,
-    std::byte* compBase,
-    size_t compDataSize,
-    const std::array<size_t, sizeof...(AccessModes)>& offsets,
-    Func&& func,
-    std::index_sequence<Is...>)
-{
-    // 各アクセスモードに対応する型でコンポーネントを取得
-    func(
-        actor,
-        *reinterpret_cast<unwrap_access_t<AccessModes>*>(
-            compBase + offsets[Is]
-        )...
-    );
-}
-
-// Chunk内の全Actorを処理
-template<typename... AccessModes, typename Func>
-void ProcessChunk(
-    Archetype& arch,
-    size_t chunkIndex,
-    const std::array<size_t, sizeof...(AccessModes)>& offsets,
-    Func&& func)
-{
-    const auto& metas = arch.GetChunkMetas();
-    const Actor* actors = arch.GetActorArray(chunkIndex);
-    std::byte* compBase = arch.GetComponentDataBase(chunkIndex);
-    size_t compDataSize = arch.GetComponentDataSize();
-
-    for (uint16_t i = 0; i < metas[chunkIndex].count; ++i) {
-        InvokeWithComponents<AccessModes...>(
-            actors[i],
-            compBase + i * compDataSize,
-            compDataSize,
-            offsets,
-            std::forward<Func>(func),
-            std::index_sequence_for<AccessModes...>{}
-        );
-    }
-}
-
-// オフセット配列を構築
-template<typename... AccessModes>
-std::array<size_t, sizeof...(AccessModes)> GetOffsets(const Archetype& arch) {
-    return { arch.GetComponentOffset<unwrap_access_t<AccessModes>>()... };
-}
-
-} // namespace detail
-
 //============================================================================
 //! @brief TypedQuery
 //!
 //! In/Out/InOut対応の型安全クエリ。
 //! アクセスモードに基づいてconst/非constを自動決定。
+//! Out<T>/InOut<T>で処理したChunkは書き込み済みとしてバージョンが更新される。
 //!
-//! @tparam AccessModes アクセスモード群（In<T>, Out<T>, InOut<T>）
+//! @tparam AccessModes アクセスモード群（In<T>, Out<T>, InOut<T>, Changed<M>）
 //!
 //! @code
 //! registry.Query<InOut<TransformData>, In<VelocityData>>()
 //!     .ForEach([](Actor e, TransformData& t, const VelocityData& v) {
 //!         t.position += v.velocity;
 //!     });
+//!
+//! // 前回のSystem実行以降にVelocityDataが変更されたChunkのみ
+//! registry.Query<InOut<TransformData>, Changed<In<VelocityData>>>()
+//!     .ForEach([](Actor e, TransformData& t, const VelocityData& v) { ... });
 //! @endcode
 //============================================================================
 template<typename... AccessModes>
@@ -110,9 +59,12 @@ public:
     //------------------------------------------------------------------------
     //! @brief コンストラクタ
     //! @param registry ActorRegistryへのポインタ
+    //!
+    //! Changed<M>の基準バージョンは実行中Systemの前回実行時のバージョン。
     //------------------------------------------------------------------------
     explicit TypedQuery(ActorRegistry* registry) noexcept
-        : registry_(registry) {}
+        : registry_(registry)
+        , sinceVersion_(SystemAPI::LastRunVersion()) {}
 
     //------------------------------------------------------------------------
     //! @brief 全マッチActorに対してイテレーション
@@ -134,7 +86,7 @@ public:
     //------------------------------------------------------------------------
     template<typename... Ts>
     TypedQuery& With() {
-        (withTypes_.push_back(std::type_index(typeid(Ts))), ...);
+        (withSignature_.Set(ComponentTypeRegistry::Get<Ts>()), ...);
         return *this;
     }
 
@@ -147,25 +99,36 @@ public:
     //------------------------------------------------------------------------
     template<typename... Ts>
     TypedQuery& Without() {
-        (withoutTypes_.push_back(std::type_index(typeid(Ts))), ...);
+        (withoutSignature_.Set(ComponentTypeRegistry::Get<Ts>()), ...);
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief Changed<M>の基準バージョンを指定
+    //! @param version このバージョン以降に書き込まれたChunkを変更ありとみなす
+    //! @return 自身への参照
+    //------------------------------------------------------------------------
+    TypedQuery& Since(uint32_t version) noexcept {
+        sinceVersion_ = version;
         return *this;
     }
 
     //------------------------------------------------------------------------
     //! @brief フィルター条件を取得（内部用）
     //------------------------------------------------------------------------
-    [[nodiscard]] const std::vector<std::type_index>& GetWithTypes() const noexcept {
-        return withTypes_;
+    [[nodiscard]] const ComponentSignature& GetWithSignature() const noexcept {
+        return withSignature_;
     }
 
-    [[nodiscard]] const std::vector<std::type_index>& GetWithoutTypes() const noexcept {
-        return withoutTypes_;
+    [[nodiscard]] const ComponentSignature& GetWithoutSignature() const noexcept {
+        return withoutSignature_;
     }
 
 private:
     ActorRegistry* registry_;
-    std::vector<std::type_index> withTypes_;     //!< 必須コンポーネント型
-    std::vector<std::type_index> withoutTypes_;  //!< 除外コンポーネント型
+    ComponentSignature withSignature_;      //!< 必須コンポーネント型
+    ComponentSignature withoutSignature_;   //!< 除外コンポーネント型
+    uint32_t sinceVersion_;                 //!< Changed<M>の基準バージョン
 };
 
 } // namespace ECS
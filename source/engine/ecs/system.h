@@ -8,6 +8,7 @@ namespace ECS {
 
 // 前方宣言
 class World;
+struct SystemAccess;
 
 //============================================================================
 //! @brief 更新システムの基底クラス
@@ -77,6 +78,22 @@ public:
     //------------------------------------------------------------------------
     virtual const char* Name() const { return "ISystem"; }
 
+    //------------------------------------------------------------------------
+    //! @brief コンポーネントアクセスを宣言（登録時に1回呼ばれる）
+    //! @param access 宣言先（Read/Write/With/Structural）
+    //!
+    //! 宣言したSystemは、競合しない他のSystemとJobSystem上で同時に実行される。
+    //! 宣言しない場合は同期点としてメインスレッドで単独実行される。
+    //! RegisterSystemWithDeps<T>()での宣言はここでの宣言に追加される。
+    //!
+    //! @code
+    //! void DeclareAccess(SystemAccess& access) const override {
+    //!     access.With<InOut<LocalTransform>, In<VelocityData>>();
+    //! }
+    //! @endcode
+    //------------------------------------------------------------------------
+    virtual void DeclareAccess(SystemAccess& access) const { (void)access; }
+
 };
 
 //============================================================================
@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------
+//! @file   system_access.h
+//! @brief  ECS SystemAccess - Systemのコンポーネントアクセス宣言
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "access_mode.h"
+#include <vector>
+#include <typeindex>
+#include <algorithm>
+
+namespace ECS {
+
+//============================================================================
+//! @brief Systemのコンポーネントアクセス宣言
+//!
+//! SystemがOnUpdate内で読み書きするコンポーネント型の集合。
+//! スケジューラはこの宣言から競合を判定し、競合しないSystemを
+//! JobSystem上で同時に実行する。
+//!
+//! 競合判定:
+//! - 書き込み同士、または読み取りと書き込みが同じ型に重なれば競合
+//! - 読み取り同士は競合しない
+//! - 未宣言または構造変更ありのSystemは全Systemと競合（同期点）
+//!
+//! コンポーネント以外の共有データ（他Systemが公開する結果など）は、
+//! その持ち主の型で読み書きを宣言すれば同じ規則で順序付けされる
+//! （例: Collision3DSystemのイベントキューは Write<Collision3DSystem>()）。
+//!
+//! @note 未宣言のSystemは従来通りメインスレッドで単独実行される。
+//!       宣言はISystem::DeclareAccess()またはSystemBuilderで行う
+//============================================================================
+struct SystemAccess {
+    std::vector<std::type_index> reads;     //!< 読み取るコンポーネント型
+    std::vector<std::type_index> writes;    //!< 書き込むコンポーネント型
+    bool declared = false;                  //!< アクセス宣言済みか
+    bool structural = false;                //!< Actor生成/破棄、コンポーネント追加/削除を行うか
+
+    //------------------------------------------------------------------------
+    //! @brief 読み取りコンポーネントを追加
+    //------------------------------------------------------------------------
+    template<typename... Ts>
+    SystemAccess& Read() {
+        (AddUnique(reads, std::type_index(typeid(Ts))), ...);
+        declared = true;
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 書き込みコンポーネントを追加
+    //------------------------------------------------------------------------
+    template<typename... Ts>
+    SystemAccess& Write() {
+        (AddUnique(writes, std::type_index(typeid(Ts))), ...);
+        declared = true;
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief アクセスモード（In<T>/InOut<T>）からまとめて追加
+    //------------------------------------------------------------------------
+    template<typename... AccessModes>
+    SystemAccess& With() {
+        static_assert(all_are_access_modes_v<AccessModes...>, "With() requires In<T>/InOut<T>");
+        (AddMode<AccessModes>(), ...);
+        declared = true;
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 構造変更を行うことを宣言
+    //------------------------------------------------------------------------
+    SystemAccess& Structural() {
+        structural = true;
+        declared = true;
+        return *this;
+    }
+
+    //! @brief 他Systemと同時実行できないか（同期点になるか）
+    [[nodiscard]] bool IsExclusive() const noexcept {
+        return !declared || structural;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 他のアクセス宣言と競合するか
+    //------------------------------------------------------------------------
+    [[nodiscard]] bool ConflictsWith(const SystemAccess& other) const {
+        if (IsExclusive() || other.IsExclusive()) {
+            return true;
+        }
+        for (const std::type_index& w : writes) {
+            if (Contains(other.writes, w) || Contains(other.reads, w)) {
+                return true;
+            }
+        }
+        for (const std::type_index& r : reads) {
+            if (Contains(other.writes, r)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    template<typename Mode>
+    void AddMode() {
+        using T = unwrap_access_t<Mode>;
+        if constexpr (is_in_v<Mode>) {
+            AddUnique(reads, std::type_index(typeid(T)));
+        } else {
+            AddUnique(writes, std::type_index(typeid(T)));
+        }
+    }
+
+    static bool Contains(const std::vector<std::type_index>& types, std::type_index type) {
+        return std::find(types.begin(), types.end(), type) != types.end();
+    }
+
+    static void AddUnique(std::vector<std::type_index>& types, std::type_index type) {
+        if (!Contains(types, type)) {
+            types.push_back(type);
+        }
+    }
+};
+
+} // namespace ECS
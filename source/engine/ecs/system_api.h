@@ -21,7 +21,7 @@ template<typename... AccessModes> class TypedQuery;
 //! Unity DOTSのSystemAPIに相当。
 //!
 //! 使用前にSetCurrentState()で現在のSystemStateを設定する必要がある。
-//! SystemSchedulerが各System実行前に自動的に設定する。
+//! SystemExecutorが各System実行前に自動的に設定する。
 //!
 //! @code
 //! class MovementSystem final : public ISystem {
@@ -52,7 +52,7 @@ public:
     //! @brief 現在のSystemStateを設定
     //! @param state SystemStateへのポインタ
     //!
-    //! SystemSchedulerが各System実行前に呼び出す。
+    //! SystemExecutorが各System実行前に呼び出す。
     //------------------------------------------------------------------------
     static void SetCurrentState(SystemState* state) {
         currentState_ = state;
@@ -93,6 +93,11 @@ public:
         return currentState_ ? currentState_->frameCount : 0;
     }
 
+    //! 実行中Systemの前回実行時のバージョン取得（System外では0 = 全て変更扱い）
+    [[nodiscard]] static uint32_t LastRunVersion() noexcept {
+        return currentState_ ? currentState_->lastRunVersion : 0;
+    }
+
     //========================================================================
     // EntityManager相当API
     //========================================================================
@@ -174,5 +179,5 @@ private:
 
 } // namespace ECS
 
-// テンプレート実装
-#include "detail/system_api_impl.h"
+// テンプレート実装はWorldの完全定義が必要なため、world.hの末尾でインクルード
+// （detail/system_api_impl.h）
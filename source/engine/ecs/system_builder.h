@@ -6,6 +6,7 @@
 
 #include "system.h"
 #include "system_graph.h"
+#include "system_access.h"
 #include <memory>
 #include <vector>
 #include <typeindex>
@@ -32,7 +33,18 @@ class World;
 //!      .After<TransformSystem>()
 //!      .After<AnimationSystem>()
 //!      .WithPriority(100);
+//!
+//! // アクセス宣言: 競合しないSystemはJobSystem上で同時に実行される
+//! world.RegisterSystemWithDeps<MovementSystem>()
+//!      .WithAccess<InOut<LocalTransform>, In<Velocity>>();
+//!
+//! world.RegisterSystemWithDeps<SpawnSystem>()
+//!      .Writes<LocalTransform>()
+//!      .WithStructuralChanges();             // 同期点として単独実行
 //! ```
+//!
+//! @note ISystem::DeclareAccess()の宣言が初期値になり、ここでの宣言はそれに追加される。
+//!       どちらでも宣言しないSystemは従来通り単独で逐次実行される
 //============================================================================
 template<typename T>
 class SystemBuilder {
@@ -46,7 +58,11 @@ public:
         , priority_(system_ ? system_->Priority() : 0)
         , id_(std::type_index(typeid(T)))
         , name_(system_ ? system_->Name() : "Unknown")
-    {}
+    {
+        if (system_) {
+            system_->DeclareAccess(access_);
+        }
+    }
 
     //! @brief ムーブコンストラクタ
     SystemBuilder(SystemBuilder&& other) noexcept
@@ -57,6 +73,7 @@ public:
         , name_(other.name_)
         , runAfter_(std::move(other.runAfter_))
         , runBefore_(std::move(other.runBefore_))
+        , access_(std::move(other.access_))
     {
         other.world_ = nullptr;  // 移動元は登録しない
     }
@@ -74,6 +91,7 @@ public:
             name_ = other.name_;
             runAfter_ = std::move(other.runAfter_);
             runBefore_ = std::move(other.runBefore_);
+            access_ = std::move(other.access_);
             other.world_ = nullptr;
         }
         return *this;
@@ -120,6 +138,50 @@ public:
         return *this;
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 読み取るコンポーネントを宣言
+    //! @tparam Ts コンポーネント型群
+    //! @return 自身への参照（チェーン可能）
+    //------------------------------------------------------------------------
+    template<typename... Ts>
+    SystemBuilder& Reads() {
+        access_.Read<Ts...>();
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 書き込むコンポーネントを宣言
+    //! @tparam Ts コンポーネント型群
+    //! @return 自身への参照（チェーン可能）
+    //------------------------------------------------------------------------
+    template<typename... Ts>
+    SystemBuilder& Writes() {
+        access_.Write<Ts...>();
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief アクセスモードでまとめて宣言（In<T>は読み取り、InOut<T>は書き込み）
+    //! @tparam AccessModes In<T>/InOut<T>の組み合わせ
+    //! @return 自身への参照（チェーン可能）
+    //------------------------------------------------------------------------
+    template<typename... AccessModes>
+    SystemBuilder& WithAccess() {
+        access_.With<AccessModes...>();
+        return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 構造変更（Actor生成/破棄、コンポーネント追加/削除）を行うことを宣言
+    //!
+    //! 前後の全Systemとの同期点となり、メインスレッドで単独実行される。
+    //! @return 自身への参照（チェーン可能）
+    //------------------------------------------------------------------------
+    SystemBuilder& WithStructuralChanges() {
+        access_.Structural();
+        return *this;
+    }
+
 private:
     //! @brief Worldに登録を実行
     void Commit();
@@ -131,6 +193,7 @@ private:
     const char* name_;
     std::vector<SystemId> runAfter_;
     std::vector<SystemId> runBefore_;
+    SystemAccess access_;
 };
 
 //============================================================================
@@ -0,0 +1,249 @@
+//----------------------------------------------------------------------------
+//! @file   system_executor.h
+//! @brief  ECS SystemExecutor - 実行計画に従ったSystemの並列実行
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "system.h"
+#include "system_graph.h"
+#include "system_state.h"
+#include "ecs_assert.h"
+#include "engine/core/job_system.h"
+#include "common/utility/non_copyable.h"
+#include <exception>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+
+// 前方宣言
+class World;
+
+//============================================================================
+//! @brief SystemExecutor
+//!
+//! SystemGraph::BuildExecutionPlan()の結果に従って更新Systemを実行する。
+//!
+//! - 単独実行（アクセス未宣言・構造変更あり）のSystemはメインスレッドで実行し、
+//!   前後のSystemとの同期点とする
+//! - 同期点に挟まれた区間（バッチ）は依存・競合の辺に従って
+//!   JobSystem上でデータフロー実行する。先行Systemが全て完了した
+//!   Systemから順に投入され、メインスレッドは完了待ちの間ジョブを手伝う
+//! - JobSystem未作成、ワーカー0、並列無効時は計画順に逐次実行する
+//! - System毎にSystemStateを保持し、実行中はSystemAPIの現在の状態として設定する。
+//!   前回実行時のバージョン（Changed<T>フィルタの基準）は実行後に更新される
+//!
+//! @note バッチ内のSystemはActor生成/破棄・コンポーネント追加/削除を
+//!       直接行ってはならない。EntityCommandBufferに記録するか、
+//!       SystemAccess::Structural()を宣言すること
+//============================================================================
+class SystemExecutor : private NonCopyable {
+public:
+    SystemExecutor() = default;
+    ~SystemExecutor() = default;
+
+    //------------------------------------------------------------------------
+    //! @brief 実行計画からノードを構築
+    //! @param plan 実行計画
+    //! @param lookup SystemId → ISystem* の変換関数（見つからなければnullptr）
+    //------------------------------------------------------------------------
+    template<typename Lookup>
+    void Build(const SystemExecutionPlan& plan, Lookup&& lookup) {
+        const size_t count = plan.order.size();
+        nodes_.clear();
+        nodes_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            Node& node = nodes_[i];
+            node.system = lookup(plan.order[i]);
+            node.state = &states_[plan.order[i]];
+            node.exclusive = plan.exclusive[i] != 0;
+            node.predecessorCount = plan.predecessorCount[i];
+            node.successors = plan.successors[i];
+        }
+        pending_ = std::make_unique<std::atomic<uint32_t>[]>(count);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 全Systemを実行
+    //! @param world Worldへの参照
+    //! @param dt デルタタイム
+    //------------------------------------------------------------------------
+    void Execute(World& world, float dt) {
+        const uint32_t count = static_cast<uint32_t>(nodes_.size());
+        const bool parallel = CanRunParallel();
+
+        uint32_t i = 0;
+        while (i < count) {
+            if (nodes_[i].exclusive) {
+                // 同期点: メインスレッドで単独実行
+                RunNodeSystem(nodes_[i], world, dt);
+                ++i;
+                continue;
+            }
+
+            uint32_t batchEnd = i + 1;
+            while (batchEnd < count && !nodes_[batchEnd].exclusive) {
+                ++batchEnd;
+            }
+
+            if (parallel && batchEnd - i > 1) {
+                ExecuteBatchParallel(world, dt, i, batchEnd);
+            } else {
+                for (uint32_t j = i; j < batchEnd; ++j) {
+                    RunNodeSystem(nodes_[j], world, dt);
+                }
+            }
+            i = batchEnd;
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief SystemStateを現在の状態として設定してSystemを1回実行
+    //! @param system 実行するSystem
+    //! @param state Systemの実行状態（実行後にlastRunVersionを更新）
+    //! @param world Worldへの参照
+    //! @param dt デルタタイム
+    //!
+    //! Executorを介さずにSystemを直接更新する場合（テスト等）も、
+    //! これを使えばChanged<T>フィルタが前回実行からの差分で動作する。
+    //------------------------------------------------------------------------
+    static void RunSystem(ISystem& system, SystemState& state, World& world, float dt);
+
+    //! @brief ノードと全SystemStateをクリア
+    void Clear() {
+        nodes_.clear();
+        pending_.reset();
+        states_.clear();
+    }
+
+    //! @brief Systemの実行状態を破棄（再登録時に未実行扱いへ戻す）
+    void ResetSystemState(SystemId id) {
+        states_.erase(id);
+    }
+
+    //! @brief 並列実行の有効/無効を設定（無効時は計画順に逐次実行）
+    void SetParallelEnabled(bool enabled) noexcept { parallelEnabled_ = enabled; }
+
+    //! @brief 並列実行が有効か
+    [[nodiscard]] bool IsParallelEnabled() const noexcept { return parallelEnabled_; }
+
+    //! @brief 実行順のSystem数
+    [[nodiscard]] size_t GetSystemCount() const noexcept { return nodes_.size(); }
+
+    //! @brief 実行順のSystemを取得
+    [[nodiscard]] ISystem* GetSystem(size_t index) const noexcept { return nodes_[index].system; }
+
+    //! @brief 同期点（単独実行）として扱われるか
+    [[nodiscard]] bool IsExclusive(size_t index) const noexcept { return nodes_[index].exclusive; }
+
+    //! @brief 同一バッチ内で完了を待つ先行System数（依存・競合の辺の数）
+    [[nodiscard]] uint32_t GetPredecessorCount(size_t index) const noexcept { return nodes_[index].predecessorCount; }
+
+private:
+    //! @brief 実行ノード
+    struct Node {
+        ISystem* system = nullptr;
+        SystemState* state = nullptr;       //!< states_内の実行状態
+        std::vector<uint32_t> successors;   //!< 同一バッチ内の後続ノード
+        uint32_t predecessorCount = 0;      //!< 同一バッチ内の先行ノード数
+        bool exclusive = false;
+    };
+
+    static void RunNodeSystem(Node& node, World& world, float dt) {
+        if (node.system) {
+            RunSystem(*node.system, *node.state, world, dt);
+        }
+    }
+
+    [[nodiscard]] bool CanRunParallel() const noexcept {
+        return parallelEnabled_ && JobSystem::HasWorkers();
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief バッチを依存順にJobSystem上で実行し、完了まで待機
+    //------------------------------------------------------------------------
+    void ExecuteBatchParallel(World& world, float dt, uint32_t begin, uint32_t end) {
+        world_ = &world;
+        deltaTime_ = dt;
+
+        for (uint32_t i = begin; i < end; ++i) {
+            pending_[i].store(nodes_[i].predecessorCount, std::memory_order_relaxed);
+        }
+        batchCounter_.Reset(end - begin);
+        failed_.store(false, std::memory_order_relaxed);
+        error_ = nullptr;
+
+        for (uint32_t i = begin; i < end; ++i) {
+            if (nodes_[i].predecessorCount == 0) {
+                Dispatch(i);
+            }
+        }
+
+        // 待機中はメインスレッドもSystemジョブを実行する
+        batchCounter_.Wait();
+
+        // System内の例外は逐次実行時と同様に呼び出し元へ伝播する
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void Dispatch(uint32_t index) {
+        JobSystem::Get().Submit([this, index] { RunNode(index); });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief ノードを実行し、先行が揃った後続を投入
+    //!
+    //! 準備完了になった後続のうち1つは投入せずこのスレッドで続けて実行する。
+    //------------------------------------------------------------------------
+    void RunNode(uint32_t index) {
+        while (true) {
+            if (nodes_[index].system) {
+#ifdef _DEBUG
+                ParallelContextGuard guard;
+#endif
+                try {
+                    RunNodeSystem(nodes_[index], *world_, deltaTime_);
+                } catch (...) {
+                    // 最初の例外のみ保持（後続は通常通り解放して待機側を止めない）
+                    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+                        error_ = std::current_exception();
+                    }
+                }
+            }
+
+            uint32_t next = UINT32_MAX;
+            for (uint32_t successor : nodes_[index].successors) {
+                if (pending_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    if (next == UINT32_MAX) {
+                        next = successor;
+                    } else {
+                        Dispatch(successor);
+                    }
+                }
+            }
+
+            batchCounter_.Decrement();
+            if (next == UINT32_MAX) {
+                return;
+            }
+            index = next;
+        }
+    }
+
+    std::vector<Node> nodes_;
+    std::unordered_map<SystemId, SystemState> states_;  //!< System毎の実行状態（再構築後も保持）
+    std::unique_ptr<std::atomic<uint32_t>[]> pending_;  //!< 未完了の先行ノード数
+    JobCounter batchCounter_;                           //!< バッチ内の未完了ノード数
+    std::atomic<bool> failed_{false};                   //!< バッチ内で例外が発生したか
+    std::exception_ptr error_;                          //!< 最初に発生した例外
+    World* world_ = nullptr;
+    float deltaTime_ = 0.0f;
+    bool parallelEnabled_ = true;
+};
+
+} // namespace ECS
@@ -6,7 +6,10 @@
 
 
 #include "system.h"
+#include "system_access.h"
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
@@ -32,6 +35,7 @@ struct SystemNodeInfo {
     std::vector<SystemId> runAfter;         //!< このSystemの後に実行
     std::vector<SystemId> runBefore;        //!< このSystemの前に実行
     const char* name = "Unknown";           //!< System名（デバッグ用）
+    SystemAccess access;                    //!< コンポーネントアクセス宣言
 };
 
 //============================================================================
@@ -44,6 +48,7 @@ struct SystemEntry {
     std::vector<SystemId> runAfter;
     std::vector<SystemId> runBefore;
     const char* name = "Unknown";
+    SystemAccess access;
 };
 
 //============================================================================
@@ -58,6 +63,20 @@ struct RenderSystemEntry {
     const char* name = "Unknown";
 };
 
+//============================================================================
+//! @brief System並列実行計画
+//!
+//! トポロジカル順に並べたSystemと、同時実行してはならない組の間の辺。
+//! 単独実行（exclusive）のSystemは前後の全Systemとの同期点になるため、
+//! 辺は同期点で区切られた区間（バッチ）内でのみ張られる。
+//============================================================================
+struct SystemExecutionPlan {
+    std::vector<SystemId> order;                    //!< 実行順（トポロジカル順）
+    std::vector<uint8_t> exclusive;                 //!< 単独実行するか（orderと同じ並び）
+    std::vector<uint32_t> predecessorCount;         //!< 同一バッチ内の先行System数
+    std::vector<std::vector<uint32_t>> successors;  //!< 同一バッチ内の後続System（orderのインデックス）
+};
+
 //============================================================================
 //! @brief 依存関係グラフ
 //!
@@ -74,7 +93,8 @@ public:
     void AddNode(SystemId id, int priority,
                  const std::vector<SystemId>& runAfter,
                  const std::vector<SystemId>& runBefore,
-                 const char* name)
+                 const char* name,
+                 const SystemAccess& access = {})
     {
         SystemNodeInfo info;
         info.id = id;
@@ -82,6 +102,7 @@ public:
         info.runAfter = runAfter;
         info.runBefore = runBefore;
         info.name = name;
+        info.access = access;
 
         nodes_[id] = std::move(info);
         adjacency_[id];  // 空のリストを作成
@@ -181,6 +202,68 @@ public:
         return sorted;
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 並列実行計画を構築
+    //!
+    //! トポロジカル順で後ろにあるSystemは、前にあるSystemのうち
+    //! 明示的な依存（After/Before）があるもの、またはアクセスが競合するものの
+    //! 完了を待つ。どちらにも当たらない組は同時に実行される。
+    //!
+    //! @return 実行計画（循環時は空）
+    //------------------------------------------------------------------------
+    [[nodiscard]] SystemExecutionPlan BuildExecutionPlan() {
+        SystemExecutionPlan plan;
+        plan.order = TopologicalSort();
+
+        const uint32_t count = static_cast<uint32_t>(plan.order.size());
+        plan.exclusive.resize(count, 0);
+        plan.predecessorCount.resize(count, 0);
+        plan.successors.resize(count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            plan.exclusive[i] = nodes_[plan.order[i]].access.IsExclusive() ? 1 : 0;
+        }
+
+        std::vector<uint8_t> linked(count, 0);
+        uint32_t batchBegin = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (plan.exclusive[i]) {
+                // 同期点: 前後のバッチとは辺を張らない
+                batchBegin = i + 1;
+                continue;
+            }
+
+            const SystemNodeInfo& info = nodes_[plan.order[i]];
+            std::fill(linked.begin() + batchBegin, linked.begin() + i, uint8_t{0});
+
+            // 明示的な依存（runAfter/runBefore由来の辺）
+            for (uint32_t j = batchBegin; j < i; ++j) {
+                for (SystemId next : adjacency_[plan.order[j]]) {
+                    if (next == plan.order[i]) {
+                        linked[j] = 1;
+                        break;
+                    }
+                }
+            }
+
+            // アクセス競合
+            for (uint32_t j = batchBegin; j < i; ++j) {
+                if (!linked[j] && nodes_[plan.order[j]].access.ConflictsWith(info.access)) {
+                    linked[j] = 1;
+                }
+            }
+
+            for (uint32_t j = batchBegin; j < i; ++j) {
+                if (linked[j]) {
+                    plan.successors[j].push_back(i);
+                    ++plan.predecessorCount[i];
+                }
+            }
+        }
+
+        return plan;
+    }
+
     //------------------------------------------------------------------------
     //! @brief ノードが存在するか確認
     //------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 
 #include "system.h"
 #include "system_graph.h"
+#include "system_executor.h"
 #include "common/utility/non_copyable.h"
 #include <memory>
 #include <vector>
@@ -26,7 +27,7 @@ class World;
 //! Worldから分離された責務:
 //! - System登録/破棄
 //! - 依存関係に基づくソート
-//! - System実行
+//! - System実行（アクセス宣言に基づき競合しないSystemを並列実行）
 //!
 //! @note システムのライフサイクル:
 //!       Register時: OnCreate()
@@ -56,6 +57,7 @@ public:
         entry.id = std::type_index(typeid(T));
         entry.priority = system->Priority();
         entry.name = system->Name();
+        system->DeclareAccess(entry.access);
 
         // OnCreate呼び出し
         system->OnCreate(world);
@@ -98,11 +100,13 @@ public:
             entry.priority,
             entry.runAfter,
             entry.runBefore,
-            entry.name
+            entry.name,
+            entry.access
         );
 
-        // 実体を保存
+        // 実体を保存（再登録時は前回実行バージョンも破棄）
         systemsById_[id] = std::move(entry.system);
+        executor_.ResetSystemState(id);
         systemsDirty_ = true;
     }
 
@@ -138,9 +142,7 @@ public:
             RebuildSortedSystems();
         }
 
-        for (ISystem* system : sortedSystems_) {
-            system->OnUpdate(world, dt);
-        }
+        executor_.Execute(world, dt);
     }
 
     //------------------------------------------------------------------------
@@ -190,7 +192,7 @@ public:
         renderSystemGraph_.Clear();
         systemsById_.clear();
         renderSystemsById_.clear();
-        sortedSystems_.clear();
+        executor_.Clear();
         sortedRenderSystems_.clear();
         systemsDirty_ = false;
         renderSystemsDirty_ = false;
@@ -208,21 +210,26 @@ public:
         return renderSystemsById_.size();
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 更新Systemの並列実行を有効/無効化（無効時は依存順に逐次実行）
+    //------------------------------------------------------------------------
+    void SetParallelEnabled(bool enabled) noexcept {
+        executor_.SetParallelEnabled(enabled);
+    }
+
+    [[nodiscard]] bool IsParallelEnabled() const noexcept {
+        return executor_.IsParallelEnabled();
+    }
+
 private:
     //------------------------------------------------------------------------
-    //! @brief ソート済みSystem配列を再構築
+    //! @brief 実行計画を再構築
     //------------------------------------------------------------------------
     void RebuildSortedSystems() {
-        sortedSystems_.clear();
-        std::vector<SystemId> sortedIds = systemGraph_.TopologicalSort();
-        sortedSystems_.reserve(sortedIds.size());
-
-        for (SystemId id : sortedIds) {
+        executor_.Build(systemGraph_.BuildExecutionPlan(), [this](SystemId id) -> ISystem* {
             auto it = systemsById_.find(id);
-            if (it != systemsById_.end() && it->second) {
-                sortedSystems_.push_back(it->second.get());
-            }
-        }
+            return it != systemsById_.end() ? it->second.get() : nullptr;
+        });
 
         systemsDirty_ = false;
     }
@@ -254,8 +261,10 @@ private:
     std::unordered_map<SystemId, std::unique_ptr<ISystem>> systemsById_;
     std::unordered_map<SystemId, std::unique_ptr<IRenderSystem>> renderSystemsById_;
 
-    //! ソート済みSystem配列（実行用）
-    std::vector<ISystem*> sortedSystems_;
+    //! 更新Systemの実行計画（並列実行用）
+    SystemExecutor executor_;
+
+    //! ソート済みRenderSystem配列（実行用）
     std::vector<IRenderSystem*> sortedRenderSystems_;
 
     //! ソート済み配列の再構築フラグ
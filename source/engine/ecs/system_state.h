@@ -44,6 +44,7 @@ struct SystemState {
     float deltaTime = 0.0f;          //!< デルタタイム（秒）
     float time = 0.0f;               //!< 経過時間（秒）
     uint32_t frameCount = 0;         //!< フレームカウント
+    uint32_t lastRunVersion = 0;     //!< 前回実行開始時の書き込みバージョン（0は未実行）
 
     //========================================================================
     // コンストラクタ
@@ -71,6 +72,14 @@ struct SystemState {
     //! フレームカウント取得
     [[nodiscard]] uint32_t FrameCount() const noexcept { return frameCount; }
 
+    //------------------------------------------------------------------------
+    //! @brief 前回実行時のバージョンを取得
+    //!
+    //! Changed<T>フィルタの基準。Chunkのコンポーネントバージョンがこの値以上なら
+    //! 前回実行以降に変更されたとみなす（未実行の場合は0 = 全て変更扱い）。
+    //------------------------------------------------------------------------
+    [[nodiscard]] uint32_t LastRunVersion() const noexcept { return lastRunVersion; }
+
     //! Worldへのアクセス
     [[nodiscard]] World& GetWorld() noexcept { return *world; }
     [[nodiscard]] const World& GetWorld() const noexcept { return *world; }
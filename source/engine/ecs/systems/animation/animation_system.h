@@ -0,0 +1,414 @@
+//----------------------------------------------------------------------------
+//! @file   animation_system.h
+//! @brief  ECS AnimationSystem - スケルタルアニメーション評価
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/system.h"
+#include "engine/ecs/world.h"
+#include "engine/ecs/components/animation/skeletal_animation_data.h"
+#include "engine/ecs/components/animation/skeleton_ref_data.h"
+#include "engine/ecs/components/animation/skinning_matrix.h"
+#include "engine/ecs/components/animation/animation_cursor_key.h"
+#include "engine/ecs/components/animation/animation_lod_data.h"
+#include "engine/ecs/components/camera/camera3d_data.h"
+#include "engine/ecs/components/common/entity_tags.h"
+#include "engine/ecs/components/rendering/lod_range_data.h"
+#include "engine/ecs/components/transform/transform_components.h"
+#include "engine/ecs/systems/rendering/frustum_culling_system.h"
+#include "engine/game_object/components/animation/skeleton.h"
+#include "engine/game_object/components/animation/animation_clip.h"
+#include "engine/game_object/components/animation/compressed_clip.h"
+#include "engine/memory/memory_system.h"
+#include "engine/core/job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace ECS {
+
+//============================================================================
+//! @brief スケルタルアニメーションシステム（更新システム）
+//!
+//! 入力: SkeletalAnimationData, SkeletonRefData
+//! 出力: SkeletalAnimationData（再生時間）, DynamicBuffer<SkinningMatrix>
+//! 任意: DynamicBuffer<AnimationCursorKey>（圧縮クリップのカーソル）
+//!       AnimationLODData + LocalToWorld（+ LODRangeData）（アニメーションLOD）
+//!
+//! SkeletonとAnimationClipは不変の共有データとしてシステムに登録し、
+//! インスタンスはIDで参照する。インスタンスごとに持つのは再生状態と
+//! スキニング行列（とカーソル）だけ。
+//!
+//! 処理は2段階:
+//! 1. 逐次: Chunkを列挙し、バッファをボーン数・トラック数に合わせて伸縮しながら
+//!    インスタンスごとの入出力ポインタを解決する（構造変更・ヒープ確保はここだけ）
+//! 2. 並列: ChunkごとにJobSystemへ投げ、各インスタンスの時間を進めて
+//!    スレッドごとのスクラッチ上のPoseへサンプリングし、
+//!    スキニング行列をバッファへ直接書き込む
+//!
+//! AnimationLODDataを持つインスタンスは、逐次パスでアクティブカメラからの距離
+//! （LODSystemと同じ計算）とLODRangeData・前回の視錐台カリング結果を見て、
+//! 評価を間引くか止めるかを決める。評価しないフレームはバッファの行列を保持する。
+//!
+//! @note 優先度5（描画より前）
+//!
+//! 使用例:
+//! @code
+//! world.RegisterSystem<AnimationSystem>();
+//! auto* animation = world.GetSystem<AnimationSystem>();
+//! const uint32_t skeletonId = animation->RegisterSkeleton(skeleton);
+//! const uint32_t walkId = animation->RegisterClip(walkClip);
+//!
+//! auto character = world.CreateActor();
+//! world.AddComponent<SkeletalAnimationData>(character, walkId);
+//! world.AddComponent<SkeletonRefData>(character, skeletonId);
+//! world.AddBuffer<SkinningMatrix>(character);
+//! world.AddBuffer<AnimationCursorKey>(character);  // 圧縮クリップを使う場合
+//!
+//! // Update後
+//! auto matrices = world.GetBuffer<SkinningMatrix>(character);
+//! @endcode
+//============================================================================
+class AnimationSystem final : public ISystem {
+public:
+    //------------------------------------------------------------------------
+    //! @brief 1インスタンス分の評価対象（逐次パスで解決済み）
+    //------------------------------------------------------------------------
+    struct Instance {
+        SkeletalAnimationData* playback = nullptr;  //!< 再生状態
+        const Skeleton* skeleton = nullptr;         //!< 共有スケルトン
+        const AnimationClip* clip = nullptr;        //!< 共有クリップ（nullptr = 恒等ポーズ）
+        Matrix* skinning = nullptr;                 //!< スキニング行列の出力先（ボーン数分）
+        uint16_t* cursorKeys = nullptr;             //!< 圧縮クリップのカーソル（nullptr = 毎回先頭から）
+        const BoneMask* mask = nullptr;             //!< 評価するボーン（nullptr = 全ボーン）
+        float resumeWeight = 0.0f;                  //!< 保持している行列の残りウェイト（復帰補間）
+        bool evaluate = true;                       //!< このフレームにポーズを評価するか
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief 1 Chunk分のインスタンス範囲
+    //------------------------------------------------------------------------
+    struct ChunkWork {
+        uint32_t first = 0;     //!< instances_内の先頭
+        uint32_t count = 0;     //!< インスタンス数
+    };
+
+    void OnUpdate(World& world, float dt) override {
+        ++frame_;
+        CollectCamera(world);
+        culling_ = world.GetRenderSystem<FrustumCullingSystem>();
+        CollectInstances(world.GetArchetypeStorage(), dt);
+
+        RunParallelRange(static_cast<uint32_t>(work_.size()), kMinParallelChunks, MakeChunkParallelForDesc(workCosts_),
+            [this, dt](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    const ChunkWork& work = work_[i];
+                    for (uint32_t j = 0; j < work.count; ++j) {
+                        EvaluateInstance(instances_[work.first + j], dt);
+                    }
+                }
+            });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1インスタンスを評価（時間を進めてスキニング行列を書き込む）
+    //! @param instance 評価対象
+    //! @param dt デルタタイム
+    //!
+    //! 一時領域はスレッドごとのスクラッチから確保するので、ワーカースレッドから
+    //! 並列に呼んでもヒープ確保や共有状態への書き込みはない。
+    //! 復帰補間中は、保持していた行列へresumeWeightだけ寄せる。
+    //------------------------------------------------------------------------
+    static void EvaluateInstance(const Instance& instance, float dt) {
+        SkeletalAnimationData& playback = *instance.playback;
+        const AnimationClip* clip = instance.clip;
+        if (clip && playback.IsPlaying()) {
+            playback.time = AdvanceTime(playback.time + dt * playback.speed, *clip);
+        }
+        if (!instance.evaluate) return;
+
+        const uint32_t boneCount = static_cast<uint32_t>(instance.skeleton->GetBoneCount());
+        auto& scratch = Memory::GetThreadScratchAllocator();
+        Memory::ScopedStackMarker marker(scratch);
+        Pose pose = Pose::FromAllocator(scratch, boneCount);
+        const bool blend = instance.resumeWeight > 0.0f;
+        Matrix* globals = static_cast<Matrix*>(
+            scratch.Allocate(sizeof(Matrix) * boneCount * (blend ? 2 : 1), 16));
+        if (!pose.IsValid() || !globals) return;
+
+        pose.SetIdentity();
+        if (clip) {
+            if (clip->compressed) {
+                uint16_t* cursorKeys = instance.cursorKeys;
+                if (!cursorKeys) {
+                    const size_t trackCount = (std::max)(clip->compressed->GetAnimatedTrackCount(), 1u);
+                    cursorKeys = static_cast<uint16_t*>(scratch.Allocate(sizeof(uint16_t) * trackCount, 2));
+                    if (!cursorKeys) return;
+                    std::memset(cursorKeys, 0, sizeof(uint16_t) * trackCount);
+                }
+                clip->compressed->SamplePose(playback.time, cursorKeys, pose, instance.mask);
+            } else {
+                clip->SamplePose(playback.time, pose, instance.mask);
+            }
+        }
+
+        if (!blend) {
+            instance.skeleton->ComputeSkinningMatrices(pose, globals, instance.skinning, instance.mask);
+            return;
+        }
+
+        Matrix* skinning = globals + boneCount;
+        instance.skeleton->ComputeSkinningMatrices(pose, globals, skinning, instance.mask);
+        for (uint32_t i = 0; i < boneCount; ++i) {
+            instance.skinning[i] = Matrix::Lerp(skinning[i], instance.skinning[i], instance.resumeWeight);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @name 共有データ登録
+    //!
+    //! 登録はUpdateの外（メインスレッド）で行うこと。
+    //! 登録したデータは評価中に読み取り専用で共有される。
+    //------------------------------------------------------------------------
+    //!@{
+
+    //! @brief スケルトンを登録
+    //! @return スケルトンID（SkeletonRefDataに設定する）
+    uint32_t RegisterSkeleton(SkeletonPtr skeleton) {
+        skeletons_.push_back(std::move(skeleton));
+        lodBoneMasks_.emplace_back();
+        return static_cast<uint32_t>(skeletons_.size() - 1);
+    }
+
+    //! @brief クリップを登録
+    //! @return クリップID（SkeletalAnimationDataに設定する）
+    uint32_t RegisterClip(AnimationClipPtr clip) {
+        clips_.push_back(std::move(clip));
+        return static_cast<uint32_t>(clips_.size() - 1);
+    }
+
+    //! @brief スケルトンを取得（無効なIDはnullptr）
+    [[nodiscard]] const Skeleton* GetSkeleton(uint32_t id) const noexcept {
+        return id < skeletons_.size() ? skeletons_[id].get() : nullptr;
+    }
+
+    //! @brief クリップを取得（無効なIDはnullptr）
+    [[nodiscard]] const AnimationClip* GetClip(uint32_t id) const noexcept {
+        return id < clips_.size() ? clips_[id].get() : nullptr;
+    }
+
+    //! @brief 最遠LODで評価するボーンを設定（スケルトンごと）
+    //! @param skeletonId スケルトンID
+    //! @param mask ボーンマスク（空なら全ボーン）
+    void SetLODBoneMask(uint32_t skeletonId, BoneMask mask) {
+        if (skeletonId < lodBoneMasks_.size()) {
+            lodBoneMasks_[skeletonId] = std::move(mask);
+        }
+    }
+
+    //! @brief 最遠LODのボーンマスクを取得（未設定・無効なIDはnullptr）
+    [[nodiscard]] const BoneMask* GetLODBoneMask(uint32_t skeletonId) const noexcept {
+        if (skeletonId >= lodBoneMasks_.size() || lodBoneMasks_[skeletonId].GetBoneCount() == 0) {
+            return nullptr;
+        }
+        return &lodBoneMasks_[skeletonId];
+    }
+
+    //!@}
+
+    int Priority() const override { return 5; }
+    const char* Name() const override { return "AnimationSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<SkeletonRefData, LocalToWorld, LODRangeData, Camera3DData, ActiveCameraTag>()
+              .Write<SkeletalAnimationData, AnimationLODData, SkinningMatrix, AnimationCursorKey>();
+    }
+
+private:
+    //! @brief 並列評価時にJobSystemへ分割するChunk数の下限（1 Chunkでも十分重い）
+    static constexpr uint32_t kMinParallelChunks = 2;
+
+    //------------------------------------------------------------------------
+    //! @brief 再生時間を進めてラップモードの周期に収める
+    //!
+    //! 時間を周期内に保つことで、長時間再生しても浮動小数点の精度が落ちない。
+    //! PingPongの折り返しはサンプリング時にクリップ側で行う。
+    //------------------------------------------------------------------------
+    [[nodiscard]] static float AdvanceTime(float time, const AnimationClip& clip) noexcept {
+        const float duration = clip.duration;
+        if (duration <= 0.0f) return 0.0f;
+
+        switch (clip.wrapMode) {
+            case WrapMode::Loop:
+            case WrapMode::PingPong: {
+                const float period = clip.wrapMode == WrapMode::Loop ? duration : duration * 2.0f;
+                const float t = std::fmod(time, period);
+                return (t < 0.0f) ? t + period : t;
+            }
+            case WrapMode::Once:
+            case WrapMode::ClampForever:
+                break;
+        }
+        return std::clamp(time, 0.0f, duration);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief アクティブカメラの位置を取得（LODSystemと同じく最初のカメラのみ）
+    //------------------------------------------------------------------------
+    void CollectCamera(World& world) {
+        hasCamera_ = false;
+        world.ForEach<In<Camera3DData>, In<ActiveCameraTag>>(
+            [this]([[maybe_unused]] Actor actor, const Camera3DData& cam,
+                   [[maybe_unused]] const ActiveCameraTag& tag) {
+                if (!hasCamera_) {
+                    cameraPosition_ = cam.position;
+                    hasCamera_ = true;
+                }
+            });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief LOD状態を進め、このフレームにポーズを評価するかを返す
+    //!
+    //! カメラがなければ距離0（毎フレーム評価）として扱い、範囲判定もしない。
+    //------------------------------------------------------------------------
+    bool AdvanceLOD(AnimationLODData& lod, const LocalToWorld* ltw, const LODRangeData* range,
+                    bool onScreen, Actor actor, float dt) const noexcept {
+        const float distance = (ltw && hasCamera_)
+            ? Vector3::Distance(ltw->GetPosition(), cameraPosition_)
+            : 0.0f;
+        const bool visible = onScreen && (!range || !hasCamera_ || range->IsInRange(distance));
+        const uint32_t phase = (lod.phase == AnimationLODData::kAutoPhase) ? actor.Index() : lod.phase;
+        return lod.state.Advance(lod.settings, distance, visible, frame_, phase, dt);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 評価対象を列挙し、出力バッファを準備
+    //!
+    //! スキニング行列はボーン数に、カーソルは圧縮クリップのトラック数に合わせる。
+    //! クリップが切り替わったインスタンスはカーソルを先頭へ戻す。
+    //! DynamicBufferの伸縮はヒープを使うので、並列パスの前にここで済ませる。
+    //! バッファを伸縮したインスタンスは保持している行列がないので、LODに関わらず評価する。
+    //------------------------------------------------------------------------
+    void CollectInstances(ArchetypeStorage& storage, float dt) {
+        instances_.clear();
+        work_.clear();
+        workCosts_.clear();
+        const uint32_t version = storage.GetWriteVersion();
+
+        storage.ForEachMatching<SkeletalAnimationData, SkeletonRefData, SkinningMatrix>(
+            [this, version, dt](Archetype& arch) {
+                const bool hasCursor = arch.HasBuffer<AnimationCursorKey>();
+                const bool hasLOD = arch.HasComponent<AnimationLODData>();
+                const bool hasPosition = hasLOD && arch.HasComponent<LocalToWorld>();
+                const bool hasRange = hasPosition && arch.HasComponent<LODRangeData>();
+                const size_t playbackIndex = arch.GetComponentIndex<SkeletalAnimationData>();
+                const size_t skinningIndex = arch.GetComponentIndex<SkinningMatrix>();
+                const size_t lodIndex = hasLOD ? arch.GetComponentIndex<AnimationLODData>() : 0;
+                const auto& metas = arch.GetChunkMetas();
+                for (size_t ci = 0; ci < metas.size(); ++ci) {
+                    const uint16_t count = metas[ci].count;
+                    if (count == 0) continue;
+
+                    SkeletalAnimationData* playback = arch.GetComponentArray<SkeletalAnimationData>(ci);
+                    const SkeletonRefData* skeletonRef = arch.GetComponentArray<SkeletonRefData>(ci);
+                    AnimationLODData* lod = hasLOD ? arch.GetComponentArray<AnimationLODData>(ci) : nullptr;
+                    const LocalToWorld* ltw = hasPosition ? arch.GetComponentArray<LocalToWorld>(ci) : nullptr;
+                    const LODRangeData* range = hasRange ? arch.GetComponentArray<LODRangeData>(ci) : nullptr;
+                    const Actor* actors = hasLOD ? arch.GetActorArray(ci) : nullptr;
+                    // 前回の描画で判定した可視マスク（判定していないChunkはnullptr = 全て可視）
+                    const uint64_t* visibility = (hasLOD && culling_) ? culling_->GetVisibilityMask(arch, ci) : nullptr;
+                    const uint32_t chunk = static_cast<uint32_t>(ci);
+
+                    ChunkWork work;
+                    work.first = static_cast<uint32_t>(instances_.size());
+                    uint32_t cost = 0;
+                    for (uint16_t i = 0; i < count; ++i) {
+                        const Skeleton* skeleton = GetSkeleton(skeletonRef[i].skeleton);
+                        if (!skeleton || skeleton->GetBoneCount() == 0) continue;
+
+                        Instance instance;
+                        instance.playback = &playback[i];
+                        instance.skeleton = skeleton;
+                        instance.clip = GetClip(playback[i].clip);
+
+                        const int32_t boneCount = static_cast<int32_t>(skeleton->GetBoneCount());
+                        auto matrices = arch.GetBuffer<SkinningMatrix>(chunk, i);
+                        const bool resized = matrices.Length() != boneCount;
+                        if (resized) {
+                            matrices.ResizeUninitialized(boneCount);
+                        }
+                        instance.skinning = &matrices.Data()->value;
+
+                        if (lod) {
+                            const bool onScreen = FrustumCullingSystem::IsVisible(visibility, i);
+                            instance.evaluate = AdvanceLOD(lod[i], ltw ? &ltw[i] : nullptr,
+                                                           range ? &range[i] : nullptr,
+                                                           onScreen, actors[i], dt) || resized;
+                            instance.resumeWeight = resized ? 0.0f : lod[i].state.resumeWeight;
+                            if (lod[i].state.UsesBoneMask()) {
+                                instance.mask = GetLODBoneMask(skeletonRef[i].skeleton);
+                            }
+                        }
+
+                        if (hasCursor) {
+                            instance.cursorKeys = PrepareCursor(
+                                arch.GetBuffer<AnimationCursorKey>(chunk, i), playback[i], instance.clip);
+                        }
+
+                        instances_.push_back(instance);
+                        cost += instance.evaluate ? static_cast<uint32_t>(boneCount) : 1u;
+                    }
+
+                    work.count = static_cast<uint32_t>(instances_.size()) - work.first;
+                    if (work.count == 0) continue;
+
+                    arch.MarkComponentWritten(ci, playbackIndex, version);
+                    arch.MarkComponentWritten(ci, skinningIndex, version);
+                    if (hasLOD) {
+                        arch.MarkComponentWritten(ci, lodIndex, version);
+                    }
+                    work_.push_back(work);
+                    workCosts_.push_back(cost);
+                }
+            });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief カーソルバッファをクリップのトラック数に合わせる
+    //! @return カーソルのキー配列（圧縮クリップでなければnullptr）
+    //------------------------------------------------------------------------
+    [[nodiscard]] static uint16_t* PrepareCursor(DynamicBuffer<AnimationCursorKey> keys,
+                                                 SkeletalAnimationData& playback,
+                                                 const AnimationClip* clip) {
+        const int32_t trackCount = (clip && clip->compressed)
+            ? static_cast<int32_t>(clip->compressed->GetAnimatedTrackCount()) : 0;
+
+        if (playback.boundClip != playback.clip || keys.Length() != trackCount) {
+            keys.ResizeUninitialized(trackCount);
+            if (trackCount > 0) {
+                std::memset(keys.Data(), 0, sizeof(AnimationCursorKey) * static_cast<size_t>(trackCount));
+            }
+            playback.boundClip = playback.clip;
+        }
+        return trackCount > 0 ? reinterpret_cast<uint16_t*>(keys.Data()) : nullptr;
+    }
+
+    std::vector<SkeletonPtr> skeletons_;        //!< 登録済みスケルトン（IDで参照）
+    std::vector<BoneMask> lodBoneMasks_;        //!< スケルトンごとの最遠LODのボーンマスク
+    std::vector<AnimationClipPtr> clips_;       //!< 登録済みクリップ（IDで参照）
+    std::vector<Instance> instances_;           //!< 今回の評価対象
+    std::vector<ChunkWork> work_;               //!< 今回の評価対象Chunk
+    std::vector<uint32_t> workCosts_;           //!< Chunkのボーン数合計（分割のコストヒント）
+
+    const FrustumCullingSystem* culling_ = nullptr;  //!< 前回の視錐台カリング結果（なければnullptr）
+    Vector3 cameraPosition_ = Vector3::Zero;    //!< アクティブカメラの位置
+    bool hasCamera_ = false;                    //!< アクティブカメラがあるか
+    uint32_t frame_ = 0;                        //!< LODの評価フレーム判定用カウンタ
+};
+
+} // namespace ECS
@@ -5,3 +5,4 @@
 #pragma once
 
 #include "animator_system.h"
+#include "animation_system.h"
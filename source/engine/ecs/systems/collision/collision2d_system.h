@@ -12,6 +12,7 @@
 #include "engine/ecs/collision/collision_event_queue.h"
 #include "engine/ecs/collision/spatial_hash_2d.h"
 #include <cmath>
+#include <vector>
 
 namespace ECS {
 
@@ -22,11 +23,10 @@ namespace ECS {
 //! 出力: EventQueue2D
 //!
 //! 処理フロー:
-//! 1. LocalTransformからCollider2Dのposを同期
-//! 2. SpatialHashGridに全コライダーを登録
-//! 3. Broad-phase: 同一セル内のペア抽出
-//! 4. Narrow-phase: AABB判定
-//! 5. CollisionEventQueueにイベント追加
+//! 1. LocalTransformからCollider2Dのposを同期し、有効なコライダーを詰めて登録
+//! 2. SpatialHash2Dを構築（カウンティングソート、JobSystemで並列）
+//! 3. Broad-phase + Narrow-phase: 同一セル内のペアをレイヤーマスクとAABBで絞り込み（並列）
+//! 4. 衝突したペアの接触情報を計算し、CollisionEventQueueにイベント追加
 //!
 //! @note 優先度10（TransformSystemの後）
 //============================================================================
@@ -45,6 +45,7 @@ public:
     void OnUpdate(World& world, [[maybe_unused]] float dt) override {
         eventQueue_.BeginFrame();
         spatialHash_.Clear();
+        proxies_.clear();
 
         // 1. Position同期 + SpatialHash登録
         world.ForEach<LocalTransform, Collider2DData>(
@@ -55,30 +56,37 @@ public:
                 c.posX = transform.position.x + c.offsetX;
                 c.posY = transform.position.y + c.offsetY;
 
-                // SpatialHashに登録
+                // SpatialHashに登録（登録インデックスとproxies_のインデックスは一致する）
                 spatialHash_.Insert(actor, c.posX, c.posY, c.halfW, c.halfH);
+                proxies_.push_back(Proxy{c.posX, c.posY, c.halfW, c.halfH, c.layer, c.mask});
             });
 
-        // 2. Broad-phase + Narrow-phase
-        spatialHash_.QueryAllPairs([this, &world](Actor a, Actor b) {
-            auto* cA = world.GetComponent<Collider2DData>(a);
-            auto* cB = world.GetComponent<Collider2DData>(b);
-            if (!cA || !cB) return;
+        // 2. グリッド構築 + ペア抽出（ワーカーからはproxies_のみ読む）
+        spatialHash_.Build();
+        spatialHash_.FindPairs([this](uint32_t a, uint32_t b) {
+            const Proxy& pA = proxies_[a];
+            const Proxy& pB = proxies_[b];
 
             // レイヤーマスクチェック
-            if ((cA->layer & cB->mask) == 0 || (cB->layer & cA->mask) == 0) return;
+            if ((pA.layer & pB.mask) == 0 || (pB.layer & pA.mask) == 0) return false;
 
             // AABB判定
-            if (AABBIntersects(*cA, *cB)) {
-                Collision::Event2D event;
-                event.actorA = a;
-                event.actorB = b;
-                event.layerA = cA->layer;
-                event.layerB = cB->layer;
-                // 接触点・法線・侵入深度の計算
-                ComputeContactInfo(*cA, *cB, event);
-                eventQueue_.Push(event);
-            }
+            return AABBIntersects(pA, pB);
+        });
+
+        // 3. 接触情報を計算してイベント追加
+        spatialHash_.QueryAllIndexPairs([this](uint32_t a, uint32_t b) {
+            const Proxy& pA = proxies_[a];
+            const Proxy& pB = proxies_[b];
+
+            Collision::Event2D event;
+            event.actorA = spatialHash_.GetActor(a);
+            event.actorB = spatialHash_.GetActor(b);
+            event.layerA = pA.layer;
+            event.layerB = pB.layer;
+            // 接触点・法線・侵入深度の計算
+            ComputeContactInfo(pA, pB, event);
+            eventQueue_.Push(event);
         });
 
         eventQueue_.EndFrame();
@@ -102,10 +110,18 @@ public:
     }
 
 private:
+    //! @brief Narrow-phase用のコライダー情報（登録インデックス順）
+    struct Proxy {
+        float posX, posY;
+        float halfW, halfH;
+        uint8_t layer;
+        uint8_t mask;
+    };
+
     //------------------------------------------------------------------------
     //! @brief AABB交差判定
     //------------------------------------------------------------------------
-    [[nodiscard]] static bool AABBIntersects(const Collider2DData& a, const Collider2DData& b) noexcept {
+    [[nodiscard]] static bool AABBIntersects(const Proxy& a, const Proxy& b) noexcept {
         return (a.posX - a.halfW < b.posX + b.halfW) &&
                (a.posX + a.halfW > b.posX - b.halfW) &&
                (a.posY - a.halfH < b.posY + b.halfH) &&
@@ -115,7 +131,7 @@ private:
     //------------------------------------------------------------------------
     //! @brief 接触情報を計算
     //------------------------------------------------------------------------
-    static void ComputeContactInfo(const Collider2DData& a, const Collider2DData& b,
+    static void ComputeContactInfo(const Proxy& a, const Proxy& b,
                                    Collision::Event2D& event) noexcept {
         // 接触点（2つのAABB中心の中点）
         event.contactX = (a.posX + b.posX) * 0.5f;
@@ -137,6 +153,7 @@ private:
     }
 
     Collision::SpatialHash2D spatialHash_;
+    std::vector<Proxy> proxies_;
     Collision::EventQueue2D eventQueue_;
 };
 
@@ -9,77 +9,123 @@
 #include "engine/ecs/world.h"
 #include "engine/ecs/components/transform/transform_components.h"
 #include "engine/ecs/components/collision/collider3d_data.h"
+#include "engine/ecs/components/movement/velocity_data.h"
 #include "engine/ecs/collision/collision_event_queue.h"
-#include "engine/ecs/collision/spatial_grid_3d.h"
-#include <cmath>
+#include "engine/ecs/collision/broad_phase_3d.h"
+#include "engine/ecs/collision/narrow_phase_3d.h"
+#include <algorithm>
 
 namespace ECS {
 
 //============================================================================
 //! @brief 3D衝突判定システム（クエリシステム）
 //!
-//! 入力: LocalToWorldData, Collider3DData（読み取り専用）
+//! 入力: LocalToWorld, Collider3DData, VelocityData（CCD対象のみ。読み取り専用）
 //! 出力: EventQueue3D
 //!
 //! 処理フロー:
-//! 1. LocalToWorldDataからCollider3DのAABB境界を同期
-//! 2. SpatialGrid3Dに全コライダーを登録
-//! 3. Broad-phase: 同一セル内のペア抽出
-//! 4. Narrow-phase: 形状に応じた詳細判定
+//! 1. LocalToWorldかCollider3DDataが前回実行以降に変更されたChunkのみAABB境界を再計算
+//! 2. 有効なコライダーをSoAスナップショットへ詰め、BroadPhase3D（永続動的AABBツリー）へ反映
+//!    - CCD対象（Collider3DData::SetContinuous）はこのステップの移動量（速度 * dt）で
+//!      掃引したAABBを登録し、Narrow-phaseで衝突時刻を求める（Event3D::toi）
+//! 3. Broad-phase: キャッシュ済みペアをスナップショットのインデックスで列挙
+//! 4. Narrow-phase: 形状ペア別にバッチ判定（JobSystemで並列）
 //! 5. CollisionEventQueueにイベント追加
 //!
-//! @note 優先度11（Collision2DSystemの後）
+//! @note 優先度11（Collision2DSystemの後）。MovementSystemの後に実行されるため、
+//!       CCDの移動量はこのステップで位置に加えられた速度 * dt と一致する
+//! @note CCDは検出のみを行い、すり抜け自体は止めない。衝突時刻イベント（toi < 1）の
+//!       時点で物体はすでに終端位置へ移動しており、位置の巻き戻しや速度の制限はしない。
+//!       RigidBodySystemもこのイベントを接触として解かないため、弾丸のヒット判定などに使い、
+//!       反射や停止が必要なら受け取った側で位置・速度を補正すること
+//! @note AABB境界は変更バージョンを更新せずに書き込む（自身の書き込みで
+//!       次回もChunkが変更扱いになるのを避けるため）
 //============================================================================
 class Collision3DSystem final : public ISystem {
 public:
+    //------------------------------------------------------------------------
+    //! @brief Broad-phaseの太いAABBの拡張量
+    //!
+    //! 旧コンストラクタ引数（空間グリッドのセルサイズ）と取り違えないよう型で区別する。
+    //------------------------------------------------------------------------
+    struct FatMargin {
+        float value = 0.1f;
+    };
+
+    //! @brief コンストラクタ（既定の拡張量）
+    Collision3DSystem() = default;
+
     //------------------------------------------------------------------------
     //! @brief コンストラクタ
-    //! @param cellSize 空間グリッドのセルサイズ
+    //! @param margin Broad-phaseの太いAABBの拡張量
+    //!
+    //! RegisterSystem<Collision3DSystem>()で登録した場合はSetMargin()で変更する。
     //------------------------------------------------------------------------
-    explicit Collision3DSystem(float cellSize = 10.0f)
-        : spatialGrid_(cellSize) {}
+    explicit Collision3DSystem(FatMargin margin)
+        : broadPhase_(margin.value) {}
+
+    //! @brief 旧API（空間グリッドのセルサイズ指定）。拡張量と誤解されないようコンパイルエラーにする
+    Collision3DSystem(float cellSize) = delete;
 
     //------------------------------------------------------------------------
     //! @brief システム実行
     //------------------------------------------------------------------------
-    void OnUpdate(World& world, [[maybe_unused]] float dt) override {
+    void OnUpdate(World& world, float dt) override {
         eventQueue_.BeginFrame();
-        spatialGrid_.Clear();
-
-        // 1. LocalToWorld同期 + SpatialGrid登録
-        world.ForEach<LocalToWorldData, Collider3DData>(
-            [this](Actor actor, const LocalToWorldData& ltw, Collider3DData& c) {
-                if (!c.IsEnabled()) return;
-
-                // LocalToWorldDataからAABB境界を更新
-                Vector3 worldPos = ltw.GetPosition();
-                c.UpdateBounds(worldPos);
 
-                // SpatialGridに登録
-                spatialGrid_.Insert(actor,
-                    c.minX, c.minY, c.minZ,
-                    c.maxX, c.maxY, c.maxZ);
+        // 1. 変更のあったChunkのAABB境界を更新 + スナップショット作成 + Broad-phaseへ反映
+        const uint32_t sinceVersion = SystemAPI::LastRunVersion();
+        snapshot_.Clear();
+        broadPhase_.BeginUpdate();
+        world.GetArchetypeStorage().ForEachMatching<LocalToWorld, Collider3DData>(
+            [this, sinceVersion, dt](Archetype& arch) {
+                const size_t ltwIndex = arch.GetComponentIndex<LocalToWorld>();
+                const size_t colliderIndex = arch.GetComponentIndex<Collider3DData>();
+                const bool hasVelocity = arch.HasComponent<VelocityData>();
+                const auto& metas = arch.GetChunkMetas();
+
+                for (size_t ci = 0; ci < metas.size(); ++ci) {
+                    const uint16_t count = metas[ci].count;
+                    if (count == 0) continue;
+
+                    const bool changed = arch.DidChange(ci, ltwIndex, sinceVersion) ||
+                                         arch.DidChange(ci, colliderIndex, sinceVersion);
+                    const Actor* actors = arch.GetActorArray(ci);
+                    const LocalToWorld* ltw = arch.GetComponentArray<LocalToWorld>(ci);
+                    Collider3DData* colliders = arch.GetComponentArray<Collider3DData>(ci);
+                    const VelocityData* velocities = hasVelocity ? arch.GetComponentArray<VelocityData>(ci) : nullptr;
+
+                    for (uint16_t i = 0; i < count; ++i) {
+                        Collider3DData& c = colliders[i];
+                        if (changed) {
+                            c.UpdateBounds(ltw[i].GetPosition());
+                        }
+                        // 無効なコライダーは登録しない（EndUpdateでプロキシが破棄される）
+                        if (!c.IsEnabled()) continue;
+
+                        const uint32_t index = snapshot_.Add(actors[i],
+                            c.minX, c.minY, c.minZ, c.maxX, c.maxY, c.maxZ,
+                            c.shapeType == Collider3DShape::Sphere ? c.shape.sphere.radius : 0.0f,
+                            ToNarrowShape(c.shapeType), c.layer, c.mask);
+                        Collision::Bounds3D bounds{ c.minX, c.minY, c.minZ, c.maxX, c.maxY, c.maxZ };
+                        if (velocities && c.IsContinuous()) {
+                            const Vector3 move = velocities[i].value * dt;
+                            snapshot_.SetMotion(index, move.x, move.y, move.z);
+                            bounds = SweptBounds(bounds, move);
+                        }
+                        broadPhase_.UpdateProxy(actors[i], bounds, index);
+                    }
+                }
             });
+        broadPhase_.EndUpdate();
 
-        // 2. Broad-phase + Narrow-phase
-        spatialGrid_.QueryAllPairs([this, &world](Actor a, Actor b) {
-            auto* cA = world.GetComponent<Collider3DData>(a);
-            auto* cB = world.GetComponent<Collider3DData>(b);
-            if (!cA || !cB) return;
-
-            // レイヤーマスクチェック
-            if ((cA->layer & cB->mask) == 0 || (cB->layer & cA->mask) == 0) return;
-
-            // 詳細判定
-            Collision::Event3D event;
-            if (TestCollision(*cA, *cB, event)) {
-                event.actorA = a;
-                event.actorB = b;
-                event.layerA = cA->layer;
-                event.layerB = cB->layer;
-                eventQueue_.Push(event);
-            }
+        // 2. Broad-phase + Narrow-phase（コンポーネントを参照せずスナップショットのみ読む）
+        narrowPhase_.BeginPairs();
+        broadPhase_.QueryAllIndexPairs([this](uint32_t a, uint32_t b) {
+            narrowPhase_.AddPair(snapshot_, a, b);
         });
+        narrowPhase_.Execute(snapshot_);
+        narrowPhase_.Flush(eventQueue_);
 
         eventQueue_.EndFrame();
     }
@@ -87,6 +133,12 @@ public:
     int Priority() const override { return 11; }
     const char* Name() const override { return "Collision3DSystem"; }
 
+    void DeclareAccess(SystemAccess& access) const override {
+        // 境界はCollider3DDataへ書き戻し、イベントキューは自身の型で公開する
+        access.Read<LocalToWorld, VelocityData>()
+              .Write<Collider3DData, Collision3DSystem>();
+    }
+
     //------------------------------------------------------------------------
     //! @brief イベントキューへのアクセス
     //------------------------------------------------------------------------
@@ -95,227 +147,48 @@ public:
     }
 
     //------------------------------------------------------------------------
-    //! @brief セルサイズを設定
+    //! @brief Broad-phaseの太いAABBの拡張量を設定
     //------------------------------------------------------------------------
-    void SetCellSize(float size) noexcept {
-        spatialGrid_.SetCellSize(size);
+    void SetMargin(float margin) noexcept {
+        broadPhase_.SetMargin(margin);
     }
 
-private:
     //------------------------------------------------------------------------
-    //! @brief 衝突判定（形状に応じたディスパッチ）
+    //! @brief 旧API（空間グリッドのセルサイズ設定）
+    //! @deprecated 空間グリッドは動的AABBツリーに置き換えられたため何もしない。
+    //!             拡張量はSetMargin()で設定する
     //------------------------------------------------------------------------
-    [[nodiscard]] static bool TestCollision(const Collider3DData& a,
-                                             const Collider3DData& b,
-                                             Collision::Event3D& event) noexcept {
-        // まずAABBで除外判定（ブロードフェーズですでにAABBは重なっているはず）
-        if (!AABBIntersects(a, b)) return false;
-
-        // 形状に応じた詳細判定
-        if (a.shapeType == Collider3DShape::Sphere &&
-            b.shapeType == Collider3DShape::Sphere) {
-            return SphereSphere(a, b, event);
-        }
-        else if (a.shapeType == Collider3DShape::AABB &&
-                 b.shapeType == Collider3DShape::AABB) {
-            return AABBAABB(a, b, event);
-        }
-        else if (a.shapeType == Collider3DShape::Sphere &&
-                 b.shapeType == Collider3DShape::AABB) {
-            return SphereAABB(a, b, event);
-        }
-        else if (a.shapeType == Collider3DShape::AABB &&
-                 b.shapeType == Collider3DShape::Sphere) {
-            bool result = SphereAABB(b, a, event);
-            if (result) {
-                // 法線を反転
-                event.normalX = -event.normalX;
-                event.normalY = -event.normalY;
-                event.normalZ = -event.normalZ;
-            }
-            return result;
-        }
-        else if (a.shapeType == Collider3DShape::Capsule ||
-                 b.shapeType == Collider3DShape::Capsule) {
-            // カプセル判定はAABB近似で代用
-            return AABBAABB(a, b, event);
-        }
-
-        // フォールバック: AABB判定
-        return AABBAABB(a, b, event);
-    }
-
-    //------------------------------------------------------------------------
-    //! @brief AABB交差判定
-    //------------------------------------------------------------------------
-    [[nodiscard]] static bool AABBIntersects(const Collider3DData& a,
-                                              const Collider3DData& b) noexcept {
-        return (a.minX <= b.maxX && a.maxX >= b.minX) &&
-               (a.minY <= b.maxY && a.maxY >= b.minY) &&
-               (a.minZ <= b.maxZ && a.maxZ >= b.minZ);
-    }
+    [[deprecated("Collision3DSystem no longer uses a spatial grid; use SetMargin()")]]
+    void SetCellSize([[maybe_unused]] float size) noexcept {}
 
     //------------------------------------------------------------------------
-    //! @brief AABB vs AABB詳細判定
+    //! @brief Broad-phaseへのアクセス（統計・デバッグ用）
     //------------------------------------------------------------------------
-    [[nodiscard]] static bool AABBAABB(const Collider3DData& a,
-                                        const Collider3DData& b,
-                                        Collision::Event3D& event) noexcept {
-        // 接触点（2つのAABB中心の中点）
-        Vector3 centerA = a.GetCenter();
-        Vector3 centerB = b.GetCenter();
-        event.contactX = (centerA.x + centerB.x) * 0.5f;
-        event.contactY = (centerA.y + centerB.y) * 0.5f;
-        event.contactZ = (centerA.z + centerB.z) * 0.5f;
-
-        // 侵入深度と法線（最小分離軸）
-        float halfExtentAx = (a.maxX - a.minX) * 0.5f;
-        float halfExtentAy = (a.maxY - a.minY) * 0.5f;
-        float halfExtentAz = (a.maxZ - a.minZ) * 0.5f;
-        float halfExtentBx = (b.maxX - b.minX) * 0.5f;
-        float halfExtentBy = (b.maxY - b.minY) * 0.5f;
-        float halfExtentBz = (b.maxZ - b.minZ) * 0.5f;
-
-        float overlapX = (halfExtentAx + halfExtentBx) - std::abs(centerA.x - centerB.x);
-        float overlapY = (halfExtentAy + halfExtentBy) - std::abs(centerA.y - centerB.y);
-        float overlapZ = (halfExtentAz + halfExtentBz) - std::abs(centerA.z - centerB.z);
-
-        if (overlapX <= 0 || overlapY <= 0 || overlapZ <= 0) return false;
-
-        // 最小分離軸を選択
-        if (overlapX < overlapY && overlapX < overlapZ) {
-            event.normalX = (centerA.x < centerB.x) ? -1.0f : 1.0f;
-            event.normalY = 0.0f;
-            event.normalZ = 0.0f;
-            event.penetration = overlapX;
-        } else if (overlapY < overlapZ) {
-            event.normalX = 0.0f;
-            event.normalY = (centerA.y < centerB.y) ? -1.0f : 1.0f;
-            event.normalZ = 0.0f;
-            event.penetration = overlapY;
-        } else {
-            event.normalX = 0.0f;
-            event.normalY = 0.0f;
-            event.normalZ = (centerA.z < centerB.z) ? -1.0f : 1.0f;
-            event.penetration = overlapZ;
-        }
-
-        return true;
+    [[nodiscard]] const Collision::BroadPhase3D& GetBroadPhase() const noexcept {
+        return broadPhase_;
     }
 
-    //------------------------------------------------------------------------
-    //! @brief Sphere vs Sphere判定
-    //------------------------------------------------------------------------
-    [[nodiscard]] static bool SphereSphere(const Collider3DData& a,
-                                            const Collider3DData& b,
-                                            Collision::Event3D& event) noexcept {
-        Vector3 centerA = a.GetCenter();
-        Vector3 centerB = b.GetCenter();
-        float radiusA = a.shape.sphere.radius;
-        float radiusB = b.shape.sphere.radius;
-
-        float dx = centerB.x - centerA.x;
-        float dy = centerB.y - centerA.y;
-        float dz = centerB.z - centerA.z;
-        float distSq = dx * dx + dy * dy + dz * dz;
-        float radiusSum = radiusA + radiusB;
-
-        if (distSq > radiusSum * radiusSum) return false;
-
-        float dist = std::sqrt(distSq);
-        if (dist < 0.0001f) {
-            // 中心が同じ位置の場合
-            event.normalX = 0.0f;
-            event.normalY = 1.0f;
-            event.normalZ = 0.0f;
-            event.penetration = radiusSum;
-        } else {
-            float invDist = 1.0f / dist;
-            event.normalX = dx * invDist;
-            event.normalY = dy * invDist;
-            event.normalZ = dz * invDist;
-            event.penetration = radiusSum - dist;
-        }
-
-        // 接触点（2つの球の表面間の中点）
-        float contactDist = radiusA - event.penetration * 0.5f;
-        event.contactX = centerA.x + event.normalX * contactDist;
-        event.contactY = centerA.y + event.normalY * contactDist;
-        event.contactZ = centerA.z + event.normalZ * contactDist;
-
-        return true;
+private:
+    //! @brief 開始位置（終端 - 移動量）と終端を包むAABB
+    [[nodiscard]] static Collision::Bounds3D SweptBounds(const Collision::Bounds3D& end, const Vector3& move) noexcept {
+        return Collision::Bounds3D{
+            (std::min)(end.minX, end.minX - move.x), (std::min)(end.minY, end.minY - move.y),
+            (std::min)(end.minZ, end.minZ - move.z), (std::max)(end.maxX, end.maxX - move.x),
+            (std::max)(end.maxY, end.maxY - move.y), (std::max)(end.maxZ, end.maxZ - move.z) };
     }
 
-    //------------------------------------------------------------------------
-    //! @brief Sphere vs AABB判定
-    //------------------------------------------------------------------------
-    [[nodiscard]] static bool SphereAABB(const Collider3DData& sphere,
-                                          const Collider3DData& aabb,
-                                          Collision::Event3D& event) noexcept {
-        Vector3 sphereCenter = sphere.GetCenter();
-        float radius = sphere.shape.sphere.radius;
-
-        // AABBへの最近接点を計算
-        float closestX = std::clamp(sphereCenter.x, aabb.minX, aabb.maxX);
-        float closestY = std::clamp(sphereCenter.y, aabb.minY, aabb.maxY);
-        float closestZ = std::clamp(sphereCenter.z, aabb.minZ, aabb.maxZ);
-
-        // 距離を計算
-        float dx = sphereCenter.x - closestX;
-        float dy = sphereCenter.y - closestY;
-        float dz = sphereCenter.z - closestZ;
-        float distSq = dx * dx + dy * dy + dz * dz;
-
-        if (distSq > radius * radius) return false;
-
-        float dist = std::sqrt(distSq);
-        if (dist < 0.0001f) {
-            // 球の中心がAABB内部にある
-            Vector3 aabbCenter = aabb.GetCenter();
-            dx = sphereCenter.x - aabbCenter.x;
-            dy = sphereCenter.y - aabbCenter.y;
-            dz = sphereCenter.z - aabbCenter.z;
-
-            float halfExtentX = (aabb.maxX - aabb.minX) * 0.5f;
-            float halfExtentY = (aabb.maxY - aabb.minY) * 0.5f;
-            float halfExtentZ = (aabb.maxZ - aabb.minZ) * 0.5f;
-
-            float overlapX = halfExtentX - std::abs(dx);
-            float overlapY = halfExtentY - std::abs(dy);
-            float overlapZ = halfExtentZ - std::abs(dz);
-
-            if (overlapX < overlapY && overlapX < overlapZ) {
-                event.normalX = (dx > 0) ? 1.0f : -1.0f;
-                event.normalY = 0.0f;
-                event.normalZ = 0.0f;
-                event.penetration = overlapX + radius;
-            } else if (overlapY < overlapZ) {
-                event.normalX = 0.0f;
-                event.normalY = (dy > 0) ? 1.0f : -1.0f;
-                event.normalZ = 0.0f;
-                event.penetration = overlapY + radius;
-            } else {
-                event.normalX = 0.0f;
-                event.normalY = 0.0f;
-                event.normalZ = (dz > 0) ? 1.0f : -1.0f;
-                event.penetration = overlapZ + radius;
-            }
-        } else {
-            float invDist = 1.0f / dist;
-            event.normalX = dx * invDist;
-            event.normalY = dy * invDist;
-            event.normalZ = dz * invDist;
-            event.penetration = radius - dist;
+    //! @brief コライダー形状をNarrow-phaseの分類へ変換
+    [[nodiscard]] static Collision::NarrowShape3D ToNarrowShape(Collider3DShape shape) noexcept {
+        switch (shape) {
+        case Collider3DShape::Sphere: return Collision::NarrowShape3D::Sphere;
+        case Collider3DShape::AABB:   return Collision::NarrowShape3D::Box;
+        default:                      return Collision::NarrowShape3D::Approx;  // カプセル判定はAABB近似で代用
         }
-
-        event.contactX = closestX;
-        event.contactY = closestY;
-        event.contactZ = closestZ;
-
-        return true;
     }
 
-    Collision::SpatialGrid3D spatialGrid_;
+    Collision::BroadPhase3D broadPhase_;
+    Collision::ColliderSnapshot3D snapshot_;
+    Collision::NarrowPhase3D narrowPhase_;
     Collision::EventQueue3D eventQueue_;
 };
 
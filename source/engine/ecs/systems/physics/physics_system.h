@@ -10,6 +10,11 @@
 #include "engine/ecs/components/movement/velocity_data.h"
 #include "engine/ecs/components/movement/angular_velocity_data.h"
 #include "engine/ecs/components/physics/physics_components.h"
+#include "engine/core/job_system.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace ECS {
 
@@ -20,10 +25,14 @@ namespace ECS {
 //!       PhysicsGravityFactorData, PhysicsMassOverrideData
 //! 出力: VelocityData, AngularVelocityData
 //!
-//! 処理内容:
-//! 1. 重力適用（PhysicsGravityFactorData考慮）
+//! 処理内容（1エンティティあたり1回の読み書きで完結する）:
+//! 1. 重力適用（PhysicsMassDataあり。PhysicsGravityFactorDataでスケール、キネマティックは0）
 //! 2. 減衰適用（PhysicsDampingData）
-//! 3. キネマティック処理（PhysicsMassOverrideData）
+//! 3. 速度ゼロ化（PhysicsMassOverrideData::setVelocityToZero）
+//!
+//! どのオプションコンポーネントを持つかはArchetypeで決まるため、
+//! Chunk単位で列ポインタを解決し、SoA列を4体ずつSIMDで積分する。
+//! Chunkは互いに独立なのでJobSystemで並列に処理する。
 //!
 //! @note 優先度4（MovementSystemの前）
 //!
@@ -47,83 +56,80 @@ namespace ECS {
 //============================================================================
 class PhysicsSystem final : public ISystem {
 public:
-    void OnUpdate(World& world, float dt) override {
-        //================================================================
-        // Pass 1: 基本重力適用（VelocityData + PhysicsMassData のみ）
-        // 最も一般的なケース - 全物理オブジェクトに重力を適用
-        //================================================================
-        world.ForEach<VelocityData, PhysicsMassData>(
-            [this, dt]([[maybe_unused]] Actor actor, VelocityData& vel,
-                       [[maybe_unused]] const PhysicsMassData& mass) {
-                vel.value += gravity_ * dt;
-            });
+    //------------------------------------------------------------------------
+    //! @brief 1 Chunk分の積分対象（列ポインタはArchetypeの構成で決まる）
+    //!
+    //! nullptrの列は「コンポーネントなし」を表す。
+    //------------------------------------------------------------------------
+    struct ChunkWork {
+        VelocityData* velocity = nullptr;                       //!< 線形速度（nullptr = 角速度のみ）
+        AngularVelocityData* angularVelocity = nullptr;         //!< 角速度（減衰ありの場合のみ）
+        const PhysicsDampingData* damping = nullptr;            //!< 減衰
+        const PhysicsGravityFactorData* gravityFactor = nullptr;  //!< 重力スケール（nullptr = 1）
+        const PhysicsMassOverrideData* massOverride = nullptr;  //!< キネマティック・速度ゼロ化
+        bool gravity = false;                                   //!< 重力を受けるか（PhysicsMassDataあり）
+        uint16_t count = 0;                                     //!< Chunk内Actor数
+    };
 
-        //================================================================
-        // Pass 2: GravityFactor補正
-        // GravityFactorがある場合、Pass1で適用した重力を補正
-        // 打ち消し方式: 標準重力を取り消し、スケール適用した重力を再適用
-        //================================================================
-        world.ForEach<VelocityData, PhysicsMassData, PhysicsGravityFactorData>(
-            [this, dt]([[maybe_unused]] Actor actor, VelocityData& vel,
-                       [[maybe_unused]] const PhysicsMassData& mass,
-                       const PhysicsGravityFactorData& gravityFactor) {
-                vel.value -= gravity_ * dt;  // Pass1の標準重力を打ち消し
-                vel.value += gravity_ * gravityFactor.value * dt;  // スケール適用で再適用
-            });
+    void OnUpdate(World& world, float dt) override {
+        CollectChunks(world.GetArchetypeStorage());
 
-        //================================================================
-        // Pass 3: Kinematic処理（重力を打ち消し）
-        // Kinematicオブジェクトは物理演算をスキップ
-        // Note: Kinematic + GravityFactor の組み合わせは稀なので GetComponent で対応
-        //================================================================
-        world.ForEach<VelocityData, PhysicsMassData, PhysicsMassOverrideData>(
-            [this, &world, dt](Actor actor, VelocityData& vel,
-                               [[maybe_unused]] const PhysicsMassData& mass,
-                               const PhysicsMassOverrideData& override) {
-                if (override.IsKinematic()) {
-                    // GravityFactorがあるかチェック（稀なケース - GetComponent許容）
-                    auto* gf = world.GetComponent<PhysicsGravityFactorData>(actor);
-                    if (gf) {
-                        // Pass2で適用された factor * gravity を打ち消し
-                        vel.value -= gravity_ * gf->value * dt;
-                    } else {
-                        // Pass1で適用された標準重力を打ち消し
-                        vel.value -= gravity_ * dt;
-                    }
+        const Vector3 gravityStep = gravity_ * dt;
+        RunParallelRange(static_cast<uint32_t>(work_.size()), kMinParallelChunks, MakeChunkParallelForDesc(workCosts_),
+            [this, gravityStep, dt](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    IntegrateChunk(work_[i], gravityStep, dt);
                 }
             });
+    }
 
-        //================================================================
-        // Pass 4: 線形減衰適用
-        // DampingDataを持つオブジェクトの速度を減衰
-        //================================================================
-        world.ForEach<VelocityData, PhysicsDampingData>(
-            [dt]([[maybe_unused]] Actor actor, VelocityData& vel,
-                 const PhysicsDampingData& damping) {
-                vel.value = damping.ApplyLinear(vel.value, dt);
-            });
+    //------------------------------------------------------------------------
+    //! @brief 1 Chunkを積分
+    //! @param work 積分対象
+    //! @param gravityStep 重力 * dt
+    //! @param dt デルタタイム
+    //!
+    //! 端数の4体未満は中立値（重力スケール1・減衰なし・フラグなし）で埋めた
+    //! 一時領域にコピーし、同じ4幅カーネルで処理する。
+    //------------------------------------------------------------------------
+    static void IntegrateChunk(const ChunkWork& work, const Vector3& gravityStep, float dt) noexcept {
+        const uint32_t full = work.count & ~3u;
+        for (uint32_t i = 0; i < full; i += 4) {
+            Integrate4(work, i, gravityStep, dt);
+        }
 
-        //================================================================
-        // Pass 5: 角速度減衰
-        // 回転運動の減衰を適用
-        //================================================================
-        world.ForEach<AngularVelocityData, PhysicsDampingData>(
-            [dt]([[maybe_unused]] Actor actor, AngularVelocityData& angVel,
-                 const PhysicsDampingData& damping) {
-                angVel.value = damping.ApplyAngular(angVel.value, dt);
-            });
+        const uint32_t tail = work.count - full;
+        if (tail == 0) return;
 
-        //================================================================
-        // Pass 6: MassOverrideによる速度ゼロ化
-        // 特定フラグが設定されているオブジェクトの速度を強制ゼロ化
-        //================================================================
-        world.ForEach<VelocityData, PhysicsMassOverrideData>(
-            []([[maybe_unused]] Actor actor, VelocityData& vel,
-               const PhysicsMassOverrideData& override) {
-                if (override.ShouldSetVelocityToZero()) {
-                    vel.value = Vector3::Zero;
-                }
-            });
+        alignas(16) VelocityData velocity[4];
+        alignas(16) AngularVelocityData angularVelocity[4];
+        PhysicsDampingData damping[4] = {
+            PhysicsDampingData::None(), PhysicsDampingData::None(),
+            PhysicsDampingData::None(), PhysicsDampingData::None()
+        };
+        PhysicsGravityFactorData gravityFactor[4];
+        PhysicsMassOverrideData massOverride[4];
+
+        ChunkWork staged = work;
+        staged.velocity = work.velocity ? velocity : nullptr;
+        staged.angularVelocity = work.angularVelocity ? angularVelocity : nullptr;
+        staged.damping = work.damping ? damping : nullptr;
+        staged.gravityFactor = work.gravityFactor ? gravityFactor : nullptr;
+        staged.massOverride = work.massOverride ? massOverride : nullptr;
+        for (uint32_t j = 0; j < tail; ++j) {
+            if (work.velocity) velocity[j] = work.velocity[full + j];
+            if (work.angularVelocity) angularVelocity[j] = work.angularVelocity[full + j];
+            if (work.damping) damping[j] = work.damping[full + j];
+            if (work.gravityFactor) gravityFactor[j] = work.gravityFactor[full + j];
+            if (work.massOverride) massOverride[j] = work.massOverride[full + j];
+        }
+
+        Integrate4(staged, 0, gravityStep, dt);
+
+        for (uint32_t j = 0; j < tail; ++j) {
+            if (work.velocity) work.velocity[full + j] = velocity[j];
+            if (work.angularVelocity) work.angularVelocity[full + j] = angularVelocity[j];
+        }
     }
 
     //------------------------------------------------------------------------
@@ -142,8 +148,160 @@ public:
     int Priority() const override { return 4; }
     const char* Name() const override { return "PhysicsSystem"; }
 
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<PhysicsMassData, PhysicsDampingData, PhysicsGravityFactorData, PhysicsMassOverrideData>()
+              .Write<VelocityData, AngularVelocityData>();
+    }
+
 private:
+    //! @brief 並列積分時にJobSystemへ分割するChunk数の下限
+    static constexpr uint32_t kMinParallelChunks = 4;
+
+    //------------------------------------------------------------------------
+    //! @brief 積分対象のChunkを列挙し、書き込む列のバージョンを更新
+    //!
+    //! VelocityDataを持ち、重力・減衰・MassOverrideのいずれも持たない
+    //! Archetypeは何もしないので列挙しない。
+    //------------------------------------------------------------------------
+    void CollectChunks(ArchetypeStorage& storage) {
+        work_.clear();
+        workCosts_.clear();
+        const uint32_t version = storage.GetWriteVersion();
+
+        const auto collect = [this, version](Archetype& arch, bool hasVelocity) {
+            const bool gravity = hasVelocity && arch.HasComponent<PhysicsMassData>();
+            const bool hasDamping = arch.HasComponent<PhysicsDampingData>();
+            const bool hasOverride = hasVelocity && arch.HasComponent<PhysicsMassOverrideData>();
+            const bool hasAngular = hasDamping && arch.HasComponent<AngularVelocityData>();
+            if (!gravity && !hasDamping && !hasOverride) return;
+
+            const size_t velocityIndex = hasVelocity ? arch.GetComponentIndex<VelocityData>() : 0;
+            const size_t angularIndex = hasAngular ? arch.GetComponentIndex<AngularVelocityData>() : 0;
+            const auto& metas = arch.GetChunkMetas();
+            for (size_t ci = 0; ci < metas.size(); ++ci) {
+                const uint16_t count = metas[ci].count;
+                if (count == 0) continue;
+
+                ChunkWork work;
+                work.gravity = gravity;
+                work.count = count;
+                if (hasVelocity) {
+                    work.velocity = arch.GetComponentArray<VelocityData>(ci);
+                    arch.MarkComponentWritten(ci, velocityIndex, version);
+                }
+                if (hasAngular) {
+                    work.angularVelocity = arch.GetComponentArray<AngularVelocityData>(ci);
+                    arch.MarkComponentWritten(ci, angularIndex, version);
+                }
+                if (hasDamping) {
+                    work.damping = arch.GetComponentArray<PhysicsDampingData>(ci);
+                }
+                if (gravity && arch.HasComponent<PhysicsGravityFactorData>()) {
+                    work.gravityFactor = arch.GetComponentArray<PhysicsGravityFactorData>(ci);
+                }
+                if (hasOverride) {
+                    work.massOverride = arch.GetComponentArray<PhysicsMassOverrideData>(ci);
+                }
+                work_.push_back(work);
+                workCosts_.push_back(count);
+            }
+        };
+
+        storage.ForEachMatching<VelocityData>([&collect](Archetype& arch) {
+            collect(arch, true);
+        });
+        // 線形速度を持たないArchetypeは角速度の減衰のみ
+        storage.ForEachMatching<AngularVelocityData, PhysicsDampingData>([&collect](Archetype& arch) {
+            if (!arch.HasComponent<VelocityData>()) {
+                collect(arch, false);
+            }
+        });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 16バイトの3成分ベクトル4個を転置し、成分ごとに4幅で係数を掛けて戻す
+    //!
+    //! v = (v + step * gravityScale) * factor、keepが0のレーンはゼロにする。
+    //! 4番目の成分（パディング）はそのまま残す。
+    //------------------------------------------------------------------------
+    static void Apply4(float* base, const __m128 step[3], __m128 gravityScale,
+                       __m128 factor, __m128 keep) noexcept {
+        __m128 r0 = _mm_loadu_ps(base + 0);
+        __m128 r1 = _mm_loadu_ps(base + 4);
+        __m128 r2 = _mm_loadu_ps(base + 8);
+        __m128 r3 = _mm_loadu_ps(base + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);  // r0 = x0..x3, r1 = y, r2 = z, r3 = pad
+
+        r0 = _mm_and_ps(_mm_mul_ps(_mm_add_ps(r0, _mm_mul_ps(step[0], gravityScale)), factor), keep);
+        r1 = _mm_and_ps(_mm_mul_ps(_mm_add_ps(r1, _mm_mul_ps(step[1], gravityScale)), factor), keep);
+        r2 = _mm_and_ps(_mm_mul_ps(_mm_add_ps(r2, _mm_mul_ps(step[2], gravityScale)), factor), keep);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(base + 0, r0);
+        _mm_storeu_ps(base + 4, r1);
+        _mm_storeu_ps(base + 8, r2);
+        _mm_storeu_ps(base + 12, r3);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 4体を積分（first から4体分の列が有効であること）
+    //------------------------------------------------------------------------
+    static void Integrate4(const ChunkWork& work, uint32_t first,
+                           const Vector3& gravityStep, float dt) noexcept {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 dtv = _mm_set1_ps(dt);
+        const __m128 allBits = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        // 減衰係数: max(0, 1 - k * dt)。{linear, angular} x4 を2本読みで分離
+        __m128 linearFactor = one;
+        __m128 angularFactor = one;
+        if (work.damping) {
+            const float* d = &work.damping[first].linear;
+            const __m128 d01 = _mm_loadu_ps(d);
+            const __m128 d23 = _mm_loadu_ps(d + 4);
+            const __m128 linear = _mm_shuffle_ps(d01, d23, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 angular = _mm_shuffle_ps(d01, d23, _MM_SHUFFLE(3, 1, 3, 1));
+            linearFactor = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(linear, dtv)));
+            angularFactor = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(angular, dtv)));
+        }
+
+        if (work.angularVelocity) {
+            const __m128 noStep[3] = { zero, zero, zero };
+            Apply4(&work.angularVelocity[first].value.x, noStep, zero, angularFactor, allBits);
+        }
+        if (!work.velocity) return;
+
+        // 重力スケール（重力なし = 0、係数なし = 1）
+        __m128 gravityScale = work.gravity ? one : zero;
+        if (work.gravity && work.gravityFactor) {
+            gravityScale = _mm_loadu_ps(&work.gravityFactor[first].value);
+        }
+
+        // MassOverride: 1バイト目 = isKinematic、2バイト目 = setVelocityToZero
+        __m128 keep = allBits;
+        if (work.massOverride) {
+            const __m128i flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&work.massOverride[first]));
+            const __m128i zeroi = _mm_setzero_si128();
+            const __m128 kinematic = _mm_castsi128_ps(_mm_cmpeq_epi32(
+                _mm_and_si128(flags, _mm_set1_epi32(0x00FF)), zeroi));
+            gravityScale = _mm_and_ps(gravityScale, kinematic);
+            keep = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(flags, _mm_set1_epi32(0xFF00)), zeroi));
+        }
+
+        const __m128 step[3] = {
+            _mm_set1_ps(gravityStep.x), _mm_set1_ps(gravityStep.y), _mm_set1_ps(gravityStep.z)
+        };
+        Apply4(&work.velocity[first].value.x, step, gravityScale, linearFactor, keep);
+    }
+
+    // カーネルが前提とする列のレイアウト（16バイト = xyz + パディング）
+    static_assert(sizeof(VelocityData) == 16 && sizeof(AngularVelocityData) == 16,
+                  "Apply4 expects 16-byte velocity components");
+
     Vector3 gravity_ = Vector3(0.0f, -9.81f, 0.0f);  //!< 重力ベクトル（デフォルト: 地球の重力）
+    std::vector<ChunkWork> work_;                    //!< 今回の積分対象Chunk
+    std::vector<uint32_t> workCosts_;                //!< 積分対象ChunkのActor数（分割のコストヒント）
 };
 
 } // namespace ECS
@@ -5,3 +5,4 @@
 #pragma once
 
 #include "physics_system.h"
+#include "rigid_body_system.h"
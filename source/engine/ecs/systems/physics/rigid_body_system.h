@@ -0,0 +1,509 @@
+//----------------------------------------------------------------------------
+//! @file   rigid_body_system.h
+//! @brief  ECS RigidBodySystem - 接触応答・アイランド・スリープ
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/system.h"
+#include "engine/ecs/world.h"
+#include "engine/ecs/components/transform/transform_components.h"
+#include "engine/ecs/components/movement/velocity_data.h"
+#include "engine/ecs/components/movement/angular_velocity_data.h"
+#include "engine/ecs/components/physics/physics_components.h"
+#include "engine/ecs/components/collision/collider3d_data.h"
+#include "engine/ecs/systems/collision/collision3d_system.h"
+#include "engine/ecs/physics/contact_solver.h"
+#include "engine/ecs/physics/island_builder.h"
+#include "engine/core/job_system.h"
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 剛体システム（更新システム）
+//!
+//! 入力: RigidBodyData, VelocityData, PhysicsMassData, LocalTransform, Collider3DData,
+//!       AngularVelocityData（任意）, Collision3DSystemの接触イベント
+//! 出力: VelocityData, AngularVelocityData, RigidBodyData（スリープ状態）
+//!
+//! 処理フロー:
+//! 1. 動的剛体（inverseMass > 0 かつキネマティックでない）をソルバー配列へ集める
+//! 2. Collision3DSystemの接触（前ステップの検出結果 = 現在の位置）からマニフォールドを作る
+//!    - AABB同士は重なり矩形の4点（どちらも回転しなければ1点）、球を含むペアは1点
+//!    - RigidBodyDataを持たない相手は静的（VelocityDataがあればキネマティック）として扱う
+//!    - CCDの衝突時刻イベント（toi < 1）は使わない。終端位置では相手を通り抜けており、
+//!      接触として解くと誤った側へ押し出すため（CCDは検出のみ。Collision3DSystem参照）
+//! 3. 動的剛体同士の接触で Union-Find によりアイランドへ分割
+//! 4. アイランドごとに逐次インパルス法で解く（JobSystemで並列、前ステップのインパルスでウォームスタート）
+//! 5. アイランド内の全剛体が静止し続けたらアイランドごとスリープ
+//!
+//! スリープ中の剛体は解かず、PhysicsSystemが加えた重力を打ち消して速度0のまま保つ。
+//! 起きている剛体と接触した、支えを失った（接触数が減った）、動くキネマティックに
+//! 触れた場合はアイランドごと起きる。外から速度を与えたら RigidBodyData::WakeUp() を呼ぶこと。
+//!
+//! @note 優先度4。PhysicsSystem（重力）の後、MovementSystem（位置更新）の前に
+//!       実行されるよう依存関係付きで登録する。
+//!
+//! @code
+//! world.RegisterSystem<PhysicsSystem>();
+//! world.RegisterSystemWithDeps<RigidBodySystem>()
+//!      .After<PhysicsSystem>()
+//!      .Before<MovementSystem>();
+//! world.RegisterSystem<MovementSystem>();
+//! world.RegisterSystem<Collision3DSystem>();
+//! @endcode
+//============================================================================
+class RigidBodySystem final : public ISystem {
+public:
+    //! @brief 直線速度がこれ以下なら静止とみなす（m/s）
+    static constexpr float kLinearSleepTolerance = 0.05f;
+
+    //! @brief 角速度がこれ以下なら静止とみなす（rad/s）
+    static constexpr float kAngularSleepTolerance = 0.05f;
+
+    //! @brief この時間静止が続いたアイランドをスリープさせる（秒）
+    static constexpr float kTimeToSleep = 0.5f;
+
+    //! @brief 直前のステップの統計
+    struct Stats {
+        uint32_t bodyCount = 0;         //!< 動的剛体数
+        uint32_t manifoldCount = 0;     //!< 接触マニフォールド数
+        uint32_t islandCount = 0;       //!< アイランド数
+        uint32_t sleepingBodies = 0;    //!< ステップ後にスリープしている剛体数
+    };
+
+    void OnUpdate(World& world, float dt) override {
+        CollectBodies(world.GetArchetypeStorage());
+        CollectContacts(world);
+        islands_.Build();
+
+        const uint32_t islandCount = islands_.GetIslandCount();
+        islandCosts_.resize(islandCount);
+        for (uint32_t i = 0; i < islandCount; ++i) {
+            const auto& island = islands_.GetIsland(i);
+            islandCosts_[i] = (island.bodyEnd - island.bodyBegin) +
+                (island.contactEnd - island.contactBegin) * solver_.GetSettings().velocityIterations;
+        }
+
+        sleepingBodies_.store(0, std::memory_order_relaxed);
+        RunParallelRange(islandCount, kMinParallelIslands,
+            ParallelForDesc().SetPartition(ParallelForPartition::Dynamic).SetItemCosts(islandCosts_),
+            [this, dt](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    SolveIsland(i, dt);
+                }
+            });
+
+        StoreImpulses();
+        ReleaseActorSlots();
+
+        stats_.bodyCount = dynamicCount_;
+        stats_.manifoldCount = static_cast<uint32_t>(manifolds_.size());
+        stats_.islandCount = islandCount;
+        stats_.sleepingBodies = sleepingBodies_.load(std::memory_order_relaxed);
+    }
+
+    int Priority() const override { return 4; }
+    const char* Name() const override { return "RigidBodySystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        // 接触はCollision3DSystemのイベントキューから読む
+        access.Read<PhysicsMassData, PhysicsMassOverrideData, LocalTransform, Collider3DData, Collision3DSystem>()
+              .Write<RigidBodyData, VelocityData, AngularVelocityData>();
+    }
+
+    //! @brief 直前のステップの統計
+    [[nodiscard]] const Stats& GetStats() const noexcept { return stats_; }
+
+    //! @brief ソルバー設定を変更（反復回数・位置補正など）
+    void SetSettings(const Physics::ContactSolverSettings& settings) noexcept {
+        solver_ = Physics::ContactSolver(settings);
+    }
+
+    //! @brief ソルバー設定
+    [[nodiscard]] const Physics::ContactSolverSettings& GetSettings() const noexcept {
+        return solver_.GetSettings();
+    }
+
+private:
+    //! @brief 並列に解く最小アイランド数
+    static constexpr uint32_t kMinParallelIslands = 4;
+
+    //! @brief ソルバー剛体と書き戻し先
+    struct BodyRef {
+        Actor actor;
+        VelocityData* velocity = nullptr;
+        AngularVelocityData* angularVelocity = nullptr;    //!< nullptr = 回転しない
+        RigidBodyData* rigidBody = nullptr;                 //!< 書き戻し先（静的な相手はnullptr）
+        const RigidBodyData* material = nullptr;            //!< 摩擦・反発係数（nullptrなら既定値）
+        const Collider3DData* collider = nullptr;
+    };
+
+    //! @brief ウォームスタート用に保持する前ステップのインパルス
+    struct CachedImpulses {
+        uint32_t actorA = 0;                                //!< ペアの向き（入れ替わったら使わない）
+        Vector3 normal;
+        uint32_t pointCount = 0;
+        float normalImpulse[Physics::ContactManifold::kMaxPoints] = {};
+        float tangentImpulse[Physics::ContactManifold::kMaxPoints][2] = {};
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief 動的剛体を集める（ソルバー配列の先頭 [0, dynamicCount_)）
+    //------------------------------------------------------------------------
+    void CollectBodies(ArchetypeStorage& storage) {
+        bodies_.clear();
+        refs_.clear();
+        const uint32_t version = storage.GetWriteVersion();
+
+        storage.ForEachMatching<RigidBodyData, VelocityData, PhysicsMassData, LocalTransform, Collider3DData>(
+            [this, version](Archetype& arch) {
+                const bool hasAngular = arch.HasComponent<AngularVelocityData>();
+                const bool hasOverride = arch.HasComponent<PhysicsMassOverrideData>();
+                const size_t velocityIndex = arch.GetComponentIndex<VelocityData>();
+                const size_t rigidBodyIndex = arch.GetComponentIndex<RigidBodyData>();
+                const size_t angularIndex = hasAngular ? arch.GetComponentIndex<AngularVelocityData>() : 0;
+                const auto& metas = arch.GetChunkMetas();
+
+                for (size_t ci = 0; ci < metas.size(); ++ci) {
+                    const uint16_t count = metas[ci].count;
+                    if (count == 0) continue;
+
+                    arch.MarkComponentWritten(ci, velocityIndex, version);
+                    arch.MarkComponentWritten(ci, rigidBodyIndex, version);
+                    if (hasAngular) {
+                        arch.MarkComponentWritten(ci, angularIndex, version);
+                    }
+
+                    const Actor* actors = arch.GetActorArray(ci);
+                    RigidBodyData* rigidBodies = arch.GetComponentArray<RigidBodyData>(ci);
+                    VelocityData* velocities = arch.GetComponentArray<VelocityData>(ci);
+                    const PhysicsMassData* masses = arch.GetComponentArray<PhysicsMassData>(ci);
+                    const LocalTransform* transforms = arch.GetComponentArray<LocalTransform>(ci);
+                    const Collider3DData* colliders = arch.GetComponentArray<Collider3DData>(ci);
+                    AngularVelocityData* angular = hasAngular ? arch.GetComponentArray<AngularVelocityData>(ci) : nullptr;
+                    const PhysicsMassOverrideData* overrides =
+                        hasOverride ? arch.GetComponentArray<PhysicsMassOverrideData>(ci) : nullptr;
+
+                    for (uint16_t i = 0; i < count; ++i) {
+                        // 質量0・キネマティックは接触時に静的な相手として参照される
+                        if (!masses[i].IsDynamic() || (overrides && overrides[i].IsKinematic())) continue;
+
+                        Physics::SolverBody body;
+                        body.linearVelocity = velocities[i].value;
+                        body.position = transforms[i].position;
+                        body.inverseMass = masses[i].inverseMass;
+                        body.dynamic = true;
+                        if (angular) {
+                            body.angularVelocity = angular[i].value;
+                            body.inverseInertia = Physics::InverseInertia::FromPrincipal(
+                                masses[i].inverseInertia, transforms[i].rotation * masses[i].inertiaOrientation);
+                        }
+
+                        BodyRef ref;
+                        ref.actor = actors[i];
+                        ref.velocity = &velocities[i];
+                        ref.angularVelocity = angular ? &angular[i] : nullptr;
+                        ref.rigidBody = &rigidBodies[i];
+                        ref.material = &rigidBodies[i];
+                        ref.collider = &colliders[i];
+                        AssignSlot(actors[i], static_cast<uint32_t>(bodies_.size()));
+                        bodies_.push_back(body);
+                        refs_.push_back(ref);
+                    }
+                }
+            });
+
+        dynamicCount_ = static_cast<uint32_t>(bodies_.size());
+        touchCount_.assign(dynamicCount_, 0);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 接触イベントからマニフォールドを作り、アイランドへ登録
+    //------------------------------------------------------------------------
+    void CollectContacts(const World& world) {
+        manifolds_.clear();
+        manifoldActorA_.clear();
+        islands_.Reset(dynamicCount_);
+
+        const Collision3DSystem* collision = world.GetSystem<Collision3DSystem>();
+        if (!collision) return;
+
+        for (const Collision::Event3D& event : collision->GetEventQueue().GetEvents()) {
+            // CCDの衝突時刻イベント（toi < 1）は現在位置で重なっていないため応答しない（すり抜けは止めない）
+            if (event.type == Collision::EventType::Exit || event.toi < 1.0f) continue;
+
+            const uint32_t a = FindOrAddStatic(world, event.actorA);
+            const uint32_t b = FindOrAddStatic(world, event.actorB);
+            if (a == Physics::IslandBuilder::kNoBody || b == Physics::IslandBuilder::kNoBody) continue;
+            const bool dynamicA = a < dynamicCount_;
+            const bool dynamicB = b < dynamicCount_;
+            if (!dynamicA && !dynamicB) continue;
+
+            const Collider3DData& colliderA = *refs_[a].collider;
+            const Collider3DData& colliderB = *refs_[b].collider;
+            if (colliderA.IsTrigger() || colliderB.IsTrigger()) continue;
+
+            // Narrow-phaseの法線は球同士のみAからB向き、AABBを含むペアはBからA向き
+            const bool sphereSphere = colliderA.shapeType == Collider3DShape::Sphere &&
+                                      colliderB.shapeType == Collider3DShape::Sphere;
+            const bool sphereBox =
+                (colliderA.shapeType == Collider3DShape::Sphere && colliderB.shapeType == Collider3DShape::AABB) ||
+                (colliderA.shapeType == Collider3DShape::AABB && colliderB.shapeType == Collider3DShape::Sphere);
+            const Vector3 normal = sphereSphere ? event.GetNormal() : -event.GetNormal();
+
+            Physics::ContactManifold m;
+            m.bodyA = a;
+            m.bodyB = b;
+            m.normal = normal;
+            m.friction = std::sqrt(Friction(refs_[a]) * Friction(refs_[b]));
+            m.restitution = (std::max)(Restitution(refs_[a]), Restitution(refs_[b]));
+
+            // 回転しない剛体同士は4隅の拘束が同じ式になるため1点で解く
+            const bool boxBox = !sphereSphere && !sphereBox && (CanRotate(a) || CanRotate(b));
+            Vector3 points[Physics::ContactManifold::kMaxPoints];
+            m.pointCount = Physics::BuildContactPoints(normal, event.GetContactPoint(),
+                Bounds(colliderA), Bounds(colliderB), boxBox, points);
+            for (uint32_t i = 0; i < m.pointCount; ++i) {
+                Physics::ContactPoint& p = m.points[i];
+                p.rA = points[i] - bodies_[a].position;
+                p.rB = points[i] - bodies_[b].position;
+                p.penetration = event.penetration;
+                p.id = static_cast<uint8_t>(i);
+            }
+            LoadImpulses(event.actorA, event.actorB, m);
+
+            if (dynamicA) ++touchCount_[a];
+            if (dynamicB) ++touchCount_[b];
+            islands_.AddContact(dynamicA ? a : Physics::IslandBuilder::kNoBody,
+                                dynamicB ? b : Physics::IslandBuilder::kNoBody);
+            manifolds_.push_back(m);
+            manifoldActorA_.push_back(event.actorA);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1アイランドを解く（他のアイランドと並列に呼ばれる）
+    //------------------------------------------------------------------------
+    void SolveIsland(uint32_t islandIndex, float dt) {
+        const auto& island = islands_.GetIsland(islandIndex);
+        const uint32_t* bodyList = islands_.GetBodies().data();
+        const uint32_t* contactList = islands_.GetContacts().data();
+
+        // スリープ判定: 全員寝ていて、起こす理由がなければ速度0のまま解かない
+        bool allSleeping = true;
+        bool wake = false;
+        for (uint32_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+            const uint32_t body = bodyList[i];
+            const RigidBodyData& rb = *refs_[body].rigidBody;
+            allSleeping = allSleeping && rb.IsSleeping();
+            wake = wake || touchCount_[body] < rb.contactCount;
+        }
+        if (allSleeping && !wake) {
+            for (uint32_t c = island.contactBegin; c < island.contactEnd; ++c) {
+                const Physics::ContactManifold& m = manifolds_[contactList[c]];
+                const Physics::SolverBody& other = bodies_[m.bodyA < dynamicCount_ ? m.bodyB : m.bodyA];
+                if (!other.dynamic && (other.linearVelocity.LengthSquared() > 0.0f ||
+                                       other.angularVelocity.LengthSquared() > 0.0f)) {
+                    wake = true;
+                    break;
+                }
+            }
+        }
+        if (allSleeping && !wake) {
+            for (uint32_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+                PutToSleep(bodyList[i]);
+            }
+            sleepingBodies_.fetch_add(island.bodyEnd - island.bodyBegin, std::memory_order_relaxed);
+            return;
+        }
+
+        // 解く（静的な相手は書き込まれない）
+        Physics::SolverBody* bodies = bodies_.data();
+        for (uint32_t c = island.contactBegin; c < island.contactEnd; ++c) {
+            solver_.Prepare(manifolds_[contactList[c]], bodies, dt);
+        }
+        for (uint32_t c = island.contactBegin; c < island.contactEnd; ++c) {
+            solver_.WarmStart(manifolds_[contactList[c]], bodies);
+        }
+        for (uint32_t it = 0; it < solver_.GetSettings().velocityIterations; ++it) {
+            for (uint32_t c = island.contactBegin; c < island.contactEnd; ++c) {
+                solver_.Solve(manifolds_[contactList[c]], bodies);
+            }
+        }
+
+        // 書き戻しとスリープタイマー
+        float minSleepTime = kTimeToSleep;
+        const float linearTolSq = kLinearSleepTolerance * kLinearSleepTolerance;
+        const float angularTolSq = kAngularSleepTolerance * kAngularSleepTolerance;
+        for (uint32_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+            const uint32_t body = bodyList[i];
+            const Physics::SolverBody& solved = bodies_[body];
+            const BodyRef& ref = refs_[body];
+            RigidBodyData& rb = *ref.rigidBody;
+
+            ref.velocity->value = solved.linearVelocity;
+            if (ref.angularVelocity) {
+                ref.angularVelocity->value = solved.angularVelocity;
+            }
+            rb.sleeping = 0;
+            rb.contactCount = static_cast<uint16_t>((std::min)(touchCount_[body], 0xFFFFu));
+            if (solved.linearVelocity.LengthSquared() > linearTolSq ||
+                solved.angularVelocity.LengthSquared() > angularTolSq) {
+                rb.sleepTimer = 0.0f;
+            } else {
+                rb.sleepTimer += dt;
+            }
+            minSleepTime = (std::min)(minSleepTime, rb.sleepTimer);
+        }
+
+        if (minSleepTime >= kTimeToSleep) {
+            for (uint32_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+                PutToSleep(bodyList[i]);
+            }
+            sleepingBodies_.fetch_add(island.bodyEnd - island.bodyBegin, std::memory_order_relaxed);
+        }
+    }
+
+    //! @brief 剛体をスリープさせる（重力で加わった速度も打ち消す）
+    void PutToSleep(uint32_t body) noexcept {
+        const BodyRef& ref = refs_[body];
+        ref.velocity->value = Vector3::Zero;
+        if (ref.angularVelocity) {
+            ref.angularVelocity->value = Vector3::Zero;
+        }
+        ref.rigidBody->sleeping = 1;
+        ref.rigidBody->contactCount = static_cast<uint16_t>((std::min)(touchCount_[body], 0xFFFFu));
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 接触相手のソルバー剛体を探し、なければ静的な相手として追加
+    //! @return ソルバー剛体インデックス（コライダーがなければkNoBody）
+    //!
+    //! 静的な相手は読み取りのみ（const Worldから取得し、Chunkのバージョンを更新しない）
+    //------------------------------------------------------------------------
+    uint32_t FindOrAddStatic(const World& world, Actor actor) {
+        const uint32_t index = actor.Index();
+        if (index < slotOfActor_.size()) {
+            const uint32_t slot = slotOfActor_[index];
+            if (slot != Physics::IslandBuilder::kNoBody && refs_[slot].actor == actor) {
+                return slot;
+            }
+        }
+
+        const Collider3DData* collider = world.GetComponent<Collider3DData>(actor);
+        if (!collider) return Physics::IslandBuilder::kNoBody;
+
+        Physics::SolverBody body;
+        const LocalTransform* transform = world.GetComponent<LocalTransform>(actor);
+        body.position = transform ? transform->position : collider->GetCenter();
+        if (const VelocityData* velocity = world.GetComponent<VelocityData>(actor)) {
+            body.linearVelocity = velocity->value;
+        }
+        if (const AngularVelocityData* angular = world.GetComponent<AngularVelocityData>(actor)) {
+            body.angularVelocity = angular->value;
+        }
+
+        BodyRef ref;
+        ref.actor = actor;
+        ref.material = world.GetComponent<RigidBodyData>(actor);
+        ref.collider = collider;
+
+        const uint32_t slot = static_cast<uint32_t>(bodies_.size());
+        AssignSlot(actor, slot);
+        bodies_.push_back(body);
+        refs_.push_back(ref);
+        return slot;
+    }
+
+    //! @brief Actorインデックス → ソルバー剛体インデックスを登録
+    void AssignSlot(Actor actor, uint32_t slot) {
+        const uint32_t index = actor.Index();
+        if (index >= slotOfActor_.size()) {
+            slotOfActor_.resize(static_cast<size_t>(index) + 1, Physics::IslandBuilder::kNoBody);
+        }
+        slotOfActor_[index] = slot;
+    }
+
+    //! @brief 登録したスロットを戻す（次のステップで古い対応を拾わないように）
+    void ReleaseActorSlots() noexcept {
+        for (const BodyRef& ref : refs_) {
+            slotOfActor_[ref.actor.Index()] = Physics::IslandBuilder::kNoBody;
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 同じペア・同じ向き・同じ点数なら前ステップのインパルスを引き継ぐ
+    //------------------------------------------------------------------------
+    void LoadImpulses(Actor actorA, Actor actorB, Physics::ContactManifold& m) const {
+        auto it = cache_.find(Collision::PairKey(actorA, actorB).key);
+        if (it == cache_.end()) return;
+        const CachedImpulses& cached = it->second;
+        if (cached.actorA != actorA.id || cached.pointCount != m.pointCount ||
+            cached.normal.Dot(m.normal) < 0.99f) {
+            return;
+        }
+        for (uint32_t i = 0; i < m.pointCount; ++i) {
+            m.points[i].normalImpulse = cached.normalImpulse[i];
+            m.points[i].tangentImpulse[0] = cached.tangentImpulse[i][0];
+            m.points[i].tangentImpulse[1] = cached.tangentImpulse[i][1];
+        }
+    }
+
+    //! @brief 今回のインパルスを保存（今回接触していないペアは捨てる）
+    void StoreImpulses() {
+        cache_.clear();
+        for (size_t i = 0; i < manifolds_.size(); ++i) {
+            const Physics::ContactManifold& m = manifolds_[i];
+            const Actor actorA = manifoldActorA_[i];
+            const Actor actorB = refs_[m.bodyA].actor == actorA ? refs_[m.bodyB].actor : refs_[m.bodyA].actor;
+
+            CachedImpulses& cached = cache_[Collision::PairKey(actorA, actorB).key];
+            cached.actorA = actorA.id;
+            cached.normal = m.normal;
+            cached.pointCount = m.pointCount;
+            for (uint32_t p = 0; p < m.pointCount; ++p) {
+                cached.normalImpulse[p] = m.points[p].normalImpulse;
+                cached.tangentImpulse[p][0] = m.points[p].tangentImpulse[0];
+                cached.tangentImpulse[p][1] = m.points[p].tangentImpulse[1];
+            }
+        }
+    }
+
+    //! @brief 接触で回転する（動的でAngularVelocityDataあり）か、回転しているキネマティックか
+    [[nodiscard]] bool CanRotate(uint32_t slot) const noexcept {
+        return refs_[slot].angularVelocity != nullptr || bodies_[slot].angularVelocity.LengthSquared() > 0.0f;
+    }
+
+    [[nodiscard]] static float Friction(const BodyRef& ref) noexcept {
+        return ref.material ? ref.material->friction : RigidBodyData().friction;
+    }
+
+    [[nodiscard]] static float Restitution(const BodyRef& ref) noexcept {
+        return ref.material ? ref.material->restitution : 0.0f;
+    }
+
+    [[nodiscard]] static Collision::Bounds3D Bounds(const Collider3DData& c) noexcept {
+        return Collision::Bounds3D{ c.minX, c.minY, c.minZ, c.maxX, c.maxY, c.maxZ };
+    }
+
+    Physics::ContactSolver solver_;
+    Physics::IslandBuilder islands_;
+    std::vector<Physics::SolverBody> bodies_;           //!< [0, dynamicCount_) 動的剛体、以降は静的な相手
+    std::vector<BodyRef> refs_;                         //!< bodies_ と同じ並びの書き戻し先
+    uint32_t dynamicCount_ = 0;
+    std::vector<uint32_t> touchCount_;                  //!< 動的剛体ごとの今回の接触数
+    std::vector<uint32_t> slotOfActor_;                 //!< Actorインデックス → ソルバー剛体（ステップ内のみ有効）
+    std::vector<Physics::ContactManifold> manifolds_;   //!< 今回の接触（AddContactの順）
+    std::vector<Actor> manifoldActorA_;                 //!< マニフォールドごとのイベント上のActorA
+    std::vector<uint32_t> islandCosts_;                 //!< アイランドごとのコスト（分割のヒント）
+    std::unordered_map<uint64_t, CachedImpulses> cache_;  //!< ペア → 前ステップのインパルス
+    std::atomic<uint32_t> sleepingBodies_{0};
+    Stats stats_;
+};
+
+} // namespace ECS
@@ -0,0 +1,273 @@
+//----------------------------------------------------------------------------
+//! @file   frustum_culling.h
+//! @brief  視錐台カリング - 平面抽出とWorldRenderBoundsDataのSIMD判定
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/components/rendering/world_render_bounds_data.h"
+#include "engine/math/math_types.h"
+#include <immintrin.h>
+#include <bit>
+#include <cstdint>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 視錐台の6平面（SoA配置）
+//!
+//! 平面は dot(n, p) + d >= 0 を内側とする。
+//! 判定時に各平面の係数をブロードキャストするため、成分ごとに配列で保持する。
+//============================================================================
+struct FrustumPlanes {
+    static constexpr int kPlaneCount = 6;
+
+    float nx[kPlaneCount] = {};
+    float ny[kPlaneCount] = {};
+    float nz[kPlaneCount] = {};
+    float d[kPlaneCount] = {};
+
+    //------------------------------------------------------------------------
+    //! @brief ビュープロジェクション行列から平面を抽出（Gribb-Hartmann法）
+    //! @param viewProjection ビュープロジェクション行列（行ベクトル、DirectX規約）
+    //! @param useDepthPlanes falseの場合、near/far平面は常に内側として扱う（2D用）
+    //------------------------------------------------------------------------
+    [[nodiscard]] static FrustumPlanes FromViewProjection(const Matrix& viewProjection,
+                                                          bool useDepthPlanes = true) noexcept {
+        const Matrix& m = viewProjection;
+        FrustumPlanes planes;
+        // clip = [x y z 1] * M のため、列 j = (_1j, _2j, _3j, _4j)
+        planes.Set(0, m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41);  // left
+        planes.Set(1, m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41);  // right
+        planes.Set(2, m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42);  // bottom
+        planes.Set(3, m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42);  // top
+        if (useDepthPlanes) {
+            planes.Set(4, m._13, m._23, m._33, m._43);                                  // near (0 <= z)
+            planes.Set(5, m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43);  // far
+        } else {
+            planes.Set(4, 0.0f, 0.0f, 0.0f, 1.0f);
+            planes.Set(5, 0.0f, 0.0f, 0.0f, 1.0f);
+        }
+        return planes;
+    }
+
+    void Set(int index, float a, float b, float c, float dist) noexcept {
+        nx[index] = a;
+        ny[index] = b;
+        nz[index] = c;
+        d[index] = dist;
+    }
+};
+
+//============================================================================
+//! @brief AABBと視錐台の位置関係
+//============================================================================
+enum class FrustumTest : uint8_t {
+    Outside,    //!< 完全に外側
+    Intersect,  //!< 境界と交差
+    Inside      //!< 完全に内側
+};
+
+namespace Culling {
+
+//----------------------------------------------------------------------------
+//! @brief 1つのAABBを分類（Chunk境界の早期判定・端数処理用）
+//----------------------------------------------------------------------------
+[[nodiscard]] inline FrustumTest Classify(const WorldRenderBoundsData& bounds,
+                                          const FrustumPlanes& planes) noexcept {
+    FrustumTest result = FrustumTest::Inside;
+    for (int p = 0; p < FrustumPlanes::kPlaneCount; ++p) {
+        const float nx = planes.nx[p], ny = planes.ny[p], nz = planes.nz[p];
+        // P-vertex（法線方向に最も遠い頂点）が外側なら完全に外側
+        const float pDist =
+            nx * (nx >= 0.0f ? bounds.maxPoint.x : bounds.minPoint.x) +
+            ny * (ny >= 0.0f ? bounds.maxPoint.y : bounds.minPoint.y) +
+            nz * (nz >= 0.0f ? bounds.maxPoint.z : bounds.minPoint.z) + planes.d[p];
+        if (pDist < 0.0f) {
+            return FrustumTest::Outside;
+        }
+        // N-vertex（法線の逆方向に最も遠い頂点）が外側なら交差
+        const float nDist =
+            nx * (nx >= 0.0f ? bounds.minPoint.x : bounds.maxPoint.x) +
+            ny * (ny >= 0.0f ? bounds.minPoint.y : bounds.maxPoint.y) +
+            nz * (nz >= 0.0f ? bounds.minPoint.z : bounds.maxPoint.z) + planes.d[p];
+        if (nDist < 0.0f) {
+            result = FrustumTest::Intersect;
+        }
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------
+//! @brief 1つのAABBが可視か（視錐台と交差または内側）
+//----------------------------------------------------------------------------
+[[nodiscard]] inline bool IsVisible(const WorldRenderBoundsData& bounds,
+                                    const FrustumPlanes& planes) noexcept {
+    for (int p = 0; p < FrustumPlanes::kPlaneCount; ++p) {
+        const float nx = planes.nx[p], ny = planes.ny[p], nz = planes.nz[p];
+        const float pDist =
+            nx * (nx >= 0.0f ? bounds.maxPoint.x : bounds.minPoint.x) +
+            ny * (ny >= 0.0f ? bounds.maxPoint.y : bounds.minPoint.y) +
+            nz * (nz >= 0.0f ? bounds.maxPoint.z : bounds.minPoint.z) + planes.d[p];
+        if (pDist < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace detail {
+
+#if defined(__AVX__)
+//! @brief 8個のAABBを判定し、可視ビット（下位8bit）を返す
+//!
+//! WorldRenderBoundsDataは32バイト（min.xyz, pad, max.xyz, pad）のため、
+//! 1要素を__m256で読み込み8x8転置でSoAに並べ替える。
+[[nodiscard]] inline uint32_t TestBounds8(const WorldRenderBoundsData* bounds,
+                                          const FrustumPlanes& planes) noexcept {
+    const float* base = &bounds[0].minPoint.x;
+    __m256 r0 = _mm256_loadu_ps(base + 0 * 8);
+    __m256 r1 = _mm256_loadu_ps(base + 1 * 8);
+    __m256 r2 = _mm256_loadu_ps(base + 2 * 8);
+    __m256 r3 = _mm256_loadu_ps(base + 3 * 8);
+    __m256 r4 = _mm256_loadu_ps(base + 4 * 8);
+    __m256 r5 = _mm256_loadu_ps(base + 5 * 8);
+    __m256 r6 = _mm256_loadu_ps(base + 6 * 8);
+    __m256 r7 = _mm256_loadu_ps(base + 7 * 8);
+
+    // 8x8転置（行: AABB、列: minX,minY,minZ,pad,maxX,maxY,maxZ,pad）
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 minX = _mm256_permute2f128_ps(s0, s4, 0x20);
+    const __m256 minY = _mm256_permute2f128_ps(s1, s5, 0x20);
+    const __m256 minZ = _mm256_permute2f128_ps(s2, s6, 0x20);
+    const __m256 maxX = _mm256_permute2f128_ps(s0, s4, 0x31);
+    const __m256 maxY = _mm256_permute2f128_ps(s1, s5, 0x31);
+    const __m256 maxZ = _mm256_permute2f128_ps(s2, s6, 0x31);
+
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 outside = zero;
+    for (int p = 0; p < FrustumPlanes::kPlaneCount; ++p) {
+        // 法線の符号は全レーン共通のため、P-vertexの選択は平面ごとの分岐で済む
+        const __m256 px = planes.nx[p] >= 0.0f ? maxX : minX;
+        const __m256 py = planes.ny[p] >= 0.0f ? maxY : minY;
+        const __m256 pz = planes.nz[p] >= 0.0f ? maxZ : minZ;
+        __m256 dist = _mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), px);
+        dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), py));
+        dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), pz));
+        dist = _mm256_add_ps(dist, _mm256_set1_ps(planes.d[p]));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, zero, _CMP_LT_OQ));
+    }
+    return ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+}
+#endif
+
+//! @brief 4個のAABBを判定し、可視ビット（下位4bit）を返す
+[[nodiscard]] inline uint32_t TestBounds4(const WorldRenderBoundsData* bounds,
+                                          const FrustumPlanes& planes) noexcept {
+    __m128 minX = _mm_loadu_ps(&bounds[0].minPoint.x);
+    __m128 minY = _mm_loadu_ps(&bounds[1].minPoint.x);
+    __m128 minZ = _mm_loadu_ps(&bounds[2].minPoint.x);
+    __m128 minW = _mm_loadu_ps(&bounds[3].minPoint.x);
+    __m128 maxX = _mm_loadu_ps(&bounds[0].maxPoint.x);
+    __m128 maxY = _mm_loadu_ps(&bounds[1].maxPoint.x);
+    __m128 maxZ = _mm_loadu_ps(&bounds[2].maxPoint.x);
+    __m128 maxW = _mm_loadu_ps(&bounds[3].maxPoint.x);
+    _MM_TRANSPOSE4_PS(minX, minY, minZ, minW);
+    _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, maxW);
+
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside = zero;
+    for (int p = 0; p < FrustumPlanes::kPlaneCount; ++p) {
+        const __m128 px = planes.nx[p] >= 0.0f ? maxX : minX;
+        const __m128 py = planes.ny[p] >= 0.0f ? maxY : minY;
+        const __m128 pz = planes.nz[p] >= 0.0f ? maxZ : minZ;
+        __m128 dist = _mm_mul_ps(_mm_set1_ps(planes.nx[p]), px);
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes.ny[p]), py));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), pz));
+        dist = _mm_add_ps(dist, _mm_set1_ps(planes.d[p]));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, zero));
+    }
+    return ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+}
+
+} // namespace detail
+
+//----------------------------------------------------------------------------
+//! @brief AABB配列を判定し、可視ビットマスクを書き込む
+//! @param bounds AABB配列（Chunk内のWorldRenderBoundsData配列）
+//! @param count 要素数
+//! @param planes 視錐台
+//! @param outMask 出力先（(count + 63) / 64 ワード。ビットi = 要素iが可視）
+//! @return 可視な要素数
+//!
+//! AVX有効時は8個、それ以外はSSEで4個ずつ判定し、端数はスカラーで判定する。
+//----------------------------------------------------------------------------
+inline uint32_t CullBounds(const WorldRenderBoundsData* bounds, uint32_t count,
+                           const FrustumPlanes& planes, uint64_t* outMask) noexcept {
+    const uint32_t wordCount = (count + 63) / 64;
+    for (uint32_t w = 0; w < wordCount; ++w) {
+        outMask[w] = 0;
+    }
+
+    uint32_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        outMask[i / 64] |= static_cast<uint64_t>(detail::TestBounds8(bounds + i, planes)) << (i % 64);
+    }
+#endif
+    for (; i + 4 <= count; i += 4) {
+        outMask[i / 64] |= static_cast<uint64_t>(detail::TestBounds4(bounds + i, planes)) << (i % 64);
+    }
+    for (; i < count; ++i) {
+        if (IsVisible(bounds[i], planes)) {
+            outMask[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+
+    uint32_t visible = 0;
+    for (uint32_t w = 0; w < wordCount; ++w) {
+        visible += static_cast<uint32_t>(std::popcount(outMask[w]));
+    }
+    return visible;
+}
+
+//----------------------------------------------------------------------------
+//! @brief AABB配列を包含するAABBを計算
+//! @return 包含AABB（count == 0 の場合はWorldRenderBoundsData::Invalid()）
+//!
+//! 無効なAABB（min > max）は包含計算に影響しない。
+//----------------------------------------------------------------------------
+[[nodiscard]] inline WorldRenderBoundsData ComputeUnion(const WorldRenderBoundsData* bounds,
+                                                        uint32_t count) noexcept {
+    const WorldRenderBoundsData invalid = WorldRenderBoundsData::Invalid();
+    __m128 minAcc = _mm_loadu_ps(&invalid.minPoint.x);
+    __m128 maxAcc = _mm_loadu_ps(&invalid.maxPoint.x);
+    for (uint32_t i = 0; i < count; ++i) {
+        minAcc = _mm_min_ps(minAcc, _mm_loadu_ps(&bounds[i].minPoint.x));
+        maxAcc = _mm_max_ps(maxAcc, _mm_loadu_ps(&bounds[i].maxPoint.x));
+    }
+
+    alignas(16) float minOut[4];
+    alignas(16) float maxOut[4];
+    _mm_store_ps(minOut, minAcc);
+    _mm_store_ps(maxOut, maxAcc);
+    return WorldRenderBoundsData(Vector3(minOut[0], minOut[1], minOut[2]),
+                                 Vector3(maxOut[0], maxOut[1], maxOut[2]));
+}
+
+} // namespace Culling
+
+} // namespace ECS
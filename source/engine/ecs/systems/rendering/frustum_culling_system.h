@@ -0,0 +1,286 @@
+//----------------------------------------------------------------------------
+//! @file   frustum_culling_system.h
+//! @brief  ECS FrustumCullingSystem - Chunk単位の視錐台カリング
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/ecs/system.h"
+#include "engine/ecs/world.h"
+#include "engine/ecs/components/camera/camera2d_data.h"
+#include "engine/ecs/components/camera/camera3d_data.h"
+#include "engine/ecs/components/common/entity_tags.h"
+#include "engine/ecs/components/rendering/mesh_data.h"
+#include "engine/ecs/components/rendering/sprite_data.h"
+#include "engine/ecs/components/rendering/world_render_bounds_data.h"
+#include "engine/ecs/systems/rendering/frustum_culling.h"
+#include "engine/core/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+namespace ECS {
+
+//============================================================================
+//! @brief 視錐台カリングシステム（描画システム）
+//!
+//! 入力: WorldRenderBoundsData, アクティブカメラ（読み取り専用）
+//! 出力: Chunkごとの可視ビットマスク
+//!
+//! WorldRenderBoundsDataを持つChunkをJobSystemで並列に判定し、
+//! 後段の描画システムがGetVisibilityMask()で参照する。
+//! MeshDataを持つChunkは3Dカメラ、SpriteDataを持つChunkは2Dカメラで判定する。
+//!
+//! Chunkごとに全AABBの包含AABBを保持し、完全に外側なら全要素を不可視、
+//! 完全に内側なら全要素を可視として個別判定を省略する。
+//! 包含AABBはWorldRenderBoundsDataの変更バージョンとActor数が変わった時のみ再計算する。
+//!
+//! @note 優先度-10（スプライト・メッシュ描画より前）
+//============================================================================
+class FrustumCullingSystem final : public IRenderSystem {
+public:
+    //! @brief カリング統計（直前の実行分）
+    struct Stats {
+        uint32_t testedCount = 0;       //!< 判定対象のActor数
+        uint32_t visibleCount = 0;      //!< 可視と判定されたActor数
+        uint32_t chunkCount = 0;        //!< 判定対象のChunk数
+        uint32_t rejectedChunks = 0;    //!< 包含AABBで全要素を棄却したChunk数
+        uint32_t acceptedChunks = 0;    //!< 包含AABBで全要素を採用したChunk数
+    };
+
+    void OnRender(World& world, [[maybe_unused]] float alpha) override {
+        ++cullFrame_;
+        CollectPlanes(world);
+        CollectChunks(world.GetArchetypeStorage());
+
+        visibleCount_.store(0, std::memory_order_relaxed);
+        rejectedChunks_.store(0, std::memory_order_relaxed);
+        acceptedChunks_.store(0, std::memory_order_relaxed);
+
+        RunParallelRange(static_cast<uint32_t>(work_.size()), kMinParallelChunks, MakeChunkParallelForDesc(workCosts_),
+            [this](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    CullChunk(work_[i]);
+                }
+            });
+
+        stats_.chunkCount = static_cast<uint32_t>(work_.size());
+        stats_.visibleCount = visibleCount_.load(std::memory_order_relaxed);
+        stats_.rejectedChunks = rejectedChunks_.load(std::memory_order_relaxed);
+        stats_.acceptedChunks = acceptedChunks_.load(std::memory_order_relaxed);
+    }
+
+    int Priority() const override { return -10; }
+    const char* Name() const override { return "FrustumCullingSystem"; }
+
+    //------------------------------------------------------------------------
+    //! @brief Chunkの可視ビットマスクを取得
+    //! @param arch Archetype
+    //! @param chunkIndex Chunkインデックス
+    //! @return ビットi = Chunk内i番目のActorが可視。
+    //!         今フレーム判定していないChunkはnullptr（全て可視として扱う）
+    //------------------------------------------------------------------------
+    [[nodiscard]] const uint64_t* GetVisibilityMask(const Archetype& arch, size_t chunkIndex) const noexcept {
+        auto it = results_.find(&arch);
+        if (it == results_.end() || chunkIndex >= it->second.size()) {
+            return nullptr;
+        }
+        const ChunkCull& cull = it->second[chunkIndex];
+        return cull.frame == cullFrame_ ? cull.mask.data() : nullptr;
+    }
+
+    //! @brief Chunk内に可視なActorがいるか（判定していないChunkはtrue）
+    [[nodiscard]] bool AnyVisible(const Archetype& arch, size_t chunkIndex) const noexcept {
+        auto it = results_.find(&arch);
+        if (it == results_.end() || chunkIndex >= it->second.size()) {
+            return true;
+        }
+        const ChunkCull& cull = it->second[chunkIndex];
+        return cull.frame != cullFrame_ || cull.visibleCount > 0;
+    }
+
+    //! @brief マスクのビットを参照（nullptrは可視）
+    [[nodiscard]] static bool IsVisible(const uint64_t* mask, size_t index) noexcept {
+        return !mask || (mask[index / 64] & (uint64_t{1} << (index % 64))) != 0;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 3D判定に使うビュープロジェクションを明示指定
+    //!
+    //! 指定中はアクティブカメラより優先される。シャドウ用ライト視点等。
+    //------------------------------------------------------------------------
+    void SetViewProjection(const Matrix& viewProjection) noexcept {
+        overridePlanes_ = FrustumPlanes::FromViewProjection(viewProjection);
+        hasOverride_ = true;
+    }
+
+    //! @brief 明示指定を解除してアクティブカメラに戻す
+    void ClearViewProjection() noexcept { hasOverride_ = false; }
+
+    //! @brief 直前の実行の統計
+    [[nodiscard]] const Stats& GetStats() const noexcept { return stats_; }
+
+private:
+    //! @brief 並列判定時にJobSystemへ分割するChunk数の下限
+    static constexpr uint32_t kMinParallelChunks = 8;
+
+    //! @brief Chunkごとの判定結果とキャッシュ
+    struct ChunkCull {
+        std::vector<uint64_t> mask;                 //!< 可視ビットマスク
+        WorldRenderBoundsData chunkBounds = WorldRenderBoundsData::Invalid();  //!< 包含AABB
+        const void* chunk = nullptr;                //!< 包含AABB計算時のChunk実体
+        uint32_t boundsVersion = 0;                 //!< 包含AABB計算時の変更バージョン
+        uint16_t boundsCount = 0;                   //!< 包含AABB計算時のActor数
+        bool hasInvalid = false;                    //!< 無効なAABBを含むか
+        uint32_t visibleCount = 0;                  //!< 可視なActor数
+        uint32_t frame = 0;                         //!< 判定したフレーム（cullFrame_）
+    };
+
+    //! @brief 今フレームの判定対象
+    struct ChunkWork {
+        ChunkCull* cull;
+        const WorldRenderBoundsData* bounds;
+        const void* chunk;
+        const FrustumPlanes* planes;
+        uint32_t version;
+        uint16_t count;
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief アクティブカメラから平面を抽出（最初のカメラのみ使用）
+    //------------------------------------------------------------------------
+    void CollectPlanes(World& world) {
+        hasPlanes3D_ = hasOverride_;
+        if (hasOverride_) {
+            planes3D_ = overridePlanes_;
+        } else {
+            world.ForEach<In<Camera3DData>, In<ActiveCameraTag>>(
+                [this]([[maybe_unused]] Actor actor, const Camera3DData& cam,
+                       [[maybe_unused]] const ActiveCameraTag& tag) {
+                    if (!hasPlanes3D_) {
+                        planes3D_ = FrustumPlanes::FromViewProjection(cam.GetViewProjectionMatrix());
+                        hasPlanes3D_ = true;
+                    }
+                });
+        }
+
+        hasPlanes2D_ = false;
+        world.ForEach<In<Camera2DData>, In<ActiveCameraTag>>(
+            [this]([[maybe_unused]] Actor actor, const Camera2DData& cam,
+                   [[maybe_unused]] const ActiveCameraTag& tag) {
+                if (!hasPlanes2D_) {
+                    planes2D_ = FrustumPlanes::FromViewProjection(cam.GetViewProjectionMatrix(), false);
+                    hasPlanes2D_ = true;
+                }
+            });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief WorldRenderBoundsDataを持つChunkを列挙
+    //------------------------------------------------------------------------
+    void CollectChunks(ArchetypeStorage& storage) {
+        work_.clear();
+        workCosts_.clear();
+        stats_ = Stats{};
+
+        storage.ForEachMatching<WorldRenderBoundsData>([this](Archetype& arch) {
+            const FrustumPlanes* planes = nullptr;
+            if (arch.HasComponent<MeshData>()) {
+                planes = hasPlanes3D_ ? &planes3D_ : nullptr;
+            } else if (arch.HasComponent<SpriteData>()) {
+                planes = hasPlanes2D_ ? &planes2D_ : nullptr;
+            }
+            if (!planes) return;
+
+            const size_t boundsIndex = arch.GetComponentIndex<WorldRenderBoundsData>();
+            const auto& metas = arch.GetChunkMetas();
+            auto& culls = results_[&arch];
+            if (culls.size() < metas.size()) {
+                culls.resize(metas.size());
+            }
+
+            for (size_t ci = 0; ci < metas.size(); ++ci) {
+                const uint16_t count = metas[ci].count;
+                if (count == 0) continue;
+
+                ChunkWork work;
+                work.cull = &culls[ci];
+                work.bounds = arch.GetComponentArray<WorldRenderBoundsData>(ci);
+                work.chunk = arch.GetChunk(ci);
+                work.planes = planes;
+                work.version = arch.GetComponentVersion(ci, boundsIndex);
+                work.count = count;
+                work_.push_back(work);
+                workCosts_.push_back(count);
+                stats_.testedCount += count;
+            }
+        });
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1 Chunkを判定
+    //------------------------------------------------------------------------
+    void CullChunk(const ChunkWork& work) {
+        ChunkCull& cull = *work.cull;
+        const uint32_t wordCount = (work.count + 63u) / 64u;
+        cull.mask.resize(wordCount);
+        cull.frame = cullFrame_;
+
+        // 包含AABBの更新（書き込み・Actor数・Chunk実体が変わった時のみ）
+        if (cull.chunk != work.chunk || cull.boundsVersion != work.version || cull.boundsCount != work.count) {
+            cull.chunkBounds = Culling::ComputeUnion(work.bounds, work.count);
+            cull.hasInvalid = false;
+            for (uint16_t i = 0; i < work.count; ++i) {
+                if (!work.bounds[i].IsValid()) {
+                    cull.hasInvalid = true;
+                    break;
+                }
+            }
+            cull.chunk = work.chunk;
+            cull.boundsVersion = work.version;
+            cull.boundsCount = work.count;
+        }
+
+        const FrustumTest chunkTest = Culling::Classify(cull.chunkBounds, *work.planes);
+        if (chunkTest == FrustumTest::Outside) {
+            std::fill(cull.mask.begin(), cull.mask.end(), uint64_t{0});
+            cull.visibleCount = 0;
+            rejectedChunks_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (chunkTest == FrustumTest::Inside && !cull.hasInvalid) {
+            // 末尾ワードは要素数分のビットのみ立てる
+            std::fill(cull.mask.begin(), cull.mask.end(), ~uint64_t{0});
+            const uint32_t tail = work.count % 64u;
+            if (tail != 0) {
+                cull.mask.back() = (uint64_t{1} << tail) - 1;
+            }
+            cull.visibleCount = work.count;
+            acceptedChunks_.fetch_add(1, std::memory_order_relaxed);
+            visibleCount_.fetch_add(work.count, std::memory_order_relaxed);
+            return;
+        }
+
+        cull.visibleCount = Culling::CullBounds(work.bounds, work.count, *work.planes, cull.mask.data());
+        visibleCount_.fetch_add(cull.visibleCount, std::memory_order_relaxed);
+    }
+
+    std::unordered_map<const Archetype*, std::vector<ChunkCull>> results_;  //!< Archetype別のChunk判定結果
+    std::vector<ChunkWork> work_;                   //!< 今フレームの判定対象Chunk
+    std::vector<uint32_t> workCosts_;               //!< 判定対象ChunkのActor数（分割のコストヒント）
+    FrustumPlanes planes3D_;                        //!< 3Dカメラの視錐台
+    FrustumPlanes planes2D_;                        //!< 2Dカメラの視錐台（near/farなし）
+    FrustumPlanes overridePlanes_;                  //!< 明示指定された視錐台
+    bool hasPlanes3D_ = false;
+    bool hasPlanes2D_ = false;
+    bool hasOverride_ = false;
+    uint32_t cullFrame_ = 0;                        //!< 判定回数（結果の鮮度確認用）
+    std::atomic<uint32_t> visibleCount_{0};
+    std::atomic<uint32_t> rejectedChunks_{0};
+    std::atomic<uint32_t> acceptedChunks_{0};
+    Stats stats_;
+};
+
+} // namespace ECS
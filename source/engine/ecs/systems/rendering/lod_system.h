@@ -26,6 +26,9 @@ namespace ECS {
 //! カメラからの距離に基づいてvisibleフラグを制御する。
 //! LODRangeDataの範囲外のオブジェクトは非表示になる。
 //!
+//! カメラが前回から動いていなければ、LODRangeDataまたはLocalToWorldが
+//! 前回実行以降に変更されたChunkのみ再判定する。
+//!
 //! @note 優先度14（RenderBoundsUpdateSystemの後）
 //!
 //! 使用例:
@@ -53,10 +56,10 @@ public:
         // 3Dアクティブカメラの位置を取得（最初のカメラのみ使用）
         Vector3 cameraPos3D = Vector3::Zero;
         bool hasCamera3D = false;
-        world.ForEach<Camera3DData, ActiveCameraTag>(
+        world.ForEach<In<Camera3DData>, In<ActiveCameraTag>>(
             [&cameraPos3D, &hasCamera3D]([[maybe_unused]] Actor actor,
                                           const Camera3DData& cam,
-                                          [[maybe_unused]] ActiveCameraTag& tag) {
+                                          [[maybe_unused]] const ActiveCameraTag& tag) {
                 if (!hasCamera3D) {  // 最初のカメラのみ
                     cameraPos3D = cam.position;
                     hasCamera3D = true;
@@ -66,10 +69,10 @@ public:
         // 2Dアクティブカメラの位置を取得（最初のカメラのみ使用）
         Vector2 cameraPos2D = Vector2::Zero;
         bool hasCamera2D = false;
-        world.ForEach<Camera2DData, ActiveCameraTag>(
+        world.ForEach<In<Camera2DData>, In<ActiveCameraTag>>(
             [&cameraPos2D, &hasCamera2D]([[maybe_unused]] Actor actor,
                                           const Camera2DData& cam,
-                                          [[maybe_unused]] ActiveCameraTag& tag) {
+                                          [[maybe_unused]] const ActiveCameraTag& tag) {
                 if (!hasCamera2D) {  // 最初のカメラのみ
                     cameraPos2D = cam.position;
                     hasCamera2D = true;
@@ -78,26 +81,53 @@ public:
 
         // 3Dメッシュの距離判定
         if (hasCamera3D) {
-            world.ForEach<LODRangeData, LocalToWorld, MeshData>(
-                [&cameraPos3D](Actor, const LODRangeData& lod, const LocalToWorld& ltw, MeshData& mesh) {
-                    float distance = Vector3::Distance(ltw.GetPosition(), cameraPos3D);
-                    mesh.visible = lod.IsInRange(distance);
-                });
+            auto update = [&cameraPos3D](Actor, const LODRangeData& lod, const LocalToWorld& ltw, MeshData& mesh) {
+                float distance = Vector3::Distance(ltw.GetPosition(), cameraPos3D);
+                mesh.visible = lod.IsInRange(distance);
+            };
+            // カメラが動いた場合は全Chunk、そうでなければ入力が変更されたChunkのみ
+            if (!lastCamera3D_.valid || lastCamera3D_.position != cameraPos3D) {
+                world.ForEach<In<LODRangeData>, In<LocalToWorld>, InOut<MeshData>>(update);
+            } else {
+                world.ForEach<Changed<In<LODRangeData>>, Changed<In<LocalToWorld>>, InOut<MeshData>>(update);
+            }
         }
+        lastCamera3D_ = {cameraPos3D, hasCamera3D};
 
         // 2Dスプライトの距離判定
         if (hasCamera2D) {
-            world.ForEach<LODRangeData, LocalToWorld, SpriteData>(
-                [&cameraPos2D](Actor, const LODRangeData& lod, const LocalToWorld& ltw, SpriteData& sprite) {
-                    Vector2 pos2D = ltw.GetPosition2D();
-                    float distance = Vector2::Distance(pos2D, cameraPos2D);
-                    sprite.visible = lod.IsInRange(distance);
-                });
+            auto update = [&cameraPos2D](Actor, const LODRangeData& lod, const LocalToWorld& ltw, SpriteData& sprite) {
+                Vector2 pos2D = ltw.GetPosition2D();
+                float distance = Vector2::Distance(pos2D, cameraPos2D);
+                sprite.visible = lod.IsInRange(distance);
+            };
+            if (!lastCamera2D_.valid || lastCamera2D_.position != cameraPos2D) {
+                world.ForEach<In<LODRangeData>, In<LocalToWorld>, InOut<SpriteData>>(update);
+            } else {
+                world.ForEach<Changed<In<LODRangeData>>, Changed<In<LocalToWorld>>, InOut<SpriteData>>(update);
+            }
         }
+        lastCamera2D_ = {cameraPos2D, hasCamera2D};
     }
 
     int Priority() const override { return 14; }
     const char* Name() const override { return "LODSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<Camera3DData, Camera2DData, ActiveCameraTag, LODRangeData, LocalToWorld>()
+              .Write<MeshData, SpriteData>();
+    }
+
+private:
+    //! @brief 前回判定に使用したカメラ位置
+    template<typename Vec>
+    struct CameraSnapshot {
+        Vec position{};
+        bool valid = false;
+    };
+
+    CameraSnapshot<Vector3> lastCamera3D_;
+    CameraSnapshot<Vector2> lastCamera2D_;
 };
 
 } // namespace ECS
@@ -9,6 +9,7 @@
 #include "engine/ecs/world.h"
 #include "engine/ecs/components/transform/transform_components.h"
 #include "engine/ecs/components/rendering/mesh_data.h"
+#include "engine/ecs/systems/rendering/frustum_culling_system.h"
 #include "engine/graphics/mesh_batch.h"
 
 namespace ECS {
@@ -19,40 +20,40 @@ namespace ECS {
 //! 入力: LocalToWorld, MeshData（読み取り専用）
 //! 出力: GPU (MeshBatch)
 //!
+//! FrustumCullingSystemが登録されていれば、その可視ビットマスクで
+//! 視錐台外のエンティティを除外する。
+//!
 //! @note 優先度10（スプライトより後）
 //============================================================================
 class MeshRenderSystem final : public IRenderSystem {
 public:
     void OnRender(World& world, [[maybe_unused]] float alpha) override {
         auto& batch = MeshBatch::Get();
+        const FrustumCullingSystem* culling = world.GetRenderSystem<FrustumCullingSystem>();
 
         batch.Begin();
 
-        // LocalToWorldとMeshDataを持つ全エンティティを描画
-        world.ForEach<LocalToWorld, MeshData>(
-            [&batch](Actor, LocalToWorld& ltw, MeshData& mesh) {
-                // 非表示はスキップ
-                if (!mesh.visible) {
-                    return;
-                }
-
-                // 無効なメッシュはスキップ
-                if (!mesh.mesh.IsValid()) {
-                    return;
-                }
+        // LocalToWorldとMeshDataを持つ全Chunkを走査し、可視なエンティティを描画
+        world.GetArchetypeStorage().ForEachMatching<LocalToWorld, MeshData>(
+            [&batch, culling](Archetype& arch) {
+                const auto& metas = arch.GetChunkMetas();
+                for (size_t ci = 0; ci < metas.size(); ++ci) {
+                    const uint16_t count = metas[ci].count;
+                    if (count == 0) continue;
+
+                    // カリングで全要素が棄却されたChunkはスキップ
+                    const uint64_t* mask = nullptr;
+                    if (culling) {
+                        if (!culling->AnyVisible(arch, ci)) continue;
+                        mask = culling->GetVisibilityMask(arch, ci);
+                    }
 
-                // マテリアルを取得して描画
-                if (mesh.materialCount > 1) {
-                    // 複数マテリアル
-                    std::vector<MaterialHandle> mats;
-                    mats.reserve(mesh.materialCount);
-                    for (uint8_t i = 0; i < mesh.materialCount; ++i) {
-                        mats.push_back(mesh.materials[i]);
+                    const LocalToWorld* ltw = arch.GetComponentArray<LocalToWorld>(ci);
+                    const MeshData* meshes = arch.GetComponentArray<MeshData>(ci);
+                    for (uint16_t i = 0; i < count; ++i) {
+                        if (!FrustumCullingSystem::IsVisible(mask, i)) continue;
+                        DrawMesh(batch, ltw[i], meshes[i]);
                     }
-                    batch.Draw(mesh.mesh, mats, ltw.value);
-                } else {
-                    // 単一マテリアル
-                    batch.Draw(mesh.mesh, mesh.GetMaterial(), ltw.value);
                 }
             });
 
@@ -61,6 +62,34 @@ public:
 
     int Priority() const override { return 10; }
     const char* Name() const override { return "MeshRenderSystem"; }
+
+private:
+    //! @brief 1エンティティを描画
+    static void DrawMesh(MeshBatch& batch, const LocalToWorld& ltw, const MeshData& mesh) {
+        // 非表示はスキップ
+        if (!mesh.visible) {
+            return;
+        }
+
+        // 無効なメッシュはスキップ
+        if (!mesh.mesh.IsValid()) {
+            return;
+        }
+
+        // マテリアルを取得して描画
+        if (mesh.materialCount > 1) {
+            // 複数マテリアル
+            std::vector<MaterialHandle> mats;
+            mats.reserve(mesh.materialCount);
+            for (uint8_t i = 0; i < mesh.materialCount; ++i) {
+                mats.push_back(mesh.materials[i]);
+            }
+            batch.Draw(mesh.mesh, mats, ltw.value);
+        } else {
+            // 単一マテリアル
+            batch.Draw(mesh.mesh, mesh.GetMaterial(), ltw.value);
+        }
+    }
 };
 
 //============================================================================
@@ -70,6 +99,7 @@ public:
 //! 出力: GPU (Shadow Pass)
 //!
 //! @note 優先度5
+//! @note 視錐台外のキャスターも影を落とすため、カメラの可視マスクは参照しない
 //============================================================================
 class ShadowRenderSystem final : public IRenderSystem {
 public:
@@ -22,6 +22,9 @@ namespace ECS {
 //! ワールド空間のAABB（WorldRenderBoundsData）を更新する。
 //! 視錐台カリングの準備として使用。
 //!
+//! RenderBoundsDataまたはLocalToWorldが前回実行以降に変更されたChunkのみ更新する。
+//! 静的なオブジェクトのChunkはスキップされ、WorldRenderBoundsDataのバージョンも変わらない。
+//!
 //! @note 優先度12（LocalToWorldSystemの後）
 //!
 //! 使用例:
@@ -42,7 +45,7 @@ namespace ECS {
 class RenderBoundsUpdateSystem final : public ISystem {
 public:
     void OnUpdate(World& world, [[maybe_unused]] float dt) override {
-        world.ForEach<RenderBoundsData, LocalToWorld, WorldRenderBoundsData>(
+        world.ForEach<Changed<In<RenderBoundsData>>, Changed<In<LocalToWorld>>, InOut<WorldRenderBoundsData>>(
             [](Actor, const RenderBoundsData& local, const LocalToWorld& ltw,
                WorldRenderBoundsData& worldBounds) {
                 TransformAABB(local, ltw.value, worldBounds);
@@ -52,6 +55,10 @@ public:
     int Priority() const override { return 12; }
     const char* Name() const override { return "RenderBoundsUpdateSystem"; }
 
+    void DeclareAccess(SystemAccess& access) const override {
+        access.With<In<RenderBoundsData>, In<LocalToWorld>, InOut<WorldRenderBoundsData>>();
+    }
+
 private:
     //------------------------------------------------------------------------
     //! @brief ローカルAABBをワールド空間に変換
@@ -8,4 +8,5 @@
 #include "sprite_render_system.h"
 #include "lighting_system.h"
 #include "render_bounds_update_system.h"
+#include "frustum_culling_system.h"
 #include "lod_system.h"
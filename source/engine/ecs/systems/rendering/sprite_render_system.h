@@ -10,6 +10,7 @@
 #include "engine/ecs/components/transform/transform_components.h"
 #include "engine/ecs/components/rendering/sprite_data.h"
 #include "engine/ecs/components/animation/animator_data.h"
+#include "engine/ecs/systems/rendering/frustum_culling_system.h"
 #include "engine/graphics/sprite_batch.h"
 #include "engine/texture/texture_manager.h"
 
@@ -21,6 +22,9 @@ namespace ECS {
 //! 入力: LocalToWorld, SpriteData（読み取り専用）
 //! 出力: GPU (SpriteBatch)
 //!
+//! FrustumCullingSystemが登録されていれば、その可視ビットマスクで
+//! 画面外のエンティティを除外する。
+//!
 //! @note 優先度0（描画システムの中で最初に実行）
 //============================================================================
 class SpriteRenderSystem final : public IRenderSystem {
@@ -38,83 +42,30 @@ public:
 
         batch.Begin();
 
-        // LocalToWorldとSpriteDataを持つ全エンティティを描画
-        world.ForEach<LocalToWorld, SpriteData>(
-            [&batch, &texMgr, &world](Actor actor, LocalToWorld& ltw, SpriteData& sprite) {
-                // 非表示はスキップ
-                if (!sprite.visible) {
-                    return;
-                }
-
-                // テクスチャ取得
-                Texture* tex = texMgr.Get(sprite.texture);
-                if (!tex) {
-                    return;
-                }
-
-                // 位置を取得（ワールド行列から）
-                Vector2 position = ltw.GetPosition2D();
-
-                // スケールを取得
-                Vector3 scale3D = ltw.GetScale();
-                Vector2 scale(scale3D.x, scale3D.y);
-
-                // Z軸回転を取得（LocalTransformから）
-                float rotationZ = 0.0f;
-                auto* transform = world.GetComponent<LocalTransform>(actor);
-                if (transform) {
-                    rotationZ = transform->GetRotationZ();
-                }
-
-                // サイズが0の場合はテクスチャサイズを使用
-                Vector2 size = sprite.size;
-                if (size.x <= 0.0f || size.y <= 0.0f) {
-                    size.x = static_cast<float>(tex->GetWidth());
-                    size.y = static_cast<float>(tex->GetHeight());
-                }
-
-                // スケールを適用
-                Vector2 finalScale(scale.x, scale.y);
-                if (size.x > 0.0f && size.y > 0.0f) {
-                    finalScale.x *= size.x / static_cast<float>(tex->GetWidth());
-                    finalScale.y *= size.y / static_cast<float>(tex->GetHeight());
-                }
-
-                // UV座標からソース矩形を計算
-                if (sprite.uvOffset != Vector2::Zero || sprite.uvSize != Vector2::One) {
-                    Vector4 sourceRect(
-                        sprite.uvOffset.x * static_cast<float>(tex->GetWidth()),
-                        sprite.uvOffset.y * static_cast<float>(tex->GetHeight()),
-                        sprite.uvSize.x * static_cast<float>(tex->GetWidth()),
-                        sprite.uvSize.y * static_cast<float>(tex->GetHeight())
-                    );
-
-                    batch.Draw(
-                        tex,
-                        position,
-                        sourceRect,
-                        sprite.color,
-                        rotationZ,
-                        sprite.pivot,
-                        finalScale,
-                        sprite.flipX,
-                        sprite.flipY,
-                        sprite.sortingLayer,
-                        sprite.orderInLayer
-                    );
-                } else {
-                    batch.Draw(
-                        tex,
-                        position,
-                        sprite.color,
-                        rotationZ,
-                        sprite.pivot,
-                        finalScale,
-                        sprite.flipX,
-                        sprite.flipY,
-                        sprite.sortingLayer,
-                        sprite.orderInLayer
-                    );
+        const FrustumCullingSystem* culling = world.GetRenderSystem<FrustumCullingSystem>();
+
+        // LocalToWorldとSpriteDataを持つ全Chunkを走査し、可視なエンティティを描画
+        world.GetArchetypeStorage().ForEachMatching<LocalToWorld, SpriteData>(
+            [&batch, &texMgr, &world, culling](Archetype& arch) {
+                const auto& metas = arch.GetChunkMetas();
+                for (size_t ci = 0; ci < metas.size(); ++ci) {
+                    const uint16_t count = metas[ci].count;
+                    if (count == 0) continue;
+
+                    // カリングで全要素が棄却されたChunkはスキップ
+                    const uint64_t* mask = nullptr;
+                    if (culling) {
+                        if (!culling->AnyVisible(arch, ci)) continue;
+                        mask = culling->GetVisibilityMask(arch, ci);
+                    }
+
+                    const Actor* actors = arch.GetActorArray(ci);
+                    const LocalToWorld* ltw = arch.GetComponentArray<LocalToWorld>(ci);
+                    const SpriteData* sprites = arch.GetComponentArray<SpriteData>(ci);
+                    for (uint16_t i = 0; i < count; ++i) {
+                        if (!FrustumCullingSystem::IsVisible(mask, i)) continue;
+                        DrawSprite(batch, texMgr, world, actors[i], ltw[i], sprites[i]);
+                    }
                 }
             });
 
@@ -123,6 +74,87 @@ public:
 
     int Priority() const override { return 0; }
     const char* Name() const override { return "SpriteRenderSystem"; }
+
+private:
+    //! @brief 1エンティティを描画
+    static void DrawSprite(SpriteBatch& batch, TextureManager& texMgr, World& world,
+                           Actor actor, const LocalToWorld& ltw, const SpriteData& sprite) {
+        // 非表示はスキップ
+        if (!sprite.visible) {
+            return;
+        }
+
+        // テクスチャ取得
+        Texture* tex = texMgr.Get(sprite.texture);
+        if (!tex) {
+            return;
+        }
+
+        // 位置を取得（ワールド行列から）
+        Vector2 position = ltw.GetPosition2D();
+
+        // スケールを取得
+        Vector3 scale3D = ltw.GetScale();
+        Vector2 scale(scale3D.x, scale3D.y);
+
+        // Z軸回転を取得（LocalTransformから）
+        float rotationZ = 0.0f;
+        auto* transform = world.GetComponent<LocalTransform>(actor);
+        if (transform) {
+            rotationZ = transform->GetRotationZ();
+        }
+
+        // サイズが0の場合はテクスチャサイズを使用
+        Vector2 size = sprite.size;
+        if (size.x <= 0.0f || size.y <= 0.0f) {
+            size.x = static_cast<float>(tex->GetWidth());
+            size.y = static_cast<float>(tex->GetHeight());
+        }
+
+        // スケールを適用
+        Vector2 finalScale(scale.x, scale.y);
+        if (size.x > 0.0f && size.y > 0.0f) {
+            finalScale.x *= size.x / static_cast<float>(tex->GetWidth());
+            finalScale.y *= size.y / static_cast<float>(tex->GetHeight());
+        }
+
+        // UV座標からソース矩形を計算
+        if (sprite.uvOffset != Vector2::Zero || sprite.uvSize != Vector2::One) {
+            Vector4 sourceRect(
+                sprite.uvOffset.x * static_cast<float>(tex->GetWidth()),
+                sprite.uvOffset.y * static_cast<float>(tex->GetHeight()),
+                sprite.uvSize.x * static_cast<float>(tex->GetWidth()),
+                sprite.uvSize.y * static_cast<float>(tex->GetHeight())
+            );
+
+            batch.Draw(
+                tex,
+                position,
+                sourceRect,
+                sprite.color,
+                rotationZ,
+                sprite.pivot,
+                finalScale,
+                sprite.flipX,
+                sprite.flipY,
+                sprite.sortingLayer,
+                sprite.orderInLayer
+            );
+        } else {
+            batch.Draw(
+                tex,
+                position,
+                sprite.color,
+                rotationZ,
+                sprite.pivot,
+                finalScale,
+                sprite.flipX,
+                sprite.flipY,
+                sprite.sortingLayer,
+                sprite.orderInLayer
+            );
+        }
+    }
 };
 
 } // namespace ECS
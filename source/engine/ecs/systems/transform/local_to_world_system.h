@@ -8,19 +8,37 @@
 #include "engine/ecs/system.h"
 #include "engine/ecs/world.h"
 #include "engine/ecs/components/transform/transform_components.h"
+#include "engine/core/job_system.h"
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace ECS {
 
 //============================================================================
 //! @brief ローカル→ワールド変換システム（変換システム）
 //!
-//! 入力: LocalTransform（読み取り専用）
+//! 入力: LocalTransform, PostTransformMatrix, Parent, HierarchyDepthData（読み取り専用）
 //! 出力: LocalToWorld
 //!
-//! 毎フレーム全エンティティを処理。HierarchyDepthでソートして親→子の順で計算。
+//! 処理の流れ:
+//! 1. LocalToWorldを持つChunkを列挙し、入力コンポーネントのChunkバージョンから
+//!    前回実行（SystemState::lastRunVersion）以降に変更されたChunkを判定する
+//! 2. Parentを持たないArchetype（ルート）は変更されたChunkのみをChunk単位で並列計算
+//! 3. Parentを持つActorはHierarchyDepthDataの深度ごとにまとめ、浅い順に深度内で並列計算。
+//!    自Chunkが未変更でも、親が今回再計算されていれば再計算する（未変更の部分木はスキップ）
+//! 4. 子Chunkごとに親ActorのいるChunkを記録しておき、自Chunkも親Chunkも未変更なら
+//!    Actorを列挙せずChunkごとスキップする（親Chunkの変更は子孫Chunkへ伝播させる）
+//!
+//! 変更判定はフレーム単位のため、変更されたChunkは変更フレームと次のフレームの
+//! 2回計算される（同一フレーム内で後から書き込まれた場合も取りこぼさない）。
+//! SystemStateなしでOnUpdateを直接呼んだ場合は毎回全Chunkを計算する。
 //!
 //! @note 優先度10（更新システムの後）
+//! @note 深度別の並列計算はParentSystemが更新したHierarchyDepthDataに依存する。
+//!       HierarchyDepthDataを持たない子は最後に逐次計算する
 //!
 //! 使用例:
 //! @code
@@ -38,89 +56,393 @@ namespace ECS {
 class LocalToWorldSystem final : public ISystem {
 public:
     void OnUpdate(World& world, [[maybe_unused]] float dt) override {
-        // LocalToWorldを持つ全Actorを収集
-        actors_.clear();
+        ArchetypeStorage& storage = world.GetArchetypeStorage();
+        writeVersion_ = storage.GetWriteVersion();
+        sinceVersion_ = SystemAPI::LastRunVersion();
+        recomputedCount_.store(0, std::memory_order_relaxed);
 
-        world.ForEach<LocalToWorld>([this](Actor actor, LocalToWorld&) {
-            actors_.push_back(actor);
-        });
+        CollectChunks(world, storage);
+        recomputed_.assign(maxActorIndex_ + 1, 0);
+        UpdateRoots();
+        UpdateChildren(world);
+    }
 
-        if (actors_.empty()) return;
+    int Priority() const override { return 10; }
+    const char* Name() const override { return "LocalToWorldSystem"; }
 
-        // HierarchyDepthでソート（親→子の順）
-        SortByDepth(world);
+    void DeclareAccess(SystemAccess& access) const override {
+        access.Read<LocalTransform, PostTransformMatrix, Parent, HierarchyDepthData>()
+              .Write<LocalToWorld>();
+    }
 
-        // ソート順でLocalToWorld行列を計算
-        for (Actor actor : actors_) {
-            ComputeLocalToWorld(world, actor);
+    //! @brief 直前の更新で再計算したActor数（スキップされたActorは含まない）
+    [[nodiscard]] uint32_t GetLastRecomputedCount() const noexcept {
+        return recomputedCount_.load(std::memory_order_relaxed);
+    }
+
+    //! @brief 直前の更新で走査した子Actor数（スキップされた子Chunkは含まない）
+    [[nodiscard]] uint32_t GetLastVisitedChildCount() const noexcept {
+        size_t count = unorderedChildren_.size();
+        for (const auto& level : levels_) {
+            count += level.size();
         }
+        return static_cast<uint32_t>(count);
+    }
+
+    //! @brief 親Chunkの記録を保持している子Chunk数
+    [[nodiscard]] size_t GetCachedParentChunkCount() const noexcept {
+        return parentChunks_.size();
     }
 
 private:
+    //! ルートChunkを並列計算する最小Chunk数
+    static constexpr uint32_t kMinParallelChunks = 2;
+
+    //! 1深度内の子を並列計算する最小Actor数
+    static constexpr uint32_t kMinParallelChildren = 512;
+
+    //! 子の並列計算の分割粒度
+    static constexpr uint32_t kChildGranularity = 128;
+
+    //------------------------------------------------------------------------
+    //! @brief 処理対象Chunk（Archetypeごとに1度だけ列インデックスを解決）
+    //------------------------------------------------------------------------
+    struct ChunkRef {
+        Archetype* arch = nullptr;
+        uint32_t chunkIndex = 0;
+        uint16_t count = 0;
+        bool dirty = false;                         //!< 入力が前回実行以降に変更された
+        bool ltwChanged = false;                    //!< LocalToWorldまたはChunk構成が前回実行以降に変更された
+        bool affected = false;                      //!< 自身か祖先が今回再計算され得る（子Chunkを列挙する）
+        size_t ltwIndex = SIZE_MAX;                 //!< LocalToWorldの列インデックス
+        const Actor* actors = nullptr;
+        LocalToWorld* ltw = nullptr;
+        const LocalTransform* local = nullptr;      //!< nullptrなら単位行列
+        const PostTransformMatrix* post = nullptr;
+        const Parent* parent = nullptr;             //!< nullptrならルートChunk
+        const HierarchyDepthData* depth = nullptr;
+    };
+
+    //! @brief 子Actorの参照（chunks_のインデックス + Chunk内インデックス）
+    struct ChildRef {
+        uint32_t chunk;
+        uint16_t index;
+    };
+
+    //! @brief Chunkの識別子（Archetype + Chunkインデックス。フレームをまたいで有効）
+    struct ChunkKey {
+        const Archetype* arch = nullptr;
+        uint32_t chunkIndex = 0;
+
+        bool operator==(const ChunkKey&) const noexcept = default;
+    };
+
+    struct ChunkKeyHash {
+        size_t operator()(const ChunkKey& key) const noexcept {
+            return std::hash<const Archetype*>{}(key.arch) ^ (static_cast<size_t>(key.chunkIndex) * 0x9E3779B9u);
+        }
+    };
+
+    //! @brief 子Chunkの親Actorが属するChunk（子Chunkと親Chunkが未変更の間は再利用）
+    struct ParentChunks {
+        std::vector<ChunkKey> chunks;
+        bool unresolved = true;                     //!< 未記録、または親が破棄済み・LocalToWorldなし
+    };
+
     //------------------------------------------------------------------------
-    //! @brief HierarchyDepthでソート
+    //! @brief LocalToWorldを持つChunkを列挙し、ルートと深度別の子に振り分け
     //------------------------------------------------------------------------
-    void SortByDepth(World& world) {
-        std::sort(actors_.begin(), actors_.end(),
-            [&world](Actor a, Actor b) {
-                auto* depthA = world.GetComponent<HierarchyDepthData>(a);
-                auto* depthB = world.GetComponent<HierarchyDepthData>(b);
-                uint16_t dA = depthA ? depthA->depth : 0;
-                uint16_t dB = depthB ? depthB->depth : 0;
-                return dA < dB;
+    void CollectChunks(const World& world, ArchetypeStorage& storage) {
+        chunks_.clear();
+        chunkLookup_.clear();
+        childChunks_.clear();
+        rootChunks_.clear();
+        rootCosts_.clear();
+        unorderedChildren_.clear();
+        maxActorIndex_ = 0;
+        for (auto& level : levels_) {
+            level.clear();
+        }
+
+        storage.ForEachMatching<LocalToWorld>([this](Archetype& arch) {
+            const size_t ltwIndex = arch.GetComponentIndex<LocalToWorld>();
+            const size_t localIndex = arch.GetComponentIndex<LocalTransform>();
+            const size_t postIndex = arch.GetComponentIndex<PostTransformMatrix>();
+            const size_t parentIndex = arch.GetComponentIndex<Parent>();
+            const auto& metas = arch.GetChunkMetas();
+
+            for (size_t ci = 0; ci < metas.size(); ++ci) {
+                const uint16_t count = metas[ci].count;
+                if (count == 0) continue;
+
+                ChunkRef ref;
+                ref.arch = &arch;
+                ref.chunkIndex = static_cast<uint32_t>(ci);
+                ref.count = count;
+                ref.ltwIndex = ltwIndex;
+                ref.actors = arch.GetActorArray(ci);
+                ref.ltw = arch.GetComponentArray<LocalToWorld>(ci);
+                ref.local = arch.GetComponentArray<LocalTransform>(ci);
+                ref.post = arch.GetComponentArray<PostTransformMatrix>(ci);
+                ref.parent = arch.GetComponentArray<Parent>(ci);
+                ref.depth = arch.GetComponentArray<HierarchyDepthData>(ci);
+
+                // LocalTransformがないChunkは変更を検出できないため常に計算（単位行列のみ）
+                ref.dirty = localIndex == SIZE_MAX ||
+                            arch.DidChange(ci, localIndex, sinceVersion_) ||
+                            arch.DidChange(ci, postIndex, sinceVersion_) ||
+                            arch.DidChange(ci, parentIndex, sinceVersion_);
+                // Actorの追加・削除もChunk全体の書き込みとして記録される
+                ref.ltwChanged = arch.DidChange(ci, ltwIndex, sinceVersion_);
+                ref.affected = ref.dirty;
+
+                const uint32_t chunkRef = static_cast<uint32_t>(chunks_.size());
+                chunks_.push_back(ref);
+                chunkLookup_.emplace(ChunkKey{&arch, ref.chunkIndex}, chunkRef);
+
+                if (ref.parent) {
+                    childChunks_.push_back(chunkRef);
+                } else if (ref.dirty) {
+                    rootChunks_.push_back(chunkRef);
+                    rootCosts_.push_back(count);
+                    UpdateMaxActorIndex(ref);
+                }
+            }
+        });
+
+        ResolveAffectedChildChunks(world);
+
+        for (uint32_t chunkRef : childChunks_) {
+            const ChunkRef& ref = chunks_[chunkRef];
+            if (!ref.affected) continue;
+
+            UpdateMaxActorIndex(ref);
+            for (uint16_t i = 0; i < ref.count; ++i) {
+                AddChild(ref, ChildRef{chunkRef, i});
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 子Chunkのうち、自身か祖先が今回再計算され得るものを判定
+    //!
+    //! 記録済みの親Chunkがすべて未変更なら親Chunkの記録を再利用し、
+    //! そうでなければChunk内の親Actorから記録し直す。
+    //! その後、再計算され得る親Chunkを持つ子Chunkへ判定を伝播させる。
+    //------------------------------------------------------------------------
+    void ResolveAffectedChildChunks(const World& world) {
+        childParents_.clear();
+        for (uint32_t chunkRef : childChunks_) {
+            ChunkRef& ref = chunks_[chunkRef];
+            ParentChunks& parents = parentChunks_[ChunkKey{ref.arch, ref.chunkIndex}];
+            if (!ref.affected && !parents.unresolved) {
+                for (const ChunkKey& key : parents.chunks) {
+                    const auto it = chunkLookup_.find(key);
+                    if (it == chunkLookup_.end() || chunks_[it->second].ltwChanged) {
+                        ref.affected = true;
+                        break;
+                    }
+                }
+            }
+            if (ref.affected || parents.unresolved) {
+                RecordParentChunks(world, ref, parents);
+                ref.affected = true;
+            }
+            childParents_.push_back(&parents);
+        }
+
+        // 今回走査しなかった子Chunk（空になった・消えたChunk）の記録を捨てる
+        // 今回の子Chunkは必ず記録を持つため、件数が一致していれば古い記録はない
+        // （他要素のeraseでは childParents_ のポインタは無効にならない）
+        if (parentChunks_.size() > childChunks_.size()) {
+            std::erase_if(parentChunks_, [this](const auto& entry) {
+                const auto it = chunkLookup_.find(entry.first);
+                return it == chunkLookup_.end() || !chunks_[it->second].parent;
             });
+        }
+
+        // 親Chunkの再計算を子孫Chunkへ伝播（Chunk単位の親子関係は深度順とは限らないため収束まで繰り返す）
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t i = 0; i < childChunks_.size(); ++i) {
+                ChunkRef& ref = chunks_[childChunks_[i]];
+                if (ref.affected) continue;
+                for (const ChunkKey& key : childParents_[i]->chunks) {
+                    if (chunks_[chunkLookup_.find(key)->second].affected) {
+                        ref.affected = true;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    //! @brief Chunk内の親Actorが属するChunkを記録
+    static void RecordParentChunks(const World& world, const ChunkRef& ref, ParentChunks& parents) {
+        parents.chunks.clear();
+        parents.unresolved = false;
+        for (uint16_t i = 0; i < ref.count; ++i) {
+            const Parent& parent = ref.parent[i];
+            if (!parent.HasParent()) continue;
+
+            // 親の破棄やLocalToWorldなしはChunkの変更に現れないため、毎回再計算する
+            const ActorRecord* rec = world.IsAlive(parent.value) ? &world.GetActorRecord(parent.value) : nullptr;
+            if (!rec || !rec->archetype || !rec->archetype->HasComponent<LocalToWorld>()) {
+                parents.unresolved = true;
+                continue;
+            }
+            const ChunkKey key{rec->archetype, rec->chunkIndex};
+            if (std::find(parents.chunks.begin(), parents.chunks.end(), key) == parents.chunks.end()) {
+                parents.chunks.push_back(key);
+            }
+        }
+    }
+
+    //! @brief 子Actorを深度別のリストに追加
+    void AddChild(const ChunkRef& ref, ChildRef child) {
+        size_t level = 0;
+        if (ref.parent[child.index].HasParent()) {
+            if (!ref.depth) {
+                unorderedChildren_.push_back(child);
+                return;
+            }
+            level = ref.depth[child.index].depth;
+        }
+        if (level >= levels_.size()) {
+            levels_.resize(level + 1);
+        }
+        levels_[level].push_back(child);
     }
 
+    //! @brief 再計算フラグ配列の大きさを決めるため、Actorインデックスの最大値を更新
+    void UpdateMaxActorIndex(const ChunkRef& ref) noexcept {
+        for (uint16_t i = 0; i < ref.count; ++i) {
+            maxActorIndex_ = (std::max)(maxActorIndex_, ref.actors[i].Index());
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief ルートChunkを計算（Chunk単位で並列）
     //------------------------------------------------------------------------
-    //! @brief LocalToWorld行列を計算
+    void UpdateRoots() {
+        const uint32_t count = static_cast<uint32_t>(rootChunks_.size());
+        RunParallelRange(count, kMinParallelChunks, MakeChunkParallelForDesc(rootCosts_),
+            [this](uint32_t begin, uint32_t end) {
+                uint32_t recomputed = 0;
+                for (uint32_t i = begin; i < end; ++i) {
+                    const ChunkRef& ref = chunks_[rootChunks_[i]];
+                    for (uint16_t j = 0; j < ref.count; ++j) {
+                        ref.ltw[j].value = ComputeLocalMatrix(ref, j);
+                        recomputed_[ref.actors[j].Index()] = 1;
+                    }
+                    ref.arch->MarkComponentWritten(ref.chunkIndex, ref.ltwIndex, writeVersion_);
+                    recomputed += ref.count;
+                }
+                recomputedCount_.fetch_add(recomputed, std::memory_order_relaxed);
+            });
+    }
+
     //------------------------------------------------------------------------
-    void ComputeLocalToWorld(World& world, Actor actor) {
-        auto* ltw = world.GetComponent<LocalToWorld>(actor);
-        if (!ltw) return;
-
-        // ローカル行列を計算
-        Matrix localMatrix = ComputeLocalMatrix(world, actor);
-
-        // PostTransformMatrix があれば適用
-        auto* postTransform = world.GetComponent<PostTransformMatrix>(actor);
-        if (postTransform) {
-            localMatrix = localMatrix * postTransform->value;
-        }
-
-        // 親のLocalToWorldを取得して乗算
-        auto* parentData = world.GetComponent<Parent>(actor);
-        if (parentData && parentData->HasParent() && world.IsAlive(parentData->value)) {
-            auto* parentLtw = world.GetComponent<LocalToWorld>(parentData->value);
-            if (parentLtw) {
-                ltw->value = localMatrix * parentLtw->value;
-            } else {
-                ltw->value = localMatrix;
+    //! @brief 子を深度順に計算（同一深度内は並列）
+    //------------------------------------------------------------------------
+    void UpdateChildren(const World& world) {
+        const ParallelForDesc desc = ParallelForDesc()
+            .SetPartition(ParallelForPartition::Dynamic)
+            .SetGranularity(kChildGranularity);
+
+        for (const auto& level : levels_) {
+            RunParallelRange(static_cast<uint32_t>(level.size()), kMinParallelChildren, desc,
+                [this, &world, &level](uint32_t begin, uint32_t end) {
+                    UpdateChildRange(world, level, begin, end);
+                });
+        }
+
+        // 深度不明の子は順序を保証できないため逐次計算
+        UpdateChildRange(world, unorderedChildren_, 0, static_cast<uint32_t>(unorderedChildren_.size()));
+    }
+
+    void UpdateChildRange(const World& world, const std::vector<ChildRef>& children,
+                          uint32_t begin, uint32_t end) {
+        uint32_t recomputed = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            if (UpdateChild(world, children[i])) {
+                ++recomputed;
             }
-        } else {
-            ltw->value = localMatrix;
         }
+        recomputedCount_.fetch_add(recomputed, std::memory_order_relaxed);
     }
 
     //------------------------------------------------------------------------
-    //! @brief ローカル行列を計算
+    //! @brief 子のLocalToWorldを計算
+    //! @return 再計算した場合true
     //------------------------------------------------------------------------
-    [[nodiscard]] Matrix ComputeLocalMatrix(World& world, Actor actor) const {
-        auto* transform = world.GetComponent<LocalTransform>(actor);
+    bool UpdateChild(const World& world, ChildRef child) {
+        const ChunkRef& ref = chunks_[child.chunk];
+        const Parent& parent = ref.parent[child.index];
 
-        if (transform) {
-            return transform->ToMatrix();
+        bool dirty = ref.dirty;
+        const LocalToWorld* parentLtw = nullptr;
+        if (parent.HasParent()) {
+            parentLtw = FindParentLocalToWorld(world, parent.value);
+            // 親の破棄やLocalToWorld削除は自Chunkのバージョンに現れないため常に再計算
+            dirty = dirty || !parentLtw || WasRecomputed(parent.value);
+        }
+        if (!dirty) {
+            return false;
         }
 
-        // LocalTransformがない場合は単位行列
-        return Matrix::Identity;
+        const Matrix localMatrix = ComputeLocalMatrix(ref, child.index);
+        ref.ltw[child.index].value = parentLtw ? localMatrix * parentLtw->value : localMatrix;
+        ref.arch->MarkComponentWritten(ref.chunkIndex, ref.ltwIndex, writeVersion_);
+        recomputed_[ref.actors[child.index].Index()] = 1;
+        return true;
     }
 
-public:
-    int Priority() const override { return 10; }
-    const char* Name() const override { return "LocalToWorldSystem"; }
+    //! @brief 今回の更新で再計算されたか（親は必ず前の深度で処理済み）
+    [[nodiscard]] bool WasRecomputed(Actor actor) const noexcept {
+        const uint32_t index = actor.Index();
+        return index < recomputed_.size() && recomputed_[index] != 0;
+    }
 
-private:
-    std::vector<Actor> actors_;   //!< 処理対象Actor
+    //! @brief 親のLocalToWorldを取得
+    [[nodiscard]] static const LocalToWorld* FindParentLocalToWorld(const World& world, Actor parent) {
+        if (!world.IsAlive(parent)) {
+            return nullptr;
+        }
+        const ActorRecord& rec = world.GetActorRecord(parent);
+        const Archetype* arch = rec.archetype;
+        if (!arch) {
+            return nullptr;
+        }
+        return arch->GetComponent<LocalToWorld>(rec.chunkIndex, rec.indexInChunk);
+    }
+
+    //! @brief ローカル行列（PostTransformMatrixがあれば適用）
+    [[nodiscard]] static Matrix ComputeLocalMatrix(const ChunkRef& ref, uint16_t index) {
+        // LocalTransformがない場合は単位行列
+        Matrix localMatrix = ref.local ? ref.local[index].ToMatrix() : Matrix::Identity;
+        if (ref.post) {
+            localMatrix = localMatrix * ref.post[index].value;
+        }
+        return localMatrix;
+    }
+
+    std::vector<ChunkRef> chunks_;                      //!< LocalToWorldを持つ全Chunk
+    std::unordered_map<ChunkKey, uint32_t, ChunkKeyHash> chunkLookup_;  //!< Chunk → chunks_のインデックス
+    std::vector<uint32_t> childChunks_;                 //!< Parentを持つChunk（chunks_のインデックス）
+    std::vector<ParentChunks*> childParents_;           //!< childChunks_ と同じ並びの親Chunk記録
+    std::unordered_map<ChunkKey, ParentChunks, ChunkKeyHash> parentChunks_;  //!< 子Chunk別の親Chunk（フレームをまたいで保持）
+    std::vector<uint32_t> rootChunks_;                  //!< 再計算するルートChunk
+    std::vector<uint32_t> rootCosts_;                   //!< ルートChunkのActor数（分割のコストヒント）
+    std::vector<std::vector<ChildRef>> levels_;         //!< 深度別の子（[0]は親なしのParent）
+    std::vector<ChildRef> unorderedChildren_;           //!< HierarchyDepthDataを持たない子
+    std::vector<uint8_t> recomputed_;                   //!< Actorインデックス別の今回再計算フラグ
+    uint32_t maxActorIndex_ = 0;                        //!< 再計算し得るActorのインデックス最大値
+    std::atomic<uint32_t> recomputedCount_{0};          //!< 直前の更新で再計算したActor数
+    uint32_t writeVersion_ = 0;                         //!< 今回の書き込みバージョン
+    uint32_t sinceVersion_ = 0;                         //!< 変更判定の基準バージョン（SystemState::lastRunVersion）
 };
 
 } // namespace ECS
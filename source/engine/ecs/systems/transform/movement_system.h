@@ -36,6 +36,10 @@ public:
 
     int Priority() const override { return 5; }
     const char* Name() const override { return "MovementSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.With<InOut<LocalTransform>, In<VelocityData>>();
+    }
 };
 
 } // namespace ECS
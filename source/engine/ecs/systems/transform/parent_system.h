@@ -68,7 +68,7 @@ private:
         // Parent を持つが PreviousParent を持たない Actor を収集
         newParentActors_.clear();
 
-        world.ForEach<Parent>([this, &world](Actor actor, Parent&) {
+        world.ForEach<In<Parent>>([this, &world](Actor actor, const Parent&) {
             if (!world.HasComponent<PreviousParent>(actor)) {
                 newParentActors_.push_back(actor);
             }
@@ -109,8 +109,8 @@ private:
         // 変更された Actor を収集（ForEach 中に変更を避けるため）
         changedActors_.clear();
 
-        world.ForEach<Parent, PreviousParent>(
-            [this](Actor actor, Parent& parent, PreviousParent& prevParent) {
+        world.ForEach<In<Parent>, In<PreviousParent>>(
+            [this](Actor actor, const Parent& parent, const PreviousParent& prevParent) {
                 if (parent.value != prevParent.value) {
                     changedActors_.push_back({actor, prevParent.value, parent.value});
                 }
@@ -142,9 +142,12 @@ private:
     //------------------------------------------------------------------------
     //! @brief HierarchyDepthData を更新
     //! 親をたどってルートからの深度を計算（親の深度が未計算でも正確）
+    //!
+    //! Parentは読み取りのみで走査し、Chunkの変更バージョンを更新しない
+    //! （LocalToWorldSystemが未変更の階層をスキップできるようにする）
     //------------------------------------------------------------------------
     void UpdateHierarchyDepths(World& world) {
-        world.ForEach<Parent, HierarchyDepthData>(
+        world.ForEach<In<Parent>, InOut<HierarchyDepthData>>(
             [&world](Actor, const Parent& parent, HierarchyDepthData& depth) {
                 depth.depth = CalculateDepth(world, parent.value);
             });
@@ -153,13 +156,13 @@ private:
     //------------------------------------------------------------------------
     //! @brief 親をたどって深度を計算
     //------------------------------------------------------------------------
-    static uint16_t CalculateDepth(World& world, Actor actor) {
+    static uint16_t CalculateDepth(const World& world, Actor actor) {
         uint16_t depth = 0;
         Actor current = actor;
 
         while (current.IsValid()) {
             ++depth;
-            auto* parentComp = world.GetComponent<Parent>(current);
+            const auto* parentComp = world.GetComponent<Parent>(current);
             if (!parentComp || !parentComp->HasParent()) {
                 break;
             }
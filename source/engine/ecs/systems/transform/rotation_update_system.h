@@ -44,6 +44,10 @@ public:
 
     int Priority() const override { return 6; }
     const char* Name() const override { return "RotationUpdateSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.With<InOut<LocalTransform>, In<AngularVelocityData>>();
+    }
 };
 
 } // namespace ECS
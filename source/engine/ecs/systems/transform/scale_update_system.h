@@ -42,6 +42,10 @@ public:
 
     int Priority() const override { return 7; }
     const char* Name() const override { return "ScaleUpdateSystem"; }
+
+    void DeclareAccess(SystemAccess& access) const override {
+        access.With<InOut<LocalTransform>, In<ScaleVelocityData>>();
+    }
 };
 
 } // namespace ECS
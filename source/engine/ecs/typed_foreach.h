@@ -80,6 +80,10 @@ struct validate_arg_type<InOut<T>, LambdaArg> {
         !std::is_const_v<std::remove_reference_t<LambdaArg>>;
 };
 
+// Changed<M> → 包んだアクセスモードと同じ
+template<typename M, typename LambdaArg>
+struct validate_arg_type<Changed<M>, LambdaArg> : validate_arg_type<M, LambdaArg> {};
+
 template<typename AccessMode, typename LambdaArg>
 inline constexpr bool validate_arg_type_v = validate_arg_type<AccessMode, LambdaArg>::value;
 
@@ -242,6 +246,30 @@ void MarkWrittenComponents(
     };
 }
 
+//============================================================================
+// 変更フィルタヘルパー
+//============================================================================
+
+//! Changed<T>指定のコンポーネントのいずれかが基準バージョン以降に書き込まれたか
+//! （Changed<T>を含まない場合は常にtrue）
+template<typename... AccessModes>
+[[nodiscard]] bool PassesChangedFilter(
+    const Archetype& arch,
+    size_t chunkIndex,
+    uint32_t sinceVersion) noexcept
+{
+    if constexpr (has_changed_filter_v<AccessModes...>) {
+        return ((is_changed_v<AccessModes> &&
+                 arch.DidChange(chunkIndex, arch.GetComponentIndex<unwrap_access_t<AccessModes>>(),
+                                sinceVersion)) || ...);
+    } else {
+        (void)arch;
+        (void)chunkIndex;
+        (void)sinceVersion;
+        return true;
+    }
+}
+
 //============================================================================
 // 可変長 TypedForEach 実装（SoA対応）
 //============================================================================
@@ -249,12 +277,13 @@ void MarkWrittenComponents(
 //! 可変長テンプレートによるTypedForEach実装（SoA）
 //! 1〜8コンポーネントに対応
 //!
-//! @tparam AccessModes In<T>, Out<T>, InOut<T>の組み合わせ
+//! @tparam AccessModes In<T>, Out<T>, InOut<T>, Changed<M>の組み合わせ
 //! @tparam Func ラムダ型 (Actor, T1&, T2&, ...) -> void
 //! @param archetypes ArchetypeStorage参照
 //! @param func 各エンティティに対して呼び出す関数
+//! @param sinceVersion Changed<M>の基準バージョン
 template<typename... AccessModes, typename Func>
-void TypedForEachImpl(ArchetypeStorage& archetypes, Func&& func) {
+void TypedForEachImpl(ArchetypeStorage& archetypes, Func&& func, uint32_t sinceVersion = 0) {
     static_assert(sizeof...(AccessModes) >= 1,
         "At least one access mode required");
     static_assert(sizeof...(AccessModes) <= 8,
@@ -266,7 +295,7 @@ void TypedForEachImpl(ArchetypeStorage& archetypes, Func&& func) {
 
     // 各アクセスモードから純粋な型を抽出
     archetypes.ForEachMatching<unwrap_access_t<AccessModes>...>(
-        [&func, writeVersion](Archetype& arch) {
+        [&func, writeVersion, sinceVersion](Archetype& arch) {
             auto& metas = arch.GetChunkMetas();
 
             // 各Chunkをイテレーション
@@ -274,6 +303,9 @@ void TypedForEachImpl(ArchetypeStorage& archetypes, Func&& func) {
                 const uint16_t count = metas[ci].count;
                 if (count == 0) continue;
 
+                // 変更フィルタ: 入力が変更されていないChunkはスキップ（書き込みマークもしない）
+                if (!PassesChangedFilter<AccessModes...>(arch, ci, sinceVersion)) continue;
+
                 // Write操作がある場合、Chunk処理前にバージョンを更新
                 if constexpr (hasWrite) {
                     // コンポーネントオフセットを取得（変更追跡用）
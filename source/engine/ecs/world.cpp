@@ -159,6 +159,9 @@ void World::BeginFrame() {
 
     // WorldContainerのBeginFrameを呼び出し（フレームカウンタ更新など）
     container_.BeginFrame();
+
+    // 以降の書き込み（GetComponent、Actor配置など）を新しいフレームで記録
+    container_.ECS().GetArchetypeStorage().SetWriteVersion(container_.GetFrameCount());
 }
 
 //----------------------------------------------------------------------------
@@ -206,7 +209,7 @@ void World::ClearAll() {
     container_.ClearAll();  // Systemもクリア
     systemsById_.clear();
     renderSystemsById_.clear();
-    sortedSystems_.clear();
+    systemExecutor_.Clear();
     sortedRenderSystems_.clear();
     systemGraph_.Clear();
     renderSystemGraph_.Clear();
@@ -221,10 +224,11 @@ void World::CommitSystem(SystemEntry entry) {
     SystemId id = entry.id;
 
     // グラフにIDと依存関係情報を追加
-    systemGraph_.AddNode(id, entry.priority, entry.runAfter, entry.runBefore, entry.name);
+    systemGraph_.AddNode(id, entry.priority, entry.runAfter, entry.runBefore, entry.name, entry.access);
 
-    // System実体をマップに格納
+    // System実体をマップに格納（再登録時は前回実行バージョンも破棄）
     systemsById_[id] = std::move(entry.system);
+    systemExecutor_.ResetSystemState(id);
 
     // 再構築が必要
     systemsDirty_ = true;
@@ -247,20 +251,14 @@ void World::CommitRenderSystem(RenderSystemEntry entry) {
 }
 
 //----------------------------------------------------------------------------
-//! @brief Systemのソート済み配列を再構築
+//! @brief Systemの実行計画を再構築
 //----------------------------------------------------------------------------
 void World::RebuildSortedSystems() {
-    sortedSystems_.clear();
-
-    std::vector<SystemId> sorted = systemGraph_.TopologicalSort();
-    sortedSystems_.reserve(sorted.size());
-
-    for (SystemId id : sorted) {
+    // 依存関係とアクセス宣言から並列実行計画を構築
+    systemExecutor_.Build(systemGraph_.BuildExecutionPlan(), [this](SystemId id) -> ISystem* {
         auto it = systemsById_.find(id);
-        if (it != systemsById_.end() && it->second) {
-            sortedSystems_.push_back(it->second.get());
-        }
-    }
+        return it != systemsById_.end() ? it->second.get() : nullptr;
+    });
 
     systemsDirty_ = false;
 }
@@ -24,6 +24,9 @@
 #include "query/query.h"
 #include "system.h"
 #include "system_graph.h"
+#include "system_builder.h"
+#include "system_executor.h"
+#include "system_api.h"
 #include "system_scheduler.h"
 #include "world_container.h"
 #include "typed_foreach.h"
@@ -850,9 +853,15 @@ public:
     template<typename T, typename Func,
              typename = std::enable_if_t<!is_access_mode_v<T>>>
     void ForEach(Func&& func) {
-        container_.ECS().GetArchetypeStorage().ForEachMatching<T>([&func](Archetype& arch) {
+        auto& storage = container_.ECS().GetArchetypeStorage();
+        const uint32_t version = storage.GetWriteVersion();
+        storage.ForEachMatching<T>([&func, version](Archetype& arch) {
             const auto& metas = arch.GetChunkMetas();
+            const size_t compIdx = arch.GetComponentIndex<T>();
             for (size_t ci = 0; ci < metas.size(); ++ci) {
+                if (metas[ci].count == 0) continue;
+                // 非const参照を渡すため書き込みとみなす
+                arch.MarkComponentWritten(ci, compIdx, version);
                 const Actor* actors = arch.GetActorArray(ci);
                 T* compArray = arch.GetComponentArray<T>(ci);  // SoA: 連続配列
                 for (uint16_t i = 0; i < metas[ci].count; ++i) {
@@ -873,9 +882,17 @@ public:
     template<typename T1, typename T2, typename Func,
              typename = std::enable_if_t<!is_access_mode_v<T1> && !is_access_mode_v<T2>>>
     void ForEach(Func&& func) {
-        container_.ECS().GetArchetypeStorage().ForEachMatching<T1, T2>([&func](Archetype& arch) {
+        auto& storage = container_.ECS().GetArchetypeStorage();
+        const uint32_t version = storage.GetWriteVersion();
+        storage.ForEachMatching<T1, T2>([&func, version](Archetype& arch) {
             const auto& metas = arch.GetChunkMetas();
+            const size_t compIdx1 = arch.GetComponentIndex<T1>();
+            const size_t compIdx2 = arch.GetComponentIndex<T2>();
             for (size_t ci = 0; ci < metas.size(); ++ci) {
+                if (metas[ci].count == 0) continue;
+                // 非const参照を渡すため書き込みとみなす
+                arch.MarkComponentWritten(ci, compIdx1, version);
+                arch.MarkComponentWritten(ci, compIdx2, version);
                 const Actor* actors = arch.GetActorArray(ci);
                 T1* array1 = arch.GetComponentArray<T1>(ci);  // SoA: 連続配列
                 T2* array2 = arch.GetComponentArray<T2>(ci);
@@ -897,9 +914,19 @@ public:
     template<typename T1, typename T2, typename T3, typename Func,
              typename = std::enable_if_t<!is_access_mode_v<T1> && !is_access_mode_v<T2> && !is_access_mode_v<T3>>>
     void ForEach(Func&& func) {
-        container_.ECS().GetArchetypeStorage().ForEachMatching<T1, T2, T3>([&func](Archetype& arch) {
+        auto& storage = container_.ECS().GetArchetypeStorage();
+        const uint32_t version = storage.GetWriteVersion();
+        storage.ForEachMatching<T1, T2, T3>([&func, version](Archetype& arch) {
             const auto& metas = arch.GetChunkMetas();
+            const size_t compIdx1 = arch.GetComponentIndex<T1>();
+            const size_t compIdx2 = arch.GetComponentIndex<T2>();
+            const size_t compIdx3 = arch.GetComponentIndex<T3>();
             for (size_t ci = 0; ci < metas.size(); ++ci) {
+                if (metas[ci].count == 0) continue;
+                // 非const参照を渡すため書き込みとみなす
+                arch.MarkComponentWritten(ci, compIdx1, version);
+                arch.MarkComponentWritten(ci, compIdx2, version);
+                arch.MarkComponentWritten(ci, compIdx3, version);
                 const Actor* actors = arch.GetActorArray(ci);
                 T1* array1 = arch.GetComponentArray<T1>(ci);  // SoA: 連続配列
                 T2* array2 = arch.GetComponentArray<T2>(ci);
@@ -985,8 +1012,12 @@ public:
     //! - In<T>: 読み取り専用。ラムダには const T& として渡される。
     //! - Out<T>: 書き込み専用。ラムダには T& として渡される。
     //! - InOut<T>: 読み書き両方。ラムダには T& として渡される。
+    //! - Changed<M>: Mと同じ型で渡され、前回のSystem実行以降に
+    //!   変更されたChunkのみを処理する（複数指定時はいずれかが変更されたChunk）。
     //!
-    //! @tparam AccessModes In<T>/Out<T>/InOut<T>のシーケンス
+    //! Out<T>/InOut<T>で処理したChunkは書き込み済みとしてバージョンが更新される。
+    //!
+    //! @tparam AccessModes In<T>/Out<T>/InOut<T>/Changed<M>のシーケンス
     //! @tparam Func ラムダ型（Actor, 各コンポーネント参照を受け取る）
     //! @param func 各アクターに対して呼び出す関数
     //!
@@ -1008,6 +1039,10 @@ public:
     //!     [](Actor e, DamageData& d) {
     //!         d.value = 0;
     //!     });
+    //!
+    //! // 入力が変更されたChunkのみ
+    //! world.ForEach<Changed<In<LocalToWorld>>, InOut<WorldRenderBoundsData>>(
+    //!     [](Actor e, const LocalToWorld& ltw, WorldRenderBoundsData& b) { ... });
     //! @endcode
     //------------------------------------------------------------------------
     template<typename... AccessModes, typename Func,
@@ -1029,7 +1064,9 @@ public:
         // 変更追跡用のバージョンを設定
         container_.ECS().GetArchetypeStorage().SetWriteVersion(container_.GetFrameCount());
 
-        detail::TypedForEachImpl<AccessModes...>(container_.ECS().GetArchetypeStorage(), std::forward<Func>(func));
+        // Changed<M>は実行中Systemの前回実行以降に変更されたChunkのみ処理
+        detail::TypedForEachImpl<AccessModes...>(container_.ECS().GetArchetypeStorage(), std::forward<Func>(func),
+                                                 SystemAPI::LastRunVersion());
     }
 
     //------------------------------------------------------------------------
@@ -1138,12 +1175,30 @@ public:
         entry.id = std::type_index(typeid(T));
         entry.priority = system->Priority();
         entry.name = system->Name();
+        system->DeclareAccess(entry.access);
         entry.system = std::move(system);
 
         // グラフに追加してソート
         CommitSystem(std::move(entry));
     }
 
+    //------------------------------------------------------------------------
+    //! @brief 更新Systemを依存関係・アクセス宣言付きで登録
+    //! @tparam T ISystemを継承したクラス（finalを推奨）
+    //! @return SystemBuilder（破棄時に登録される）
+    //!
+    //! @code
+    //! world.RegisterSystemWithDeps<MovementSystem>()
+    //!      .After<InputSystem>()
+    //!      .WithAccess<InOut<LocalTransform>, In<Velocity>>();
+    //! @endcode
+    //------------------------------------------------------------------------
+    template<typename T>
+    SystemBuilder<T> RegisterSystemWithDeps() {
+        static_assert(std::is_base_of_v<ISystem, T>, "T must inherit from ISystem");
+        return SystemBuilder<T>(this, std::make_unique<T>());
+    }
+
     //------------------------------------------------------------------------
     //! @brief 描画Systemをクラスベースで登録（シンプル版）
     //! @tparam T IRenderSystemを継承したクラス（finalを推奨）
@@ -1176,6 +1231,30 @@ public:
     //------------------------------------------------------------------------
     void CommitRenderSystem(RenderSystemEntry entry);
 
+    //------------------------------------------------------------------------
+    //! @brief 登録済みの更新Systemを取得
+    //! @tparam T 登録時に指定したSystemクラス
+    //! @return 未登録ならnullptr
+    //------------------------------------------------------------------------
+    template<typename T>
+    [[nodiscard]] T* GetSystem() const {
+        auto it = systemsById_.find(std::type_index(typeid(T)));
+        return it != systemsById_.end() ? static_cast<T*>(it->second.get()) : nullptr;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 登録済みの描画Systemを取得
+    //! @tparam T 登録時に指定したRenderSystemクラス
+    //! @return 未登録ならnullptr
+    //!
+    //! 前段の描画Systemが生成した結果（可視性マスク等）を後段から参照する用途。
+    //------------------------------------------------------------------------
+    template<typename T>
+    [[nodiscard]] T* GetRenderSystem() const {
+        auto it = renderSystemsById_.find(std::type_index(typeid(T)));
+        return it != renderSystemsById_.end() ? static_cast<T*>(it->second.get()) : nullptr;
+    }
+
     //========================================================================
     // フレーム制御
     //========================================================================
@@ -1218,9 +1297,26 @@ public:
         if (systemsDirty_) {
             RebuildSortedSystems();
         }
-        for (ISystem* system : sortedSystems_) {
-            system->OnUpdate(*this, dt);
-        }
+
+        // アクセスが競合しないSystemはJobSystem上で同時に実行される
+        systemExecutor_.Execute(*this, dt);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 更新Systemの並列実行を有効/無効化
+    //! @param enabled falseの場合は依存順に逐次実行（デバッグ用）
+    //------------------------------------------------------------------------
+    void SetParallelSystemUpdate(bool enabled) noexcept {
+        systemExecutor_.SetParallelEnabled(enabled);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 更新Systemの実行計画を取得（デバッグ・テスト用）
+    //!
+    //! 登録後の最初のFixedUpdate()で構築される。
+    //------------------------------------------------------------------------
+    [[nodiscard]] const SystemExecutor& GetSystemExecutor() const noexcept {
+        return systemExecutor_;
     }
 
     //------------------------------------------------------------------------
@@ -1350,8 +1446,10 @@ private:
     std::unordered_map<SystemId, std::unique_ptr<ISystem>> systemsById_;
     std::unordered_map<SystemId, std::unique_ptr<IRenderSystem>> renderSystemsById_;
 
-    //! ソート済みSystem配列（実行用、生ポインタ）
-    std::vector<ISystem*> sortedSystems_;
+    //! 更新Systemの実行計画（並列実行用）
+    SystemExecutor systemExecutor_;
+
+    //! ソート済みRenderSystem配列（実行用、生ポインタ）
     std::vector<IRenderSystem*> sortedRenderSystems_;
 
     //! ソート済み配列の再構築フラグ
@@ -1390,3 +1488,12 @@ private:
 
 // ComponentRef テンプレート実装
 #include "detail/component_ref_impl.h"
+
+// SystemBuilder::Commit() 実装
+#include "detail/system_builder_impl.h"
+
+// SystemExecutor::RunSystem() 実装
+#include "detail/system_executor_impl.h"
+
+// SystemAPI テンプレート実装
+#include "detail/system_api_impl.h"
@@ -6,6 +6,8 @@
 
 
 #include "engine/math/math_types.h"
+#include "pose.h"
+#include "bone_mask.h"
 #include <vector>
 #include <string>
 #include <variant>
@@ -78,6 +80,35 @@ inline Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t) {
     return Quaternion::Slerp(a, b, t);
 }
 
+//! @brief 時間をラップモードに従って正規化
+//! @param time 入力時間
+//! @param duration 再生時間
+//! @param wrapMode ラップモード
+//! @return 正規化された時間
+inline float WrapTime(float time, float duration, WrapMode wrapMode) {
+    if (duration <= 0.0f) return 0.0f;
+
+    switch (wrapMode) {
+        case WrapMode::Once:
+            return std::clamp(time, 0.0f, duration);
+
+        case WrapMode::Loop: {
+            float t = std::fmod(time, duration);
+            return (t < 0.0f) ? t + duration : t;
+        }
+
+        case WrapMode::PingPong: {
+            float t = std::fmod(time, duration * 2.0f);
+            if (t < 0.0f) t += duration * 2.0f;
+            return (t > duration) ? (duration * 2.0f - t) : t;
+        }
+
+        case WrapMode::ClampForever:
+            return std::clamp(time, 0.0f, duration);
+    }
+    return time;
+}
+
 //! @brief キーフレーム配列から補間サンプリング
 template<typename T, typename InterpFunc>
 T SampleKeyframes(const std::vector<Keyframe<T>>& keys, float time, InterpFunc interp) {
@@ -131,14 +162,16 @@ struct BoneChannel {
     std::vector<RotationKey> rotationKeys;          //!< 回転キーフレーム
     std::vector<ScaleKey> scaleKeys;                //!< スケールキーフレーム
 
-    //! @brief 指定時間でのTransform行列をサンプリング
+    //! @brief 指定時間でのTRSをサンプリング
     //! @param time サンプリング時間（秒）
-    //! @return Transform行列
-    [[nodiscard]] Matrix SampleAt(float time) const {
+    //! @param outPosition 位置（キーがなければ原点）
+    //! @param outRotation 回転（キーがなければ恒等）
+    //! @param outScale スケール（キーがなければ1）
+    void SampleTRS(float time, Vector3& outPosition, Quaternion& outRotation, Vector3& outScale) const {
         // 位置
-        Vector3 position = Vector3::Zero;
+        outPosition = Vector3::Zero;
         if (!positionKeys.empty()) {
-            position = AnimationInterp::SampleKeyframes(
+            outPosition = AnimationInterp::SampleKeyframes(
                 positionKeys, time,
                 [](const Vector3& a, const Vector3& b, float t) {
                     return AnimationInterp::Lerp(a, b, t);
@@ -146,9 +179,9 @@ struct BoneChannel {
         }
 
         // 回転
-        Quaternion rotation = Quaternion::Identity;
+        outRotation = Quaternion::Identity;
         if (!rotationKeys.empty()) {
-            rotation = AnimationInterp::SampleKeyframes(
+            outRotation = AnimationInterp::SampleKeyframes(
                 rotationKeys, time,
                 [](const Quaternion& a, const Quaternion& b, float t) {
                     return AnimationInterp::Slerp(a, b, t);
@@ -156,14 +189,24 @@ struct BoneChannel {
         }
 
         // スケール
-        Vector3 scale = Vector3::One;
+        outScale = Vector3::One;
         if (!scaleKeys.empty()) {
-            scale = AnimationInterp::SampleKeyframes(
+            outScale = AnimationInterp::SampleKeyframes(
                 scaleKeys, time,
                 [](const Vector3& a, const Vector3& b, float t) {
                     return AnimationInterp::Lerp(a, b, t);
                 });
         }
+    }
+
+    //! @brief 指定時間でのTransform行列をサンプリング
+    //! @param time サンプリング時間（秒）
+    //! @return Transform行列
+    [[nodiscard]] Matrix SampleAt(float time) const {
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale;
+        SampleTRS(time, position, rotation, scale);
 
         // TRS行列を構築
         return Matrix::CreateScale(scale) *
@@ -177,6 +220,8 @@ struct BoneChannel {
     }
 };
 
+class CompressedAnimationClip;
+
 //============================================================================
 //! @brief AnimationClip - アニメーションクリップ
 //!
@@ -210,6 +255,9 @@ public:
     std::vector<BoneChannel> channels;              //!< ボーンチャンネル配列
     std::vector<AnimationEvent> events;             //!< アニメーションイベント
 
+    //! 圧縮済みデータ（compressed_clip.h）。設定されていればAnimatorはこちらを使う
+    std::shared_ptr<const CompressedAnimationClip> compressed;
+
     //========================================================================
     // チャンネル管理
     //========================================================================
@@ -256,27 +304,7 @@ public:
     //! @param time 入力時間
     //! @return 正規化された時間
     [[nodiscard]] float WrapTime(float time) const {
-        if (duration <= 0.0f) return 0.0f;
-
-        switch (wrapMode) {
-            case WrapMode::Once:
-                return std::clamp(time, 0.0f, duration);
-
-            case WrapMode::Loop: {
-                float t = std::fmod(time, duration);
-                return (t < 0.0f) ? t + duration : t;
-            }
-
-            case WrapMode::PingPong: {
-                float t = std::fmod(time, duration * 2.0f);
-                if (t < 0.0f) t += duration * 2.0f;
-                return (t > duration) ? (duration * 2.0f - t) : t;
-            }
-
-            case WrapMode::ClampForever:
-                return std::clamp(time, 0.0f, duration);
-        }
-        return time;
+        return AnimationInterp::WrapTime(time, duration, wrapMode);
     }
 
     //! @brief 全ボーンのポーズをサンプリング
@@ -298,6 +326,30 @@ public:
         }
     }
 
+    //! @brief 全ボーンのポーズをTRSのままサンプリング
+    //! @param time サンプリング時間（秒）
+    //! @param outPose 出力ポーズ
+    //! @param mask サンプリングするボーン（nullptr = 全ボーン）
+    //!
+    //! キーから直接SoAストリームへ書き込み、行列は作らない。
+    //! @note SamplePose(float, std::vector<Matrix>&) と同じく、
+    //!       チャンネルのないボーンは変更されない（事前にSetIdentity()しておくこと）。
+    void SamplePose(float time, Pose& outPose, const BoneMask* mask = nullptr) const {
+        float wrappedTime = WrapTime(time);
+        const int boneCount = static_cast<int>(outPose.GetBoneCount());
+
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale;
+        for (const auto& channel : channels) {
+            if (channel.boneIndex >= 0 && channel.boneIndex < boneCount && channel.HasKeys() &&
+                IsBoneEnabled(mask, static_cast<uint32_t>(channel.boneIndex))) {
+                channel.SampleTRS(wrappedTime, position, rotation, scale);
+                outPose.SetBone(static_cast<uint32_t>(channel.boneIndex), position, rotation, scale);
+            }
+        }
+    }
+
     //! @brief 特定のボーンのTransformをサンプリング
     //! @param boneIndex ボーンインデックス
     //! @param time サンプリング時間
@@ -375,7 +427,14 @@ public:
 
     //! @brief クリップが有効か
     [[nodiscard]] bool IsValid() const noexcept {
-        return duration > 0.0f && !channels.empty();
+        return duration > 0.0f && (!channels.empty() || compressed);
+    }
+
+    //! @brief 元のキーフレームを解放（圧縮後のメモリ節約用）
+    //! @note 以降のSamplePose/SampleBoneはcompressedを経由しない限り何も書かない
+    void ReleaseSourceKeys() {
+        channels.clear();
+        channels.shrink_to_fit();
     }
 
 private:
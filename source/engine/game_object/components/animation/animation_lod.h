@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------
+//! @file   animation_lod.h
+//! @brief  アニメーションLOD - 距離による更新頻度の間引きと画面外での停止
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <algorithm>
+#include <cstdint>
+
+//============================================================================
+//! @brief アニメーションLODレベル
+//!
+//! レベルnのキャラクターは 2^n フレームに1回ポーズを評価する。
+//! 最遠レベルではボーンマスクも適用する。
+//============================================================================
+enum class AnimationLODLevel : uint8_t {
+    Full = 0,       //!< 毎フレーム・全ボーン
+    Half = 1,       //!< 2フレームに1回
+    Quarter = 2,    //!< 4フレームに1回・ボーンマスク適用
+};
+
+//============================================================================
+//! @brief アニメーションLOD設定
+//!
+//! 距離はLODSystemと同じく、アクティブカメラ位置からの直線距離。
+//============================================================================
+struct AnimationLODSettings {
+    float halfRateDistance = 20.0f;     //!< これより遠いとHalf
+    float quarterRateDistance = 50.0f;  //!< これより遠いとQuarter
+    float resumeBlendTime = 0.15f;      //!< 画面外から復帰した時に停止ポーズから補間する時間（秒）
+
+    //! @brief 距離からLODレベルを選択
+    [[nodiscard]] AnimationLODLevel SelectLevel(float distance) const noexcept {
+        if (distance > quarterRateDistance) return AnimationLODLevel::Quarter;
+        if (distance > halfRateDistance) return AnimationLODLevel::Half;
+        return AnimationLODLevel::Full;
+    }
+};
+
+//============================================================================
+//! @brief アニメーションLODの状態（インスタンスごと、trivially copyable）
+//!
+//! AnimatorとECSのAnimationSystemで共通の判定を行う。
+//! 再生時間は毎フレーム進め、ポーズの評価だけを間引く。
+//!
+//! - 更新間隔: レベルに応じて 1/2/4 フレームに1回。phaseでインスタンスごとに
+//!   評価フレームをずらし、負荷が特定のフレームに集中しないようにする。
+//! - 画面外: 評価を止めて直前のポーズを保持する。
+//! - 復帰: 停止していたポーズから新しいポーズへresumeBlendTimeかけて補間する
+//!   （補間中は毎フレーム評価する）。
+//============================================================================
+struct AnimationLODState {
+    float resumeWeight = 0.0f;                          //!< 停止ポーズの残りウェイト（1→0）
+    AnimationLODLevel level = AnimationLODLevel::Full;  //!< 現在のレベル
+    bool frozen = false;                                //!< 画面外で停止中か
+    uint8_t _pad0[2] = {};
+
+    //------------------------------------------------------------------------
+    //! @brief 1フレーム進めて、このフレームにポーズを評価するかを返す
+    //! @param settings LOD設定
+    //! @param distance カメラからの距離
+    //! @param visible 画面内か（視錐台・LODRangeData）
+    //! @param frame フレーム番号
+    //! @param phase インスタンスごとの位相（任意の値、下位ビットのみ使用）
+    //! @param dt デルタタイム
+    //------------------------------------------------------------------------
+    bool Advance(const AnimationLODSettings& settings, float distance, bool visible,
+                 uint32_t frame, uint32_t phase, float dt) noexcept {
+        if (!visible) {
+            frozen = true;
+            resumeWeight = 0.0f;
+            return false;
+        }
+
+        bool force = false;
+        if (frozen) {
+            frozen = false;
+            resumeWeight = 1.0f;
+            force = true;
+        }
+        if (resumeWeight > 0.0f) {
+            resumeWeight = settings.resumeBlendTime > 0.0f
+                ? (std::max)(resumeWeight - dt / settings.resumeBlendTime, 0.0f)
+                : 0.0f;
+        }
+
+        level = settings.SelectLevel(distance);
+        return force || resumeWeight > 0.0f || IsUpdateFrame(level, frame, phase);
+    }
+
+    //! @brief レベルの評価間隔（フレーム）
+    [[nodiscard]] static constexpr uint32_t GetInterval(AnimationLODLevel level) noexcept {
+        return 1u << static_cast<uint32_t>(level);
+    }
+
+    //! @brief 位相をずらした上で評価フレームか
+    [[nodiscard]] static constexpr bool IsUpdateFrame(AnimationLODLevel level, uint32_t frame, uint32_t phase) noexcept {
+        return ((frame + phase) & (GetInterval(level) - 1)) == 0;
+    }
+
+    //! @brief ボーンマスクを適用するレベルか
+    [[nodiscard]] bool UsesBoneMask() const noexcept {
+        return level == AnimationLODLevel::Quarter;
+    }
+};
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------
+//! @file   bone_mask.h
+//! @brief  BoneMask - 評価するボーンの部分集合
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+//============================================================================
+//! @brief BoneMask - ボーンごとの有効/無効ビット
+//!
+//! 遠距離のアニメーションLODで、指・顔・装飾などの重要度の低いボーンを
+//! 評価から外すために使う。無効なボーンはサンプリングせず、
+//! バインドポーズのまま親に追従する（Skeleton::ComputeGlobalTransforms）。
+//!
+//! 範囲外のボーンは有効として扱う（空のマスク = 全ボーン有効）。
+//!
+//! @code
+//! // ルートから深さ3までのボーンだけを評価
+//! auto mask = std::make_shared<BoneMask>(skeleton->CreateDepthMask(3));
+//! animator->SetLODBoneMask(mask);
+//! @endcode
+//============================================================================
+class BoneMask {
+public:
+    BoneMask() = default;
+
+    //! @brief 全ボーンを同じ状態で初期化
+    //! @param boneCount ボーン数
+    //! @param enabled 初期状態
+    explicit BoneMask(uint32_t boneCount, bool enabled = true)
+        : words_((boneCount + 63) / 64, enabled ? ~uint64_t{0} : uint64_t{0})
+        , boneCount_(boneCount) {}
+
+    //! @brief ボーンの有効/無効を設定
+    void Set(uint32_t bone, bool enabled) noexcept {
+        if (bone >= boneCount_) return;
+        const uint64_t bit = uint64_t{1} << (bone % 64);
+        words_[bone / 64] = enabled ? (words_[bone / 64] | bit) : (words_[bone / 64] & ~bit);
+    }
+
+    //! @brief ボーンが有効か（範囲外は有効）
+    [[nodiscard]] bool Test(uint32_t bone) const noexcept {
+        return bone >= boneCount_ || (words_[bone / 64] >> (bone % 64)) & 1u;
+    }
+
+    //! @brief 対象ボーン数
+    [[nodiscard]] uint32_t GetBoneCount() const noexcept { return boneCount_; }
+
+    //! @brief 有効なボーン数
+    [[nodiscard]] uint32_t CountEnabled() const noexcept {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < boneCount_; ++i) {
+            count += Test(i) ? 1u : 0u;
+        }
+        return count;
+    }
+
+private:
+    std::vector<uint64_t> words_;   //!< 有効ビット（64ボーン/ワード）
+    uint32_t boneCount_ = 0;        //!< 対象ボーン数
+};
+
+//! @brief マスクが有効なボーンか（nullptr = 全ボーン有効）
+[[nodiscard]] inline bool IsBoneEnabled(const BoneMask* mask, uint32_t bone) noexcept {
+    return !mask || mask->Test(bone);
+}
@@ -0,0 +1,531 @@
+//----------------------------------------------------------------------------
+//! @file   compressed_clip.h
+//! @brief  CompressedAnimationClip - 量子化・キー削減済みのアニメーションクリップ
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "animation_clip.h"
+#include "pose.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+//============================================================================
+//! @brief 圧縮設定
+//============================================================================
+struct AnimationCompressionSettings {
+    float translationTolerance = 0.001f;    //!< 位置の許容誤差（ワールド単位）
+    float rotationTolerance = 0.001f;       //!< 回転の許容誤差（ラジアン）
+    float scaleTolerance = 0.001f;          //!< スケールの許容誤差
+    float sampleRate = 0.0f;                //!< 再サンプリングレート（0ならクリップのframeRate）
+};
+
+class CompressedAnimationClip;
+
+//============================================================================
+//! @brief 再生カーソル（インスタンスごと）
+//!
+//! アニメーショントラックごとに直前に使ったキー位置を覚えておき、
+//! 次のサンプリングではそこから前後に歩くだけで区間を見つける。
+//! 連続再生なら1フレームに進むキーは高々数個で、二分探索は不要（償却O(1)）。
+//!
+//! 別のクリップでサンプリングすると自動で先頭から再バインドする。
+//============================================================================
+class AnimationClipCursor {
+public:
+    //! @brief 先頭へ戻す
+    void Reset() noexcept {
+        std::fill(keys_.begin(), keys_.end(), uint16_t(0));
+    }
+
+    //! @brief バインド中のクリップ
+    [[nodiscard]] const CompressedAnimationClip* GetClip() const noexcept { return clip_; }
+
+private:
+    friend class CompressedAnimationClip;
+
+    const CompressedAnimationClip* clip_ = nullptr;     //!< バインド中のクリップ
+    std::vector<uint16_t> keys_;                        //!< アニメーショントラックごとの区間先頭キー
+};
+
+//============================================================================
+//! @brief CompressedAnimationClip - 圧縮済みクリップ
+//!
+//! AnimationClipをロード時（またはオフライン）に変換したランタイム用の形式。
+//!
+//! - 一定値トラックの除去: 全フレームで許容誤差内に収まるトラックは値1つだけ持つ。
+//!   既定値（位置0・回転なし・スケール1）なら値も持たず、3トラックとも既定の
+//!   チャンネルは丸ごと捨てる（出力ポーズは事前に恒等で初期化されている前提）。
+//! - 誤差制限付きキー削減: sampleRateで再サンプリングしたフレームから、
+//!   前後のキーの補間で許容誤差内に再現できるキーを落とす。
+//! - 量子化: 位置・スケールはトラックごとの範囲で正規化した16bit×3、
+//!   回転は最大成分を省く smallest-three（2bit + 15bit×3 = 48bit）。
+//!
+//! キー値とキー時刻は全トラック分を1本の配列に詰めてあり、
+//! サンプリングはAnimationClipCursorを使って区間を前後に歩く。
+//!
+//! @code
+//! // ロード時に圧縮し、元のキーは捨てる
+//! clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+//! clip->ReleaseSourceKeys();
+//!
+//! // インスタンスごとにカーソルを持ってサンプリング
+//! AnimationClipCursor cursor;
+//! pose.SetIdentity();
+//! clip->compressed->SamplePose(time, cursor, pose);
+//! @endcode
+//============================================================================
+class CompressedAnimationClip {
+public:
+    //! @brief トラック種別
+    enum class TrackKind : uint8_t {
+        Default,        //!< 既定値（データなし）
+        Constant,       //!< 一定値（valueのみ）
+        Animated        //!< キーフレームあり
+    };
+
+    //! @brief トラック（位置・回転・スケールのいずれか）
+    struct Track {
+        TrackKind kind = TrackKind::Default;
+        uint8_t _pad[3] = {};
+        uint32_t cursorSlot = 0;    //!< AnimationClipCursor内の位置（Animatedのみ）
+        uint32_t firstKey = 0;      //!< keyFrames_/keyValues_ 内の先頭キー
+        uint32_t keyCount = 0;      //!< キー数（Animatedは2以上）
+        float value[4] = {};        //!< Constant: 値 / Animated(位置・スケール): 範囲の最小値
+        float extent[3] = {};       //!< Animated(位置・スケール): 範囲の幅
+    };
+
+    //! @brief チャンネル（1ボーン分）
+    struct Channel {
+        int boneIndex = -1;
+        Track translation;
+        Track rotation;
+        Track scale;
+    };
+
+    CompressedAnimationClip() = default;
+
+    //------------------------------------------------------------------------
+    //! @brief AnimationClipを圧縮して構築
+    //! @param source 元クリップ
+    //! @param settings 圧縮設定
+    //------------------------------------------------------------------------
+    explicit CompressedAnimationClip(const AnimationClip& source,
+                                     const AnimationCompressionSettings& settings = {}) {
+        Build(source, settings);
+    }
+
+    //========================================================================
+    // 情報
+    //========================================================================
+    [[nodiscard]] float GetDuration() const noexcept { return duration_; }
+    [[nodiscard]] float GetSampleRate() const noexcept { return sampleRate_; }
+    [[nodiscard]] WrapMode GetWrapMode() const noexcept { return wrapMode_; }
+    [[nodiscard]] uint32_t GetFrameCount() const noexcept { return frameCount_; }
+    [[nodiscard]] const std::vector<Channel>& GetChannels() const noexcept { return channels_; }
+
+    //! @brief 全トラックの保持キー数
+    [[nodiscard]] size_t GetKeyCount() const noexcept { return keyFrames_.size(); }
+
+    //! @brief アニメーション（キーを持つ）トラック数
+    [[nodiscard]] uint32_t GetAnimatedTrackCount() const noexcept { return animatedTrackCount_; }
+
+    //! @brief 保持しているデータ量（バイト）
+    [[nodiscard]] size_t GetMemorySize() const noexcept {
+        return sizeof(*this) +
+               channels_.capacity() * sizeof(Channel) +
+               keyFrames_.capacity() * sizeof(uint16_t) +
+               keyValues_.capacity() * sizeof(uint16_t);
+    }
+
+    //! @brief 元クリップのキーデータ量（バイト、比較用）
+    [[nodiscard]] static size_t GetSourceMemorySize(const AnimationClip& clip) noexcept {
+        size_t size = sizeof(AnimationClip) + clip.channels.capacity() * sizeof(BoneChannel);
+        for (const auto& channel : clip.channels) {
+            size += channel.positionKeys.capacity() * sizeof(PositionKey);
+            size += channel.rotationKeys.capacity() * sizeof(RotationKey);
+            size += channel.scaleKeys.capacity() * sizeof(ScaleKey);
+        }
+        return size;
+    }
+
+    //========================================================================
+    // サンプリング
+    //========================================================================
+
+    //------------------------------------------------------------------------
+    //! @brief 全ボーンのポーズをサンプリング
+    //! @param time サンプリング時間（秒、ラップモードで正規化される）
+    //! @param cursor このインスタンスの再生カーソル
+    //! @param outPose 出力ポーズ（チャンネルのないボーンは変更されない）
+    //! @param mask サンプリングするボーン（nullptr = 全ボーン）
+    //------------------------------------------------------------------------
+    void SamplePose(float time, AnimationClipCursor& cursor, Pose& outPose,
+                    const BoneMask* mask = nullptr) const {
+        if (cursor.clip_ != this) {
+            cursor.clip_ = this;
+            cursor.keys_.assign(animatedTrackCount_, uint16_t(0));
+        }
+        SamplePose(time, cursor.keys_.data(), outPose, mask);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief カーソルのキー配列を呼び出し側が持つ版
+    //! @param time サンプリング時間（秒、ラップモードで正規化される）
+    //! @param cursorKeys GetAnimatedTrackCount()要素のキー配列（初回は0で埋める）
+    //! @param outPose 出力ポーズ（チャンネルのないボーンは変更されない）
+    //! @param mask サンプリングするボーン（無効なボーンのカーソルは進めない）
+    //!
+    //! ECSのようにカーソルをコンポーネントのバッファへ置く場合に使う。
+    //------------------------------------------------------------------------
+    void SamplePose(float time, uint16_t* cursorKeys, Pose& outPose,
+                    const BoneMask* mask = nullptr) const {
+        const float frame = std::min(
+            AnimationInterp::WrapTime(time, duration_, wrapMode_) * sampleRate_,
+            static_cast<float>(frameCount_ - 1));
+        const uint32_t boneCount = outPose.GetBoneCount();
+
+        for (const Channel& channel : channels_) {
+            const uint32_t bone = static_cast<uint32_t>(channel.boneIndex);
+            if (bone >= boneCount || !IsBoneEnabled(mask, bone)) continue;
+
+            const Vector3 translation = SampleVector(channel.translation, frame, cursorKeys, Vector3::Zero);
+            const Quaternion rotation = SampleRotation(channel.rotation, frame, cursorKeys);
+            const Vector3 scale = SampleVector(channel.scale, frame, cursorKeys, Vector3::One);
+            outPose.SetBone(bone, translation, rotation, scale);
+        }
+    }
+
+    //========================================================================
+    // 量子化（テスト・ツール用に公開）
+    //========================================================================
+
+    //! @brief 回転を smallest-three 48bit へ量子化
+    static void PackRotation(const Quaternion& q, uint16_t out[3]) noexcept {
+        const float c[4] = { q.x, q.y, q.z, q.w };
+        uint32_t largest = 0;
+        for (uint32_t i = 1; i < 4; ++i) {
+            if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+        }
+        // 最大成分が正になる側を使う（qと-qは同じ回転）
+        const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+        uint64_t packed = static_cast<uint64_t>(largest) << 45;
+        uint32_t shift = 30;
+        for (uint32_t i = 0; i < 4; ++i) {
+            if (i == largest) continue;
+            const float normalized = std::clamp(c[i] * sign * kSqrt2 * 0.5f + 0.5f, 0.0f, 1.0f);
+            packed |= static_cast<uint64_t>(std::lround(normalized * kRotationQuantMax)) << shift;
+            shift -= 15;
+        }
+        out[0] = static_cast<uint16_t>(packed >> 32);
+        out[1] = static_cast<uint16_t>(packed >> 16);
+        out[2] = static_cast<uint16_t>(packed);
+    }
+
+    //! @brief smallest-three 48bit から回転を復元
+    [[nodiscard]] static Quaternion UnpackRotation(const uint16_t in[3]) noexcept {
+        const uint64_t packed = (static_cast<uint64_t>(in[0]) << 32) |
+                                (static_cast<uint64_t>(in[1]) << 16) |
+                                static_cast<uint64_t>(in[2]);
+        const uint32_t largest = static_cast<uint32_t>(packed >> 45) & 3u;
+
+        float c[4];
+        float sumSq = 0.0f;
+        uint32_t shift = 30;
+        for (uint32_t i = 0; i < 4; ++i) {
+            if (i == largest) continue;
+            const float normalized = static_cast<float>((packed >> shift) & 0x7FFFu) / kRotationQuantMax;
+            c[i] = (normalized - 0.5f) * 2.0f / kSqrt2;
+            sumSq += c[i] * c[i];
+            shift -= 15;
+        }
+        c[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+        return Quaternion(c[0], c[1], c[2], c[3]);
+    }
+
+private:
+    static constexpr float kSqrt2 = 1.41421356f;
+    static constexpr float kRotationQuantMax = 32767.0f;
+    static constexpr float kVectorQuantMax = 65535.0f;
+
+    //========================================================================
+    // 構築
+    //========================================================================
+
+    void Build(const AnimationClip& source, const AnimationCompressionSettings& settings) {
+        duration_ = source.duration;
+        wrapMode_ = source.wrapMode;
+        sampleRate_ = settings.sampleRate > 0.0f ? settings.sampleRate : source.frameRate;
+        if (sampleRate_ <= 0.0f) sampleRate_ = 30.0f;
+
+        // [0, duration] を等間隔に割る（レートは端数が出ないよう微調整）
+        const float frames = std::ceil(std::max(duration_, 0.0f) * sampleRate_ - 1e-4f);
+        frameCount_ = static_cast<uint32_t>(frames) + 1;
+        assert(frameCount_ <= 0xFFFFu && "Clip is too long for 16-bit key frames");
+        frameCount_ = std::min<uint32_t>(frameCount_, 0xFFFFu);
+        if (frameCount_ > 1) {
+            sampleRate_ = static_cast<float>(frameCount_ - 1) / duration_;
+        }
+
+        std::vector<Vector3> positions(frameCount_);
+        std::vector<Quaternion> rotations(frameCount_);
+        std::vector<Vector3> scales(frameCount_);
+
+        for (const BoneChannel& sourceChannel : source.channels) {
+            if (sourceChannel.boneIndex < 0 || !sourceChannel.HasKeys()) continue;
+
+            // 一様なフレームへ再サンプリング
+            for (uint32_t f = 0; f < frameCount_; ++f) {
+                const float time = std::min(static_cast<float>(f) / sampleRate_, duration_);
+                sourceChannel.SampleTRS(time, positions[f], rotations[f], scales[f]);
+                rotations[f].Normalize();
+                // 隣接フレームの符号をそろえる（削減時の補間誤差評価のため）
+                if (f > 0 && rotations[f].Dot(rotations[f - 1]) < 0.0f) {
+                    rotations[f] = -rotations[f];
+                }
+            }
+
+            Channel channel;
+            channel.boneIndex = sourceChannel.boneIndex;
+            BuildVectorTrack(positions, Vector3::Zero, settings.translationTolerance, channel.translation);
+            BuildRotationTrack(rotations, settings.rotationTolerance, channel.rotation);
+            BuildVectorTrack(scales, Vector3::One, settings.scaleTolerance, channel.scale);
+
+            // 全トラックが既定値ならチャンネルごと不要
+            if (channel.translation.kind == TrackKind::Default &&
+                channel.rotation.kind == TrackKind::Default &&
+                channel.scale.kind == TrackKind::Default) {
+                continue;
+            }
+            channels_.push_back(channel);
+        }
+
+        channels_.shrink_to_fit();
+        keyFrames_.shrink_to_fit();
+        keyValues_.shrink_to_fit();
+    }
+
+    void BuildVectorTrack(const std::vector<Vector3>& samples, const Vector3& defaultValue,
+                          float tolerance, Track& track) {
+        const auto distance = [](const Vector3& a, const Vector3& b) {
+            return Vector3::Distance(a, b);
+        };
+
+        if (IsConstant(samples, distance, tolerance)) {
+            if (distance(samples[0], defaultValue) <= tolerance) {
+                track.kind = TrackKind::Default;
+            } else {
+                track.kind = TrackKind::Constant;
+                track.value[0] = samples[0].x;
+                track.value[1] = samples[0].y;
+                track.value[2] = samples[0].z;
+            }
+            return;
+        }
+
+        const std::vector<uint32_t> keys = ReduceKeys(samples, tolerance,
+            [](const Vector3& a, const Vector3& b, float t) { return Vector3::Lerp(a, b, t); },
+            distance);
+
+        // 範囲を求めて16bitへ量子化
+        Vector3 minValue = samples[0];
+        Vector3 maxValue = samples[0];
+        for (uint32_t key : keys) {
+            minValue = Vector3::Min(minValue, samples[key]);
+            maxValue = Vector3::Max(maxValue, samples[key]);
+        }
+        const Vector3 extent = maxValue - minValue;
+
+        BeginAnimatedTrack(track, keys.size());
+        track.value[0] = minValue.x;
+        track.value[1] = minValue.y;
+        track.value[2] = minValue.z;
+        track.extent[0] = extent.x;
+        track.extent[1] = extent.y;
+        track.extent[2] = extent.z;
+
+        const float mins[3] = { minValue.x, minValue.y, minValue.z };
+        const float extents[3] = { extent.x, extent.y, extent.z };
+        for (uint32_t key : keys) {
+            const float values[3] = { samples[key].x, samples[key].y, samples[key].z };
+            keyFrames_.push_back(static_cast<uint16_t>(key));
+            for (int axis = 0; axis < 3; ++axis) {
+                const float normalized = extents[axis] > 0.0f
+                    ? (values[axis] - mins[axis]) / extents[axis] : 0.0f;
+                keyValues_.push_back(static_cast<uint16_t>(
+                    std::lround(std::clamp(normalized, 0.0f, 1.0f) * kVectorQuantMax)));
+            }
+        }
+    }
+
+    void BuildRotationTrack(const std::vector<Quaternion>& samples, float tolerance, Track& track) {
+        // 回転誤差（ラジアン）。acos(|dot|)は小角で精度が出ないので
+        // 単位クォータニオン間の弦長 |a - b| = 2 sin(θ/4) から求める
+        const auto angle = [](const Quaternion& a, const Quaternion& b) {
+            const Quaternion d = (a.Dot(b) < 0.0f) ? a + b : a - b;
+            return 4.0f * std::asin(std::min(1.0f, d.Length() * 0.5f));
+        };
+
+        if (IsConstant(samples, angle, tolerance)) {
+            if (angle(samples[0], Quaternion::Identity) <= tolerance) {
+                track.kind = TrackKind::Default;
+            } else {
+                track.kind = TrackKind::Constant;
+                track.value[0] = samples[0].x;
+                track.value[1] = samples[0].y;
+                track.value[2] = samples[0].z;
+                track.value[3] = samples[0].w;
+            }
+            return;
+        }
+
+        const std::vector<uint32_t> keys = ReduceKeys(samples, tolerance,
+            [](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::Lerp(a, b, t); },
+            angle);
+
+        BeginAnimatedTrack(track, keys.size());
+        for (uint32_t key : keys) {
+            uint16_t packed[3];
+            PackRotation(samples[key], packed);
+            keyFrames_.push_back(static_cast<uint16_t>(key));
+            keyValues_.insert(keyValues_.end(), packed, packed + 3);
+        }
+    }
+
+    void BeginAnimatedTrack(Track& track, size_t keyCount) {
+        track.kind = TrackKind::Animated;
+        track.cursorSlot = animatedTrackCount_++;
+        track.firstKey = static_cast<uint32_t>(keyFrames_.size());
+        track.keyCount = static_cast<uint32_t>(keyCount);
+    }
+
+    //! @brief 全サンプルが先頭から許容誤差内か
+    template<typename T, typename ErrorFunc>
+    static bool IsConstant(const std::vector<T>& samples, ErrorFunc error, float tolerance) {
+        for (const T& sample : samples) {
+            if (error(samples[0], sample) > tolerance) return false;
+        }
+        return true;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 誤差制限付きキー削減（貪欲法）
+    //!
+    //! 区間の始点から終点をできるだけ伸ばし、間の全フレームが
+    //! 始点・終点の補間で許容誤差内に収まる最長区間を採用する。
+    //! 先頭と末尾のフレームは必ず残る。
+    //------------------------------------------------------------------------
+    template<typename T, typename InterpFunc, typename ErrorFunc>
+    static std::vector<uint32_t> ReduceKeys(const std::vector<T>& samples, float tolerance,
+                                            InterpFunc interp, ErrorFunc error) {
+        const uint32_t count = static_cast<uint32_t>(samples.size());
+        std::vector<uint32_t> keys;
+        keys.push_back(0);
+
+        uint32_t start = 0;
+        while (start + 1 < count) {
+            uint32_t end = start + 1;
+            while (end + 1 < count) {
+                const uint32_t candidate = end + 1;
+                bool fits = true;
+                for (uint32_t i = start + 1; i < candidate && fits; ++i) {
+                    const float t = static_cast<float>(i - start) / static_cast<float>(candidate - start);
+                    fits = error(interp(samples[start], samples[candidate], t), samples[i]) <= tolerance;
+                }
+                if (!fits) break;
+                end = candidate;
+            }
+            keys.push_back(end);
+            start = end;
+        }
+        return keys;
+    }
+
+    //========================================================================
+    // サンプリング
+    //========================================================================
+
+    //! @brief カーソル位置から前後に歩いて frame を含む区間の先頭キーを返す
+    [[nodiscard]] uint32_t SeekKey(const Track& track, float frame, uint16_t* cursorKeys) const {
+        const uint16_t* frames = keyFrames_.data() + track.firstKey;
+        uint32_t key = cursorKeys[track.cursorSlot];
+        const uint32_t last = track.keyCount - 1;
+
+        if (frame < static_cast<float>(frames[key])) {
+            // 巻き戻り（ループ・往復）。先頭区間なら直接戻る
+            if (frame < static_cast<float>(frames[1])) {
+                key = 0;
+            } else {
+                while (key > 0 && frame < static_cast<float>(frames[key])) --key;
+            }
+        }
+        while (key + 1 < last && frame >= static_cast<float>(frames[key + 1])) ++key;
+
+        cursorKeys[track.cursorSlot] = static_cast<uint16_t>(key);
+        return key;
+    }
+
+    //! @brief 区間内の補間係数
+    [[nodiscard]] float SegmentAlpha(const Track& track, uint32_t key, float frame) const {
+        const uint16_t* frames = keyFrames_.data() + track.firstKey;
+        const float f0 = static_cast<float>(frames[key]);
+        const float f1 = static_cast<float>(frames[key + 1]);
+        return std::clamp((frame - f0) / (f1 - f0), 0.0f, 1.0f);
+    }
+
+    [[nodiscard]] Vector3 DecodeVector(const Track& track, uint32_t key) const {
+        const uint16_t* q = keyValues_.data() + static_cast<size_t>(track.firstKey + key) * 3;
+        return Vector3(
+            track.value[0] + track.extent[0] * (static_cast<float>(q[0]) / kVectorQuantMax),
+            track.value[1] + track.extent[1] * (static_cast<float>(q[1]) / kVectorQuantMax),
+            track.value[2] + track.extent[2] * (static_cast<float>(q[2]) / kVectorQuantMax));
+    }
+
+    [[nodiscard]] Vector3 SampleVector(const Track& track, float frame, uint16_t* cursorKeys,
+                                       const Vector3& defaultValue) const {
+        switch (track.kind) {
+            case TrackKind::Default:
+                return defaultValue;
+            case TrackKind::Constant:
+                return Vector3(track.value[0], track.value[1], track.value[2]);
+            case TrackKind::Animated:
+                break;
+        }
+        const uint32_t key = SeekKey(track, frame, cursorKeys);
+        return Vector3::Lerp(DecodeVector(track, key), DecodeVector(track, key + 1),
+                             SegmentAlpha(track, key, frame));
+    }
+
+    [[nodiscard]] Quaternion SampleRotation(const Track& track, float frame, uint16_t* cursorKeys) const {
+        switch (track.kind) {
+            case TrackKind::Default:
+                return Quaternion::Identity;
+            case TrackKind::Constant:
+                return Quaternion(track.value[0], track.value[1], track.value[2], track.value[3]);
+            case TrackKind::Animated:
+                break;
+        }
+        const uint32_t key = SeekKey(track, frame, cursorKeys);
+        const size_t offset = static_cast<size_t>(track.firstKey + key) * 3;
+        return Quaternion::Lerp(UnpackRotation(keyValues_.data() + offset),
+                                UnpackRotation(keyValues_.data() + offset + 3),
+                                SegmentAlpha(track, key, frame));
+    }
+
+private:
+    float duration_ = 0.0f;                 //!< 再生時間（秒）
+    float sampleRate_ = 30.0f;              //!< キー時刻の単位（フレーム/秒）
+    WrapMode wrapMode_ = WrapMode::Loop;    //!< ラップモード
+    uint32_t frameCount_ = 1;               //!< 再サンプリング後のフレーム数
+    uint32_t animatedTrackCount_ = 0;       //!< キーを持つトラック数
+
+    std::vector<Channel> channels_;         //!< 既定値でないチャンネル
+    std::vector<uint16_t> keyFrames_;       //!< 全トラックのキー時刻（フレーム番号）
+    std::vector<uint16_t> keyValues_;       //!< 全トラックのキー値（1キー3要素）
+};
+
+using CompressedAnimationClipPtr = std::shared_ptr<const CompressedAnimationClip>;
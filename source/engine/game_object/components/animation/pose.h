@@ -0,0 +1,300 @@
+//----------------------------------------------------------------------------
+//! @file   pose.h
+//! @brief  Pose - SoA形式のボーンローカルTRS
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "engine/math/math_types.h"
+#include "engine/memory/allocator.h"
+#include <immintrin.h>
+#include <cstdint>
+#include <vector>
+
+//============================================================================
+//! @brief Pose - ボーンローカルTRSのSoAビュー
+//!
+//! 平行移動・回転・スケールを成分ごとの float 配列（ストリーム）として持つ。
+//! 各ストリームはボーン数を4の倍数へ切り上げた長さで、余りのレーンは
+//! 恒等変換で埋めておくため、ブレンドは常に4ボーン単位でSIMD処理できる。
+//!
+//! メモリは所有しない（std::span と同じく浅いビュー）。
+//! 永続的なポーズは PoseBuffer、フレーム内の一時ポーズは
+//! FromAllocator() でスクラッチアロケータから確保する。
+//!
+//! 行列化は Skeleton::ComputeGlobalTransforms で1回だけ行う。
+//!
+//! @code
+//! auto& scratch = Memory::GetThreadScratchAllocator();
+//! Memory::ScopedStackMarker marker(scratch);
+//!
+//! Pose walk = Pose::FromAllocator(scratch, boneCount);
+//! Pose run = Pose::FromAllocator(scratch, boneCount);
+//! walk.SetIdentity();
+//! run.SetIdentity();
+//! walkClip->SamplePose(t0, walk);
+//! runClip->SamplePose(t1, run);
+//!
+//! Pose::Blend(walk, run, 0.3f, walk);
+//! skeleton->ComputeGlobalTransforms(walk, globalTransforms);
+//! @endcode
+//============================================================================
+class Pose {
+public:
+    //! @brief SIMDレーン幅（ストリーム長はこの倍数）
+    static constexpr uint32_t kLaneWidth = 4;
+
+    //! @brief ストリーム種別
+    enum Stream : uint32_t {
+        kTranslationX, kTranslationY, kTranslationZ,
+        kRotationX, kRotationY, kRotationZ, kRotationW,
+        kScaleX, kScaleY, kScaleZ,
+        kStreamCount
+    };
+
+    //------------------------------------------------------------------------
+    // 生成
+    //------------------------------------------------------------------------
+    Pose() = default;
+
+    //! @brief 外部メモリをビューとして使う
+    //! @param data GetRequiredFloats(boneCount) 個以上の float 領域
+    //! @param boneCount ボーン数
+    Pose(float* data, uint32_t boneCount) noexcept
+        : data_(data)
+        , boneCount_(boneCount)
+        , stride_(GetPaddedCount(boneCount)) {}
+
+    //! @brief アロケータから確保したポーズを作る（中身は未初期化）
+    //! @note 解放はアロケータ側（スタックマーカー等）に任せる
+    [[nodiscard]] static Pose FromAllocator(Memory::IAllocator& allocator, uint32_t boneCount) {
+        if (boneCount == 0) return Pose();
+        void* memory = allocator.Allocate(GetRequiredFloats(boneCount) * sizeof(float), 16);
+        if (!memory) return Pose();
+        return Pose(static_cast<float*>(memory), boneCount);
+    }
+
+    //! @brief 4の倍数へ切り上げたストリーム長
+    [[nodiscard]] static constexpr uint32_t GetPaddedCount(uint32_t boneCount) noexcept {
+        return (boneCount + kLaneWidth - 1) & ~(kLaneWidth - 1);
+    }
+
+    //! @brief ボーン数分のポーズに必要な float 数
+    [[nodiscard]] static constexpr size_t GetRequiredFloats(uint32_t boneCount) noexcept {
+        return static_cast<size_t>(GetPaddedCount(boneCount)) * kStreamCount;
+    }
+
+    //------------------------------------------------------------------------
+    // アクセス
+    //------------------------------------------------------------------------
+    [[nodiscard]] bool IsValid() const noexcept { return data_ != nullptr; }
+    [[nodiscard]] uint32_t GetBoneCount() const noexcept { return boneCount_; }
+    [[nodiscard]] uint32_t GetPaddedCount() const noexcept { return stride_; }
+
+    [[nodiscard]] float* GetStream(Stream stream) noexcept { return data_ + stream * stride_; }
+    [[nodiscard]] const float* GetStream(Stream stream) const noexcept { return data_ + stream * stride_; }
+
+    //! @brief 1ボーンのTRSを書き込む
+    void SetBone(uint32_t bone, const Vector3& translation, const Quaternion& rotation,
+                 const Vector3& scale) noexcept {
+        float* d = data_ + bone;
+        d[kTranslationX * stride_] = translation.x;
+        d[kTranslationY * stride_] = translation.y;
+        d[kTranslationZ * stride_] = translation.z;
+        d[kRotationX * stride_] = rotation.x;
+        d[kRotationY * stride_] = rotation.y;
+        d[kRotationZ * stride_] = rotation.z;
+        d[kRotationW * stride_] = rotation.w;
+        d[kScaleX * stride_] = scale.x;
+        d[kScaleY * stride_] = scale.y;
+        d[kScaleZ * stride_] = scale.z;
+    }
+
+    [[nodiscard]] Vector3 GetTranslation(uint32_t bone) const noexcept {
+        const float* d = data_ + bone;
+        return Vector3(d[kTranslationX * stride_], d[kTranslationY * stride_], d[kTranslationZ * stride_]);
+    }
+
+    [[nodiscard]] Quaternion GetRotation(uint32_t bone) const noexcept {
+        const float* d = data_ + bone;
+        return Quaternion(d[kRotationX * stride_], d[kRotationY * stride_],
+                          d[kRotationZ * stride_], d[kRotationW * stride_]);
+    }
+
+    [[nodiscard]] Vector3 GetScale(uint32_t bone) const noexcept {
+        const float* d = data_ + bone;
+        return Vector3(d[kScaleX * stride_], d[kScaleY * stride_], d[kScaleZ * stride_]);
+    }
+
+    //! @brief 1ボーンのローカル行列（Scale * Rotation * Translation）
+    //! @note 回転は正規化済みであること
+    [[nodiscard]] Matrix ToMatrix(uint32_t bone) const noexcept {
+        const float* d = data_ + bone;
+        const float qx = d[kRotationX * stride_];
+        const float qy = d[kRotationY * stride_];
+        const float qz = d[kRotationZ * stride_];
+        const float qw = d[kRotationW * stride_];
+        const float sx = d[kScaleX * stride_];
+        const float sy = d[kScaleY * stride_];
+        const float sz = d[kScaleZ * stride_];
+
+        const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+        const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+        const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+        return Matrix(
+            sx * (1.0f - 2.0f * (yy + zz)), sx * 2.0f * (xy + wz), sx * 2.0f * (xz - wy), 0.0f,
+            sy * 2.0f * (xy - wz), sy * (1.0f - 2.0f * (xx + zz)), sy * 2.0f * (yz + wx), 0.0f,
+            sz * 2.0f * (xz + wy), sz * 2.0f * (yz - wx), sz * (1.0f - 2.0f * (xx + yy)), 0.0f,
+            d[kTranslationX * stride_], d[kTranslationY * stride_], d[kTranslationZ * stride_], 1.0f);
+    }
+
+    //------------------------------------------------------------------------
+    // 一括操作
+    //------------------------------------------------------------------------
+
+    //! @brief 全ボーン（パディング含む）を恒等変換にする
+    void SetIdentity() noexcept {
+        for (uint32_t s = 0; s < kStreamCount; ++s) {
+            const float value = (s == kRotationW || s >= kScaleX) ? 1.0f : 0.0f;
+            const __m128 v = _mm_set1_ps(value);
+            float* stream = data_ + s * stride_;
+            for (uint32_t i = 0; i < stride_; i += kLaneWidth) {
+                _mm_storeu_ps(stream + i, v);
+            }
+        }
+    }
+
+    //! @brief 同じボーン数のポーズから全ストリームをコピー
+    void CopyFrom(const Pose& source) noexcept {
+        const size_t count = static_cast<size_t>(stride_) * kStreamCount;
+        for (size_t i = 0; i < count; i += kLaneWidth) {
+            _mm_storeu_ps(data_ + i, _mm_loadu_ps(source.data_ + i));
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 2つのポーズをブレンド（4ボーンずつSIMD）
+    //!
+    //! 平行移動・スケールは線形補間、回転は最短弧へ符号をそろえた nlerp。
+    //! 隣接フレームやクロスフェード程度の角度差では slerp との差は小さく、
+    //! acos/sin を使わずに済む。
+    //!
+    //! @param a ウェイト0側
+    //! @param b ウェイト1側
+    //! @param t bのウェイト（0〜1）
+    //! @param out 出力（a または b と同じでもよい）
+    //------------------------------------------------------------------------
+    static void Blend(const Pose& a, const Pose& b, float t, Pose& out) noexcept {
+        const uint32_t stride = out.stride_;
+        const __m128 wb = _mm_set1_ps(t);
+        const __m128 wa = _mm_set1_ps(1.0f - t);
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        // 平行移動・スケール
+        static constexpr Stream kLinearStreams[] = {
+            kTranslationX, kTranslationY, kTranslationZ, kScaleX, kScaleY, kScaleZ
+        };
+        for (Stream s : kLinearStreams) {
+            const float* pa = a.data_ + s * stride;
+            const float* pb = b.data_ + s * stride;
+            float* po = out.data_ + s * stride;
+            for (uint32_t i = 0; i < stride; i += kLaneWidth) {
+                const __m128 va = _mm_loadu_ps(pa + i);
+                const __m128 vb = _mm_loadu_ps(pb + i);
+                _mm_storeu_ps(po + i, _mm_add_ps(_mm_mul_ps(va, wa), _mm_mul_ps(vb, wb)));
+            }
+        }
+
+        // 回転（nlerp）
+        const float* ax = a.data_ + kRotationX * stride;
+        const float* ay = a.data_ + kRotationY * stride;
+        const float* az = a.data_ + kRotationZ * stride;
+        const float* aw = a.data_ + kRotationW * stride;
+        const float* bx = b.data_ + kRotationX * stride;
+        const float* by = b.data_ + kRotationY * stride;
+        const float* bz = b.data_ + kRotationZ * stride;
+        const float* bw = b.data_ + kRotationW * stride;
+        float* ox = out.data_ + kRotationX * stride;
+        float* oy = out.data_ + kRotationY * stride;
+        float* oz = out.data_ + kRotationZ * stride;
+        float* ow = out.data_ + kRotationW * stride;
+
+        for (uint32_t i = 0; i < stride; i += kLaneWidth) {
+            const __m128 qax = _mm_loadu_ps(ax + i), qay = _mm_loadu_ps(ay + i);
+            const __m128 qaz = _mm_loadu_ps(az + i), qaw = _mm_loadu_ps(aw + i);
+            __m128 qbx = _mm_loadu_ps(bx + i), qby = _mm_loadu_ps(by + i);
+            __m128 qbz = _mm_loadu_ps(bz + i), qbw = _mm_loadu_ps(bw + i);
+
+            // 内積が負なら b を反転して最短弧にする
+            const __m128 dot = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(qax, qbx), _mm_mul_ps(qay, qby)),
+                _mm_add_ps(_mm_mul_ps(qaz, qbz), _mm_mul_ps(qaw, qbw)));
+            const __m128 flip = _mm_and_ps(dot, signMask);
+            qbx = _mm_xor_ps(qbx, flip);
+            qby = _mm_xor_ps(qby, flip);
+            qbz = _mm_xor_ps(qbz, flip);
+            qbw = _mm_xor_ps(qbw, flip);
+
+            const __m128 rx = _mm_add_ps(_mm_mul_ps(qax, wa), _mm_mul_ps(qbx, wb));
+            const __m128 ry = _mm_add_ps(_mm_mul_ps(qay, wa), _mm_mul_ps(qby, wb));
+            const __m128 rz = _mm_add_ps(_mm_mul_ps(qaz, wa), _mm_mul_ps(qbz, wb));
+            const __m128 rw = _mm_add_ps(_mm_mul_ps(qaw, wa), _mm_mul_ps(qbw, wb));
+
+            const __m128 lengthSq = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+            const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+
+            _mm_storeu_ps(ox + i, _mm_mul_ps(rx, invLength));
+            _mm_storeu_ps(oy + i, _mm_mul_ps(ry, invLength));
+            _mm_storeu_ps(oz + i, _mm_mul_ps(rz, invLength));
+            _mm_storeu_ps(ow + i, _mm_mul_ps(rw, invLength));
+        }
+    }
+
+private:
+    float* data_ = nullptr;         //!< ストリーム先頭（stride_ * kStreamCount 個）
+    uint32_t boneCount_ = 0;        //!< ボーン数
+    uint32_t stride_ = 0;           //!< 1ストリームの長さ（4の倍数）
+};
+
+//============================================================================
+//! @brief PoseBuffer - メモリを所有するポーズ
+//!
+//! Animatorのローカルポーズなど、フレームをまたいで保持するポーズ用。
+//============================================================================
+class PoseBuffer {
+public:
+    PoseBuffer() = default;
+
+    explicit PoseBuffer(uint32_t boneCount) {
+        Resize(boneCount);
+    }
+
+    //! @brief ボーン数を変更して恒等変換で初期化
+    void Resize(uint32_t boneCount) {
+        boneCount_ = boneCount;
+        storage_.assign(Pose::GetRequiredFloats(boneCount), 0.0f);
+        if (boneCount > 0) {
+            GetPose().SetIdentity();
+        }
+    }
+
+    [[nodiscard]] uint32_t GetBoneCount() const noexcept { return boneCount_; }
+    [[nodiscard]] bool IsEmpty() const noexcept { return boneCount_ == 0; }
+
+    //! @brief ポーズのビューを取得
+    [[nodiscard]] Pose GetPose() noexcept {
+        return Pose(storage_.data(), boneCount_);
+    }
+
+    //! @brief 読み取り専用のビューを取得
+    [[nodiscard]] const Pose GetPose() const noexcept {
+        return Pose(const_cast<float*>(storage_.data()), boneCount_);
+    }
+
+private:
+    std::vector<float> storage_;    //!< ストリーム本体
+    uint32_t boneCount_ = 0;        //!< ボーン数
+};
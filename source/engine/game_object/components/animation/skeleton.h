@@ -6,9 +6,12 @@
 
 
 #include "engine/math/math_types.h"
+#include "pose.h"
+#include "bone_mask.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 //============================================================================
 //! @brief ボーン情報
@@ -54,11 +57,11 @@ struct Bone {
 //! skeleton->ComputeInverseBindMatrices();
 //!
 //! // アニメーション適用後、スキニング行列を計算
-//! std::vector<Matrix> localTransforms = ...;  // アニメーションからサンプリング
+//! Pose localPose = ...;  // アニメーションからサンプリング（SoA TRS）
 //! std::vector<Matrix> globalTransforms;
 //! std::vector<Matrix> skinningMatrices;
 //!
-//! skeleton->ComputeGlobalTransforms(localTransforms, globalTransforms);
+//! skeleton->ComputeGlobalTransforms(localPose, globalTransforms);
 //! skeleton->ComputeSkinningMatrices(globalTransforms, skinningMatrices);
 //! // skinningMatricesをGPUに送信
 //! @endcode
@@ -183,6 +186,31 @@ public:
         }
     }
 
+    //! @brief ローカルポーズ（SoA TRS）からグローバルTransformを計算
+    //!
+    //! ボーンごとにTRSから行列を1回だけ組み立て、そのまま親と合成する。
+    //! ブレンドはPose上で済ませておき、行列化はここに集約する。
+    //!
+    //! @param localPose ローカルポーズ（ボーン数が一致すること）
+    //! @param globalOut グローバル変換行列配列（出力）
+    //! @param mask 評価するボーン（無効なボーンはポーズを見ずにバインドポーズで親に追従）
+    void ComputeGlobalTransforms(
+        const Pose& localPose,
+        std::vector<Matrix>& globalOut,
+        const BoneMask* mask = nullptr) const {
+
+        if (bones_.empty()) return;
+        if (localPose.GetBoneCount() != bones_.size()) return;
+
+        globalOut.resize(bones_.size());
+
+        for (size_t i = 0; i < bones_.size(); ++i) {
+            const Matrix local = GetLocalMatrix(localPose, static_cast<uint32_t>(i), mask);
+            const int parent = bones_[i].parentIndex;
+            globalOut[i] = (parent < 0) ? local : local * globalOut[parent];
+        }
+    }
+
     //! @brief グローバルTransformからスキニング行列を計算
     //!
     //! スキニング行列 = 逆バインド行列 × グローバル変換行列
@@ -205,10 +233,52 @@ public:
         }
     }
 
+    //! @brief ローカルポーズから呼び出し側のバッファへスキニング行列を計算
+    //!
+    //! グローバル行列の作業領域と出力先を呼び出し側が用意する版（いずれもボーン数分）。
+    //! ヒープ確保をしないので、ECSのようにインスタンスごとの出力先が
+    //! すでにある場合や、ワーカースレッドから呼ぶ場合に使う。
+    //!
+    //! @param localPose ローカルポーズ（ボーン数が一致すること）
+    //! @param globalOut グローバル変換行列の出力先
+    //! @param skinningOut スキニング行列の出力先
+    //! @param mask 評価するボーン（nullptr = 全ボーン）
+    void ComputeSkinningMatrices(
+        const Pose& localPose,
+        Matrix* globalOut,
+        Matrix* skinningOut,
+        const BoneMask* mask = nullptr) const {
+
+        if (localPose.GetBoneCount() != bones_.size()) return;
+
+        for (size_t i = 0; i < bones_.size(); ++i) {
+            const Bone& bone = bones_[i];
+            const Matrix local = GetLocalMatrix(localPose, static_cast<uint32_t>(i), mask);
+            globalOut[i] = (bone.parentIndex < 0) ? local : local * globalOut[bone.parentIndex];
+            skinningOut[i] = bone.inverseBindMatrix * globalOut[i];
+        }
+    }
+
     //========================================================================
     // ユーティリティ
     //========================================================================
 
+    //! @brief ルートからの深さでボーンマスクを作成
+    //! @param maxDepth 有効にする最大の深さ（ルート = 0）
+    //! @return 深さmaxDepthまでのボーンが有効なマスク
+    //!
+    //! ボーンは親より後に追加されている前提（AddBoneの順序）。
+    [[nodiscard]] BoneMask CreateDepthMask(int maxDepth) const {
+        BoneMask mask(static_cast<uint32_t>(bones_.size()), false);
+        std::vector<int> depth(bones_.size(), 0);
+        for (size_t i = 0; i < bones_.size(); ++i) {
+            const int parent = bones_[i].parentIndex;
+            depth[i] = (parent < 0) ? 0 : depth[parent] + 1;
+            mask.Set(static_cast<uint32_t>(i), depth[i] <= maxDepth);
+        }
+        return mask;
+    }
+
     //! @brief ボーンの子インデックスリストを取得
     //! @param parentIndex 親ボーンインデックス
     //! @return 子ボーンインデックスのリスト
@@ -240,6 +310,11 @@ public:
     }
 
 private:
+    //! @brief ボーンのローカル行列（マスクで無効ならバインドポーズ）
+    [[nodiscard]] Matrix GetLocalMatrix(const Pose& localPose, uint32_t bone, const BoneMask* mask) const {
+        return IsBoneEnabled(mask, bone) ? localPose.ToMatrix(bone) : bones_[bone].localBindPose;
+    }
+
     std::vector<Bone> bones_;                           //!< ボーン配列
     std::unordered_map<std::string, int> boneNameToIndex_;  //!< 名前→インデックスマップ
 };
@@ -9,12 +9,21 @@
 #include "engine/math/math_types.h"
 #include "transform.h"
 #include "animation/skeleton.h"
+#include "animation/pose.h"
 #include "animation/animation_clip.h"
+#include "animation/compressed_clip.h"
 #include "animation/animator_controller.h"
 #include "animation/animator_state_info.h"
+#include "animation/animation_lod.h"
+#include "animation/bone_mask.h"
+#include "engine/ecs/components/rendering/lod_range_data.h"
+#include "engine/memory/memory_system.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <vector>
 #include <memory>
+#include <utility>
 
 //============================================================================
 //! @brief レイヤー再生状態
@@ -31,6 +40,10 @@ struct LayerPlaybackState {
     float blendDuration = 0.0f;         //!< ブレンド時間
     float blendElapsed = 0.0f;          //!< ブレンド経過時間
 
+    // 圧縮クリップの再生カーソル
+    AnimationClipCursor cursor;         //!< 現在ステート用
+    AnimationClipCursor previousCursor; //!< 前ステート用（ブレンド中）
+
     LayerPlaybackState() = default;
 
     //! @brief ブレンドを開始
@@ -41,6 +54,8 @@ struct LayerPlaybackState {
         previousNormalizedTime = normalizedTime;
         currentStateIndex = newStateIndex;
         normalizedTime = 0.0f;
+        std::swap(previousCursor, cursor);
+        cursor.Reset();
 
         isBlending = true;
         blendWeight = 0.0f;
@@ -181,7 +196,7 @@ public:
         skeleton_ = std::move(skeleton);
         if (skeleton_) {
             size_t boneCount = skeleton_->GetBoneCount();
-            localBoneTransforms_.resize(boneCount, Matrix::Identity);
+            localPose_.Resize(static_cast<uint32_t>(boneCount));
             globalBoneTransforms_.resize(boneCount, Matrix::Identity);
             skinningMatrices_.resize(boneCount, Matrix::Identity);
         }
@@ -379,8 +394,8 @@ public:
 
     //! @brief ボーンのローカルTransformを取得
     [[nodiscard]] Matrix GetBoneLocalTransform(int boneIndex) const {
-        if (boneIndex >= 0 && boneIndex < static_cast<int>(localBoneTransforms_.size())) {
-            return localBoneTransforms_[boneIndex];
+        if (boneIndex >= 0 && boneIndex < static_cast<int>(localPose_.GetBoneCount())) {
+            return localPose_.GetPose().ToMatrix(static_cast<uint32_t>(boneIndex));
         }
         return Matrix::Identity;
     }
@@ -395,11 +410,19 @@ public:
 
     //! @brief ボーンのローカルTransformを設定（IK用）
     void SetBoneLocalTransform(int boneIndex, const Matrix& transform) {
-        if (boneIndex >= 0 && boneIndex < static_cast<int>(localBoneTransforms_.size())) {
-            localBoneTransforms_[boneIndex] = transform;
+        if (boneIndex >= 0 && boneIndex < static_cast<int>(localPose_.GetBoneCount())) {
+            Vector3 scale, translation;
+            Quaternion rotation;
+            Matrix(transform).Decompose(scale, rotation, translation);
+            localPose_.GetPose().SetBone(static_cast<uint32_t>(boneIndex), translation, rotation, scale);
         }
     }
 
+    //! @brief ローカルポーズ（SoA TRS）を取得
+    [[nodiscard]] const PoseBuffer& GetLocalPose() const noexcept {
+        return localPose_;
+    }
+
     //========================================================================
     // スキニング行列（レンダラー用）
     //========================================================================
@@ -441,6 +464,40 @@ public:
     [[nodiscard]] Vector3 GetDeltaPosition() const noexcept { return deltaPosition_; }
     [[nodiscard]] Quaternion GetDeltaRotation() const noexcept { return deltaRotation_; }
 
+    //========================================================================
+    // アニメーションLOD
+    //
+    // 有効にすると、視点からの距離に応じてポーズの評価を2/4フレームに1回へ間引き、
+    // 最遠レベルではボーンマスクで評価するボーンを絞る。画面外では評価を止め、
+    // 復帰時は停止していたポーズから補間する。ステートマシンと再生時間は常に進む。
+    //========================================================================
+
+    [[nodiscard]] bool IsLODEnabled() const noexcept { return lodEnabled_; }
+    void SetLODEnabled(bool enabled) noexcept { lodEnabled_ = enabled; }
+
+    [[nodiscard]] const AnimationLODSettings& GetLODSettings() const noexcept { return lodSettings_; }
+    void SetLODSettings(const AnimationLODSettings& settings) noexcept { lodSettings_ = settings; }
+
+    //! @brief 表示距離範囲を設定（LODSystemと同じく、範囲外は画面外として停止）
+    void SetLODRange(const ECS::LODRangeData& range) noexcept { lodRange_ = range; }
+
+    //! @brief 最遠レベルで評価するボーン（nullptr = 全ボーン）
+    void SetLODBoneMask(std::shared_ptr<const BoneMask> mask) { lodBoneMask_ = std::move(mask); }
+
+    //! @brief 評価フレームの位相（既定は生成順に割り振られる）
+    void SetLODPhase(uint32_t phase) noexcept { lodPhase_ = phase; }
+
+    //! @brief 視点を設定（毎フレーム、Updateより前に呼ぶ）
+    //! @param cameraPosition アクティブカメラの位置
+    //! @param onScreen 視錐台カリングの結果など（falseなら評価を止める）
+    void SetLODViewer(const Vector3& cameraPosition, bool onScreen = true) noexcept {
+        lodViewerPosition_ = cameraPosition;
+        lodOnScreen_ = onScreen;
+    }
+
+    [[nodiscard]] AnimationLODLevel GetLODLevel() const noexcept { return lodState_.level; }
+    [[nodiscard]] bool IsLODFrozen() const noexcept { return lodState_.frozen; }
+
     //========================================================================
     // レイヤー情報
     //========================================================================
@@ -494,10 +551,29 @@ private:
             UpdateLayer(static_cast<int>(i), dt);
         }
 
+        // 間引かれたフレーム・画面外では前回のポーズを保持
+        if (lodEnabled_ && !AdvanceLOD(dt)) return;
+
         // ボーンポーズを計算
         ComputeFinalPose();
     }
 
+    //! @brief LOD状態を進め、このフレームにポーズを評価するかを返す
+    //!
+    //! 距離はLODSystemと同じく、視点とワールド位置の直線距離（Transformがなければ原点）。
+    bool AdvanceLOD(float dt) {
+        const Vector3 position = transform_ ? transform_->GetWorldPosition() : Vector3::Zero;
+        const float distance = Vector3::Distance(position, lodViewerPosition_);
+        const bool visible = lodOnScreen_ && lodRange_.IsInRange(distance);
+        return lodState_.Advance(lodSettings_, distance, visible, lodFrame_++, lodPhase_, dt);
+    }
+
+    //! @brief 生成順に評価フレームの位相を割り振る
+    static uint32_t NextLODPhase() noexcept {
+        static std::atomic<uint32_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
     void UpdateLayer(int layerIndex, float dt) {
         auto* layerDef = controller_->GetLayer(layerIndex);
         if (!layerDef) return;
@@ -604,17 +680,33 @@ private:
         }
     }
 
+    //! @brief 全レイヤーを合成してボーン行列を更新
+    //!
+    //! クリップはキー（圧縮済みならカーソル）から直接SoAのTRSへサンプリングし、クロスフェードと
+    //! レイヤーブレンドはPose::Blend（4ボーンずつSIMD）で行う。
+    //! 一時ポーズはスレッドごとのスクラッチから確保するのでヒープ確保はない。
+    //! 行列化はSkeleton::ComputeGlobalTransformsの1回だけ。
     void ComputeFinalPose() {
-        if (!skeleton_ || localBoneTransforms_.empty()) return;
+        if (!skeleton_ || localPose_.IsEmpty()) return;
 
-        // 各レイヤーのポーズを合成
-        std::fill(localBoneTransforms_.begin(), localBoneTransforms_.end(), Matrix::Identity);
+        const uint32_t boneCount = localPose_.GetBoneCount();
+        Pose finalPose = localPose_.GetPose();
+        finalPose.SetIdentity();
 
+        auto& scratch = Memory::GetThreadScratchAllocator();
+        Memory::ScopedStackMarker marker(scratch);
+        Pose layerPose = Pose::FromAllocator(scratch, boneCount);
+        Pose prevPose = Pose::FromAllocator(scratch, boneCount);
+        if (!layerPose.IsValid() || !prevPose.IsValid()) return;
+
+        const BoneMask* mask = (lodEnabled_ && lodState_.UsesBoneMask()) ? lodBoneMask_.get() : nullptr;
+
+        // 各レイヤーのポーズを合成
         for (size_t layerIdx = 0; layerIdx < layerStates_.size(); ++layerIdx) {
             auto* layerDef = controller_->GetLayer(static_cast<int>(layerIdx));
             if (!layerDef) continue;
 
-            const auto& playback = layerStates_[layerIdx];
+            auto& playback = layerStates_[layerIdx];
             float layerWeight = layerDef->weight;
 
             if (layerWeight <= 0.0f) continue;
@@ -622,104 +714,71 @@ private:
             // 現在ステートをサンプリング
             auto* currentState = layerDef->GetState(playback.currentStateIndex);
             if (currentState && currentState->clip) {
-                std::vector<Matrix> currentPose(skeleton_->GetBoneCount(), Matrix::Identity);
-                currentState->clip->SamplePose(
-                    playback.normalizedTime * currentState->clip->duration,
-                    currentPose);
+                SampleClip(*currentState->clip, playback.normalizedTime, playback.cursor, layerPose, mask);
 
                 // ブレンド中の場合
                 if (playback.isBlending && playback.previousStateIndex >= 0) {
                     auto* prevState = layerDef->GetState(playback.previousStateIndex);
                     if (prevState && prevState->clip) {
-                        std::vector<Matrix> prevPose(skeleton_->GetBoneCount(), Matrix::Identity);
-                        prevState->clip->SamplePose(
-                            playback.previousNormalizedTime * prevState->clip->duration,
-                            prevPose);
+                        SampleClip(*prevState->clip, playback.previousNormalizedTime,
+                                   playback.previousCursor, prevPose, mask);
 
                         // ポーズをブレンド
-                        for (size_t i = 0; i < currentPose.size(); ++i) {
-                            currentPose[i] = BlendMatrix(prevPose[i], currentPose[i], playback.blendWeight);
-                        }
+                        Pose::Blend(prevPose, layerPose, playback.blendWeight, layerPose);
                     }
                 }
 
                 // レイヤーブレンド（最初のレイヤーは上書き、以降はブレンド）
                 if (layerIdx == 0 || layerDef->blendingMode == LayerBlendingMode::Override) {
-                    for (size_t i = 0; i < currentPose.size(); ++i) {
-                        if (layerWeight >= 1.0f) {
-                            localBoneTransforms_[i] = currentPose[i];
-                        } else {
-                            localBoneTransforms_[i] = BlendMatrix(localBoneTransforms_[i], currentPose[i], layerWeight);
-                        }
+                    if (layerWeight >= 1.0f) {
+                        finalPose.CopyFrom(layerPose);
+                    } else {
+                        Pose::Blend(finalPose, layerPose, layerWeight, finalPose);
                     }
                 }
                 // Additiveモードは将来実装
             }
         }
 
-        // グローバル変換を計算
-        skeleton_->ComputeGlobalTransforms(localBoneTransforms_, globalBoneTransforms_);
+        // 画面外からの復帰中は、停止していた行列を退避して補間する
+        const float resumeWeight = lodEnabled_ ? lodState_.resumeWeight : 0.0f;
+        Matrix* held = nullptr;
+        if (resumeWeight > 0.0f && globalBoneTransforms_.size() == boneCount) {
+            held = static_cast<Matrix*>(scratch.Allocate(sizeof(Matrix) * boneCount * 2, 16));
+            if (held) {
+                std::copy(globalBoneTransforms_.begin(), globalBoneTransforms_.end(), held);
+                std::copy(skinningMatrices_.begin(), skinningMatrices_.end(), held + boneCount);
+            }
+        }
+
+        // グローバル変換を計算（ここで初めて行列化）
+        skeleton_->ComputeGlobalTransforms(finalPose, globalBoneTransforms_, mask);
 
         // スキニング行列を計算
         skeleton_->ComputeSkinningMatrices(globalBoneTransforms_, skinningMatrices_);
+
+        if (held) {
+            for (uint32_t i = 0; i < boneCount; ++i) {
+                globalBoneTransforms_[i] = Matrix::Lerp(globalBoneTransforms_[i], held[i], resumeWeight);
+                skinningMatrices_[i] = Matrix::Lerp(skinningMatrices_[i], held[boneCount + i], resumeWeight);
+            }
+        }
     }
 
-    //! @brief 行列のブレンド（TRS分解 + 回転はSlerp）
+    //! @brief クリップを恒等ポーズの上にサンプリング
     //!
-    //! 行列を Translation, Rotation, Scale に分解し、
-    //! T/S は線形補間、R は球面線形補間（Slerp）でブレンドする。
-    static Matrix BlendMatrix(const Matrix& a, const Matrix& b, float t) {
-        // 行列をTRS分解
-        Vector3 scaleA, scaleB;
-        Quaternion rotA, rotB;
-        Vector3 transA, transB;
-
-        // 行列からTRSを抽出
-        DecomposeMatrix(a, transA, rotA, scaleA);
-        DecomposeMatrix(b, transB, rotB, scaleB);
-
-        // Translation: 線形補間
-        Vector3 trans = Vector3::Lerp(transA, transB, t);
-
-        // Rotation: 球面線形補間（Slerp）
-        Quaternion rot = Quaternion::Slerp(rotA, rotB, t);
-
-        // Scale: 線形補間
-        Vector3 scale = Vector3::Lerp(scaleA, scaleB, t);
-
-        // TRSから行列を再構築
-        return Matrix::CreateScale(scale) *
-               Matrix::CreateFromQuaternion(rot) *
-               Matrix::CreateTranslation(trans);
-    }
-
-    //! @brief 行列をTranslation, Rotation, Scaleに分解
-    static void DecomposeMatrix(const Matrix& m, Vector3& translation, Quaternion& rotation, Vector3& scale) {
-        // Translation: 行列の最後の列
-        translation = Vector3(m._41, m._42, m._43);
-
-        // Scale: 各軸ベクトルの長さ
-        Vector3 axisX(m._11, m._12, m._13);
-        Vector3 axisY(m._21, m._22, m._23);
-        Vector3 axisZ(m._31, m._32, m._33);
-
-        scale.x = axisX.Length();
-        scale.y = axisY.Length();
-        scale.z = axisZ.Length();
-
-        // 回転行列を抽出（スケールを除去）
-        if (scale.x > 0.0001f) axisX = axisX / scale.x;
-        if (scale.y > 0.0001f) axisY = axisY / scale.y;
-        if (scale.z > 0.0001f) axisZ = axisZ / scale.z;
-
-        // 回転行列からクォータニオンへ
-        Matrix rotMatrix(
-            axisX.x, axisX.y, axisX.z, 0,
-            axisY.x, axisY.y, axisY.z, 0,
-            axisZ.x, axisZ.y, axisZ.z, 0,
-            0, 0, 0, 1
-        );
-        rotation = Quaternion::CreateFromRotationMatrix(rotMatrix);
+    //! 圧縮済みならカーソルを使って区間を前後に歩くだけで済ませ、
+    //! そうでなければ元のキーを二分探索する。
+    static void SampleClip(const AnimationClip& clip, float normalizedTime,
+                           AnimationClipCursor& cursor, Pose& outPose,
+                           const BoneMask* mask = nullptr) {
+        outPose.SetIdentity();
+        const float time = normalizedTime * clip.duration;
+        if (clip.compressed) {
+            clip.compressed->SamplePose(time, cursor, outPose, mask);
+        } else {
+            clip.SamplePose(time, outPose, mask);
+        }
     }
 
     //------------------------------------------------------------------------
@@ -736,7 +795,7 @@ private:
     std::vector<LayerPlaybackState> layerStates_;
 
     // ボーンTransform
-    std::vector<Matrix> localBoneTransforms_;
+    PoseBuffer localPose_;
     std::vector<Matrix> globalBoneTransforms_;
     std::vector<Matrix> skinningMatrices_;
 
@@ -748,6 +807,17 @@ private:
     bool applyRootMotion_ = false;
     Vector3 deltaPosition_ = Vector3::Zero;
     Quaternion deltaRotation_ = Quaternion::Identity;
+
+    // アニメーションLOD
+    bool lodEnabled_ = false;
+    bool lodOnScreen_ = true;
+    AnimationLODSettings lodSettings_;
+    AnimationLODState lodState_;
+    ECS::LODRangeData lodRange_ = ECS::LODRangeData::Unlimited();
+    std::shared_ptr<const BoneMask> lodBoneMask_;
+    Vector3 lodViewerPosition_ = Vector3::Zero;
+    uint32_t lodFrame_ = 0;
+    uint32_t lodPhase_ = NextLODPhase();
 };
 
 OOP_COMPONENT(Animator);
@@ -6,6 +6,7 @@
 
 
 #include "allocator.h"
+#include <algorithm>
 #include <mutex>
 #include <cstdlib>
 #include <cstring>
@@ -259,8 +260,9 @@ private:
 #if defined(_WIN32)
         return _aligned_malloc(size, alignment);
 #else
+        // posix_memalignはsizeof(void*)未満のアラインメントを受け付けない
         void* ptr = nullptr;
-        if (posix_memalign(&ptr, alignment, size) != 0) {
+        if (posix_memalign(&ptr, (std::max)(alignment, sizeof(void*)), size) != 0) {
             return nullptr;
         }
         return ptr;
@@ -11,6 +11,7 @@
 #include "heap_allocator.h"
 #include "linear_allocator.h"
 #include "pool_allocator.h"
+#include "stack_allocator.h"
 
 namespace Memory {
 
@@ -28,6 +29,9 @@ public:
     //! フレームアロケータのデフォルト容量（1MB）
     static constexpr size_t kFrameAllocatorCapacity = 1 * 1024 * 1024;
 
+    //! スレッドごとのスクラッチ容量（256KB）
+    static constexpr size_t kThreadScratchCapacity = 256 * 1024;
+
     //! ECS Chunkプール用ブロックサイズ（16KB）
     //! @note ECS::Chunkは純粋な16KBバッファ（sizeof(Chunk) == 16KB保証）
     static constexpr size_t kChunkBlockSize = 16 * 1024;
@@ -195,6 +199,26 @@ private:
     return MemorySystem::Get().GetFrame();
 }
 
+//----------------------------------------------------------------------------
+//! @brief 呼び出しスレッド専用のスクラッチアロケータを取得
+//!
+//! フレームアロケータはメインスレッド専用のため、ジョブ内の一時バッファは
+//! こちらを使う。スレッドごとに初回呼び出しで作成され、スレッド終了まで保持。
+//! MemorySystemの初期化とは独立して使える。
+//!
+//! @code
+//! auto& scratch = Memory::GetThreadScratchAllocator();
+//! Memory::ScopedStackMarker marker(scratch);   // スコープ終了で解放
+//! void* temp = scratch.Allocate(size, 16);
+//! @endcode
+//!
+//! @return スレッドローカルなスタックアロケータへの参照
+//----------------------------------------------------------------------------
+[[nodiscard]] inline StackAllocator& GetThreadScratchAllocator() {
+    thread_local StackAllocator allocator(MemorySystem::kThreadScratchCapacity);
+    return allocator;
+}
+
 //----------------------------------------------------------------------------
 //! @brief Chunkプールを取得（ショートカット）
 //! @return Chunkプールへの参照
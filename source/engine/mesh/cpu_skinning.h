@@ -0,0 +1,243 @@
+//----------------------------------------------------------------------------
+//! @file   cpu_skinning.h
+//! @brief  CPUスキニング - スキン頂点をスキニング行列で変形（SSE/AVX・JobSystem並列）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "vertex_format.h"
+#include "engine/core/job_system.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+//============================================================================
+//! @brief CPUスキニング
+//!
+//! スキンメッシュシェーダー（skinned_mesh_vs.hlsl）と同じ4ボーンの線形ブレンドで、
+//! 頂点位置と法線をCPU上で変形する。当たり判定（MeshCollider::Refit）や
+//! 布の接続点など、変形後の頂点をCPUで参照する処理向け。
+//!
+//! - 4頂点ずつ処理する。頂点ごとに4ボーンの行列をウェイトで合成してから変換する
+//!   （AVX有効時は2頂点分の行を__m256で同時に合成する）
+//! - 法線は行列の3x3部分で変換し、4頂点まとめて正規化する
+//! - kMinParallelVertices以上でJobSystemがあれば、kVerticesPerBlock単位で並列化する
+//!
+//! @code
+//! std::vector<Vector3> positions(mesh->GetVertexCount());
+//! std::vector<Vector3> normals(mesh->GetVertexCount());
+//! CpuSkinning::Skin(mesh->GetCpuVertices(), animator->GetSkinningMatrices(), positions, normals);
+//! @endcode
+//============================================================================
+namespace CpuSkinning {
+
+//! @brief この頂点数以上でJobSystemがあれば並列化
+inline constexpr uint32_t kMinParallelVertices = 4096;
+
+//! @brief 並列化の分割単位（頂点数、4の倍数）
+inline constexpr uint32_t kVerticesPerBlock = 1024;
+
+static_assert(kVerticesPerBlock % 4 == 0, "Block size must be a multiple of 4");
+
+namespace detail {
+
+//! @brief パックされたボーンインデックスを取り出す（範囲外は最後の行列に丸める）
+[[nodiscard]] inline uint32_t BoneIndex(uint32_t packed, int slot, uint32_t maxIndex) noexcept {
+    return (std::min)((packed >> (slot * 8)) & 0xFFu, maxIndex);
+}
+
+//! @brief 行列の行を読み込む
+[[nodiscard]] inline __m128 LoadRow(const Matrix& m, int row) noexcept {
+    return _mm_loadu_ps(&m._11 + row * 4);
+}
+
+//! @brief 1頂点分の行列を4ボーンのウェイトで合成
+inline void BlendRows(const SkinnedMeshVertex& v, const Matrix* matrices, uint32_t maxIndex,
+                      __m128 rows[4]) noexcept {
+    const float* weights = &v.boneWeights.x;
+    rows[0] = rows[1] = rows[2] = rows[3] = _mm_setzero_ps();
+    for (int k = 0; k < 4; ++k) {
+        const Matrix& m = matrices[BoneIndex(v.boneIndices, k, maxIndex)];
+        const __m128 w = _mm_set1_ps(weights[k]);
+        for (int r = 0; r < 4; ++r) {
+            rows[r] = _mm_add_ps(rows[r], _mm_mul_ps(w, LoadRow(m, r)));
+        }
+    }
+}
+
+//! @brief 点を変換（行ベクトル × 行列、w = 1）
+[[nodiscard]] inline __m128 TransformPoint(__m128 p, const __m128 rows[4]) noexcept {
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), rows[0]);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), rows[1]));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), rows[2]));
+    return _mm_add_ps(r, rows[3]);
+}
+
+//! @brief 方向を変換（3x3部分のみ）
+[[nodiscard]] inline __m128 TransformDirection(__m128 n, const __m128 rows[4]) noexcept {
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(n, n, _MM_SHUFFLE(0, 0, 0, 0)), rows[0]);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(n, n, _MM_SHUFFLE(1, 1, 1, 1)), rows[1]));
+    return _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(n, n, _MM_SHUFFLE(2, 2, 2, 2)), rows[2]));
+}
+
+#if defined(__AVX__)
+//! @brief 2頂点分の行列を合成し、点と方向を変換（下位128bit = a、上位 = b）
+inline void SkinPair(const SkinnedMeshVertex& a, const SkinnedMeshVertex& b,
+                     const Matrix* matrices, uint32_t maxIndex,
+                     __m128& posA, __m128& posB, __m128& nrmA, __m128& nrmB) noexcept {
+    const float* wa = &a.boneWeights.x;
+    const float* wb = &b.boneWeights.x;
+    __m256 rows[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+    for (int k = 0; k < 4; ++k) {
+        const Matrix& ma = matrices[BoneIndex(a.boneIndices, k, maxIndex)];
+        const Matrix& mb = matrices[BoneIndex(b.boneIndices, k, maxIndex)];
+        const __m256 w = _mm256_set_m128(_mm_set1_ps(wb[k]), _mm_set1_ps(wa[k]));
+        for (int r = 0; r < 4; ++r) {
+            rows[r] = _mm256_add_ps(rows[r], _mm256_mul_ps(w, _mm256_set_m128(LoadRow(mb, r), LoadRow(ma, r))));
+        }
+    }
+
+    // _mm256_shuffle_psは128bitレーン内で動くので、各頂点の成分がそのまま行へ掛かる
+    const __m256 p = _mm256_set_m128(_mm_loadu_ps(&b.position.x), _mm_loadu_ps(&a.position.x));
+    const __m256 n = _mm256_set_m128(_mm_loadu_ps(&b.normal.x), _mm_loadu_ps(&a.normal.x));
+    __m256 dir = _mm256_mul_ps(_mm256_shuffle_ps(n, n, _MM_SHUFFLE(0, 0, 0, 0)), rows[0]);
+    dir = _mm256_add_ps(dir, _mm256_mul_ps(_mm256_shuffle_ps(n, n, _MM_SHUFFLE(1, 1, 1, 1)), rows[1]));
+    dir = _mm256_add_ps(dir, _mm256_mul_ps(_mm256_shuffle_ps(n, n, _MM_SHUFFLE(2, 2, 2, 2)), rows[2]));
+    __m256 pos = _mm256_mul_ps(_mm256_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), rows[0]);
+    pos = _mm256_add_ps(pos, _mm256_mul_ps(_mm256_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), rows[1]));
+    pos = _mm256_add_ps(pos, _mm256_mul_ps(_mm256_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), rows[2]));
+    pos = _mm256_add_ps(pos, rows[3]);
+
+    posA = _mm256_castps256_ps128(pos);
+    posB = _mm256_extractf128_ps(pos, 1);
+    nrmA = _mm256_castps256_ps128(dir);
+    nrmB = _mm256_extractf128_ps(dir, 1);
+}
+#endif
+
+//! @brief 1頂点を変換（w成分は不定）
+inline void SkinOne(const SkinnedMeshVertex& v, const Matrix* matrices, uint32_t maxIndex,
+                    __m128& pos, __m128& nrm) noexcept {
+    __m128 rows[4];
+    BlendRows(v, matrices, maxIndex, rows);
+    pos = TransformPoint(_mm_loadu_ps(&v.position.x), rows);
+    nrm = TransformDirection(_mm_loadu_ps(&v.normal.x), rows);
+}
+
+//! @brief 4つのxyz_をVector3配列へ12floatで書き込む
+inline void Store4(Vector3* out, __m128 a, __m128 b, __m128 c, __m128 d) noexcept {
+    float* dst = &out[0].x;
+    const __m128 ab = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 2, 2));   // a.z a.z b.x b.x
+    const __m128 cd = _mm_shuffle_ps(c, d, _MM_SHUFFLE(0, 0, 2, 2));   // c.z c.z d.x d.x
+    _mm_storeu_ps(dst + 0, _mm_shuffle_ps(a, ab, _MM_SHUFFLE(2, 0, 1, 0)));  // a.x a.y a.z b.x
+    _mm_storeu_ps(dst + 4, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 2, 1)));   // b.y b.z c.x c.y
+    _mm_storeu_ps(dst + 8, _mm_shuffle_ps(cd, d, _MM_SHUFFLE(2, 1, 2, 0)));  // c.z d.x d.y d.z
+}
+
+//! @brief 4つの方向をまとめて正規化（長さ0はそのまま0）
+inline void Normalize4(__m128& a, __m128& b, __m128& c, __m128& d) noexcept {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c));
+    const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(1e-30f))));
+    a = _mm_mul_ps(a, invLength);
+    b = _mm_mul_ps(b, invLength);
+    c = _mm_mul_ps(c, invLength);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+}
+
+//! @brief 1つのxyz_をVector3へ書き込む
+inline void Store1(Vector3& out, __m128 v) noexcept {
+    alignas(16) float tmp[4];
+    _mm_store_ps(tmp, v);
+    out = Vector3(tmp[0], tmp[1], tmp[2]);
+}
+
+} // namespace detail
+
+//----------------------------------------------------------------------------
+//! @brief [begin, end) の頂点をスキニング（スレッドから直接呼べる本体）
+//! @param vertices スキン頂点配列
+//! @param matrices スキニング行列（ボーンインデックスで参照）
+//! @param matrixCount 行列数（1以上、範囲外のインデックスは最後の行列を使う）
+//! @param outPositions 変形後の位置
+//! @param outNormals 変形後の法線（正規化済み、nullptrなら計算しない）
+//----------------------------------------------------------------------------
+inline void SkinRange(const SkinnedMeshVertex* vertices, uint32_t begin, uint32_t end,
+                      const Matrix* matrices, uint32_t matrixCount,
+                      Vector3* outPositions, Vector3* outNormals) noexcept {
+    const uint32_t maxIndex = matrixCount - 1;
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const SkinnedMeshVertex* v = vertices + i;
+        __m128 p0, p1, p2, p3;
+        __m128 n0, n1, n2, n3;
+#if defined(__AVX__)
+        detail::SkinPair(v[0], v[1], matrices, maxIndex, p0, p1, n0, n1);
+        detail::SkinPair(v[2], v[3], matrices, maxIndex, p2, p3, n2, n3);
+#else
+        detail::SkinOne(v[0], matrices, maxIndex, p0, n0);
+        detail::SkinOne(v[1], matrices, maxIndex, p1, n1);
+        detail::SkinOne(v[2], matrices, maxIndex, p2, n2);
+        detail::SkinOne(v[3], matrices, maxIndex, p3, n3);
+#endif
+        detail::Store4(outPositions + i, p0, p1, p2, p3);
+        if (outNormals) {
+            detail::Normalize4(n0, n1, n2, n3);
+            detail::Store4(outNormals + i, n0, n1, n2, n3);
+        }
+    }
+
+    // 端数
+    for (; i < end; ++i) {
+        __m128 p, n;
+        detail::SkinOne(vertices[i], matrices, maxIndex, p, n);
+        detail::Store1(outPositions[i], p);
+        if (outNormals) {
+            Vector3 normal;
+            detail::Store1(normal, n);
+            normal.Normalize();
+            outNormals[i] = normal;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+//! @brief 頂点配列をスキニング
+//! @param vertices スキン頂点配列
+//! @param skinningMatrices スキニング行列（Animator::GetSkinningMatrices() など）
+//! @param outPositions 変形後の位置（頂点数分）
+//! @param outNormals 変形後の法線（空なら計算しない）
+//!
+//! 出力が頂点数より短い場合は出力の長さまで処理する。行列が空なら何もしない。
+//----------------------------------------------------------------------------
+inline void Skin(std::span<const SkinnedMeshVertex> vertices, std::span<const Matrix> skinningMatrices,
+                 std::span<Vector3> outPositions, std::span<Vector3> outNormals = {}) {
+    if (skinningMatrices.empty()) return;
+
+    uint32_t count = static_cast<uint32_t>((std::min)(vertices.size(), outPositions.size()));
+    Vector3* normals = nullptr;
+    if (!outNormals.empty()) {
+        count = (std::min)(count, static_cast<uint32_t>(outNormals.size()));
+        normals = outNormals.data();
+    }
+    if (count == 0) return;
+
+    const SkinnedMeshVertex* src = vertices.data();
+    const Matrix* matrices = skinningMatrices.data();
+    const uint32_t matrixCount = static_cast<uint32_t>(skinningMatrices.size());
+    Vector3* positions = outPositions.data();
+    auto body = [=](uint32_t blockBegin, uint32_t blockEnd) {
+        SkinRange(src, blockBegin * kVerticesPerBlock, (std::min)(blockEnd * kVerticesPerBlock, count),
+                  matrices, matrixCount, positions, normals);
+    };
+
+    const uint32_t blockCount = (count + kVerticesPerBlock - 1) / kVerticesPerBlock;
+    if (count >= kMinParallelVertices && JobSystem::HasWorkers()) {
+        JobSystem::Get().ParallelForRange(0, blockCount, body, 1u).Wait();
+    } else {
+        body(0, blockCount);
+    }
+}
+
+} // namespace CpuSkinning
@@ -42,6 +42,7 @@ struct MeshLoadOptions
     float scale = 1.0f;                 //!< スケール係数
     bool loadMaterials = true;          //!< マテリアル情報を読み込む
     bool loadTextures = false;          //!< 埋め込みテクスチャを読み込む（glTF用）
+    bool keepCpuData = false;           //!< スキンメッシュの頂点をCPU側にも保持（CPUスキニング用）
 };
 
 //============================================================================
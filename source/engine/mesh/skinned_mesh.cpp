@@ -46,6 +46,10 @@ std::shared_ptr<SkinnedMesh> SkinnedMesh::Create(const SkinnedMeshDesc& desc)
     mesh->name_ = desc.name;
     mesh->skeleton_ = desc.skeleton;
     mesh->animations_ = desc.animations;
+    if (desc.keepCpuData) {
+        mesh->cpuVertices_ = desc.vertices;
+        mesh->cpuIndices_ = desc.indices;
+    }
 
     LOG_INFO("[SkinnedMesh] Created '" + desc.name + "' with " +
              std::to_string(mesh->vertexCount_) + " vertices, " +
@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <span>
 
 //============================================================================
 //! @brief スキンメッシュ記述子
@@ -28,6 +29,8 @@ struct SkinnedMeshDesc
 
     SkeletonPtr skeleton;                       //!< スケルトン（ボーン階層）
     std::vector<AnimationClipPtr> animations;   //!< アニメーションクリップ
+
+    bool keepCpuData = false;                   //!< CPUスキニング・当たり判定用に頂点とインデックスを保持
 };
 
 //============================================================================
@@ -36,6 +39,8 @@ struct SkinnedMeshDesc
 //! ボーンアニメーション対応のメッシュ。
 //! 頂点にボーンインデックスとウェイトが含まれ、
 //! GPU上でスキニング変換を行う。
+//! keepCpuDataを指定すると頂点とインデックスをCPU側にも残し、
+//! CpuSkinningやPhysics::SkinnedMeshColliderの入力に使える。
 //!
 //! @code
 //! // ロード
@@ -105,6 +110,21 @@ public:
     //! @brief メッシュ名取得
     [[nodiscard]] const std::string& GetName() const noexcept { return name_; }
 
+    //!@}
+    //----------------------------------------------------------
+    //! @name CPU側データ（SkinnedMeshDesc::keepCpuData指定時のみ）
+    //----------------------------------------------------------
+    //!@{
+
+    //! @brief CPU側のデータを保持しているか
+    [[nodiscard]] bool HasCpuData() const noexcept { return !cpuVertices_.empty(); }
+
+    //! @brief スキン頂点（CpuSkinning::Skin の入力）
+    [[nodiscard]] std::span<const SkinnedMeshVertex> GetCpuVertices() const noexcept { return cpuVertices_; }
+
+    //! @brief インデックス（当たり判定用）
+    [[nodiscard]] std::span<const uint32_t> GetCpuIndices() const noexcept { return cpuIndices_; }
+
     //!@}
     //----------------------------------------------------------
     //! @name スケルトン・アニメーション
@@ -161,6 +181,9 @@ private:
 
     SkeletonPtr skeleton_;                      //!< スケルトン
     std::vector<AnimationClipPtr> animations_;  //!< アニメーションクリップ
+
+    std::vector<SkinnedMeshVertex> cpuVertices_; //!< CPU側のスキン頂点（keepCpuData時のみ）
+    std::vector<uint32_t> cpuIndices_;          //!< CPU側のインデックス（keepCpuData時のみ）
 };
 
 using SkinnedMeshPtr = std::shared_ptr<SkinnedMesh>;
@@ -854,6 +854,7 @@ SkinnedMeshLoadResult SkinnedMeshLoader::LoadFromMemory(
     desc.name = "SkinnedMesh";
     desc.skeleton = skeleton;
     desc.animations = std::move(animations);
+    desc.keepCpuData = options.keepCpuData;
 
     ProcessNodeSkinned(
         scene->mRootNode, scene, skeleton,
@@ -1,14 +1,22 @@
 //----------------------------------------------------------------------------
 //! @file   bvh.h
-//! @brief  BVH (Bounding Volume Hierarchy) - 高速レイキャスト用空間分割
+//! @brief  BVH (Bounding Volume Hierarchy) - 高速レイキャスト用空間分割（ビン分割SAH）
 //----------------------------------------------------------------------------
 #pragma once
 
 
 #include "engine/math/math_types.h"
+#include "engine/core/job_system.h"
+#include "common/logging/logging.h"
 #include <vector>
+#include <array>
+#include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <cfloat>
 #include <cstdint>
+#include <span>
+#include <string>
 
 namespace Physics {
 
@@ -101,21 +109,72 @@ struct Triangle {
 };
 
 //============================================================================
-//! @brief BVHノード
+//! @brief BVHノード（32バイト、深さ優先順に配置）
+//!
+//! 内部ノードの左子は常に直後のノード（nodeIdx + 1）に置かれる。
 //============================================================================
 struct BVHNode {
-    AABB bounds;
-    uint32_t leftFirst;   // 内部ノード: 左子のインデックス, 葉: 三角形開始インデックス
+    float minX, minY, minZ;
+    uint32_t leftFirst;   // 内部ノード: 右子のインデックス, 葉: 三角形インデックス配列の開始位置
+    float maxX, maxY, maxZ;
     uint32_t triCount;    // 0なら内部ノード、それ以外は葉の三角形数
 
     [[nodiscard]] bool IsLeaf() const noexcept { return triCount > 0; }
+
+    //! @brief AABBとして取得
+    [[nodiscard]] AABB GetBounds() const noexcept {
+        AABB aabb;
+        aabb.min = Vector3(minX, minY, minZ);
+        aabb.max = Vector3(maxX, maxY, maxZ);
+        return aabb;
+    }
+
+    //! @brief レイとの交差判定
+    [[nodiscard]] bool Intersect(const Vector3& origin, const Vector3& invDir, float tMax) const noexcept {
+        float t1 = (minX - origin.x) * invDir.x;
+        float t2 = (maxX - origin.x) * invDir.x;
+        float tmin = (std::min)(t1, t2);
+        float tmax = (std::max)(t1, t2);
+
+        t1 = (minY - origin.y) * invDir.y;
+        t2 = (maxY - origin.y) * invDir.y;
+        tmin = (std::max)(tmin, (std::min)(t1, t2));
+        tmax = (std::min)(tmax, (std::max)(t1, t2));
+
+        t1 = (minZ - origin.z) * invDir.z;
+        t2 = (maxZ - origin.z) * invDir.z;
+        tmin = (std::max)(tmin, (std::min)(t1, t2));
+        tmax = (std::min)(tmax, (std::max)(t1, t2));
+
+        return tmax >= (std::max)(0.0f, tmin) && tmin < tMax;
+    }
+};
+static_assert(sizeof(BVHNode) == 32, "BVHNode must be 32 bytes");
+
+//============================================================================
+//! @brief BVH構築統計
+//============================================================================
+struct BVHBuildStats {
+    double buildTimeMs = 0.0;       //!< 構築時間（ミリ秒）
+    float sahCost = 0.0f;           //!< SAHコスト（ルート表面積で正規化）
+    uint32_t nodeCount = 0;         //!< ノード数
+    uint32_t leafCount = 0;         //!< 葉の数
+    uint32_t maxDepth = 0;          //!< 最大深さ（ルート=0）
+    uint32_t maxLeafTriangles = 0;  //!< 葉の最大三角形数
 };
 
 //============================================================================
 //! @brief BVH (Bounding Volume Hierarchy)
 //!
 //! 三角形メッシュに対する高速レイキャスト用の空間分割構造。
-//! 構築: O(n log n)、レイキャスト: O(log n)
+//! 構築: ビン分割SAH、O(n log n)。大きい部分木はJobSystemで並列構築する。
+//! レイキャスト: O(log n)
+//!
+//! 三角形は入力順のまま保持し、葉は三角形インデックス配列を参照する。
+//! ノードは深さ優先順の32バイト配列に平坦化する。
+//!
+//! 頂点が動くメッシュは Refit で分割を保ったままAABBだけ更新できる。
+//! 更新後のSAHコストを構築時と比べ、品質が落ちたら呼び出し側で再構築する。
 //!
 //! @code
 //! BVH bvh;
@@ -130,31 +189,145 @@ struct BVHNode {
 //============================================================================
 class BVH {
 public:
+    //! @brief SAHのビン数
+    static constexpr uint32_t kBinCount = 16;
+
+    //! @brief この数以下の三角形は分割しない
+    static constexpr uint32_t kMinLeafTriangles = 2;
+
+    //! @brief SAHで葉の方が安くてもこの数を超えれば分割する
+    static constexpr uint32_t kMaxLeafTriangles = 8;
+
+    //! @brief この深さ以降は三角形数の中央で分割（深さの上限を抑える）
+    static constexpr uint32_t kMaxSahDepth = 40;
+
+    //! @brief この三角形数以上の部分木は別ジョブで構築
+    static constexpr uint32_t kParallelSubtreeTriangles = 4096;
+
+    //! @brief ノード1つをたどるコスト（三角形1つの交差判定コストに対する比）
+    static constexpr float kTraversalCost = 1.0f;
+
+    //! @brief トラバーサルスタックの深さ
+    static constexpr uint32_t kStackSize = 128;
+
+    //! @brief リフィットはこの三角形数以下の部分木を単位にJobSystemへ分散
+    static constexpr uint32_t kRefitSubtreeTriangles = 1024;
+
     //! @brief BVHを構築
     void Build(std::vector<Triangle> triangles) {
-        if (triangles.empty()) return;
-
-        triangles_ = std::move(triangles);
         nodes_.clear();
-        nodes_.reserve(triangles_.size() * 2);
+        triIndices_.clear();
+        refitRanges_.clear();
+        refitTop_.clear();
+        stats_ = BVHBuildStats{};
+        sahCost_ = 0.0f;
+        triangles_ = std::move(triangles);
+        if (triangles_.empty()) return;
+
+        const auto start = std::chrono::steady_clock::now();
+        const uint32_t triCount = static_cast<uint32_t>(triangles_.size());
+
+        // 三角形ごとのAABBと重心（構築中のみ使用。分割時はこの配列を並べ替え、連続アクセスにする）
+        BuildContext ctx;
+        ctx.prims.resize(triCount);
+        auto prepare = [this, &ctx](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                const Triangle& tri = triangles_[i];
+                BuildPrim& prim = ctx.prims[i];
+                prim.bounds = BuildBounds{};
+                prim.bounds.Expand(tri.v0);
+                prim.bounds.Expand(tri.v1);
+                prim.bounds.Expand(tri.v2);
+                for (int axis = 0; axis < 3; ++axis) {
+                    prim.centroid[axis] = (prim.bounds.mn[axis] + prim.bounds.mx[axis]) * 0.5f;
+                }
+                prim.index = i;
+            }
+        };
+        if (triCount >= kParallelSubtreeTriangles && JobSystem::HasWorkers()) {
+            JobSystem::Get().ParallelForRange(0, triCount, prepare).Wait();
+        } else {
+            prepare(0, triCount);
+        }
+
+        // 二分木の最大ノード数（葉は1三角形以上）
+        ctx.nodes.resize(static_cast<size_t>(triCount) * 2 - 1);
+        ctx.nodeCount.store(1, std::memory_order_relaxed);
+        BuildBounds rootBounds, rootCentroidBounds;
+        ComputeBounds(ctx, 0, triCount, rootBounds, rootCentroidBounds);
+        BuildNode(ctx, 0, 0, triCount, 0, rootBounds, rootCentroidBounds);
+
+        triIndices_.resize(triCount);
+        for (uint32_t i = 0; i < triCount; ++i) {
+            triIndices_[i] = ctx.prims[i].index;
+        }
 
-        // ルートノード作成
-        nodes_.push_back({});
-        rootIndex_ = 0;
-        nodesUsed_ = 1;
+        // 深さ優先順に平坦化
+        nodes_.reserve(ctx.nodeCount.load(std::memory_order_relaxed));
+        const float rootArea = ctx.nodes[0].bounds.HalfArea();
+        Flatten(ctx, 0, 0, rootArea > 0.0f ? 1.0f / rootArea : 0.0f, false);
+        sahCost_ = stats_.sahCost;
 
-        // 全三角形のAABBを計算
-        BVHNode& root = nodes_[rootIndex_];
-        root.leftFirst = 0;
-        root.triCount = static_cast<uint32_t>(triangles_.size());
+        stats_.nodeCount = static_cast<uint32_t>(nodes_.size());
+        stats_.buildTimeMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
 
-        UpdateNodeBounds(rootIndex_);
+        LOG_INFO("[BVH] Built with " + std::to_string(triCount) +
+                 " triangles, " + std::to_string(stats_.nodeCount) + " nodes, SAH " +
+                 std::to_string(stats_.sahCost) + ", " + std::to_string(stats_.buildTimeMs) + " ms");
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 頂点の移動に合わせてノードのAABBを更新（分割は変えない）
+    //!
+    //! 三角形を更新してから、部分木ごとに葉から根に向かってAABBを合わせ直す。
+    //! 部分木は深さ優先配列の連続区間なので末尾から処理すれば子が先に更新され、
+    //! 部分木同士は独立にJobSystemで並列処理できる。最後に上位のノードを更新する。
+    //! @param positions 頂点位置
+    //! @param indices 頂点インデックス（三角形 i は indices[i * 3] から3つ。構築時の入力順）
+    //------------------------------------------------------------------------
+    void Refit(std::span<const Vector3> positions, std::span<const uint32_t> indices) {
+        const uint32_t triCount = static_cast<uint32_t>(triangles_.size());
+        if (nodes_.empty() || indices.size() < static_cast<size_t>(triCount) * 3) return;
+
+        auto updateTriangles = [this, positions, indices](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                Triangle& tri = triangles_[i];
+                tri.v0 = positions[indices[i * 3 + 0]];
+                tri.v1 = positions[indices[i * 3 + 1]];
+                tri.v2 = positions[indices[i * 3 + 2]];
+            }
+        };
+        auto refitRanges = [this](uint32_t begin, uint32_t end) {
+            for (uint32_t r = begin; r < end; ++r) {
+                RefitRange& range = refitRanges_[r];
+                range.cost = 0.0f;
+                for (uint32_t nodeIdx = range.end; nodeIdx-- > range.begin;) {
+                    range.cost += RefitNode(nodeIdx);
+                }
+            }
+        };
+
+        const uint32_t rangeCount = static_cast<uint32_t>(refitRanges_.size());
+        if (triCount >= kParallelSubtreeTriangles && JobSystem::HasWorkers()) {
+            JobSystem::Get().ParallelForRange(0, triCount, updateTriangles).Wait();
+            JobSystem::Get().ParallelForRange(0, rangeCount, refitRanges, 1).Wait();
+        } else {
+            updateTriangles(0, triCount);
+            refitRanges(0, rangeCount);
+        }
 
-        // 再帰的に分割
-        Subdivide(rootIndex_);
+        // 部分木より上のノード（前順なので逆順にたどれば子が先）
+        float cost = 0.0f;
+        for (const RefitRange& range : refitRanges_) {
+            cost += range.cost;
+        }
+        for (auto it = refitTop_.rbegin(); it != refitTop_.rend(); ++it) {
+            cost += RefitNode(*it);
+        }
 
-        LOG_INFO("[BVH] Built with " + std::to_string(triangles_.size()) +
-                 " triangles, " + std::to_string(nodesUsed_) + " nodes");
+        const float rootArea = HalfArea(nodes_[0]);
+        sahCost_ = rootArea > 0.0f ? cost / rootArea : 0.0f;
     }
 
     //! @brief レイとの交差判定
@@ -184,23 +357,23 @@ public:
         uint32_t closestTri = UINT32_MAX;
 
         // スタックベースのトラバーサル
-        uint32_t stack[64];
-        int stackPtr = 0;
-        stack[stackPtr++] = rootIndex_;
+        uint32_t stack[kStackSize];
+        uint32_t stackPtr = 0;
+        stack[stackPtr++] = 0;
 
         while (stackPtr > 0) {
             uint32_t nodeIdx = stack[--stackPtr];
             const BVHNode& node = nodes_[nodeIdx];
 
             // AABBテスト
-            if (!node.bounds.Intersect(origin, invDir, closestT)) {
+            if (!node.Intersect(origin, invDir, closestT)) {
                 continue;
             }
 
             if (node.IsLeaf()) {
                 // 葉ノード：三角形をテスト
                 for (uint32_t i = 0; i < node.triCount; ++i) {
-                    const Triangle& tri = triangles_[node.leftFirst + i];
+                    const Triangle& tri = triangles_[triIndices_[node.leftFirst + i]];
                     float t;
                     if (IntersectTriangle(origin, dir, tri, closestT, t)) {
                         closestT = t;
@@ -208,9 +381,9 @@ public:
                     }
                 }
             } else {
-                // 内部ノード：子をスタックに追加
+                // 内部ノード：子をスタックに追加（左子を先にたどる）
                 stack[stackPtr++] = node.leftFirst;
-                stack[stackPtr++] = node.leftFirst + 1;
+                stack[stackPtr++] = nodeIdx + 1;
             }
         }
 
@@ -222,76 +395,472 @@ public:
         return false;
     }
 
+    //! @brief AABBと重なる葉の三角形を列挙（形状の重なり判定用）
+    //! @param bounds 判定するAABB
+    //! @param func void(const Triangle&)。葉単位の判定のため、正確な判定は呼び出し側で行う
+    template<typename Func>
+    void QueryOverlap(const AABB& bounds, Func&& func) const {
+        if (nodes_.empty()) return;
+
+        uint32_t stack[kStackSize];
+        uint32_t stackPtr = 0;
+        stack[stackPtr++] = 0;
+
+        while (stackPtr > 0) {
+            const uint32_t nodeIdx = stack[--stackPtr];
+            const BVHNode& node = nodes_[nodeIdx];
+            if (node.minX > bounds.max.x || node.maxX < bounds.min.x ||
+                node.minY > bounds.max.y || node.maxY < bounds.min.y ||
+                node.minZ > bounds.max.z || node.maxZ < bounds.min.z) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                for (uint32_t i = 0; i < node.triCount; ++i) {
+                    func(triangles_[triIndices_[node.leftFirst + i]]);
+                }
+            } else {
+                stack[stackPtr++] = node.leftFirst;
+                stack[stackPtr++] = nodeIdx + 1;
+            }
+        }
+    }
+
+    //! @brief 形状のスイープで接触しうる三角形を列挙
+    //!
+    //! ノードのAABBを形状の半径だけ膨らませ、形状の中心からのレイでたどる。
+    //! 近い子から順にたどり、funcでtMaxを縮めると以降の探索が打ち切られる。
+    //! @param origin 形状の中心
+    //! @param dir 移動方向（正規化不要。tはdir単位）
+    //! @param extent 形状のAABBの半径
+    //! @param tMax [in,out] 最大距離
+    //! @param func void(const Triangle&)
+    template<typename Func>
+    void QuerySweep(const Vector3& origin, const Vector3& dir, const Vector3& extent,
+                    float& tMax, Func&& func) const {
+        if (nodes_.empty()) return;
+
+        const Vector3 invDir(
+            std::abs(dir.x) > 1e-8f ? 1.0f / dir.x : 1e8f,
+            std::abs(dir.y) > 1e-8f ? 1.0f / dir.y : 1e8f,
+            std::abs(dir.z) > 1e-8f ? 1.0f / dir.z : 1e8f
+        );
+
+        struct Entry {
+            uint32_t node;
+            float tNear;
+        };
+        Entry stack[kStackSize];
+        uint32_t stackPtr = 0;
+
+        float rootNear;
+        if (!IntersectExpanded(nodes_[0], origin, invDir, extent, tMax, rootNear)) return;
+        stack[stackPtr++] = Entry{0, rootNear};
+
+        while (stackPtr > 0) {
+            const Entry entry = stack[--stackPtr];
+            if (entry.tNear > tMax) continue;
+
+            const BVHNode& node = nodes_[entry.node];
+            if (node.IsLeaf()) {
+                for (uint32_t i = 0; i < node.triCount; ++i) {
+                    func(triangles_[triIndices_[node.leftFirst + i]]);
+                }
+                continue;
+            }
+
+            // 遠い子を先に積む
+            const uint32_t left = entry.node + 1;
+            const uint32_t right = node.leftFirst;
+            float leftNear, rightNear;
+            const bool hitLeft = IntersectExpanded(nodes_[left], origin, invDir, extent, tMax, leftNear);
+            const bool hitRight = IntersectExpanded(nodes_[right], origin, invDir, extent, tMax, rightNear);
+            if (hitLeft && hitRight) {
+                if (leftNear <= rightNear) {
+                    stack[stackPtr++] = Entry{right, rightNear};
+                    stack[stackPtr++] = Entry{left, leftNear};
+                } else {
+                    stack[stackPtr++] = Entry{left, leftNear};
+                    stack[stackPtr++] = Entry{right, rightNear};
+                }
+            } else if (hitLeft) {
+                stack[stackPtr++] = Entry{left, leftNear};
+            } else if (hitRight) {
+                stack[stackPtr++] = Entry{right, rightNear};
+            }
+        }
+    }
+
     //! @brief 構築済みか
     [[nodiscard]] bool IsBuilt() const noexcept { return !nodes_.empty(); }
 
     //! @brief 三角形数を取得
     [[nodiscard]] size_t GetTriangleCount() const noexcept { return triangles_.size(); }
 
+    //! @brief 構築統計を取得
+    [[nodiscard]] const BVHBuildStats& GetBuildStats() const noexcept { return stats_; }
+
+    //! @brief 現在のSAHコスト（ルート表面積で正規化。リフィットで更新される）
+    [[nodiscard]] float GetSahCost() const noexcept { return sahCost_; }
+
+    //! @brief 構築時に対する現在のSAHコストの比（リフィットによる品質の劣化度合い）
+    [[nodiscard]] float GetSahDegradation() const noexcept {
+        return stats_.sahCost > 0.0f ? sahCost_ / stats_.sahCost : 1.0f;
+    }
+
+    //! @brief ノード配列（深さ優先順）
+    [[nodiscard]] const std::vector<BVHNode>& GetNodes() const noexcept { return nodes_; }
+
+    //! @brief 葉が参照する三角形インデックス配列
+    [[nodiscard]] const std::vector<uint32_t>& GetTriangleIndices() const noexcept { return triIndices_; }
+
+    //! @brief 三角形配列（入力順）
+    [[nodiscard]] const std::vector<Triangle>& GetTriangles() const noexcept { return triangles_; }
+
 private:
-    //! @brief ノードのAABBを更新
-    void UpdateNodeBounds(uint32_t nodeIdx) {
-        BVHNode& node = nodes_[nodeIdx];
-        node.bounds = AABB();
-        for (uint32_t i = 0; i < node.triCount; ++i) {
-            node.bounds.Expand(triangles_[node.leftFirst + i].GetAABB());
+    //! @brief 構築用AABB（軸インデックスでアクセス）
+    struct BuildBounds {
+        float mn[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+        float mx[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        void Expand(const Vector3& p) noexcept {
+            mn[0] = (std::min)(mn[0], p.x); mx[0] = (std::max)(mx[0], p.x);
+            mn[1] = (std::min)(mn[1], p.y); mx[1] = (std::max)(mx[1], p.y);
+            mn[2] = (std::min)(mn[2], p.z); mx[2] = (std::max)(mx[2], p.z);
+        }
+
+        void Expand(const BuildBounds& b) noexcept {
+            for (int axis = 0; axis < 3; ++axis) {
+                mn[axis] = (std::min)(mn[axis], b.mn[axis]);
+                mx[axis] = (std::max)(mx[axis], b.mx[axis]);
+            }
+        }
+
+        void ExpandPoint(const std::array<float, 3>& p) noexcept {
+            for (int axis = 0; axis < 3; ++axis) {
+                mn[axis] = (std::min)(mn[axis], p[axis]);
+                mx[axis] = (std::max)(mx[axis], p[axis]);
+            }
+        }
+
+        //! @brief 表面積の半分（空なら0）
+        [[nodiscard]] float HalfArea() const noexcept {
+            if (mn[0] > mx[0]) return 0.0f;
+            const float dx = mx[0] - mn[0];
+            const float dy = mx[1] - mn[1];
+            const float dz = mx[2] - mn[2];
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+    //! @brief 構築中の三角形
+    struct BuildPrim {
+        BuildBounds bounds;
+        std::array<float, 3> centroid;
+        uint32_t index;     //!< triangles_のインデックス
+    };
+
+    //! @brief 構築中のノード（平坦化前）
+    struct TempNode {
+        BuildBounds bounds;
+        uint32_t begin = 0;
+        uint32_t count = 0;
+        uint32_t left = UINT32_MAX;     //!< UINT32_MAXなら葉
+        uint32_t right = UINT32_MAX;
+    };
+
+    struct BuildContext {
+        std::vector<BuildPrim> prims;
+        std::vector<TempNode> nodes;
+        std::atomic<uint32_t> nodeCount{0};
+    };
+
+    struct Bin {
+        BuildBounds bounds;
+        uint32_t count = 0;
+    };
+
+    //! @brief 分割結果（子のAABBと重心AABBを含む）
+    struct Split {
+        uint32_t mid;
+        BuildBounds bounds[2];
+        BuildBounds centroidBounds[2];
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief 範囲のAABBと重心AABBを計算
+    //------------------------------------------------------------------------
+    static void ComputeBounds(const BuildContext& ctx, uint32_t begin, uint32_t end,
+                              BuildBounds& outBounds, BuildBounds& outCentroidBounds) noexcept {
+        outBounds = BuildBounds{};
+        outCentroidBounds = BuildBounds{};
+        for (uint32_t i = begin; i < end; ++i) {
+            const BuildPrim& prim = ctx.prims[i];
+            outBounds.Expand(prim.bounds);
+            outCentroidBounds.ExpandPoint(prim.centroid);
         }
     }
 
-    //! @brief ノードを分割
-    void Subdivide(uint32_t nodeIdx) {
-        BVHNode& node = nodes_[nodeIdx];
+    //------------------------------------------------------------------------
+    //! @brief ノードを構築（ビン分割SAHで再帰的に分割）
+    //! @param bounds 範囲のAABB（親の分割時に計算済み）
+    //! @param centroidBounds 範囲の重心AABB
+    //------------------------------------------------------------------------
+    void BuildNode(BuildContext& ctx, uint32_t nodeIdx, uint32_t begin, uint32_t end, uint32_t depth,
+                   const BuildBounds& bounds, const BuildBounds& centroidBounds) {
+        TempNode& node = ctx.nodes[nodeIdx];
+        node.begin = begin;
+        node.count = end - begin;
+        node.bounds = bounds;
+
+        const uint32_t count = node.count;
+        if (count <= kMinLeafTriangles) return;
+
+        Split split;
+        split.mid = begin;
+        if (depth < kMaxSahDepth) {
+            PartitionSah(ctx, bounds, centroidBounds, begin, end, split);
+        }
+        if (split.mid == begin || split.mid == end) {
+            // SAHで葉の方が安い
+            if (count <= kMaxLeafTriangles) return;
+
+            // 分割できない（重心が一点に集まっている等）または深すぎる: 中央で分割
+            const int axis = LongestAxis(centroidBounds);
+            split.mid = begin + count / 2;
+            std::nth_element(ctx.prims.begin() + begin, ctx.prims.begin() + split.mid, ctx.prims.begin() + end,
+                [axis](const BuildPrim& a, const BuildPrim& b) { return a.centroid[axis] < b.centroid[axis]; });
+            ComputeBounds(ctx, begin, split.mid, split.bounds[0], split.centroidBounds[0]);
+            ComputeBounds(ctx, split.mid, end, split.bounds[1], split.centroidBounds[1]);
+        }
 
-        // 三角形が少なければ葉のまま
-        if (node.triCount <= 4) return;
+        // 子ノードを確保（並列構築中も衝突しないようアトミックに確保）
+        const uint32_t left = ctx.nodeCount.fetch_add(2, std::memory_order_relaxed);
+        node.left = left;
+        node.right = left + 1;
+
+        const uint32_t mid = split.mid;
+        if (count >= kParallelSubtreeTriangles && JobSystem::HasWorkers()) {
+            // 左部分木を別ジョブ、右部分木をこのスレッドで構築
+            JobHandle handle = JobSystem::Get().SubmitJob(JobDesc([this, &ctx, &split, left, begin, mid, depth] {
+                BuildNode(ctx, left, begin, mid, depth + 1, split.bounds[0], split.centroidBounds[0]);
+            }));
+            BuildNode(ctx, left + 1, mid, end, depth + 1, split.bounds[1], split.centroidBounds[1]);
+            handle.Wait();
+        } else {
+            BuildNode(ctx, left, begin, mid, depth + 1, split.bounds[0], split.centroidBounds[0]);
+            BuildNode(ctx, left + 1, mid, end, depth + 1, split.bounds[1], split.centroidBounds[1]);
+        }
+    }
 
-        // 最長軸で分割
-        int axis = node.bounds.LongestAxis();
-        float splitPos = AABB::GetAxis(node.bounds.Center(), axis);
+    //------------------------------------------------------------------------
+    //! @brief ビン分割SAHで最良の分割を選んでパーティション
+    //! @param outSplit [out] 分割結果（分割しない方が安い場合はmid=begin）
+    //------------------------------------------------------------------------
+    void PartitionSah(BuildContext& ctx, const BuildBounds& nodeBounds,
+                      const BuildBounds& centroidBounds, uint32_t begin, uint32_t end, Split& outSplit) {
+        const uint32_t count = end - begin;
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+
+        // 3軸を1パスでビンに振り分け（小さいノードはビンを減らして固定コストを抑える）
+        const uint32_t binCount = (std::min)(kBinCount, count);
+        Bin bins[3][kBinCount];
+        float lo[3], scale[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = centroidBounds.mx[axis] - centroidBounds.mn[axis];
+            lo[axis] = centroidBounds.mn[axis];
+            scale[axis] = extent > 0.0f ? static_cast<float>(binCount) / extent : 0.0f;
+        }
+        for (uint32_t i = begin; i < end; ++i) {
+            const BuildPrim& prim = ctx.prims[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                Bin& bin = bins[axis][BinIndex(prim.centroid[axis], lo[axis], scale[axis], binCount)];
+                bin.bounds.Expand(prim.bounds);
+                ++bin.count;
+            }
+        }
+
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] <= 0.0f) continue;
+
+            // 右からの累積
+            float rightArea[kBinCount];
+            uint32_t rightCount[kBinCount];
+            BuildBounds accum;
+            uint32_t accumCount = 0;
+            for (uint32_t b = binCount - 1; b > 0; --b) {
+                accum.Expand(bins[axis][b].bounds);
+                accumCount += bins[axis][b].count;
+                rightArea[b] = accum.HalfArea();
+                rightCount[b] = accumCount;
+            }
+
+            // 左からの累積とコスト評価（分割 b: [0, b) | [b, binCount)）
+            accum = BuildBounds{};
+            accumCount = 0;
+            for (uint32_t b = 1; b < binCount; ++b) {
+                accum.Expand(bins[axis][b - 1].bounds);
+                accumCount += bins[axis][b - 1].count;
+                if (accumCount == 0 || rightCount[b] == 0) continue;
+                const float cost = accum.HalfArea() * static_cast<float>(accumCount) +
+                                   rightArea[b] * static_cast<float>(rightCount[b]);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) return;
+
+        // 葉のコストと比較（表面積はノードで正規化）
+        const float nodeArea = nodeBounds.HalfArea();
+        const float splitCost = kTraversalCost + (nodeArea > 0.0f ? bestCost / nodeArea : 0.0f);
+        if (splitCost >= static_cast<float>(count) && count <= kMaxLeafTriangles) {
+            return;
+        }
 
-        // 三角形を分割位置でパーティション
-        uint32_t i = node.leftFirst;
-        uint32_t j = i + node.triCount - 1;
+        // 子のAABBはビンから求まる
+        for (uint32_t b = 0; b < binCount; ++b) {
+            outSplit.bounds[b < bestSplit ? 0 : 1].Expand(bins[bestAxis][b].bounds);
+        }
 
-        while (i <= j) {
-            if (AABB::GetAxis(triangles_[i].Centroid(), axis) < splitPos) {
+        // パーティションしながら子の重心AABBを計算
+        const float splitLo = lo[bestAxis];
+        const float splitScale = scale[bestAxis];
+        uint32_t i = begin;
+        uint32_t j = end;
+        while (i < j) {
+            BuildPrim& prim = ctx.prims[i];
+            if (BinIndex(prim.centroid[bestAxis], splitLo, splitScale, binCount) < bestSplit) {
+                outSplit.centroidBounds[0].ExpandPoint(prim.centroid);
                 ++i;
             } else {
-                std::swap(triangles_[i], triangles_[j]);
-                --j;
+                outSplit.centroidBounds[1].ExpandPoint(prim.centroid);
+                std::swap(prim, ctx.prims[--j]);
             }
         }
+        outSplit.mid = i;
+    }
+
+    [[nodiscard]] static uint32_t BinIndex(float centroid, float lo, float scale, uint32_t binCount) noexcept {
+        const int bin = static_cast<int>((centroid - lo) * scale);
+        return static_cast<uint32_t>((std::clamp)(bin, 0, static_cast<int>(binCount) - 1));
+    }
+
+    [[nodiscard]] static int LongestAxis(const BuildBounds& b) noexcept {
+        const float dx = b.mx[0] - b.mn[0];
+        const float dy = b.mx[1] - b.mn[1];
+        const float dz = b.mx[2] - b.mn[2];
+        if (dx > dy && dx > dz) return 0;
+        if (dy > dz) return 1;
+        return 2;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 構築したノードを深さ優先順に平坦化し、統計を集計
+    //! @param inRefitRange 祖先がリフィットの部分木として登録済みか
+    //------------------------------------------------------------------------
+    void Flatten(const BuildContext& ctx, uint32_t tempIdx, uint32_t depth, float invRootArea, bool inRefitRange) {
+        const TempNode& temp = ctx.nodes[tempIdx];
+        const uint32_t nodeIdx = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back(BVHNode{
+            temp.bounds.mn[0], temp.bounds.mn[1], temp.bounds.mn[2], 0,
+            temp.bounds.mx[0], temp.bounds.mx[1], temp.bounds.mx[2], 0});
+
+        const float areaRatio = temp.bounds.HalfArea() * invRootArea;
+        stats_.maxDepth = (std::max)(stats_.maxDepth, depth);
+
+        // 小さい部分木はリフィットの並列単位、それより上のノードは最後にまとめて更新
+        const bool refitRoot = !inRefitRange && temp.count <= kRefitSubtreeTriangles;
+        if (!inRefitRange && !refitRoot) {
+            refitTop_.push_back(nodeIdx);
+        }
 
-        // 分割が有効かチェック
-        uint32_t leftCount = i - node.leftFirst;
-        if (leftCount == 0 || leftCount == node.triCount) {
-            return;  // 分割できない
+        if (temp.left == UINT32_MAX) {
+            nodes_[nodeIdx].leftFirst = temp.begin;
+            nodes_[nodeIdx].triCount = temp.count;
+            stats_.sahCost += areaRatio * static_cast<float>(temp.count);
+            ++stats_.leafCount;
+            stats_.maxLeafTriangles = (std::max)(stats_.maxLeafTriangles, temp.count);
+            if (refitRoot) {
+                refitRanges_.push_back(RefitRange{nodeIdx, nodeIdx + 1});
+            }
+            return;
         }
 
-        // 子ノードを作成
-        uint32_t leftChildIdx = nodesUsed_++;
-        uint32_t rightChildIdx = nodesUsed_++;
+        stats_.sahCost += areaRatio * kTraversalCost;
+        Flatten(ctx, temp.left, depth + 1, invRootArea, inRefitRange || refitRoot);
+        nodes_[nodeIdx].leftFirst = static_cast<uint32_t>(nodes_.size());
+        Flatten(ctx, temp.right, depth + 1, invRootArea, inRefitRange || refitRoot);
+        if (refitRoot) {
+            refitRanges_.push_back(RefitRange{nodeIdx, static_cast<uint32_t>(nodes_.size())});
+        }
+    }
 
-        // ノード配列の拡張
-        if (nodes_.size() <= rightChildIdx) {
-            nodes_.resize(rightChildIdx + 1);
+    //------------------------------------------------------------------------
+    //! @brief ノード1つのAABBを三角形または子から計算し直す
+    //! @return SAHコストへの寄与（表面積 x 三角形数 or トラバーサルコスト。正規化前）
+    //------------------------------------------------------------------------
+    float RefitNode(uint32_t nodeIdx) noexcept {
+        BVHNode& node = nodes_[nodeIdx];
+        if (node.IsLeaf()) {
+            AABB bounds;
+            for (uint32_t i = 0; i < node.triCount; ++i) {
+                const Triangle& tri = triangles_[triIndices_[node.leftFirst + i]];
+                bounds.Expand(tri.v0);
+                bounds.Expand(tri.v1);
+                bounds.Expand(tri.v2);
+            }
+            SetBounds(node, bounds.min, bounds.max);
+            return HalfArea(node) * static_cast<float>(node.triCount);
         }
 
-        nodes_[leftChildIdx].leftFirst = node.leftFirst;
-        nodes_[leftChildIdx].triCount = leftCount;
+        const BVHNode& left = nodes_[nodeIdx + 1];
+        const BVHNode& right = nodes_[node.leftFirst];
+        SetBounds(node,
+                  Vector3((std::min)(left.minX, right.minX), (std::min)(left.minY, right.minY),
+                          (std::min)(left.minZ, right.minZ)),
+                  Vector3((std::max)(left.maxX, right.maxX), (std::max)(left.maxY, right.maxY),
+                          (std::max)(left.maxZ, right.maxZ)));
+        return HalfArea(node) * kTraversalCost;
+    }
+
+    static void SetBounds(BVHNode& node, const Vector3& mn, const Vector3& mx) noexcept {
+        node.minX = mn.x; node.minY = mn.y; node.minZ = mn.z;
+        node.maxX = mx.x; node.maxY = mx.y; node.maxZ = mx.z;
+    }
+
+    [[nodiscard]] static float HalfArea(const BVHNode& node) noexcept {
+        const float dx = node.maxX - node.minX;
+        const float dy = node.maxY - node.minY;
+        const float dz = node.maxZ - node.minZ;
+        return dx * dy + dy * dz + dz * dx;
+    }
 
-        nodes_[rightChildIdx].leftFirst = i;
-        nodes_[rightChildIdx].triCount = node.triCount - leftCount;
+    //! @brief extentだけ膨らませたノードAABBとレイの交差判定
+    [[nodiscard]] static bool IntersectExpanded(const BVHNode& node, const Vector3& origin, const Vector3& invDir,
+                                                const Vector3& extent, float tMax, float& outNear) noexcept {
+        float t1 = (node.minX - extent.x - origin.x) * invDir.x;
+        float t2 = (node.maxX + extent.x - origin.x) * invDir.x;
+        float tmin = (std::min)(t1, t2);
+        float tmax = (std::max)(t1, t2);
 
-        // 現在のノードを内部ノードに変換
-        node.leftFirst = leftChildIdx;
-        node.triCount = 0;
+        t1 = (node.minY - extent.y - origin.y) * invDir.y;
+        t2 = (node.maxY + extent.y - origin.y) * invDir.y;
+        tmin = (std::max)(tmin, (std::min)(t1, t2));
+        tmax = (std::min)(tmax, (std::max)(t1, t2));
+
+        t1 = (node.minZ - extent.z - origin.z) * invDir.z;
+        t2 = (node.maxZ + extent.z - origin.z) * invDir.z;
+        tmin = (std::max)(tmin, (std::min)(t1, t2));
+        tmax = (std::min)(tmax, (std::max)(t1, t2));
 
-        // 子のAABBを更新して再帰
-        UpdateNodeBounds(leftChildIdx);
-        UpdateNodeBounds(rightChildIdx);
-        Subdivide(leftChildIdx);
-        Subdivide(rightChildIdx);
+        outNear = (std::max)(0.0f, tmin);
+        return tmax >= outNear && tmin <= tMax;
     }
 
     //! @brief レイ-三角形交差判定（Möller-Trumbore法）
@@ -332,10 +901,20 @@ private:
         return false;
     }
 
-    std::vector<Triangle> triangles_;
-    std::vector<BVHNode> nodes_;
-    uint32_t rootIndex_ = 0;
-    uint32_t nodesUsed_ = 0;
+    //! @brief リフィットの並列単位（深さ優先配列の連続区間 = 1つの部分木）
+    struct RefitRange {
+        uint32_t begin;
+        uint32_t end;
+        float cost = 0.0f;      //!< 部分木のSAHコスト（正規化前）
+    };
+
+    std::vector<Triangle> triangles_;       //!< 三角形（入力順）
+    std::vector<uint32_t> triIndices_;      //!< 葉が参照する三角形インデックス
+    std::vector<BVHNode> nodes_;            //!< ノード（深さ優先順、ルートは0）
+    std::vector<RefitRange> refitRanges_;   //!< リフィットの部分木
+    std::vector<uint32_t> refitTop_;        //!< 部分木より上の内部ノード（前順）
+    BVHBuildStats stats_;
+    float sahCost_ = 0.0f;                  //!< 現在のSAHコスト
 };
 
 } // namespace Physics
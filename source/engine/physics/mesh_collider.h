@@ -1,16 +1,20 @@
 //----------------------------------------------------------------------------
 //! @file   mesh_collider.h
-//! @brief  メッシュコライダー - BVHによる高速レイキャスト
+//! @brief  メッシュコライダー - 多分木BVHによる高速レイキャスト
 //----------------------------------------------------------------------------
 #pragma once
 
 
 #include "raycast.h"
 #include "bvh.h"
+#include "wide_bvh.h"
+#include "shape_query.h"
 #include "engine/mesh/mesh.h"
 #include "engine/mesh/vertex_format.h"
 #include <vector>
+#include <atomic>
 #include <memory>
+#include <span>
 
 namespace Physics {
 
@@ -18,7 +22,13 @@ namespace Physics {
 //! @brief メッシュコライダー
 //!
 //! BVH（Bounding Volume Hierarchy）を使用した高速レイキャスト。
-//! 構築時にBVHを生成し、レイキャストをO(log n)で実行。
+//! 構築時に二分木BVHを生成して多分木（RaycastBVH）に畳み込み、
+//! レイキャストをO(log n)で実行。大量のレイはRaycastBatchでまとめて判定する。
+//! 球・カプセルのスイープと球・AABBの重なり判定は二分木BVHで候補を絞って行う。
+//!
+//! 移動床・破壊オブジェクト・スキンメッシュのように頂点が動く場合は Refit で
+//! BVHのAABBだけを更新する。SAHコストが構築時の kRebuildSahRatio 倍を超えたら
+//! JobSystemで新しいBVHをバックグラウンド構築し、完成後の Refit で差し替える。
 //!
 //! @code
 //! auto collider = MeshCollider::CreateFromMeshDesc(meshDesc);
@@ -28,10 +38,24 @@ namespace Physics {
 //! if (collider->Raycast(ray, 100.0f, hit)) {
 //!     // ヒット処理
 //! }
+//!
+//! std::vector<RaycastHit> hits(rays.size());
+//! collider->RaycastBatch(rays, 100.0f, hits);
+//!
+//! ShapeHit contact;
+//! if (collider->SweepCapsule(feet, head, 0.5f, moveDir, moveLength, contact)) {
+//!     // contact.distance まで移動して contact.normal に沿って滑らせる
+//! }
 //! @endcode
 //============================================================================
 class MeshCollider {
 public:
+    //! @brief この件数以上の形状クエリは一括実行時に並列化
+    static constexpr uint32_t kMinParallelShapeQueries = 16;
+
+    //! @brief リフィット後のSAHコストが構築時のこの倍率を超えたら再構築
+    static constexpr float kRebuildSahRatio = 1.5f;
+
     //------------------------------------------------------------------------
     // 生成
     //------------------------------------------------------------------------
@@ -96,6 +120,46 @@ public:
         return worldMatrix_;
     }
 
+    //------------------------------------------------------------------------
+    // 変形
+    //------------------------------------------------------------------------
+
+    //! @brief 頂点位置を更新してBVHをリフィット
+    //!
+    //! 分割は変えずにAABBだけを更新する。バックグラウンドの再構築が完了していれば
+    //! 先に新しいBVHへ差し替えてから、現在の頂点でリフィットする。
+    //! クエリと同時に呼ばないこと（SetWorldMatrixと同じくフレームの更新フェーズで呼ぶ）。
+    //! @param newPositions 頂点位置（生成時と同じ頂点数・同じ並び）
+    void Refit(std::span<const Vector3> newPositions) {
+        if (newPositions.size() != positions_.size() || !bvh_.IsBuilt()) return;
+        std::copy(newPositions.begin(), newPositions.end(), positions_.begin());
+
+        // 完成した再構築結果を取り込む（構築時点の頂点は古いので、この後リフィットする）
+        if (rebuild_ && rebuild_->ready.load(std::memory_order_acquire)) {
+            bvh_ = std::move(rebuild_->bvh);
+            wideBvh_ = std::move(rebuild_->wideBvh);
+            rebuild_.reset();
+        }
+
+        bvh_.Refit(positions_, indices_);
+        wideBvh_.Refit(bvh_);
+
+        // ルートのAABBがそのままローカルバウンディングボックスになる
+        const BVHNode& root = bvh_.GetNodes()[0];
+        localBounds_.min = Vector3(root.minX, root.minY, root.minZ);
+        localBounds_.max = Vector3(root.maxX, root.maxY, root.maxZ);
+        UpdateWorldBounds();
+
+        if (!rebuild_ && bvh_.GetSahDegradation() > kRebuildSahRatio) {
+            StartRebuild();
+        }
+    }
+
+    //! @brief バックグラウンドでBVHを再構築中か
+    [[nodiscard]] bool IsRebuildPending() const noexcept {
+        return rebuild_ != nullptr;
+    }
+
     //------------------------------------------------------------------------
     // レイキャスト
     //------------------------------------------------------------------------
@@ -121,26 +185,185 @@ public:
         // BVHでレイキャスト
         float t;
         uint32_t triIndex;
-        if (!bvh_.Intersect(localOrigin, localDir, maxDistance, t, triIndex)) {
+        if (!wideBvh_.Intersect(localOrigin, localDir, maxDistance, t, triIndex)) {
             return false;
         }
 
-        // ヒット情報を構築
-        Vector3 localPoint = localOrigin + localDir * t;
+        FillHit(ray, localOrigin, localDir, t, triIndex, outHit);
+        return true;
+    }
 
-        const Vector3& v0 = positions_[indices_[triIndex * 3 + 0]];
-        const Vector3& v1 = positions_[indices_[triIndex * 3 + 1]];
-        const Vector3& v2 = positions_[indices_[triIndex * 3 + 2]];
-        Vector3 localNormal = CalculateTriangleNormal(v0, v1, v2);
+    //! @brief 一括レイキャスト（ワールド空間）
+    //!
+    //! レイをローカル空間に変換してから、64本ずつのチャンク単位のジョブで
+    //! 各レイを個別にBVHでたどる（複数レイをSIMDでまとめるパケット走査ではない）。
+    //! レイ数が多い場合は変換・判定・結果の構築をJobSystemに分散する。
+    //! @param rays レイ（ワールド空間）
+    //! @param maxDistance 最大距離
+    //! @param outHits [out] レイごとの結果（rays と同じ要素数）
+    //! @return ヒットしたレイの数
+    size_t RaycastBatch(
+        std::span<const Ray> rays,
+        float maxDistance,
+        std::span<RaycastHit> outHits) const
+    {
+        const uint32_t rayCount = static_cast<uint32_t>((std::min)(rays.size(), outHits.size()));
+        if (rayCount == 0) return 0;
+
+        // ワールドAABBでカリングし、残りをローカル空間に変換
+        std::vector<BVHRay> localRays(rayCount);
+        ForEachRange(rayCount, [this, &rays, &localRays, maxDistance](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                BVHRay& local = localRays[i];
+                if (!RayAABBIntersect(rays[i], worldBounds_.min, worldBounds_.max, maxDistance)) {
+                    local.tMax = 0.0f;
+                    continue;
+                }
+                local.origin = Vector3::Transform(rays[i].origin, worldMatrixInverse_);
+                local.direction = Vector3::TransformNormal(rays[i].direction, worldMatrixInverse_);
+                local.direction.Normalize();
+                local.tMax = maxDistance;
+            }
+        });
+
+        std::vector<BVHRayHit> localHits(rayCount);
+        wideBvh_.IntersectBatch(localRays, localHits);
+
+        std::atomic<size_t> hitCount{0};
+        ForEachRange(rayCount, [&](uint32_t begin, uint32_t end) {
+            size_t hits = 0;
+            for (uint32_t i = begin; i < end; ++i) {
+                outHits[i].Reset();
+                if (!localHits[i].IsHit()) continue;
+                FillHit(rays[i], localRays[i].origin, localRays[i].direction,
+                        localHits[i].t, localHits[i].triIndex, outHits[i]);
+                ++hits;
+            }
+            hitCount.fetch_add(hits, std::memory_order_relaxed);
+        });
+        return hitCount.load(std::memory_order_relaxed);
+    }
 
-        // ワールド空間に変換
-        outHit.point = Vector3::Transform(localPoint, worldMatrix_);
-        outHit.normal = Vector3::TransformNormal(localNormal, worldMatrix_);
-        outHit.normal.Normalize();
-        outHit.distance = Vector3::Distance(ray.origin, outHit.point);
-        outHit.hit = true;
+    //------------------------------------------------------------------------
+    // 形状クエリ（ワールド空間）
+    //------------------------------------------------------------------------
 
-        return true;
+    //! @brief 球と重なる三角形をすべて取得
+    //! @param outHits [out] 末尾に追加（distanceはめり込み深さ）
+    //! @return 追加したヒット数
+    size_t OverlapSphere(const Vector3& center, float radius, std::vector<ShapeHit>& outHits) const {
+        const size_t before = outHits.size();
+        ForEachTriangleInBox(center, Vector3(radius, radius, radius),
+            [&](const Vector3& v0, const Vector3& v1, const Vector3& v2, uint32_t triIndex) {
+                ShapeHit hit;
+                if (SphereTriangleOverlap(center, radius, v0, v1, v2, hit)) {
+                    hit.triangleIndex = triIndex;
+                    outHits.push_back(hit);
+                }
+            });
+        return outHits.size() - before;
+    }
+
+    //! @brief 球と重なる三角形のうち、最もめり込みが深いものを取得
+    [[nodiscard]] bool OverlapSphere(const Vector3& center, float radius, ShapeHit& outHit) const {
+        outHit.Reset();
+        ForEachTriangleInBox(center, Vector3(radius, radius, radius),
+            [&](const Vector3& v0, const Vector3& v1, const Vector3& v2, uint32_t triIndex) {
+                ShapeHit hit;
+                if (SphereTriangleOverlap(center, radius, v0, v1, v2, hit) &&
+                    (!outHit.hit || hit.distance > outHit.distance)) {
+                    hit.triangleIndex = triIndex;
+                    outHit = hit;
+                }
+            });
+        return outHit.hit;
+    }
+
+    //! @brief AABBと重なる三角形をすべて取得
+    //! @param outHits [out] 末尾に追加（normalは面法線、distanceはその方向へのめり込み深さ）
+    //! @return 追加したヒット数
+    size_t OverlapAABB(const BoundingBox& box, std::vector<ShapeHit>& outHits) const {
+        const size_t before = outHits.size();
+        const Vector3 center = box.Center();
+        const Vector3 extents = box.Extents();
+        ForEachTriangleInBox(center, extents,
+            [&](const Vector3& v0, const Vector3& v1, const Vector3& v2, uint32_t triIndex) {
+                ShapeHit hit;
+                if (AABBTriangleOverlap(center, extents, v0, v1, v2, hit)) {
+                    hit.triangleIndex = triIndex;
+                    outHits.push_back(hit);
+                }
+            });
+        return outHits.size() - before;
+    }
+
+    //! @brief 球スイープ
+    //! @param direction 移動方向（正規化）
+    //! @param outHit [out] 最初の接触（開始時点で重なっていれば distance = 0）
+    [[nodiscard]] bool SweepSphere(
+        const Vector3& center,
+        float radius,
+        const Vector3& direction,
+        float maxDistance,
+        ShapeHit& outHit) const
+    {
+        outHit.Reset();
+        SweepShape(center, direction, Vector3(radius, radius, radius), maxDistance, outHit,
+            [&](const Vector3& v0, const Vector3& v1, const Vector3& v2, float tMax, ShapeHit& hit) {
+                return SweepSphereTriangle(center, radius, direction, tMax, v0, v1, v2, hit);
+            });
+        return outHit.hit;
+    }
+
+    //! @brief カプセルスイープ
+    //! @param point0, point1 カプセルの軸の端点
+    //! @param direction 移動方向（正規化）
+    //! @param outHit [out] 最初の接触（開始時点で重なっていれば distance = 0）
+    [[nodiscard]] bool SweepCapsule(
+        const Vector3& point0,
+        const Vector3& point1,
+        float radius,
+        const Vector3& direction,
+        float maxDistance,
+        ShapeHit& outHit) const
+    {
+        outHit.Reset();
+        const Vector3 center = (point0 + point1) * 0.5f;
+        const Vector3 halfAxis = (point1 - point0) * 0.5f;
+        const Vector3 extent(std::abs(halfAxis.x) + radius, std::abs(halfAxis.y) + radius,
+                             std::abs(halfAxis.z) + radius);
+        SweepShape(center, direction, extent, maxDistance, outHit,
+            [&](const Vector3& v0, const Vector3& v1, const Vector3& v2, float tMax, ShapeHit& hit) {
+                return SweepCapsuleTriangle(point0, point1, radius, direction, tMax, v0, v1, v2, hit);
+            });
+        return outHit.hit;
+    }
+
+    //! @brief 球スイープを一括実行（全エージェントのキャラクター移動を1パスで解決する用途）
+    //! @param outHits [out] クエリごとの結果（queries と同じ要素数）
+    //! @return 接触したクエリの数
+    size_t SweepSphereBatch(std::span<const SphereSweepQuery> queries, std::span<ShapeHit> outHits) const {
+        return RunQueryBatch(queries, outHits, [this](const SphereSweepQuery& q, ShapeHit& hit) {
+            return SweepSphere(q.center, q.radius, q.direction, q.maxDistance, hit);
+        });
+    }
+
+    //! @brief カプセルスイープを一括実行
+    //! @param outHits [out] クエリごとの結果（queries と同じ要素数）
+    //! @return 接触したクエリの数
+    size_t SweepCapsuleBatch(std::span<const CapsuleSweepQuery> queries, std::span<ShapeHit> outHits) const {
+        return RunQueryBatch(queries, outHits, [this](const CapsuleSweepQuery& q, ShapeHit& hit) {
+            return SweepCapsule(q.point0, q.point1, q.radius, q.direction, q.maxDistance, hit);
+        });
+    }
+
+    //! @brief 球の重なり判定を一括実行（クエリごとに最もめり込みが深い接触）
+    //! @param outHits [out] クエリごとの結果（queries と同じ要素数）
+    //! @return 重なったクエリの数
+    size_t OverlapSphereBatch(std::span<const SphereOverlapQuery> queries, std::span<ShapeHit> outHits) const {
+        return RunQueryBatch(queries, outHits, [this](const SphereOverlapQuery& q, ShapeHit& hit) {
+            return OverlapSphere(q.center, q.radius, hit);
+        });
     }
 
     //------------------------------------------------------------------------
@@ -171,6 +394,11 @@ public:
         return bvh_.IsBuilt();
     }
 
+    //! @brief 二分木BVHを取得（品質の確認用）
+    [[nodiscard]] const BVH& GetBVH() const noexcept {
+        return bvh_;
+    }
+
 public:
     MeshCollider() = default;
 
@@ -193,6 +421,131 @@ private:
         }
 
         bvh_.Build(std::move(triangles));
+        wideBvh_.Build(bvh_);
+    }
+
+    //! @brief 再構築中のBVH（ジョブと共有し、完成したらreadyを立てる）
+    struct PendingRebuild {
+        BVH bvh;
+        RaycastBVH wideBvh;
+        std::atomic<bool> ready{false};
+    };
+
+    //! @brief 現在の三角形からBVHを再構築（JobSystemがあればバックグラウンド）
+    //!
+    //! ジョブは結果をPendingRebuildに書き込むだけで、現在のBVHには触れない。
+    //! コライダーが先に破棄されても、共有しているPendingRebuildはジョブ終了まで残る。
+    void StartRebuild() {
+        std::vector<Triangle> triangles = bvh_.GetTriangles();
+        if (!JobSystem::IsCreated()) {
+            bvh_.Build(std::move(triangles));
+            wideBvh_.Build(bvh_);
+            return;
+        }
+
+        auto rebuild = std::make_shared<PendingRebuild>();
+        rebuild_ = rebuild;
+        JobSystem::Get().SubmitJob(JobDesc::LowPriority([rebuild, triangles = std::move(triangles)]() mutable {
+            rebuild->bvh.Build(std::move(triangles));
+            rebuild->wideBvh.Build(rebuild->bvh);
+            rebuild->ready.store(true, std::memory_order_release);
+        }));
+    }
+
+    //! @brief ローカル空間のヒットからワールド空間のヒット情報を構築
+    void FillHit(const Ray& ray, const Vector3& localOrigin, const Vector3& localDir,
+                 float t, uint32_t triIndex, RaycastHit& outHit) const {
+        Vector3 localPoint = localOrigin + localDir * t;
+
+        const Vector3& v0 = positions_[indices_[triIndex * 3 + 0]];
+        const Vector3& v1 = positions_[indices_[triIndex * 3 + 1]];
+        const Vector3& v2 = positions_[indices_[triIndex * 3 + 2]];
+        Vector3 localNormal = CalculateTriangleNormal(v0, v1, v2);
+
+        // ワールド空間に変換
+        outHit.point = Vector3::Transform(localPoint, worldMatrix_);
+        outHit.normal = Vector3::TransformNormal(localNormal, worldMatrix_);
+        outHit.normal.Normalize();
+        outHit.distance = Vector3::Distance(ray.origin, outHit.point);
+        outHit.hit = true;
+    }
+
+    //! @brief [0, count) を分割して処理（minParallelCount件以上でJobSystemがあれば並列）
+    template<typename Func>
+    static void ForEachRange(uint32_t count, Func&& func,
+                             uint32_t minParallelCount = RaycastBVH::kMinParallelRays) {
+        if (count >= minParallelCount && JobSystem::HasWorkers()) {
+            JobSystem::Get().ParallelForRange(0, count, func, (std::max)(1u, minParallelCount / 4)).Wait();
+        } else {
+            func(0, count);
+        }
+    }
+
+    //! @brief 形状クエリを一括実行し、ヒット数を返す
+    template<typename Query, typename Func>
+    size_t RunQueryBatch(std::span<const Query> queries, std::span<ShapeHit> outHits, Func&& func) const {
+        const uint32_t count = static_cast<uint32_t>((std::min)(queries.size(), outHits.size()));
+        std::atomic<size_t> hitCount{0};
+        ForEachRange(count, [&](uint32_t begin, uint32_t end) {
+            size_t hits = 0;
+            for (uint32_t i = begin; i < end; ++i) {
+                hits += func(queries[i], outHits[i]) ? 1 : 0;
+            }
+            hitCount.fetch_add(hits, std::memory_order_relaxed);
+        }, kMinParallelShapeQueries);
+        return hitCount.load(std::memory_order_relaxed);
+    }
+
+    //! @brief ワールドAABBと重なりうる三角形をワールド座標で列挙
+    //! @param func void(v0, v1, v2, triIndex)
+    template<typename Func>
+    void ForEachTriangleInBox(const Vector3& center, const Vector3& extents, Func&& func) const {
+        if (!bvh_.IsBuilt()) return;
+        const Vector3 localCenter = Vector3::Transform(center, worldMatrixInverse_);
+        const Vector3 localExtents = TransformExtents(extents, worldMatrixInverse_);
+        AABB localBounds;
+        localBounds.min = localCenter - localExtents;
+        localBounds.max = localCenter + localExtents;
+        bvh_.QueryOverlap(localBounds, [&](const Triangle& tri) {
+            func(Vector3::Transform(tri.v0, worldMatrix_),
+                 Vector3::Transform(tri.v1, worldMatrix_),
+                 Vector3::Transform(tri.v2, worldMatrix_), tri.index);
+        });
+    }
+
+    //! @brief 形状スイープの共通処理
+    //!
+    //! 移動量はローカル空間でも同じパラメータtになるよう、方向を正規化せずに変換する。
+    //! 三角形はワールド座標に戻してから判定するので、非一様スケールでも正確。
+    //! @param sweep bool(v0, v1, v2, tMax, ShapeHit&)
+    template<typename Func>
+    void SweepShape(const Vector3& center, const Vector3& direction, const Vector3& extents,
+                    float maxDistance, ShapeHit& outHit, Func&& sweep) const {
+        if (!bvh_.IsBuilt()) return;
+        const Vector3 localCenter = Vector3::Transform(center, worldMatrixInverse_);
+        const Vector3 localDir = Vector3::TransformNormal(direction, worldMatrixInverse_);
+        const Vector3 localExtents = TransformExtents(extents, worldMatrixInverse_);
+
+        float tMax = maxDistance;
+        bvh_.QuerySweep(localCenter, localDir, localExtents, tMax, [&](const Triangle& tri) {
+            ShapeHit hit;
+            if (sweep(Vector3::Transform(tri.v0, worldMatrix_),
+                      Vector3::Transform(tri.v1, worldMatrix_),
+                      Vector3::Transform(tri.v2, worldMatrix_), tMax, hit) &&
+                (!outHit.hit || hit.distance < outHit.distance)) {
+                hit.triangleIndex = tri.index;
+                outHit = hit;
+                tMax = hit.distance;
+            }
+        });
+    }
+
+    //! @brief AABBの半径を行列で変換（回転・スケール後も元の箱を包む半径）
+    [[nodiscard]] static Vector3 TransformExtents(const Vector3& e, const Matrix& m) noexcept {
+        return Vector3(
+            std::abs(m._11) * e.x + std::abs(m._21) * e.y + std::abs(m._31) * e.z,
+            std::abs(m._12) * e.x + std::abs(m._22) * e.y + std::abs(m._32) * e.z,
+            std::abs(m._13) * e.x + std::abs(m._23) * e.y + std::abs(m._33) * e.z);
     }
 
     void UpdateWorldBounds() {
@@ -222,7 +575,9 @@ private:
     BoundingBox worldBounds_;
     Matrix worldMatrix_ = Matrix::Identity;
     Matrix worldMatrixInverse_ = Matrix::Identity;
-    BVH bvh_;  // 空間分割構造
+    BVH bvh_;               // 空間分割構造（二分木）
+    RaycastBVH wideBvh_;    // レイキャスト用の多分木
+    std::shared_ptr<PendingRebuild> rebuild_;   // バックグラウンドで再構築中のBVH
 };
 
 using MeshColliderPtr = std::shared_ptr<MeshCollider>;
@@ -0,0 +1,546 @@
+//----------------------------------------------------------------------------
+//! @file   shape_query.h
+//! @brief  形状クエリ - 球・カプセルのスイープとAABB・球の重なり判定（三角形単位）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "raycast.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Physics {
+
+//============================================================================
+//! @brief 形状クエリのヒット情報
+//!
+//! スイープ: distance は接触するまでの移動距離、normal は三角形から形状へ向く接触法線。
+//! 重なり: distance は normal 方向への押し出し量（めり込み深さ）。
+//============================================================================
+struct ShapeHit {
+    Vector3 point;                      //!< 接触点（三角形上）
+    Vector3 normal;                     //!< 接触法線（三角形→形状）
+    float distance = 0.0f;              //!< 移動距離 または めり込み深さ
+    uint32_t triangleIndex = UINT32_MAX;  //!< 三角形インデックス
+    bool hit = false;                   //!< ヒットしたか
+
+    //! @brief ヒット情報をリセット
+    void Reset() noexcept {
+        point = Vector3::Zero;
+        normal = Vector3::Up;
+        distance = (std::numeric_limits<float>::max)();
+        triangleIndex = UINT32_MAX;
+        hit = false;
+    }
+};
+
+//============================================================================
+//! @brief 一括クエリ用の入力（ワールド空間）
+//============================================================================
+struct SphereSweepQuery {
+    Vector3 center;             //!< 球の中心
+    Vector3 direction;          //!< 移動方向（正規化）
+    float radius = 0.0f;        //!< 半径
+    float maxDistance = 0.0f;   //!< 最大移動距離
+};
+
+struct CapsuleSweepQuery {
+    Vector3 point0;             //!< 軸の端点
+    Vector3 point1;             //!< 軸の端点
+    Vector3 direction;          //!< 移動方向（正規化）
+    float radius = 0.0f;        //!< 半径
+    float maxDistance = 0.0f;   //!< 最大移動距離
+};
+
+struct SphereOverlapQuery {
+    Vector3 center;             //!< 球の中心
+    float radius = 0.0f;        //!< 半径
+};
+
+//============================================================================
+//! @brief 三角形上で点に最も近い点（Ericson, Real-Time Collision Detection 5.1.5）
+//============================================================================
+[[nodiscard]] inline Vector3 ClosestPointOnTriangle(
+    const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) noexcept
+{
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Vector3 ap = p - a;
+    const float d1 = ab.Dot(ap);
+    const float d2 = ac.Dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const Vector3 bp = p - b;
+    const float d3 = ab.Dot(bp);
+    const float d4 = ac.Dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const Vector3 cp = p - c;
+    const float d5 = ab.Dot(cp);
+    const float d6 = ac.Dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+//============================================================================
+//! @brief 2線分の最近接点（Ericson 5.1.9）
+//! @return 最近接点間の距離の2乗
+//============================================================================
+inline float ClosestPointsSegmentSegment(
+    const Vector3& p1, const Vector3& q1, const Vector3& p2, const Vector3& q2,
+    Vector3& outC1, Vector3& outC2) noexcept
+{
+    constexpr float EPSILON = 1e-12f;
+    const Vector3 d1 = q1 - p1;
+    const Vector3 d2 = q2 - p2;
+    const Vector3 r = p1 - p2;
+    const float a = d1.Dot(d1);
+    const float e = d2.Dot(d2);
+    const float f = d2.Dot(r);
+
+    float s = 0.0f;
+    float t = 0.0f;
+    if (a <= EPSILON && e <= EPSILON) {
+        // 両方とも点
+    } else if (a <= EPSILON) {
+        t = std::clamp(f / e, 0.0f, 1.0f);
+    } else {
+        const float c = d1.Dot(r);
+        if (e <= EPSILON) {
+            s = std::clamp(-c / a, 0.0f, 1.0f);
+        } else {
+            const float b = d1.Dot(d2);
+            const float denom = a * e - b * b;
+            s = denom != 0.0f ? std::clamp((b * f - c * e) / denom, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            } else if (t > 1.0f) {
+                t = 1.0f;
+                s = std::clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+    outC1 = p1 + d1 * s;
+    outC2 = p2 + d2 * t;
+    return (outC1 - outC2).LengthSquared();
+}
+
+//============================================================================
+//! @brief 線分と三角形の最近接点
+//! @return 最近接点間の距離の2乗（線分が三角形を貫通していれば0）
+//============================================================================
+inline float ClosestPointsSegmentTriangle(
+    const Vector3& p, const Vector3& q,
+    const Vector3& a, const Vector3& b, const Vector3& c,
+    Vector3& outSegment, Vector3& outTriangle) noexcept
+{
+    // 貫通判定
+    const Vector3 dir = q - p;
+    const float length = dir.Length();
+    if (length > 0.0f) {
+        float t;
+        if (RayTriangleIntersect(Ray(p, dir), a, b, c, length, t)) {
+            outSegment = p + dir * (t / length);
+            outTriangle = outSegment;
+            return 0.0f;
+        }
+    }
+
+    // 端点と三角形
+    outSegment = p;
+    outTriangle = ClosestPointOnTriangle(p, a, b, c);
+    float best = (outSegment - outTriangle).LengthSquared();
+
+    const Vector3 onTriQ = ClosestPointOnTriangle(q, a, b, c);
+    const float distQ = (q - onTriQ).LengthSquared();
+    if (distQ < best) {
+        best = distQ;
+        outSegment = q;
+        outTriangle = onTriQ;
+    }
+
+    // 線分と三角形の辺
+    const Vector3* edges[3][2] = {{&a, &b}, {&b, &c}, {&c, &a}};
+    for (const auto& edge : edges) {
+        Vector3 onSegment, onEdge;
+        const float dist = ClosestPointsSegmentSegment(p, q, *edge[0], *edge[1], onSegment, onEdge);
+        if (dist < best) {
+            best = dist;
+            outSegment = onSegment;
+            outTriangle = onEdge;
+        }
+    }
+    return best;
+}
+
+//============================================================================
+//! @brief 球と三角形の重なり判定
+//! @param outHit [out] 接触点・押し出し法線・めり込み深さ（triangleIndexは設定しない）
+//! @return 重なっていればtrue
+//============================================================================
+inline bool SphereTriangleOverlap(
+    const Vector3& center, float radius,
+    const Vector3& v0, const Vector3& v1, const Vector3& v2,
+    ShapeHit& outHit) noexcept
+{
+    const Vector3 closest = ClosestPointOnTriangle(center, v0, v1, v2);
+    const Vector3 delta = center - closest;
+    const float distSq = delta.LengthSquared();
+    if (distSq > radius * radius) return false;
+
+    const float dist = std::sqrt(distSq);
+    if (dist > 1e-6f) {
+        outHit.normal = delta * (1.0f / dist);
+    } else {
+        // 中心が三角形上: 面法線で押し出す
+        outHit.normal = CalculateTriangleNormal(v0, v1, v2);
+    }
+    outHit.point = closest;
+    outHit.distance = radius - dist;
+    outHit.hit = true;
+    return true;
+}
+
+//============================================================================
+//! @brief AABBと三角形の重なり判定（分離軸13本、Akenine-Möller法）
+//! @param center AABBの中心
+//! @param halfExtents AABBの半径（各軸）
+//! @param outHit [out] 面法線方向の押し出しと三角形上の最近接点（triangleIndexは設定しない）
+//! @return 重なっていればtrue
+//============================================================================
+inline bool AABBTriangleOverlap(
+    const Vector3& center, const Vector3& halfExtents,
+    const Vector3& v0, const Vector3& v1, const Vector3& v2,
+    ShapeHit& outHit) noexcept
+{
+    const Vector3 p0 = v0 - center;
+    const Vector3 p1 = v1 - center;
+    const Vector3 p2 = v2 - center;
+
+    // 軸に投影した三角形の範囲がボックスの範囲と離れていれば分離
+    auto separated = [&](const Vector3& axis) {
+        const float d0 = p0.Dot(axis);
+        const float d1 = p1.Dot(axis);
+        const float d2 = p2.Dot(axis);
+        const float r = halfExtents.x * std::abs(axis.x) +
+                        halfExtents.y * std::abs(axis.y) +
+                        halfExtents.z * std::abs(axis.z);
+        return (std::min)({d0, d1, d2}) > r || (std::max)({d0, d1, d2}) < -r;
+    };
+
+    // ボックスの3軸
+    if (separated(Vector3(1, 0, 0)) || separated(Vector3(0, 1, 0)) || separated(Vector3(0, 0, 1))) {
+        return false;
+    }
+
+    // 三角形の面法線
+    const Vector3 e0 = p1 - p0;
+    const Vector3 e1 = p2 - p1;
+    const Vector3 e2 = p0 - p2;
+    const Vector3 faceNormal = e0.Cross(p2 - p0);
+    if (separated(faceNormal)) return false;
+
+    // ボックスの軸 x 三角形の辺（9本）
+    const Vector3 boxAxes[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)};
+    const Vector3 triEdges[3] = {e0, e1, e2};
+    for (const Vector3& boxAxis : boxAxes) {
+        for (const Vector3& edge : triEdges) {
+            if (separated(boxAxis.Cross(edge))) return false;
+        }
+    }
+
+    // 面法線方向の押し出し（中心が面の表側にある向き）
+    Vector3 normal = faceNormal;
+    normal.Normalize();
+    float centerDist = -p0.Dot(normal);
+    if (centerDist < 0.0f) {
+        normal = -normal;
+        centerDist = -centerDist;
+    }
+    const float boxRadius = halfExtents.x * std::abs(normal.x) +
+                            halfExtents.y * std::abs(normal.y) +
+                            halfExtents.z * std::abs(normal.z);
+    outHit.point = ClosestPointOnTriangle(center, v0, v1, v2);
+    outHit.normal = normal;
+    outHit.distance = (std::max)(0.0f, boxRadius - centerDist);
+    outHit.hit = true;
+    return true;
+}
+
+namespace detail {
+
+//! @brief レイと球の最初の交差（始点が球の外側の場合のみ）
+inline bool RaySphere(const Vector3& origin, const Vector3& dir, const Vector3& center, float radius,
+                      float& outT) noexcept
+{
+    const Vector3 m = origin - center;
+    const float b = m.Dot(dir);
+    const float c = m.Dot(m) - radius * radius;
+    if (c > 0.0f && b > 0.0f) return false;
+    const float disc = b * b - c;
+    if (disc < 0.0f) return false;
+    const float t = -b - std::sqrt(disc);
+    if (t < 0.0f) return false;
+    outT = t;
+    return true;
+}
+
+//! @brief レイと有限円柱（軸 a→b、端の蓋なし）の最初の交差
+//! @param outS [out] 交点の軸方向パラメータ [0, 1]
+inline bool RayCylinder(const Vector3& origin, const Vector3& dir,
+                        const Vector3& a, const Vector3& b, float radius,
+                        float& outT, float& outS) noexcept
+{
+    const Vector3 ab = b - a;
+    const Vector3 ao = origin - a;
+    const float abab = ab.Dot(ab);
+    if (abab <= 1e-12f) return false;
+    const float aoab = ao.Dot(ab);
+    const float dab = dir.Dot(ab);
+
+    const float qa = abab * dir.Dot(dir) - dab * dab;
+    if (qa <= 1e-12f * abab) return false;   // 軸と平行（端点の球で扱う）
+    const float qb = abab * ao.Dot(dir) - aoab * dab;
+    const float qc = abab * ao.Dot(ao) - aoab * aoab - radius * radius * abab;
+    const float disc = qb * qb - qa * qc;
+    if (disc < 0.0f) return false;
+
+    const float t = (-qb - std::sqrt(disc)) / qa;
+    if (t < 0.0f) return false;
+    const float s = (aoab + t * dab) / abab;
+    if (s < 0.0f || s > 1.0f) return false;
+    outT = t;
+    outS = s;
+    return true;
+}
+
+//! @brief 点が三角形の内側か（点は三角形の平面上）
+inline bool PointInTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c,
+                            const Vector3& normal) noexcept
+{
+    return (b - a).Cross(p - a).Dot(normal) >= 0.0f &&
+           (c - b).Cross(p - b).Dot(normal) >= 0.0f &&
+           (a - c).Cross(p - c).Dot(normal) >= 0.0f;
+}
+
+//! @brief 移動する球が三角形に初めて接触する時刻（初期状態で重なっていない前提）
+inline bool SweepSphereTriangleNoOverlap(
+    const Vector3& center, float radius, const Vector3& dir, float maxDistance,
+    const Vector3& v0, const Vector3& v1, const Vector3& v2,
+    ShapeHit& outHit) noexcept
+{
+    bool found = false;
+    float best = maxDistance;
+
+    // 面の内側
+    Vector3 normal = (v1 - v0).Cross(v2 - v0);
+    const float normalLength = normal.Length();
+    if (normalLength > 1e-12f) {
+        normal = normal * (1.0f / normalLength);
+        float dist = (center - v0).Dot(normal);
+        if (dist < 0.0f) {
+            normal = -normal;
+            dist = -dist;
+        }
+        const float approach = -dir.Dot(normal);
+        if (approach > 1e-8f) {
+            const float t = (dist - radius) / approach;
+            if (t >= 0.0f && t <= best) {
+                const Vector3 contact = center + dir * t - normal * radius;
+                // CCWに依存しないよう、元の向きの法線で内側判定
+                const Vector3 faceNormal = (v1 - v0).Cross(v2 - v0);
+                if (PointInTriangle(contact, v0, v1, v2, faceNormal)) {
+                    best = t;
+                    outHit.point = contact;
+                    outHit.normal = normal;
+                    found = true;
+                }
+            }
+        }
+    }
+
+    // 頂点
+    const Vector3* vertices[3] = {&v0, &v1, &v2};
+    for (const Vector3* v : vertices) {
+        float t;
+        if (RaySphere(center, dir, *v, radius, t) && t <= best) {
+            best = t;
+            outHit.point = *v;
+            outHit.normal = (center + dir * t - *v) * (1.0f / radius);
+            found = true;
+        }
+    }
+
+    // 辺
+    for (int i = 0; i < 3; ++i) {
+        const Vector3& a = *vertices[i];
+        const Vector3& b = *vertices[(i + 1) % 3];
+        float t, s;
+        if (RayCylinder(center, dir, a, b, radius, t, s) && t <= best) {
+            best = t;
+            outHit.point = a + (b - a) * s;
+            outHit.normal = (center + dir * t - outHit.point) * (1.0f / radius);
+            found = true;
+        }
+    }
+
+    if (found) {
+        outHit.distance = best;
+        outHit.hit = true;
+    }
+    return found;
+}
+
+} // namespace detail
+
+//============================================================================
+//! @brief 球スイープと三角形
+//!
+//! 開始時点で重なっている場合は distance = 0 で、押し出し方向を法線として返す。
+//! @param dir 移動方向（正規化）
+//! @param outHit [out] 接触情報（triangleIndexは設定しない）
+//! @return maxDistance 以内に接触すればtrue
+//============================================================================
+inline bool SweepSphereTriangle(
+    const Vector3& center, float radius, const Vector3& dir, float maxDistance,
+    const Vector3& v0, const Vector3& v1, const Vector3& v2,
+    ShapeHit& outHit) noexcept
+{
+    if (SphereTriangleOverlap(center, radius, v0, v1, v2, outHit)) {
+        outHit.distance = 0.0f;
+        return true;
+    }
+    return detail::SweepSphereTriangleNoOverlap(center, radius, dir, maxDistance, v0, v1, v2, outHit);
+}
+
+//============================================================================
+//! @brief カプセルスイープと三角形
+//!
+//! 接触は次のいずれかで最初に起きる:
+//! 端点の球と三角形 / 三角形の頂点とカプセルの円柱 / 三角形の辺と軸の内部。
+//! 開始時点で重なっている場合は distance = 0 で、押し出し方向を法線として返す。
+//! @param point0, point1 カプセルの軸の端点
+//! @param dir 移動方向（正規化）
+//! @param outHit [out] 接触情報（triangleIndexは設定しない）
+//! @return maxDistance 以内に接触すればtrue
+//============================================================================
+inline bool SweepCapsuleTriangle(
+    const Vector3& point0, const Vector3& point1, float radius,
+    const Vector3& dir, float maxDistance,
+    const Vector3& v0, const Vector3& v1, const Vector3& v2,
+    ShapeHit& outHit) noexcept
+{
+    // 初期重なり
+    Vector3 onSegment, onTriangle;
+    const float distSq = ClosestPointsSegmentTriangle(point0, point1, v0, v1, v2, onSegment, onTriangle);
+    if (distSq <= radius * radius) {
+        const float dist = std::sqrt(distSq);
+        if (dist > 1e-6f) {
+            outHit.normal = (onSegment - onTriangle) * (1.0f / dist);
+        } else {
+            // 軸が三角形を貫通: 移動方向に逆らう向きの面法線で押し出す
+            outHit.normal = CalculateTriangleNormal(v0, v1, v2);
+            if (outHit.normal.Dot(dir) > 0.0f) outHit.normal = -outHit.normal;
+        }
+        outHit.point = onTriangle;
+        outHit.distance = 0.0f;
+        outHit.hit = true;
+        return true;
+    }
+
+    bool found = false;
+    float best = maxDistance;
+    ShapeHit candidate;
+
+    // 端点の球
+    for (const Vector3* end : {&point0, &point1}) {
+        if (detail::SweepSphereTriangleNoOverlap(*end, radius, dir, best, v0, v1, v2, candidate) &&
+            candidate.distance <= best) {
+            best = candidate.distance;
+            outHit = candidate;
+            found = true;
+        }
+    }
+
+    // 三角形の頂点とカプセルの円柱（頂点から逆方向へのレイ）
+    const Vector3 axis = point1 - point0;
+    const Vector3 back = -dir;
+    const Vector3* vertices[3] = {&v0, &v1, &v2};
+    for (const Vector3* v : vertices) {
+        float t, s;
+        if (detail::RayCylinder(*v, back, point0, point1, radius, t, s) && t <= best) {
+            best = t;
+            const Vector3 axisPoint = point0 + axis * s + dir * t;
+            outHit.point = *v;
+            outHit.normal = (axisPoint - *v) * (1.0f / radius);
+            found = true;
+        }
+    }
+
+    // 三角形の辺とカプセル軸の内部
+    // 辺上の点と軸上の点の差は平行四辺形 Q = base + s*E - u*S をなし、
+    // 移動量 dir*t が Q の平面から radius 離れた位置で Q の内側に入れば接触する。
+    for (int i = 0; i < 3; ++i) {
+        const Vector3& e0 = *vertices[i];
+        const Vector3 edge = *vertices[(i + 1) % 3] - e0;
+        Vector3 m = edge.Cross(axis);
+        const float mLength = m.Length();
+        if (mLength <= 1e-8f) continue;   // 平行（端点・頂点の判定で扱う）
+        m = m * (1.0f / mLength);
+
+        const Vector3 base = e0 - point0;
+        const float h = m.Dot(base);
+        const float side = h >= 0.0f ? 1.0f : -1.0f;
+        const float denom = m.Dot(dir);
+        if (std::abs(denom) <= 1e-8f) continue;
+        const float t = (h - side * radius) / denom;
+        if (t < 0.0f || t > best) continue;
+
+        // 平面上の点を辺と軸のパラメータに分解
+        const Vector3 w = dir * t + m * (side * radius) - base;
+        const float a11 = edge.Dot(edge);
+        const float a12 = -edge.Dot(axis);
+        const float a22 = axis.Dot(axis);
+        const float b1 = edge.Dot(w);
+        const float b2 = -axis.Dot(w);
+        const float det = a11 * a22 - a12 * a12;
+        if (std::abs(det) <= 1e-12f) continue;
+        const float s = (b1 * a22 - b2 * a12) / det;
+        const float u = (a11 * b2 - a12 * b1) / det;
+        if (s < 0.0f || s > 1.0f || u < 0.0f || u > 1.0f) continue;
+
+        best = t;
+        outHit.point = e0 + edge * s;
+        outHit.normal = m * -side;
+        found = true;
+    }
+
+    if (found) {
+        outHit.distance = best;
+        outHit.hit = true;
+    }
+    return found;
+}
+
+} // namespace Physics
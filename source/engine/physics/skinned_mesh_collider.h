@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------
+//! @file   skinned_mesh_collider.h
+//! @brief  スキンメッシュコライダー - CPUスキニングした頂点でBVHをリフィット
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "mesh_collider.h"
+#include "engine/mesh/cpu_skinning.h"
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Physics {
+
+//============================================================================
+//! @brief スキンメッシュコライダー（キャラクターごとのヒットボックス）
+//!
+//! バインドポーズの頂点でMeshColliderを構築し、Updateのたびに
+//! CpuSkinningで変形した頂点位置でBVHをリフィットする。
+//! 分割が大きく崩れた場合はMeshColliderがバックグラウンドで再構築する。
+//! 変形後の位置・法線はそのまま参照できるので、布の接続点などにも使える。
+//!
+//! @code
+//! auto hitbox = SkinnedMeshCollider::Create(mesh->GetCpuVertices(), mesh->GetCpuIndices());
+//!
+//! // 毎フレーム（Animator更新後）
+//! hitbox->Update(animator->GetSkinningMatrices());
+//! hitbox->GetCollider().SetWorldMatrix(transform->GetWorldMatrix());
+//! if (hitbox->GetCollider().Raycast(ray, 100.0f, hit)) { ... }
+//! @endcode
+//============================================================================
+class SkinnedMeshCollider {
+public:
+    //! @brief スキン頂点・インデックスから生成
+    //! @param vertices スキン頂点（コピーして保持する）
+    //! @param indices 三角形インデックス
+    //! @param withNormals 変形後の法線も計算するか
+    [[nodiscard]] static std::shared_ptr<SkinnedMeshCollider> Create(
+        std::span<const SkinnedMeshVertex> vertices,
+        std::span<const uint32_t> indices,
+        bool withNormals = false)
+    {
+        auto collider = std::make_shared<SkinnedMeshCollider>();
+        collider->vertices_.assign(vertices.begin(), vertices.end());
+        collider->positions_.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            collider->positions_.push_back(v.position);
+        }
+        if (withNormals) {
+            collider->normals_.reserve(vertices.size());
+            for (const auto& v : vertices) {
+                collider->normals_.push_back(v.normal);
+            }
+        }
+        collider->collider_ = MeshCollider::Create(
+            collider->positions_, std::vector<uint32_t>(indices.begin(), indices.end()));
+        collider->collider_->SetWorldMatrix(Matrix::Identity);
+        return collider;
+    }
+
+    //! @brief スキニング行列で頂点を変形し、BVHをリフィット
+    //!
+    //! MeshCollider::Refitと同じく、クエリと同時に呼ばないこと。
+    //! @param skinningMatrices スキニング行列（Animator::GetSkinningMatrices() など）
+    void Update(std::span<const Matrix> skinningMatrices) {
+        if (skinningMatrices.empty()) return;
+        CpuSkinning::Skin(vertices_, skinningMatrices, positions_, normals_);
+        collider_->Refit(positions_);
+    }
+
+    //! @brief コライダー（レイキャスト・形状クエリ・ワールド行列の設定）
+    [[nodiscard]] MeshCollider& GetCollider() noexcept { return *collider_; }
+    [[nodiscard]] const MeshCollider& GetCollider() const noexcept { return *collider_; }
+
+    //! @brief 変形後の頂点位置（ローカル座標）
+    [[nodiscard]] std::span<const Vector3> GetPositions() const noexcept { return positions_; }
+
+    //! @brief 変形後の法線（ローカル座標、withNormals指定時のみ）
+    [[nodiscard]] std::span<const Vector3> GetNormals() const noexcept { return normals_; }
+
+    //! @brief 頂点数
+    [[nodiscard]] size_t GetVertexCount() const noexcept { return vertices_.size(); }
+
+private:
+    std::vector<SkinnedMeshVertex> vertices_;   //!< バインドポーズのスキン頂点
+    std::vector<Vector3> positions_;            //!< 変形後の頂点位置
+    std::vector<Vector3> normals_;              //!< 変形後の法線（withNormals時のみ）
+    std::shared_ptr<MeshCollider> collider_;    //!< リフィット対象
+};
+
+} // namespace Physics
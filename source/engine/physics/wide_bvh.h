@@ -0,0 +1,604 @@
+//----------------------------------------------------------------------------
+//! @file   wide_bvh.h
+//! @brief  多分木BVH（BVH4/BVH8）- SIMDノード判定と一括レイキャスト
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "bvh.h"
+#include "engine/core/job_system.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Physics {
+
+//============================================================================
+//! @brief 一括レイキャスト用のレイ（ローカル空間）
+//!
+//! tMaxが0以下のレイは判定しない（ワールドAABBで事前に棄却した場合など）。
+//============================================================================
+struct BVHRay {
+    Vector3 origin;         //!< 原点
+    Vector3 direction;      //!< 方向（正規化）
+    float tMax = 0.0f;      //!< 最大距離
+};
+
+//============================================================================
+//! @brief 一括レイキャストの結果
+//============================================================================
+struct BVHRayHit {
+    float t = 0.0f;                     //!< 交差距離
+    uint32_t triIndex = UINT32_MAX;     //!< 三角形インデックス（UINT32_MAXならヒットなし）
+
+    [[nodiscard]] bool IsHit() const noexcept { return triIndex != UINT32_MAX; }
+};
+
+//============================================================================
+//! @brief 4三角形分のSoAパケット（Möller-Trumboreを4本同時に評価）
+//!
+//! 余りのレーンは辺ベクトルを0にして常に不成立にする。
+//============================================================================
+struct alignas(16) TrianglePacket4 {
+    float v0x[4], v0y[4], v0z[4];
+    float e1x[4], e1y[4], e1z[4];
+    float e2x[4], e2y[4], e2z[4];
+    uint32_t index[4];      //!< Triangle::index（空きレーンはUINT32_MAX）
+};
+
+namespace detail {
+
+//----------------------------------------------------------------------------
+//! @brief 子ノード判定に使うSIMD幅ごとの演算
+//----------------------------------------------------------------------------
+template<uint32_t Width>
+struct WideFloat;
+
+template<>
+struct WideFloat<4> {
+    using Type = __m128;
+    static Type Load(const float* p) noexcept { return _mm_load_ps(p); }
+    static Type Set1(float v) noexcept { return _mm_set1_ps(v); }
+    static Type Sub(Type a, Type b) noexcept { return _mm_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) noexcept { return _mm_mul_ps(a, b); }
+    static Type Min(Type a, Type b) noexcept { return _mm_min_ps(a, b); }
+    static Type Max(Type a, Type b) noexcept { return _mm_max_ps(a, b); }
+    static uint32_t LessEqualMask(Type a, Type b) noexcept {
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(a, b)));
+    }
+    static void Store(float* p, Type v) noexcept { _mm_store_ps(p, v); }
+};
+
+#if defined(__AVX__)
+template<>
+struct WideFloat<8> {
+    using Type = __m256;
+    static Type Load(const float* p) noexcept { return _mm256_load_ps(p); }
+    static Type Set1(float v) noexcept { return _mm256_set1_ps(v); }
+    static Type Sub(Type a, Type b) noexcept { return _mm256_sub_ps(a, b); }
+    static Type Mul(Type a, Type b) noexcept { return _mm256_mul_ps(a, b); }
+    static Type Min(Type a, Type b) noexcept { return _mm256_min_ps(a, b); }
+    static Type Max(Type a, Type b) noexcept { return _mm256_max_ps(a, b); }
+    static uint32_t LessEqualMask(Type a, Type b) noexcept {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)));
+    }
+    static void Store(float* p, Type v) noexcept { _mm256_store_ps(p, v); }
+};
+#endif
+
+} // namespace detail
+
+//============================================================================
+//! @brief 多分木BVHのノード（子のAABBをSoAで保持）
+//!
+//! 空きスロットは min > max の反転AABBにしておき、判定で必ず外れるようにする。
+//============================================================================
+template<uint32_t Width>
+struct alignas(Width * sizeof(float)) WideBVHNode {
+    static constexpr uint32_t kLeafFlag = 0x80000000u;   //!< 葉スロット（下位ビットは先頭パケット）
+    static constexpr uint32_t kEmptySlot = UINT32_MAX;   //!< 空きスロット
+
+    float minX[Width], minY[Width], minZ[Width];
+    float maxX[Width], maxY[Width], maxZ[Width];
+    uint32_t child[Width];          //!< 内部: ノードインデックス, 葉: kLeafFlag | 先頭パケット
+    uint32_t packetCount[Width];    //!< 葉のパケット数（内部ノードは0）
+};
+
+//============================================================================
+//! @brief 多分木BVH（BVH4 / BVH8）
+//!
+//! 構築済みの二分木BVHを、表面積の大きい子から展開して Width 分木に畳み込む。
+//! 子のAABBは一度のSIMD判定でまとめてテストし、葉の三角形は4つずつ判定する。
+//!
+//! 一括レイキャストは呼び出し側の順序のまま kRayChunkSize 本ずつのチャンクに分け、
+//! チャンク内のレイを1本ずつたどる（複数レイをSIMDでまとめるパケット走査ではない）。
+//! 同じエージェントの視線など近いレイが続けて同じノードをたどるようにする。
+//! 十分な本数があればチャンク単位でJobSystemに分散する。
+//!
+//! 二分木を Refit した後は、同じ木構造のまま Refit で子のAABBと三角形パケットを更新できる。
+//!
+//! @code
+//! BVH4 wide;
+//! wide.Build(bvh);
+//!
+//! std::vector<BVHRayHit> hits(rays.size());
+//! wide.IntersectBatch(rays, hits);
+//! @endcode
+//============================================================================
+template<uint32_t Width>
+class WideBVH {
+    static_assert(Width == 4 || Width == 8, "WideBVH supports 4 or 8 children");
+
+public:
+    using Node = WideBVHNode<Width>;
+
+    //! @brief 一括レイキャストのチャンク1つのレイ数
+    static constexpr uint32_t kRayChunkSize = 64;
+
+    //! @brief このレイ数以上ならチャンク単位で並列化
+    static constexpr uint32_t kMinParallelRays = 256;
+
+    //! @brief ジョブ1つが処理するチャンク数
+    static constexpr uint32_t kRayChunksPerJob = 2;
+
+    //! @brief リフィットでジョブ1つが処理するノード数
+    static constexpr uint32_t kRefitNodesPerJob = 64;
+
+    //! @brief トラバーサルスタックの深さ
+    //!
+    //! 二分木の深さは kMaxSahDepth + 32（中央分割で三角形数が半減）以下で、
+    //! 多分木のノードはそれぞれ最大 Width - 1 個の兄弟をスタックに残す。
+    static constexpr uint32_t kStackSize = (BVH::kMaxSahDepth + 32) * (Width - 1) + 1;
+
+    //------------------------------------------------------------------------
+    //! @brief 二分木BVHから構築
+    //------------------------------------------------------------------------
+    void Build(const BVH& bvh) {
+        nodes_.clear();
+        packets_.clear();
+        sources_.clear();
+        if (!bvh.IsBuilt()) return;
+
+        const auto& binary = bvh.GetNodes();
+        nodes_.reserve(binary.size() / (Width / 2) + 1);
+        sources_.reserve(nodes_.capacity() * Width);
+        packets_.reserve(bvh.GetTriangleCount() / 2 + 1);
+        CollapseNode(bvh, 0);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief リフィットした二分木から子のAABBと三角形パケットを更新
+    //!
+    //! 木構造は Build 時のまま（bvh は同じ二分木を Refit したもの）。
+    //! スロットごとに元の二分木ノードを覚えているので、ノード単位で独立に更新できる。
+    //------------------------------------------------------------------------
+    void Refit(const BVH& bvh) {
+        if (nodes_.empty()) return;
+
+        auto refit = [this, &bvh](uint32_t begin, uint32_t end) {
+            const auto& binary = bvh.GetNodes();
+            for (uint32_t n = begin; n < end; ++n) {
+                Node& node = nodes_[n];
+                for (uint32_t slot = 0; slot < Width; ++slot) {
+                    if (node.child[slot] == Node::kEmptySlot) continue;
+                    const BVHNode& src = binary[sources_[n * Width + slot]];
+                    SetSlotBounds(node, slot, src);
+                    if (node.child[slot] & Node::kLeafFlag) {
+                        WritePackets(bvh, src, node.child[slot] & ~Node::kLeafFlag);
+                    }
+                }
+            }
+        };
+
+        const uint32_t nodeCount = static_cast<uint32_t>(nodes_.size());
+        if (bvh.GetTriangleCount() >= BVH::kParallelSubtreeTriangles && JobSystem::HasWorkers()) {
+            JobSystem::Get().ParallelForRange(0, nodeCount, refit, kRefitNodesPerJob).Wait();
+        } else {
+            refit(0, nodeCount);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief レイとの交差判定
+    //! @param origin レイの原点
+    //! @param dir レイの方向（正規化）
+    //! @param tMax 最大距離
+    //! @param outT [out] 交差距離
+    //! @param outTriIndex [out] 交差した三角形のインデックス
+    //! @return 交差したらtrue
+    //------------------------------------------------------------------------
+    [[nodiscard]] bool Intersect(
+        const Vector3& origin,
+        const Vector3& dir,
+        float tMax,
+        float& outT,
+        uint32_t& outTriIndex) const
+    {
+        if (nodes_.empty() || tMax <= 0.0f) return false;
+
+        RayState ray;
+        InitRayState(BVHRay{origin, dir, tMax}, ray);
+        Traverse(ray);
+        if (ray.closestTri == UINT32_MAX) return false;
+        outT = ray.closestT;
+        outTriIndex = ray.closestTri;
+        return true;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 複数のレイを一括判定
+    //!
+    //! kRayChunkSize 本ずつのチャンクをジョブに割り当て、チャンク内の各レイは個別にたどる。
+    //! @param rays レイ（ローカル空間）
+    //! @param outHits [out] レイごとの結果（rays と同じ順序・同じ要素数）
+    //------------------------------------------------------------------------
+    void IntersectBatch(std::span<const BVHRay> rays, std::span<BVHRayHit> outHits) const {
+        const uint32_t rayCount = static_cast<uint32_t>((std::min)(rays.size(), outHits.size()));
+        std::fill(outHits.begin(), outHits.begin() + rayCount, BVHRayHit{});
+        if (nodes_.empty() || rayCount == 0) return;
+
+        const uint32_t chunkCount = (rayCount + kRayChunkSize - 1) / kRayChunkSize;
+        auto process = [this, &rays, &outHits, rayCount](uint32_t begin, uint32_t end) {
+            for (uint32_t c = begin; c < end; ++c) {
+                const uint32_t first = c * kRayChunkSize;
+                IntersectRayChunk(rays.data() + first, (std::min)(kRayChunkSize, rayCount - first),
+                                  outHits.data() + first);
+            }
+        };
+
+        if (rayCount >= kMinParallelRays && JobSystem::HasWorkers()) {
+            JobSystem::Get().ParallelForRange(0, chunkCount, process, kRayChunksPerJob).Wait();
+        } else {
+            process(0, chunkCount);
+        }
+    }
+
+    //! @brief 構築済みか
+    [[nodiscard]] bool IsBuilt() const noexcept { return !nodes_.empty(); }
+
+    //! @brief ノード配列（ルートは0）
+    [[nodiscard]] const std::vector<Node>& GetNodes() const noexcept { return nodes_; }
+
+    //! @brief 三角形パケット配列（葉の順）
+    [[nodiscard]] const std::vector<TrianglePacket4>& GetPackets() const noexcept { return packets_; }
+
+private:
+    using Simd = detail::WideFloat<Width>;
+
+    //! @brief トラバーサル中のレイ（SIMD定数を事前に展開）
+    struct RayState {
+        typename Simd::Type originX, originY, originZ;
+        typename Simd::Type invDirX, invDirY, invDirZ;
+        __m128 dirX4, dirY4, dirZ4;
+        __m128 originX4, originY4, originZ4;
+        uint32_t nearX, nearY, nearZ;   //!< ノード先頭からのfloatオフセット（方向の符号で min/max を選ぶ）
+        uint32_t farX, farY, farZ;
+        float closestT;
+        uint32_t closestTri;
+    };
+
+    //------------------------------------------------------------------------
+    //! @brief 二分木の部分木を畳み込み、多分木ノードのインデックスを返す
+    //------------------------------------------------------------------------
+    uint32_t CollapseNode(const BVH& bvh, uint32_t binaryIdx) {
+        const auto& binary = bvh.GetNodes();
+
+        // 表面積が最大の内部ノードを展開して Width 個まで子を集める
+        uint32_t children[Width];
+        uint32_t childCount = 0;
+        children[childCount++] = binaryIdx;
+        while (childCount < Width) {
+            int best = -1;
+            float bestArea = -1.0f;
+            for (uint32_t i = 0; i < childCount; ++i) {
+                const BVHNode& node = binary[children[i]];
+                if (node.IsLeaf()) continue;
+                const float area = HalfArea(node);
+                if (area > bestArea) {
+                    bestArea = area;
+                    best = static_cast<int>(i);
+                }
+            }
+            if (best < 0) break;
+
+            // 左子をその場に、右子を直後に入れて深さ優先の順序を保つ
+            const uint32_t expand = children[best];
+            for (uint32_t i = childCount; i > static_cast<uint32_t>(best) + 1; --i) {
+                children[i] = children[i - 1];
+            }
+            children[best] = expand + 1;
+            children[best + 1] = binary[expand].leftFirst;
+            ++childCount;
+        }
+
+        const uint32_t nodeIdx = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        InitEmpty(nodes_[nodeIdx]);
+        sources_.resize(sources_.size() + Width, UINT32_MAX);
+
+        for (uint32_t slot = 0; slot < childCount; ++slot) {
+            const BVHNode& src = binary[children[slot]];
+            uint32_t child;
+            uint32_t packetCount = 0;
+            if (src.IsLeaf()) {
+                child = Node::kLeafFlag | static_cast<uint32_t>(packets_.size());
+                packetCount = AppendPackets(bvh, src);
+            } else {
+                child = CollapseNode(bvh, children[slot]);
+            }
+
+            // 再帰でnodes_が再確保されるため、書き込みは最後にまとめる
+            Node& node = nodes_[nodeIdx];
+            SetSlotBounds(node, slot, src);
+            node.child[slot] = child;
+            node.packetCount[slot] = packetCount;
+            sources_[nodeIdx * Width + slot] = children[slot];
+        }
+        return nodeIdx;
+    }
+
+    static void SetSlotBounds(Node& node, uint32_t slot, const BVHNode& src) noexcept {
+        node.minX[slot] = src.minX;
+        node.minY[slot] = src.minY;
+        node.minZ[slot] = src.minZ;
+        node.maxX[slot] = src.maxX;
+        node.maxY[slot] = src.maxY;
+        node.maxZ[slot] = src.maxZ;
+    }
+
+    //! @brief 葉の三角形を4つずつパケットに詰める
+    uint32_t AppendPackets(const BVH& bvh, const BVHNode& leaf) {
+        const uint32_t first = static_cast<uint32_t>(packets_.size());
+        packets_.resize(first + (leaf.triCount + 3) / 4);
+        return WritePackets(bvh, leaf, first);
+    }
+
+    //! @brief 葉の三角形を packets_[first] から書き込み、パケット数を返す
+    uint32_t WritePackets(const BVH& bvh, const BVHNode& leaf, uint32_t first) {
+        const auto& triangles = bvh.GetTriangles();
+        const auto& indices = bvh.GetTriangleIndices();
+        const uint32_t packetCount = (leaf.triCount + 3) / 4;
+        for (uint32_t p = 0; p < packetCount; ++p) {
+            TrianglePacket4& packet = packets_[first + p];
+            packet = TrianglePacket4{};
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                const uint32_t k = p * 4 + lane;
+                if (k >= leaf.triCount) {
+                    packet.index[lane] = UINT32_MAX;
+                    continue;
+                }
+                const Triangle& tri = triangles[indices[leaf.leftFirst + k]];
+                const Vector3 e1 = tri.v1 - tri.v0;
+                const Vector3 e2 = tri.v2 - tri.v0;
+                packet.v0x[lane] = tri.v0.x; packet.v0y[lane] = tri.v0.y; packet.v0z[lane] = tri.v0.z;
+                packet.e1x[lane] = e1.x;     packet.e1y[lane] = e1.y;     packet.e1z[lane] = e1.z;
+                packet.e2x[lane] = e2.x;     packet.e2y[lane] = e2.y;     packet.e2z[lane] = e2.z;
+                packet.index[lane] = tri.index;
+            }
+        }
+        return packetCount;
+    }
+
+    static void InitEmpty(Node& node) noexcept {
+        for (uint32_t i = 0; i < Width; ++i) {
+            node.minX[i] = node.minY[i] = node.minZ[i] = FLT_MAX;
+            node.maxX[i] = node.maxY[i] = node.maxZ[i] = -FLT_MAX;
+            node.child[i] = Node::kEmptySlot;
+            node.packetCount[i] = 0;
+        }
+    }
+
+    [[nodiscard]] static float HalfArea(const BVHNode& node) noexcept {
+        const float dx = node.maxX - node.minX;
+        const float dy = node.maxY - node.minY;
+        const float dz = node.maxZ - node.minZ;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief チャンク内のレイを1本ずつたどる
+    //------------------------------------------------------------------------
+    void IntersectRayChunk(const BVHRay* rays, uint32_t count, BVHRayHit* outHits) const {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (rays[i].tMax <= 0.0f) continue;
+            RayState ray;
+            InitRayState(rays[i], ray);
+            Traverse(ray);
+            if (ray.closestTri != UINT32_MAX) {
+                outHits[i] = BVHRayHit{ray.closestT, ray.closestTri};
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief レイの事前計算
+    //------------------------------------------------------------------------
+    static void InitRayState(const BVHRay& ray, RayState& state) noexcept {
+        const Vector3& o = ray.origin;
+        const Vector3& d = ray.direction;
+        // 逆方向を事前計算（BVH::Intersectと同じく0方向は大きな値で代用）
+        const float invX = std::abs(d.x) > 1e-8f ? 1.0f / d.x : 1e8f;
+        const float invY = std::abs(d.y) > 1e-8f ? 1.0f / d.y : 1e8f;
+        const float invZ = std::abs(d.z) > 1e-8f ? 1.0f / d.z : 1e8f;
+
+        state.originX = Simd::Set1(o.x);
+        state.originY = Simd::Set1(o.y);
+        state.originZ = Simd::Set1(o.z);
+        state.invDirX = Simd::Set1(invX);
+        state.invDirY = Simd::Set1(invY);
+        state.invDirZ = Simd::Set1(invZ);
+        state.dirX4 = _mm_set1_ps(d.x);
+        state.dirY4 = _mm_set1_ps(d.y);
+        state.dirZ4 = _mm_set1_ps(d.z);
+        state.originX4 = _mm_set1_ps(o.x);
+        state.originY4 = _mm_set1_ps(o.y);
+        state.originZ4 = _mm_set1_ps(o.z);
+
+        // 正方向なら min が近い面、負方向なら max が近い面
+        constexpr uint32_t kMaxOffset = Width * 3;
+        state.nearX = invX >= 0.0f ? 0 : kMaxOffset;
+        state.nearY = (invY >= 0.0f ? 0 : kMaxOffset) + Width;
+        state.nearZ = (invZ >= 0.0f ? 0 : kMaxOffset) + Width * 2;
+        state.farX = (state.nearX + kMaxOffset) % (Width * 6);
+        state.farY = (state.nearY + kMaxOffset) % (Width * 6);
+        state.farZ = (state.nearZ + kMaxOffset) % (Width * 6);
+
+        state.closestT = ray.tMax;
+        state.closestTri = UINT32_MAX;
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 子のAABBを一度に判定し、ヒットした子のビットを返す
+    //------------------------------------------------------------------------
+    [[nodiscard]] static uint32_t IntersectChildren(const Node& node, const RayState& ray,
+                                                    float* outNear) noexcept {
+        const float* base = node.minX;
+        const auto tNearX = Simd::Mul(Simd::Sub(Simd::Load(base + ray.nearX), ray.originX), ray.invDirX);
+        const auto tNearY = Simd::Mul(Simd::Sub(Simd::Load(base + ray.nearY), ray.originY), ray.invDirY);
+        const auto tNearZ = Simd::Mul(Simd::Sub(Simd::Load(base + ray.nearZ), ray.originZ), ray.invDirZ);
+        const auto tFarX = Simd::Mul(Simd::Sub(Simd::Load(base + ray.farX), ray.originX), ray.invDirX);
+        const auto tFarY = Simd::Mul(Simd::Sub(Simd::Load(base + ray.farY), ray.originY), ray.invDirY);
+        const auto tFarZ = Simd::Mul(Simd::Sub(Simd::Load(base + ray.farZ), ray.originZ), ray.invDirZ);
+
+        const auto tNear = Simd::Max(Simd::Max(tNearX, tNearY), Simd::Max(tNearZ, Simd::Set1(0.0f)));
+        const auto tFar = Simd::Min(Simd::Min(tFarX, tFarY), Simd::Min(tFarZ, Simd::Set1(ray.closestT)));
+        Simd::Store(outNear, tNear);
+        return Simd::LessEqualMask(tNear, tFar);
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 4三角形を同時に判定し、最も近いヒットでレイを更新（Möller-Trumbore法）
+    //------------------------------------------------------------------------
+    static void IntersectTriangles(const TrianglePacket4& packet, RayState& ray) noexcept {
+        const __m128 epsilon = _mm_set1_ps(1e-8f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        const __m128 e1x = _mm_load_ps(packet.e1x), e1y = _mm_load_ps(packet.e1y), e1z = _mm_load_ps(packet.e1z);
+        const __m128 e2x = _mm_load_ps(packet.e2x), e2y = _mm_load_ps(packet.e2y), e2z = _mm_load_ps(packet.e2z);
+
+        // h = dir x edge2
+        const __m128 hx = _mm_sub_ps(_mm_mul_ps(ray.dirY4, e2z), _mm_mul_ps(ray.dirZ4, e2y));
+        const __m128 hy = _mm_sub_ps(_mm_mul_ps(ray.dirZ4, e2x), _mm_mul_ps(ray.dirX4, e2z));
+        const __m128 hz = _mm_sub_ps(_mm_mul_ps(ray.dirX4, e2y), _mm_mul_ps(ray.dirY4, e2x));
+        const __m128 a = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, hx), _mm_mul_ps(e1y, hy)), _mm_mul_ps(e1z, hz));
+        __m128 valid = _mm_cmpge_ps(_mm_and_ps(a, absMask), epsilon);
+        if (_mm_movemask_ps(valid) == 0) return;
+
+        const __m128 f = _mm_div_ps(one, a);
+        const __m128 sx = _mm_sub_ps(ray.originX4, _mm_load_ps(packet.v0x));
+        const __m128 sy = _mm_sub_ps(ray.originY4, _mm_load_ps(packet.v0y));
+        const __m128 sz = _mm_sub_ps(ray.originZ4, _mm_load_ps(packet.v0z));
+        const __m128 u = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, hx), _mm_mul_ps(sy, hy)), _mm_mul_ps(sz, hz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        // q = s x edge1
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        const __m128 v = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ray.dirX4, qx), _mm_mul_ps(ray.dirY4, qy)),
+                                                  _mm_mul_ps(ray.dirZ4, qz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        const __m128 t = _mm_mul_ps(f, _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)));
+        valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpgt_ps(t, epsilon), _mm_cmplt_ps(t, _mm_set1_ps(ray.closestT))));
+
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(valid));
+        if (mask == 0) return;
+
+        alignas(16) float ts[4];
+        _mm_store_ps(ts, t);
+        while (mask != 0) {
+            const uint32_t lane = static_cast<uint32_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+            if (ts[lane] < ray.closestT) {
+                ray.closestT = ts[lane];
+                ray.closestTri = packet.index[lane];
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    //! @brief 1本のレイでたどる
+    //!
+    //! 当たった子が1つならスタックを使わずにそのまま降りる。
+    //------------------------------------------------------------------------
+    void Traverse(RayState& ray) const {
+        struct Entry {
+            uint32_t ref;
+            uint32_t packetCount;
+            float tNear;
+        };
+        Entry stack[kStackSize];
+        uint32_t stackPtr = 0;
+        Entry current{0, 0, 0.0f};
+
+        alignas(Width * sizeof(float)) float childNear[Width];
+        while (true) {
+            if (current.ref & Node::kLeafFlag) {
+                // 葉: 三角形を4つずつ判定
+                const uint32_t first = current.ref & ~Node::kLeafFlag;
+                for (uint32_t p = first; p < first + current.packetCount; ++p) {
+                    IntersectTriangles(packets_[p], ray);
+                }
+            } else {
+                const Node& node = nodes_[current.ref];
+                uint32_t hit = IntersectChildren(node, ray, childNear);
+                if (hit != 0) {
+                    uint32_t c = static_cast<uint32_t>(std::countr_zero(hit));
+                    hit &= hit - 1;
+                    if (hit == 0) {
+                        current = Entry{node.child[c], node.packetCount[c], childNear[c]};
+                        continue;
+                    }
+
+                    // 遠い子から積み、最も近い子を取り出す
+                    const uint32_t base = stackPtr;
+                    while (true) {
+                        const Entry child{node.child[c], node.packetCount[c], childNear[c]};
+                        uint32_t i = stackPtr++;
+                        while (i > base && stack[i - 1].tNear < child.tNear) {
+                            stack[i] = stack[i - 1];
+                            --i;
+                        }
+                        stack[i] = child;
+                        if (hit == 0) break;
+                        c = static_cast<uint32_t>(std::countr_zero(hit));
+                        hit &= hit - 1;
+                    }
+                }
+            }
+
+            // すでに見つかったヒットより遠い要素は捨てる
+            do {
+                if (stackPtr == 0) return;
+                current = stack[--stackPtr];
+            } while (current.tNear > ray.closestT);
+        }
+    }
+
+    std::vector<Node> nodes_;                   //!< ノード（ルートは0）
+    std::vector<TrianglePacket4> packets_;      //!< 三角形パケット（葉ごとに連続）
+    std::vector<uint32_t> sources_;             //!< スロットごとの元の二分木ノード（ノード x Width）
+};
+
+//! @brief 4分木BVH（SSE）
+using BVH4 = WideBVH<4>;
+
+#if defined(__AVX__)
+//! @brief 8分木BVH（AVX）
+using BVH8 = WideBVH<8>;
+
+//! @brief メッシュコライダーのレイキャストに使う多分木
+using RaycastBVH = BVH8;
+#else
+using RaycastBVH = BVH4;
+#endif
+
+} // namespace Physics
@@ -0,0 +1,429 @@
+//----------------------------------------------------------------------------
+//! @file   animation_lod_test.cpp
+//! @brief  アニメーションLOD（更新頻度の間引き・ボーンマスク・画面外停止）のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/world.h"
+#include "engine/game_object/game_object_impl.h"
+#include "engine/game_object/components/animator.h"
+#include "engine/ecs/systems/animation/animation_system.h"
+#include "engine/ecs/components/animation/animation_components.h"
+#include "engine/game_object/components/animation/animation_lod.h"
+#include "engine/game_object/components/animation/bone_mask.h"
+#include "engine/game_object/components/animation/skeleton.h"
+#include "engine/game_object/components/animation/animation_clip.h"
+#include "engine/game_object/components/animation/compressed_clip.h"
+#include "engine/core/job_system.h"
+#include "animation_test_helpers.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using TestHelpers::ExpectMatrixNear;
+using TestHelpers::MakeClip;
+using TestHelpers::MakeSkeleton;
+
+constexpr float kDt = 1.0f / 60.0f;
+
+//! @brief 参照実装（maskを渡すとマスク外のボーンはバインドポーズ）
+std::vector<Matrix> ReferenceSkinning(const Skeleton& skeleton, const AnimationClip& clip, float time,
+                                      const BoneMask* mask = nullptr)
+{
+    PoseBuffer buffer(static_cast<uint32_t>(skeleton.GetBoneCount()));
+    Pose pose = buffer.GetPose();
+    clip.SamplePose(time, pose, mask);
+    std::vector<Matrix> globals;
+    std::vector<Matrix> skinning;
+    skeleton.ComputeGlobalTransforms(pose, globals, mask);
+    skeleton.ComputeSkinningMatrices(globals, skinning);
+    return skinning;
+}
+
+std::vector<Matrix> CopySkinning(ECS::World& world, ECS::Actor actor)
+{
+    auto matrices = world.GetBuffer<ECS::SkinningMatrix>(actor);
+    std::vector<Matrix> result;
+    for (int i = 0; i < matrices.Length(); ++i) {
+        result.push_back(matrices[i].value);
+    }
+    return result;
+}
+
+bool SameMatrices(const std::vector<Matrix>& a, const std::vector<Matrix>& b)
+{
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), sizeof(Matrix) * a.size()) == 0;
+}
+
+//! @brief 原点にアクティブカメラを置いたワールド
+class AnimationSystemLODTest : public ::testing::Test {
+protected:
+    static constexpr int kBones = 12;
+
+    void SetUp() override
+    {
+        world_.RegisterSystem<ECS::AnimationSystem>();
+        animation_ = world_.GetSystem<ECS::AnimationSystem>();
+        skeleton_ = MakeSkeleton(kBones);
+        clip_ = MakeClip(kBones, 0.0f);
+        skeletonId_ = animation_->RegisterSkeleton(skeleton_);
+        clipId_ = animation_->RegisterClip(clip_);
+
+        camera_ = world_.CreateActor();
+        world_.AddComponent<ECS::Camera3DData>(camera_, 60.0f, 16.0f / 9.0f);
+        world_.AddComponent<ECS::ActiveCameraTag>(camera_);
+    }
+
+    ECS::Actor CreateCharacter(float distance, uint8_t phase = 0)
+    {
+        auto actor = world_.CreateActor();
+        world_.AddComponent<ECS::SkeletalAnimationData>(actor, clipId_);
+        world_.AddComponent<ECS::SkeletonRefData>(actor, skeletonId_);
+        world_.AddComponent<ECS::LocalToWorld>(actor, Matrix::CreateTranslation(0.0f, 0.0f, distance));
+        world_.AddComponent<ECS::AnimationLODData>(actor)->phase = phase;
+        world_.AddBuffer<ECS::SkinningMatrix>(actor);
+        return actor;
+    }
+
+    float TimeOf(ECS::Actor actor)
+    {
+        return world_.GetComponent<ECS::SkeletalAnimationData>(actor)->time;
+    }
+
+    void MoveCamera(float z)
+    {
+        world_.GetComponent<ECS::Camera3DData>(camera_)->position = Vector3(0.0f, 0.0f, z);
+    }
+
+    ECS::World world_;
+    ECS::AnimationSystem* animation_ = nullptr;
+    SkeletonPtr skeleton_;
+    AnimationClipPtr clip_;
+    uint32_t skeletonId_ = 0;
+    uint32_t clipId_ = 0;
+    ECS::Actor camera_;
+};
+
+class AnimatorLODTest : public ::testing::Test {
+protected:
+    static constexpr int kBones = 12;
+
+    void SetUp() override
+    {
+        skeleton_ = MakeSkeleton(kBones);
+        clip_ = MakeClip(kBones, 0.0f);
+        controller_ = std::make_shared<AnimatorController>();
+        controller_->AddLayer("Base Layer").AddState("Walk", clip_);
+    }
+
+    SkeletonPtr skeleton_;
+    AnimationClipPtr clip_;
+    AnimatorControllerPtr controller_;
+};
+
+} // namespace
+
+//============================================================================
+// LOD状態
+//============================================================================
+
+TEST(AnimationLODStateTest, IntervalFollowsDistanceAndPhaseStaggers)
+{
+    AnimationLODSettings settings;
+    EXPECT_EQ(settings.SelectLevel(5.0f), AnimationLODLevel::Full);
+    EXPECT_EQ(settings.SelectLevel(30.0f), AnimationLODLevel::Half);
+    EXPECT_EQ(settings.SelectLevel(80.0f), AnimationLODLevel::Quarter);
+
+    // Quarterの4インスタンスを位相0〜3でずらすと、毎フレームちょうど1体が評価される
+    AnimationLODState states[4];
+    for (uint32_t frame = 0; frame < 16; ++frame) {
+        int evaluated = 0;
+        for (uint32_t phase = 0; phase < 4; ++phase) {
+            evaluated += states[phase].Advance(settings, 80.0f, true, frame, phase, kDt) ? 1 : 0;
+        }
+        EXPECT_EQ(evaluated, 1) << "frame " << frame;
+    }
+    EXPECT_TRUE(states[0].UsesBoneMask());
+
+    // Fullは毎フレーム
+    AnimationLODState full;
+    for (uint32_t frame = 0; frame < 8; ++frame) {
+        EXPECT_TRUE(full.Advance(settings, 5.0f, true, frame, 3, kDt));
+    }
+}
+
+TEST(AnimationLODStateTest, FreezesOffscreenAndBlendsOnResume)
+{
+    AnimationLODSettings settings;
+    settings.resumeBlendTime = 4.0f * kDt;
+    AnimationLODState state;
+
+    EXPECT_FALSE(state.Advance(settings, 80.0f, false, 0, 0, kDt));
+    EXPECT_TRUE(state.frozen);
+
+    // 復帰直後から補間が終わるまでは、間引きレベルに関わらず毎フレーム評価する
+    EXPECT_TRUE(state.Advance(settings, 80.0f, true, 1, 0, kDt));
+    EXPECT_FALSE(state.frozen);
+    EXPECT_NEAR(state.resumeWeight, 0.75f, 1e-5f);
+    EXPECT_TRUE(state.Advance(settings, 80.0f, true, 2, 0, kDt));
+    EXPECT_TRUE(state.Advance(settings, 80.0f, true, 3, 0, kDt));
+    EXPECT_EQ(state.resumeWeight, 0.25f);
+
+    // 補間が終われば間引きに戻る
+    EXPECT_TRUE(state.Advance(settings, 80.0f, true, 4, 0, kDt));
+    EXPECT_EQ(state.resumeWeight, 0.0f);
+    EXPECT_FALSE(state.Advance(settings, 80.0f, true, 5, 0, kDt));
+}
+
+TEST(BoneMaskTest, DepthMaskKeepsUpperHierarchy)
+{
+    auto skeleton = MakeSkeleton(12);
+    const BoneMask mask = skeleton->CreateDepthMask(2);
+    ASSERT_EQ(mask.GetBoneCount(), 12u);
+    EXPECT_TRUE(mask.Test(0));
+    EXPECT_TRUE(mask.Test(2));
+    EXPECT_TRUE(mask.Test(3));     // 親は0
+    EXPECT_FALSE(mask.Test(5));    // 0 → 3 → 4 → 5
+    EXPECT_TRUE(mask.Test(100));   // 範囲外は有効扱い
+    EXPECT_TRUE(IsBoneEnabled(nullptr, 5));
+    EXPECT_LT(mask.CountEnabled(), 12u);
+}
+
+//============================================================================
+// ECS AnimationSystem
+//============================================================================
+
+TEST_F(AnimationSystemLODTest, DistantCharactersEvaluateEveryOtherFrame)
+{
+    const auto nearActor = CreateCharacter(5.0f);
+    const auto farActor = CreateCharacter(30.0f);
+
+    world_.FixedUpdate(kDt);
+    int nearUpdates = 0;
+    int farUpdates = 0;
+    for (int frame = 0; frame < 8; ++frame) {
+        const auto nearBefore = CopySkinning(world_, nearActor);
+        const auto farBefore = CopySkinning(world_, farActor);
+        world_.FixedUpdate(kDt);
+        nearUpdates += SameMatrices(nearBefore, CopySkinning(world_, nearActor)) ? 0 : 1;
+        farUpdates += SameMatrices(farBefore, CopySkinning(world_, farActor)) ? 0 : 1;
+    }
+    EXPECT_EQ(nearUpdates, 8);
+    EXPECT_EQ(farUpdates, 4);
+    EXPECT_EQ(world_.GetComponent<ECS::AnimationLODData>(farActor)->GetLevel(), AnimationLODLevel::Half);
+
+    // 間引いても再生時間は毎フレーム進む
+    EXPECT_NEAR(TimeOf(farActor), 9.0f * kDt, 1e-5f);
+    EXPECT_NEAR(TimeOf(nearActor), 9.0f * kDt, 1e-5f);
+
+    // 評価したフレームの結果はその時刻のポーズ
+    for (int frame = 0; frame < 2; ++frame) {
+        const auto before = CopySkinning(world_, farActor);
+        world_.FixedUpdate(kDt);
+        const auto after = CopySkinning(world_, farActor);
+        if (SameMatrices(before, after)) continue;
+        const auto expected = ReferenceSkinning(*skeleton_, *clip_, TimeOf(farActor));
+        for (int b = 0; b < kBones; ++b) {
+            ExpectMatrixNear(after[b], expected[b]);
+        }
+    }
+}
+
+TEST_F(AnimationSystemLODTest, FarthestLevelAppliesSkeletonBoneMask)
+{
+    animation_->SetLODBoneMask(skeletonId_, skeleton_->CreateDepthMask(2));
+    ASSERT_NE(animation_->GetLODBoneMask(skeletonId_), nullptr);
+    const auto actor = CreateCharacter(100.0f);
+
+    for (int i = 0; i < 8; ++i) {
+        world_.FixedUpdate(kDt);
+    }
+    ASSERT_EQ(world_.GetComponent<ECS::AnimationLODData>(actor)->GetLevel(), AnimationLODLevel::Quarter);
+
+    // 最後に評価したのは8フレーム目（位相0・4フレーム間隔）
+    const auto skinning = CopySkinning(world_, actor);
+    const auto masked = ReferenceSkinning(*skeleton_, *clip_, TimeOf(actor),
+                                          animation_->GetLODBoneMask(skeletonId_));
+    const auto unmasked = ReferenceSkinning(*skeleton_, *clip_, TimeOf(actor));
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(skinning[b], masked[b]);
+    }
+    EXPECT_FALSE(SameMatrices(masked, unmasked));
+}
+
+TEST_F(AnimationSystemLODTest, OutOfRangeFreezesAndResumesWithBlend)
+{
+    const auto actor = CreateCharacter(10.0f);
+    world_.AddComponent<ECS::LODRangeData>(actor, 0.0f, 40.0f);
+    auto* lod = world_.GetComponent<ECS::AnimationLODData>(actor);
+    lod->settings.resumeBlendTime = 4.0f * kDt;
+
+    for (int i = 0; i < 3; ++i) {
+        world_.FixedUpdate(kDt);
+    }
+
+    // 範囲外：行列は保持したまま時間だけ進む
+    MoveCamera(-100.0f);
+    const auto held = CopySkinning(world_, actor);
+    for (int i = 0; i < 5; ++i) {
+        world_.FixedUpdate(kDt);
+    }
+    EXPECT_TRUE(world_.GetComponent<ECS::AnimationLODData>(actor)->IsFrozen());
+    EXPECT_TRUE(SameMatrices(held, CopySkinning(world_, actor)));
+    EXPECT_NEAR(TimeOf(actor), 8.0f * kDt, 1e-5f);
+
+    // 復帰：停止していた行列から新しいポーズへ補間する
+    MoveCamera(0.0f);
+    world_.FixedUpdate(kDt);
+    EXPECT_FALSE(world_.GetComponent<ECS::AnimationLODData>(actor)->IsFrozen());
+    const float weight = world_.GetComponent<ECS::AnimationLODData>(actor)->state.resumeWeight;
+    EXPECT_NEAR(weight, 0.75f, 1e-5f);
+    const auto fresh = ReferenceSkinning(*skeleton_, *clip_, TimeOf(actor));
+    const auto blended = CopySkinning(world_, actor);
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(blended[b], Matrix::Lerp(fresh[b], held[b], weight));
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        world_.FixedUpdate(kDt);
+    }
+    const auto settled = CopySkinning(world_, actor);
+    const auto expected = ReferenceSkinning(*skeleton_, *clip_, TimeOf(actor));
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(settled[b], expected[b]);
+    }
+}
+
+TEST_F(AnimationSystemLODTest, WithoutCameraEveryFrameIsEvaluated)
+{
+    world_.DestroyActor(camera_);
+    const auto actor = CreateCharacter(100.0f);
+
+    world_.FixedUpdate(kDt);
+    for (int frame = 0; frame < 4; ++frame) {
+        const auto before = CopySkinning(world_, actor);
+        world_.FixedUpdate(kDt);
+        EXPECT_FALSE(SameMatrices(before, CopySkinning(world_, actor))) << "frame " << frame;
+    }
+}
+
+//============================================================================
+// Animator
+//============================================================================
+
+TEST_F(AnimatorLODTest, ThrottlesByViewerDistance)
+{
+    Animator animator(controller_, skeleton_);
+    animator.SetController(controller_);
+    animator.SetSkeleton(skeleton_);
+    animator.SetLODEnabled(true);
+    animator.SetLODPhase(0);
+    animator.SetLODViewer(Vector3(0.0f, 0.0f, 30.0f));
+    animator.Play("Walk");
+
+    int updates = 0;
+    for (int frame = 0; frame < 8; ++frame) {
+        const std::vector<Matrix> before = animator.GetSkinningMatrices();
+        animator.Update(kDt);
+        updates += SameMatrices(before, animator.GetSkinningMatrices()) ? 0 : 1;
+    }
+    EXPECT_EQ(animator.GetLODLevel(), AnimationLODLevel::Half);
+    EXPECT_EQ(updates, 4);
+
+    // LOD無効なら毎フレーム
+    animator.SetLODEnabled(false);
+    const std::vector<Matrix> before = animator.GetSkinningMatrices();
+    animator.Update(kDt);
+    EXPECT_FALSE(SameMatrices(before, animator.GetSkinningMatrices()));
+}
+
+TEST_F(AnimatorLODTest, OffscreenHoldsPoseAndResumeBlends)
+{
+    Animator animator(controller_, skeleton_);
+    animator.SetController(controller_);
+    animator.SetSkeleton(skeleton_);
+    animator.SetLODEnabled(true);
+    animator.SetLODViewer(Vector3::Zero);
+    animator.Play("Walk");
+    animator.Update(kDt);
+
+    animator.SetLODViewer(Vector3::Zero, false);
+    const std::vector<Matrix> held = animator.GetSkinningMatrices();
+    for (int i = 0; i < 6; ++i) {
+        animator.Update(kDt);
+    }
+    EXPECT_TRUE(animator.IsLODFrozen());
+    EXPECT_TRUE(SameMatrices(held, animator.GetSkinningMatrices()));
+
+    animator.SetLODViewer(Vector3::Zero, true);
+    animator.Update(kDt);
+    EXPECT_FALSE(animator.IsLODFrozen());
+    EXPECT_FALSE(SameMatrices(held, animator.GetSkinningMatrices()));
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+TEST(AnimationLODBenchmark, DISABLED_TwoThousandCharactersSpreadOverDistance)
+{
+    constexpr int kBones = 60;
+    constexpr int kCharacters = 2000;
+    constexpr int kMeasuredFrames = 30;
+
+    JobSystem::Create();
+    for (const bool useLOD : {false, true}) {
+        ECS::World world;
+        world.RegisterSystem<ECS::AnimationSystem>();
+        auto* animation = world.GetSystem<ECS::AnimationSystem>();
+        auto skeleton = MakeSkeleton(kBones);
+        const uint32_t skeletonId = animation->RegisterSkeleton(skeleton);
+        animation->SetLODBoneMask(skeletonId, skeleton->CreateDepthMask(4));
+        auto clip = MakeClip(kBones, 0.0f);
+        clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+        clip->ReleaseSourceKeys();
+        const uint32_t clipId = animation->RegisterClip(clip);
+
+        auto camera = world.CreateActor();
+        world.AddComponent<ECS::Camera3DData>(camera, 60.0f, 16.0f / 9.0f);
+        world.AddComponent<ECS::ActiveCameraTag>(camera);
+
+        // 0〜100mに均等に配置（Full 20% / Half 30% / Quarter 50%）
+        for (int i = 0; i < kCharacters; ++i) {
+            auto actor = world.CreateActor();
+            world.AddComponent<ECS::SkeletalAnimationData>(actor, clipId);
+            world.AddComponent<ECS::SkeletonRefData>(actor, skeletonId);
+            world.AddComponent<ECS::LocalToWorld>(actor, Matrix::CreateTranslation(
+                0.0f, 0.0f, 100.0f * static_cast<float>(i) / kCharacters));
+            if (useLOD) {
+                world.AddComponent<ECS::AnimationLODData>(actor);
+            }
+            world.AddBuffer<ECS::SkinningMatrix>(actor);
+            world.AddBuffer<ECS::AnimationCursorKey>(actor);
+        }
+
+        // 初回はバッファ確保を含むので除外
+        world.FixedUpdate(kDt);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < kMeasuredFrames; ++i) {
+            world.FixedUpdate(kDt);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double msPerFrame =
+            std::chrono::duration<double, std::milli>(end - start).count() / kMeasuredFrames;
+
+        std::printf("[ BENCH    ] %d characters x %d bones, LOD %s: %.3f ms/frame\n",
+                    kCharacters, kBones, useLOD ? "on " : "off", msPerFrame);
+        RecordProperty(useLOD ? "lod_on_ms_per_frame_x1000" : "lod_off_ms_per_frame_x1000",
+                       static_cast<int>(msPerFrame * 1000.0));
+    }
+    JobSystem::Destroy();
+}
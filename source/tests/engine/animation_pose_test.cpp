@@ -0,0 +1,298 @@
+//----------------------------------------------------------------------------
+//! @file   animation_pose_test.cpp
+//! @brief  Pose（SoA TRS）/ ポーズブレンド / Animator合成 のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/world.h"
+#include "engine/game_object/game_object_impl.h"
+#include "engine/game_object/components/animator.h"
+#include "engine/game_object/components/animation/pose.h"
+#include "engine/game_object/components/animation/skeleton.h"
+#include "engine/game_object/components/animation/animation_clip.h"
+#include "engine/memory/memory_system.h"
+#include "animation_test_helpers.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using TestHelpers::ExpectMatrixNear;
+using TestHelpers::MakeClip;
+
+//! @brief 鎖状のスケルトン（各ボーンは1つ前の子）
+SkeletonPtr MakeChainSkeleton(int boneCount)
+{
+    auto skeleton = std::make_shared<Skeleton>();
+    for (int i = 0; i < boneCount; ++i) {
+        skeleton->AddBone(Bone("Bone" + std::to_string(i), i - 1,
+                               Matrix::CreateTranslation(0.0f, 0.1f, 0.0f)));
+    }
+    skeleton->ComputeInverseBindMatrices();
+    return skeleton;
+}
+
+//! @brief 参照実装：行列へサンプリングしてから分解してブレンド（回転はnlerp）
+Matrix BlendMatrixReference(const Matrix& a, const Matrix& b, float t)
+{
+    Vector3 sa, sb, ta, tb;
+    Quaternion ra, rb;
+    Matrix(a).Decompose(sa, ra, ta);
+    Matrix(b).Decompose(sb, rb, tb);
+    return Matrix::CreateScale(Vector3::Lerp(sa, sb, t)) *
+           Matrix::CreateFromQuaternion(Quaternion::Lerp(ra, rb, t)) *
+           Matrix::CreateTranslation(Vector3::Lerp(ta, tb, t));
+}
+
+//============================================================================
+// Pose
+//============================================================================
+
+TEST(PoseTest, StreamsArePaddedToLaneWidthAndIdentityFilled)
+{
+    PoseBuffer buffer(5);
+    const Pose pose = buffer.GetPose();
+
+    EXPECT_EQ(pose.GetBoneCount(), 5u);
+    EXPECT_EQ(pose.GetPaddedCount(), 8u);
+    for (uint32_t i = 0; i < pose.GetPaddedCount(); ++i) {
+        EXPECT_EQ(pose.GetStream(Pose::kTranslationX)[i], 0.0f);
+        EXPECT_EQ(pose.GetStream(Pose::kRotationW)[i], 1.0f);
+        EXPECT_EQ(pose.GetStream(Pose::kScaleY)[i], 1.0f);
+    }
+}
+
+TEST(PoseTest, ToMatrixMatchesScaleRotationTranslation)
+{
+    PoseBuffer buffer(1);
+    Pose pose = buffer.GetPose();
+    const Vector3 t(1.0f, -2.0f, 3.0f);
+    const Quaternion r = Quaternion::CreateFromAxisAngle(Vector3(1.0f, 2.0f, 0.5f), 0.7f);
+    const Vector3 s(2.0f, 0.5f, 1.5f);
+    pose.SetBone(0, t, r, s);
+
+    ExpectMatrixNear(pose.ToMatrix(0),
+        Matrix::CreateScale(s) * Matrix::CreateFromQuaternion(r) * Matrix::CreateTranslation(t));
+}
+
+TEST(PoseTest, BlendMatchesScalarLerpAndNlerpWithHemisphereFix)
+{
+    // 4の倍数でないボーン数で端数レーンも確認
+    constexpr uint32_t kBones = 7;
+    PoseBuffer a(kBones);
+    PoseBuffer b(kBones);
+    PoseBuffer out(kBones);
+    for (uint32_t i = 0; i < kBones; ++i) {
+        const Quaternion ra = Quaternion::CreateFromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), 0.2f * i);
+        Quaternion rb = Quaternion::CreateFromAxisAngle(Vector3(1.0f, 0.0f, 0.0f), 0.3f * i + 0.1f);
+        if (i % 2 == 1) {
+            rb = -rb;   // 反対側の半球（同じ回転）
+        }
+        a.GetPose().SetBone(i, Vector3(float(i), 0.0f, 0.0f), ra, Vector3(1.0f, 1.0f, 1.0f));
+        b.GetPose().SetBone(i, Vector3(0.0f, float(i), 0.0f), rb, Vector3(2.0f, 3.0f, 4.0f));
+    }
+
+    const float t = 0.3f;
+    Pose result = out.GetPose();
+    Pose::Blend(a.GetPose(), b.GetPose(), t, result);
+
+    for (uint32_t i = 0; i < kBones; ++i) {
+        const Vector3 expectedT = Vector3::Lerp(a.GetPose().GetTranslation(i), b.GetPose().GetTranslation(i), t);
+        const Vector3 gotT = result.GetTranslation(i);
+        EXPECT_NEAR(gotT.x, expectedT.x, 1e-5f);
+        EXPECT_NEAR(gotT.y, expectedT.y, 1e-5f);
+        EXPECT_NEAR(result.GetScale(i).z, 1.0f + 3.0f * t, 1e-5f);
+
+        const Quaternion expectedR = Quaternion::Lerp(a.GetPose().GetRotation(i), b.GetPose().GetRotation(i), t);
+        const Quaternion gotR = result.GetRotation(i);
+        EXPECT_NEAR(gotR.x, expectedR.x, 1e-5f);
+        EXPECT_NEAR(gotR.y, expectedR.y, 1e-5f);
+        EXPECT_NEAR(gotR.z, expectedR.z, 1e-5f);
+        EXPECT_NEAR(gotR.w, expectedR.w, 1e-5f);
+    }
+
+    // パディングレーンは恒等のまま
+    EXPECT_NEAR(result.GetStream(Pose::kRotationW)[kBones], 1.0f, 1e-6f);
+}
+
+TEST(PoseTest, ThreadScratchIsReleasedByMarker)
+{
+    auto& scratch = Memory::GetThreadScratchAllocator();
+    const auto before = scratch.GetUsed();
+    {
+        Memory::ScopedStackMarker marker(scratch);
+        Pose pose = Pose::FromAllocator(scratch, 80);
+        ASSERT_TRUE(pose.IsValid());
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(pose.GetStream(Pose::kTranslationX)) % 16, 0u);
+        EXPECT_GE(scratch.GetUsed(), before + Pose::GetRequiredFloats(80) * sizeof(float));
+    }
+    EXPECT_EQ(scratch.GetUsed(), before);
+}
+
+//============================================================================
+// サンプリング / 行列化
+//============================================================================
+
+TEST(PoseSamplingTest, ClipSampledToPoseMatchesMatrixSampling)
+{
+    constexpr int kBones = 6;
+    auto clip = MakeClip(kBones, 0.25f, WrapMode::Loop, true);
+
+    std::vector<Matrix> matrices(kBones, Matrix::Identity);
+    clip->SamplePose(0.37f, matrices);
+
+    PoseBuffer buffer(kBones);
+    Pose pose = buffer.GetPose();
+    clip->SamplePose(0.37f, pose);
+
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(pose.ToMatrix(b), matrices[b]);
+    }
+}
+
+TEST(PoseSamplingTest, GlobalTransformsFromPoseMatchMatrixPath)
+{
+    constexpr int kBones = 9;
+    auto skeleton = MakeChainSkeleton(kBones);
+    auto clip = MakeClip(kBones, 0.1f, WrapMode::Loop, true);
+
+    std::vector<Matrix> localMatrices(kBones, Matrix::Identity);
+    clip->SamplePose(0.8f, localMatrices);
+    std::vector<Matrix> expected;
+    skeleton->ComputeGlobalTransforms(localMatrices, expected);
+
+    PoseBuffer buffer(kBones);
+    Pose pose = buffer.GetPose();
+    clip->SamplePose(0.8f, pose);
+    std::vector<Matrix> global;
+    skeleton->ComputeGlobalTransforms(pose, global);
+
+    ASSERT_EQ(global.size(), expected.size());
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(global[b], expected[b], 1e-3f);
+    }
+}
+
+//============================================================================
+// Animator
+//============================================================================
+
+class AnimatorPoseTest : public ::testing::Test {
+protected:
+    static constexpr int kBones = 12;
+
+    void SetUp() override
+    {
+        skeleton_ = MakeChainSkeleton(kBones);
+        walk_ = MakeClip(kBones, 0.0f, WrapMode::Loop, true);
+        run_ = MakeClip(kBones, 0.5f, WrapMode::Loop, true);
+
+        controller_ = std::make_shared<AnimatorController>();
+        auto& layer = controller_->AddLayer("Base Layer");
+        layer.AddState("Walk", walk_);
+        layer.AddState("Run", run_);
+    }
+
+    SkeletonPtr skeleton_;
+    AnimationClipPtr walk_;
+    AnimationClipPtr run_;
+    AnimatorControllerPtr controller_;
+};
+
+TEST_F(AnimatorPoseTest, CrossFadeMatchesMatrixBlendReference)
+{
+    Animator animator(controller_, skeleton_);
+    animator.SetController(controller_);
+    animator.SetSkeleton(skeleton_);
+
+    animator.Play("Walk");
+    animator.Update(0.1f);
+    animator.CrossFade("Run", 0.5f);
+    animator.Update(0.2f);
+
+    // 参照：行列にサンプリングして TRS分解 + nlerp
+    std::vector<Matrix> walkPose(kBones, Matrix::Identity);
+    std::vector<Matrix> runPose(kBones, Matrix::Identity);
+    walk_->SamplePose(0.3f, walkPose);
+    run_->SamplePose(0.2f, runPose);
+    const float weight = 0.2f / 0.5f;
+
+    std::vector<Matrix> local(kBones);
+    for (int b = 0; b < kBones; ++b) {
+        local[b] = BlendMatrixReference(walkPose[b], runPose[b], weight);
+        ExpectMatrixNear(animator.GetBoneLocalTransform(b), local[b], 2e-3f);
+    }
+
+    std::vector<Matrix> global;
+    std::vector<Matrix> skinning;
+    skeleton_->ComputeGlobalTransforms(local, global);
+    skeleton_->ComputeSkinningMatrices(global, skinning);
+    ASSERT_EQ(animator.GetSkinningMatrices().size(), skinning.size());
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(animator.GetSkinningMatrices()[b], skinning[b], 1e-2f);
+    }
+}
+
+TEST_F(AnimatorPoseTest, SetBoneLocalTransformRoundTrips)
+{
+    Animator animator(controller_, skeleton_);
+    animator.SetSkeleton(skeleton_);
+
+    const Matrix transform = Matrix::CreateScale(1.5f) *
+        Matrix::CreateFromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), 0.4f) *
+        Matrix::CreateTranslation(1.0f, 2.0f, 3.0f);
+    animator.SetBoneLocalTransform(3, transform);
+
+    ExpectMatrixNear(animator.GetBoneLocalTransform(3), transform);
+    ExpectMatrixNear(animator.GetBoneLocalTransform(4), Matrix::Identity);
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+
+TEST_F(AnimatorPoseTest, DISABLED_Benchmark_CrossFadingCrowd)
+{
+    constexpr int kCharacters = 300;
+    constexpr int kCrowdBones = 80;
+    constexpr int kFrames = 20;
+
+    auto skeleton = MakeChainSkeleton(kCrowdBones);
+    auto walk = MakeClip(kCrowdBones, 0.0f, WrapMode::Loop, true);
+    auto run = MakeClip(kCrowdBones, 0.5f, WrapMode::Loop, true);
+    auto controller = std::make_shared<AnimatorController>();
+    auto& layer = controller->AddLayer("Base Layer");
+    layer.AddState("Walk", walk);
+    layer.AddState("Run", run);
+
+    std::vector<std::unique_ptr<Animator>> crowd;
+    for (int i = 0; i < kCharacters; ++i) {
+        auto animator = std::make_unique<Animator>(controller, skeleton);
+        animator->SetController(controller);
+        animator->SetSkeleton(skeleton);
+        animator->Play("Walk", 0, (i % 10) * 0.1f);
+        animator->CrossFade("Run", 10.0f);   // 計測中はずっとクロスフェード
+        crowd.push_back(std::move(animator));
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        for (auto& animator : crowd) {
+            animator->Update(1.0f / 60.0f);
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double msPerFrame =
+        std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+
+    std::printf("[ BENCH    ] %d animators x %d bones (cross-fading): %.3f ms/frame\n",
+                kCharacters, kCrowdBones, msPerFrame);
+    RecordProperty("animators", kCharacters);
+    RecordProperty("ms_per_frame_x1000", static_cast<int>(msPerFrame * 1000.0));
+}
+
+} // namespace
@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------
+//! @file   animation_system_test.cpp
+//! @brief  ECS AnimationSystem（スケルタルアニメーション並列評価）のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/world.h"
+#include "engine/ecs/systems/animation/animation_system.h"
+#include "engine/ecs/components/animation/animation_components.h"
+#include "engine/game_object/components/animation/skeleton.h"
+#include "engine/game_object/components/animation/animation_clip.h"
+#include "engine/game_object/components/animation/compressed_clip.h"
+#include "engine/core/job_system.h"
+#include "animation_test_helpers.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using TestHelpers::ExpectMatrixNear;
+using TestHelpers::MakeClip;
+using TestHelpers::MakeSkeleton;
+
+constexpr float kDt = 1.0f / 60.0f;
+
+//! @brief 参照実装：OOP側と同じ経路（Pose → グローバル → スキニング）
+std::vector<Matrix> ReferenceSkinning(const Skeleton& skeleton, const AnimationClip& clip, float time)
+{
+    PoseBuffer buffer(static_cast<uint32_t>(skeleton.GetBoneCount()));
+    Pose pose = buffer.GetPose();
+    clip.SamplePose(time, pose);
+    std::vector<Matrix> globals;
+    std::vector<Matrix> skinning;
+    skeleton.ComputeGlobalTransforms(pose, globals);
+    skeleton.ComputeSkinningMatrices(globals, skinning);
+    return skinning;
+}
+
+ECS::Actor CreateCharacter(ECS::World& world, uint32_t skeletonId, uint32_t clipId, bool withCursor = true)
+{
+    auto actor = world.CreateActor();
+    world.AddComponent<ECS::SkeletalAnimationData>(actor, clipId);
+    world.AddComponent<ECS::SkeletonRefData>(actor, skeletonId);
+    world.AddBuffer<ECS::SkinningMatrix>(actor);
+    if (withCursor) {
+        world.AddBuffer<ECS::AnimationCursorKey>(actor);
+    }
+    return actor;
+}
+
+} // namespace
+
+//============================================================================
+// 評価結果
+//============================================================================
+
+TEST(AnimationSystemTest, SkinningMatchesSkeletonPath)
+{
+    constexpr int kBones = 12;
+    ECS::World world;
+    world.RegisterSystem<ECS::AnimationSystem>();
+    auto* animation = world.GetSystem<ECS::AnimationSystem>();
+    auto skeleton = MakeSkeleton(kBones);
+    auto clip = MakeClip(kBones, 0.0f);
+    const auto actor = CreateCharacter(world, animation->RegisterSkeleton(skeleton),
+                                       animation->RegisterClip(clip), false);
+
+    for (int i = 0; i < 10; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    const float time = world.GetComponent<ECS::SkeletalAnimationData>(actor)->time;
+    EXPECT_NEAR(time, 10.0f * kDt, 1e-5f);
+
+    auto matrices = world.GetBuffer<ECS::SkinningMatrix>(actor);
+    ASSERT_EQ(matrices.Length(), kBones);
+    const std::vector<Matrix> expected = ReferenceSkinning(*skeleton, *clip, time);
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(matrices[b].value, expected[b]);
+    }
+}
+
+TEST(AnimationSystemTest, CompressedClipKeepsCursorInBuffer)
+{
+    constexpr int kBones = 9;
+    ECS::World world;
+    world.RegisterSystem<ECS::AnimationSystem>();
+    auto* animation = world.GetSystem<ECS::AnimationSystem>();
+    auto skeleton = MakeSkeleton(kBones);
+    auto clip = MakeClip(kBones, 0.25f);
+    clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+    clip->ReleaseSourceKeys();
+    auto other = MakeClip(kBones, 0.5f);
+
+    const uint32_t clipId = animation->RegisterClip(clip);
+    const uint32_t otherId = animation->RegisterClip(other);
+    const auto withCursor = CreateCharacter(world, animation->RegisterSkeleton(skeleton), clipId);
+    const auto withoutCursor = CreateCharacter(world, 0, clipId, false);
+
+    for (int i = 0; i < 45; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    const uint32_t trackCount = clip->compressed->GetAnimatedTrackCount();
+    EXPECT_EQ(world.GetBuffer<ECS::AnimationCursorKey>(withCursor).Length(), static_cast<int32_t>(trackCount));
+
+    // カーソルの有無で結果は変わらない
+    const float time = world.GetComponent<ECS::SkeletalAnimationData>(withCursor)->time;
+    PoseBuffer buffer(kBones);
+    Pose pose = buffer.GetPose();
+    AnimationClipCursor cursor;
+    clip->compressed->SamplePose(time, cursor, pose);
+    std::vector<Matrix> globals;
+    std::vector<Matrix> expected;
+    skeleton->ComputeGlobalTransforms(pose, globals);
+    skeleton->ComputeSkinningMatrices(globals, expected);
+
+    auto a = world.GetBuffer<ECS::SkinningMatrix>(withCursor);
+    auto b = world.GetBuffer<ECS::SkinningMatrix>(withoutCursor);
+    for (int i = 0; i < kBones; ++i) {
+        ExpectMatrixNear(a[i].value, expected[i]);
+        ExpectMatrixNear(b[i].value, expected[i]);
+    }
+
+    // 非圧縮クリップへ切り替えるとカーソルは空になる
+    world.GetComponent<ECS::SkeletalAnimationData>(withCursor)->Play(otherId);
+    world.FixedUpdate(kDt);
+    EXPECT_EQ(world.GetBuffer<ECS::AnimationCursorKey>(withCursor).Length(), 0);
+    EXPECT_EQ(world.GetComponent<ECS::SkeletalAnimationData>(withCursor)->boundClip, otherId);
+}
+
+TEST(AnimationSystemTest, TimeWrapsPerClipAndStopHoldsPose)
+{
+    constexpr int kBones = 4;
+    ECS::World world;
+    world.RegisterSystem<ECS::AnimationSystem>();
+    auto* animation = world.GetSystem<ECS::AnimationSystem>();
+    const uint32_t skeletonId = animation->RegisterSkeleton(MakeSkeleton(kBones));
+    const auto loop = CreateCharacter(world, skeletonId, animation->RegisterClip(MakeClip(kBones, 0.0f)));
+    const auto pingPong = CreateCharacter(world, skeletonId,
+        animation->RegisterClip(MakeClip(kBones, 0.0f, WrapMode::PingPong)));
+    const auto once = CreateCharacter(world, skeletonId,
+        animation->RegisterClip(MakeClip(kBones, 0.0f, WrapMode::Once)));
+    const auto stopped = CreateCharacter(world, skeletonId, 0);
+    world.GetComponent<ECS::SkeletalAnimationData>(stopped)->time = 0.5f;
+    world.GetComponent<ECS::SkeletalAnimationData>(stopped)->Stop();
+
+    for (int i = 0; i < 90; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    EXPECT_NEAR(world.GetComponent<ECS::SkeletalAnimationData>(loop)->time, 0.5f, 1e-3f);
+    EXPECT_NEAR(world.GetComponent<ECS::SkeletalAnimationData>(pingPong)->time, 1.5f, 1e-3f);
+    EXPECT_FLOAT_EQ(world.GetComponent<ECS::SkeletalAnimationData>(once)->time, 1.0f);
+    EXPECT_FLOAT_EQ(world.GetComponent<ECS::SkeletalAnimationData>(stopped)->time, 0.5f);
+
+    // 停止中もポーズは出力される
+    auto matrices = world.GetBuffer<ECS::SkinningMatrix>(stopped);
+    const std::vector<Matrix> expected = ReferenceSkinning(
+        *animation->GetSkeleton(skeletonId), *animation->GetClip(0), 0.5f);
+    ASSERT_EQ(matrices.Length(), kBones);
+    for (int b = 0; b < kBones; ++b) {
+        ExpectMatrixNear(matrices[b].value, expected[b]);
+    }
+}
+
+TEST(AnimationSystemTest, InstancesWithoutSkeletonAreSkipped)
+{
+    ECS::World world;
+    world.RegisterSystem<ECS::AnimationSystem>();
+    auto* animation = world.GetSystem<ECS::AnimationSystem>();
+    const uint32_t clipId = animation->RegisterClip(MakeClip(4, 0.0f));
+    const auto actor = CreateCharacter(world, ECS::SkeletonRefData::kInvalidId, clipId);
+
+    world.FixedUpdate(kDt);
+
+    EXPECT_EQ(world.GetBuffer<ECS::SkinningMatrix>(actor).Length(), 0);
+    EXPECT_FLOAT_EQ(world.GetComponent<ECS::SkeletalAnimationData>(actor)->time, 0.0f);
+}
+
+TEST(AnimationSystemTest, ParallelChunksMatchSerial)
+{
+    constexpr int kBones = 20;
+    constexpr int kCharacters = 300;
+
+    auto simulate = [](bool parallel) {
+        if (parallel) {
+            JobSystem::Create(2);
+        }
+        std::vector<Matrix> result;
+        {
+            ECS::World world;
+            world.RegisterSystem<ECS::AnimationSystem>();
+            auto* animation = world.GetSystem<ECS::AnimationSystem>();
+            const uint32_t skeletonId = animation->RegisterSkeleton(MakeSkeleton(kBones));
+            std::vector<uint32_t> clips;
+            for (int c = 0; c < 4; ++c) {
+                auto clip = MakeClip(kBones, 0.1f * static_cast<float>(c));
+                if (c % 2 == 0) {
+                    clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+                }
+                clips.push_back(animation->RegisterClip(clip));
+            }
+            std::vector<ECS::Actor> actors;
+            for (int i = 0; i < kCharacters; ++i) {
+                actors.push_back(CreateCharacter(world, skeletonId, clips[i % clips.size()]));
+                world.GetComponent<ECS::SkeletalAnimationData>(actors.back())->speed =
+                    0.5f + 0.01f * static_cast<float>(i % 50);
+            }
+            for (int i = 0; i < 20; ++i) {
+                world.FixedUpdate(kDt);
+            }
+            for (auto actor : actors) {
+                for (const auto& m : world.GetBuffer<ECS::SkinningMatrix>(actor)) {
+                    result.push_back(m.value);
+                }
+            }
+        }
+        if (parallel) {
+            JobSystem::Destroy();
+        }
+        return result;
+    };
+
+    const std::vector<Matrix> serial = simulate(false);
+    const std::vector<Matrix> parallel = simulate(true);
+    ASSERT_EQ(serial.size(), static_cast<size_t>(kBones * kCharacters));
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(std::memcmp(&serial[i], &parallel[i], sizeof(Matrix)), 0) << "matrix " << i;
+    }
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+TEST(AnimationSystemBenchmark, DISABLED_TwoThousandCharacters)
+{
+    constexpr int kBones = 60;
+    constexpr int kCharacters = 2000;
+    constexpr int kClips = 8;
+    constexpr int kMeasuredFrames = 30;
+
+    JobSystem::Create();
+    {
+        ECS::World world;
+        world.RegisterSystem<ECS::AnimationSystem>();
+        auto* animation = world.GetSystem<ECS::AnimationSystem>();
+        const uint32_t skeletonId = animation->RegisterSkeleton(MakeSkeleton(kBones));
+        std::vector<uint32_t> clips;
+        for (int c = 0; c < kClips; ++c) {
+            auto clip = MakeClip(kBones, 0.07f * static_cast<float>(c));
+            clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+            clip->ReleaseSourceKeys();
+            clips.push_back(animation->RegisterClip(clip));
+        }
+        for (int i = 0; i < kCharacters; ++i) {
+            const auto actor = CreateCharacter(world, skeletonId, clips[i % kClips]);
+            world.GetComponent<ECS::SkeletalAnimationData>(actor)->time = 0.013f * static_cast<float>(i);
+        }
+
+        // 初回はバッファ確保を含むので除外
+        world.FixedUpdate(kDt);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < kMeasuredFrames; ++i) {
+            world.FixedUpdate(kDt);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double msPerFrame =
+            std::chrono::duration<double, std::milli>(end - start).count() / kMeasuredFrames;
+
+        const uint32_t threads = JobSystem::Get().GetWorkerCount() + 1;
+        std::printf("[ BENCH    ] %d characters x %d bones, %u threads: %.3f ms/frame\n",
+                    kCharacters, kBones, threads, msPerFrame);
+        RecordProperty("characters", kCharacters);
+        RecordProperty("threads", static_cast<int>(threads));
+        RecordProperty("ms_per_frame_x1000", static_cast<int>(msPerFrame * 1000.0));
+    }
+    JobSystem::Destroy();
+}
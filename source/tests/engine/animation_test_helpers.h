@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------
+//! @file   animation_test_helpers.h
+//! @brief  アニメーションテスト共通ヘルパー（スケルトン・クリップの生成）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "test_helpers.h"
+#include "engine/game_object/components/animation/skeleton.h"
+#include "engine/game_object/components/animation/animation_clip.h"
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace TestHelpers
+{
+
+//! @brief 背骨＋左右の腕が枝分かれするスケルトン
+inline SkeletonPtr MakeSkeleton(int boneCount)
+{
+    auto skeleton = std::make_shared<Skeleton>();
+    for (int i = 0; i < boneCount; ++i) {
+        const int parent = (i < 3) ? i - 1 : (i % 3 == 0 ? i - 3 : i - 1);
+        skeleton->AddBone(Bone("Bone" + std::to_string(i), parent,
+                               Matrix::CreateTranslation(0.05f * static_cast<float>(i % 3), 0.1f, 0.0f)));
+    }
+    skeleton->ComputeInverseBindMatrices();
+    return skeleton;
+}
+
+//! @brief 全ボーンに位置・回転のキーを持つクリップ
+//! @param withScaleKeys trueならスケールのキーも付ける
+inline AnimationClipPtr MakeClip(int boneCount, float phase, WrapMode wrapMode = WrapMode::Loop,
+                                 bool withScaleKeys = false)
+{
+    auto clip = std::make_shared<AnimationClip>();
+    clip->name = "Clip";
+    clip->duration = 1.0f;
+    clip->wrapMode = wrapMode;
+    clip->channels.reserve(static_cast<size_t>(boneCount));
+    for (int b = 0; b < boneCount; ++b) {
+        BoneChannel& channel = clip->AddChannel(b);
+        for (int k = 0; k <= 30; ++k) {
+            const float t = static_cast<float>(k) / 30.0f;
+            const float angle = std::sin((t + phase) * 6.28318f + static_cast<float>(b) * 0.3f) * 0.8f;
+            channel.positionKeys.push_back({t, Vector3(0.0f, 0.1f + 0.02f * std::sin(t * 6.28318f), phase)});
+            channel.rotationKeys.push_back({t, Quaternion::CreateFromAxisAngle(
+                Vector3(0.3f, 1.0f, 0.2f), angle)});
+            if (withScaleKeys) {
+                channel.scaleKeys.push_back({t, Vector3(1.0f, 1.0f + 0.2f * t, 1.0f)});
+            }
+        }
+    }
+    return clip;
+}
+
+} // namespace TestHelpers
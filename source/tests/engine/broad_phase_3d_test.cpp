@@ -0,0 +1,312 @@
+//----------------------------------------------------------------------------
+//! @file   broad_phase_3d_test.cpp
+//! @brief  DynamicAabbTree3D / BroadPhase3D のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/collision/broad_phase_3d.h"
+#include "engine/ecs/collision/spatial_grid_3d.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using Collision::Bounds3D;
+using TestHelpers::TestRandom;
+
+Bounds3D MakeBox(float x, float y, float z, float halfExtent)
+{
+    return Bounds3D{x - halfExtent, y - halfExtent, z - halfExtent,
+                    x + halfExtent, y + halfExtent, z + halfExtent};
+}
+
+Bounds3D Translate(const Bounds3D& b, float dx, float dy, float dz)
+{
+    return Bounds3D{b.minX + dx, b.minY + dy, b.minZ + dz, b.maxX + dx, b.maxY + dy, b.maxZ + dz};
+}
+
+//! @brief ペアを(小さいID, 大きいID)に正規化してソート
+std::vector<std::pair<uint32_t, uint32_t>> Normalize(std::vector<std::pair<uint32_t, uint32_t>> pairs)
+{
+    for (auto& p : pairs) {
+        if (p.first > p.second) std::swap(p.first, p.second);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> CollectPairs(const Collision::BroadPhase3D& broadPhase)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    broadPhase.QueryAllPairs([&pairs](ECS::Actor a, ECS::Actor b) {
+        pairs.emplace_back(a.id, b.id);
+    });
+    return Normalize(std::move(pairs));
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> BruteForcePairs(const std::vector<ECS::Actor>& actors,
+                                                           const std::vector<Bounds3D>& bounds,
+                                                           const std::vector<bool>& alive)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        if (!alive[i]) continue;
+        for (size_t j = i + 1; j < bounds.size(); ++j) {
+            if (alive[j] && bounds[i].Overlaps(bounds[j])) {
+                pairs.emplace_back(actors[i].id, actors[j].id);
+            }
+        }
+    }
+    return Normalize(std::move(pairs));
+}
+
+//============================================================================
+// DynamicAabbTree3D テスト
+//============================================================================
+TEST(DynamicAabbTree3DTest, QueryMatchesBruteForceAfterMovesAndRemovals)
+{
+    Collision::DynamicAabbTree3D tree(0.0f);
+    TestRandom rng(7);
+
+    std::vector<int32_t> proxies;
+    std::vector<Bounds3D> bounds;
+    for (uint32_t i = 0; i < 500; ++i) {
+        bounds.push_back(MakeBox(rng.Range(-50, 50), rng.Range(-50, 50), rng.Range(-50, 50), rng.Range(0.5f, 3.0f)));
+        proxies.push_back(tree.CreateProxy(bounds.back(), i));
+    }
+    for (uint32_t i = 0; i < 500; i += 3) {
+        bounds[i] = Translate(bounds[i], rng.Range(-5, 5), rng.Range(-5, 5), rng.Range(-5, 5));
+        tree.MoveProxy(proxies[i], bounds[i]);
+    }
+    std::vector<bool> alive(500, true);
+    for (uint32_t i = 0; i < 500; i += 7) {
+        tree.DestroyProxy(proxies[i]);
+        alive[i] = false;
+    }
+
+    const Bounds3D query = MakeBox(0.0f, 0.0f, 0.0f, 15.0f);
+    std::vector<uint32_t> found;
+    tree.Query(query, [&](int32_t proxyId) { found.push_back(tree.GetUserData(proxyId)); });
+    std::sort(found.begin(), found.end());
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < 500; ++i) {
+        if (alive[i] && bounds[i].Overlaps(query)) expected.push_back(i);
+    }
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(tree.GetProxyCount(), 500u - (500u + 6u) / 7u);
+}
+
+TEST(DynamicAabbTree3DTest, RotationsKeepHeightLogarithmic)
+{
+    // 一方向に並べて挿入しても回転で高さが抑えられる
+    Collision::DynamicAabbTree3D tree;
+    constexpr uint32_t kCount = 4096;
+    for (uint32_t i = 0; i < kCount; ++i) {
+        tree.CreateProxy(MakeBox(static_cast<float>(i) * 2.0f, 0.0f, 0.0f, 0.5f), i);
+    }
+    EXPECT_LE(tree.GetHeight(), 2 * static_cast<int32_t>(std::log2(kCount)));
+}
+
+TEST(DynamicAabbTree3DTest, MoveWithinFatBoundsDoesNotReinsert)
+{
+    Collision::DynamicAabbTree3D tree(0.5f);
+    const int32_t proxy = tree.CreateProxy(MakeBox(0, 0, 0, 1.0f), 0);
+
+    EXPECT_FALSE(tree.MoveProxy(proxy, MakeBox(0.3f, 0, 0, 1.0f)));
+    EXPECT_TRUE(tree.MoveProxy(proxy, MakeBox(1.0f, 0, 0, 1.0f)));
+}
+
+//============================================================================
+// BroadPhase3D テスト
+//============================================================================
+TEST(BroadPhase3DTest, PairsMatchBruteForceAcrossFrames)
+{
+    // margin 0 + 平行移動のみなら、ペアは実AABBの重なりと一致する
+    Collision::BroadPhase3D broadPhase(0.0f);
+    TestRandom rng(42);
+
+    constexpr uint32_t kCount = 400;
+    std::vector<ECS::Actor> actors;
+    std::vector<Bounds3D> bounds;
+    std::vector<bool> alive(kCount, true);
+    for (uint32_t i = 0; i < kCount; ++i) {
+        actors.emplace_back(i, 0u);
+        bounds.push_back(MakeBox(rng.Range(-30, 30), rng.Range(-30, 30), rng.Range(-30, 30), rng.Range(0.5f, 2.5f)));
+    }
+
+    for (int frame = 0; frame < 6; ++frame) {
+        // 一部を移動・削除
+        if (frame > 0) {
+            for (uint32_t i = static_cast<uint32_t>(frame); i < kCount; i += 5) {
+                bounds[i] = Translate(bounds[i], rng.Range(-3, 3), rng.Range(-3, 3), rng.Range(-3, 3));
+            }
+            alive[frame * 11] = false;
+        }
+
+        broadPhase.BeginUpdate();
+        for (uint32_t i = 0; i < kCount; ++i) {
+            if (alive[i]) broadPhase.UpdateProxy(actors[i], bounds[i]);
+        }
+        broadPhase.EndUpdate();
+
+        EXPECT_EQ(CollectPairs(broadPhase), BruteForcePairs(actors, bounds, alive)) << "frame " << frame;
+    }
+}
+
+TEST(BroadPhase3DTest, StaticFrameRebuildsNothing)
+{
+    Collision::BroadPhase3D broadPhase;
+    std::vector<Bounds3D> bounds = {MakeBox(0, 0, 0, 1), MakeBox(1, 0, 0, 1), MakeBox(10, 0, 0, 1)};
+
+    for (int frame = 0; frame < 2; ++frame) {
+        broadPhase.BeginUpdate();
+        for (uint32_t i = 0; i < bounds.size(); ++i) {
+            broadPhase.UpdateProxy(ECS::Actor(i, 0u), bounds[i]);
+        }
+        broadPhase.EndUpdate();
+    }
+
+    EXPECT_EQ(broadPhase.GetLastMovedCount(), 0u);
+    EXPECT_EQ(broadPhase.GetPairCount(), 1u);
+}
+
+TEST(BroadPhase3DTest, OnlyProxiesLeavingFatBoundsAreMoved)
+{
+    Collision::BroadPhase3D broadPhase;
+    std::vector<Bounds3D> bounds = {MakeBox(0, 0, 0, 1), MakeBox(10, 0, 0, 1), MakeBox(20, 0, 0, 1)};
+
+    for (int frame = 0; frame < 2; ++frame) {
+        if (frame == 1) {
+            bounds[0] = MakeBox(0.01f, 0, 0, 1);   // 太いAABB内
+            bounds[2] = MakeBox(11, 0, 0, 1);      // 大きく移動して[1]と重なる
+        }
+        broadPhase.BeginUpdate();
+        for (uint32_t i = 0; i < bounds.size(); ++i) {
+            broadPhase.UpdateProxy(ECS::Actor(i, 0u), bounds[i]);
+        }
+        broadPhase.EndUpdate();
+    }
+
+    EXPECT_EQ(broadPhase.GetLastMovedCount(), 1u);
+    EXPECT_EQ(broadPhase.GetPairCount(), 1u);
+}
+
+TEST(BroadPhase3DTest, ReusedActorIndexReplacesOldProxy)
+{
+    Collision::BroadPhase3D broadPhase;
+    const ECS::Actor other(1u, 0u);
+
+    broadPhase.BeginUpdate();
+    broadPhase.UpdateProxy(ECS::Actor(0u, 0u), MakeBox(0, 0, 0, 1));
+    broadPhase.UpdateProxy(other, MakeBox(1, 0, 0, 1));
+    broadPhase.EndUpdate();
+    ASSERT_EQ(broadPhase.GetPairCount(), 1u);
+
+    // 同じインデックスの新世代Actorが離れた位置に現れる
+    const ECS::Actor reused(0u, 1u);
+    broadPhase.BeginUpdate();
+    broadPhase.UpdateProxy(reused, MakeBox(50, 0, 0, 1));
+    broadPhase.UpdateProxy(other, MakeBox(1, 0, 0, 1));
+    broadPhase.EndUpdate();
+
+    EXPECT_EQ(broadPhase.GetProxyCount(), 2u);
+    EXPECT_EQ(broadPhase.GetPairCount(), 0u);
+}
+
+//============================================================================
+// Broad-phase ベンチマーク（SpatialGrid3D毎フレーム再構築との比較）
+//
+// ほぼ静的な大量コライダーのうち一部だけが動く状況を測る。
+// 結果は標準出力とテストプロパティに記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class BroadPhase3DBenchmark : public ::testing::Test {
+protected:
+    static constexpr uint32_t kColliderCount = 20000;
+    static constexpr uint32_t kMovingStride = 50;   // 2%が移動
+    static constexpr int kFrames = 30;
+
+    void SetUp() override
+    {
+        TestRandom rng(1234);
+        for (uint32_t i = 0; i < kColliderCount; ++i) {
+            actors_.emplace_back(i, 0u);
+            bounds_.push_back(MakeBox(rng.Range(-500, 500), rng.Range(-20, 20), rng.Range(-500, 500),
+                                      rng.Range(0.5f, 2.0f)));
+        }
+    }
+
+    void MoveColliders(int frame)
+    {
+        const float dx = (frame % 2 == 0) ? 0.5f : -0.5f;
+        for (uint32_t i = 0; i < kColliderCount; i += kMovingStride) {
+            bounds_[i] = Translate(bounds_[i], dx, 0.0f, 0.0f);
+        }
+    }
+
+    void Report(const char* label, std::chrono::steady_clock::duration elapsed, size_t pairs)
+    {
+        const double ms = std::chrono::duration<double, std::milli>(elapsed).count() / kFrames;
+        std::printf("[ BENCH    ] %s: %u colliders, %.3f ms/frame, %zu pairs\n",
+                    label, kColliderCount, ms, pairs);
+        RecordProperty(label, static_cast<int>(ms * 1000.0));
+    }
+
+    std::vector<ECS::Actor> actors_;
+    std::vector<Bounds3D> bounds_;
+};
+
+TEST_F(BroadPhase3DBenchmark, DISABLED_SpatialGridRebuildPerFrame)
+{
+    Collision::SpatialGrid3D grid(10.0f);
+    size_t pairs = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        MoveColliders(frame);
+        grid.Clear();
+        for (uint32_t i = 0; i < kColliderCount; ++i) {
+            const Bounds3D& b = bounds_[i];
+            grid.Insert(actors_[i], b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ);
+        }
+        pairs = 0;
+        grid.QueryAllPairs([&pairs](ECS::Actor, ECS::Actor) { ++pairs; });
+    }
+    Report("SpatialGridRebuildPerFrame", std::chrono::steady_clock::now() - start, pairs);
+}
+
+TEST_F(BroadPhase3DBenchmark, DISABLED_PersistentBroadPhase)
+{
+    Collision::BroadPhase3D broadPhase;
+
+    // 初回構築は計測外（以降のフレームは差分更新）
+    broadPhase.BeginUpdate();
+    for (uint32_t i = 0; i < kColliderCount; ++i) {
+        broadPhase.UpdateProxy(actors_[i], bounds_[i]);
+    }
+    broadPhase.EndUpdate();
+
+    size_t pairs = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        MoveColliders(frame);
+        broadPhase.BeginUpdate();
+        for (uint32_t i = 0; i < kColliderCount; ++i) {
+            broadPhase.UpdateProxy(actors_[i], bounds_[i]);
+        }
+        broadPhase.EndUpdate();
+        pairs = 0;
+        broadPhase.QueryAllPairs([&pairs](ECS::Actor, ECS::Actor) { ++pairs; });
+    }
+    Report("PersistentBroadPhase", std::chrono::steady_clock::now() - start, pairs);
+
+    EXPECT_LE(broadPhase.GetLastMovedCount(), kColliderCount / kMovingStride + 1);
+}
+
+} // namespace
@@ -0,0 +1,407 @@
+//----------------------------------------------------------------------------
+//! @file   bvh_test.cpp
+//! @brief  Physics::BVH のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/physics/bvh.h"
+#include "physics_test_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+using Physics::BVH;
+using Physics::BVHNode;
+using Physics::Triangle;
+using TestHelpers::MakeTerrain;
+using TestHelpers::MakeTriangleSoup;
+using TestHelpers::TestRandom;
+
+bool Contains(const BVHNode& outer, const Vector3& p)
+{
+    return p.x >= outer.minX && p.x <= outer.maxX &&
+           p.y >= outer.minY && p.y <= outer.maxY &&
+           p.z >= outer.minZ && p.z <= outer.maxZ;
+}
+
+bool Contains(const BVHNode& outer, const BVHNode& inner)
+{
+    return Contains(outer, Vector3(inner.minX, inner.minY, inner.minZ)) &&
+           Contains(outer, Vector3(inner.maxX, inner.maxY, inner.maxZ));
+}
+
+//! @brief 全三角形を総当たりで判定（基準）
+bool BruteForceIntersect(const std::vector<Triangle>& triangles, const Vector3& origin, const Vector3& dir,
+                         float tMax, float& outT, uint32_t& outTri)
+{
+    // 単一三角形のBVHで交差判定を流用する
+    bool hit = false;
+    for (const Triangle& tri : triangles) {
+        BVH single;
+        single.Build({tri});
+        float t;
+        uint32_t index;
+        if (single.Intersect(origin, dir, tMax, t, index)) {
+            tMax = t;
+            outT = t;
+            outTri = index;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+//! @brief 三角形を頂点配列とインデックスに展開（リフィットの入力）
+void ToVertices(const std::vector<Triangle>& triangles, std::vector<Vector3>& positions,
+                std::vector<uint32_t>& indices)
+{
+    positions.clear();
+    for (const Triangle& tri : triangles) {
+        positions.insert(positions.end(), {tri.v0, tri.v1, tri.v2});
+    }
+    indices.resize(positions.size());
+    std::iota(indices.begin(), indices.end(), 0u);
+}
+
+//! @brief 頂点配列から三角形を組み立て直す
+std::vector<Triangle> FromVertices(const std::vector<Vector3>& positions)
+{
+    std::vector<Triangle> triangles;
+    for (uint32_t i = 0; i * 3 < positions.size(); ++i) {
+        triangles.push_back(Triangle{positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], i});
+    }
+    return triangles;
+}
+
+//! @brief 波で頂点を上下させる（形状は変わるが三角形の並びは保たれる変形）
+void ApplyWave(std::vector<Vector3>& positions, float phase)
+{
+    for (Vector3& p : positions) {
+        p.y += std::sin(p.x * 0.3f + phase) * std::cos(p.z * 0.2f) * 2.0f;
+    }
+}
+
+//! @brief ノードのAABBが子（葉なら三角形）のAABBと一致するか
+void ExpectTightBounds(const BVH& bvh)
+{
+    const auto& nodes = bvh.GetNodes();
+    const auto& indices = bvh.GetTriangleIndices();
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        const BVHNode& node = nodes[n];
+        Physics::AABB expected;
+        if (node.IsLeaf()) {
+            for (uint32_t i = 0; i < node.triCount; ++i) {
+                expected.Expand(bvh.GetTriangles()[indices[node.leftFirst + i]].GetAABB());
+            }
+        } else {
+            expected.Expand(nodes[n + 1].GetBounds());
+            expected.Expand(nodes[node.leftFirst].GetBounds());
+        }
+        EXPECT_EQ(node.minX, expected.min.x) << n;
+        EXPECT_EQ(node.minY, expected.min.y) << n;
+        EXPECT_EQ(node.minZ, expected.min.z) << n;
+        EXPECT_EQ(node.maxX, expected.max.x) << n;
+        EXPECT_EQ(node.maxY, expected.max.y) << n;
+        EXPECT_EQ(node.maxZ, expected.max.z) << n;
+    }
+}
+
+} // namespace
+
+//============================================================================
+// 構造
+//============================================================================
+
+TEST(BVHTest, NodeIsThirtyTwoBytes)
+{
+    EXPECT_EQ(sizeof(BVHNode), 32u);
+}
+
+TEST(BVHTest, DepthFirstLayoutCoversEveryTriangleOnce)
+{
+    const auto triangles = MakeTriangleSoup(3000, 50.0f, 1);
+    BVH bvh;
+    bvh.Build(triangles);
+
+    const auto& nodes = bvh.GetNodes();
+    const auto& indices = bvh.GetTriangleIndices();
+    ASSERT_FALSE(nodes.empty());
+
+    std::vector<uint32_t> seen(triangles.size(), 0);
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        const BVHNode& node = nodes[i];
+        if (node.IsLeaf()) {
+            for (uint32_t k = 0; k < node.triCount; ++k) {
+                const Triangle& tri = triangles[indices[node.leftFirst + k]];
+                ++seen[tri.index];
+                EXPECT_TRUE(Contains(node, tri.v0) && Contains(node, tri.v1) && Contains(node, tri.v2));
+            }
+        } else {
+            // 左子は直後、右子はleftFirst
+            ASSERT_LT(node.leftFirst, nodes.size());
+            EXPECT_GT(node.leftFirst, i + 1);
+            EXPECT_TRUE(Contains(node, nodes[i + 1]));
+            EXPECT_TRUE(Contains(node, nodes[node.leftFirst]));
+        }
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](uint32_t c) { return c == 1; }));
+
+    // 入力順の三角形はそのまま保持される
+    for (uint32_t i = 0; i < triangles.size(); ++i) {
+        EXPECT_EQ(bvh.GetTriangles()[i].index, i);
+    }
+
+    const auto& stats = bvh.GetBuildStats();
+    EXPECT_EQ(stats.nodeCount, nodes.size());
+    EXPECT_EQ(stats.nodeCount, stats.leafCount * 2 - 1);
+    EXPECT_LE(stats.maxLeafTriangles, BVH::kMaxLeafTriangles);
+    EXPECT_LT(stats.maxDepth, BVH::kStackSize);
+    EXPECT_GT(stats.sahCost, 0.0f);
+}
+
+TEST(BVHTest, DegenerateCentroidsStillSplit)
+{
+    // 全三角形が同じ位置（SAHでは分割できない）
+    std::vector<Triangle> triangles(100, Triangle{Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0), 0});
+    for (uint32_t i = 0; i < triangles.size(); ++i) triangles[i].index = i;
+
+    BVH bvh;
+    bvh.Build(triangles);
+    EXPECT_LE(bvh.GetBuildStats().maxLeafTriangles, BVH::kMaxLeafTriangles);
+
+    float t;
+    uint32_t index;
+    EXPECT_TRUE(bvh.Intersect(Vector3(0.2f, 0.2f, -1.0f), Vector3(0, 0, 1), 10.0f, t, index));
+    EXPECT_NEAR(t, 1.0f, 1e-5f);
+}
+
+//============================================================================
+// レイキャスト
+//============================================================================
+
+TEST(BVHTest, RaycastMatchesBruteForce)
+{
+    const auto triangles = MakeTriangleSoup(800, 20.0f, 5);
+    BVH bvh;
+    bvh.Build(triangles);
+
+    TestRandom rng(9);
+    int hits = 0;
+    for (int r = 0; r < 200; ++r) {
+        const Vector3 origin(rng.Range(-30, 30), rng.Range(-30, 30), -40.0f);
+        Vector3 dir(rng.Range(-0.3f, 0.3f), rng.Range(-0.3f, 0.3f), 1.0f);
+        dir.Normalize();
+
+        float expectedT = 0.0f, actualT = 0.0f;
+        uint32_t expectedTri = 0, actualTri = 0;
+        const bool expected = BruteForceIntersect(triangles, origin, dir, 1000.0f, expectedT, expectedTri);
+        const bool actual = bvh.Intersect(origin, dir, 1000.0f, actualT, actualTri);
+        ASSERT_EQ(actual, expected) << r;
+        if (expected) {
+            ++hits;
+            EXPECT_FLOAT_EQ(actualT, expectedT);
+            EXPECT_EQ(actualTri, expectedTri);
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST(BVHTest, ParallelBuildMatchesSerialBuild)
+{
+    const auto triangles = MakeTerrain(120);
+
+    BVH serial;
+    serial.Build(triangles);
+
+    JobSystem::Create(3);
+    BVH parallel;
+    parallel.Build(triangles);
+    JobSystem::Destroy();
+
+    ASSERT_EQ(parallel.GetNodes().size(), serial.GetNodes().size());
+    EXPECT_EQ(parallel.GetTriangleIndices(), serial.GetTriangleIndices());
+    for (size_t i = 0; i < serial.GetNodes().size(); ++i) {
+        const BVHNode& a = parallel.GetNodes()[i];
+        const BVHNode& b = serial.GetNodes()[i];
+        EXPECT_EQ(a.leftFirst, b.leftFirst);
+        EXPECT_EQ(a.triCount, b.triCount);
+    }
+    EXPECT_FLOAT_EQ(parallel.GetBuildStats().sahCost, serial.GetBuildStats().sahCost);
+}
+
+//============================================================================
+// リフィット
+//============================================================================
+
+TEST(BVHTest, RefitKeepsTopologyAndTightensBounds)
+{
+    const auto triangles = MakeTerrain(30);
+    BVH bvh;
+    bvh.Build(triangles);
+    const std::vector<uint32_t> leafOrder = bvh.GetTriangleIndices();
+    std::vector<uint32_t> topology;
+    for (const BVHNode& node : bvh.GetNodes()) {
+        topology.push_back(node.leftFirst);
+        topology.push_back(node.triCount);
+    }
+
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    ToVertices(triangles, positions, indices);
+    ApplyWave(positions, 1.0f);
+    bvh.Refit(positions, indices);
+
+    // 分割はそのまま、AABBだけが変わる
+    EXPECT_EQ(bvh.GetTriangleIndices(), leafOrder);
+    std::vector<uint32_t> refitTopology;
+    for (const BVHNode& node : bvh.GetNodes()) {
+        refitTopology.push_back(node.leftFirst);
+        refitTopology.push_back(node.triCount);
+    }
+    EXPECT_EQ(refitTopology, topology);
+    ExpectTightBounds(bvh);
+
+    // 変形後の三角形に対して総当たりと一致する
+    const auto deformed = FromVertices(positions);
+    TestRandom rng(4);
+    int hits = 0;
+    for (int r = 0; r < 100; ++r) {
+        const Vector3 origin(rng.Range(0, 30), 20.0f, rng.Range(0, 30));
+        Vector3 dir(rng.Range(-0.5f, 0.5f), -1.0f, rng.Range(-0.5f, 0.5f));
+        dir.Normalize();
+
+        float expectedT = 0.0f, actualT = 0.0f;
+        uint32_t expectedTri = 0, actualTri = 0;
+        const bool expected = BruteForceIntersect(deformed, origin, dir, 1000.0f, expectedT, expectedTri);
+        const bool actual = bvh.Intersect(origin, dir, 1000.0f, actualT, actualTri);
+        ASSERT_EQ(actual, expected) << r;
+        if (expected) {
+            ++hits;
+            EXPECT_FLOAT_EQ(actualT, expectedT);
+            EXPECT_EQ(actualTri, expectedTri);
+        }
+    }
+    EXPECT_GT(hits, 50);
+}
+
+TEST(BVHTest, ParallelRefitMatchesSerialRefit)
+{
+    const auto triangles = MakeTerrain(120);
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    ToVertices(triangles, positions, indices);
+    ApplyWave(positions, 0.5f);
+
+    BVH serial;
+    serial.Build(triangles);
+    serial.Refit(positions, indices);
+
+    JobSystem::Create(3);
+    BVH parallel;
+    parallel.Build(triangles);
+    parallel.Refit(positions, indices);
+    JobSystem::Destroy();
+
+    ASSERT_EQ(parallel.GetNodes().size(), serial.GetNodes().size());
+    for (size_t i = 0; i < serial.GetNodes().size(); ++i) {
+        EXPECT_EQ(std::memcmp(&parallel.GetNodes()[i], &serial.GetNodes()[i], sizeof(BVHNode)), 0) << i;
+    }
+    EXPECT_FLOAT_EQ(parallel.GetSahCost(), serial.GetSahCost());
+    ExpectTightBounds(parallel);
+}
+
+TEST(BVHTest, SahDegradationTracksRefitQuality)
+{
+    const auto triangles = MakeTriangleSoup(4000, 30.0f, 12);
+    BVH bvh;
+    bvh.Build(triangles);
+    EXPECT_FLOAT_EQ(bvh.GetSahCost(), bvh.GetBuildStats().sahCost);
+    EXPECT_FLOAT_EQ(bvh.GetSahDegradation(), 1.0f);
+
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    ToVertices(triangles, positions, indices);
+
+    // 全体の平行移動では品質は変わらない
+    for (Vector3& p : positions) p += Vector3(100.0f, -50.0f, 20.0f);
+    bvh.Refit(positions, indices);
+    EXPECT_NEAR(bvh.GetSahDegradation(), 1.0f, 1e-3f);
+
+    // 三角形をばらばらに動かすと、分割が合わなくなりコストが上がる
+    TestRandom rng(99);
+    for (uint32_t i = 0; i < positions.size(); i += 3) {
+        const Vector3 offset(rng.Range(-30, 30), rng.Range(-30, 30), rng.Range(-30, 30));
+        for (uint32_t k = 0; k < 3; ++k) positions[i + k] += offset;
+    }
+    bvh.Refit(positions, indices);
+    EXPECT_GT(bvh.GetSahDegradation(), 2.0f);
+
+    // 作り直せば元の品質に戻る
+    BVH rebuilt;
+    rebuilt.Build(bvh.GetTriangles());
+    EXPECT_LT(rebuilt.GetSahCost(), bvh.GetSahCost() * 0.5f);
+}
+
+//============================================================================
+// ベンチマーク
+//
+// レベルジオメトリ相当の地形メッシュで構築時間とSAHコストを測る。
+// 結果は標準出力とテストプロパティに記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class BVHBenchmark : public ::testing::Test {
+protected:
+    void Report(const char* label, const BVH& bvh)
+    {
+        const auto& stats = bvh.GetBuildStats();
+        std::printf("[ BENCH    ] %s: %zu triangles, %.3f ms, SAH %.2f, %u nodes, depth %u\n",
+                    label, bvh.GetTriangleCount(), stats.buildTimeMs, stats.sahCost,
+                    stats.nodeCount, stats.maxDepth);
+        RecordProperty(label, static_cast<int>(stats.buildTimeMs * 1000.0));
+    }
+};
+
+TEST_F(BVHBenchmark, DISABLED_BuildTerrainSerial)
+{
+    BVH bvh;
+    bvh.Build(MakeTerrain(500));   // 50万三角形
+    Report("BuildTerrainSerial", bvh);
+}
+
+TEST_F(BVHBenchmark, DISABLED_BuildTerrainParallel)
+{
+    JobSystem::Create();
+    BVH bvh;
+    bvh.Build(MakeTerrain(500));
+    JobSystem::Destroy();
+    Report("BuildTerrainParallel", bvh);
+}
+
+TEST_F(BVHBenchmark, DISABLED_RefitTerrainParallel)
+{
+    const auto triangles = MakeTerrain(500);
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    ToVertices(triangles, positions, indices);
+    ApplyWave(positions, 0.25f);
+
+    JobSystem::Create();
+    BVH bvh;
+    bvh.Build(triangles);
+    const auto start = std::chrono::steady_clock::now();
+    bvh.Refit(positions, indices);
+    const double refitMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    JobSystem::Destroy();
+
+    std::printf("[ BENCH    ] RefitTerrainParallel: %zu triangles, %.3f ms (build %.3f ms), SAH %.2f -> %.2f\n",
+                bvh.GetTriangleCount(), refitMs, bvh.GetBuildStats().buildTimeMs,
+                bvh.GetBuildStats().sahCost, bvh.GetSahCost());
+    RecordProperty("RefitTerrainParallel", static_cast<int>(refitMs * 1000.0));
+}
@@ -0,0 +1,297 @@
+//----------------------------------------------------------------------------
+//! @file   compressed_clip_test.cpp
+//! @brief  CompressedAnimationClip（量子化・キー削減・カーソル再生）のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/world.h"
+#include "engine/game_object/game_object_impl.h"
+#include "engine/game_object/components/animator.h"
+#include "engine/game_object/components/animation/compressed_clip.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+using Kind = CompressedAnimationClip::TrackKind;
+
+//! @brief 2つの回転の角度差（ラジアン）
+float RotationError(const Quaternion& a, const Quaternion& b)
+{
+    const Quaternion d = (a.Dot(b) < 0.0f) ? a + b : a - b;
+    return 4.0f * std::asin(std::min(1.0f, d.Length() * 0.5f));
+}
+
+//! @brief 30fpsで焼き込まれた、ゆらぎのあるクリップ
+AnimationClipPtr MakeBakedClip(int boneCount, float duration, float phase)
+{
+    auto clip = std::make_shared<AnimationClip>();
+    clip->name = "Baked";
+    clip->duration = duration;
+    clip->frameRate = 30.0f;
+    clip->wrapMode = WrapMode::Loop;
+
+    const int frames = static_cast<int>(duration * clip->frameRate);
+    for (int b = 0; b < boneCount; ++b) {
+        BoneChannel& channel = clip->AddChannel(b);
+        for (int f = 0; f <= frames; ++f) {
+            const float t = f / clip->frameRate;
+            const float wave = std::sin(t * 6.28318f / duration + b * 0.4f + phase);
+            // 位置はルートのみ動く（他は一定オフセット＝よくある骨格）
+            const Vector3 position = (b == 0)
+                ? Vector3(0.0f, 0.9f + 0.05f * wave, t * 1.5f)
+                : Vector3(0.0f, 0.12f, 0.0f);
+            channel.positionKeys.push_back({t, position});
+            channel.rotationKeys.push_back({t, Quaternion::CreateFromAxisAngle(
+                Vector3(1.0f, 0.2f * b, 0.1f), 0.6f * wave)});
+            channel.scaleKeys.push_back({t, Vector3::One});
+        }
+    }
+    return clip;
+}
+
+//============================================================================
+// 量子化
+//============================================================================
+
+TEST(CompressedClipTest, SmallestThreeRoundTripsWithin48Bits)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    float worst = 0.0f;
+    for (int i = 0; i < 1000; ++i) {
+        Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+        q.Normalize();
+
+        uint16_t packed[3];
+        CompressedAnimationClip::PackRotation(q, packed);
+        const Quaternion decoded = CompressedAnimationClip::UnpackRotation(packed);
+
+        EXPECT_NEAR(decoded.Length(), 1.0f, 1e-4f);
+        worst = std::max(worst, RotationError(q, decoded));
+    }
+    EXPECT_LT(worst, 2e-4f);
+}
+
+//============================================================================
+// 一定値トラック / キー削減
+//============================================================================
+
+TEST(CompressedClipTest, ConstantAndDefaultTracksAreStripped)
+{
+    AnimationClip clip;
+    clip.duration = 1.0f;
+    clip.frameRate = 30.0f;
+    clip.channels.reserve(2);
+
+    // 位置一定（既定値でない）・回転アニメーション・スケール既定
+    BoneChannel& arm = clip.AddChannel(1);
+    // 全トラック既定 → チャンネルごと消える
+    BoneChannel& idle = clip.AddChannel(2);
+    for (int f = 0; f <= 30; ++f) {
+        const float t = f / 30.0f;
+        arm.positionKeys.push_back({t, Vector3(0.0f, 0.5f, 0.0f)});
+        arm.rotationKeys.push_back({t, Quaternion::CreateFromAxisAngle(Vector3::UnitZ, t * t)});
+        arm.scaleKeys.push_back({t, Vector3::One});
+        idle.positionKeys.push_back({t, Vector3::Zero});
+        idle.rotationKeys.push_back({t, Quaternion::Identity});
+    }
+
+    const CompressedAnimationClip compressed(clip);
+    ASSERT_EQ(compressed.GetChannels().size(), 1u);
+    const auto& channel = compressed.GetChannels()[0];
+    EXPECT_EQ(channel.boneIndex, 1);
+    EXPECT_EQ(channel.translation.kind, Kind::Constant);
+    EXPECT_EQ(channel.rotation.kind, Kind::Animated);
+    EXPECT_EQ(channel.scale.kind, Kind::Default);
+    EXPECT_EQ(compressed.GetAnimatedTrackCount(), 1u);
+}
+
+TEST(CompressedClipTest, LinearMotionReducesToEndpointKeys)
+{
+    AnimationClip clip;
+    clip.duration = 2.0f;
+    clip.frameRate = 30.0f;
+    BoneChannel& root = clip.AddChannel(0);
+    for (int f = 0; f <= 60; ++f) {
+        const float t = f / 30.0f;
+        root.positionKeys.push_back({t, Vector3(t * 3.0f, 0.0f, -t)});
+    }
+
+    const CompressedAnimationClip compressed(clip);
+    ASSERT_EQ(compressed.GetChannels().size(), 1u);
+    EXPECT_EQ(compressed.GetChannels()[0].translation.kind, Kind::Animated);
+    EXPECT_EQ(compressed.GetChannels()[0].translation.keyCount, 2u);
+}
+
+TEST(CompressedClipTest, SamplingStaysWithinToleranceOfSource)
+{
+    auto clip = MakeBakedClip(10, 2.0f, 0.3f);
+    AnimationCompressionSettings settings;
+    settings.translationTolerance = 0.002f;
+    settings.rotationTolerance = 0.002f;
+    const CompressedAnimationClip compressed(*clip, settings);
+
+    PoseBuffer sourceBuffer(10);
+    PoseBuffer compressedBuffer(10);
+    AnimationClipCursor cursor;
+
+    // 量子化分の余裕
+    const float translationSlack = settings.translationTolerance + 1e-3f;
+    const float rotationSlack = settings.rotationTolerance + 1e-3f;
+
+    for (int step = 0; step < 240; ++step) {
+        const float time = step * (1.0f / 97.0f);   // キー時刻とずれた時刻
+        Pose source = sourceBuffer.GetPose();
+        Pose result = compressedBuffer.GetPose();
+        source.SetIdentity();
+        result.SetIdentity();
+        clip->SamplePose(time, source);
+        compressed.SamplePose(time, cursor, result);
+
+        for (uint32_t b = 0; b < 10; ++b) {
+            EXPECT_LE(Vector3::Distance(source.GetTranslation(b), result.GetTranslation(b)), translationSlack)
+                << "bone " << b << " time " << time;
+            EXPECT_LE(RotationError(source.GetRotation(b), result.GetRotation(b)), rotationSlack)
+                << "bone " << b << " time " << time;
+        }
+    }
+}
+
+//============================================================================
+// カーソル
+//============================================================================
+
+TEST(CompressedClipTest, CursorMatchesFreshCursorAcrossLoopAndPingPong)
+{
+    for (WrapMode mode : { WrapMode::Loop, WrapMode::PingPong }) {
+        auto clip = MakeBakedClip(4, 1.0f, 0.0f);
+        clip->wrapMode = mode;
+        const CompressedAnimationClip compressed(*clip);
+
+        PoseBuffer walkedBuffer(4);
+        PoseBuffer freshBuffer(4);
+        AnimationClipCursor walked;
+
+        // ループ境界をまたぎ、途中で巻き戻しも入れる
+        const float times[] = { 0.0f, 0.2f, 0.55f, 0.97f, 1.03f, 1.4f, 0.1f, 0.8f, 2.6f, 1.9f, 0.0f };
+        for (float time : times) {
+            AnimationClipCursor fresh;
+            Pose a = walkedBuffer.GetPose();
+            Pose b = freshBuffer.GetPose();
+            compressed.SamplePose(time, walked, a);
+            compressed.SamplePose(time, fresh, b);
+            for (uint32_t bone = 0; bone < 4; ++bone) {
+                EXPECT_NEAR(a.GetTranslation(bone).y, b.GetTranslation(bone).y, 1e-6f);
+                EXPECT_NEAR(a.GetRotation(bone).Dot(b.GetRotation(bone)), 1.0f, 1e-6f);
+            }
+        }
+        EXPECT_EQ(walked.GetClip(), &compressed);
+    }
+}
+
+//============================================================================
+// メモリ / Animator
+//============================================================================
+
+TEST(CompressedClipTest, CompressesTypicalClipSeveralTimes)
+{
+    auto clip = MakeBakedClip(60, 2.0f, 0.0f);
+    const CompressedAnimationClip compressed(*clip);
+
+    const size_t sourceSize = CompressedAnimationClip::GetSourceMemorySize(*clip);
+    const size_t compressedSize = compressed.GetMemorySize();
+    EXPECT_LT(compressedSize * 4, sourceSize);
+}
+
+TEST(CompressedClipTest, AnimatorUsesCompressedClipWhenSourceKeysReleased)
+{
+    constexpr int kBones = 8;
+    auto skeleton = std::make_shared<Skeleton>();
+    for (int i = 0; i < kBones; ++i) {
+        skeleton->AddBone(Bone("Bone" + std::to_string(i), i - 1));
+    }
+
+    auto reference = MakeBakedClip(kBones, 1.0f, 0.0f);
+    auto clip = MakeBakedClip(kBones, 1.0f, 0.0f);
+    clip->compressed = std::make_shared<CompressedAnimationClip>(*clip);
+    clip->ReleaseSourceKeys();
+    EXPECT_TRUE(clip->IsValid());
+
+    auto makeAnimator = [&](const AnimationClipPtr& c) {
+        auto controller = std::make_shared<AnimatorController>();
+        controller->AddLayer("Base Layer").AddState("Move", c);
+        auto animator = std::make_unique<Animator>();
+        animator->SetController(controller);
+        animator->SetSkeleton(skeleton);
+        return animator;
+    };
+    auto expected = makeAnimator(reference);
+    auto actual = makeAnimator(clip);
+
+    for (int frame = 0; frame < 90; ++frame) {
+        expected->Update(1.0f / 60.0f);
+        actual->Update(1.0f / 60.0f);
+    }
+    for (int b = 0; b < kBones; ++b) {
+        const Matrix e = expected->GetBoneGlobalTransform(b);
+        const Matrix a = actual->GetBoneGlobalTransform(b);
+        const float* pe = &e._11;
+        const float* pa = &a._11;
+        for (int i = 0; i < 16; ++i) {
+            EXPECT_NEAR(pa[i], pe[i], 1e-2f) << "bone " << b << " element " << i;
+        }
+    }
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+TEST(CompressedClipTest, DISABLED_Benchmark_CursorSamplingVsKeySearch)
+{
+    constexpr int kInstances = 300;
+    constexpr int kClips = 24;      // インスタンスごとに別クリップ（ライブラリがキャッシュに載らない状況）
+    constexpr int kBones = 80;
+    constexpr int kFrames = 30;
+
+    std::vector<AnimationClipPtr> clips;
+    std::vector<std::unique_ptr<CompressedAnimationClip>> compressed;
+    for (int c = 0; c < kClips; ++c) {
+        clips.push_back(MakeBakedClip(kBones, 4.0f, c * 0.1f));
+        compressed.push_back(std::make_unique<CompressedAnimationClip>(*clips.back()));
+    }
+
+    PoseBuffer buffer(kBones);
+    Pose pose = buffer.GetPose();
+    std::vector<AnimationClipCursor> cursors(kInstances);
+
+    const auto measure = [&](auto&& sample) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            for (int i = 0; i < kInstances; ++i) {
+                sample(i, frame / 60.0f + i * 0.013f);
+            }
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / kFrames;
+    };
+
+    const double sourceMs = measure([&](int i, float time) {
+        clips[i % kClips]->SamplePose(time, pose);
+    });
+    const double compressedMs = measure([&](int i, float time) {
+        compressed[i % kClips]->SamplePose(time, cursors[i], pose);
+    });
+
+    std::printf("[ BENCH    ] %d instances x %d bones (%d clips): keys %.3f ms/frame, compressed+cursor %.3f ms/frame\n",
+                kInstances, kBones, kClips, sourceMs, compressedMs);
+    RecordProperty("source_ms_x1000", static_cast<int>(sourceMs * 1000.0));
+    RecordProperty("compressed_ms_x1000", static_cast<int>(compressedMs * 1000.0));
+}
+
+} // namespace
@@ -0,0 +1,277 @@
+//----------------------------------------------------------------------------
+//! @file   cpu_skinning_test.cpp
+//! @brief  CpuSkinning（SIMDスキニング）と Physics::SkinnedMeshCollider のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/mesh/cpu_skinning.h"
+#include "engine/physics/skinned_mesh_collider.h"
+#include "engine/core/job_system.h"
+#include "test_helpers.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+using TestHelpers::TestRandom;
+
+uint32_t PackIndices(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    return a | (b << 8) | (c << 16) | (d << 24);
+}
+
+//! @brief ランダムな頂点（ウェイトは合計1、影響ボーン数は1〜4）
+std::vector<SkinnedMeshVertex> MakeVertices(uint32_t count, uint32_t boneCount, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<SkinnedMeshVertex> vertices(count);
+    for (auto& v : vertices) {
+        v.position = Vector3(rng.Range(-1, 1), rng.Range(0, 2), rng.Range(-1, 1));
+        v.normal = Vector3(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1));
+        v.normal.Normalize();
+        v.boneIndices = PackIndices(rng.Next(boneCount), rng.Next(boneCount),
+                                    rng.Next(boneCount), rng.Next(boneCount));
+        float w[4] = {};
+        const uint32_t influences = 1 + rng.Next(4);
+        float total = 0.0f;
+        for (uint32_t k = 0; k < influences; ++k) {
+            w[k] = rng.Range(0.1f, 1.0f);
+            total += w[k];
+        }
+        v.boneWeights = Vector4(w[0] / total, w[1] / total, w[2] / total, w[3] / total);
+    }
+    return vertices;
+}
+
+//! @brief 回転・平行移動・スケールを含むスキニング行列
+std::vector<Matrix> MakeMatrices(uint32_t boneCount, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<Matrix> matrices;
+    for (uint32_t b = 0; b < boneCount; ++b) {
+        matrices.push_back(
+            Matrix::CreateScale(rng.Range(0.8f, 1.2f)) *
+            Matrix::CreateFromQuaternion(Quaternion::CreateFromAxisAngle(
+                Vector3(rng.Range(-1, 1), 1.0f, rng.Range(-1, 1)), rng.Range(-3, 3))) *
+            Matrix::CreateTranslation(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1)));
+    }
+    return matrices;
+}
+
+//! @brief 参照実装（スキンメッシュシェーダーと同じ式をスカラーで）
+void ReferenceSkin(const SkinnedMeshVertex& v, const std::vector<Matrix>& matrices,
+                   Vector3& outPosition, Vector3& outNormal)
+{
+    outPosition = Vector3::Zero;
+    outNormal = Vector3::Zero;
+    const float weights[4] = {v.boneWeights.x, v.boneWeights.y, v.boneWeights.z, v.boneWeights.w};
+    for (int k = 0; k < 4; ++k) {
+        if (weights[k] <= 0.0f) continue;
+        const Matrix& m = matrices[(v.boneIndices >> (k * 8)) & 0xFFu];
+        outPosition += Vector3::Transform(v.position, m) * weights[k];
+        outNormal += Vector3::TransformNormal(v.normal, m) * weights[k];
+    }
+    outNormal.Normalize();
+}
+
+void ExpectVectorNear(const Vector3& a, const Vector3& b, float tolerance, size_t index)
+{
+    EXPECT_NEAR(a.x, b.x, tolerance) << "vertex " << index;
+    EXPECT_NEAR(a.y, b.y, tolerance) << "vertex " << index;
+    EXPECT_NEAR(a.z, b.z, tolerance) << "vertex " << index;
+}
+
+//! @brief 1ボーンに追従する箱（当たり判定用）
+void MakeBox(std::vector<SkinnedMeshVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    const float h = 0.5f;
+    const Vector3 corners[8] = {
+        {-h, -h, -h}, {h, -h, -h}, {h, h, -h}, {-h, h, -h},
+        {-h, -h, h},  {h, -h, h},  {h, h, h},  {-h, h, h},
+    };
+    for (const auto& c : corners) {
+        SkinnedMeshVertex v{};
+        v.position = c;
+        v.normal = c;
+        v.normal.Normalize();
+        v.boneIndices = PackIndices(1, 0, 0, 0);
+        v.boneWeights = Vector4(1, 0, 0, 0);
+        vertices.push_back(v);
+    }
+    indices = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+               3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+}
+
+} // namespace
+
+//============================================================================
+// CpuSkinning
+//============================================================================
+
+TEST(CpuSkinningTest, MatchesShaderReference)
+{
+    // 4の倍数でない頂点数で端数処理も通す
+    constexpr uint32_t kVertices = 1003;
+    constexpr uint32_t kBones = 40;
+    const auto vertices = MakeVertices(kVertices, kBones, 1);
+    const auto matrices = MakeMatrices(kBones, 2);
+
+    std::vector<Vector3> positions(kVertices);
+    std::vector<Vector3> normals(kVertices);
+    CpuSkinning::Skin(vertices, matrices, positions, normals);
+
+    for (size_t i = 0; i < kVertices; ++i) {
+        Vector3 expectedPosition, expectedNormal;
+        ReferenceSkin(vertices[i], matrices, expectedPosition, expectedNormal);
+        ExpectVectorNear(positions[i], expectedPosition, 1e-4f, i);
+        ExpectVectorNear(normals[i], expectedNormal, 1e-4f, i);
+    }
+}
+
+TEST(CpuSkinningTest, PositionsOnlyLeaveNeighboursUntouched)
+{
+    constexpr uint32_t kVertices = 7;
+    const auto vertices = MakeVertices(kVertices, 4, 3);
+    const auto matrices = MakeMatrices(4, 4);
+
+    // 出力が短ければその長さまで。Store4が隣の要素を書き潰さないことも確認する
+    const Vector3 sentinel(123.0f, 456.0f, 789.0f);
+    std::vector<Vector3> positions(kVertices + 1, sentinel);
+    CpuSkinning::Skin(vertices, matrices, std::span<Vector3>(positions.data(), 5));
+
+    for (size_t i = 0; i < 5; ++i) {
+        Vector3 expectedPosition, expectedNormal;
+        ReferenceSkin(vertices[i], matrices, expectedPosition, expectedNormal);
+        ExpectVectorNear(positions[i], expectedPosition, 1e-4f, i);
+    }
+    for (size_t i = 5; i < positions.size(); ++i) {
+        EXPECT_EQ(positions[i], sentinel) << i;
+    }
+}
+
+TEST(CpuSkinningTest, OutOfRangeBoneIndexUsesLastMatrix)
+{
+    std::vector<SkinnedMeshVertex> vertices(4);
+    for (auto& v : vertices) {
+        v.position = Vector3(1, 2, 3);
+        v.normal = Vector3::UnitY;
+        v.boneIndices = PackIndices(200, 0, 0, 0);
+        v.boneWeights = Vector4(1, 0, 0, 0);
+    }
+    const std::vector<Matrix> matrices = {Matrix::Identity, Matrix::CreateTranslation(10, 0, 0)};
+
+    std::vector<Vector3> positions(vertices.size());
+    CpuSkinning::Skin(vertices, matrices, positions);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        ExpectVectorNear(positions[i], Vector3(11, 2, 3), 1e-5f, i);
+    }
+
+    // 行列が空なら何もしない
+    std::vector<Vector3> untouched(vertices.size(), Vector3::Zero);
+    CpuSkinning::Skin(vertices, {}, untouched);
+    EXPECT_EQ(untouched[0], Vector3::Zero);
+}
+
+TEST(CpuSkinningTest, ParallelMatchesSerial)
+{
+    constexpr uint32_t kVertices = CpuSkinning::kMinParallelVertices * 4 + 37;
+    constexpr uint32_t kBones = 64;
+    const auto vertices = MakeVertices(kVertices, kBones, 5);
+    const auto matrices = MakeMatrices(kBones, 6);
+
+    std::vector<Vector3> serialPositions(kVertices), serialNormals(kVertices);
+    CpuSkinning::SkinRange(vertices.data(), 0, kVertices, matrices.data(), kBones,
+                           serialPositions.data(), serialNormals.data());
+
+    JobSystem::Create(4);
+    std::vector<Vector3> positions(kVertices), normals(kVertices);
+    CpuSkinning::Skin(vertices, matrices, positions, normals);
+    JobSystem::Destroy();
+
+    EXPECT_EQ(std::memcmp(positions.data(), serialPositions.data(), sizeof(Vector3) * kVertices), 0);
+    EXPECT_EQ(std::memcmp(normals.data(), serialNormals.data(), sizeof(Vector3) * kVertices), 0);
+}
+
+//============================================================================
+// SkinnedMeshCollider
+//============================================================================
+
+TEST(SkinnedMeshColliderTest, RefitFollowsSkinnedPose)
+{
+    std::vector<SkinnedMeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeBox(vertices, indices);
+    auto hitbox = Physics::SkinnedMeshCollider::Create(vertices, indices, true);
+    ASSERT_EQ(hitbox->GetVertexCount(), vertices.size());
+
+    const Physics::Ray down(Vector3(0, 10, 0), Vector3(0, -1, 0));
+    const Physics::Ray downAtMoved(Vector3(5, 10, 0), Vector3(0, -1, 0));
+    Physics::RaycastHit hit;
+    EXPECT_TRUE(hitbox->GetCollider().Raycast(down, 100.0f, hit));
+    EXPECT_FALSE(hitbox->GetCollider().Raycast(downAtMoved, 100.0f, hit));
+
+    // ボーン1を(5, 1, 0)へ移動
+    const std::vector<Matrix> skinning = {Matrix::Identity, Matrix::CreateTranslation(5, 1, 0)};
+    hitbox->Update(skinning);
+
+    EXPECT_FALSE(hitbox->GetCollider().Raycast(down, 100.0f, hit));
+    ASSERT_TRUE(hitbox->GetCollider().Raycast(downAtMoved, 100.0f, hit));
+    EXPECT_NEAR(hit.distance, 10.0f - 1.5f, 1e-4f);
+
+    const BoundingBox& bounds = hitbox->GetCollider().GetLocalBounds();
+    EXPECT_NEAR(bounds.min.x, 4.5f, 1e-5f);
+    EXPECT_NEAR(bounds.max.y, 1.5f, 1e-5f);
+
+    ASSERT_EQ(hitbox->GetNormals().size(), vertices.size());
+    ExpectVectorNear(hitbox->GetNormals()[6], Vector3(1, 1, 1) / std::sqrt(3.0f), 1e-5f, 6);
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+TEST(CpuSkinningBenchmark, DISABLED_FiftyCharacters)
+{
+    constexpr uint32_t kVertices = 20000;
+    constexpr uint32_t kBones = 60;
+    constexpr int kCharacters = 50;
+    const auto vertices = MakeVertices(kVertices, kBones, 7);
+    const auto matrices = MakeMatrices(kBones, 8);
+    std::vector<Vector3> positions(kVertices), normals(kVertices);
+
+    auto measure = [&](auto&& body) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int c = 0; c < kCharacters; ++c) {
+            body();
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    const double scalarMs = measure([&] {
+        for (uint32_t i = 0; i < kVertices; ++i) {
+            ReferenceSkin(vertices[i], matrices, positions[i], normals[i]);
+        }
+    });
+    const double simdMs = measure([&] {
+        CpuSkinning::Skin(vertices, matrices, positions, normals);
+    });
+
+    JobSystem::Create();
+    const uint32_t threads = JobSystem::Get().GetWorkerCount() + 1;
+    const double parallelMs = measure([&] {
+        CpuSkinning::Skin(vertices, matrices, positions, normals);
+    });
+    JobSystem::Destroy();
+
+    std::printf("[ BENCH    ] %d characters x %u vertices: scalar %.3f ms, SIMD %.3f ms, "
+                "SIMD %u threads %.3f ms\n",
+                kCharacters, kVertices, scalarMs, simdMs, threads, parallelMs);
+    RecordProperty("vertices", static_cast<int>(kVertices * kCharacters));
+    RecordProperty("scalar_ms_x1000", static_cast<int>(scalarMs * 1000.0));
+    RecordProperty("simd_ms_x1000", static_cast<int>(simdMs * 1000.0));
+    RecordProperty("parallel_ms_x1000", static_cast<int>(parallelMs * 1000.0));
+}
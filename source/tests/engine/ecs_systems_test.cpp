@@ -9,6 +9,13 @@
 #include "engine/ecs/system.h"
 #include "engine/ecs/components/transform/transform_components.h"
 #include "engine/ecs/systems/transform/transform_system.h"
+#include "engine/ecs/systems/transform/local_to_world_system.h"
+#include "engine/ecs/systems/rendering/lod_system.h"
+#include "engine/ecs/systems/rendering/render_bounds_update_system.h"
+#include "engine/core/job_system.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 
 namespace
@@ -360,4 +367,266 @@ TEST_F(RenderSystemGraphTest, Clear_RemovesAll)
     EXPECT_EQ(graph_.NodeCount(), 0u);
 }
 
+//============================================================================
+// SystemAccess / 並列実行計画 テスト
+//============================================================================
+struct AccessCompA {};
+struct AccessCompB {};
+
+TEST(SystemAccessTest, ReadersDoNotConflict)
+{
+    ECS::SystemAccess a;
+    ECS::SystemAccess b;
+    a.Read<AccessCompA>();
+    b.Read<AccessCompA, AccessCompB>();
+
+    EXPECT_FALSE(a.ConflictsWith(b));
+    EXPECT_FALSE(b.ConflictsWith(a));
+}
+
+TEST(SystemAccessTest, WriterConflictsWithReaderAndWriter)
+{
+    ECS::SystemAccess reader;
+    ECS::SystemAccess writer;
+    ECS::SystemAccess other;
+    reader.With<ECS::In<AccessCompA>>();
+    writer.With<ECS::InOut<AccessCompA>>();
+    other.Write<AccessCompB>();
+
+    EXPECT_TRUE(reader.ConflictsWith(writer));
+    EXPECT_TRUE(writer.ConflictsWith(writer));
+    EXPECT_FALSE(writer.ConflictsWith(other));
+}
+
+TEST(SystemAccessTest, UndeclaredAndStructuralAreExclusive)
+{
+    ECS::SystemAccess undeclared;
+    ECS::SystemAccess structural;
+    ECS::SystemAccess reader;
+    structural.Structural();
+    reader.Read<AccessCompA>();
+
+    EXPECT_TRUE(undeclared.IsExclusive());
+    EXPECT_TRUE(structural.IsExclusive());
+    EXPECT_FALSE(reader.IsExclusive());
+    EXPECT_TRUE(reader.ConflictsWith(undeclared));
+    EXPECT_TRUE(reader.ConflictsWith(structural));
+}
+
+TEST_F(SystemGraphTest, ExecutionPlan_WriterWaitsForReaders)
+{
+    ECS::SystemId idA = std::type_index(typeid(SystemA));
+    ECS::SystemId idB = std::type_index(typeid(SystemB));
+    ECS::SystemId idC = std::type_index(typeid(SystemC));
+
+    ECS::SystemAccess reader;
+    ECS::SystemAccess writer;
+    reader.Read<AccessCompA>();
+    writer.Write<AccessCompA>();
+
+    graph_.AddNode(idA, 10, {}, {}, "SystemA", reader);
+    graph_.AddNode(idB, 20, {}, {}, "SystemB", reader);
+    graph_.AddNode(idC, 30, {}, {}, "SystemC", writer);
+
+    auto plan = graph_.BuildExecutionPlan();
+    ASSERT_EQ(plan.order.size(), 3u);
+    EXPECT_EQ(plan.order[2], idC);
+
+    // A, Bは同時実行可能、CはA, B両方を待つ
+    EXPECT_EQ(plan.predecessorCount[0], 0u);
+    EXPECT_EQ(plan.predecessorCount[1], 0u);
+    EXPECT_EQ(plan.predecessorCount[2], 2u);
+    EXPECT_FALSE(plan.exclusive[0]);
+    EXPECT_FALSE(plan.exclusive[2]);
+}
+
+TEST_F(SystemGraphTest, ExecutionPlan_ExplicitDependencyWithoutConflict)
+{
+    ECS::SystemId idA = std::type_index(typeid(SystemA));
+    ECS::SystemId idB = std::type_index(typeid(SystemB));
+
+    ECS::SystemAccess accessA;
+    ECS::SystemAccess accessB;
+    accessA.Write<AccessCompA>();
+    accessB.Write<AccessCompB>();
+
+    // アクセスは競合しないがAfter指定は守る
+    graph_.AddNode(idB, 20, {idA}, {}, "SystemB", accessB);
+    graph_.AddNode(idA, 10, {}, {}, "SystemA", accessA);
+
+    auto plan = graph_.BuildExecutionPlan();
+    ASSERT_EQ(plan.order.size(), 2u);
+    EXPECT_EQ(plan.order[0], idA);
+    ASSERT_EQ(plan.successors[0].size(), 1u);
+    EXPECT_EQ(plan.successors[0][0], 1u);
+    EXPECT_EQ(plan.predecessorCount[1], 1u);
+}
+
+TEST_F(SystemGraphTest, ExecutionPlan_UndeclaredSystemIsSyncPoint)
+{
+    ECS::SystemId idA = std::type_index(typeid(SystemA));
+    ECS::SystemId idB = std::type_index(typeid(SystemB));
+    ECS::SystemId idC = std::type_index(typeid(SystemC));
+
+    ECS::SystemAccess reader;
+    reader.Read<AccessCompA>();
+
+    graph_.AddNode(idA, 10, {}, {}, "SystemA", reader);
+    graph_.AddNode(idB, 20, {}, {}, "SystemB");  // アクセス未宣言
+    graph_.AddNode(idC, 30, {}, {}, "SystemC", reader);
+
+    auto plan = graph_.BuildExecutionPlan();
+    ASSERT_EQ(plan.order.size(), 3u);
+    EXPECT_TRUE(plan.exclusive[1]);
+
+    // 同期点を跨ぐ辺は張られない（同期点自体が順序を保証する）
+    EXPECT_TRUE(plan.successors[0].empty());
+    EXPECT_EQ(plan.predecessorCount[2], 0u);
+}
+
+//============================================================================
+// 並列System実行テスト（JobSystem統合）
+//============================================================================
+static std::atomic<uint32_t> g_readersStarted{0};
+static std::atomic<bool> g_readersOverlapped{false};
+static std::atomic<uint32_t> g_readersFinished{0};
+static std::atomic<bool> g_writerSawReaders{false};
+static std::atomic<bool> g_structuralOnMainThread{false};
+
+//! 他方の読み取りSystemが開始するまで待つ（同時実行されなければタイムアウト）
+static void WaitForOtherReader()
+{
+    g_readersStarted.fetch_add(1);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (g_readersStarted.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    if (g_readersStarted.load() >= 2) {
+        g_readersOverlapped = true;
+    }
+    g_readersFinished.fetch_add(1);
+}
+
+class ParallelReaderSystemA final : public ECS::ISystem {
+public:
+    void OnUpdate(ECS::World&, float) override { WaitForOtherReader(); }
+    int Priority() const override { return 10; }
+    const char* Name() const override { return "ParallelReaderSystemA"; }
+};
+
+class ParallelReaderSystemB final : public ECS::ISystem {
+public:
+    void OnUpdate(ECS::World&, float) override { WaitForOtherReader(); }
+    int Priority() const override { return 20; }
+    const char* Name() const override { return "ParallelReaderSystemB"; }
+};
+
+class ParallelWriterSystem final : public ECS::ISystem {
+public:
+    void OnUpdate(ECS::World&, float) override { g_writerSawReaders = (g_readersFinished.load() == 2); }
+    int Priority() const override { return 30; }
+    const char* Name() const override { return "ParallelWriterSystem"; }
+};
+
+class StructuralSystem final : public ECS::ISystem {
+public:
+    void OnUpdate(ECS::World&, float) override { g_structuralOnMainThread = JobSystem::Get().IsMainThread(); }
+    int Priority() const override { return 0; }
+    const char* Name() const override { return "StructuralSystem"; }
+};
+
+class ParallelSystemUpdateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        JobSystem::Create(2);
+        g_readersStarted = 0;
+        g_readersOverlapped = false;
+        g_readersFinished = 0;
+        g_writerSawReaders = false;
+        g_structuralOnMainThread = false;
+    }
+
+    void TearDown() override {
+        JobSystem::Destroy();
+    }
+};
+
+TEST_F(ParallelSystemUpdateTest, NonConflictingSystemsRunConcurrently)
+{
+    ECS::World world;
+    world.RegisterSystemWithDeps<ParallelReaderSystemA>().Reads<AccessCompA>();
+    world.RegisterSystemWithDeps<ParallelReaderSystemB>().WithAccess<ECS::In<AccessCompA>>();
+    world.RegisterSystemWithDeps<ParallelWriterSystem>().Writes<AccessCompA>();
+    world.RegisterSystemWithDeps<StructuralSystem>().WithStructuralChanges();
+
+    world.FixedUpdate(1.0f / 60.0f);
+
+    EXPECT_TRUE(g_readersOverlapped);
+    EXPECT_TRUE(g_writerSawReaders);
+    EXPECT_TRUE(g_structuralOnMainThread);
+}
+
+TEST_F(ParallelSystemUpdateTest, ParallelDisabledRunsInPriorityOrder)
+{
+    g_priorityOrder.clear();
+
+    ECS::World world;
+    world.SetParallelSystemUpdate(false);
+    world.RegisterSystemWithDeps<SystemC>().Reads<AccessCompA>();
+    world.RegisterSystemWithDeps<SystemA>().Reads<AccessCompA>();
+    world.RegisterSystemWithDeps<SystemB>().Reads<AccessCompA>();
+
+    world.FixedUpdate(1.0f / 60.0f);
+
+    // 並列無効時は計画順（優先度順）に逐次実行
+    ASSERT_EQ(g_priorityOrder.size(), 3u);
+    EXPECT_EQ(g_priorityOrder[0], 1);
+    EXPECT_EQ(g_priorityOrder[1], 2);
+    EXPECT_EQ(g_priorityOrder[2], 3);
+}
+
+TEST_F(ParallelSystemUpdateTest, EngineSystemsDeclaringAccessShareBatch)
+{
+    ECS::World world;
+    world.RegisterSystem<ECS::LocalToWorldSystem>();
+    world.RegisterSystem<ECS::LODSystem>();
+    world.RegisterSystem<ECS::RenderBoundsUpdateSystem>();
+
+    ECS::Actor camera = world.CreateActor();
+    world.AddComponent<ECS::Camera3DData>(camera, 60.0f, 16.0f / 9.0f);
+    world.AddComponent<ECS::ActiveCameraTag>(camera);
+    world.GetComponent<ECS::Camera3DData>(camera)->position = Vector3::Zero;
+
+    // 100mの位置、Medium範囲=50-200m
+    ECS::Actor mesh = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(mesh, Vector3(100.0f, 0.0f, 0.0f));
+    world.AddComponent<ECS::LocalToWorld>(mesh);
+    world.AddComponent<ECS::MeshData>(mesh);
+    world.AddComponent<ECS::LODRangeData>(mesh, ECS::LODRangeData::Medium());
+    world.AddComponent<ECS::RenderBoundsData>(mesh, ECS::RenderBoundsData::UnitCube());
+    world.AddComponent<ECS::WorldRenderBoundsData>(mesh);
+    world.GetComponent<ECS::MeshData>(mesh)->visible = false;
+
+    world.FixedUpdate(1.0f / 60.0f);
+
+    // 全Systemが宣言済みで同期点にならない。
+    // LODとAABB更新はLocalToWorldだけを待ち、互いには待たない（同じバッチで並走する）
+    const ECS::SystemExecutor& executor = world.GetSystemExecutor();
+    ASSERT_EQ(executor.GetSystemCount(), 3u);
+    for (size_t i = 0; i < executor.GetSystemCount(); ++i) {
+        ECS::ISystem* system = executor.GetSystem(i);
+        EXPECT_FALSE(executor.IsExclusive(i)) << system->Name();
+        if (system == world.GetSystem<ECS::LocalToWorldSystem>()) {
+            EXPECT_EQ(executor.GetPredecessorCount(i), 0u);
+        } else {
+            EXPECT_EQ(executor.GetPredecessorCount(i), 1u) << system->Name();
+        }
+    }
+
+    EXPECT_TRUE(world.GetComponent<ECS::MeshData>(mesh)->visible);
+    const auto* bounds = world.GetComponent<ECS::WorldRenderBoundsData>(mesh);
+    EXPECT_NEAR(bounds->minPoint.x, 99.5f, 1e-4f);
+    EXPECT_NEAR(bounds->maxPoint.x, 100.5f, 1e-4f);
+}
+
 } // namespace
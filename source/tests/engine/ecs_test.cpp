@@ -15,6 +15,7 @@
 #include "engine/ecs/entity_command_buffer.h"
 #include <vector>
 #include <atomic>
+#include <thread>
 
 namespace
 {
@@ -890,6 +891,187 @@ TEST_F(ArchetypeStorageTest, EmptyArchetypeDoesNotCollideWithComponentArchetypes
     EXPECT_EQ(world_.GetComponent<VelocityData>(empty), nullptr);
 }
 
+TEST_F(ArchetypeStorageTest, ComponentTypeIdIsStablePerType)
+{
+    const ECS::ComponentTypeId posId = ECS::ComponentTypeRegistry::Get<PositionData>();
+    const ECS::ComponentTypeId velId = ECS::ComponentTypeRegistry::Get<VelocityData>();
+
+    EXPECT_NE(posId, velId);
+    EXPECT_EQ(ECS::ComponentTypeRegistry::Get<PositionData>(), posId);
+    EXPECT_EQ(ECS::ComponentTypeRegistry::Get<const PositionData>(), posId);
+    EXPECT_EQ(ECS::ComponentTypeRegistry::Find(std::type_index(typeid(PositionData))), posId);
+    EXPECT_LT(posId, ECS::ComponentTypeRegistry::GetCount());
+
+    // 一度も参照されていない型は検索で登録されない
+    struct NeverRegisteredData {};
+    EXPECT_EQ(ECS::ComponentTypeRegistry::Find(std::type_index(typeid(NeverRegisteredData))),
+              ECS::kInvalidComponentTypeId);
+}
+
+//! @brief 登録テスト用の型（番号ごとに別の型）
+template<int N>
+struct RegistryTagData {};
+
+template<int... Ns>
+std::vector<std::type_index> RegistryTagTypes(std::integer_sequence<int, Ns...>)
+{
+    return { std::type_index(typeid(RegistryTagData<Ns>))... };
+}
+
+TEST_F(ArchetypeStorageTest, ComponentTypeLookupSeesConcurrentRegistrations)
+{
+    // 登録と検索を並行させても、登録済みの型は常に同じIDで見つかる
+    const ECS::ComponentTypeId posId = ECS::ComponentTypeRegistry::Get<PositionData>();
+    const std::vector<std::type_index> types = RegistryTagTypes(std::make_integer_sequence<int, 64>());
+
+    std::vector<ECS::ComponentTypeId> registered(types.size(), ECS::kInvalidComponentTypeId);
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> mismatches{0};
+
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            if (ECS::ComponentTypeRegistry::Find(std::type_index(typeid(PositionData))) != posId) {
+                mismatches.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (size_t i = 0; i < types.size(); ++i) {
+        registered[i] = ECS::ComponentTypeRegistry::GetOrRegister(types[i]);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    for (size_t i = 0; i < types.size(); ++i) {
+        EXPECT_EQ(ECS::ComponentTypeRegistry::Find(types[i]), registered[i]);
+        EXPECT_EQ(ECS::ComponentTypeRegistry::GetOrRegister(types[i]), registered[i]);
+    }
+}
+
+TEST_F(ArchetypeStorageTest, ColumnLookupByTypeIdMatchesComponentOrder)
+{
+    ECS::ArchetypeStorage& storage = world_.GetArchetypeStorage();
+    ECS::Archetype* arch = storage.GetOrCreate<PositionData, VelocityData, HealthData>();
+    ASSERT_NE(arch, nullptr);
+
+    const auto& components = arch->GetComponents();
+    for (size_t i = 0; i < components.size(); ++i) {
+        EXPECT_EQ(arch->GetComponentIndexById(components[i].typeId), i);
+        EXPECT_EQ(arch->GetComponentIndex(components[i].type), i);
+    }
+    EXPECT_EQ(arch->GetComponentInfo<VelocityData>(), &components[arch->GetComponentIndex<VelocityData>()]);
+
+    EXPECT_TRUE(arch->HasComponent<HealthData>());
+    EXPECT_FALSE(arch->HasComponent<ColorData>());
+    EXPECT_EQ(arch->GetComponentIndex<ColorData>(), SIZE_MAX);
+    EXPECT_EQ(arch->GetComponentInfo<ColorData>(), nullptr);
+    EXPECT_EQ(arch->GetComponentIndexById(ECS::kInvalidComponentTypeId), SIZE_MAX);
+}
+
+TEST(ArchetypeLayoutTest, MixedAlignmentLayoutFitsInChunk)
+{
+    // 1Actorあたりのサイズから求めた容量（455）では、配列間のアラインメント詰め物でChunkを超える構成
+    struct Aligned4Data { float v; };
+    struct Aligned8Data { double d; };
+    struct alignas(16) Aligned16Data { float v[4]; };
+
+    ECS::Archetype arch({
+        ECS::ComponentInfo(typeid(AlphaData), sizeof(AlphaData), alignof(AlphaData)),
+        ECS::ComponentInfo(typeid(Aligned8Data), sizeof(Aligned8Data), alignof(Aligned8Data)),
+        ECS::ComponentInfo(typeid(Aligned4Data), sizeof(Aligned4Data), alignof(Aligned4Data)),
+        ECS::ComponentInfo(typeid(Aligned16Data), sizeof(Aligned16Data), alignof(Aligned16Data)),
+    });
+
+    const size_t capacity = arch.GetChunkCapacity();
+    ASSERT_GT(capacity, 0u);
+    EXPECT_GE(arch.GetComponentDataOffset(), capacity * sizeof(ECS::Actor));
+
+    size_t end = arch.GetComponentDataOffset();
+    for (const auto& info : arch.GetComponents()) {
+        EXPECT_EQ(info.offset % info.alignment, 0u);
+        EXPECT_GE(info.offset, end);
+        end = info.offset + info.size * capacity;
+    }
+    EXPECT_LE(end, ECS::Chunk::kSize);
+}
+
+TEST_F(ArchetypeStorageTest, SignatureMatchingHonorsRequiredAndExclude)
+{
+    ECS::ArchetypeStorage& storage = world_.GetArchetypeStorage();
+    ECS::Archetype* pos = storage.GetOrCreate<PositionData>();
+    ECS::Archetype* posVel = storage.GetOrCreate<PositionData, VelocityData>();
+    ECS::Archetype* posVelHealth = storage.GetOrCreate<PositionData, VelocityData, HealthData>();
+    ECS::Archetype* vel = storage.GetOrCreate<VelocityData>();
+
+    std::vector<ECS::Archetype*> matched;
+    storage.ForEachMatching<PositionData, VelocityData>([&](ECS::Archetype& arch) {
+        matched.push_back(&arch);
+    });
+    EXPECT_EQ(matched.size(), 2u);
+    EXPECT_NE(std::find(matched.begin(), matched.end(), posVel), matched.end());
+    EXPECT_NE(std::find(matched.begin(), matched.end(), posVelHealth), matched.end());
+
+    matched.clear();
+    storage.ForEachMatchingFiltered<PositionData, ECS::Exclude<HealthData>>([&](ECS::Archetype& arch) {
+        matched.push_back(&arch);
+    });
+    EXPECT_EQ(matched.size(), 2u);
+    EXPECT_NE(std::find(matched.begin(), matched.end(), pos), matched.end());
+    EXPECT_NE(std::find(matched.begin(), matched.end(), posVel), matched.end());
+    EXPECT_EQ(std::find(matched.begin(), matched.end(), vel), matched.end());
+}
+
+TEST_F(ArchetypeStorageTest, QueryCacheAppendsNewArchetypesWithoutRebuild)
+{
+    ECS::ArchetypeStorage& storage = world_.GetArchetypeStorage();
+    ECS::QueryCache& cache = storage.GetQueryCache();
+    storage.GetOrCreate<PositionData>();
+    cache.ResetStats();
+
+    const std::vector<ECS::Archetype*>& matching = storage.GetMatchingArchetypes<PositionData>();
+    const size_t initialCount = matching.size();
+    EXPECT_EQ(cache.GetStats().missCount, 1u);
+
+    // マッチするArchetypeは作成時に追加される
+    ECS::Archetype* posHealth = storage.GetOrCreate<PositionData, HealthData>();
+    ASSERT_EQ(matching.size(), initialCount + 1);
+    EXPECT_EQ(matching.back(), posHealth);
+
+    // マッチしないArchetypeは照合のみ
+    storage.GetOrCreate<VelocityData, HealthData>();
+    EXPECT_EQ(matching.size(), initialCount + 1);
+
+    // 再取得は再構築されずヒットする
+    EXPECT_EQ(&storage.GetMatchingArchetypes<PositionData>(), &matching);
+
+    const ECS::QueryCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.missCount, 1u);
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_EQ(stats.appendCount, 1u);
+    EXPECT_EQ(stats.archetypeTestCount, 2u * stats.entryCount);
+}
+
+TEST_F(ArchetypeStorageTest, CachedQuerySeesArchetypesCreatedAfterFirstUse)
+{
+    auto query = world_.CreateCachedQuery<PositionData>();
+
+    ECS::Actor a = world_.CreateActor();
+    world_.AddComponent<PositionData>(a);
+    EXPECT_EQ(query.Count(), 1u);
+    EXPECT_TRUE(query.IsCacheValid());
+
+    // 新しいArchetype（Position + Velocity）を作成してもキャッシュは有効なまま追従する
+    ECS::Actor b = world_.CreateActor();
+    world_.AddComponent<PositionData>(b);
+    world_.AddComponent<VelocityData>(b);
+    EXPECT_TRUE(query.IsCacheValid());
+    EXPECT_EQ(query.Count(), 2u);
+
+    int visited = 0;
+    query.ForEach([&visited](ECS::Actor, PositionData&) { ++visited; });
+    EXPECT_EQ(visited, 2);
+}
+
 //============================================================================
 // Deferred操作 テスト
 //============================================================================
@@ -3413,6 +3595,158 @@ TEST_F(ChangeTrackingTest, GetComponentVersion_ReturnsCorrectVersion)
     });
 }
 
+TEST_F(ChangeTrackingTest, Changed_SkipsChunksUnchangedSinceLastRun)
+{
+    ECS::Actor actor = world_.CreateActor();
+    world_.AddComponent<PositionData>(actor, 1.0f, 2.0f, 3.0f);
+    world_.AddComponent<VelocityData>(actor);
+
+    ECS::SystemState state;
+    ECS::SystemAPI::SetCurrentState(&state);
+
+    auto countChanged = [this] {
+        int count = 0;
+        world_.ForEach<ECS::Changed<ECS::In<PositionData>>, ECS::InOut<VelocityData>>(
+            [&count](ECS::Actor, const PositionData& p, VelocityData& v) {
+                v.vx = p.x;
+                ++count;
+            });
+        return count;
+    };
+
+    // 未実行（lastRunVersion=0）は全て変更扱い
+    world_.BeginFrame();  // v1
+    EXPECT_EQ(countChanged(), 1);
+
+    // 前回実行（v1）以降に書き込みがなければスキップされる
+    state.lastRunVersion = 1;
+    world_.BeginFrame();  // v2
+    EXPECT_EQ(countChanged(), 0);
+
+    // 書き込み後は処理される
+    world_.ForEach<ECS::InOut<PositionData>>([](ECS::Actor, PositionData& p) { p.x = 5.0f; });
+    EXPECT_EQ(countChanged(), 1);
+    EXPECT_FLOAT_EQ(world_.GetComponent<VelocityData>(actor)->vx, 5.0f);
+
+    ECS::SystemAPI::SetCurrentState(nullptr);
+}
+
+TEST_F(ChangeTrackingTest, TypedQuery_PassesSoAComponentsAndMarksWrites)
+{
+    std::vector<ECS::Actor> actors;
+    for (int i = 0; i < 4; ++i) {
+        ECS::Actor actor = world_.CreateActor();
+        world_.AddComponent<PositionData>(actor, static_cast<float>(i), 0.0f, 0.0f);
+        world_.AddComponent<VelocityData>(actor, static_cast<float>(i * 10), 0.0f, 0.0f);
+        actors.push_back(actor);
+    }
+
+    world_.BeginFrame();  // v1
+    world_.BeginFrame();  // v2
+    world_.Actors().Query<ECS::In<VelocityData>, ECS::InOut<PositionData>>()
+        .ForEach([](ECS::Actor, const VelocityData& v, PositionData& p) {
+            p.y = p.x + v.vx;
+        });
+
+    const ECS::World& constWorld = world_;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FLOAT_EQ(constWorld.GetComponent<PositionData>(actors[i])->y, static_cast<float>(i * 11));
+    }
+
+    // InOutのみバージョンが更新される
+    size_t positionChanged = world_.Query<PositionData>().WithChangeFilter<PositionData>(1).Count();
+    size_t velocityChanged = world_.Query<VelocityData>().WithChangeFilter<VelocityData>(1).Count();
+    EXPECT_EQ(positionChanged, 4u);
+    EXPECT_EQ(velocityChanged, 0u);
+
+    // Changed + Since: 基準以降に変更のないChunkはスキップ
+    int count = 0;
+    world_.Actors().Query<ECS::Changed<ECS::In<VelocityData>>>().Since(2)
+        .ForEach([&count](ECS::Actor, const VelocityData&) { ++count; });
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(ChangeTrackingTest, CachedQuery_ChangedFilterUsesLastRunVersion)
+{
+    ECS::Actor actor = world_.CreateActor();
+    world_.AddComponent<PositionData>(actor, 3.0f, 0.0f, 0.0f);
+    world_.AddComponent<VelocityData>(actor);
+
+    auto query = world_.CreateCachedQuery<ECS::Changed<PositionData>, VelocityData>();
+    ECS::SystemState state;
+    ECS::SystemAPI::SetCurrentState(&state);
+
+    int count = 0;
+    auto run = [&] {
+        query.ForEach([&count](ECS::Actor, const PositionData& p, VelocityData& v) {
+            v.vx = p.x;
+            ++count;
+        });
+    };
+
+    world_.BeginFrame();  // v1
+    run();
+    EXPECT_EQ(count, 1);
+    EXPECT_FLOAT_EQ(world_.GetComponent<VelocityData>(actor)->vx, 3.0f);
+
+    world_.BeginFrame();  // v2
+    world_.BeginFrame();  // v3
+    state.lastRunVersion = 2;
+    run();
+    EXPECT_EQ(count, 1);
+
+    ECS::SystemAPI::SetCurrentState(nullptr);
+}
+
+//! Changed<In<PositionData>>で処理したActor数を数えるSystem
+class ChangedPositionCounterSystem final : public ECS::ISystem {
+public:
+    void OnUpdate(ECS::World& world, float) override {
+        processed = 0;
+        world.ForEach<ECS::Changed<ECS::In<PositionData>>>(
+            [this](ECS::Actor, const PositionData&) { ++processed; });
+    }
+    const char* Name() const override { return "ChangedPositionCounterSystem"; }
+
+    int processed = 0;
+};
+
+TEST_F(ChangeTrackingTest, SystemState_TracksLastRunVersionPerSystem)
+{
+    ECS::Actor actor = world_.CreateActor();
+    world_.AddComponent<PositionData>(actor, 1.0f, 2.0f, 3.0f);
+
+    ECS::SystemExecutor executor;
+    ECS::SystemGraph graph;
+    graph.AddNode(typeid(ChangedPositionCounterSystem), 0, {}, {}, "Counter");
+    ChangedPositionCounterSystem system;
+    executor.Build(graph.BuildExecutionPlan(), [&system](ECS::SystemId) -> ECS::ISystem* { return &system; });
+
+    auto step = [&] {
+        world_.BeginFrame();
+        executor.Execute(world_, 0.016f);
+    };
+
+    // 初回は全て処理、以降は書き込みがなければスキップ
+    step();
+    EXPECT_EQ(system.processed, 1);
+    step();
+    EXPECT_EQ(system.processed, 0);
+
+    // 書き込んだフレームと次のフレームで処理される
+    world_.BeginFrame();
+    world_.GetComponent<PositionData>(actor)->x = 10.0f;
+    executor.Execute(world_, 0.016f);
+    EXPECT_EQ(system.processed, 1);
+    step();
+    EXPECT_EQ(system.processed, 1);
+    step();
+    EXPECT_EQ(system.processed, 0);
+
+    // System外ではSystemStateが設定されていない
+    EXPECT_FALSE(ECS::SystemAPI::HasCurrentState());
+}
+
 //============================================================================
 // Tag Component テスト
 //============================================================================
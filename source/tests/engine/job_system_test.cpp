@@ -1,9 +1,14 @@
 //----------------------------------------------------------------------------
 //! @file   job_system_test.cpp
-//! @brief  JobSystem関連クラスのテスト（CancelToken, JobCounter, JobHandle, JobDesc）
+//! @brief  JobSystem関連クラスのテスト（CancelToken, JobCounter, JobHandle, JobDesc, WorkStealingDeque, InlineFunction）
 //----------------------------------------------------------------------------
 #include <gtest/gtest.h>
 #include "engine/core/job_system.h"
+#include "engine/core/work_stealing_deque.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
 #include <thread>
 
 namespace
@@ -198,6 +203,58 @@ TEST(JobCounterTest, SetResultToException)
     EXPECT_EQ(counter.GetResult(), JobResult::Exception);
 }
 
+TEST(JobCounterTest, DecrementAtZeroStaysZero)
+{
+    JobCounter counter;
+    counter.Decrement();
+    EXPECT_EQ(counter.GetCount(), 0u);
+}
+
+TEST(JobCounterTest, ErrorResultIsNotOverwritten)
+{
+    JobCounter counter;
+    counter.SetResult(JobResult::Exception);
+    counter.SetResult(JobResult::Success);
+    EXPECT_EQ(counter.GetResult(), JobResult::Exception);
+}
+
+TEST(JobCounterTest, ConcurrentDecrementReachesZero)
+{
+    constexpr uint32_t kThreads = 4;
+    constexpr uint32_t kPerThread = 10000;
+    JobCounter counter(kThreads * kPerThread);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&counter] {
+            for (uint32_t i = 0; i < kPerThread; ++i) {
+                counter.Decrement();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(counter.IsComplete());
+}
+
+TEST(JobCounterTest, WaitBlocksUntilOtherThreadCompletes)
+{
+    // JobSystemなし: アトミック待機でブロックする
+    JobCounter counter(1);
+    std::atomic<bool> released{false};
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        released = true;
+        counter.Decrement();
+    });
+
+    counter.Wait();
+    EXPECT_TRUE(released.load());
+    releaser.join();
+}
+
 //============================================================================
 // JobHandle テスト
 //============================================================================
@@ -389,4 +446,628 @@ TEST(JobDescDependencyTest, AddMultipleInvalidDependencies)
     SUCCEED();
 }
 
+//============================================================================
+// WorkStealingDeque テスト
+//============================================================================
+TEST(WorkStealingDequeTest, EmptyPopAndStealFail)
+{
+    WorkStealingDeque<int*> deque;
+    int* item = nullptr;
+    EXPECT_FALSE(deque.Pop(item));
+    EXPECT_FALSE(deque.Steal(item));
+    EXPECT_TRUE(deque.IsEmptyApprox());
+}
+
+TEST(WorkStealingDequeTest, PopIsLifo)
+{
+    int values[3] = {};
+    WorkStealingDeque<int*> deque;
+    deque.Push(&values[0]);
+    deque.Push(&values[1]);
+    deque.Push(&values[2]);
+
+    int* item = nullptr;
+    ASSERT_TRUE(deque.Pop(item));
+    EXPECT_EQ(item, &values[2]);
+    ASSERT_TRUE(deque.Pop(item));
+    EXPECT_EQ(item, &values[1]);
+}
+
+TEST(WorkStealingDequeTest, StealIsFifo)
+{
+    int values[3] = {};
+    WorkStealingDeque<int*> deque;
+    deque.Push(&values[0]);
+    deque.Push(&values[1]);
+    deque.Push(&values[2]);
+
+    int* item = nullptr;
+    ASSERT_TRUE(deque.Steal(item));
+    EXPECT_EQ(item, &values[0]);
+    ASSERT_TRUE(deque.Steal(item));
+    EXPECT_EQ(item, &values[1]);
+    EXPECT_EQ(deque.SizeApprox(), 1);
+}
+
+TEST(WorkStealingDequeTest, GrowsBeyondInitialCapacity)
+{
+    WorkStealingDeque<uintptr_t> deque(4);
+    for (uintptr_t i = 1; i <= 100; ++i) {
+        deque.Push(i);
+    }
+    EXPECT_EQ(deque.SizeApprox(), 100);
+
+    uintptr_t item = 0;
+    for (uintptr_t i = 100; i >= 1; --i) {
+        ASSERT_TRUE(deque.Pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(deque.Pop(item));
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealTakesEachItemOnce)
+{
+    constexpr uintptr_t kItemCount = 100000;
+    constexpr int kThieves = 3;
+
+    WorkStealingDeque<uintptr_t> deque(64);
+    std::atomic<uint64_t> stolenSum{0};
+    std::atomic<uint32_t> stolenCount{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t) {
+        thieves.emplace_back([&] {
+            uintptr_t item = 0;
+            while (!done.load(std::memory_order_acquire) || !deque.IsEmptyApprox()) {
+                if (deque.Steal(item)) {
+                    stolenSum.fetch_add(item, std::memory_order_relaxed);
+                    stolenCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // 所有スレッドはPushしつつ時々Popする
+    uint64_t poppedSum = 0;
+    uint32_t poppedCount = 0;
+    for (uintptr_t i = 1; i <= kItemCount; ++i) {
+        deque.Push(i);
+        uintptr_t item = 0;
+        if ((i % 3) == 0 && deque.Pop(item)) {
+            poppedSum += item;
+            ++poppedCount;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    constexpr uint64_t kExpectedSum = kItemCount * (kItemCount + 1) / 2;
+    EXPECT_EQ(poppedCount + stolenCount.load(), kItemCount);
+    EXPECT_EQ(poppedSum + stolenSum.load(), kExpectedSum);
+}
+
+//============================================================================
+// InlineFunction テスト
+//============================================================================
+TEST(InlineFunctionTest, DefaultIsEmpty)
+{
+    JobFunction func;
+    EXPECT_FALSE(func);
+    EXPECT_TRUE(func.IsInline());
+}
+
+TEST(InlineFunctionTest, SmallCaptureIsStoredInline)
+{
+    int value = 0;
+    JobFunction func([&value] { value = 42; });
+    EXPECT_TRUE(func);
+    EXPECT_TRUE(func.IsInline());
+    func();
+    EXPECT_EQ(value, 42);
+}
+
+TEST(InlineFunctionTest, LargeCaptureFallsBackToHeap)
+{
+    std::array<uint8_t, JobFunction::kInlineSize + 1> payload{};
+    payload[0] = 7;
+    int result = 0;
+    JobFunction func([payload, &result] { result = payload[0]; });
+    EXPECT_FALSE(func.IsInline());
+    func();
+    EXPECT_EQ(result, 7);
+}
+
+TEST(InlineFunctionTest, CopyAndMovePreserveCallable)
+{
+    auto shared = std::make_shared<int>(0);
+    JobFunction original([shared] { ++*shared; });
+
+    JobFunction copy(original);
+    JobFunction moved(std::move(copy));
+    EXPECT_FALSE(copy);
+    original();
+    moved();
+    EXPECT_EQ(*shared, 2);
+
+    // キャプチャの寿命が正しく管理されている
+    EXPECT_EQ(shared.use_count(), 3);
+    moved = nullptr;
+    EXPECT_EQ(shared.use_count(), 2);
+}
+
+TEST(InlineFunctionTest, PassesArguments)
+{
+    CancelToken token;
+    token.Cancel();
+    bool observed = false;
+    CancellableJobFunction func([&observed](const CancelToken& ct) { observed = ct.IsCancelled(); });
+    func(token);
+    EXPECT_TRUE(observed);
+}
+
+//============================================================================
+// JobSystem 実行テスト
+//============================================================================
+class JobSystemExecutionTest : public ::testing::Test {
+protected:
+    void SetUp() override { JobSystem::Create(4); }
+    void TearDown() override { JobSystem::Destroy(); }
+};
+
+TEST_F(JobSystemExecutionTest, SubmittedJobsAllRun)
+{
+    constexpr int kJobCount = 1000;
+    std::atomic<int> executed{0};
+
+    std::vector<JobHandle> handles;
+    handles.reserve(kJobCount);
+    for (int i = 0; i < kJobCount; ++i) {
+        handles.push_back(JobSystem::Get().SubmitJob(JobDesc([&executed] { ++executed; })));
+    }
+    for (const auto& handle : handles) {
+        handle.Wait();
+        EXPECT_TRUE(handle.IsSuccess());
+    }
+    EXPECT_EQ(executed.load(), kJobCount);
+}
+
+TEST_F(JobSystemExecutionTest, JobsSubmittedFromWorkersRun)
+{
+    constexpr uint32_t kOuter = 16;
+    static constexpr uint32_t kInner = 64;
+    std::atomic<uint32_t> executed{0};
+    auto counter = std::make_shared<JobCounter>(kOuter * kInner);
+
+    auto outer = JobSystem::Get().ParallelFor(0, kOuter, [&executed, counter](uint32_t) {
+        // ワーカーのローカルデックに積まれ、他ワーカーにStealされる
+        for (uint32_t i = 0; i < kInner; ++i) {
+            JobSystem::Get().Submit([&executed, counter] {
+                ++executed;
+                counter->Decrement();
+            });
+        }
+    }, 1);
+    outer.Wait();
+    counter->Wait();
+
+    EXPECT_EQ(executed.load(), kOuter * kInner);
+}
+
+TEST_F(JobSystemExecutionTest, NestedWaitInsideWorkersDoesNotDeadlock)
+{
+    // 全ワーカーが内側のParallelForを待つ状況: 待機中にジョブを実行しないとデッドロックする
+    constexpr uint32_t kOuter = 32;
+    static constexpr uint32_t kInner = 64;
+    std::atomic<uint32_t> executed{0};
+
+    auto outer = JobSystem::Get().ParallelFor(0, kOuter, [&executed](uint32_t) {
+        auto inner = JobSystem::Get().ParallelFor(0, kInner, [&executed](uint32_t) { ++executed; }, 1);
+        inner.Wait();
+        EXPECT_TRUE(inner.IsComplete());
+    }, 1);
+    outer.Wait();
+
+    EXPECT_EQ(executed.load(), kOuter * kInner);
+}
+
+TEST_F(JobSystemExecutionTest, WaitOnLowPriorityJobWhileAllThreadsWait)
+{
+    // 全スレッド（ワーカー＋メイン）がジョブ内でLow優先度ジョブを待つ状況:
+    // 待機中にLowを実行しないと、自分のデックに積んだジョブが誰にも実行されない
+    const uint32_t threads = JobSystem::Get().GetWorkerCount() + 1;
+    std::atomic<uint32_t> started{0};
+    std::atomic<uint32_t> executed{0};
+
+    auto outer = JobSystem::Get().ParallelFor(0, threads, [&](uint32_t) {
+        started.fetch_add(1);
+        while (started.load() < threads) {
+            std::this_thread::yield();
+        }
+        auto low = JobSystem::Get().SubmitJob(JobDesc::LowPriority([&executed] { ++executed; }));
+        low.Wait();
+        EXPECT_TRUE(low.IsSuccess());
+    }, 1);
+    outer.Wait();
+
+    EXPECT_EQ(executed.load(), threads);
+}
+
+TEST_F(JobSystemExecutionTest, WaitAllWaitsForRunningJobs)
+{
+    constexpr int kJobCount = 64;
+    std::atomic<int> finished{0};
+
+    for (int i = 0; i < kJobCount; ++i) {
+        JobSystem::Get().Submit([&finished] {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            ++finished;
+        });
+    }
+    JobSystem::Get().WaitAll();
+
+    EXPECT_EQ(finished.load(), kJobCount);
+    EXPECT_EQ(JobSystem::Get().GetPendingJobCount(), 0u);
+}
+
+TEST_F(JobSystemExecutionTest, WaitOnMainThreadJobFromMainThread)
+{
+    bool executed = false;
+    auto handle = JobSystem::Get().SubmitJob(JobDesc::MainThread([&executed] { executed = true; }));
+    handle.Wait();  // 待機中にメインスレッドジョブを処理する
+    EXPECT_TRUE(executed);
+}
+
+TEST_F(JobSystemExecutionTest, TemplateParallelForRangeCoversRange)
+{
+    constexpr uint32_t kCount = 1000;
+    std::vector<std::atomic<uint32_t>> hits(kCount);
+
+    auto handle = JobSystem::Get().ParallelForRange(0, kCount, [&hits](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    }, 7);
+    handle.Wait();
+
+    for (uint32_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(hits[i].load(), 1u) << "index " << i;
+    }
+}
+
+TEST_F(JobSystemExecutionTest, TemplateParallelForReleasesBody)
+{
+    auto shared = std::make_shared<int>(0);
+    std::atomic<uint32_t> executed{0};
+    {
+        auto handle = JobSystem::Get().ParallelFor(0, 100, [shared, &executed](uint32_t) { ++executed; });
+        handle.Wait();
+    }
+    JobSystem::Get().WaitAll();
+    EXPECT_EQ(executed.load(), 100u);
+    // 全スライス完了後にファンクタが破棄されている
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST_F(JobSystemExecutionTest, DynamicPartitionCoversRangeOnce)
+{
+    constexpr uint32_t kCount = 5000;
+    std::vector<std::atomic<uint32_t>> hits(kCount);
+
+    auto handle = JobSystem::Get().ParallelFor(10, kCount, [&hits](uint32_t i) {
+        hits[i].fetch_add(1, std::memory_order_relaxed);
+    }, ParallelForDesc().SetPartition(ParallelForPartition::Dynamic));
+    handle.Wait();
+
+    for (uint32_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(hits[i].load(), i < 10 ? 0u : 1u) << "index " << i;
+    }
+}
+
+TEST_F(JobSystemExecutionTest, CostHintBalancesSlicesByCost)
+{
+    // 先頭の要素だけ極端に重い: コスト均等化すると重い要素は単独スライスになる
+    constexpr uint32_t kCount = 64;
+    std::vector<uint32_t> costs(kCount, 1);
+    costs[0] = 1000;
+
+    std::mutex mutex;
+    std::vector<std::pair<uint32_t, uint32_t>> slices;
+    auto handle = JobSystem::Get().ParallelForRange(0, kCount, [&](uint32_t begin, uint32_t end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slices.emplace_back(begin, end);
+    }, ParallelForDesc().SetItemCosts(costs).SetGranularity(16));
+    handle.Wait();
+
+    std::sort(slices.begin(), slices.end());
+    ASSERT_FALSE(slices.empty());
+    EXPECT_EQ(slices.front(), std::make_pair(0u, 1u));
+    uint32_t covered = 0;
+    for (const auto& [begin, end] : slices) {
+        EXPECT_EQ(begin, covered);
+        EXPECT_LE(end - begin, 16u);
+        covered = end;
+    }
+    EXPECT_EQ(covered, kCount);
+}
+
+TEST_F(JobSystemExecutionTest, DynamicPartitionWithCostHint)
+{
+    constexpr uint32_t kCount = 300;
+    std::vector<uint32_t> costs(kCount);
+    for (uint32_t i = 0; i < kCount; ++i) {
+        costs[i] = (i % 10 == 9) ? 3 : 128;  // 部分的に埋まったChunkを模擬
+    }
+    std::atomic<uint64_t> processedCost{0};
+
+    auto handle = JobSystem::Get().ParallelForRange(0, kCount, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            processedCost.fetch_add(costs[i], std::memory_order_relaxed);
+        }
+    }, ParallelForDesc().SetPartition(ParallelForPartition::Dynamic).SetItemCosts(costs));
+    handle.Wait();
+
+    uint64_t expected = 0;
+    for (uint32_t cost : costs) expected += cost;
+    EXPECT_EQ(processedCost.load(), expected);
+}
+
+TEST_F(JobSystemExecutionTest, AllPrioritiesRun)
+{
+    std::atomic<int> executed{0};
+    auto high = JobSystem::Get().SubmitJob(JobDesc::HighPriority([&executed] { ++executed; }));
+    auto normal = JobSystem::Get().SubmitJob(JobDesc([&executed] { ++executed; }));
+    auto low = JobSystem::Get().SubmitJob(JobDesc::LowPriority([&executed] { ++executed; }));
+    high.Wait();
+    normal.Wait();
+    low.Wait();
+    EXPECT_EQ(executed.load(), 3);
+}
+
+TEST_F(JobSystemExecutionTest, DependencyRunsAfterPredecessor)
+{
+    std::atomic<int> order{0};
+    int firstOrder = -1;
+    int secondOrder = -1;
+
+    auto first = JobSystem::Get().SubmitJob(JobDesc([&] { firstOrder = order++; }));
+    auto second = JobSystem::Get().SubmitJob(JobDesc::After(first, [&] { secondOrder = order++; }));
+    second.Wait();
+
+    EXPECT_EQ(firstOrder, 0);
+    EXPECT_EQ(secondOrder, 1);
+}
+
+TEST_F(JobSystemExecutionTest, SubmitFromExternalThreadRuns)
+{
+    std::atomic<int> executed{0};
+    JobHandle handle;
+    std::thread external([&] {
+        handle = JobSystem::Get().SubmitJob(JobDesc([&executed] { ++executed; }));
+    });
+    external.join();
+    handle.Wait();
+    EXPECT_EQ(executed.load(), 1);
+}
+
+//============================================================================
+// JobSystem ヒープ確保テスト
+//
+// JobSystem::GetHeapAllocationCount() で投入経路のヒープ確保を数える
+// （全ビルド構成で有効）。
+//============================================================================
+class JobSystemAllocationTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t kJobCount = 10000;
+
+    void SetUp() override { JobSystem::Create(); }
+    void TearDown() override { JobSystem::Destroy(); }
+
+    //! @brief ジョブを同時に滞留させ、プール・デックを計測時の需要以上に成長させる
+    //! @note 各スレッドのローカルキャッシュに残るブロック分も見込んで多めに確保する
+    static void WarmUp()
+    {
+        const uint32_t warmUpJobs = kJobCount + 512 * (JobSystem::Get().GetWorkerCount() + 1);
+        std::atomic<bool> release{false};
+        auto gate = [&release] {
+            while (!release.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        };
+
+        std::vector<JobHandle> handles;
+        handles.reserve(warmUpJobs * 2);
+        for (uint32_t i = 0; i < warmUpJobs; ++i) {
+            handles.push_back(JobSystem::Get().SubmitJob(JobDesc(gate)));
+            handles.push_back(JobSystem::Get().ParallelForRange(0, 1, [&gate](uint32_t, uint32_t) { gate(); }, 1));
+        }
+        release.store(true, std::memory_order_release);
+        for (const auto& handle : handles) {
+            handle.Wait();
+        }
+        JobSystem::Get().WaitAll();
+    }
+};
+
+TEST_F(JobSystemAllocationTest, SubmittedJobsDoNotAllocate)
+{
+    // 定常状態ではジョブ・カウンターがプールから再利用され、ヒープ確保しない
+    WarmUp();
+
+    std::atomic<uint32_t> executed{0};
+    std::vector<JobHandle> handles;
+    handles.reserve(kJobCount);
+
+    const uint64_t before = JobSystem::GetHeapAllocationCount();
+    for (uint32_t i = 0; i < kJobCount; ++i) {
+        handles.push_back(JobSystem::Get().SubmitJob(JobDesc([&executed] { ++executed; })));
+    }
+    for (const auto& handle : handles) {
+        handle.Wait();
+    }
+    const uint64_t allocations = JobSystem::GetHeapAllocationCount() - before;
+
+    EXPECT_EQ(executed.load(), kJobCount);
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST_F(JobSystemAllocationTest, ParallelForRangeDoesNotAllocate)
+{
+    // 本体・スライスジョブ・カウンターはすべてプールから確保される
+    WarmUp();
+
+    constexpr uint32_t kCalls = 1000;
+    constexpr uint32_t kSlices = 64;
+    std::atomic<uint32_t> executed{0};
+    auto body = [&executed](uint32_t begin, uint32_t end) {
+        executed.fetch_add(end - begin, std::memory_order_relaxed);
+    };
+
+    const uint64_t before = JobSystem::GetHeapAllocationCount();
+    for (uint32_t i = 0; i < kCalls; ++i) {
+        JobSystem::Get().ParallelForRange(0, kSlices, body, 1).Wait();
+    }
+    const uint64_t allocations = JobSystem::GetHeapAllocationCount() - before;
+
+    EXPECT_EQ(executed.load(), kCalls * kSlices);
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST_F(JobSystemAllocationTest, OversizedCaptureIsCounted)
+{
+    // インラインストレージを超えるキャプチャはヒープ確保として数える
+    std::array<uint8_t, 128> payload{};
+    std::atomic<uint32_t> sum{0};
+
+    const uint64_t before = JobSystem::GetHeapAllocationCount();
+    JobSystem::Get().SubmitJob(JobDesc([payload, &sum] { sum += payload.size(); })).Wait();
+
+    EXPECT_EQ(sum.load(), 128u);
+    EXPECT_GE(JobSystem::GetHeapAllocationCount() - before, 1u);
+}
+
+TEST_F(JobSystemAllocationTest, DependencyListGrowthIsCounted)
+{
+    auto first = JobSystem::Get().SubmitJob(JobDesc([] {}));
+
+    const uint64_t before = JobSystem::GetHeapAllocationCount();
+    JobDesc desc([] {});
+    desc.AddDependency(first);
+    const uint64_t allocations = JobSystem::GetHeapAllocationCount() - before;
+
+    JobSystem::Get().SubmitJob(std::move(desc)).Wait();
+    EXPECT_EQ(allocations, 1u);
+}
+
+TEST_F(JobSystemAllocationTest, OversizedParallelBodyIsCounted)
+{
+    // プールのブロックに収まらない本体はヒープ確保として数える
+    std::array<uint8_t, 512> payload{};
+    std::atomic<uint32_t> executed{0};
+
+    const uint64_t before = JobSystem::GetHeapAllocationCount();
+    JobSystem::Get().ParallelForRange(0, 4, [payload, &executed](uint32_t begin, uint32_t end) {
+        executed.fetch_add((end - begin) * (payload[0] + 1), std::memory_order_relaxed);
+    }, 1).Wait();
+
+    EXPECT_EQ(executed.load(), 4u);
+    EXPECT_GE(JobSystem::GetHeapAllocationCount() - before, 1u);
+}
+
+//============================================================================
+// JobSystem 競合マイクロベンチマーク
+//
+// 大量の極小ジョブを投入してスケジューラ自体のオーバーヘッドを測る。
+// 結果は標準出力とテストプロパティに記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class JobSystemContentionBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override { JobSystem::Create(); }
+    void TearDown() override { JobSystem::Destroy(); }
+
+    void Report(const char* label, uint32_t jobCount, std::chrono::steady_clock::duration elapsed)
+    {
+        const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+        const double jobsPerSec = ms > 0.0 ? jobCount / (ms / 1000.0) : 0.0;
+        std::printf("[ BENCH    ] %s: %u jobs, %.3f ms, %.0f jobs/s (workers=%u)\n",
+                    label, jobCount, ms, jobsPerSec, JobSystem::Get().GetWorkerCount());
+        RecordProperty(label, static_cast<int>(jobsPerSec));
+    }
+};
+
+TEST_F(JobSystemContentionBenchmark, DISABLED_ParallelForRangeFineGrained)
+{
+    // World::ParallelForEachが1チャンク1スライスで投入する状況を模擬
+    constexpr uint32_t kSlices = 20000;
+    std::atomic<uint32_t> executed{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto handle = JobSystem::Get().ParallelForRange(0, kSlices,
+        [&executed](uint32_t begin, uint32_t end) {
+            executed.fetch_add(end - begin, std::memory_order_relaxed);
+        }, 1);
+    handle.Wait();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(executed.load(), kSlices);
+    Report("ParallelForRangeFineGrained", kSlices, elapsed);
+}
+
+TEST_F(JobSystemContentionBenchmark, DISABLED_UnevenWorkloadStaticVsDynamic)
+{
+    // 要素コストが大きく偏るループ（重いArchetypeと部分的なChunkの混在を模擬）
+    constexpr uint32_t kCount = 2048;
+    std::vector<uint32_t> costs(kCount);
+    for (uint32_t i = 0; i < kCount; ++i) {
+        costs[i] = (i < kCount / 8) ? 64 : 1;
+    }
+    auto spin = [&costs](uint32_t begin, uint32_t end) {
+        volatile uint32_t sink = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            for (uint32_t k = 0; k < costs[i] * 200; ++k) {
+                sink = sink + k;
+            }
+        }
+    };
+
+    auto measure = [&](const ParallelForDesc& desc) {
+        const auto start = std::chrono::steady_clock::now();
+        JobSystem::Get().ParallelForRange(0, kCount, spin, desc).Wait();
+        return std::chrono::steady_clock::now() - start;
+    };
+
+    Report("UnevenStatic", kCount, measure(ParallelForDesc()));
+    Report("UnevenDynamic", kCount, measure(ParallelForDesc().SetPartition(ParallelForPartition::Dynamic)));
+    Report("UnevenDynamicCostHint", kCount,
+           measure(ParallelForDesc().SetPartition(ParallelForPartition::Dynamic).SetItemCosts(costs)));
+}
+
+TEST_F(JobSystemContentionBenchmark, DISABLED_NestedSubmitFromAllWorkers)
+{
+    // 全ワーカーが同時に投入する状況（旧実装ではグローバルロックで直列化していた）
+    const uint32_t outerCount = std::max(1u, JobSystem::Get().GetWorkerCount()) * 4;
+    static constexpr uint32_t kInnerCount = 2000;
+    std::atomic<uint32_t> executed{0};
+    auto counter = std::make_shared<JobCounter>(outerCount * kInnerCount);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto handle = JobSystem::Get().ParallelFor(0, outerCount, [&executed, counter](uint32_t) {
+        for (uint32_t i = 0; i < kInnerCount; ++i) {
+            JobSystem::Get().Submit([&executed, counter] {
+                executed.fetch_add(1, std::memory_order_relaxed);
+                counter->Decrement();
+            });
+        }
+    }, 1);
+    handle.Wait();
+    counter->Wait();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(executed.load(), outerCount * kInnerCount);
+    Report("NestedSubmitFromAllWorkers", outerCount * kInnerCount, elapsed);
+}
+
 } // namespace
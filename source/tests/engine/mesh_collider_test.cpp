@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+//! @file   mesh_collider_test.cpp
+//! @brief  Physics::MeshCollider の変形（リフィットと再構築）のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/physics/mesh_collider.h"
+#include "physics_test_helpers.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using namespace Physics;
+using TestHelpers::MakeGridMesh;
+using TestHelpers::TestRandom;
+
+//! @brief 全三角形を総当たりで判定（基準）
+bool BruteForceRaycast(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices,
+                       const Ray& ray, float maxDistance, float& outT)
+{
+    bool hit = false;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        float t;
+        if (RayTriangleIntersect(ray, positions[indices[i]], positions[indices[i + 1]],
+                                 positions[indices[i + 2]], maxDistance, t)) {
+            maxDistance = t;
+            outT = t;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+void ExpectRaycastsMatch(const MeshCollider& collider, const std::vector<Vector3>& positions,
+                         const std::vector<uint32_t>& indices, uint32_t seed)
+{
+    TestRandom rng(seed);
+    for (int r = 0; r < 100; ++r) {
+        const Ray ray(Vector3(rng.Range(0, 40), 30.0f, rng.Range(0, 40)),
+                      Vector3(rng.Range(-0.3f, 0.3f), -1.0f, rng.Range(-0.3f, 0.3f)));
+        float expectedT = 0.0f;
+        const bool expected = BruteForceRaycast(positions, indices, ray, 100.0f, expectedT);
+        RaycastHit hit;
+        ASSERT_EQ(collider.Raycast(ray, 100.0f, hit), expected) << r;
+        if (expected) {
+            EXPECT_NEAR(hit.distance, expectedT, 1e-3f) << r;
+        }
+    }
+}
+
+} // namespace
+
+TEST(MeshColliderTest, RefitFollowsDeformedVertices)
+{
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    MakeGridMesh(40, positions, indices);
+    auto collider = MeshCollider::Create(positions, indices);
+
+    // 持ち上げて波打たせる（移動床・変形メッシュ相当）
+    for (Vector3& p : positions) {
+        p.y = 5.0f + std::sin(p.x * 0.4f) * std::cos(p.z * 0.3f);
+    }
+    collider->Refit(positions);
+
+    EXPECT_FALSE(collider->IsRebuildPending());
+    EXPECT_NEAR(collider->GetLocalBounds().min.y, 4.0f, 0.05f);
+    EXPECT_NEAR(collider->GetWorldBounds().max.y, 6.0f, 0.05f);
+    ExpectRaycastsMatch(*collider, positions, indices, 3);
+
+    // 頂点数が違う入力は無視する
+    collider->Refit(std::vector<Vector3>(positions.size() - 1));
+    ExpectRaycastsMatch(*collider, positions, indices, 4);
+}
+
+TEST(MeshColliderTest, DegradedRefitRebuildsSynchronouslyWithoutJobSystem)
+{
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    MakeGridMesh(40, positions, indices);
+    auto collider = MeshCollider::Create(positions, indices);
+
+    // 左右を入れ替えると分割が合わなくなる
+    for (Vector3& p : positions) {
+        p.x = p.x < 20.0f ? p.x + 20.0f : p.x - 20.0f;
+    }
+    collider->Refit(positions);
+
+    EXPECT_FALSE(collider->IsRebuildPending());
+    EXPECT_NEAR(collider->GetBVH().GetSahDegradation(), 1.0f, 1e-3f);
+    ExpectRaycastsMatch(*collider, positions, indices, 5);
+}
+
+TEST(MeshColliderTest, DegradedRefitSwapsInBackgroundRebuild)
+{
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    MakeGridMesh(40, positions, indices);
+
+    JobSystem::Create(2);
+    auto collider = MeshCollider::Create(positions, indices);
+
+    for (Vector3& p : positions) {
+        p.x = p.x < 20.0f ? p.x + 20.0f : p.x - 20.0f;
+    }
+    collider->Refit(positions);
+    ASSERT_TRUE(collider->IsRebuildPending());
+    EXPECT_GT(collider->GetBVH().GetSahDegradation(), MeshCollider::kRebuildSahRatio);
+
+    // 再構築中もリフィットした木で正しく判定できる
+    ExpectRaycastsMatch(*collider, positions, indices, 6);
+
+    // 完成した木は次のリフィットで差し替わる
+    for (int frame = 0; frame < 1000 && collider->IsRebuildPending(); ++frame) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        collider->Refit(positions);
+    }
+    EXPECT_FALSE(collider->IsRebuildPending());
+    EXPECT_NEAR(collider->GetBVH().GetSahDegradation(), 1.0f, 1e-3f);
+    ExpectRaycastsMatch(*collider, positions, indices, 7);
+
+    // 再構築中にコライダーを破棄しても、ジョブは共有した結果にだけ書き込む
+    for (Vector3& p : positions) {
+        p.x = 40.0f - p.x;
+    }
+    collider->Refit(positions);
+    collider.reset();
+    JobSystem::Destroy();
+}
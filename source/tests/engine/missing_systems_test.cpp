@@ -10,6 +10,7 @@
 #include "engine/ecs/systems/physics/physics_system.h"
 #include "engine/ecs/systems/rendering/render_bounds_update_system.h"
 #include "engine/ecs/systems/rendering/lod_system.h"
+#include "engine/ecs/systems/rendering/frustum_culling_system.h"
 #include "engine/ecs/components/common/lifetime_data.h"
 #include "engine/ecs/components/common/entity_tags.h"
 #include "engine/ecs/components/camera/camera2d_data.h"
@@ -19,6 +20,10 @@
 #include "engine/ecs/components/physics/physics_components.h"
 #include "engine/ecs/components/rendering/render_components.h"
 #include "engine/ecs/components/transform/transform_components.h"
+#include "engine/core/job_system.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
 
 namespace
 {
@@ -361,6 +366,193 @@ TEST_F(PhysicsSystemTest, AngularDampingReducesAngularVelocity)
     EXPECT_LT(angVel->value.x, 10.0f);
 }
 
+//----------------------------------------------------------------------------
+// 融合カーネル: Archetypeの組み合わせと端数をスカラー基準と比較
+//----------------------------------------------------------------------------
+class PhysicsSystemFusedTest : public ::testing::Test {
+protected:
+    //! @brief 検証対象のActorと期待値
+    struct Expected {
+        ECS::Actor actor;
+        Vector3 velocity;
+        Vector3 angularVelocity;
+    };
+
+    //! @brief 組み合わせごとのフラグ
+    struct Layout {
+        bool velocity, mass, gravityFactor, damping, massOverride, angular;
+    };
+
+    static constexpr Layout kLayouts[] = {
+        { true,  true,  false, false, false, false },   // 重力のみ
+        { true,  true,  true,  false, false, false },   // 重力スケール
+        { true,  true,  true,  true,  true,  true  },   // 全部入り
+        { true,  true,  false, false, true,  false },   // キネマティック
+        { true,  false, false, true,  false, false },   // 減衰のみ（質量なし）
+        { true,  false, false, false, true,  false },   // 速度ゼロ化のみ
+        { true,  false, false, false, false, false },   // 対象外（変化なし）
+        { false, false, false, true,  false, true  },   // 角速度の減衰のみ
+    };
+
+    //! @brief テスト用の決定的な乱数
+    float Random(float lo, float hi) {
+        state_ = state_ * 1664525u + 1013904223u;
+        return lo + (hi - lo) * static_cast<float>(state_ >> 8) / static_cast<float>(1u << 24);
+    }
+
+    //! @brief 旧実装（パスごとの処理）と同じ意味のスカラー計算
+    static void Reference(const Layout& layout, const Vector3& gravity, float dt, float gravityFactor,
+                          const ECS::PhysicsDampingData& damping, const ECS::PhysicsMassOverrideData& massOverride,
+                          Vector3& velocity, Vector3& angularVelocity) {
+        if (layout.velocity) {
+            if (layout.mass && !(layout.massOverride && massOverride.IsKinematic())) {
+                velocity += gravity * (layout.gravityFactor ? gravityFactor : 1.0f) * dt;
+            }
+            if (layout.damping) {
+                velocity = damping.ApplyLinear(velocity, dt);
+            }
+            if (layout.massOverride && massOverride.ShouldSetVelocityToZero()) {
+                velocity = Vector3::Zero;
+            }
+        }
+        if (layout.angular && layout.damping) {
+            angularVelocity = damping.ApplyAngular(angularVelocity, dt);
+        }
+    }
+
+    //! @brief 各組み合わせでActorを生成し、期待値を記録
+    std::vector<Expected> Populate(ECS::World& world, int actorsPerLayout, float dt) {
+        std::vector<Expected> expected;
+        const Vector3 gravity(0.0f, -9.81f, 0.0f);
+        for (const Layout& layout : kLayouts) {
+            for (int i = 0; i < actorsPerLayout; ++i) {
+                const ECS::Actor actor = world.CreateActor();
+                Vector3 velocity(Random(-5, 5), Random(-5, 5), Random(-5, 5));
+                Vector3 angularVelocity(Random(-3, 3), Random(-3, 3), Random(-3, 3));
+                const float gravityFactor = Random(-1, 2);
+                const ECS::PhysicsDampingData damping(Random(0, 0.9f), Random(0, 0.9f));
+                const ECS::PhysicsMassOverrideData massOverride(Random(0, 1) < 0.5f, Random(0, 1) < 0.3f);
+
+                if (layout.velocity) world.AddComponent<ECS::VelocityData>(actor, velocity);
+                if (layout.angular) world.AddComponent<ECS::AngularVelocityData>(actor, angularVelocity);
+                if (layout.mass) world.AddComponent<ECS::PhysicsMassData>(actor, ECS::PhysicsMassData::CreateDynamic(1.0f));
+                if (layout.gravityFactor) world.AddComponent<ECS::PhysicsGravityFactorData>(actor, gravityFactor);
+                if (layout.damping) world.AddComponent<ECS::PhysicsDampingData>(actor, damping);
+                if (layout.massOverride) world.AddComponent<ECS::PhysicsMassOverrideData>(actor, massOverride);
+
+                Reference(layout, gravity, dt, gravityFactor, damping, massOverride, velocity, angularVelocity);
+                expected.push_back({ actor, velocity, angularVelocity });
+            }
+        }
+        return expected;
+    }
+
+    static void ExpectMatches(ECS::World& world, const std::vector<Expected>& expected) {
+        for (const Expected& e : expected) {
+            if (auto* vel = world.GetComponent<ECS::VelocityData>(e.actor)) {
+                EXPECT_NEAR(vel->value.x, e.velocity.x, 1e-5f);
+                EXPECT_NEAR(vel->value.y, e.velocity.y, 1e-5f);
+                EXPECT_NEAR(vel->value.z, e.velocity.z, 1e-5f);
+            }
+            if (auto* angVel = world.GetComponent<ECS::AngularVelocityData>(e.actor)) {
+                EXPECT_NEAR(angVel->value.x, e.angularVelocity.x, 1e-5f);
+                EXPECT_NEAR(angVel->value.y, e.angularVelocity.y, 1e-5f);
+                EXPECT_NEAR(angVel->value.z, e.angularVelocity.z, 1e-5f);
+            }
+        }
+    }
+
+    uint32_t state_ = 12345u;
+};
+
+TEST_F(PhysicsSystemFusedTest, MixedArchetypesMatchScalarReference)
+{
+    // 4体単位の端数（1〜3体）も含める
+    for (int actorsPerLayout : { 1, 3, 4, 7, 37 }) {
+        ECS::World world;
+        world.RegisterSystem<ECS::PhysicsSystem>();
+        const auto expected = Populate(world, actorsPerLayout, 0.05f);
+        world.FixedUpdate(0.05f);
+        ExpectMatches(world, expected);
+    }
+}
+
+TEST_F(PhysicsSystemFusedTest, ParallelChunksMatchScalarReference)
+{
+    JobSystem::Create(2);
+    {
+        ECS::World world;
+        world.RegisterSystem<ECS::PhysicsSystem>();
+        const auto expected = Populate(world, 3001, 0.016f);
+        world.FixedUpdate(0.016f);
+        ExpectMatches(world, expected);
+    }
+    JobSystem::Destroy();
+}
+
+TEST_F(PhysicsSystemFusedTest, KinematicWithGravityFactorGetsNoGravity)
+{
+    ECS::World world;
+    world.RegisterSystem<ECS::PhysicsSystem>();
+    ECS::Actor actor = world.CreateActor();
+    world.AddComponent<ECS::VelocityData>(actor, Vector3(1.0f, 2.0f, 3.0f));
+    world.AddComponent<ECS::PhysicsMassData>(actor, ECS::PhysicsMassData::CreateDynamic(1.0f));
+    world.AddComponent<ECS::PhysicsGravityFactorData>(actor, ECS::PhysicsGravityFactorData::Heavy());
+    world.AddComponent<ECS::PhysicsMassOverrideData>(actor, ECS::PhysicsMassOverrideData::Kinematic());
+
+    world.FixedUpdate(1.0f);
+
+    // 打ち消し方式ではなく最初から加えないため、誤差なく元の値のまま
+    auto* vel = world.GetComponent<ECS::VelocityData>(actor);
+    ASSERT_NE(vel, nullptr);
+    EXPECT_EQ(vel->value.x, 1.0f);
+    EXPECT_EQ(vel->value.y, 2.0f);
+    EXPECT_EQ(vel->value.z, 3.0f);
+}
+
+//----------------------------------------------------------------------------
+// ベンチマーク: 移動Actorの積分スループット
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//----------------------------------------------------------------------------
+TEST(PhysicsSystemBenchmark, DISABLED_FusedIntegration)
+{
+    constexpr int kActorCount = 200000;
+    constexpr int kFrames = 50;
+
+    ECS::World world;
+    world.RegisterSystem<ECS::PhysicsSystem>();
+    for (int i = 0; i < kActorCount; ++i) {
+        const ECS::Actor actor = world.CreateActor();
+        world.AddComponent<ECS::VelocityData>(actor, Vector3(1.0f, 0.0f, 0.0f));
+        world.AddComponent<ECS::PhysicsMassData>(actor, ECS::PhysicsMassData::CreateDynamic(1.0f));
+        world.AddComponent<ECS::PhysicsDampingData>(actor, ECS::PhysicsDampingData::Air());
+        if (i % 4 == 0) {
+            world.AddComponent<ECS::PhysicsGravityFactorData>(actor, ECS::PhysicsGravityFactorData::Light());
+        }
+    }
+
+    const auto measure = [&world]() {
+        world.FixedUpdate(0.016f);
+        const auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            world.FixedUpdate(0.016f);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(elapsed).count() / kFrames;
+    };
+
+    const double serialMs = measure();
+    JobSystem::Create();
+    const double parallelMs = measure();
+    const uint32_t workers = JobSystem::Get().GetWorkerCount();
+    JobSystem::Destroy();
+
+    std::printf("[ BENCH    ] PhysicsSystem: %d actors, serial %.3f ms/frame, parallel %.3f ms/frame (workers=%u)\n",
+                kActorCount, serialMs, parallelMs, workers);
+    RecordProperty("SerialUs", static_cast<int>(serialMs * 1000.0));
+    RecordProperty("ParallelUs", static_cast<int>(parallelMs * 1000.0));
+}
+
 //============================================================================
 // RenderBoundsUpdateSystem テスト
 //============================================================================
@@ -434,6 +626,159 @@ TEST_F(RenderBoundsUpdateSystemTest, ScaleExpandsBounds)
     EXPECT_NEAR(worldBounds->maxPoint.z, 1.0f, 0.001f);
 }
 
+TEST_F(RenderBoundsUpdateSystemTest, SkipsChunksWithUnchangedInputs)
+{
+    ECS::Actor actor = world_->CreateActor();
+    world_->AddComponent<ECS::RenderBoundsData>(actor, ECS::RenderBoundsData::UnitCube());
+    world_->AddComponent<ECS::LocalToWorld>(actor)->value = Matrix::Identity;
+    auto* worldBounds = world_->AddComponent<ECS::WorldRenderBoundsData>(actor);
+
+    for (int i = 0; i < 2; ++i) {
+        world_->BeginFrame();
+        world_->FixedUpdate(0.016f);
+    }
+    EXPECT_NEAR(worldBounds->minPoint.x, -0.5f, 0.001f);
+
+    // 入力が変わらなければ再計算されない（直接書き換えた出力が残る）
+    world_->BeginFrame();
+    worldBounds->minPoint.x = 123.0f;
+    world_->FixedUpdate(0.016f);
+    EXPECT_NEAR(worldBounds->minPoint.x, 123.0f, 0.001f);
+
+    // LocalToWorldを書き換えると再計算される
+    world_->BeginFrame();
+    world_->GetComponent<ECS::LocalToWorld>(actor)->value = Matrix::CreateTranslation(10.0f, 0.0f, 0.0f);
+    world_->FixedUpdate(0.016f);
+    EXPECT_NEAR(worldBounds->minPoint.x, 9.5f, 0.001f);
+}
+
+//============================================================================
+// FrustumCullingSystem テスト
+//============================================================================
+class FrustumCullingSystemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        world_ = std::make_unique<ECS::World>();
+        world_->RegisterRenderSystem<ECS::FrustumCullingSystem>();
+
+        // 原点から+Z方向を向くアクティブカメラ
+        ECS::Actor camera = world_->CreateActor();
+        world_->AddComponent<ECS::Camera3DData>(camera, 60.0f, 1.0f, 0.1f, 100.0f);
+        world_->AddComponent<ECS::ActiveCameraTag>(camera);
+    }
+
+    void TearDown() override {
+        world_.reset();
+    }
+
+    ECS::Actor CreateMesh(const Vector3& center) {
+        ECS::Actor actor = world_->CreateActor();
+        world_->AddComponent<ECS::LocalToWorld>(actor);
+        world_->AddComponent<ECS::MeshData>(actor);
+        world_->AddComponent<ECS::WorldRenderBoundsData>(actor,
+            ECS::WorldRenderBoundsData::FromCenterExtents(center, Vector3(0.5f)));
+        return actor;
+    }
+
+    bool IsActorVisible(ECS::Actor actor) {
+        const auto* culling = world_->GetRenderSystem<ECS::FrustumCullingSystem>();
+        const ECS::ActorRecord& rec = world_->GetActorRecord(actor);
+        const uint64_t* mask = culling->GetVisibilityMask(*rec.archetype, rec.chunkIndex);
+        return ECS::FrustumCullingSystem::IsVisible(mask, rec.indexInChunk);
+    }
+
+    std::unique_ptr<ECS::World> world_;
+};
+
+TEST_F(FrustumCullingSystemTest, SimdKernelMatchesScalarTest)
+{
+    ECS::Camera3DData cam(60.0f, 1.0f, 0.1f, 100.0f);
+    const ECS::FrustumPlanes planes = ECS::FrustumPlanes::FromViewProjection(cam.GetViewProjectionMatrix());
+
+    // SIMD幅で割り切れない要素数で、内側・外側・交差が混在する配置
+    std::vector<ECS::WorldRenderBoundsData> bounds;
+    for (int i = 0; i < 77; ++i) {
+        const float x = static_cast<float>((i * 37) % 61) - 30.0f;
+        const float z = static_cast<float>((i * 53) % 131) - 15.0f;
+        bounds.push_back(ECS::WorldRenderBoundsData::FromCenterExtents(Vector3(x, 0.0f, z), Vector3(1.0f)));
+    }
+
+    uint64_t mask[2] = {};
+    const uint32_t visible = ECS::Culling::CullBounds(bounds.data(), 77, planes, mask);
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < 77; ++i) {
+        const bool scalar = ECS::Culling::IsVisible(bounds[i], planes);
+        EXPECT_EQ(ECS::FrustumCullingSystem::IsVisible(mask, i), scalar) << "index " << i;
+        expected += scalar ? 1u : 0u;
+    }
+    EXPECT_EQ(visible, expected);
+    EXPECT_GT(visible, 0u);
+    EXPECT_LT(visible, 77u);
+    EXPECT_EQ(mask[1] >> (77 - 64), 0u);  // 要素数を超えるビットは立たない
+}
+
+TEST_F(FrustumCullingSystemTest, ClassifyDistinguishesInsideIntersectOutside)
+{
+    ECS::Camera3DData cam(60.0f, 1.0f, 0.1f, 100.0f);
+    const ECS::FrustumPlanes planes = ECS::FrustumPlanes::FromViewProjection(cam.GetViewProjectionMatrix());
+
+    const auto box = [](float x, float z) {
+        return ECS::WorldRenderBoundsData::FromCenterExtents(Vector3(x, 0.0f, z), Vector3(1.0f));
+    };
+    EXPECT_EQ(ECS::Culling::Classify(box(0.0f, 10.0f), planes), ECS::FrustumTest::Inside);
+    EXPECT_EQ(ECS::Culling::Classify(box(0.0f, 100.0f), planes), ECS::FrustumTest::Intersect);
+    EXPECT_EQ(ECS::Culling::Classify(box(0.0f, -10.0f), planes), ECS::FrustumTest::Outside);
+    EXPECT_EQ(ECS::Culling::Classify(box(50.0f, 10.0f), planes), ECS::FrustumTest::Outside);
+}
+
+TEST_F(FrustumCullingSystemTest, MasksActorsOutsideCameraFrustum)
+{
+    ECS::Actor front = CreateMesh(Vector3(0.0f, 0.0f, 10.0f));
+    ECS::Actor behind = CreateMesh(Vector3(0.0f, 0.0f, -10.0f));
+    ECS::Actor side = CreateMesh(Vector3(50.0f, 0.0f, 10.0f));
+
+    world_->Render(0.0f);
+
+    EXPECT_TRUE(IsActorVisible(front));
+    EXPECT_FALSE(IsActorVisible(behind));
+    EXPECT_FALSE(IsActorVisible(side));
+
+    const auto& stats = world_->GetRenderSystem<ECS::FrustumCullingSystem>()->GetStats();
+    EXPECT_EQ(stats.testedCount, 3u);
+    EXPECT_EQ(stats.visibleCount, 1u);
+}
+
+TEST_F(FrustumCullingSystemTest, RejectsWholeChunkOutsideFrustum)
+{
+    ECS::Actor first = CreateMesh(Vector3(0.0f, 0.0f, -10.0f));
+    CreateMesh(Vector3(5.0f, 0.0f, -20.0f));
+
+    world_->Render(0.0f);
+
+    const auto* culling = world_->GetRenderSystem<ECS::FrustumCullingSystem>();
+    const ECS::ActorRecord& rec = world_->GetActorRecord(first);
+    EXPECT_FALSE(culling->AnyVisible(*rec.archetype, rec.chunkIndex));
+    EXPECT_EQ(culling->GetStats().rejectedChunks, 1u);
+    EXPECT_EQ(culling->GetStats().visibleCount, 0u);
+}
+
+TEST_F(FrustumCullingSystemTest, RecomputesChunkBoundsWhenBoundsChange)
+{
+    ECS::Actor actor = CreateMesh(Vector3(0.0f, 0.0f, -10.0f));
+
+    world_->BeginFrame();
+    world_->Render(0.0f);
+    EXPECT_FALSE(IsActorVisible(actor));
+
+    // バウンズを視錐台内に移動すると次の判定で可視になる
+    world_->BeginFrame();
+    *world_->GetComponent<ECS::WorldRenderBoundsData>(actor) =
+        ECS::WorldRenderBoundsData::FromCenterExtents(Vector3(0.0f, 0.0f, 10.0f), Vector3(0.5f));
+    world_->Render(0.0f);
+    EXPECT_TRUE(IsActorVisible(actor));
+}
+
 //============================================================================
 // LODSystem テスト
 //============================================================================
@@ -0,0 +1,371 @@
+//----------------------------------------------------------------------------
+//! @file   narrow_phase_3d_test.cpp
+//! @brief  NarrowPhase3D のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/collision/narrow_phase_3d.h"
+#include "engine/ecs/world.h"
+#include "engine/ecs/systems/collision/collision3d_system.h"
+#include "engine/ecs/systems/transform/movement_system.h"
+#include "engine/ecs/systems/transform/local_to_world_system.h"
+#include "engine/ecs/components/movement/velocity_data.h"
+#include "engine/ecs/components/transform/transform_components.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+using Collision::ColliderSnapshot3D;
+using Collision::Event3D;
+using Collision::NarrowPhase3D;
+using Collision::NarrowShape3D;
+using TestHelpers::TestRandom;
+
+uint32_t AddSphere(ColliderSnapshot3D& s, float x, float y, float z, float r,
+                   uint32_t layer = 0xFFFFFFFF, uint32_t mask = 0xFFFFFFFF)
+{
+    return s.Add(ECS::Actor(s.Size(), 0), x - r, y - r, z - r, x + r, y + r, z + r,
+                 r, NarrowShape3D::Sphere, layer, mask);
+}
+
+uint32_t AddBox(ColliderSnapshot3D& s, float x, float y, float z, float h,
+                NarrowShape3D shape = NarrowShape3D::Box)
+{
+    return s.Add(ECS::Actor(s.Size(), 0), x - h, y - h, z - h, x + h, y + h, z + h,
+                 0.0f, shape, 0xFFFFFFFF, 0xFFFFFFFF);
+}
+
+std::vector<Event3D> RunPairs(NarrowPhase3D& narrowPhase, const ColliderSnapshot3D& s,
+                              const std::vector<std::pair<uint32_t, uint32_t>>& pairs)
+{
+    narrowPhase.BeginPairs();
+    for (const auto& p : pairs) {
+        narrowPhase.AddPair(s, p.first, p.second);
+    }
+    narrowPhase.Execute(s);
+
+    std::vector<Event3D> events;
+    narrowPhase.ForEachEvent([&events](const Event3D& e) { events.push_back(e); });
+    return events;
+}
+
+//! @brief 1ペアずつのスカラー判定（SIMD棄却判定の基準）
+bool ReferenceOverlap(const ColliderSnapshot3D& s, uint32_t a, uint32_t b)
+{
+    auto center = [&s](uint32_t i, int axis) {
+        const float lo = axis == 0 ? s.minX[i] : axis == 1 ? s.minY[i] : s.minZ[i];
+        const float hi = axis == 0 ? s.maxX[i] : axis == 1 ? s.maxY[i] : s.maxZ[i];
+        return (lo + hi) * 0.5f;
+    };
+    const bool sphereA = s.shape[a] == NarrowShape3D::Sphere;
+    const bool sphereB = s.shape[b] == NarrowShape3D::Sphere;
+    const bool boxA = s.shape[a] == NarrowShape3D::Box;
+    const bool boxB = s.shape[b] == NarrowShape3D::Box;
+
+    if (sphereA && sphereB) {
+        float distSq = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float d = center(b, axis) - center(a, axis);
+            distSq += d * d;
+        }
+        const float sum = s.radius[a] + s.radius[b];
+        return distSq <= sum * sum;
+    }
+    if ((sphereA && boxB) || (boxA && sphereB)) {
+        const uint32_t sp = sphereA ? a : b;
+        const uint32_t bx = sphereA ? b : a;
+        const float c[3] = {center(sp, 0), center(sp, 1), center(sp, 2)};
+        const float lo[3] = {s.minX[bx], s.minY[bx], s.minZ[bx]};
+        const float hi[3] = {s.maxX[bx], s.maxY[bx], s.maxZ[bx]};
+        float distSq = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float d = c[axis] - std::clamp(c[axis], lo[axis], hi[axis]);
+            distSq += d * d;
+        }
+        return distSq <= s.radius[sp] * s.radius[sp];
+    }
+    return s.minX[a] < s.maxX[b] && s.maxX[a] > s.minX[b] &&
+           s.minY[a] < s.maxY[b] && s.maxY[a] > s.minY[b] &&
+           s.minZ[a] < s.maxZ[b] && s.maxZ[a] > s.minZ[b];
+}
+
+} // namespace
+
+//============================================================================
+// 形状ペア別の判定
+//============================================================================
+
+TEST(NarrowPhase3DTest, SphereSphereNormalPointsFromAToB)
+{
+    ColliderSnapshot3D s;
+    const uint32_t a = AddSphere(s, 0.0f, 0.0f, 0.0f, 1.0f);
+    const uint32_t b = AddSphere(s, 1.5f, 0.0f, 0.0f, 1.0f);
+    const uint32_t c = AddSphere(s, 5.0f, 0.0f, 0.0f, 1.0f);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{a, b}, {a, c}});
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].actorA, s.actors[a]);
+    EXPECT_EQ(events[0].actorB, s.actors[b]);
+    EXPECT_FLOAT_EQ(events[0].normalX, 1.0f);
+    EXPECT_FLOAT_EQ(events[0].penetration, 0.5f);
+    EXPECT_FLOAT_EQ(events[0].contactX, 0.75f);
+}
+
+TEST(NarrowPhase3DTest, BoxBoxUsesMinimumSeparatingAxis)
+{
+    ColliderSnapshot3D s;
+    const uint32_t a = AddBox(s, 0.0f, 0.0f, 0.0f, 1.0f);
+    const uint32_t b = AddBox(s, 0.0f, 1.8f, 0.0f, 1.0f);
+    const uint32_t touching = AddBox(s, 2.0f, 0.0f, 0.0f, 1.0f);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{a, b}, {a, touching}});
+
+    // 接しているだけのペアは衝突しない
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_FLOAT_EQ(events[0].normalY, -1.0f);
+    EXPECT_NEAR(events[0].penetration, 0.2f, 1e-5f);
+}
+
+TEST(NarrowPhase3DTest, SphereBoxNormalFollowsPairOrder)
+{
+    ColliderSnapshot3D s;
+    const uint32_t sphere = AddSphere(s, 0.0f, 1.5f, 0.0f, 1.0f);
+    const uint32_t box = AddBox(s, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    NarrowPhase3D narrowPhase;
+    const auto sphereFirst = RunPairs(narrowPhase, s, {{sphere, box}});
+    ASSERT_EQ(sphereFirst.size(), 1u);
+    EXPECT_FLOAT_EQ(sphereFirst[0].normalY, 1.0f);
+    EXPECT_FLOAT_EQ(sphereFirst[0].penetration, 0.5f);
+
+    const auto boxFirst = RunPairs(narrowPhase, s, {{box, sphere}});
+    ASSERT_EQ(boxFirst.size(), 1u);
+    EXPECT_EQ(boxFirst[0].actorA, s.actors[box]);
+    EXPECT_FLOAT_EQ(boxFirst[0].normalY, -1.0f);
+    EXPECT_FLOAT_EQ(boxFirst[0].contactY, 1.0f);
+}
+
+TEST(NarrowPhase3DTest, ApproximateShapeUsesBoxTest)
+{
+    ColliderSnapshot3D s;
+    const uint32_t sphere = AddSphere(s, 0.0f, 0.0f, 0.0f, 1.0f);
+    const uint32_t capsule = AddBox(s, 1.9f, 1.9f, 0.0f, 1.0f, NarrowShape3D::Approx);
+
+    // 球同士としては離れているがAABB近似では重なる
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{sphere, capsule}});
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_NEAR(events[0].penetration, 0.1f, 1e-5f);
+}
+
+TEST(NarrowPhase3DTest, LayerMaskFiltersPairs)
+{
+    ColliderSnapshot3D s;
+    const uint32_t a = AddSphere(s, 0.0f, 0.0f, 0.0f, 1.0f, 0x1, 0x2);
+    const uint32_t b = AddSphere(s, 0.5f, 0.0f, 0.0f, 1.0f, 0x2, 0x1);
+    const uint32_t c = AddSphere(s, 0.5f, 0.0f, 0.0f, 1.0f, 0x4, 0xFFFFFFFF);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{a, b}, {a, c}});
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].actorB, s.actors[b]);
+    EXPECT_EQ(events[0].layerA, 0x1u);
+    EXPECT_EQ(events[0].layerB, 0x2u);
+    EXPECT_EQ(narrowPhase.GetPairCount(), 1u);
+}
+
+//============================================================================
+// 連続衝突判定（掃引ペア）
+//============================================================================
+
+TEST(NarrowPhase3DTest, SweptSphereHitsThinWallAtTimeOfImpact)
+{
+    ColliderSnapshot3D s;
+    // 1ステップで x=-5 → 5 へ移動した弾（終端では壁を通り抜けている）
+    const uint32_t bullet = AddSphere(s, 5.0f, 0.0f, 0.0f, 0.1f);
+    s.SetMotion(bullet, 10.0f, 0.0f, 0.0f);
+    const uint32_t wall = s.Add(ECS::Actor(s.Size(), 0), -0.05f, -5.0f, -5.0f, 0.05f, 5.0f, 5.0f,
+                                0.0f, NarrowShape3D::Box, 0xFFFFFFFF, 0xFFFFFFFF);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{bullet, wall}});
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_NEAR(events[0].toi, 0.485f, 1e-5f);
+    EXPECT_FLOAT_EQ(events[0].normalX, -1.0f);     // 壁の入射面から弾向き
+    EXPECT_FLOAT_EQ(events[0].contactX, -0.05f);
+    EXPECT_FLOAT_EQ(events[0].contactY, 0.0f);
+    EXPECT_FLOAT_EQ(events[0].penetration, 0.0f);
+}
+
+TEST(NarrowPhase3DTest, SweptSphereSphereUsesRelativeMotion)
+{
+    ColliderSnapshot3D s;
+    const uint32_t a = AddSphere(s, 4.0f, 0.0f, 0.0f, 0.5f);
+    s.SetMotion(a, 8.0f, 0.0f, 0.0f);
+    const uint32_t b = AddSphere(s, -1.0f, 0.0f, 0.0f, 0.5f);
+    s.SetMotion(b, -1.0f, 0.0f, 0.0f);           // 0 → -1 へ逆向きに移動
+    const uint32_t missed = AddSphere(s, 0.0f, 2.0f, 0.0f, 0.5f);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{a, b}, {a, missed}});
+
+    // 相対移動 9 で距離 4 - 1 = 3 を詰める → toi = 1/3
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].actorB, s.actors[b]);
+    EXPECT_NEAR(events[0].toi, 1.0f / 3.0f, 1e-5f);
+    EXPECT_NEAR(events[0].normalX, 1.0f, 1e-5f);   // 球同士はAからB
+    EXPECT_NEAR(events[0].contactX, -4.0f + 8.0f / 3.0f + 0.5f, 1e-4f);
+}
+
+TEST(NarrowPhase3DTest, SweptPairOverlappingAtEndUsesDiscreteContact)
+{
+    ColliderSnapshot3D s;
+    const uint32_t box = AddBox(s, 0.0f, 1.8f, 0.0f, 1.0f);
+    s.SetMotion(box, 0.0f, -3.0f, 0.0f);
+    const uint32_t ground = AddBox(s, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    NarrowPhase3D narrowPhase;
+    const auto events = RunPairs(narrowPhase, s, {{box, ground}});
+
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_FLOAT_EQ(events[0].toi, 1.0f);
+    EXPECT_FLOAT_EQ(events[0].normalY, 1.0f);
+    EXPECT_NEAR(events[0].penetration, 0.2f, 1e-5f);
+}
+
+// 旧コンストラクタ（セルサイズ）の呼び出しは拡張量と取り違えないようコンパイルエラーになる
+static_assert(!std::is_constructible_v<ECS::Collision3DSystem, float>);
+static_assert(!std::is_constructible_v<ECS::Collision3DSystem, int>);
+static_assert(std::is_constructible_v<ECS::Collision3DSystem, ECS::Collision3DSystem::FatMargin>);
+
+TEST(Collision3DSystemTest, FatMarginIsPassedToBroadPhase)
+{
+    ECS::Collision3DSystem system(ECS::Collision3DSystem::FatMargin{0.25f});
+    EXPECT_FLOAT_EQ(system.GetBroadPhase().GetMargin(), 0.25f);
+
+    ECS::Collision3DSystem defaultSystem;
+    EXPECT_FLOAT_EQ(defaultSystem.GetBroadPhase().GetMargin(), ECS::Collision3DSystem::FatMargin{}.value);
+}
+
+TEST(Collision3DSystemTest, ContinuousProjectileDoesNotTunnelThroughThinWall)
+{
+    auto run = [](bool continuous) -> std::vector<Event3D> {
+        ECS::World world;
+        world.RegisterSystem<ECS::MovementSystem>();
+        world.RegisterSystem<ECS::LocalToWorldSystem>();
+        world.RegisterSystem<ECS::Collision3DSystem>();
+
+        auto wall = world.CreateActor();
+        world.AddComponent<ECS::LocalTransform>(wall)->position = Vector3(1.0f, 0.0f, 0.0f);
+        world.AddComponent<ECS::LocalToWorld>(wall);
+        world.AddComponent<ECS::Collider3DData>(wall, 0.05f, 2.0f, 2.0f);
+
+        auto bullet = world.CreateActor();
+        world.AddComponent<ECS::LocalTransform>(bullet);
+        world.AddComponent<ECS::LocalToWorld>(bullet);
+        world.AddComponent<ECS::VelocityData>(bullet, Vector3(100.0f, 0.0f, 0.0f));
+        world.AddComponent<ECS::Collider3DData>(bullet, 0.05f)->SetContinuous(continuous);
+
+        // 1ステップで 100 / 60 ≒ 1.67 進み、終端では壁（x=0.95..1.05）を越えている
+        world.FixedUpdate(1.0f / 60.0f);
+        return world.GetSystem<ECS::Collision3DSystem>()->GetEventQueue().GetEvents();
+    };
+
+    EXPECT_TRUE(run(false).empty());
+
+    const auto events = run(true);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, Collision::EventType::Enter);
+    // 壁の手前の面 x=0.95 に弾の表面が触れる時刻
+    EXPECT_NEAR(events[0].toi, 0.9f / (100.0f / 60.0f), 1e-4f);
+    EXPECT_NEAR(events[0].contactX, 0.95f, 1e-5f);
+}
+
+//============================================================================
+// バッチ判定の一致
+//============================================================================
+
+TEST(NarrowPhase3DTest, BatchedKernelsMatchScalarReference)
+{
+    TestRandom random(7);
+    ColliderSnapshot3D s;
+    for (int i = 0; i < 300; ++i) {
+        const float x = random.Range(0.0f, 20.0f);
+        const float y = random.Range(0.0f, 20.0f);
+        const float z = random.Range(0.0f, 20.0f);
+        const float size = random.Range(0.2f, 1.5f);
+        switch (i % 3) {
+        case 0:  AddSphere(s, x, y, z, size); break;
+        case 1:  AddBox(s, x, y, z, size); break;
+        default: AddBox(s, x, y, z, size, NarrowShape3D::Approx); break;
+        }
+    }
+
+    // 端数レーンを含むように全ペアのうち一部を使う
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t a = 0; a < s.Size(); ++a) {
+        for (uint32_t b = a + 1; b < s.Size(); b += 7) {
+            pairs.emplace_back((a + b) % 2 ? a : b, (a + b) % 2 ? b : a);
+        }
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> expected;
+    for (const auto& p : pairs) {
+        if (ReferenceOverlap(s, p.first, p.second)) expected.push_back(p);
+    }
+    ASSERT_FALSE(expected.empty());
+
+    NarrowPhase3D narrowPhase;
+    std::vector<std::pair<uint32_t, uint32_t>> actual;
+    for (const Event3D& e : RunPairs(narrowPhase, s, pairs)) {
+        actual.emplace_back(e.actorA.Index(), e.actorB.Index());
+        EXPECT_GE(e.penetration, 0.0f);
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(NarrowPhase3DTest, ParallelExecutionMatchesSerialOrder)
+{
+    TestRandom random(11);
+    ColliderSnapshot3D s;
+    for (int i = 0; i < 400; ++i) {
+        const float x = random.Range(0.0f, 10.0f);
+        const float y = random.Range(0.0f, 10.0f);
+        const float z = random.Range(0.0f, 10.0f);
+        if (i % 2) AddSphere(s, x, y, z, 0.8f);
+        else       AddBox(s, x, y, z, 0.8f);
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t a = 0; a < s.Size(); ++a) {
+        for (uint32_t b = a + 1; b < s.Size(); b += 5) {
+            pairs.emplace_back(a, b);
+        }
+    }
+
+    NarrowPhase3D serial;
+    const auto expected = RunPairs(serial, s, pairs);
+
+    JobSystem::Create(3);
+    NarrowPhase3D parallel;
+    const auto actual = RunPairs(parallel, s, pairs);
+    JobSystem::Destroy();
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].actorA, expected[i].actorA);
+        EXPECT_EQ(actual[i].actorB, expected[i].actorB);
+        EXPECT_EQ(actual[i].penetration, expected[i].penetration);
+    }
+}
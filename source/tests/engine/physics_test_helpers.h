@@ -0,0 +1,77 @@
+//----------------------------------------------------------------------------
+//! @file   physics_test_helpers.h
+//! @brief  物理テスト共通ヘルパー（三角形集合・地形メッシュの生成）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include "test_helpers.h"
+#include "engine/physics/bvh.h"
+#include <cmath>
+#include <vector>
+
+namespace TestHelpers
+{
+
+//! @brief ランダムな小さい三角形の集合
+inline std::vector<Physics::Triangle> MakeTriangleSoup(uint32_t count, float extent, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<Physics::Triangle> triangles;
+    triangles.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Vector3 c(rng.Range(-extent, extent), rng.Range(-extent, extent), rng.Range(-extent, extent));
+        Physics::Triangle tri;
+        tri.v0 = c + Vector3(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1));
+        tri.v1 = c + Vector3(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1));
+        tri.v2 = c + Vector3(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1));
+        tri.index = i;
+        triangles.push_back(tri);
+    }
+    return triangles;
+}
+
+//! @brief 起伏のあるグリッド地形（レベルジオメトリ相当）
+inline std::vector<Physics::Triangle> MakeTerrain(uint32_t cellsPerSide)
+{
+    auto height = [](uint32_t x, uint32_t z) {
+        return std::sin(static_cast<float>(x) * 0.1f) * std::cos(static_cast<float>(z) * 0.07f) * 4.0f;
+    };
+    std::vector<Physics::Triangle> triangles;
+    triangles.reserve(static_cast<size_t>(cellsPerSide) * cellsPerSide * 2);
+    for (uint32_t z = 0; z < cellsPerSide; ++z) {
+        for (uint32_t x = 0; x < cellsPerSide; ++x) {
+            const Vector3 p00(static_cast<float>(x), height(x, z), static_cast<float>(z));
+            const Vector3 p10(static_cast<float>(x + 1), height(x + 1, z), static_cast<float>(z));
+            const Vector3 p01(static_cast<float>(x), height(x, z + 1), static_cast<float>(z + 1));
+            const Vector3 p11(static_cast<float>(x + 1), height(x + 1, z + 1), static_cast<float>(z + 1));
+            triangles.push_back(Physics::Triangle{p00, p01, p10, static_cast<uint32_t>(triangles.size())});
+            triangles.push_back(Physics::Triangle{p10, p01, p11, static_cast<uint32_t>(triangles.size())});
+        }
+    }
+    return triangles;
+}
+
+//! @brief 頂点を共有するグリッドメッシュ（1セル = 1単位、XZ平面）
+//! @param amplitude 起伏の高さ（0なら平面）
+inline void MakeGridMesh(uint32_t cells, std::vector<Vector3>& positions, std::vector<uint32_t>& indices,
+                         float amplitude = 0.0f)
+{
+    for (uint32_t z = 0; z <= cells; ++z) {
+        for (uint32_t x = 0; x <= cells; ++x) {
+            const float h = (amplitude != 0.0f)
+                ? std::sin(static_cast<float>(x) * 0.4f) * std::cos(static_cast<float>(z) * 0.3f) * amplitude
+                : 0.0f;
+            positions.emplace_back(static_cast<float>(x), h, static_cast<float>(z));
+        }
+    }
+    const uint32_t stride = cells + 1;
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            const uint32_t i = z * stride + x;
+            indices.insert(indices.end(), {i, i + stride, i + 1, i + 1, i + stride, i + stride + 1});
+        }
+    }
+}
+
+} // namespace TestHelpers
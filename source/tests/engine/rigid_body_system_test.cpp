@@ -0,0 +1,397 @@
+//----------------------------------------------------------------------------
+//! @file   rigid_body_system_test.cpp
+//! @brief  RigidBodySystem / IslandBuilder / ContactSolver のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/world.h"
+#include "engine/ecs/systems/physics/physics_system.h"
+#include "engine/ecs/systems/physics/rigid_body_system.h"
+#include "engine/ecs/systems/transform/movement_system.h"
+#include "engine/ecs/systems/transform/local_to_world_system.h"
+#include "engine/ecs/systems/collision/collision3d_system.h"
+#include "engine/ecs/components/movement/velocity_data.h"
+#include "engine/ecs/components/movement/angular_velocity_data.h"
+#include "engine/ecs/components/physics/physics_components.h"
+#include "engine/ecs/components/collision/collider3d_data.h"
+#include "engine/ecs/components/transform/transform_components.h"
+#include "engine/core/job_system.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+constexpr float kDt = 1.0f / 60.0f;
+
+//! @brief 重力 → 接触応答 → 移動 → 行列 → 衝突検出 の順で登録したワールド
+void RegisterPhysicsStep(ECS::World& world)
+{
+    world.RegisterSystem<ECS::PhysicsSystem>();
+    world.RegisterSystemWithDeps<ECS::RigidBodySystem>()
+        .After<ECS::PhysicsSystem>()
+        .Before<ECS::MovementSystem>();
+    world.RegisterSystem<ECS::MovementSystem>();
+    world.RegisterSystem<ECS::LocalToWorldSystem>();
+    world.RegisterSystem<ECS::Collision3DSystem>();
+}
+
+ECS::Actor CreateGround(ECS::World& world, const Vector3& position, float halfX = 50.0f, float halfZ = 50.0f)
+{
+    auto actor = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(actor)->position = position;
+    world.AddComponent<ECS::LocalToWorld>(actor);
+    world.AddComponent<ECS::Collider3DData>(actor, halfX, 0.5f, halfZ);
+    return actor;
+}
+
+ECS::Actor CreateBox(ECS::World& world, const Vector3& position, float half = 0.5f,
+                     const ECS::RigidBodyData& material = ECS::RigidBodyData())
+{
+    auto actor = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(actor)->position = position;
+    world.AddComponent<ECS::LocalToWorld>(actor);
+    world.AddComponent<ECS::VelocityData>(actor);
+    world.AddComponent<ECS::PhysicsMassData>(actor, ECS::PhysicsMassData::CreateDynamic(1.0f));
+    world.AddComponent<ECS::RigidBodyData>(actor, material);
+    world.AddComponent<ECS::Collider3DData>(actor, half, half, half);
+    return actor;
+}
+
+ECS::Actor CreateBall(ECS::World& world, const Vector3& position, float radius,
+                      const ECS::RigidBodyData& material = ECS::RigidBodyData())
+{
+    auto actor = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(actor)->position = position;
+    world.AddComponent<ECS::LocalToWorld>(actor);
+    world.AddComponent<ECS::VelocityData>(actor);
+    world.AddComponent<ECS::PhysicsMassData>(actor, ECS::PhysicsMassData::CreateDynamic(1.0f));
+    world.AddComponent<ECS::RigidBodyData>(actor, material);
+    world.AddComponent<ECS::Collider3DData>(actor, radius);
+    return actor;
+}
+
+float PositionY(ECS::World& world, ECS::Actor actor)
+{
+    return world.GetComponent<ECS::LocalTransform>(actor)->position.y;
+}
+
+} // namespace
+
+//============================================================================
+// IslandBuilder テスト
+//============================================================================
+TEST(IslandBuilderTest, GroupsDynamicBodiesConnectedByContacts)
+{
+    constexpr uint32_t kStatic = Physics::IslandBuilder::kNoBody;
+    Physics::IslandBuilder islands;
+    islands.Reset(6);
+    islands.AddContact(0, kStatic);   // 0: 地面
+    islands.AddContact(3, 1);         // 1
+    islands.AddContact(kStatic, 4);   // 2: 地面（4は単独）
+    islands.AddContact(1, 0);         // 3
+    islands.AddContact(5, 2);         // 4
+    islands.Build();
+
+    // {0,1,3} {2,5} {4}（最小の剛体インデックス順）
+    ASSERT_EQ(islands.GetIslandCount(), 3u);
+    const auto& bodies = islands.GetBodies();
+    const auto& contacts = islands.GetContacts();
+
+    const auto& first = islands.GetIsland(0);
+    EXPECT_EQ(std::vector<uint32_t>(bodies.begin() + first.bodyBegin, bodies.begin() + first.bodyEnd),
+              (std::vector<uint32_t>{0, 1, 3}));
+    EXPECT_EQ(std::vector<uint32_t>(contacts.begin() + first.contactBegin, contacts.begin() + first.contactEnd),
+              (std::vector<uint32_t>{0, 1, 3}));
+
+    const auto& second = islands.GetIsland(1);
+    EXPECT_EQ(std::vector<uint32_t>(bodies.begin() + second.bodyBegin, bodies.begin() + second.bodyEnd),
+              (std::vector<uint32_t>{2, 5}));
+    EXPECT_EQ(second.contactEnd - second.contactBegin, 1u);
+    EXPECT_EQ(contacts[second.contactBegin], 4u);
+
+    const auto& third = islands.GetIsland(2);
+    EXPECT_EQ(third.bodyEnd - third.bodyBegin, 1u);
+    EXPECT_EQ(bodies[third.bodyBegin], 4u);
+    EXPECT_EQ(contacts[third.contactBegin], 2u);
+
+    EXPECT_EQ(islands.GetBodyIsland(3), 0u);
+    EXPECT_EQ(islands.GetBodyIsland(5), 1u);
+}
+
+//============================================================================
+// ContactSolver テスト
+//============================================================================
+TEST(ContactSolverTest, StopsApproachAgainstStaticBody)
+{
+    Physics::SolverBody bodies[2];
+    bodies[0].linearVelocity = Vector3(1.0f, -3.0f, 0.0f);
+    bodies[0].inverseMass = 1.0f;
+    bodies[0].dynamic = true;
+
+    Physics::ContactManifold m;
+    m.bodyA = 0;
+    m.bodyB = 1;
+    m.normal = Vector3(0.0f, -1.0f, 0.0f);   // A（上）から B（地面）へ
+    m.friction = 0.0f;
+    m.pointCount = 1;
+    m.points[0].penetration = 0.0f;
+
+    Physics::ContactSolver solver;
+    solver.Prepare(m, bodies, kDt);
+    for (int i = 0; i < 4; ++i) {
+        solver.Solve(m, bodies);
+    }
+
+    // 法線方向の接近だけが止まり、接線方向（摩擦0）は残る。静的な相手は動かない
+    EXPECT_NEAR(bodies[0].linearVelocity.y, 0.0f, 1e-5f);
+    EXPECT_NEAR(bodies[0].linearVelocity.x, 1.0f, 1e-5f);
+    EXPECT_EQ(bodies[1].linearVelocity, Vector3::Zero);
+    EXPECT_NEAR(m.points[0].normalImpulse, 3.0f, 1e-5f);
+}
+
+//============================================================================
+// RigidBodySystem テスト
+//============================================================================
+TEST(RigidBodySystemTest, BoxRestsOnGroundAndFallsAsleep)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+    auto box = CreateBox(world, Vector3(0.0f, 0.6f, 0.0f));
+
+    for (int i = 0; i < 180; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    // 地面（上面 y=0）に載り、沈み込みはスロップ程度に収まる
+    EXPECT_NEAR(PositionY(world, box), 0.5f, 0.02f);
+    const auto* rb = world.GetComponent<ECS::RigidBodyData>(box);
+    EXPECT_TRUE(rb->IsSleeping());
+    EXPECT_EQ(world.GetComponent<ECS::VelocityData>(box)->value, Vector3::Zero);
+
+    // スリープ中は位置が変わらない
+    const float restY = PositionY(world, box);
+    for (int i = 0; i < 30; ++i) {
+        world.FixedUpdate(kDt);
+    }
+    EXPECT_FLOAT_EQ(PositionY(world, box), restY);
+    EXPECT_EQ(world.GetSystem<ECS::RigidBodySystem>()->GetStats().sleepingBodies, 1u);
+}
+
+TEST(RigidBodySystemTest, StaticContactPartnerChunkIsNotMarkedWritten)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    auto ground = CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+    CreateBox(world, Vector3(0.0f, 0.45f, 0.0f));
+
+    // 接触イベントが出るまで進める
+    for (int i = 0; i < 3; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    const ECS::ActorRecord& rec = world.GetActorRecord(ground);
+    const size_t transformIndex = rec.archetype->GetComponentIndex<ECS::LocalTransform>();
+    const size_t colliderIndex = rec.archetype->GetComponentIndex<ECS::Collider3DData>();
+    const uint32_t transformVersion = rec.archetype->GetComponentVersion(rec.chunkIndex, transformIndex);
+    const uint32_t colliderVersion = rec.archetype->GetComponentVersion(rec.chunkIndex, colliderIndex);
+
+    // 書き込みバージョンを進めて1ステップだけ解く
+    ECS::ArchetypeStorage& storage = world.GetArchetypeStorage();
+    storage.SetWriteVersion(storage.GetWriteVersion() + 1);
+    ECS::RigidBodySystem* rigidBodies = world.GetSystem<ECS::RigidBodySystem>();
+    rigidBodies->OnUpdate(world, kDt);
+
+    // 静的な地面は読み取るだけで、Changed<>の対象にならない
+    ASSERT_GT(rigidBodies->GetStats().manifoldCount, 0u);
+    EXPECT_EQ(rec.archetype->GetComponentVersion(rec.chunkIndex, transformIndex), transformVersion);
+    EXPECT_EQ(rec.archetype->GetComponentVersion(rec.chunkIndex, colliderIndex), colliderVersion);
+}
+
+TEST(RigidBodySystemTest, BoxStackStaysStable)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+
+    constexpr int kHeight = 6;
+    std::vector<ECS::Actor> stack;
+    for (int i = 0; i < kHeight; ++i) {
+        stack.push_back(CreateBox(world, Vector3(0.0f, 0.5f + static_cast<float>(i) * 1.0f, 0.0f)));
+    }
+
+    for (int i = 0; i < 240; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    for (int i = 0; i < kHeight; ++i) {
+        EXPECT_NEAR(PositionY(world, stack[i]), 0.5f + static_cast<float>(i), 0.1f) << "box " << i;
+        const auto& p = world.GetComponent<ECS::LocalTransform>(stack[i])->position;
+        EXPECT_NEAR(p.x, 0.0f, 1e-3f);
+        EXPECT_NEAR(p.z, 0.0f, 1e-3f);
+    }
+    const auto& stats = world.GetSystem<ECS::RigidBodySystem>()->GetStats();
+    EXPECT_EQ(stats.bodyCount, static_cast<uint32_t>(kHeight));
+    EXPECT_EQ(stats.islandCount, 1u);
+    EXPECT_EQ(stats.sleepingBodies, static_cast<uint32_t>(kHeight));
+}
+
+TEST(RigidBodySystemTest, RotatingBoxRestsFlatOnFourContactPoints)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+    // 台からはみ出して載せても4隅で支えられ、傾かずに眠る
+    CreateGround(world, Vector3(0.3f, 0.5f, 0.0f), 0.5f, 0.5f);
+    auto box = CreateBox(world, Vector3(0.0f, 1.55f, 0.0f));
+    world.AddComponent<ECS::AngularVelocityData>(box);
+
+    for (int i = 0; i < 180; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    EXPECT_EQ(world.GetSystem<ECS::RigidBodySystem>()->GetStats().manifoldCount, 1u);
+    EXPECT_NEAR(PositionY(world, box), 1.5f, 0.02f);
+    EXPECT_TRUE(world.GetComponent<ECS::RigidBodyData>(box)->IsSleeping());
+    EXPECT_EQ(world.GetComponent<ECS::AngularVelocityData>(box)->value, Vector3::Zero);
+}
+
+TEST(RigidBodySystemTest, RestitutionBouncesBall)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+    auto bouncy = CreateBall(world, Vector3(-2.0f, 2.0f, 0.0f), 0.5f, ECS::RigidBodyData(0.5f, 0.8f));
+    auto dead = CreateBall(world, Vector3(2.0f, 2.0f, 0.0f), 0.5f, ECS::RigidBodyData(0.5f, 0.0f));
+
+    float bouncyPeak = 0.0f;
+    float deadPeak = 0.0f;
+    for (int i = 0; i < 120; ++i) {
+        world.FixedUpdate(kDt);
+        bouncyPeak = (std::max)(bouncyPeak, world.GetComponent<ECS::VelocityData>(bouncy)->value.y);
+        deadPeak = (std::max)(deadPeak, world.GetComponent<ECS::VelocityData>(dead)->value.y);
+    }
+
+    // 衝突速度 約5.4m/s → 反発0.8なら 4m/s 以上で跳ね返る
+    EXPECT_GT(bouncyPeak, 3.5f);
+    EXPECT_LT(deadPeak, 0.5f);
+    EXPECT_GT(PositionY(world, bouncy), 0.0f);
+    EXPECT_NEAR(PositionY(world, dead), 0.5f, 0.02f);
+}
+
+TEST(RigidBodySystemTest, FrictionStopsSlidingBox)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f));
+    auto box = CreateBox(world, Vector3(0.0f, 0.5f, 0.0f), 0.5f, ECS::RigidBodyData(0.5f, 0.0f));
+    world.GetComponent<ECS::VelocityData>(box)->value = Vector3(3.0f, 0.0f, 0.0f);
+
+    for (int i = 0; i < 120; ++i) {
+        world.FixedUpdate(kDt);
+    }
+
+    // μg = 4.9m/s² で減速 → 約0.92m滑って止まる
+    EXPECT_NEAR(world.GetComponent<ECS::LocalTransform>(box)->position.x, 0.92f, 0.1f);
+    EXPECT_NEAR(world.GetComponent<ECS::VelocityData>(box)->value.x, 0.0f, 1e-3f);
+}
+
+TEST(RigidBodySystemTest, SleepingBodyWakesWhenSupportIsRemoved)
+{
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -10.5f, 0.0f));
+    auto shelf = CreateGround(world, Vector3(0.0f, -0.5f, 0.0f), 2.0f, 2.0f);
+    auto box = CreateBox(world, Vector3(0.0f, 0.5f, 0.0f));
+
+    for (int i = 0; i < 60; ++i) {
+        world.FixedUpdate(kDt);
+    }
+    ASSERT_TRUE(world.GetComponent<ECS::RigidBodyData>(box)->IsSleeping());
+
+    // 棚を外すと接触数が減って起き、下の地面まで落ちる
+    world.GetComponent<ECS::Collider3DData>(shelf)->SetEnabled(false);
+    for (int i = 0; i < 180; ++i) {
+        world.FixedUpdate(kDt);
+    }
+    EXPECT_NEAR(PositionY(world, box), -9.5f, 0.05f);
+}
+
+TEST(RigidBodySystemTest, ParallelIslandsMatchSerial)
+{
+    auto simulate = [](bool parallel) {
+        if (parallel) {
+            JobSystem::Create(2);
+        }
+        std::vector<float> heights;
+        {
+            ECS::World world;
+            RegisterPhysicsStep(world);
+            CreateGround(world, Vector3(0.0f, -0.5f, 0.0f), 100.0f, 100.0f);
+            std::vector<ECS::Actor> actors;
+            for (int s = 0; s < 32; ++s) {
+                const float x = static_cast<float>(s % 8) * 3.0f;
+                const float z = static_cast<float>(s / 8) * 3.0f;
+                for (int level = 0; level < 4; ++level) {
+                    actors.push_back(CreateBox(world, Vector3(x, 0.6f + static_cast<float>(level) * 1.05f, z)));
+                }
+            }
+            for (int i = 0; i < 90; ++i) {
+                world.FixedUpdate(kDt);
+            }
+            EXPECT_EQ(world.GetSystem<ECS::RigidBodySystem>()->GetStats().islandCount, 32u);
+            for (auto actor : actors) {
+                heights.push_back(world.GetComponent<ECS::LocalTransform>(actor)->position.y);
+            }
+        }
+        if (parallel) {
+            JobSystem::Destroy();
+        }
+        return heights;
+    };
+
+    const std::vector<float> serial = simulate(false);
+    const std::vector<float> parallel = simulate(true);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i], parallel[i]) << "actor " << i;
+    }
+}
+
+//============================================================================
+// ベンチマーク
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+TEST(RigidBodySystemBenchmark, DISABLED_FixedStepWithPropPiles)
+{
+    constexpr int kPiles = 400;
+    constexpr int kPerPile = 5;
+    constexpr int kMeasuredSteps = 60;
+
+    ECS::World world;
+    RegisterPhysicsStep(world);
+    CreateGround(world, Vector3(0.0f, -0.5f, 0.0f), 200.0f, 200.0f);
+    for (int p = 0; p < kPiles; ++p) {
+        const float x = static_cast<float>(p % 20) * 3.0f;
+        const float z = static_cast<float>(p / 20) * 3.0f;
+        for (int level = 0; level < kPerPile; ++level) {
+            CreateBox(world, Vector3(x, 0.6f + static_cast<float>(level) * 1.05f, z));
+        }
+    }
+
+    // 落下・着地・スリープまでを含めて計測
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kMeasuredSteps; ++i) {
+        world.FixedUpdate(kDt);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double msPerStep =
+        std::chrono::duration<double, std::milli>(end - start).count() / kMeasuredSteps;
+
+    const auto& stats = world.GetSystem<ECS::RigidBodySystem>()->GetStats();
+    std::printf("[ BENCH    ] %d bodies, %u manifolds, %u islands, %u sleeping: %.3f ms/step\n",
+                kPiles * kPerPile, stats.manifoldCount, stats.islandCount, stats.sleepingBodies, msPerStep);
+    RecordProperty("bodies", kPiles * kPerPile);
+    RecordProperty("ms_per_step_x1000", static_cast<int>(msPerStep * 1000.0));
+}
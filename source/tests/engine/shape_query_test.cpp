@@ -0,0 +1,371 @@
+//----------------------------------------------------------------------------
+//! @file   shape_query_test.cpp
+//! @brief  形状クエリ（球・カプセルのスイープ、重なり判定）と MeshCollider のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/physics/shape_query.h"
+#include "engine/physics/mesh_collider.h"
+#include "physics_test_helpers.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+using namespace Physics;
+using TestHelpers::MakeGridMesh;
+using TestHelpers::TestRandom;
+
+struct Tri {
+    Vector3 v0, v1, v2;
+};
+
+float SphereDistance(const Vector3& c, const Tri& t)
+{
+    return (c - ClosestPointOnTriangle(c, t.v0, t.v1, t.v2)).Length();
+}
+
+float CapsuleDistance(const Vector3& p, const Vector3& q, const Tri& t)
+{
+    Vector3 a, b;
+    return std::sqrt(ClosestPointsSegmentTriangle(p, q, t.v0, t.v1, t.v2, a, b));
+}
+
+//! @brief 距離関数を細かく刻んで最初に radius 以下になる時刻を求める（基準）
+template<typename DistanceFunc>
+bool ReferenceSweep(DistanceFunc&& distanceAt, float radius, float maxDistance, float& outT)
+{
+    constexpr float kStep = 0.002f;
+    if (distanceAt(0.0f) <= radius) {
+        outT = 0.0f;
+        return true;
+    }
+    float prev = 0.0f;
+    for (float t = kStep; t <= maxDistance + kStep; t += kStep) {
+        const float clamped = (std::min)(t, maxDistance);
+        if (distanceAt(clamped) <= radius) {
+            // 二分法で詰める
+            float lo = prev, hi = clamped;
+            for (int i = 0; i < 30; ++i) {
+                const float mid = (lo + hi) * 0.5f;
+                (distanceAt(mid) <= radius ? hi : lo) = mid;
+            }
+            outT = hi;
+            return true;
+        }
+        prev = clamped;
+    }
+    return false;
+}
+
+//! @brief コライダーの全三角形（ワールド座標）
+std::vector<Tri> WorldTriangles(const std::vector<Vector3>& positions, const std::vector<uint32_t>& indices,
+                                const Matrix& world)
+{
+    std::vector<Tri> tris;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        tris.push_back(Tri{Vector3::Transform(positions[indices[i]], world),
+                           Vector3::Transform(positions[indices[i + 1]], world),
+                           Vector3::Transform(positions[indices[i + 2]], world)});
+    }
+    return tris;
+}
+
+} // namespace
+
+//============================================================================
+// 三角形単位の判定
+//============================================================================
+
+TEST(ShapeQueryTest, ClosestPointOnTriangleRegions)
+{
+    const Vector3 a(0, 0, 0), b(2, 0, 0), c(0, 2, 0);
+    const Vector3 inside = ClosestPointOnTriangle(Vector3(0.5f, 0.5f, 3.0f), a, b, c);
+    EXPECT_NEAR(inside.x, 0.5f, 1e-6f);
+    EXPECT_NEAR(inside.y, 0.5f, 1e-6f);
+    EXPECT_NEAR(inside.z, 0.0f, 1e-6f);
+
+    const Vector3 vertex = ClosestPointOnTriangle(Vector3(-1, -1, 0), a, b, c);
+    EXPECT_NEAR((vertex - a).Length(), 0.0f, 1e-6f);
+
+    const Vector3 edge = ClosestPointOnTriangle(Vector3(2, 2, 0), a, b, c);
+    EXPECT_NEAR(edge.x, 1.0f, 1e-6f);
+    EXPECT_NEAR(edge.y, 1.0f, 1e-6f);
+}
+
+TEST(ShapeQueryTest, SphereSweepHitsFaceEdgeAndVertex)
+{
+    const Vector3 a(0, 0, 0), b(4, 0, 0), c(0, 0, 4);
+    ShapeHit hit;
+
+    // 面: 真上から落とす
+    ASSERT_TRUE(SweepSphereTriangle(Vector3(1, 5, 1), 0.5f, Vector3(0, -1, 0), 10.0f, a, b, c, hit));
+    EXPECT_NEAR(hit.distance, 4.5f, 1e-5f);
+    EXPECT_NEAR(hit.normal.y, 1.0f, 1e-5f);
+
+    // 辺: 斜辺の外側をかすめる
+    ASSERT_TRUE(SweepSphereTriangle(Vector3(2.3f, 5, 2.3f), 0.5f, Vector3(0, -1, 0), 10.0f, a, b, c, hit));
+    const float edgeDist = (2.3f - 2.0f) * std::sqrt(2.0f);
+    EXPECT_NEAR(hit.distance, 5.0f - std::sqrt(0.25f - edgeDist * edgeDist), 1e-4f);
+
+    // 頂点
+    ASSERT_TRUE(SweepSphereTriangle(Vector3(-0.3f, 5, -0.3f), 0.5f, Vector3(0, -1, 0), 10.0f, a, b, c, hit));
+    EXPECT_NEAR(hit.distance, 5.0f - std::sqrt(0.25f - 0.18f), 1e-4f);
+    EXPECT_NEAR((hit.point - a).Length(), 0.0f, 1e-6f);
+
+    // 届かない・外れる
+    EXPECT_FALSE(SweepSphereTriangle(Vector3(1, 5, 1), 0.5f, Vector3(0, -1, 0), 4.0f, a, b, c, hit));
+    EXPECT_FALSE(SweepSphereTriangle(Vector3(-2, 5, -2), 0.5f, Vector3(0, -1, 0), 10.0f, a, b, c, hit));
+
+    // 初期重なり
+    ASSERT_TRUE(SweepSphereTriangle(Vector3(1, 0.2f, 1), 0.5f, Vector3(1, 0, 0), 10.0f, a, b, c, hit));
+    EXPECT_EQ(hit.distance, 0.0f);
+    EXPECT_NEAR(hit.normal.y, 1.0f, 1e-5f);
+}
+
+TEST(ShapeQueryTest, SphereSweepMatchesReference)
+{
+    TestRandom rng(3);
+    int hits = 0;
+    for (int i = 0; i < 300; ++i) {
+        const Tri tri{rng.Point(2.0f), rng.Point(2.0f), rng.Point(2.0f)};
+        const Vector3 center = rng.Point(2.0f) + rng.Direction() * 3.0f;
+        const Vector3 target = rng.Point(1.0f);
+        Vector3 dir = target - center;
+        dir.Normalize();
+        const float radius = rng.Range(0.1f, 0.8f);
+
+        float expectedT;
+        const bool expected = ReferenceSweep(
+            [&](float t) { return SphereDistance(center + dir * t, tri); }, radius, 6.0f, expectedT);
+        ShapeHit hit;
+        const bool actual = SweepSphereTriangle(center, radius, dir, 6.0f, tri.v0, tri.v1, tri.v2, hit);
+        ASSERT_EQ(actual, expected) << i;
+        if (expected) {
+            ++hits;
+            EXPECT_NEAR(hit.distance, expectedT, 2e-3f) << i;
+            // 初期重なりでなければ、接触点は形状から radius の距離
+            if (hit.distance > 0.0f) {
+                EXPECT_NEAR((center + dir * hit.distance - hit.point).Length(), radius, 2e-3f) << i;
+            }
+            EXPECT_NEAR(hit.normal.Length(), 1.0f, 1e-3f) << i;
+        }
+    }
+    EXPECT_GT(hits, 50);
+}
+
+TEST(ShapeQueryTest, CapsuleSweepMatchesReference)
+{
+    TestRandom rng(17);
+    int hits = 0;
+    for (int i = 0; i < 300; ++i) {
+        const Tri tri{rng.Point(2.0f), rng.Point(2.0f), rng.Point(2.0f)};
+        const Vector3 center = rng.Point(1.0f) + rng.Direction() * 4.0f;
+        const Vector3 halfAxis = rng.Direction() * rng.Range(0.2f, 1.5f);
+        const Vector3 p0 = center - halfAxis;
+        const Vector3 p1 = center + halfAxis;
+        Vector3 dir = rng.Point(1.0f) - center;
+        dir.Normalize();
+        const float radius = rng.Range(0.1f, 0.6f);
+
+        float expectedT;
+        const bool expected = ReferenceSweep(
+            [&](float t) { return CapsuleDistance(p0 + dir * t, p1 + dir * t, tri); }, radius, 7.0f, expectedT);
+        ShapeHit hit;
+        const bool actual = SweepCapsuleTriangle(p0, p1, radius, dir, 7.0f, tri.v0, tri.v1, tri.v2, hit);
+        ASSERT_EQ(actual, expected) << i;
+        if (expected) {
+            ++hits;
+            EXPECT_NEAR(hit.distance, expectedT, 2e-3f) << i;
+            if (hit.distance > 0.0f) {
+                EXPECT_NEAR(CapsuleDistance(p0 + dir * hit.distance, p1 + dir * hit.distance, tri), radius, 2e-3f) << i;
+            }
+            EXPECT_NEAR(hit.normal.Length(), 1.0f, 1e-3f) << i;
+        }
+    }
+    EXPECT_GT(hits, 50);
+}
+
+TEST(ShapeQueryTest, AABBTriangleOverlapUsesAllAxes)
+{
+    const Vector3 center(0, 0, 0);
+    const Vector3 half(1, 1, 1);
+    ShapeHit hit;
+
+    // 頂点がすべて箱の外でも、面が箱を貫通していれば重なる
+    EXPECT_TRUE(AABBTriangleOverlap(center, half, Vector3(-5, 0.5f, -5), Vector3(5, 0.5f, -5), Vector3(0, 0.5f, 5), hit));
+    EXPECT_NEAR(hit.normal.y, -1.0f, 1e-5f);
+    EXPECT_NEAR(hit.distance, 0.5f, 1e-5f);
+
+    // 面の平面で分離
+    EXPECT_FALSE(AABBTriangleOverlap(center, half, Vector3(-5, 1.5f, -5), Vector3(5, 1.5f, -5), Vector3(0, 1.5f, 5), hit));
+
+    // 角をかすめる斜めの三角形（各軸のAABBは重なるが辺の外積軸で分離）
+    EXPECT_FALSE(AABBTriangleOverlap(center, half, Vector3(1.5f, 1.5f, -3), Vector3(1.5f, 1.5f, 3), Vector3(3, 0.5f, 0), hit));
+    EXPECT_TRUE(AABBTriangleOverlap(center, half, Vector3(0.9f, 0.9f, -3), Vector3(0.9f, 0.9f, 3), Vector3(3, 0.5f, 0), hit));
+}
+
+//============================================================================
+// MeshCollider
+//============================================================================
+
+class MeshColliderShapeQueryTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        MakeGridMesh(24, positions_, indices_, 1.5f);
+        collider_ = MeshCollider::Create(positions_, indices_);
+        // 回転 + 非一様スケール + 平行移動
+        world_ = Matrix::CreateScale(1.5f, 0.8f, 1.2f) * Matrix::CreateRotationY(0.6f) *
+                 Matrix::CreateTranslation(-10.0f, 2.0f, 5.0f);
+        collider_->SetWorldMatrix(world_);
+        tris_ = WorldTriangles(positions_, indices_, world_);
+    }
+
+    Vector3 RandomAbove(TestRandom& rng) const
+    {
+        const Vector3 local(rng.Range(0, 24), rng.Range(2, 6), rng.Range(0, 24));
+        return Vector3::Transform(local, world_);
+    }
+
+    std::vector<Vector3> positions_;
+    std::vector<uint32_t> indices_;
+    MeshColliderPtr collider_;
+    Matrix world_;
+    std::vector<Tri> tris_;
+};
+
+TEST_F(MeshColliderShapeQueryTest, OverlapSphereMatchesBruteForce)
+{
+    TestRandom rng(5);
+    for (int i = 0; i < 50; ++i) {
+        const Vector3 center = RandomAbove(rng) - Vector3(0, rng.Range(1.5f, 5.0f), 0);
+        const float radius = rng.Range(0.3f, 2.0f);
+
+        std::vector<ShapeHit> hits;
+        collider_->OverlapSphere(center, radius, hits);
+        std::vector<uint32_t> actual;
+        for (const ShapeHit& hit : hits) actual.push_back(hit.triangleIndex);
+        std::sort(actual.begin(), actual.end());
+
+        std::vector<uint32_t> expected;
+        for (uint32_t t = 0; t < tris_.size(); ++t) {
+            if (SphereDistance(center, tris_[t]) <= radius) expected.push_back(t);
+        }
+        EXPECT_EQ(actual, expected) << i;
+
+        ShapeHit deepest;
+        EXPECT_EQ(collider_->OverlapSphere(center, radius, deepest), !expected.empty());
+    }
+}
+
+TEST_F(MeshColliderShapeQueryTest, OverlapAABBMatchesBruteForce)
+{
+    TestRandom rng(8);
+    for (int i = 0; i < 50; ++i) {
+        const Vector3 center = RandomAbove(rng) - Vector3(0, rng.Range(1.5f, 5.0f), 0);
+        BoundingBox box;
+        const Vector3 half(rng.Range(0.2f, 2.0f), rng.Range(0.2f, 2.0f), rng.Range(0.2f, 2.0f));
+        box.min = center - half;
+        box.max = center + half;
+
+        std::vector<ShapeHit> hits;
+        collider_->OverlapAABB(box, hits);
+        std::vector<uint32_t> actual;
+        for (const ShapeHit& hit : hits) actual.push_back(hit.triangleIndex);
+        std::sort(actual.begin(), actual.end());
+
+        std::vector<uint32_t> expected;
+        for (uint32_t t = 0; t < tris_.size(); ++t) {
+            ShapeHit hit;
+            if (AABBTriangleOverlap(center, half, tris_[t].v0, tris_[t].v1, tris_[t].v2, hit)) expected.push_back(t);
+        }
+        EXPECT_EQ(actual, expected) << i;
+    }
+}
+
+TEST_F(MeshColliderShapeQueryTest, SweepsMatchBruteForce)
+{
+    TestRandom rng(13);
+    int hits = 0;
+    for (int i = 0; i < 60; ++i) {
+        const Vector3 start = RandomAbove(rng);
+        Vector3 dir = rng.Direction();
+        dir.y = -std::abs(dir.y) - 0.2f;
+        dir.Normalize();
+        const float radius = rng.Range(0.2f, 0.7f);
+        const Vector3 p0 = start;
+        const Vector3 p1 = start + Vector3(0, 1.6f, 0);
+
+        float expectedSphere = FLT_MAX, expectedCapsule = FLT_MAX;
+        for (const Tri& tri : tris_) {
+            ShapeHit hit;
+            if (SweepSphereTriangle(start, radius, dir, 20.0f, tri.v0, tri.v1, tri.v2, hit)) {
+                expectedSphere = (std::min)(expectedSphere, hit.distance);
+            }
+            if (SweepCapsuleTriangle(p0, p1, radius, dir, 20.0f, tri.v0, tri.v1, tri.v2, hit)) {
+                expectedCapsule = (std::min)(expectedCapsule, hit.distance);
+            }
+        }
+
+        ShapeHit sphere;
+        ASSERT_EQ(collider_->SweepSphere(start, radius, dir, 20.0f, sphere), expectedSphere != FLT_MAX) << i;
+        if (sphere.hit) {
+            ++hits;
+            EXPECT_NEAR(sphere.distance, expectedSphere, 1e-4f) << i;
+            EXPECT_LT(sphere.triangleIndex, tris_.size());
+        }
+
+        ShapeHit capsule;
+        ASSERT_EQ(collider_->SweepCapsule(p0, p1, radius, dir, 20.0f, capsule), expectedCapsule != FLT_MAX) << i;
+        if (capsule.hit) {
+            EXPECT_NEAR(capsule.distance, expectedCapsule, 1e-4f) << i;
+            EXPECT_LE(capsule.distance, sphere.hit ? sphere.distance + 1e-4f : FLT_MAX) << i;
+        }
+    }
+    EXPECT_GT(hits, 30);
+}
+
+TEST_F(MeshColliderShapeQueryTest, BatchMatchesSingleQueriesInParallel)
+{
+    TestRandom rng(21);
+    std::vector<CapsuleSweepQuery> capsules;
+    std::vector<SphereOverlapQuery> overlaps;
+    for (int i = 0; i < 200; ++i) {
+        CapsuleSweepQuery q;
+        q.point0 = RandomAbove(rng);
+        q.point1 = q.point0 + Vector3(0, 1.5f, 0);
+        q.direction = Vector3(rng.Range(-1, 1), -1.0f, rng.Range(-1, 1));
+        q.direction.Normalize();
+        q.radius = 0.4f;
+        q.maxDistance = 10.0f;
+        capsules.push_back(q);
+        overlaps.push_back(SphereOverlapQuery{q.point0 - Vector3(0, 3.0f, 0), 1.0f});
+    }
+
+    JobSystem::Create(3);
+    std::vector<ShapeHit> sweepHits(capsules.size());
+    std::vector<ShapeHit> overlapHits(overlaps.size());
+    const size_t sweepCount = collider_->SweepCapsuleBatch(capsules, sweepHits);
+    const size_t overlapCount = collider_->OverlapSphereBatch(overlaps, overlapHits);
+    JobSystem::Destroy();
+
+    size_t expectedSweeps = 0, expectedOverlaps = 0;
+    for (size_t i = 0; i < capsules.size(); ++i) {
+        const CapsuleSweepQuery& q = capsules[i];
+        ShapeHit single;
+        expectedSweeps += collider_->SweepCapsule(q.point0, q.point1, q.radius, q.direction, q.maxDistance, single);
+        EXPECT_EQ(sweepHits[i].hit, single.hit) << i;
+        EXPECT_EQ(sweepHits[i].distance, single.distance) << i;
+        EXPECT_EQ(sweepHits[i].triangleIndex, single.triangleIndex) << i;
+
+        ShapeHit deepest;
+        expectedOverlaps += collider_->OverlapSphere(overlaps[i].center, overlaps[i].radius, deepest);
+        EXPECT_EQ(overlapHits[i].triangleIndex, deepest.triangleIndex) << i;
+    }
+    EXPECT_EQ(sweepCount, expectedSweeps);
+    EXPECT_EQ(overlapCount, expectedOverlaps);
+    EXPECT_GT(sweepCount, 100u);
+}
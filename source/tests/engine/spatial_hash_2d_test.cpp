@@ -0,0 +1,204 @@
+//----------------------------------------------------------------------------
+//! @file   spatial_hash_2d_test.cpp
+//! @brief  SpatialHash2D のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/ecs/collision/spatial_hash_2d.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using Collision::SpatialHash2D;
+using TestHelpers::TestRandom;
+
+struct Box2D {
+    float x, y, halfW, halfH;
+};
+
+bool Overlaps(const Box2D& a, const Box2D& b)
+{
+    return (a.x - a.halfW < b.x + b.halfW) && (a.x + a.halfW > b.x - b.halfW) &&
+           (a.y - a.halfH < b.y + b.halfH) && (a.y + a.halfH > b.y - b.halfH);
+}
+
+std::vector<Box2D> MakeBoxes(uint32_t count, float extent, float minHalf, float maxHalf, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<Box2D> boxes;
+    for (uint32_t i = 0; i < count; ++i) {
+        boxes.push_back(Box2D{rng.Range(-extent, extent), rng.Range(-extent, extent),
+                              rng.Range(minHalf, maxHalf), rng.Range(minHalf, maxHalf)});
+    }
+    return boxes;
+}
+
+void InsertAll(SpatialHash2D& grid, const std::vector<Box2D>& boxes)
+{
+    grid.Clear();
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        const Box2D& b = boxes[i];
+        grid.Insert(ECS::Actor(i, 0), b.x, b.y, b.halfW, b.halfH);
+    }
+    grid.Build();
+}
+
+//! @brief AABBが重なるペア（グリッドの結果）
+std::vector<std::pair<uint32_t, uint32_t>> FindOverlaps(SpatialHash2D& grid, const std::vector<Box2D>& boxes)
+{
+    grid.FindPairs([&boxes](uint32_t a, uint32_t b) { return Overlaps(boxes[a], boxes[b]); });
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    grid.QueryAllIndexPairs([&pairs](uint32_t a, uint32_t b) {
+        pairs.emplace_back((std::min)(a, b), (std::max)(a, b));
+    });
+    return pairs;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> BruteForceOverlaps(const std::vector<Box2D>& boxes)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t a = 0; a < boxes.size(); ++a) {
+        for (uint32_t b = a + 1; b < boxes.size(); ++b) {
+            if (Overlaps(boxes[a], boxes[b])) pairs.emplace_back(a, b);
+        }
+    }
+    return pairs;
+}
+
+} // namespace
+
+//============================================================================
+// SpatialHash2D
+//============================================================================
+
+TEST(SpatialHash2DTest, PairsMatchBruteForceWithoutDuplicates)
+{
+    // 負の座標とセルをまたぐ大きいコライダーを含む
+    const auto boxes = MakeBoxes(600, 400.0f, 2.0f, 90.0f, 42);
+    SpatialHash2D grid(32.0f);
+    InsertAll(grid, boxes);
+
+    auto actual = FindOverlaps(grid, boxes);
+    const size_t reported = actual.size();
+    std::sort(actual.begin(), actual.end());
+    actual.erase(std::unique(actual.begin(), actual.end()), actual.end());
+
+    EXPECT_EQ(actual.size(), reported);
+    EXPECT_EQ(actual, BruteForceOverlaps(boxes));
+    EXPECT_GT(grid.GetEntryCount(), boxes.size());
+}
+
+TEST(SpatialHash2DTest, QueryAllPairsWithoutFilterReportsEachSharedCellPairOnce)
+{
+    SpatialHash2D grid(10.0f);
+    grid.Insert(ECS::Actor(0, 0), 0.0f, 0.0f, 15.0f, 15.0f);   // 4x4セル
+    grid.Insert(ECS::Actor(1, 0), 5.0f, 5.0f, 12.0f, 12.0f);   // 複数セルを共有
+    grid.Insert(ECS::Actor(2, 0), 100.0f, 100.0f, 1.0f, 1.0f);
+    grid.Build();
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    grid.QueryAllPairs([&pairs](ECS::Actor a, ECS::Actor b) { pairs.emplace_back(a.Index(), b.Index()); });
+
+    ASSERT_EQ(pairs.size(), 1u);
+    EXPECT_EQ(pairs[0], std::make_pair(0u, 1u));
+    EXPECT_GE(grid.GetCellCount(), 17u);
+}
+
+TEST(SpatialHash2DTest, QueryRangeReportsEachColliderOnce)
+{
+    const auto boxes = MakeBoxes(300, 200.0f, 1.0f, 40.0f, 7);
+    SpatialHash2D grid(16.0f);
+    InsertAll(grid, boxes);
+
+    const Box2D query{10.0f, -20.0f, 60.0f, 35.0f};
+    std::vector<uint32_t> found;
+    grid.QueryRange(query.x, query.y, query.halfW, query.halfH,
+                    [&found](ECS::Actor actor) { found.push_back(actor.Index()); });
+    std::vector<uint32_t> unique = found;
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    EXPECT_EQ(unique.size(), found.size());
+
+    // 重なるコライダーは必ず含まれる（セル単位なので余分は許容）
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        if (Overlaps(query, boxes[i])) {
+            EXPECT_TRUE(std::binary_search(unique.begin(), unique.end(), i)) << i;
+        }
+    }
+}
+
+TEST(SpatialHash2DTest, ParallelBuildMatchesSerialOrder)
+{
+    const auto boxes = MakeBoxes(20000, 3000.0f, 2.0f, 12.0f, 99);
+
+    SpatialHash2D serial(32.0f);
+    InsertAll(serial, boxes);
+    const auto expected = FindOverlaps(serial, boxes);
+
+    JobSystem::Create(3);
+    SpatialHash2D parallel(32.0f);
+    InsertAll(parallel, boxes);
+    const auto actual = FindOverlaps(parallel, boxes);
+    const size_t cellCount = parallel.GetCellCount();
+    JobSystem::Destroy();
+
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(cellCount, serial.GetCellCount());
+}
+
+//============================================================================
+// ベンチマーク
+//
+// 弾幕のような小さいコライダーを密度一定で1k/10k/100k配置し、
+// 構築 + ペア抽出の時間を逐次と並列で測る。
+// 結果は標準出力とテストプロパティに記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class SpatialHash2DBenchmark : public ::testing::Test {
+protected:
+    static constexpr int kFrames = 10;
+
+    void RunScaling(const char* label)
+    {
+        for (const uint32_t count : {1000u, 10000u, 100000u}) {
+            // 1コライダーあたり約40x40の面積
+            const float extent = std::sqrt(static_cast<float>(count)) * 20.0f;
+            const auto boxes = MakeBoxes(count, extent, 2.0f, 6.0f, count);
+            SpatialHash2D grid(32.0f);
+
+            size_t pairs = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < kFrames; ++frame) {
+                InsertAll(grid, boxes);
+                pairs = FindOverlaps(grid, boxes).size();
+            }
+            const double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count() / kFrames;
+
+            char name[64];
+            std::snprintf(name, sizeof(name), "%s_%u", label, count);
+            std::printf("[ BENCH    ] %s: %u colliders, %.3f ms/frame, %zu pairs\n",
+                        label, count, ms, pairs);
+            RecordProperty(name, static_cast<int>(ms * 1000.0));
+        }
+    }
+};
+
+TEST_F(SpatialHash2DBenchmark, DISABLED_Serial)
+{
+    RunScaling("Serial");
+}
+
+TEST_F(SpatialHash2DBenchmark, DISABLED_Parallel)
+{
+    JobSystem::Create();
+    RunScaling("Parallel");
+    JobSystem::Destroy();
+}
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------
+//! @file   test_helpers.h
+//! @brief  テスト共通ヘルパー（決定的な乱数、行列比較）
+//----------------------------------------------------------------------------
+#pragma once
+
+
+#include <gtest/gtest.h>
+#include "engine/math/math_types.h"
+#include <cstdint>
+
+namespace TestHelpers
+{
+
+//============================================================================
+//! @brief テスト用の決定的な乱数（線形合同法）
+//!
+//! 同じシードからは全プラットフォームで同じ系列を返す。
+//============================================================================
+class TestRandom {
+public:
+    explicit TestRandom(uint32_t seed) : state_(seed) {}
+
+    //! @brief [lo, hi) の一様乱数
+    float Range(float lo, float hi) {
+        return lo + (hi - lo) * static_cast<float>(Advance() >> 8) / static_cast<float>(1u << 24);
+    }
+
+    //! @brief [0, bound) の整数乱数
+    uint32_t Next(uint32_t bound) {
+        return (Advance() >> 8) % bound;
+    }
+
+    //! @brief 各成分が [-extent, extent) の点
+    Vector3 Point(float extent) {
+        return Vector3(Range(-extent, extent), Range(-extent, extent), Range(-extent, extent));
+    }
+
+    //! @brief 単位方向ベクトル
+    Vector3 Direction() {
+        Vector3 d;
+        do {
+            d = Point(1.0f);
+        } while (d.LengthSquared() < 0.01f);
+        d.Normalize();
+        return d;
+    }
+
+private:
+    uint32_t Advance() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return state_;
+    }
+
+    uint32_t state_;
+};
+
+//! @brief 行列の全要素が許容誤差内で一致することを検証
+inline void ExpectMatrixNear(const Matrix& a, const Matrix& b, float tolerance = 1e-4f)
+{
+    const float* pa = &a._11;
+    const float* pb = &b._11;
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_NEAR(pa[i], pb[i], tolerance) << "element " << i;
+    }
+}
+
+} // namespace TestHelpers
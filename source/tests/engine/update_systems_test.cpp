@@ -12,7 +12,12 @@
 #include "engine/ecs/systems/transform/rotation_update_system.h"
 #include "engine/ecs/systems/transform/scale_update_system.h"
 #include "engine/ecs/systems/transform/local_to_world_system.h"
+#include "engine/ecs/systems/transform/parent_system.h"
+#include "engine/core/job_system.h"
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <vector>
 
 namespace
 {
@@ -282,6 +287,319 @@ TEST(LocalToWorldSystemTest, ComputesWorldMatrix)
     EXPECT_NEAR(pos.z, 30.0f, kEpsilon);
 }
 
+TEST(LocalToWorldSystemTest, ComputesDeepHierarchyInDepthOrder)
+{
+    ECS::World world;
+    ECS::ParentSystem parentSystem;
+    ECS::LocalToWorldSystem ltwSystem;
+
+    // 子から先に作成し、作成順ではなく深度順に計算されることを確認
+    std::vector<ECS::Actor> chain(4);
+    const float offsets[] = { 1000.0f, 100.0f, 10.0f, 1.0f };
+    for (int i = 3; i >= 0; --i) {
+        chain[i] = world.CreateActor();
+        auto* transform = world.AddComponent<ECS::LocalTransform>(chain[i]);
+        transform->position = Vector3(offsets[i], 0.0f, 0.0f);
+        world.AddComponent<ECS::LocalToWorld>(chain[i]);
+    }
+    for (int i = 1; i < 4; ++i) {
+        world.AddComponent<ECS::Parent>(chain[i], chain[i - 1]);
+    }
+
+    parentSystem.OnUpdate(world, 0.016f);
+    ltwSystem.OnUpdate(world, 0.016f);
+
+    const ECS::World& constWorld = world;
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(chain[1])->GetPosition().x, 1100.0f, kEpsilon);
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(chain[3])->GetPosition().x, 1111.0f, kEpsilon);
+}
+
+TEST(LocalToWorldSystemTest, SkipsUnchangedChunksAndPropagatesParentChange)
+{
+    ECS::World world;
+    ECS::ParentSystem parentSystem;
+    ECS::LocalToWorldSystem ltwSystem;
+    ECS::SystemState ltwState;  // 前回実行バージョンを保持
+
+    auto root = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(root)->position = Vector3(100.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(root);
+
+    auto child = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(child)->position = Vector3(10.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(child);
+    world.AddComponent<ECS::Parent>(child, root);
+
+    auto step = [&] {
+        world.BeginFrame();
+        parentSystem.OnUpdate(world, 0.016f);
+        ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+    };
+
+    // 変更は変更フレームと次のフレームで計算され、その後はスキップされる
+    step();
+    step();
+    step();
+    EXPECT_EQ(ltwSystem.GetLastRecomputedCount(), 0u);
+
+    // ルートのみ変更 → ルートと、その子が再計算される
+    world.BeginFrame();
+    world.GetComponent<ECS::LocalTransform>(root)->position.x = 200.0f;
+    parentSystem.OnUpdate(world, 0.016f);
+    ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+
+    EXPECT_EQ(ltwSystem.GetLastRecomputedCount(), 2u);
+    const ECS::World& constWorld = world;
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(child)->GetPosition().x, 210.0f, kEpsilon);
+}
+
+TEST(LocalToWorldSystemTest, SkipsChildChunksWhoseParentChunksAreClean)
+{
+    ECS::World world;
+    ECS::ParentSystem parentSystem;
+    ECS::LocalToWorldSystem ltwSystem;
+    ECS::SystemState ltwState;
+
+    // PostTransformMatrixの有無でArchetype（Chunk）を分けた2つの階層
+    auto rootA = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(rootA)->position = Vector3(100.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(rootA);
+    auto childA = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(childA)->position = Vector3(10.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(childA);
+    world.AddComponent<ECS::Parent>(childA, rootA);
+
+    auto rootB = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(rootB);
+    world.AddComponent<ECS::LocalToWorld>(rootB);
+    world.AddComponent<ECS::PostTransformMatrix>(rootB);
+    auto childB = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(childB);
+    world.AddComponent<ECS::LocalToWorld>(childB);
+    world.AddComponent<ECS::PostTransformMatrix>(childB);
+    world.AddComponent<ECS::Parent>(childB, rootB);
+
+    auto step = [&] {
+        world.BeginFrame();
+        parentSystem.OnUpdate(world, 0.016f);
+        ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+    };
+
+    // 変更がなければ子Chunkは走査されない
+    step();
+    step();
+    step();
+    step();
+    EXPECT_EQ(ltwSystem.GetLastRecomputedCount(), 0u);
+    EXPECT_EQ(ltwSystem.GetLastVisitedChildCount(), 0u);
+
+    // rootAのみ変更 → childAのChunkだけが走査される
+    world.BeginFrame();
+    world.GetComponent<ECS::LocalTransform>(rootA)->position.x = 200.0f;
+    parentSystem.OnUpdate(world, 0.016f);
+    ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+
+    EXPECT_EQ(ltwSystem.GetLastRecomputedCount(), 2u);
+    EXPECT_EQ(ltwSystem.GetLastVisitedChildCount(), 1u);
+    const ECS::World& constWorld = world;
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(childA)->GetPosition().x, 210.0f, kEpsilon);
+}
+
+TEST(LocalToWorldSystemTest, FollowsParentMovedOutOfSharedChunk)
+{
+    ECS::World world;
+    ECS::ParentSystem parentSystem;
+    ECS::LocalToWorldSystem ltwSystem;
+    ECS::SystemState ltwState;
+
+    // 同じChunkに残る別の親（移動元Chunkが空にならないようにする）
+    auto other = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(other);
+    world.AddComponent<ECS::LocalToWorld>(other);
+    auto otherChild = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(otherChild);
+    world.AddComponent<ECS::LocalToWorld>(otherChild);
+    world.AddComponent<ECS::Parent>(otherChild, other);
+
+    auto root = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(root)->position = Vector3(100.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(root);
+
+    auto child = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(child)->position = Vector3(10.0f, 0.0f, 0.0f);
+    world.AddComponent<ECS::LocalToWorld>(child);
+    world.AddComponent<ECS::Parent>(child, root);
+
+    auto step = [&] {
+        world.BeginFrame();
+        parentSystem.OnUpdate(world, 0.016f);
+        ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+    };
+
+    step();
+    step();
+    step();
+    step();
+    EXPECT_EQ(ltwSystem.GetLastVisitedChildCount(), 0u);
+
+    // 親が別Archetypeへ移動（子のChunkは未変更）
+    world.BeginFrame();
+    world.AddComponent<ECS::PostTransformMatrix>(root, Matrix::CreateTranslation(0.0f, 5.0f, 0.0f));
+    parentSystem.OnUpdate(world, 0.016f);
+    ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+    step();
+    step();
+
+    const ECS::World& constWorld = world;
+    const Vector3 pos = constWorld.GetComponent<ECS::LocalToWorld>(child)->GetPosition();
+    EXPECT_NEAR(pos.x, 110.0f, kEpsilon);
+    EXPECT_NEAR(pos.y, 5.0f, kEpsilon);
+
+    // 移動後の親の変更も子へ伝播する
+    world.BeginFrame();
+    world.GetComponent<ECS::LocalTransform>(root)->position.x = 300.0f;
+    parentSystem.OnUpdate(world, 0.016f);
+    ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(child)->GetPosition().x, 310.0f, kEpsilon);
+}
+
+TEST(LocalToWorldSystemTest, DropsParentChunkRecordsOfEmptiedChunks)
+{
+    ECS::World world;
+    ECS::ParentSystem parentSystem;
+    ECS::LocalToWorldSystem ltwSystem;
+    ECS::SystemState ltwState;
+
+    auto root = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(root);
+    world.AddComponent<ECS::LocalToWorld>(root);
+
+    // 別Archetype（別Chunk）の子を2つ
+    auto childA = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(childA);
+    world.AddComponent<ECS::LocalToWorld>(childA);
+    world.AddComponent<ECS::Parent>(childA, root);
+    auto childB = world.CreateActor();
+    world.AddComponent<ECS::LocalTransform>(childB);
+    world.AddComponent<ECS::LocalToWorld>(childB);
+    world.AddComponent<ECS::PostTransformMatrix>(childB);
+    world.AddComponent<ECS::Parent>(childB, root);
+
+    auto step = [&] {
+        world.BeginFrame();
+        parentSystem.OnUpdate(world, 0.016f);
+        ECS::SystemExecutor::RunSystem(ltwSystem, ltwState, world, 0.016f);
+    };
+
+    step();
+    EXPECT_EQ(ltwSystem.GetCachedParentChunkCount(), 2u);
+
+    // 子のいなくなったChunkの記録は捨てられる
+    world.DestroyActor(childA);
+    step();
+    EXPECT_EQ(ltwSystem.GetCachedParentChunkCount(), 1u);
+
+    world.DestroyActor(childB);
+    step();
+    EXPECT_EQ(ltwSystem.GetCachedParentChunkCount(), 0u);
+}
+
+//============================================================================
+// LocalToWorldSystem ベンチマーク
+//
+// フラット（ルートのみ）と深い階層で、全変更フレームと無変更フレームの
+// 1フレームあたりの処理時間を測る。結果は標準出力とテストプロパティに
+// 記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class LocalToWorldSystemBenchmark : public ::testing::Test {
+protected:
+    static constexpr int kActorCount = 20000;
+    static constexpr int kFrames = 10;
+
+    void SetUp() override { JobSystem::Create(); }
+    void TearDown() override { JobSystem::Destroy(); }
+
+    ECS::Actor CreateTransform(ECS::Actor parent) {
+        ECS::Actor actor = world_.CreateActor();
+        world_.AddComponent<ECS::LocalTransform>(actor)->position = Vector3(1.0f, 0.0f, 0.0f);
+        world_.AddComponent<ECS::LocalToWorld>(actor);
+        if (parent.IsValid()) {
+            world_.AddComponent<ECS::Parent>(actor, parent);
+        }
+        return actor;
+    }
+
+    void Step(bool touchAll) {
+        world_.BeginFrame();
+        if (touchAll) {
+            world_.ForEach<ECS::InOut<ECS::LocalTransform>>([](ECS::Actor, ECS::LocalTransform& t) {
+                t.position.y += 0.001f;
+            });
+        }
+        parentSystem_.OnUpdate(world_, 0.016f);
+        ECS::SystemExecutor::RunSystem(ltwSystem_, ltwState_, world_, 0.016f);
+    }
+
+    double MeasureMs(bool touchAll) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrames; ++i) {
+            Step(touchAll);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::milli>(elapsed).count() / kFrames;
+    }
+
+    void RunAndReport(const char* label) {
+        // 初回計算と、構造変更（ParentSystemによる追加）の反映を済ませる
+        Step(false);
+        Step(false);
+        Step(false);
+        EXPECT_EQ(ltwSystem_.GetLastRecomputedCount(), 0u);
+
+        const double unchangedMs = MeasureMs(false);
+        const double changedMs = MeasureMs(true);
+        EXPECT_EQ(ltwSystem_.GetLastRecomputedCount(), static_cast<uint32_t>(kActorCount));
+
+        std::printf("[ BENCH    ] %s: %d actors, all changed %.3f ms/frame, unchanged %.3f ms/frame (workers=%u)\n",
+                    label, kActorCount, changedMs, unchangedMs, JobSystem::Get().GetWorkerCount());
+        RecordProperty(label, static_cast<int>(changedMs * 1000.0));
+    }
+
+    ECS::World world_;
+    ECS::ParentSystem parentSystem_;
+    ECS::LocalToWorldSystem ltwSystem_;
+    ECS::SystemState ltwState_;
+};
+
+TEST_F(LocalToWorldSystemBenchmark, DISABLED_FlatHierarchy)
+{
+    for (int i = 0; i < kActorCount; ++i) {
+        CreateTransform(ECS::Actor::Invalid());
+    }
+    RunAndReport("LocalToWorldFlat");
+}
+
+TEST_F(LocalToWorldSystemBenchmark, DISABLED_DeepHierarchy)
+{
+    // 深さ20のチェーンを並べる
+    constexpr int kDepth = 20;
+    ECS::Actor leaf = ECS::Actor::Invalid();
+    for (int c = 0; c < kActorCount / kDepth; ++c) {
+        ECS::Actor parent = ECS::Actor::Invalid();
+        for (int d = 0; d < kDepth; ++d) {
+            parent = CreateTransform(parent);
+        }
+        leaf = parent;
+    }
+    RunAndReport("LocalToWorldDeep");
+
+    const ECS::World& constWorld = world_;
+    EXPECT_NEAR(constWorld.GetComponent<ECS::LocalToWorld>(leaf)->GetPosition().x,
+                static_cast<float>(kDepth), kEpsilon);
+}
+
 //============================================================================
 // World::GetWorldMatrix テスト
 //============================================================================
@@ -0,0 +1,393 @@
+//----------------------------------------------------------------------------
+//! @file   wide_bvh_test.cpp
+//! @brief  Physics::WideBVH（BVH4/BVH8）のテスト
+//----------------------------------------------------------------------------
+#include <gtest/gtest.h>
+#include "engine/physics/wide_bvh.h"
+#include "physics_test_helpers.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+using Physics::BVH;
+using Physics::BVH4;
+using Physics::BVHRay;
+using Physics::BVHRayHit;
+using Physics::Triangle;
+using TestHelpers::MakeTerrain;
+using TestHelpers::MakeTriangleSoup;
+using TestHelpers::TestRandom;
+
+//! @brief 全方向のランダムなレイ
+std::vector<BVHRay> MakeRays(uint32_t count, float extent, float tMax, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<BVHRay> rays(count);
+    for (BVHRay& ray : rays) {
+        ray.origin = Vector3(rng.Range(-extent, extent), rng.Range(-extent, extent), rng.Range(-extent, extent));
+        ray.direction = Vector3(rng.Range(-1, 1), rng.Range(-1, 1), rng.Range(-1, 1));
+        ray.direction.Normalize();
+        ray.tMax = tMax;
+    }
+    return rays;
+}
+
+//! @brief 地形を見下ろす視線・弾道相当のレイ（原点が近いものが多い）
+std::vector<BVHRay> MakeTerrainRays(uint32_t count, float size, uint32_t seed)
+{
+    TestRandom rng(seed);
+    std::vector<BVHRay> rays(count);
+    for (BVHRay& ray : rays) {
+        ray.origin = Vector3(rng.Range(0, size), rng.Range(5, 20), rng.Range(0, size));
+        ray.direction = Vector3(rng.Range(-1, 1), rng.Range(-1, -0.1f), rng.Range(-1, 1));
+        ray.direction.Normalize();
+        ray.tMax = 1000.0f;
+    }
+    return rays;
+}
+
+//! @brief 多分木と二分木の結果が一致することを確認
+template<typename WideTree>
+void ExpectMatchesBinary(const BVH& bvh, const WideTree& wide, const std::vector<BVHRay>& rays)
+{
+    int hits = 0;
+    for (uint32_t r = 0; r < rays.size(); ++r) {
+        const BVHRay& ray = rays[r];
+        float expectedT = 0.0f, actualT = 0.0f;
+        uint32_t expectedTri = 0, actualTri = 0;
+        const bool expected = bvh.Intersect(ray.origin, ray.direction, ray.tMax, expectedT, expectedTri);
+        const bool actual = wide.Intersect(ray.origin, ray.direction, ray.tMax, actualT, actualTri);
+        ASSERT_EQ(actual, expected) << r;
+        if (expected) {
+            ++hits;
+            EXPECT_NEAR(actualT, expectedT, 1e-4f) << r;
+            EXPECT_EQ(actualTri, expectedTri) << r;
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+} // namespace
+
+//============================================================================
+// 構造
+//============================================================================
+
+TEST(WideBVHTest, CollapsedTreeCoversEveryTriangleOnce)
+{
+    const auto triangles = MakeTriangleSoup(3000, 50.0f, 1);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+
+    const auto& nodes = wide.GetNodes();
+    const auto& packets = wide.GetPackets();
+    ASSERT_FALSE(nodes.empty());
+    EXPECT_LT(nodes.size(), bvh.GetNodes().size() / 2);
+
+    std::vector<uint32_t> seen(triangles.size(), 0);
+    for (const BVH4::Node& node : nodes) {
+        uint32_t used = 0;
+        for (uint32_t c = 0; c < 4; ++c) {
+            const uint32_t child = node.child[c];
+            if (child == BVH4::Node::kEmptySlot) continue;
+            ++used;
+            if ((child & BVH4::Node::kLeafFlag) == 0) {
+                ASSERT_LT(child, nodes.size());
+                EXPECT_EQ(node.packetCount[c], 0u);
+                continue;
+            }
+            const uint32_t first = child & ~BVH4::Node::kLeafFlag;
+            ASSERT_LE(first + node.packetCount[c], packets.size());
+            for (uint32_t p = first; p < first + node.packetCount[c]; ++p) {
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    const uint32_t index = packets[p].index[lane];
+                    if (index == UINT32_MAX) continue;
+                    ++seen[index];
+                    // 三角形は子のAABBに含まれる
+                    const Vector3 v0(packets[p].v0x[lane], packets[p].v0y[lane], packets[p].v0z[lane]);
+                    EXPECT_TRUE(v0.x >= node.minX[c] && v0.x <= node.maxX[c] &&
+                                v0.y >= node.minY[c] && v0.y <= node.maxY[c] &&
+                                v0.z >= node.minZ[c] && v0.z <= node.maxZ[c]);
+                }
+            }
+        }
+        // 二分木の内部ノードを展開するので、根以外のノードも2つ以上の子を持つ
+        EXPECT_GE(used, 2u);
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](uint32_t c) { return c == 1; }));
+}
+
+TEST(WideBVHTest, SingleLeafTree)
+{
+    BVH bvh;
+    bvh.Build({Triangle{Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0), 7}});
+    BVH4 wide;
+    wide.Build(bvh);
+    ASSERT_EQ(wide.GetNodes().size(), 1u);
+
+    float t;
+    uint32_t index;
+    ASSERT_TRUE(wide.Intersect(Vector3(0.2f, 0.2f, -1.0f), Vector3(0, 0, 1), 10.0f, t, index));
+    EXPECT_NEAR(t, 1.0f, 1e-5f);
+    EXPECT_EQ(index, 7u);
+    EXPECT_FALSE(wide.Intersect(Vector3(0.2f, 0.2f, -1.0f), Vector3(0, 0, 1), 0.5f, t, index));
+    EXPECT_FALSE(wide.Intersect(Vector3(2.0f, 2.0f, -1.0f), Vector3(0, 0, 1), 10.0f, t, index));
+}
+
+//============================================================================
+// レイキャスト
+//============================================================================
+
+TEST(WideBVHTest, RaycastMatchesBinaryTree)
+{
+    const auto triangles = MakeTriangleSoup(2000, 20.0f, 5);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+    ExpectMatchesBinary(bvh, wide, MakeRays(2000, 30.0f, 100.0f, 9));
+}
+
+TEST(WideBVHTest, RefitMatchesRefitBinaryTree)
+{
+    auto triangles = MakeTriangleSoup(3000, 20.0f, 6);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+
+    // 三角形ごとに違う量を動かしてからリフィット
+    std::vector<Vector3> positions;
+    std::vector<uint32_t> indices;
+    TestRandom rng(31);
+    for (const Triangle& tri : triangles) {
+        const Vector3 offset(rng.Range(-2, 2), rng.Range(-2, 2), rng.Range(-2, 2));
+        for (const Vector3& v : {tri.v0, tri.v1, tri.v2}) {
+            indices.push_back(static_cast<uint32_t>(positions.size()));
+            positions.push_back(v + offset);
+        }
+    }
+    JobSystem::Create(3);
+    bvh.Refit(positions, indices);
+    wide.Refit(bvh);
+    JobSystem::Destroy();
+
+    // 子のAABBは子ノードのAABBの和、葉は三角形のAABBにぴったり一致する
+    using Node = BVH4::Node;
+    const auto& nodes = wide.GetNodes();
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        for (uint32_t slot = 0; slot < 4; ++slot) {
+            const uint32_t child = nodes[n].child[slot];
+            if (child == Node::kEmptySlot) continue;
+            Physics::AABB expected;
+            if (child & Node::kLeafFlag) {
+                const uint32_t first = child & ~Node::kLeafFlag;
+                for (uint32_t p = first; p < first + nodes[n].packetCount[slot]; ++p) {
+                    for (uint32_t lane = 0; lane < 4; ++lane) {
+                        const uint32_t index = wide.GetPackets()[p].index[lane];
+                        if (index != UINT32_MAX) expected.Expand(bvh.GetTriangles()[index].GetAABB());
+                    }
+                }
+            } else {
+                for (uint32_t c = 0; c < 4; ++c) {
+                    if (nodes[child].child[c] == Node::kEmptySlot) continue;
+                    expected.Expand(Vector3(nodes[child].minX[c], nodes[child].minY[c], nodes[child].minZ[c]));
+                    expected.Expand(Vector3(nodes[child].maxX[c], nodes[child].maxY[c], nodes[child].maxZ[c]));
+                }
+            }
+            EXPECT_EQ(nodes[n].minX[slot], expected.min.x) << n;
+            EXPECT_EQ(nodes[n].minY[slot], expected.min.y) << n;
+            EXPECT_EQ(nodes[n].minZ[slot], expected.min.z) << n;
+            EXPECT_EQ(nodes[n].maxX[slot], expected.max.x) << n;
+            EXPECT_EQ(nodes[n].maxY[slot], expected.max.y) << n;
+            EXPECT_EQ(nodes[n].maxZ[slot], expected.max.z) << n;
+        }
+    }
+    ExpectMatchesBinary(bvh, wide, MakeRays(1000, 30.0f, 100.0f, 10));
+}
+
+#if defined(__AVX__)
+TEST(WideBVHTest, Bvh8RaycastMatchesBinaryTree)
+{
+    const auto triangles = MakeTriangleSoup(2000, 20.0f, 5);
+    BVH bvh;
+    bvh.Build(triangles);
+    Physics::BVH8 wide;
+    wide.Build(bvh);
+    ExpectMatchesBinary(bvh, wide, MakeRays(2000, 30.0f, 100.0f, 9));
+}
+#endif
+
+TEST(WideBVHTest, AxisAlignedRaysHitTerrain)
+{
+    const auto triangles = MakeTerrain(32);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+
+    // 真下・軸平行のレイ（逆方向が大きな値になる）
+    std::vector<BVHRay> rays;
+    for (float x = 0.25f; x < 32.0f; x += 1.5f) {
+        rays.push_back(BVHRay{Vector3(x, 20.0f, 7.75f), Vector3(0, -1, 0), 100.0f});
+        rays.push_back(BVHRay{Vector3(-5.0f, 0.0f, x), Vector3(1, 0, 0), 100.0f});
+    }
+    ExpectMatchesBinary(bvh, wide, rays);
+}
+
+TEST(WideBVHTest, BatchMatchesSingleRays)
+{
+    const auto triangles = MakeTriangleSoup(4000, 30.0f, 11);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+
+    auto rays = MakeRays(1000, 40.0f, 150.0f, 3);
+    rays[10].tMax = 0.0f;   // 判定しないレイ
+
+    std::vector<BVHRayHit> hits(rays.size());
+    wide.IntersectBatch(rays, hits);
+
+    int hitCount = 0;
+    for (uint32_t r = 0; r < rays.size(); ++r) {
+        float t = 0.0f;
+        uint32_t index = UINT32_MAX;
+        const bool expected = rays[r].tMax > 0.0f &&
+            wide.Intersect(rays[r].origin, rays[r].direction, rays[r].tMax, t, index);
+        ASSERT_EQ(hits[r].IsHit(), expected) << r;
+        if (expected) {
+            ++hitCount;
+            EXPECT_FLOAT_EQ(hits[r].t, t) << r;
+            EXPECT_EQ(hits[r].triIndex, index) << r;
+        }
+    }
+    EXPECT_GT(hitCount, 0);
+}
+
+TEST(WideBVHTest, ParallelBatchMatchesSerialBatch)
+{
+    const auto triangles = MakeTerrain(100);
+    BVH bvh;
+    bvh.Build(triangles);
+    BVH4 wide;
+    wide.Build(bvh);
+
+    const auto rays = MakeTerrainRays(5000, 100.0f, 21);
+    std::vector<BVHRayHit> serial(rays.size());
+    wide.IntersectBatch(rays, serial);
+
+    JobSystem::Create(3);
+    std::vector<BVHRayHit> parallel(rays.size());
+    wide.IntersectBatch(rays, parallel);
+    JobSystem::Destroy();
+
+    for (uint32_t r = 0; r < rays.size(); ++r) {
+        EXPECT_EQ(parallel[r].triIndex, serial[r].triIndex) << r;
+        EXPECT_EQ(parallel[r].t, serial[r].t) << r;
+    }
+}
+
+//============================================================================
+// ベンチマーク
+//
+// 地形メッシュ（50万三角形）に視線・弾道相当のレイを撃ち、
+// 二分木の1本ずつ、多分木の1本ずつ、多分木の一括（逐次/並列）で rays/sec を測る。
+// 結果は標準出力とテストプロパティに記録する（閾値判定はしない）。
+// 既定では無効（--gtest_also_run_disabled_tests で実行する）。
+//============================================================================
+class WideBVHBenchmark : public ::testing::Test {
+protected:
+    static constexpr uint32_t kRayCount = 200000;
+
+    static void SetUpTestSuite()
+    {
+        bvh_ = new BVH();
+        bvh_->Build(MakeTerrain(500));
+        wide_ = new BVH4();
+        wide_->Build(*bvh_);
+        rays_ = new std::vector<BVHRay>(MakeTerrainRays(kRayCount, 500.0f, 77));
+    }
+
+    static void TearDownTestSuite()
+    {
+        delete rays_;
+        delete wide_;
+        delete bvh_;
+    }
+
+    template<typename Func>
+    void Measure(const char* label, Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const uint32_t hits = func();
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double raysPerSec = static_cast<double>(kRayCount) / sec;
+        std::printf("[ BENCH    ] %s: %u rays, %u hits, %.2f Mrays/s\n",
+                    label, kRayCount, hits, raysPerSec / 1.0e6);
+        RecordProperty(label, static_cast<int>(raysPerSec));
+    }
+
+    static uint32_t CountHits(const std::vector<BVHRayHit>& hits)
+    {
+        return static_cast<uint32_t>(std::count_if(hits.begin(), hits.end(),
+            [](const BVHRayHit& hit) { return hit.IsHit(); }));
+    }
+
+    static inline BVH* bvh_ = nullptr;
+    static inline BVH4* wide_ = nullptr;
+    static inline std::vector<BVHRay>* rays_ = nullptr;
+};
+
+TEST_F(WideBVHBenchmark, DISABLED_BinarySingle)
+{
+    Measure("BinarySingle", [] {
+        uint32_t hits = 0;
+        for (const BVHRay& ray : *rays_) {
+            float t;
+            uint32_t index;
+            hits += bvh_->Intersect(ray.origin, ray.direction, ray.tMax, t, index) ? 1 : 0;
+        }
+        return hits;
+    });
+}
+
+TEST_F(WideBVHBenchmark, DISABLED_WideSingle)
+{
+    Measure("WideSingle", [] {
+        uint32_t hits = 0;
+        for (const BVHRay& ray : *rays_) {
+            float t;
+            uint32_t index;
+            hits += wide_->Intersect(ray.origin, ray.direction, ray.tMax, t, index) ? 1 : 0;
+        }
+        return hits;
+    });
+}
+
+TEST_F(WideBVHBenchmark, DISABLED_WideBatchSerial)
+{
+    std::vector<BVHRayHit> hits(kRayCount);
+    Measure("WideBatchSerial", [&hits] {
+        wide_->IntersectBatch(*rays_, hits);
+        return CountHits(hits);
+    });
+}
+
+TEST_F(WideBVHBenchmark, DISABLED_WideBatchParallel)
+{
+    JobSystem::Create();
+    std::vector<BVHRayHit> hits(kRayCount);
+    Measure("WideBatchParallel", [&hits] {
+        wide_->IntersectBatch(*rays_, hits);
+        return CountHits(hits);
+    });
+    JobSystem::Destroy();
+}